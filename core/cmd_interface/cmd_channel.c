@@ -98,6 +98,9 @@ int cmd_channel_validate_packet_for_send (const struct cmd_packet *packet)
  * be interrupted by a different sequence of packets.  This ensures no interleaving of different
  * messages over the channel.
  *
+ * If the channel supports sending all packets in a single operation, the entire message is passed
+ * to the channel at once.  Otherwise, each packet is sent individually.
+ *
  * @param channel The channel to send the packets on.
  * @param message The message container with the packets that should be sent.
  * @param packet A packet buffer to use for sending the packets.  Once access to the channel is
@@ -116,7 +119,13 @@ static int cmd_channel_send_packets (struct cmd_channel *channel, struct cmd_mes
 
 	platform_mutex_lock (&channel->lock);
 
-	if (!packet->timeout_valid || !platform_has_timeout_expired (&packet->pkt_timeout)) {
+	if (packet->timeout_valid && platform_has_timeout_expired (&packet->pkt_timeout)) {
+		status = CMD_CHANNEL_PKT_EXPIRED;
+	}
+	else if (channel->send_packets != NULL) {
+		status = channel->send_packets (channel, message);
+	}
+	else {
 		pkt_pos = message->data;
 		msg_len = message->msg_size;
 
@@ -135,9 +144,6 @@ static int cmd_channel_send_packets (struct cmd_channel *channel, struct cmd_mes
 			msg_len -= pkt_len;
 		}
 	}
-	else {
-		status = CMD_CHANNEL_PKT_EXPIRED;
-	}
 
 	platform_mutex_unlock (&channel->lock);
 	return status;
@@ -89,6 +89,21 @@ struct cmd_channel {
 	 */
 	int (*send_packet) (struct cmd_channel *channel, struct cmd_packet *packet);
 
+	/**
+	 * Send all packets of a packetized message over a communication channel in a single
+	 * operation, such as one vectored write.  Every packet in the message is message->pkt_size
+	 * bytes, except for the last packet, which contains the remaining data.
+	 *
+	 * This is optional.  If a channel does not provide it, send_packet will be called for each
+	 * packet in the message.  The same postconditions as send_packet apply to each packet.
+	 *
+	 * @param channel The channel to send the packets on.
+	 * @param message The packetized message to send.
+	 *
+	 * @return 0 if all packets were successfully sent or an error code.
+	 */
+	int (*send_packets) (struct cmd_channel *channel, struct cmd_message *message);
+
 	int id;					/**< ID for the command channel. */
 	bool overflow;			/**< Flag if the channel is in an overflow condition. */
 	platform_mutex lock;	/**< Synchronization for message transmission. */
@@ -131,6 +146,7 @@ enum {
 	CMD_CHANNEL_SOC_SELECT_FAILURE = CMD_CHANNEL_ERROR (0x10),				/**< Socket select failure. */
 	CMD_CHANNEL_SOC_TIMEOUT = CMD_CHANNEL_ERROR(0x11),						/**< Socket timeout error. */
 	CMD_CHANNEL_SOC_BIND_FAILURE = CMD_CHANNEL_ERROR(0x12),					/**<Socket bind error. */
+	CMD_CHANNEL_SHM_INIT_FAILURE = CMD_CHANNEL_ERROR (0x13),				/**< Shared memory link initialization failure. */
 };
 
 
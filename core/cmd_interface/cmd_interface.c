@@ -157,6 +157,54 @@ int cmd_interface_prepare_response (struct cmd_interface *intf, struct cmd_inter
 	return status;
 }
 
+/**
+ * Get the location in the packet buffer for a message that holds response data at a specified
+ * message offset.  This allows a handler to write response data directly into the payload of the
+ * packets that will be transmitted, without first building the response in the message buffer.
+ *
+ * @param message The message that will be updated with a response.
+ * @param offset Offset within the response message.
+ * @param length Output for the number of response bytes that can be written contiguously at the
+ * returned location before reaching the end of the packet payload.
+ *
+ * @return The location in the packet buffer for the response data or null if the message does not
+ * have a packet buffer or the offset is beyond the end of the buffer.
+ */
+uint8_t* cmd_interface_msg_get_packet_payload (const struct cmd_interface_msg *message,
+	size_t offset, size_t *length)
+{
+	const struct cmd_interface_msg_packets *packets;
+	size_t pkt_offset;
+	size_t payload_offset;
+	size_t trailer_len;
+
+	if ((message == NULL) || (message->packets == NULL) || (length == NULL)) {
+		return NULL;
+	}
+
+	packets = message->packets;
+	if ((packets->payload_len == 0) ||
+		(packets->pkt_len < (packets->header_len + packets->payload_len))) {
+		return NULL;
+	}
+
+	trailer_len = packets->pkt_len - packets->header_len - packets->payload_len;
+	payload_offset = offset % packets->payload_len;
+	pkt_offset = ((offset / packets->payload_len) * packets->pkt_len) + packets->header_len +
+		payload_offset;
+
+	if ((pkt_offset + trailer_len) >= packets->length) {
+		return NULL;
+	}
+
+	*length = packets->payload_len - payload_offset;
+	if ((pkt_offset + *length + trailer_len) > packets->length) {
+		*length = packets->length - pkt_offset - trailer_len;
+	}
+
+	return &packets->data[pkt_offset];
+}
+
 /**
  * Generate a packet containing error message.
  *
@@ -11,6 +11,19 @@
 #include "cerberus_protocol.h"
 
 
+/**
+ * Layout of a transport buffer that allows a response to be written directly into the payload of
+ * the packets that will be transmitted.  Each packet is pkt_len bytes, with up to payload_len bytes
+ * of payload starting header_len bytes into the packet.
+ */
+struct cmd_interface_msg_packets {
+	uint8_t *data;					/**< The buffer for the packets. */
+	size_t length;					/**< Total length of the packet buffer. */
+	size_t header_len;				/**< Length of the transport header before each payload. */
+	size_t payload_len;				/**< Maximum payload in each packet. */
+	size_t pkt_len;					/**< Length of a full packet, including the header and trailer. */
+};
+
 /**
  * Container for message data.
  */
@@ -28,6 +41,11 @@ struct cmd_interface_msg {
 										timeout.  This is set for every message, even when there is
 										an error. */
 	int channel_id;					/**< Channel on which the message is received. */
+	struct cmd_interface_msg_packets *packets;	/**< Packet buffer that a response can be written
+										to instead of the data buffer.  This is null if the
+										transport does not support it. */
+	bool packetized;				/**< Flag set by the handler to indicate the response was written
+										to the packet buffer instead of the data buffer. */
 };
 
 /**
@@ -101,6 +119,8 @@ int cmd_interface_process_cerberus_protocol_message (struct cmd_interface *intf,
 	struct cmd_interface_msg *message, uint8_t *command_id, uint8_t *command_set, bool decrypt,
 	bool rsvd_zero);
 int cmd_interface_prepare_response (struct cmd_interface *intf, struct cmd_interface_msg *response);
+uint8_t* cmd_interface_msg_get_packet_payload (const struct cmd_interface_msg *message,
+	size_t offset, size_t *length);
 int cmd_interface_generate_error_packet (struct cmd_interface *intf,
 	struct cmd_interface_msg *request, uint8_t error_code, uint32_t error_data, uint8_t cmd_set);
 
@@ -71,6 +71,86 @@ int device_manager_update_device_state (struct device_manager *mgr, int device_n
 	return platform_init_timeout (timeout, &mgr->entries[device_num].attestation_timeout);
 }
 
+/**
+ * Update the transport parameters cached for an EID from the device table.
+ *
+ * @param mgr Device manager instance to update.
+ * @param eid The EID to update.
+ */
+static void device_manager_refresh_eid_entry (struct device_manager *mgr, uint8_t eid)
+{
+	struct device_manager_eid_entry *entry = &mgr->eid_map[eid];
+
+	entry->max_message_len = device_manager_get_max_message_len (mgr, entry->device_num);
+	entry->max_transmission_unit =
+		device_manager_get_max_transmission_unit (mgr, entry->device_num);
+}
+
+/**
+ * Update the transport parameters cached for every EID.  This is necessary when the local device
+ * capabilities change, since they limit the parameters for all devices.
+ *
+ * @param mgr Device manager instance to update.
+ */
+static void device_manager_refresh_all_eid_entries (struct device_manager *mgr)
+{
+	int eid;
+
+	for (eid = 0; eid < DEVICE_MANAGER_NUM_EIDS; eid++) {
+		device_manager_refresh_eid_entry (mgr, eid);
+	}
+}
+
+/**
+ * Update the EID lookup table for a device table entry that changed EIDs.  If multiple entries use
+ * the same EID, the EID maps to the first of them.
+ *
+ * @param mgr Device manager instance to update.
+ * @param device_num Device table entry that changed.
+ * @param prev_eid The EID previously used by the entry.
+ * @param eid The EID now used by the entry.
+ */
+static void device_manager_map_device_eid (struct device_manager *mgr, int device_num,
+	uint8_t prev_eid, uint8_t eid)
+{
+	int i_device;
+
+	if (mgr->eid_map[prev_eid].device_num == device_num) {
+		mgr->eid_map[prev_eid].device_num = DEVICE_MANAGER_EID_NOT_MAPPED;
+
+		for (i_device = device_num + 1; i_device < mgr->num_devices; ++i_device) {
+			if (mgr->entries[i_device].eid == prev_eid) {
+				mgr->eid_map[prev_eid].device_num = i_device;
+				break;
+			}
+		}
+
+		device_manager_refresh_eid_entry (mgr, prev_eid);
+	}
+
+	if ((mgr->eid_map[eid].device_num == DEVICE_MANAGER_EID_NOT_MAPPED) ||
+		(mgr->eid_map[eid].device_num > device_num)) {
+		mgr->eid_map[eid].device_num = device_num;
+		device_manager_refresh_eid_entry (mgr, eid);
+	}
+}
+
+/**
+ * Update the transport parameters cached for a device table entry that changed capabilities.
+ *
+ * @param mgr Device manager instance to update.
+ * @param device_num Device table entry that changed.
+ */
+static void device_manager_refresh_device_eid_entry (struct device_manager *mgr, int device_num)
+{
+	if (device_num == DEVICE_MANAGER_SELF_DEVICE_NUM) {
+		device_manager_refresh_all_eid_entries (mgr);
+	}
+	else if (mgr->eid_map[mgr->entries[device_num].eid].device_num == device_num) {
+		device_manager_refresh_eid_entry (mgr, mgr->entries[device_num].eid);
+	}
+}
+
 /**
  * Initialize a device manager.
  *
@@ -102,6 +182,7 @@ int device_manager_init (struct device_manager *mgr, int num_requester_devices,
 	uint8_t attestation_rsp_not_ready_max_retry)
 {
 	int total_num_devices = num_requester_devices + num_responder_devices;
+	int i_eid;
 	int status;
 
 	if ((mgr == NULL) || (num_requester_devices == 0) ||
@@ -116,11 +197,18 @@ int device_manager_init (struct device_manager *mgr, int num_requester_devices,
 		return DEVICE_MGR_NO_MEMORY;
 	}
 
+	mgr->eid_map =
+		platform_malloc (DEVICE_MANAGER_NUM_EIDS * sizeof (struct device_manager_eid_entry));
+	if (mgr->eid_map == NULL) {
+		status = DEVICE_MGR_NO_MEMORY;
+		goto free_entries;
+	}
+
 	if (num_responder_devices != 0) {
 		mgr->attestation_status = platform_malloc (num_responder_devices);
 		if (mgr->attestation_status == NULL) {
 			status = DEVICE_MGR_NO_MEMORY;
-			goto free_entries;
+			goto free_eid_map;
 		}
 	}
 
@@ -150,6 +238,14 @@ int device_manager_init (struct device_manager *mgr, int num_requester_devices,
 	mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].capabilities.max_sig =
 		device_manager_set_crypto_timeout_ms (MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS);
 
+	/* All device entries start with an EID of 0, so only the first entry is mapped. */
+	memset (mgr->eid_map, 0, DEVICE_MANAGER_NUM_EIDS * sizeof (struct device_manager_eid_entry));
+	for (i_eid = 1; i_eid < DEVICE_MANAGER_NUM_EIDS; i_eid++) {
+		mgr->eid_map[i_eid].device_num = DEVICE_MANAGER_EID_NOT_MAPPED;
+	}
+
+	device_manager_refresh_all_eid_entries (mgr);
+
 	status = device_manager_update_device_state (mgr, DEVICE_MANAGER_SELF_DEVICE_NUM,
 		DEVICE_MANAGER_NOT_ATTESTABLE);
 	if (status != 0) {
@@ -165,6 +261,8 @@ int device_manager_init (struct device_manager *mgr, int num_requester_devices,
 
 error_exit:
 	platform_free (mgr->attestation_status);
+free_eid_map:
+	platform_free (mgr->eid_map);
 free_entries:
 	platform_free (mgr->entries);
 
@@ -223,6 +321,7 @@ void device_manager_release (struct device_manager *mgr)
 {
 	if (mgr) {
 		platform_free (mgr->entries);
+		platform_free (mgr->eid_map);
 		platform_free (mgr->attestation_status);
 
 		mgr->num_devices = 0;
@@ -280,19 +379,15 @@ int device_manager_remove_observer (struct device_manager *mgr,
  */
 int device_manager_get_device_num (struct device_manager *mgr, uint8_t eid)
 {
-	int i_device;
-
 	if (mgr == NULL) {
 		return DEVICE_MGR_INVALID_ARGUMENT;
 	}
 
-	for (i_device = 0; i_device < mgr->num_devices; ++i_device) {
-		if (mgr->entries[i_device].eid == eid) {
-			return i_device;
-		}
+	if (mgr->eid_map[eid].device_num == DEVICE_MANAGER_EID_NOT_MAPPED) {
+		return DEVICE_MGR_UNKNOWN_DEVICE;
 	}
 
-	return DEVICE_MGR_UNKNOWN_DEVICE;
+	return mgr->eid_map[eid].device_num;
 }
 
 /**
@@ -373,6 +468,7 @@ int device_manager_update_device_eid (struct device_manager *mgr, int device_num
 		return DEVICE_MGR_UNKNOWN_DEVICE;
 	}
 
+	device_manager_map_device_eid (mgr, device_num, mgr->entries[device_num].eid, eid);
 	mgr->entries[device_num].eid = eid;
 
 	if (device_num == DEVICE_MANAGER_SELF_DEVICE_NUM) {
@@ -407,6 +503,7 @@ int device_manager_update_not_attestable_device_entry (struct device_manager *mg
 		return DEVICE_MGR_UNKNOWN_DEVICE;
 	}
 
+	device_manager_map_device_eid (mgr, device_num, mgr->entries[device_num].eid, eid);
 	mgr->entries[device_num].eid = eid;
 	mgr->entries[device_num].smbus_addr = smbus_addr;
 	mgr->entries[device_num].pcd_component_index = pcd_component_index;
@@ -520,6 +617,7 @@ int device_manager_update_device_capabilities (struct device_manager *mgr, int d
 
 	memcpy (&mgr->entries[device_num].capabilities, capabilities,
 		sizeof (struct device_manager_full_capabilities));
+	device_manager_refresh_device_eid_entry (mgr, device_num);
 
 	return 0;
 }
@@ -569,6 +667,7 @@ int device_manager_update_device_capabilities_request (struct device_manager *mg
 
 	memcpy (&mgr->entries[device_num].capabilities, capabilities,
 		sizeof (struct device_manager_capabilities));
+	device_manager_refresh_device_eid_entry (mgr, device_num);
 
 	return 0;
 }
@@ -617,7 +716,7 @@ size_t device_manager_get_max_message_len_by_eid (struct device_manager *mgr, ui
 		return MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 	}
 
-	return device_manager_get_max_message_len (mgr, device_manager_get_device_num (mgr, eid));
+	return mgr->eid_map[eid].max_message_len;
 }
 
 /**
@@ -664,7 +763,7 @@ size_t device_manager_get_max_transmission_unit_by_eid (struct device_manager *m
 		return MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
 	}
 
-	return device_manager_get_max_transmission_unit (mgr, device_manager_get_device_num (mgr, eid));
+	return mgr->eid_map[eid].max_transmission_unit;
 }
 
 /**
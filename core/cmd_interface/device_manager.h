@@ -22,6 +22,12 @@
 // Index indicating component not in PCD
 #define DEVICE_MANAGER_NOT_PCD_COMPONENT						0xFF
 
+// Device number indicating no device table entry uses an EID
+#define DEVICE_MANAGER_EID_NOT_MAPPED							0xFF
+
+// Number of entries in the EID lookup table
+#define DEVICE_MANAGER_NUM_EIDS									256
+
 // Maximum key length
 #define DEVICE_MANAGER_MAX_KEY_LEN								RSA_MAX_KEY_LENGTH
 
@@ -195,12 +201,26 @@ struct device_manager_unidentified_entry {
 	struct device_manager_unidentified_entry *next;				/**< Next entry in circular linked list */
 };
 
+/**
+ * Entry in the EID lookup table.  This holds the device table entry for an EID along with the
+ * transport parameters needed for every packet sent to the device, so they don't need to be
+ * determined from the device table.
+ */
+#pragma pack(push, 1)
+struct device_manager_eid_entry {
+	uint16_t max_message_len;									/**< Maximum message size to use with the device. */
+	uint16_t max_transmission_unit;								/**< Maximum packet size to use with the device. */
+	uint8_t device_num;											/**< Device table entry using the EID. */
+};
+#pragma pack(pop)
+
 /**
  * Module which holds a table of all devices Cerberus expects to communicate with and itself, to be
  * populated from PCD
  */
 struct device_manager {
 	struct device_manager_entry *entries;						/**< Device table entries. */
+	struct device_manager_eid_entry *eid_map;					/**< Device table entry and transport parameters for each EID. */
 	uint8_t *attestation_status;								/**< Dynamically allocated buffer to hold attestation status of all attestable devices. */
 	uint8_t num_devices;										/**< Number of device table entries. */
 	uint8_t num_requester_devices; 								/**< Number of requester device table entries. */
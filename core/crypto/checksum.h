@@ -5,6 +5,19 @@
 #define CHECKSUM_H_
 
 #include <stdint.h>
+#include <stddef.h>
+
+
+/**
+ * Select the implementation used for SMBus CRC8 calculations, such as the MCTP packet PEC.
+ *  - 0:  Calculate the CRC bit by bit.  No lookup table is needed.
+ *  - 1:  Use a 256 byte lookup table to process one byte at a time.
+ *  - 4:  Use four lookup tables (1 kB) to process four bytes at a time.
+ *  - 8:  Use eight lookup tables (2 kB) to process eight bytes at a time.
+ */
+#ifndef CHECKSUM_SMBUS_CRC8_SLICES
+#define	CHECKSUM_SMBUS_CRC8_SLICES		1
+#endif
 
 
 uint8_t checksum_crc8 (uint8_t smbus_addr, const uint8_t *data, uint8_t len);
@@ -12,5 +25,8 @@ uint8_t checksum_crc8 (uint8_t smbus_addr, const uint8_t *data, uint8_t len);
 uint8_t checksum_init_smbus_crc8 (uint8_t smbus_addr);
 uint8_t checksum_update_smbus_crc8 (uint8_t crc, const uint8_t *data, uint8_t len);
 
+uint32_t checksum_crc32 (const uint8_t *data, size_t len);
+uint32_t checksum_update_crc32 (uint32_t crc, const uint8_t *data, size_t len);
+
 
 #endif //CHECKSUM_H_
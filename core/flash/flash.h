@@ -127,6 +127,28 @@ struct flash {
 	 * @return 0 if the all flash memory was erased or an error code.
 	 */
 	int (*chip_erase) (const struct flash *flash);
+
+	/**
+	 * Start reading data from flash without waiting for the read to complete, such as with a DMA
+	 * transfer.  The data buffer must not be accessed until the read has been completed by
+	 * read_wait.  Only one read can be outstanding at a time.
+	 *
+	 * This is optional and can be null if the flash only supports blocking reads.  If this is
+	 * provided, read_wait must also be provided.
+	 * @param flash The flash to read from.
+	 * @param address The address to start reading from.
+	 * @param data The buffer to hold the data that will be read.
+	 * @param length The number of bytes to read.
+	 * @return 0 if the read was started or an error code.
+	 */
+	int (*read_start) (const struct flash *flash, uint32_t address, uint8_t *data, size_t length);
+
+	/**
+	 * Wait for a read started with read_start to complete.
+	 * @param flash The flash that is being read.
+	 * @return 0 if the bytes were read from flash or an error code.
+	 */
+	int (*read_wait) (const struct flash *flash);
 };
 
 
@@ -0,0 +1,542 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <string.h>
+#include "flash_cached.h"
+#include "flash_cached_static.h"
+
+
+/**
+ * Find the cache line that holds data for a flash address.  The cache lock must be held.
+ *
+ * @param cached The cache to search.
+ * @param line_addr The line aligned flash address to find.
+ *
+ * @return The line holding the data or null if the address is not cached.
+ */
+static struct flash_cached_line* flash_cached_find_line (const struct flash_cached *cached,
+	uint32_t line_addr)
+{
+	size_t i;
+
+	for (i = 0; i < cached->line_count; i++) {
+		if (cached->lines[i].valid && (cached->lines[i].address == line_addr)) {
+			return &cached->lines[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Select the cache line to use for new data.  An unused line is selected if there is one,
+ * otherwise the least recently used line is replaced.  The cache lock must be held.
+ *
+ * @param cached The cache to select a line from.
+ *
+ * @return The line to use for new data.
+ */
+static struct flash_cached_line* flash_cached_select_line (const struct flash_cached *cached)
+{
+	struct flash_cached_line *victim = &cached->lines[0];
+	size_t i;
+
+	for (i = 0; i < cached->line_count; i++) {
+		if (!cached->lines[i].valid) {
+			return &cached->lines[i];
+		}
+
+		/* Differences are used so the age comparison still works when the counter wraps. */
+		if ((uint32_t) (cached->state->access - cached->lines[i].last_used) >
+			(uint32_t) (cached->state->access - victim->last_used)) {
+			victim = &cached->lines[i];
+		}
+	}
+
+	return victim;
+}
+
+/**
+ * Get the cache storage for a line.
+ *
+ * @param cached The cache that contains the line.
+ * @param line The line to get the storage for.
+ *
+ * @return The cached data for the line.
+ */
+static uint8_t* flash_cached_line_data (const struct flash_cached *cached,
+	const struct flash_cached_line *line)
+{
+	return &cached->cache[(line - cached->lines) * cached->line_size];
+}
+
+/**
+ * Get a line holding the flash data at an address, reading the data from flash if necessary.  The
+ * cache lock must be held.
+ *
+ * @param cached The cache to get the line from.
+ * @param line_addr The line aligned flash address of the data.
+ * @param line Output for the line holding the data.
+ *
+ * @return 0 if the line was found or loaded from flash or an error code.
+ */
+static int flash_cached_load_line (const struct flash_cached *cached, uint32_t line_addr,
+	struct flash_cached_line **line)
+{
+	int status;
+
+	*line = flash_cached_find_line (cached, line_addr);
+	if (*line != NULL) {
+		cached->state->stats.hits++;
+	}
+	else {
+		cached->state->stats.misses++;
+
+		*line = flash_cached_select_line (cached);
+		(*line)->valid = false;
+
+		status = cached->flash->read (cached->flash, line_addr,
+			flash_cached_line_data (cached, *line), cached->line_size);
+		if (status != 0) {
+			return status;
+		}
+
+		(*line)->address = line_addr;
+		(*line)->valid = true;
+	}
+
+	(*line)->last_used = ++cached->state->access;
+
+	return 0;
+}
+
+/**
+ * Invalidate any cache lines that hold data in a range of flash.  The cache lock must be held.
+ *
+ * @param cached The cache to update.
+ * @param address The first address in the range.
+ * @param length The number of bytes in the range.
+ */
+static void flash_cached_invalidate_range (const struct flash_cached *cached, uint32_t address,
+	size_t length)
+{
+	uint32_t first = FLASH_REGION_BASE (address, cached->line_size);
+	size_t i;
+
+	if (length == 0) {
+		return;
+	}
+
+	for (i = 0; i < cached->line_count; i++) {
+		if (cached->lines[i].valid && (cached->lines[i].address >= first) &&
+			((cached->lines[i].address - first) < ((address - first) + length))) {
+			cached->lines[i].valid = false;
+		}
+	}
+}
+
+int flash_cached_get_device_size (const struct flash *flash, uint32_t *bytes)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	return cached->flash->get_device_size (cached->flash, bytes);
+}
+
+int flash_cached_read (const struct flash *flash, uint32_t address, uint8_t *data, size_t length)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+	struct flash_cached_line *line;
+	uint32_t line_addr;
+	uint32_t line_offset;
+	size_t read_len;
+	int status = 0;
+
+	if ((cached == NULL) || (data == NULL)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+
+	while ((status == 0) && (length > 0)) {
+		line_addr = FLASH_REGION_BASE (address, cached->line_size);
+		line_offset = address - line_addr;
+		read_len = cached->line_size - line_offset;
+		if (read_len > length) {
+			read_len = length;
+		}
+
+		if ((read_len == cached->line_size) &&
+			(flash_cached_find_line (cached, line_addr) == NULL)) {
+			/* Whole lines that are not already cached are read straight into the output.  Any
+			 * following lines that are also not cached are included in the same flash read. */
+			cached->state->stats.misses++;
+			while (((length - read_len) >= cached->line_size) &&
+				(flash_cached_find_line (cached, line_addr + read_len) == NULL)) {
+				cached->state->stats.misses++;
+				read_len += cached->line_size;
+			}
+
+			status = cached->flash->read (cached->flash, address, data, read_len);
+		}
+		else {
+			status = flash_cached_load_line (cached, line_addr, &line);
+			if (status == 0) {
+				memcpy (data, &flash_cached_line_data (cached, line)[line_offset], read_len);
+			}
+		}
+
+		address += read_len;
+		data += read_len;
+		length -= read_len;
+	}
+
+	platform_mutex_unlock (&cached->state->lock);
+
+	return status;
+}
+
+int flash_cached_get_page_size (const struct flash *flash, uint32_t *bytes)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	return cached->flash->get_page_size (cached->flash, bytes);
+}
+
+int flash_cached_minimum_write_per_page (const struct flash *flash, uint32_t *bytes)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	return cached->flash->minimum_write_per_page (cached->flash, bytes);
+}
+
+int flash_cached_write (const struct flash *flash, uint32_t address, const uint8_t *data,
+	size_t length)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+	int status;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+
+	flash_cached_invalidate_range (cached, address, length);
+	status = cached->flash->write (cached->flash, address, data, length);
+
+	platform_mutex_unlock (&cached->state->lock);
+
+	return status;
+}
+
+int flash_cached_get_sector_size (const struct flash *flash, uint32_t *bytes)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	return cached->flash->get_sector_size (cached->flash, bytes);
+}
+
+int flash_cached_sector_erase (const struct flash *flash, uint32_t sector_addr)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+	uint32_t sector_size;
+	int status;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	status = cached->flash->get_sector_size (cached->flash, &sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+
+	flash_cached_invalidate_range (cached, FLASH_REGION_BASE (sector_addr, sector_size),
+		sector_size);
+	status = cached->flash->sector_erase (cached->flash, sector_addr);
+
+	platform_mutex_unlock (&cached->state->lock);
+
+	return status;
+}
+
+int flash_cached_get_block_size (const struct flash *flash, uint32_t *bytes)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	return cached->flash->get_block_size (cached->flash, bytes);
+}
+
+int flash_cached_block_erase (const struct flash *flash, uint32_t block_addr)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+	uint32_t block_size;
+	int status;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	status = cached->flash->get_block_size (cached->flash, &block_size);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+
+	flash_cached_invalidate_range (cached, FLASH_REGION_BASE (block_addr, block_size),
+		block_size);
+	status = cached->flash->block_erase (cached->flash, block_addr);
+
+	platform_mutex_unlock (&cached->state->lock);
+
+	return status;
+}
+
+int flash_cached_chip_erase (const struct flash *flash)
+{
+	const struct flash_cached *cached = (const struct flash_cached*) flash;
+	size_t i;
+	int status;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+
+	for (i = 0; i < cached->line_count; i++) {
+		cached->lines[i].valid = false;
+	}
+
+	status = cached->flash->chip_erase (cached->flash);
+
+	platform_mutex_unlock (&cached->state->lock);
+
+	return status;
+}
+
+/**
+ * Initialize a read cache for a flash device.
+ *
+ * @param cached The cached flash device to initialize.
+ * @param state Variable context for the cached flash.  This must be uninitialized.
+ * @param flash The flash device to cache.
+ * @param lines Tracking for each cache line.  There must be line_count entries.
+ * @param cache Storage for the cached data.  This must be line_count * line_size bytes.
+ * @param line_count The number of lines in the cache.
+ * @param line_size The number of bytes in each cache line.  This must be a power of two.  Using
+ * the page size of the flash device is generally a good choice.
+ *
+ * @return 0 if the cached flash was successfully initialized or an error code.
+ */
+int flash_cached_init (struct flash_cached *cached, struct flash_cached_state *state,
+	const struct flash *flash, struct flash_cached_line *lines, uint8_t *cache, size_t line_count,
+	uint32_t line_size)
+{
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	memset (cached, 0, sizeof (struct flash_cached));
+
+	cached->base.get_device_size = flash_cached_get_device_size;
+	cached->base.read = flash_cached_read;
+	cached->base.get_page_size = flash_cached_get_page_size;
+	cached->base.minimum_write_per_page = flash_cached_minimum_write_per_page;
+	cached->base.write = flash_cached_write;
+	cached->base.get_sector_size = flash_cached_get_sector_size;
+	cached->base.sector_erase = flash_cached_sector_erase;
+	cached->base.get_block_size = flash_cached_get_block_size;
+	cached->base.block_erase = flash_cached_block_erase;
+	cached->base.chip_erase = flash_cached_chip_erase;
+
+	cached->state = state;
+	cached->flash = flash;
+	cached->lines = lines;
+	cached->cache = cache;
+	cached->line_count = line_count;
+	cached->line_size = line_size;
+
+	return flash_cached_init_state (cached);
+}
+
+/**
+ * Initialize only the variable state for a cached flash device.  The rest of the instance is
+ * assumed to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param cached The cached flash that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int flash_cached_init_state (const struct flash_cached *cached)
+{
+	if ((cached == NULL) || (cached->state == NULL) || (cached->flash == NULL) ||
+		(cached->lines == NULL) || (cached->cache == NULL) || (cached->line_count == 0) ||
+		(cached->line_size == 0) || ((cached->line_size & (cached->line_size - 1)) != 0)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	memset (cached->state, 0, sizeof (struct flash_cached_state));
+	memset (cached->lines, 0, sizeof (struct flash_cached_line) * cached->line_count);
+
+	return platform_mutex_init (&cached->state->lock);
+}
+
+/**
+ * Release the resources used by a cached flash device.
+ *
+ * @param cached The cached flash to release.
+ */
+void flash_cached_release (const struct flash_cached *cached)
+{
+	if (cached) {
+		platform_mutex_free (&cached->state->lock);
+	}
+}
+
+/**
+ * Discard any cached data for a region of flash.  This is only needed if the flash contents are
+ * changed without using the cached flash device, such as by another master on the bus.
+ *
+ * @param cached The cached flash to update.
+ * @param address The first address of the region to discard.
+ * @param length The length of the region.
+ *
+ * @return 0 if the cache was updated or an error code.
+ */
+int flash_cached_invalidate (const struct flash_cached *cached, uint32_t address, size_t length)
+{
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+	flash_cached_invalidate_range (cached, address, length);
+	platform_mutex_unlock (&cached->state->lock);
+
+	return 0;
+}
+
+/**
+ * Discard all cached data.
+ *
+ * @param cached The cached flash to update.
+ */
+void flash_cached_invalidate_all (const struct flash_cached *cached)
+{
+	size_t i;
+
+	if (cached != NULL) {
+		platform_mutex_lock (&cached->state->lock);
+
+		for (i = 0; i < cached->line_count; i++) {
+			cached->lines[i].valid = false;
+		}
+
+		platform_mutex_unlock (&cached->state->lock);
+	}
+}
+
+/**
+ * Load a region of flash into the cache ahead of reading it.  If the region is larger than the
+ * cache, only the end of the region will remain cached.
+ *
+ * @param cached The cached flash to load.
+ * @param address The first address of the region to load.
+ * @param length The length of the region.
+ *
+ * @return 0 if the region was loaded into the cache or an error code.
+ */
+int flash_cached_prefetch (const struct flash_cached *cached, uint32_t address, size_t length)
+{
+	struct flash_cached_line *line;
+	uint32_t line_addr;
+	uint32_t end;
+	int status = 0;
+
+	if (cached == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	if (length == 0) {
+		return 0;
+	}
+
+	line_addr = FLASH_REGION_BASE (address, cached->line_size);
+	end = address + (length - 1);
+
+	platform_mutex_lock (&cached->state->lock);
+
+	while (status == 0) {
+		status = flash_cached_load_line (cached, line_addr, &line);
+		if ((end - line_addr) < cached->line_size) {
+			break;
+		}
+
+		line_addr += cached->line_size;
+	}
+
+	platform_mutex_unlock (&cached->state->lock);
+
+	return status;
+}
+
+/**
+ * Get the usage statistics for the cache.
+ *
+ * @param cached The cached flash to query.
+ * @param stats Output for the cache statistics.
+ *
+ * @return 0 if the statistics were retrieved or an error code.
+ */
+int flash_cached_get_stats (const struct flash_cached *cached, struct flash_cached_stats *stats)
+{
+	if ((cached == NULL) || (stats == NULL)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&cached->state->lock);
+	*stats = cached->state->stats;
+	platform_mutex_unlock (&cached->state->lock);
+
+	return 0;
+}
+
+/**
+ * Clear the usage statistics for the cache.
+ *
+ * @param cached The cached flash to update.
+ */
+void flash_cached_reset_stats (const struct flash_cached *cached)
+{
+	if (cached != NULL) {
+		platform_mutex_lock (&cached->state->lock);
+		memset (&cached->state->stats, 0, sizeof (cached->state->stats));
+		platform_mutex_unlock (&cached->state->lock);
+	}
+}
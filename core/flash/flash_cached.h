@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_CACHED_H_
+#define FLASH_CACHED_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+#include "platform_api.h"
+#include "flash.h"
+
+
+/**
+ * Tracking information for a single line in the cache.
+ */
+struct flash_cached_line {
+	uint32_t address;			/**< Flash address of the first byte held in the line. */
+	uint32_t last_used;			/**< Access count when the line was last used. */
+	bool valid;					/**< Flag indicating the line holds flash data. */
+};
+
+/**
+ * Cache usage statistics.
+ */
+struct flash_cached_stats {
+	uint32_t hits;				/**< Number of cache lines read that were already cached. */
+	uint32_t misses;			/**< Number of cache lines read that needed a flash read. */
+};
+
+/**
+ * Variable context for a cached flash instance.
+ */
+struct flash_cached_state {
+	platform_mutex lock;			/**< Synchronization for cache accesses. */
+	uint32_t access;				/**< Counter used to find the least recently used line. */
+	struct flash_cached_stats stats;	/**< Cache usage statistics. */
+};
+
+/**
+ * Defines a flash implementation that adds a read cache to another flash device.  Data is cached
+ * in fixed size lines, and the least recently used line is replaced when a new line is needed.
+ * Writes and erases are passed directly to the flash device and invalidate any affected lines.
+ *
+ * Reads that cover an entire line that is not cached are not added to the cache, so large
+ * sequential reads do not push out small, frequently used regions like manifest headers.
+ */
+struct flash_cached {
+	struct flash base;						/**< Base flash API. */
+	struct flash_cached_state *state;		/**< Variable context for the cached instance. */
+	const struct flash *flash;				/**< The flash device being cached. */
+	struct flash_cached_line *lines;		/**< Tracking for each cache line. */
+	uint8_t *cache;							/**< Storage for the cached data. */
+	size_t line_count;						/**< The number of lines in the cache. */
+	uint32_t line_size;						/**< The number of bytes in each cache line. */
+};
+
+
+int flash_cached_init (struct flash_cached *cached, struct flash_cached_state *state,
+	const struct flash *flash, struct flash_cached_line *lines, uint8_t *cache, size_t line_count,
+	uint32_t line_size);
+int flash_cached_init_state (const struct flash_cached *cached);
+void flash_cached_release (const struct flash_cached *cached);
+
+int flash_cached_invalidate (const struct flash_cached *cached, uint32_t address, size_t length);
+void flash_cached_invalidate_all (const struct flash_cached *cached);
+int flash_cached_prefetch (const struct flash_cached *cached, uint32_t address, size_t length);
+
+int flash_cached_get_stats (const struct flash_cached *cached, struct flash_cached_stats *stats);
+void flash_cached_reset_stats (const struct flash_cached *cached);
+
+
+#endif /* FLASH_CACHED_H_ */
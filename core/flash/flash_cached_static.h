@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_CACHED_STATIC_H_
+#define FLASH_CACHED_STATIC_H_
+
+#include "flash_cached.h"
+
+
+/* Internal functions declared to allow for static initialization. */
+int flash_cached_get_device_size (const struct flash *flash, uint32_t *bytes);
+int flash_cached_read (const struct flash *flash, uint32_t address, uint8_t *data, size_t length);
+int flash_cached_get_page_size (const struct flash *flash, uint32_t *bytes);
+int flash_cached_minimum_write_per_page (const struct flash *flash, uint32_t *bytes);
+int flash_cached_write (const struct flash *flash, uint32_t address, const uint8_t *data,
+	size_t length);
+int flash_cached_get_sector_size (const struct flash *flash, uint32_t *bytes);
+int flash_cached_sector_erase (const struct flash *flash, uint32_t sector_addr);
+int flash_cached_get_block_size (const struct flash *flash, uint32_t *bytes);
+int flash_cached_block_erase (const struct flash *flash, uint32_t block_addr);
+int flash_cached_chip_erase (const struct flash *flash);
+
+/**
+ * Constant initializer for the cached flash APIs.
+ */
+#define	FLASH_CACHED_API_INIT  { \
+		.get_device_size = flash_cached_get_device_size, \
+		.read = flash_cached_read, \
+		.get_page_size = flash_cached_get_page_size, \
+		.minimum_write_per_page = flash_cached_minimum_write_per_page, \
+		.write = flash_cached_write, \
+		.get_sector_size = flash_cached_get_sector_size, \
+		.sector_erase = flash_cached_sector_erase, \
+		.get_block_size = flash_cached_get_block_size, \
+		.block_erase = flash_cached_block_erase, \
+		.chip_erase = flash_cached_chip_erase \
+	}
+
+/**
+ * Initialize a static instance of a cached flash device.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the cached flash.
+ * @param flash_ptr The flash device to cache.
+ * @param lines_ptr Tracking for each cache line.  There must be line_cnt entries.
+ * @param cache_ptr Storage for the cached data.  This must be line_cnt * line_sz bytes.
+ * @param line_cnt The number of lines in the cache.
+ * @param line_sz The number of bytes in each cache line.  This must be a power of two.
+ */
+#define	flash_cached_static_init(state_ptr, flash_ptr, lines_ptr, cache_ptr, line_cnt, line_sz) { \
+		.base = FLASH_CACHED_API_INIT, \
+		.state = state_ptr, \
+		.flash = flash_ptr, \
+		.lines = lines_ptr, \
+		.cache = cache_ptr, \
+		.line_count = line_cnt, \
+		.line_size = line_sz, \
+	}
+
+
+#endif /* FLASH_CACHED_STATIC_H_ */
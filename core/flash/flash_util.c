@@ -97,6 +97,42 @@ int flash_verify_noncontiguous_contents_at_offset (const struct flash *flash, ui
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
 	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length)
+{
+	uint8_t data[FLASH_HASH_BLOCK];
+
+	return flash_verify_noncontiguous_contents_buffered (flash, offset, regions, count, hash, type,
+		rsa, signature, sig_length, pub_key, hash_out, hash_length, data, sizeof (data));
+}
+
+/**
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device
+ * against an RSA encrypted signature, using a provided buffer to read the data.
+ *
+ * All regions will be verified starting at a fixed offset in flash.
+ *
+ * @param flash The flash device that contains the data to verify.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of flash regions that should be verified as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param pub_key The public key for the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
+ * @param hash_length The length of the hash output buffer.
+ * @param buffer Temporary storage to use for reading the flash data.
+ * @param length The length of the buffer.
+ *
+ * @return 0 if the flash contents are valid or an error code.
+ */
+int flash_verify_noncontiguous_contents_buffered (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
+	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length, uint8_t *buffer,
+	size_t length)
 {
 	uint8_t data_hash[SHA256_HASH_LENGTH];
 	int status;
@@ -127,8 +163,8 @@ int flash_verify_noncontiguous_contents_at_offset (const struct flash *flash, ui
 			return FLASH_UTIL_UNKNOWN_SIG_HASH;
 	}
 
-	status = flash_hash_noncontiguous_contents_at_offset (flash, offset, regions, count, hash, type,
-		hash_out, SHA256_HASH_LENGTH);
+	status = flash_hash_noncontiguous_contents_buffered (flash, offset, regions, count, hash, type,
+		hash_out, SHA256_HASH_LENGTH, buffer, length);
 	if (status != 0) {
 		return status;
 	}
@@ -325,11 +361,39 @@ int flash_hash_noncontiguous_contents (const struct flash *flash,
 int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	uint8_t *hash_out, size_t hash_length)
+{
+	uint8_t data[FLASH_HASH_BLOCK];
+
+	return flash_hash_noncontiguous_contents_buffered (flash, offset, regions, count, hash, type,
+		hash_out, hash_length, data, sizeof (data));
+}
+
+/**
+ * Generate a hash for a group of noncontiguous blocks of data stored in a flash device, using a
+ * provided buffer to read the data.  All regions will be hashed starting at a fixed offset in
+ * flash.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param type The type of hash to generate.
+ * @param hash_out The buffer to hold the generated hash value.
+ * @param hash_length The length of the hash output buffer.
+ * @param buffer Temporary storage to use for reading the flash data.
+ * @param length The length of the buffer.
+ *
+ * @return 0 if the hash was generated successfully or an error code.
+ */
+int flash_hash_noncontiguous_contents_buffered (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	uint8_t *hash_out, size_t hash_length, uint8_t *buffer, size_t length)
 {
 	int status;
 
 	if ((flash == NULL) || (regions == NULL) || (hash == NULL) || (hash_out == NULL) ||
-		(count == 0) || (hash_length == 0)) {
+		(count == 0) || (hash_length == 0) || (buffer == NULL) || (length == 0)) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
@@ -338,8 +402,8 @@ int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint
 		return status;
 	}
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (flash, offset, regions, count,
-		hash);
+	status = flash_hash_update_noncontiguous_contents_buffered (flash, offset, regions, count, hash,
+		buffer, length);
 	if (status != 0) {
 		goto fail;
 	}
@@ -421,38 +485,151 @@ int flash_hash_update_noncontiguous_contents (const struct flash *flash,
 int flash_hash_update_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash)
 {
-	uint8_t data[FLASH_VERIFICATION_BLOCK];
-	size_t next_read;
-	uint32_t current_addr;
-	size_t remaining;
-	size_t i;
+	uint8_t data[FLASH_HASH_BLOCK];
+
+	return flash_hash_update_noncontiguous_contents_buffered (flash, offset, regions, count, hash,
+		data, sizeof (data));
+}
+
+/**
+ * Determine the next block of flash data to hash from a group of regions.
+ *
+ * @param regions The group of regions being hashed.
+ * @param count The number of regions defined in the group.
+ * @param offset An offset to apply to each region address.
+ * @param max_length The maximum number of bytes to include in the block.
+ * @param region The region containing the next block.  This will be updated to point to the region
+ * that follows the block.
+ * @param done The number of bytes in the region that have already been handled.  This will be
+ * updated to include the block.
+ * @param address Output for the flash address of the block.
+ *
+ * @return The number of bytes in the block or 0 if there is no more data to hash.
+ */
+static size_t flash_hash_next_block (const struct flash_region *regions, size_t count,
+	uint32_t offset, size_t max_length, size_t *region, size_t *done, uint32_t *address)
+{
+	size_t length;
+
+	while ((*region < count) && (*done == regions[*region].length)) {
+		*region += 1;
+		*done = 0;
+	}
+
+	if (*region == count) {
+		return 0;
+	}
+
+	length = regions[*region].length - *done;
+	if (length > max_length) {
+		length = max_length;
+	}
+
+	*address = regions[*region].start_addr + offset + *done;
+	*done += length;
+
+	return length;
+}
+
+/**
+ * Update a hash for a group of noncontiguous blocks of data stored in a flash device, using a
+ * provided buffer to read the data.  All regions will be hashed starting at a fixed offset in
+ * flash.  Larger buffers reduce the number of flash read operations needed to hash the data.
+ *
+ * If the flash supports reading without blocking, the buffer is split in half and the next block
+ * of data is read into one half while the data in the other half is being hashed.  Otherwise, the
+ * entire buffer is used for each read.
+ *
+ * The hash context must already be started prior to this call.  The hashing context will not be
+ * canceled on failure.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param buffer Temporary storage to use for reading the flash data.
+ * @param length The length of the buffer.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+int flash_hash_update_noncontiguous_contents_buffered (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, uint8_t *buffer,
+	size_t length)
+{
+	uint8_t *data[2];
+	size_t block_len;
+	size_t next_len;
+	uint32_t next_addr;
+	size_t region = 0;
+	size_t done = 0;
+	int current = 0;
 	int status;
 
-	if ((flash == NULL) || (regions == NULL) || (count == 0) || (hash == NULL)) {
+	if ((flash == NULL) || (regions == NULL) || (count == 0) || (hash == NULL) ||
+		(buffer == NULL) || (length == 0)) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	for (i = 0; i < count; i++) {
-		current_addr = regions[i].start_addr + offset;
-		remaining = regions[i].length;
-
-		while (remaining > 0) {
-			next_read = (remaining < FLASH_VERIFICATION_BLOCK) ?
-				remaining : FLASH_VERIFICATION_BLOCK;
+	if ((flash->read_start == NULL) || (flash->read_wait == NULL) || (length < 2)) {
+		while ((block_len = flash_hash_next_block (regions, count, offset, length, &region, &done,
+			&next_addr)) != 0) {
+			status = flash->read (flash, next_addr, buffer, block_len);
+			if (status != 0) {
+				return status;
+			}
 
-			status = flash->read (flash, current_addr, data, next_read);
+			status = hash->update (hash, buffer, block_len);
 			if (status != 0) {
 				return status;
 			}
+		}
+
+		return 0;
+	}
+
+	length /= 2;
+	data[0] = buffer;
+	data[1] = &buffer[length];
+
+	block_len = flash_hash_next_block (regions, count, offset, length, &region, &done,
+		&next_addr);
+	if (block_len == 0) {
+		return 0;
+	}
 
-			status = hash->update (hash, data, next_read);
+	status = flash->read_start (flash, next_addr, data[current], block_len);
+	if (status != 0) {
+		return status;
+	}
+
+	while (block_len != 0) {
+		status = flash->read_wait (flash);
+		if (status != 0) {
+			return status;
+		}
+
+		next_len = flash_hash_next_block (regions, count, offset, length, &region, &done,
+			&next_addr);
+		if (next_len != 0) {
+			status = flash->read_start (flash, next_addr, data[!current], next_len);
 			if (status != 0) {
 				return status;
 			}
+		}
 
-			remaining -= next_read;
-			current_addr += next_read;
+		status = hash->update (hash, data[current], block_len);
+		if (status != 0) {
+			if (next_len != 0) {
+				/* Don't leave a read in progress into the caller's buffer. */
+				flash->read_wait (flash);
+			}
+
+			return status;
 		}
+
+		block_len = next_len;
+		current = !current;
 	}
 
 	return 0;
@@ -1096,6 +1273,133 @@ static int flash_sector_copy_data_region (const struct flash *dest_flash, uint32
 		flash_sector_erase_region, src_flash->get_sector_size, verify);
 }
 
+/**
+ * Copy data stored at one flash location to another flash location, only updating the destination
+ * sectors that don't already contain the source data.  Each sector is compared before any changes
+ * are made, and sectors that differ are erased, blank checked, and programmed.  The programmed data
+ * can optionally be verified.
+ *
+ * Source data is read into the provided buffer for comparison.  If the part of a sector being
+ * copied fits in the buffer, a changed sector is programmed directly from the buffer.  Otherwise,
+ * the source data for a changed sector is read again while it is being programmed.
+ *
+ * Erase blocks are on 4kB boundaries.
+ *
+ * @param dest_flash The flash device to copy data to.
+ * @param dest_addr The starting address of the region to copy to.
+ * @param src_flash The flash device to copy data from.
+ * @param src_addr The starting address of the region to copy from.
+ * @param length The size of the region to copy.
+ * @param verify Flag indicating if the copy should be verified after the data has been written to
+ * the destination.
+ * @param buffer Temporary storage to use for reading the source data.
+ * @param buf_length The length of the buffer.
+ * @param written Optional output for the number of bytes that were programmed in the destination.
+ * If an error occurs, this will contain the number of bytes programmed before the failure.
+ *
+ * @return 0 if the destination contains the source data or an error code.
+ */
+static int flash_sector_copy_data_region_if_changed (const struct flash *dest_flash,
+	uint32_t dest_addr, const struct flash *src_flash, uint32_t src_addr, size_t length,
+	uint8_t verify, uint8_t *buffer, size_t buf_length, size_t *written)
+{
+	uint32_t sector;
+	uint32_t page;
+	size_t sector_len;
+	size_t offset;
+	size_t read_len;
+	size_t total = 0;
+	int status;
+
+	if (written) {
+		*written = 0;
+	}
+
+	if ((dest_flash == NULL) || (src_flash == NULL) || (buffer == NULL) || (buf_length == 0)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if (length == 0) {
+		return 0;
+	}
+
+	status = dest_flash->get_sector_size (dest_flash, &sector);
+	if (status != 0) {
+		return status;
+	}
+
+	if (dest_flash == src_flash) {
+		status = flash_check_copy_region (dest_addr, src_addr, length, FLASH_REGION_MASK (sector));
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	status = dest_flash->get_page_size (dest_flash, &page);
+	if (status != 0) {
+		return status;
+	}
+
+	if (page > FLASH_MAX_COPY_BLOCK) {
+		return FLASH_UTIL_UNSUPPORTED_PAGE_SIZE;
+	}
+
+	while ((status == 0) && (length != 0)) {
+		sector_len = sector - FLASH_REGION_OFFSET (dest_addr, sector);
+		sector_len = (length > sector_len) ? sector_len : length;
+
+		/* Compare the sector, stopping at the first difference. */
+		offset = 0;
+		while ((status == 0) && (offset < sector_len)) {
+			read_len = sector_len - offset;
+			read_len = (read_len > buf_length) ? buf_length : read_len;
+
+			status = src_flash->read (src_flash, src_addr + offset, buffer, read_len);
+			if (status == 0) {
+				status = flash_check_region_for_data (dest_flash, dest_addr + offset, buffer,
+					read_len, false);
+				offset += read_len;
+			}
+		}
+
+		if (status == FLASH_UTIL_DATA_MISMATCH) {
+			status = dest_flash->sector_erase (dest_flash, FLASH_REGION_BASE (dest_addr, sector));
+			if (status == 0) {
+				status = flash_blank_check (dest_flash, dest_addr, sector_len);
+			}
+
+			if (status == 0) {
+				if (sector_len <= buf_length) {
+					/* The buffer already holds the source data for the whole sector. */
+					status = flash_program_data_ext (dest_flash, dest_addr, buffer, sector_len,
+						NULL);
+					if ((status == 0) && verify) {
+						status = flash_verify_data (dest_flash, dest_addr, buffer, sector_len);
+					}
+				}
+				else {
+					status = flash_copy_data_to_blank_region (dest_flash, dest_addr, src_flash,
+						src_addr, sector_len, page, verify);
+				}
+
+				if (status == 0) {
+					total += sector_len;
+				}
+			}
+		}
+
+		length -= sector_len;
+		dest_addr += sector_len;
+		src_addr += sector_len;
+	}
+
+	if (written) {
+		*written = total;
+	}
+
+	return status;
+}
+
 /**
  * Copy data stored at one location in a flash device to another location in the same flash device
  * after first erasing the destination region.  The source and destination regions must not overlap
@@ -1410,3 +1714,97 @@ int flash_copy_ext_to_blank_and_verify (const struct flash *dest_flash, uint32_t
 {
 	return flash_copy_data_region (dest_flash, dest_addr, src_flash, src_addr, length, NULL, 1);
 }
+
+/**
+ * Copy data stored in at a location in flash to another flash location, only erasing and
+ * programming the destination sectors whose contents differ from the source.  Sectors that already
+ * contain the source data are left untouched.  The source and destination flash devices can be the
+ * same or different devices.  If they are the same, then the source and destination regions must
+ * not overlap or be within the same erase block.
+ *
+ * Erase blocks are on 4kB boundaries.  Any sector that needs to be updated will be completely
+ * erased, even if the copy region only covers part of the sector.
+ *
+ * @param dest_flash The flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ * @param written Optional output for the number of bytes that needed to be programmed in the
+ * destination.
+ *
+ * @return 0 if the destination contains the source data or an error code.
+ */
+int flash_sector_copy_ext_if_changed (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, size_t *written)
+{
+	uint8_t data[FLASH_VERIFICATION_BLOCK];
+
+	return flash_sector_copy_data_region_if_changed (dest_flash, dest_addr, src_flash, src_addr,
+		length, 0, data, sizeof (data), written);
+}
+
+/**
+ * Copy data stored in at a location in flash to another flash location, only erasing and
+ * programming the destination sectors whose contents differ from the source.  Sectors that already
+ * contain the source data are left untouched.  The source and destination flash devices can be the
+ * same or different devices.  If they are the same, then the source and destination regions must
+ * not overlap or be within the same erase block.  Any sectors that get programmed will be verified.
+ *
+ * Erase blocks are on 4kB boundaries.  Any sector that needs to be updated will be completely
+ * erased, even if the copy region only covers part of the sector.
+ *
+ * @param dest_flash The flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ * @param written Optional output for the number of bytes that needed to be programmed in the
+ * destination.
+ *
+ * @return 0 if the destination contains the source data or an error code.
+ */
+int flash_sector_copy_ext_if_changed_and_verify (const struct flash *dest_flash,
+	uint32_t dest_addr, const struct flash *src_flash, uint32_t src_addr, size_t length,
+	size_t *written)
+{
+	uint8_t data[FLASH_VERIFICATION_BLOCK];
+
+	return flash_sector_copy_data_region_if_changed (dest_flash, dest_addr, src_flash, src_addr,
+		length, 1, data, sizeof (data), written);
+}
+
+/**
+ * Copy data stored in at a location in flash to another flash location, only erasing and
+ * programming the destination sectors whose contents differ from the source, using a provided
+ * buffer to read the source data.  Sectors that already contain the source data are left untouched.
+ * The source and destination flash devices can be the same or different devices.  If they are the
+ * same, then the source and destination regions must not overlap or be within the same erase block.
+ *
+ * A buffer at least as large as the flash sector allows each changed sector to be programmed from
+ * the data read during the comparison, so the source is only read once.  Smaller buffers reduce the
+ * size of each read but require changed sectors to be read again from the source.
+ *
+ * Erase blocks are on 4kB boundaries.  Any sector that needs to be updated will be completely
+ * erased, even if the copy region only covers part of the sector.
+ *
+ * @param dest_flash The flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ * @param verify Flag indicating if any programmed sectors should be verified.
+ * @param buffer Temporary storage to use for reading the source data.
+ * @param buf_length The length of the buffer.
+ * @param written Optional output for the number of bytes that needed to be programmed in the
+ * destination.
+ *
+ * @return 0 if the destination contains the source data or an error code.
+ */
+int flash_sector_copy_ext_if_changed_buffered (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, bool verify, uint8_t *buffer,
+	size_t buf_length, size_t *written)
+{
+	return flash_sector_copy_data_region_if_changed (dest_flash, dest_addr, src_flash, src_addr,
+		length, (verify) ? 1 : 0, buffer, buf_length, written);
+}
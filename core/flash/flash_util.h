@@ -11,6 +11,7 @@
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
 #include "crypto/signature_verification.h"
+#include "platform_config.h"
 
 
 /**
@@ -18,6 +19,17 @@
  */
 #define	FLASH_VERIFICATION_BLOCK	256
 
+/* Configurable flash utility parameters.  Defaults can be overridden in platform_config.h. */
+
+/**
+ * The size of the buffer used to read flash contents that are being hashed.  This buffer is
+ * allocated on the stack.  Callers that can provide a larger buffer from other memory can use
+ * flash_hash_update_noncontiguous_contents_buffered directly.
+ */
+#ifndef FLASH_HASH_BLOCK
+#define	FLASH_HASH_BLOCK			FLASH_VERIFICATION_BLOCK
+#endif
+
 /**
  * The maximum block size supported for flash copy operations.
  */
@@ -44,6 +56,11 @@ int flash_verify_noncontiguous_contents_at_offset (const struct flash *flash, ui
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
 	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length);
+int flash_verify_noncontiguous_contents_buffered (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
+	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length, uint8_t *buffer,
+	size_t length);
 
 int flash_contents_verification (const struct flash *flash, uint32_t start_addr, size_t length,
 	struct hash_engine *hash, enum hash_type type,
@@ -66,6 +83,9 @@ int flash_hash_noncontiguous_contents (const struct flash *flash,
 int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	uint8_t *hash_out, size_t hash_length);
+int flash_hash_noncontiguous_contents_buffered (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	uint8_t *hash_out, size_t hash_length, uint8_t *buffer, size_t length);
 
 int flash_hash_update_contents (const struct flash *flash, uint32_t start_addr, size_t length,
 	struct hash_engine *hash);
@@ -73,6 +93,9 @@ int flash_hash_update_noncontiguous_contents (const struct flash *flash,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash);
 int flash_hash_update_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash);
+int flash_hash_update_noncontiguous_contents_buffered (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, uint8_t *buffer,
+	size_t length);
 
 int flash_erase_region (const struct flash *flash, uint32_t start_addr, size_t length);
 int flash_sector_erase_region (const struct flash *flash, uint32_t start_addr, size_t length);
@@ -130,6 +153,15 @@ int flash_copy_ext_to_blank (const struct flash *dest_flash, uint32_t dest_addr,
 int flash_copy_ext_to_blank_and_verify (const struct flash *dest_flash, uint32_t dest_addr,
 	const struct flash *src_flash, uint32_t src_addr, size_t length);
 
+int flash_sector_copy_ext_if_changed (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, size_t *written);
+int flash_sector_copy_ext_if_changed_and_verify (const struct flash *dest_flash,
+	uint32_t dest_addr, const struct flash *src_flash, uint32_t src_addr, size_t length,
+	size_t *written);
+int flash_sector_copy_ext_if_changed_buffered (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, bool verify, uint8_t *buffer,
+	size_t buf_length, size_t *written);
+
 
 #define	FLASH_UTIL_ERROR(code)		ROT_ERROR (ROT_MODULE_FLASH_UTIL, code)
 
@@ -2,6 +2,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "flash_virtual_disk.h"
 
 
@@ -20,10 +23,145 @@ int flash_virtual_disk_get_device_size (const struct flash *virtual_flash, uint3
 	return 0;
 }
 
+/**
+ * Get the descriptor for the file backing the virtual flash, opening the file if it has not been
+ * opened yet.  The descriptor is kept open until the device is released, so each flash operation
+ * is a single system call.  This must be called with the state lock held.
+ *
+ * Since the descriptor refers to the file that was opened, rewriting the file in place (e.g. by
+ * opening it for writing, which truncates it) is seen by the virtual flash.  If the file is
+ * deleted or replaced by a new file at the same path, the virtual flash continues to use the old
+ * file until it is released and the state is initialized again.
+ *
+ * @param disk The virtual flash to access.
+ *
+ * @return The file descriptor or -1 if the file could not be opened.
+ */
+static int flash_virtual_disk_get_fd (const struct flash_virtual_disk *disk)
+{
+	if (disk->state->fd < 0) {
+		disk->state->fd = open (disk->disk_region, O_RDWR);
+		if (disk->state->fd < 0) {
+			/* A read-only file can still be used for reads.  Writes will fail. */
+			disk->state->fd = open (disk->disk_region, O_RDONLY);
+		}
+	}
+
+	return disk->state->fd;
+}
+
+/**
+ * Write data to the file backing the virtual flash.  This must be called with the state lock held.
+ *
+ * @param disk The virtual flash to write to.
+ * @param address The address to start writing to.
+ * @param data The data to write.
+ * @param length The number of bytes to write.
+ *
+ * @return 0 if all the data was written or -1 if not.
+ */
+static int flash_virtual_disk_write_file (const struct flash_virtual_disk *disk,
+	uint32_t address, const uint8_t *data, size_t length)
+{
+	int fd = flash_virtual_disk_get_fd (disk);
+	ssize_t bytes;
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	while (length > 0) {
+		bytes = pwrite (fd, data, length, address);
+		if (bytes <= 0) {
+			if ((bytes < 0) && (errno == EINTR)) {
+				continue;
+			}
+
+			return -1;
+		}
+
+		data += bytes;
+		address += bytes;
+		length -= bytes;
+	}
+
+	return 0;
+}
+
+/**
+ * Read data from the file backing the virtual flash.  This must be called with the state lock held.
+ *
+ * @param disk The virtual flash to read from.
+ * @param address The address to start reading from.
+ * @param data The buffer to hold the data that will be read.
+ * @param length The number of bytes to read.
+ *
+ * @return 0 if all the data was read or -1 if not.
+ */
+static int flash_virtual_disk_read_file (const struct flash_virtual_disk *disk,
+	uint32_t address, uint8_t *data, size_t length)
+{
+	int fd = flash_virtual_disk_get_fd (disk);
+	ssize_t bytes;
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	while (length > 0) {
+		bytes = pread (fd, data, length, address);
+		if (bytes <= 0) {
+			if ((bytes < 0) && (errno == EINTR)) {
+				continue;
+			}
+
+			return -1;
+		}
+
+		data += bytes;
+		address += bytes;
+		length -= bytes;
+	}
+
+	return 0;
+}
+
+/**
+ * Erase part of the file backing the virtual flash.  This must be called with the state lock held.
+ *
+ * @param disk The virtual flash to erase.
+ * @param address The address to start erasing from.
+ * @param length The number of bytes to erase.
+ *
+ * @return 0 if the data was erased or -1 if not.
+ */
+static int flash_virtual_disk_erase_file (const struct flash_virtual_disk *disk,
+	uint32_t address, size_t length)
+{
+	uint8_t erased[VIRTUAL_FLASH_DISK_ERASE_CHUNK];
+	size_t erase_len;
+
+	memset (erased, 0xff, sizeof (erased));
+
+	while (length > 0) {
+		erase_len = (length < sizeof (erased)) ? length : sizeof (erased);
+
+		if (flash_virtual_disk_write_file (disk, address, erased, erase_len) != 0) {
+			return -1;
+		}
+
+		address += erase_len;
+		length -= erase_len;
+	}
+
+	return 0;
+}
+
 int flash_virtual_disk_read (const struct flash *virtual_flash, uint32_t address, uint8_t *data,
 	size_t length)
 {
 	struct flash_virtual_disk *disk = (struct flash_virtual_disk*) virtual_flash;
+	int status;
 
 	if ((disk == NULL) || (data == NULL)) {
 		return FLASH_INVALID_ARGUMENT;
@@ -35,33 +173,114 @@ int flash_virtual_disk_read (const struct flash *virtual_flash, uint32_t address
 
 	platform_mutex_lock (&disk->state->lock);
 
-	FILE *file = fopen(disk->disk_region, "rb");
-    if (file == NULL) {
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_READ_FAILED;
-    }
+	status = flash_virtual_disk_read_file (disk, address, data, length);
+
+	platform_mutex_unlock (&disk->state->lock);
+
+	return (status == 0) ? 0 : FLASH_READ_FAILED;
+}
+
+int flash_virtual_disk_read_start (const struct flash *virtual_flash, uint32_t address,
+	uint8_t *data, size_t length)
+{
+	const struct flash_virtual_disk *disk = (const struct flash_virtual_disk*) virtual_flash;
+	struct aiocb *req;
+	int fd;
+	int status = 0;
 
-    if (fseek(file, address, SEEK_SET) != 0) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_READ_FAILED;
-    }
+	if ((disk == NULL) || (data == NULL)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
 
-    size_t bytes = fread(data, sizeof(uint8_t), length, file);
+	if ((address >= disk->size) || (length > (disk->size - address))) {
+		return FLASH_ADDRESS_OUT_OF_RANGE;
+	}
 
-    if (bytes < length) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_READ_FAILED;
-    }
+	platform_mutex_lock (&disk->state->lock);
 
-    fclose(file);
+	req = &disk->state->read_req;
+	fd = flash_virtual_disk_get_fd (disk);
+	if ((fd < 0) || disk->state->read_pending) {
+		status = FLASH_READ_FAILED;
+	}
+	else {
+		memset (req, 0, sizeof (*req));
+		req->aio_fildes = fd;
+		req->aio_offset = address;
+		req->aio_buf = data;
+		req->aio_nbytes = length;
+		req->aio_sigevent.sigev_notify = SIGEV_NONE;
+
+		if (aio_read (req) == 0) {
+			disk->state->read_pending = true;
+		}
+		else {
+			status = FLASH_READ_FAILED;
+		}
+	}
 
 	platform_mutex_unlock (&disk->state->lock);
 
+	return status;
+}
+
+/**
+ * Wait for the read started without waiting to complete.  This must be called with the state lock
+ * held.
+ *
+ * @param disk The virtual flash being read.
+ *
+ * @return 0 if all the requested data was read or -1 if not.
+ */
+static int flash_virtual_disk_wait_for_read (const struct flash_virtual_disk *disk)
+{
+	struct aiocb *req = &disk->state->read_req;
+	const struct aiocb *list[1] = {req};
+	ssize_t bytes;
+	int status;
+
+	while ((status = aio_error (req)) == EINPROGRESS) {
+		aio_suspend (list, 1, NULL);
+	}
+
+	disk->state->read_pending = false;
+	bytes = aio_return (req);
+	if ((status != 0) || (bytes <= 0)) {
+		return -1;
+	}
+
+	/* A read can complete with less data than requested, so read the rest directly. */
+	if ((size_t) bytes < req->aio_nbytes) {
+		return flash_virtual_disk_read_file (disk, req->aio_offset + bytes,
+			(uint8_t*) req->aio_buf + bytes, req->aio_nbytes - bytes);
+	}
+
 	return 0;
 }
 
+int flash_virtual_disk_read_wait (const struct flash *virtual_flash)
+{
+	const struct flash_virtual_disk *disk = (const struct flash_virtual_disk*) virtual_flash;
+	int status;
+
+	if (disk == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&disk->state->lock);
+
+	if (disk->state->read_pending) {
+		status = (flash_virtual_disk_wait_for_read (disk) == 0) ? 0 : FLASH_READ_FAILED;
+	}
+	else {
+		status = FLASH_READ_FAILED;
+	}
+
+	platform_mutex_unlock (&disk->state->lock);
+
+	return status;
+}
+
 
 int flash_virtual_disk_get_block_size (const struct flash *virtual_flash, uint32_t *bytes)
 {
@@ -78,6 +297,7 @@ int flash_virtual_disk_write (const struct flash *virtual_flash, uint32_t addres
 	const uint8_t *data, size_t length)
 {
 	struct flash_virtual_disk *disk = (struct flash_virtual_disk*) virtual_flash;
+	int status;
 
 	if ((disk == NULL) || (data == NULL)) {
 		return FLASH_INVALID_ARGUMENT;
@@ -89,37 +309,18 @@ int flash_virtual_disk_write (const struct flash *virtual_flash, uint32_t addres
 
 	platform_mutex_lock (&disk->state->lock);
 
-	FILE *file = fopen(disk->disk_region, "r+b");
-    if (file == NULL) {
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_WRITE_FAILED;
-    }
-
-    if (fseek(file, address, SEEK_SET) != 0) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_WRITE_FAILED;
-    }
-
-    size_t bytes = fwrite(data, sizeof(uint8_t), length, file);
-
-    if (bytes < length) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_WRITE_FAILED;
-    }
-
-    fclose(file);
+	status = flash_virtual_disk_write_file (disk, address, data, length);
 
 	platform_mutex_unlock (&disk->state->lock);
 
-	return bytes;
+	return (status == 0) ? (int) length : FLASH_WRITE_FAILED;
 }
 
 
 int flash_virtual_disk_block_erase (const struct flash *virtual_flash, uint32_t address)
 {
 	const struct flash_virtual_disk *disk = (const struct flash_virtual_disk*) virtual_flash;
+	int status;
 
 	if (disk == NULL) {
 		return FLASH_INVALID_ARGUMENT;
@@ -131,77 +332,60 @@ int flash_virtual_disk_block_erase (const struct flash *virtual_flash, uint32_t
 
 	address = FLASH_REGION_BASE (address, VIRTUAL_FLASH_DISK_BLOCK_SIZE);
 
-	uint8_t *buffer = malloc(VIRTUAL_FLASH_DISK_BLOCK_SIZE * sizeof (uint8_t));
-	memset(buffer, 0xFF, VIRTUAL_FLASH_DISK_BLOCK_SIZE);
-
 	platform_mutex_lock (&disk->state->lock);
 
-	FILE *file = fopen(disk->disk_region, "r+b");
-    if (file == NULL) {
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_BLOCK_ERASE_FAILED;
-    }
-
-    if (fseek(file, address, SEEK_SET) != 0) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_BLOCK_ERASE_FAILED;
-    }
-
-    size_t bytes = fwrite(buffer, sizeof(uint8_t), VIRTUAL_FLASH_DISK_BLOCK_SIZE, file);
-
-    if (bytes < VIRTUAL_FLASH_DISK_BLOCK_SIZE) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_BLOCK_ERASE_FAILED;
-    }
-
-    fclose(file);
+	status = flash_virtual_disk_erase_file (disk, address, VIRTUAL_FLASH_DISK_BLOCK_SIZE);
 
 	platform_mutex_unlock (&disk->state->lock);
 
-	free(buffer);
-	return 0;
+	return (status == 0) ? 0 : FLASH_BLOCK_ERASE_FAILED;
 }
 
 
 int flash_virtual_disk_region_erase (const struct flash *virtual_flash)
 {
 	const struct flash_virtual_disk *disk = (const struct flash_virtual_disk*) virtual_flash;
+	int status;
 
 	if (disk == NULL) {
 		return FLASH_INVALID_ARGUMENT;
 	}
 
-	uint8_t *buffer = malloc(disk->size * sizeof (uint8_t));
-	memset(buffer, 0xFF, disk->size);
-
 	platform_mutex_lock (&disk->state->lock);
 
-	FILE *file = fopen(disk->disk_region, "r+b");
-    if (file == NULL) {
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_CHIP_ERASE_FAILED;
-    }
+	status = flash_virtual_disk_erase_file (disk, 0, disk->size);
 
-    size_t bytes = fwrite(buffer, sizeof(uint8_t), disk->size, file);
+	platform_mutex_unlock (&disk->state->lock);
 
-    if (bytes < VIRTUAL_FLASH_DISK_BLOCK_SIZE) {
-        fclose(file);
-        platform_mutex_unlock (&disk->state->lock);
-        return FLASH_CHIP_ERASE_FAILED;
-    }
+	return (status == 0) ? 0 : FLASH_CHIP_ERASE_FAILED;
+}
 
-    fclose(file);
+/**
+ * Flush data written to the virtual flash to the backing file on disk.  Written data is always
+ * visible to other readers of the file, so this is only needed to make the contents durable.
+ *
+ * @param virtual_flash The virtual flash to flush.
+ *
+ * @return 0 if the data was flushed or an error code.
+ */
+int flash_virtual_disk_sync (struct flash_virtual_disk *virtual_flash)
+{
+	int status = 0;
 
-	platform_mutex_unlock (&disk->state->lock);
+	if (virtual_flash == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
 
-	free(buffer);
-	return 0;
-}
+	platform_mutex_lock (&virtual_flash->state->lock);
 
+	if ((virtual_flash->state->fd >= 0) && (fsync (virtual_flash->state->fd) != 0)) {
+		status = FLASH_WRITE_FAILED;
+	}
 
+	platform_mutex_unlock (&virtual_flash->state->lock);
 
+	return status;
+}
 
 
 /**
@@ -233,6 +417,8 @@ int flash_virtual_disk_init (struct flash_virtual_disk *virtual_flash, const cha
 	virtual_flash->base.get_block_size = flash_virtual_disk_get_block_size;
 	virtual_flash->base.chip_erase = flash_virtual_disk_region_erase;
 	virtual_flash->base.block_erase = flash_virtual_disk_block_erase;
+	virtual_flash->base.read_start = flash_virtual_disk_read_start;
+	virtual_flash->base.read_wait = flash_virtual_disk_read_wait;
 
 	virtual_flash->size = size;
 	virtual_flash->state = state_ptr;
@@ -261,6 +447,7 @@ int flash_virtual_disk_init_state (struct flash_virtual_disk *virtual_flash)
 	}
 
 	memset (virtual_flash->state, 0, sizeof (struct flash_virtual_disk_state));
+	virtual_flash->state->fd = -1;
 
 	return platform_mutex_init (&virtual_flash->state->lock);
 }
@@ -274,6 +461,15 @@ int flash_virtual_disk_init_state (struct flash_virtual_disk *virtual_flash)
 void flash_virtual_disk_release (struct flash_virtual_disk *virtual_flash)
 {
 	if (virtual_flash) {
+		if (virtual_flash->state->read_pending) {
+			flash_virtual_disk_wait_for_read (virtual_flash);
+		}
+
+		if (virtual_flash->state->fd >= 0) {
+			close (virtual_flash->state->fd);
+			virtual_flash->state->fd = -1;
+		}
+
 		platform_mutex_free (&virtual_flash->state->lock);
 	}
 }
\ No newline at end of file
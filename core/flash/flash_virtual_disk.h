@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <aio.h>
 #include "status/rot_status.h"
 #include "platform_api.h"
 #include "flash.h"
@@ -15,6 +16,11 @@
  * Block size of the virtual flash instance.
  */
 #define	VIRTUAL_FLASH_DISK_BLOCK_SIZE		256
+
+/**
+ * Number of bytes written at a time when erasing the virtual flash.
+ */
+#define	VIRTUAL_FLASH_DISK_ERASE_CHUNK		4096
    
 
 enum {
@@ -30,12 +36,18 @@ enum {
  */
 struct flash_virtual_disk_state {
 	platform_mutex lock;			            /**< Lock to synchronize access to the hardware. */
+	int fd;										/**< Descriptor for the backing file, or -1 if it is not open. */
+	struct aiocb read_req;						/**< Context for a read started without waiting. */
+	bool read_pending;							/**< Flag indicating a read has been started but not completed. */
 };
 
 
 /**
  * Defines a flash implementation that uses disk as a virtual flash device. This can be
  * used in the same way as any other flash device.
+ *
+ * The backing file is opened on first access and stays open until the device is released.  A
+ * backing file that is replaced rather than rewritten in place will not be seen until then.
  */
 struct flash_virtual_disk {
 	struct flash base;							/**< Base flash API. */
@@ -50,5 +62,7 @@ int flash_virtual_disk_init (struct flash_virtual_disk *virtual_flash, const cha
 int flash_virtual_disk_init_state (struct flash_virtual_disk *virtual_disk);
 void flash_virtual_disk_release (struct flash_virtual_disk *virtual_disk);
 
+int flash_virtual_disk_sync (struct flash_virtual_disk *virtual_flash);
+
 
 #endif /* FLASH_VIRTUAL_DISK_H_ */
\ No newline at end of file
@@ -154,6 +154,9 @@ void host_flash_manager_free_images (struct host_flash_manager_images *host_img)
  * @param pfm The PFM to use for validation.
  * @param hash The hash to use for image validation.
  * @param rsa The RSA engine to use for signature verification.
+ * @param verify Optional scheduler to verify the images on flash with multiple workers.  If this is
+ * null, images are verified sequentially using the provided hash and RSA engines.  Full flash
+ * validation always uses the provided engines.
  * @param full_validation Flag to control level of flash validation.
  * @param flash The flash device to validate.
  * @param host_rw Output for the read/write regions of the validated flash.  This will only be
@@ -162,11 +165,11 @@ void host_flash_manager_free_images (struct host_flash_manager_images *host_img)
  * @return 0 if the validation was successful or an error code.
  */
 int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash,
-	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash,
-	struct host_flash_manager_rw_regions *host_rw)
+	struct rsa_engine *rsa, const struct host_fw_verify_scheduler *verify, bool full_validation,
+	const struct spi_flash *flash, struct host_flash_manager_rw_regions *host_rw)
 {
-	return host_flash_manager_validate_offset_flash (pfm, hash, rsa, full_validation, flash, 0,
-		host_rw);
+	return host_flash_manager_validate_offset_flash (pfm, hash, rsa, verify, full_validation, flash,
+		0, host_rw);
 }
 
 /**
@@ -175,6 +178,9 @@ int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash
  * @param pfm The PFM to use for validation.
  * @param hash The hash to use for image validation.
  * @param rsa The RSA engine to use for signature verification.
+ * @param verify Optional scheduler to verify the images on flash with multiple workers.  If this is
+ * null, images are verified sequentially using the provided hash and RSA engines.  Full flash
+ * validation always uses the provided engines.
  * @param full_validation Flag to control level of flash validation.
  * @param flash The flash device to validate.
  * @param offset An offset in flash for images that will be validated.  Ignored if full_validation
@@ -185,8 +191,8 @@ int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash
  * @return 0 if the validation was successful or an error code.
  */
 int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
-	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash, uint32_t offset,
-	struct host_flash_manager_rw_regions *host_rw)
+	struct rsa_engine *rsa, const struct host_fw_verify_scheduler *verify, bool full_validation,
+	const struct spi_flash *flash, uint32_t offset, struct host_flash_manager_rw_regions *host_rw)
 {
 	struct pfm_firmware host_fw;
 	struct pfm_firmware_versions versions;
@@ -219,6 +225,10 @@ int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engin
 		status = host_fw_full_flash_verification_multiple_fw (flash, host_img.fw_images,
 			host_rw->writable, host_fw.count, version->blank_byte, hash, rsa);
 	}
+	else if (verify) {
+		status = host_fw_verify_scheduler_verify_offset_images_multiple_fw (verify, flash,
+			host_img.fw_images, host_img.count, offset);
+	}
 	else {
 		status = host_fw_verify_offset_images_multiple_fw (flash, host_img.fw_images,
 			host_img.count, offset, hash, rsa);
@@ -242,6 +252,8 @@ free_host:
  * @param good_pfm The PFM that is known to be good for the flash image.
  * @param hash The hash to use for image validation.
  * @param rsa The RSA engine to use for signature verification.
+ * @param verify Optional scheduler to verify the images on flash with multiple workers.  If this is
+ * null, images are verified sequentially using the provided hash and RSA engines.
  * @param flash The flash device to validate.
  * @param host_rw Output for the read/write regions of the validated flash.  This will only be
  * valid if the flash is successfully validated.  This can be null.
@@ -249,7 +261,8 @@ free_host:
  * @return 0 if the validation was successful or an error code.
  */
 int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
-	struct hash_engine *hash, struct rsa_engine *rsa, const struct spi_flash *flash,
+	struct hash_engine *hash, struct rsa_engine *rsa,
+	const struct host_fw_verify_scheduler *verify, const struct spi_flash *flash,
 	struct host_flash_manager_rw_regions *host_rw)
 {
 	struct pfm_firmware host_fw;
@@ -292,7 +305,11 @@ int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
 		pfm->free_fw_versions (pfm, &versions);
 	}
 
-	if (match_status != 0) {
+	if ((match_status != 0) && verify) {
+		status = host_fw_verify_scheduler_verify_images_multiple_fw (verify, flash,
+			host_img.fw_images, host_img.count);
+	}
+	else if (match_status != 0) {
 		status = host_fw_verify_images_multiple_fw (flash, host_img.fw_images, host_img.count, hash,
 			rsa);
 	}
@@ -15,6 +15,7 @@
 #include "manifest/pfm/pfm_manager.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
+#include "host_fw_verify_scheduler.h"
 
 
 /**
@@ -242,13 +243,14 @@ int host_flash_manager_get_firmware_types (struct pfm *pfm, struct pfm_firmware
 	struct host_flash_manager_images *host_img, struct host_flash_manager_rw_regions *host_rw);
 
 int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash,
-	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash,
-	struct host_flash_manager_rw_regions *host_rw);
+	struct rsa_engine *rsa, const struct host_fw_verify_scheduler *verify, bool full_validation,
+	const struct spi_flash *flash, struct host_flash_manager_rw_regions *host_rw);
 int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
-	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash, uint32_t offset,
-	struct host_flash_manager_rw_regions *host_rw);
+	struct rsa_engine *rsa, const struct host_fw_verify_scheduler *verify, bool full_validation,
+	const struct spi_flash *flash, uint32_t offset, struct host_flash_manager_rw_regions *host_rw);
 int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
-	struct hash_engine *hash, struct rsa_engine *rsa, const struct spi_flash *flash,
+	struct hash_engine *hash, struct rsa_engine *rsa,
+	const struct host_fw_verify_scheduler *verify, const struct spi_flash *flash,
 	struct host_flash_manager_rw_regions *host_rw);
 
 int host_flash_manager_get_flash_read_write_regions (const struct spi_flash *flash, struct pfm *pfm,
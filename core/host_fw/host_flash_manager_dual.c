@@ -47,19 +47,20 @@ static int host_flash_manager_dual_validate_read_only_flash (struct host_flash_m
 	struct pfm *pfm, struct pfm *good_pfm, struct hash_engine *hash, struct rsa_engine *rsa,
 	bool full_validation, struct host_flash_manager_rw_regions *host_rw)
 {
+	struct host_flash_manager_dual *dual = (struct host_flash_manager_dual*) manager;
 	int status;
 
-	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
+	if ((dual == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
 		(host_rw == NULL)) {
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
 	if (good_pfm && !full_validation) {
-		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa,
+		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa, dual->verify,
 			host_flash_manager_dual_get_read_only_flash (manager), host_rw);
 	}
 	else {
-		status = host_flash_manager_validate_flash (pfm, hash, rsa, full_validation,
+		status = host_flash_manager_validate_flash (pfm, hash, rsa, dual->verify, full_validation,
 			host_flash_manager_dual_get_read_only_flash (manager), host_rw);
 	}
 
@@ -75,7 +76,7 @@ static int host_flash_manager_dual_validate_read_write_flash (struct host_flash_
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
-	return host_flash_manager_validate_flash (pfm, hash, rsa, true,
+	return host_flash_manager_validate_flash (pfm, hash, rsa, NULL, true,
 		host_flash_manager_dual_get_read_write_flash (manager), host_rw);
 }
 
@@ -423,3 +424,19 @@ void host_flash_manager_dual_release (struct host_flash_manager_dual *manager)
 {
 	UNUSED (manager);
 }
+
+/**
+ * Use a scheduler to verify host images with multiple workers.  Only images that are verified
+ * against the PFM use the scheduler.  Full flash validation always runs on the calling task.
+ *
+ * @param manager The manager to update.
+ * @param verify The scheduler to use for image verification.  Set this to null to verify images
+ * sequentially with the engines provided for each validation.
+ */
+void host_flash_manager_dual_set_verify_scheduler (struct host_flash_manager_dual *manager,
+	const struct host_fw_verify_scheduler *verify)
+{
+	if (manager) {
+		manager->verify = verify;
+	}
+}
@@ -19,6 +19,7 @@ struct host_flash_manager_dual {
 	const struct spi_filter_interface *filter;			/**< The SPI filter connected to the flash devices. */
 	const struct flash_mfg_filter_handler *mfg_handler;	/**< The filter handler for flash device types. */
 	struct host_flash_initialization *flash_init;		/**< Host flash initialization manager. */
+	const struct host_fw_verify_scheduler *verify;		/**< Scheduler for verifying host images. */
 };
 
 
@@ -32,5 +33,8 @@ int host_flash_manager_dual_init_with_managed_flash_initialization (
 	struct host_flash_initialization *flash_init);
 void host_flash_manager_dual_release (struct host_flash_manager_dual *manager);
 
+void host_flash_manager_dual_set_verify_scheduler (struct host_flash_manager_dual *manager,
+	const struct host_fw_verify_scheduler *verify);
+
 
 #endif /* HOST_FLASH_MANAGER_DUAL_H_ */
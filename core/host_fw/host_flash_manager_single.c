@@ -44,11 +44,12 @@ static int host_flash_manager_single_validate_read_only_flash (struct host_flash
 	}
 
 	if (good_pfm && !full_validation) {
-		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa, single->flash, host_rw);
+		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa, single->verify,
+			single->flash, host_rw);
 	}
 	else {
-		status = host_flash_manager_validate_flash (pfm, hash, rsa, full_validation, single->flash,
-			host_rw);
+		status = host_flash_manager_validate_flash (pfm, hash, rsa, single->verify,
+			full_validation, single->flash, host_rw);
 	}
 
 	return status;
@@ -64,7 +65,7 @@ static int host_flash_manager_single_validate_read_write_flash (struct host_flas
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
-	return host_flash_manager_validate_flash (pfm, hash, rsa, true, single->flash, host_rw);
+	return host_flash_manager_validate_flash (pfm, hash, rsa, NULL, true, single->flash, host_rw);
 }
 
 static int host_flash_manager_single_get_flash_read_write_regions (
@@ -351,3 +352,19 @@ void host_flash_manager_single_release (struct host_flash_manager_single *manage
 {
 	UNUSED (manager);
 }
+
+/**
+ * Use a scheduler to verify host images with multiple workers.  Only images that are verified
+ * against the PFM use the scheduler.  Full flash validation always runs on the calling task.
+ *
+ * @param manager The manager to update.
+ * @param verify The scheduler to use for image verification.  Set this to null to verify images
+ * sequentially with the engines provided for each validation.
+ */
+void host_flash_manager_single_set_verify_scheduler (struct host_flash_manager_single *manager,
+	const struct host_fw_verify_scheduler *verify)
+{
+	if (manager) {
+		manager->verify = verify;
+	}
+}
@@ -6,7 +6,9 @@
 #include <string.h>
 #include "platform_api.h"
 #include "host_fw_util.h"
+#include "host_logging.h"
 #include "flash/flash_util.h"
+#include "logging/debug_log.h"
 
 
 /**
@@ -316,6 +318,77 @@ bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
 	return false;
 }
 
+/**
+ * Determine if an image in a list has been flagged for validation.
+ *
+ * @param img_list The list of images to query.
+ * @param index Index in the list of the image to check.
+ *
+ * @return true if the image should always be validated or false if not.
+ */
+bool host_fw_is_image_validation_required (const struct pfm_image_list *img_list, size_t index)
+{
+	if (img_list->images_sig) {
+		return img_list->images_sig[index].always_validate;
+	}
+	else {
+		return img_list->images_hash[index].always_validate;
+	}
+}
+
+/**
+ * Verify that a single image on the flash is valid.  The image will be checked regardless of the
+ * image validation flag.
+ *
+ * All image addresses specified in the PFM will be offset by a fixed amount.
+ *
+ * @param flash The flash that contains the image to validate.
+ * @param img_list The list of images containing the image to validate.
+ * @param index Index in the list of the image to validate.
+ * @param offset The offset to apply to image addresses.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if the image is good or an error code.
+ */
+int host_fw_verify_offset_image (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t index, uint32_t offset, struct hash_engine *hash,
+	struct rsa_engine *rsa)
+{
+	uint8_t img_hash[SHA512_HASH_LENGTH];
+	uint8_t data[HOST_FW_HASH_BLOCK];
+	int status;
+
+	if ((flash == NULL) || (img_list == NULL) || (hash == NULL) || (rsa == NULL) ||
+		(index >= img_list->count)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	/* Host images can be many megabytes, so read them in blocks larger than the default used by
+	 * the flash utilities to reduce the number of flash commands. */
+	if (img_list->images_sig) {
+		return flash_verify_noncontiguous_contents_buffered (&flash->base, offset,
+			img_list->images_sig[index].regions, img_list->images_sig[index].count, hash,
+			HASH_TYPE_SHA256, rsa, img_list->images_sig[index].signature,
+			img_list->images_sig[index].sig_length, &img_list->images_sig[index].key, NULL, 0,
+			data, sizeof (data));
+	}
+
+	status = flash_hash_noncontiguous_contents_buffered (&flash->base, offset,
+		img_list->images_hash[index].regions, img_list->images_hash[index].count, hash,
+		img_list->images_hash[index].hash_type, img_hash, sizeof (img_hash), data, sizeof (data));
+	if (status != 0) {
+		return status;
+	}
+
+	if (memcmp (img_list->images_hash[index].hash, img_hash,
+		img_list->images_hash[index].hash_length) != 0) {
+		return HOST_FW_UTIL_BAD_IMAGE_HASH;
+	}
+
+	return 0;
+}
+
 /**
  * Verify that images on the flash are valid.  All image addresses specified in the PFM will be
  * offset by a fixed amount.
@@ -334,38 +407,18 @@ static int host_fw_verify_images_on_flash (const struct spi_flash *flash,
 	struct hash_engine *hash, struct rsa_engine *rsa)
 {
 	size_t i;
-	int status = 0;
+	int status;
 
 	for (i = 0; i < img_list->count; i++) {
-		if (img_list->images_sig) {
-			if (validate_all || img_list->images_sig[i].always_validate) {
-				status = flash_verify_noncontiguous_contents_at_offset (&flash->base, offset,
-					img_list->images_sig[i].regions, img_list->images_sig[i].count, hash,
-					HASH_TYPE_SHA256, rsa, img_list->images_sig[i].signature,
-					img_list->images_sig[i].sig_length, &img_list->images_sig[i].key, NULL, 0);
-				if (status != 0) {
-					return status;
-				}
-			}
-		}
-		else if (validate_all || img_list->images_hash[i].always_validate) {
-			uint8_t img_hash[SHA512_HASH_LENGTH];
-
-			status = flash_hash_noncontiguous_contents_at_offset (&flash->base, offset,
-				img_list->images_hash[i].regions, img_list->images_hash[i].count, hash,
-				img_list->images_hash[i].hash_type, img_hash, sizeof (img_hash));
+		if (validate_all || host_fw_is_image_validation_required (img_list, i)) {
+			status = host_fw_verify_offset_image (flash, img_list, i, offset, hash, rsa);
 			if (status != 0) {
 				return status;
 			}
-
-			if (memcmp (img_list->images_hash[i].hash, img_hash,
-				img_list->images_hash[i].hash_length) != 0) {
-				return HOST_FW_UTIL_BAD_IMAGE_HASH;
-			}
 		}
 	}
 
-	return status;
+	return 0;
 }
 
 /**
@@ -676,15 +729,44 @@ bool host_fw_are_read_write_regions_different (const struct pfm_read_write_regio
 	return host_fw_are_regions_different (rw1->regions, rw1->count, rw2->regions, rw2->count);
 }
 
+/**
+ * Copy a read/write region from one flash device to another, only erasing and programming the
+ * destination sectors that don't already match the source.  Any programmed sectors are verified.
+ * The number of bytes that needed to be programmed is reported in the debug log.
+ *
+ * @param dest The flash device that will receive the read/write data.
+ * @param src The flash device that contains the read/write data.
+ * @param region The read/write region to copy.
+ *
+ * @return 0 if the destination region contains the source data or an error code.
+ */
+static int host_fw_copy_read_write_region (const struct spi_flash *dest,
+	const struct spi_flash *src, const struct flash_region *region)
+{
+	uint8_t data[HOST_FW_COPY_BLOCK];
+	size_t written = 0;
+	int status;
+
+	status = flash_sector_copy_ext_if_changed_buffered (&dest->base, region->start_addr,
+		&src->base, region->start_addr, region->length, true, data, sizeof (data), &written);
+	if ((status == 0) && (written != 0)) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_HOST_FW,
+			HOST_LOGGING_RW_DATA_COPIED, region->start_addr, written);
+	}
+
+	return status;
+}
+
 /**
  * Migrate the read/write data from one flash device to another.  The migration will only happen if
  * the read/write regions defined for the two flash devices are exactly the same.  Any change in
  * defined read/write regions will cause the migration to fail.  It is possible to bypass this error
  * checking and force the migration, if that behavior is necessary.
  *
- * The read/write regions of the destination flash are always erased, even if the migration can't
- * happen.  This ensures blank data on the destination read/write regions instead of allowing
- * data previously in that location to persist.
+ * The read/write regions of the destination flash are always erased if the migration can't happen.
+ * This ensures blank data on the destination read/write regions instead of allowing data
+ * previously in that location to persist.  When the data is migrated, only destination sectors
+ * that don't already match the source data are erased and programmed.
  *
  * @param dest The flash device that will receive the read/write data.
  * @param dest_writable The read/write regions defined on the destination flash.
@@ -718,22 +800,14 @@ int host_fw_migrate_read_write_data (const struct spi_flash *dest,
 
 	last_addr = 0;
 	dest_pos = host_fw_find_next_rw_region (last_addr, dest_writable, 1);
-	while (dest_pos) {
-		status = flash_erase_region_and_verify (&dest->base, dest_pos->start_addr,
-			dest_pos->length);
-		if (status != 0) {
-			return status;
-		}
-
-		if (src_writable && !migrate_fail) {
-			src_pos = host_fw_find_next_rw_region (last_addr, src_writable, 1);
-			if (src_pos) {
-				if (dest_pos->start_addr != src_pos->start_addr) {
-					migrate_fail = HOST_FW_UTIL_DIFF_REGION_ADDR;
-				}
-				else if (dest_pos->length != src_pos->length) {
-					migrate_fail = HOST_FW_UTIL_DIFF_REGION_SIZE;
-				}
+	while (dest_pos && src_writable && !migrate_fail) {
+		src_pos = host_fw_find_next_rw_region (last_addr, src_writable, 1);
+		if (src_pos) {
+			if (dest_pos->start_addr != src_pos->start_addr) {
+				migrate_fail = HOST_FW_UTIL_DIFF_REGION_ADDR;
+			}
+			else if (dest_pos->length != src_pos->length) {
+				migrate_fail = HOST_FW_UTIL_DIFF_REGION_SIZE;
 			}
 		}
 
@@ -741,15 +815,19 @@ int host_fw_migrate_read_write_data (const struct spi_flash *dest,
 		dest_pos = host_fw_find_next_rw_region (last_addr, dest_writable, 1);
 	}
 
-	if (migrate_fail) {
-		return migrate_fail;
-	}
-
 	last_addr = 0;
 	dest_pos = host_fw_find_next_rw_region (last_addr, dest_writable, 1);
 	while (dest_pos) {
-		status = flash_copy_ext_to_blank_and_verify (&dest->base, dest_pos->start_addr, &src->base,
-			dest_pos->start_addr, dest_pos->length);
+		if (migrate_fail) {
+			status = flash_erase_region_and_verify (&dest->base, dest_pos->start_addr,
+				dest_pos->length);
+		}
+		else {
+			/* Most read/write data doesn't change between resets, so skip any sectors that
+			 * already match instead of erasing and reprogramming the entire region. */
+			status = host_fw_copy_read_write_region (dest, src, dest_pos);
+		}
+
 		if (status != 0) {
 			return status;
 		}
@@ -758,7 +836,7 @@ int host_fw_migrate_read_write_data (const struct spi_flash *dest,
 		dest_pos = host_fw_find_next_rw_region (last_addr, dest_writable, 1);
 	}
 
-	return 0;
+	return migrate_fail;
 }
 
 /**
@@ -902,7 +980,8 @@ int host_fw_restore_flash_device (const struct spi_flash *restore, const struct
 /**
  * Restore the read/write data in a flash device.  Based on the configuration of each region, the
  * destination flash will either be left unchanged, completely erased, or copied from a different
- * flash device.
+ * flash device.  When a region is copied, only sectors that differ from the other flash device are
+ * erased and programmed.
  *
  * @param restore The flash device that should be restored.
  * @param from The device to restore data from.  If this is null, regions that are configured to be
@@ -933,9 +1012,8 @@ int host_fw_restore_read_write_data (const struct spi_flash *restore, const stru
 
 			case PFM_RW_RESTORE:
 				if (from != NULL) {
-					status = flash_copy_ext_and_verify (&restore->base,
-						writable->regions[i].start_addr, &from->base,
-						writable->regions[i].start_addr, writable->regions[i].length);
+					status = host_fw_copy_read_write_region (restore, from,
+						&writable->regions[i]);
 					if (status != 0) {
 						return status;
 					}
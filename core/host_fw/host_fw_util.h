@@ -12,6 +12,27 @@
 #include "spi_filter/spi_filter_interface.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
+#include "platform_config.h"
+
+
+/* Configurable host firmware parameters.  Defaults can be overridden in platform_config.h. */
+
+/**
+ * The size of the buffer used to read host firmware images from flash while they are being
+ * verified.  This buffer is allocated on the stack of the task running the verification.
+ */
+#ifndef HOST_FW_HASH_BLOCK
+#define	HOST_FW_HASH_BLOCK			4096
+#endif
+
+/**
+ * The size of the buffer used to compare and copy read/write data between flash devices.  When this
+ * is at least as large as a flash sector, changed sectors are programmed from the data already read
+ * for the comparison.  This buffer is allocated on the stack of the task running the copy.
+ */
+#ifndef HOST_FW_COPY_BLOCK
+#define	HOST_FW_COPY_BLOCK			4096
+#endif
 
 
 int host_fw_determine_version (const struct spi_flash *flash,
@@ -22,6 +43,11 @@ int host_fw_determine_offset_version (const struct spi_flash *flash, uint32_t of
 bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
 	const struct pfm_image_list *img_list2);
 
+bool host_fw_is_image_validation_required (const struct pfm_image_list *img_list, size_t index);
+int host_fw_verify_offset_image (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t index, uint32_t offset, struct hash_engine *hash,
+	struct rsa_engine *rsa);
+
 int host_fw_verify_images (const struct spi_flash *flash, const struct pfm_image_list *img_list,
 	struct hash_engine *hash, struct rsa_engine *rsa);
 int host_fw_verify_offset_images (const struct spi_flash *flash,
@@ -0,0 +1,372 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <string.h>
+#include "host_fw_verify_scheduler.h"
+#include "host_fw_util.h"
+
+
+/**
+ * Claim the next image from the active job that needs to be verified.  The scheduler lock must be
+ * held.
+ *
+ * Once an image has failed verification, no images after it in the list will be claimed since they
+ * cannot change the result.
+ *
+ * @param state The scheduler state containing the active job.
+ * @param fw Output for the firmware component containing the claimed image.
+ * @param img Output for the index of the claimed image.
+ * @param seq Output for the position of the claimed image across all firmware components.
+ *
+ * @return true if an image was claimed or false if there are no more images to verify.
+ */
+static bool host_fw_verify_scheduler_claim_image (struct host_fw_verify_scheduler_state *state,
+	size_t *fw, size_t *img, size_t *seq)
+{
+	while (state->next_fw < state->fw_count) {
+		if (state->next_img >= state->img_list[state->next_fw].count) {
+			state->next_fw++;
+			state->next_img = 0;
+			continue;
+		}
+
+		if (state->next_seq > state->fail_seq) {
+			return false;
+		}
+
+		*fw = state->next_fw;
+		*img = state->next_img;
+		*seq = state->next_seq;
+
+		state->next_img++;
+		state->next_seq++;
+
+		if (host_fw_is_image_validation_required (&state->img_list[*fw], *img)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Check if the active job has images that have not been claimed.  The scheduler lock must be held.
+ *
+ * This does not check if the remaining images need to be validated, so it can report images that
+ * would not be claimed.
+ *
+ * @param state The scheduler state containing the active job.
+ *
+ * @return true if there may be more images to claim or false if there are none.
+ */
+static bool host_fw_verify_scheduler_has_images (const struct host_fw_verify_scheduler_state *state)
+{
+	return (state->next_fw < state->fw_count) && (state->next_seq <= state->fail_seq);
+}
+
+/**
+ * Verify images from the active job until there are no more images left to claim.
+ *
+ * @param scheduler The scheduler running the job.
+ * @param worker The engines to use for verification.
+ */
+static void host_fw_verify_scheduler_process_images (
+	const struct host_fw_verify_scheduler *scheduler, const struct host_fw_verify_worker *worker)
+{
+	struct host_fw_verify_scheduler_state *state = scheduler->state;
+	size_t fw;
+	size_t img;
+	size_t seq;
+	int status;
+
+	platform_mutex_lock (&state->lock);
+
+	while (host_fw_verify_scheduler_claim_image (state, &fw, &img, &seq)) {
+		platform_mutex_unlock (&state->lock);
+
+		status = host_fw_verify_offset_image (state->flash, &state->img_list[fw], img,
+			state->offset, worker->hash, worker->rsa);
+
+		platform_mutex_lock (&state->lock);
+
+		if ((status != 0) && (seq < state->fail_seq)) {
+			state->fail_seq = seq;
+			state->fail_status = status;
+		}
+	}
+
+	platform_mutex_unlock (&state->lock);
+}
+
+/**
+ * Initialize a scheduler for verifying host firmware images.
+ *
+ * @param scheduler The scheduler to initialize.
+ * @param state Variable context for the scheduler.
+ * @param workers Engines for each worker.  The first entry is used by the task requesting
+ * verification.  The remaining entries are used by helper tasks run by the platform.
+ * @param worker_count The number of workers.
+ *
+ * @return 0 if the scheduler was initialized successfully or an error code.
+ */
+int host_fw_verify_scheduler_init (struct host_fw_verify_scheduler *scheduler,
+	struct host_fw_verify_scheduler_state *state, const struct host_fw_verify_worker *workers,
+	size_t worker_count)
+{
+	if (scheduler == NULL) {
+		return HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	memset (scheduler, 0, sizeof (struct host_fw_verify_scheduler));
+
+	scheduler->state = state;
+	scheduler->workers = workers;
+	scheduler->worker_count = worker_count;
+
+	return host_fw_verify_scheduler_init_state (scheduler);
+}
+
+/**
+ * Initialize only the variable state for a verification scheduler.  The rest of the instance is
+ * assumed to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param scheduler The scheduler that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int host_fw_verify_scheduler_init_state (const struct host_fw_verify_scheduler *scheduler)
+{
+	size_t i;
+	int status;
+
+	if ((scheduler == NULL) || (scheduler->state == NULL) || (scheduler->workers == NULL)) {
+		return HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	if (scheduler->worker_count == 0) {
+		return HOST_FW_VERIFY_SCHEDULER_NO_WORKERS;
+	}
+
+	for (i = 0; i < scheduler->worker_count; i++) {
+		if ((scheduler->workers[i].hash == NULL) || (scheduler->workers[i].rsa == NULL)) {
+			return HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT;
+		}
+	}
+
+	memset (scheduler->state, 0, sizeof (struct host_fw_verify_scheduler_state));
+
+	status = platform_mutex_init (&scheduler->state->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_semaphore_init (&scheduler->state->work);
+	if (status != 0) {
+		goto free_lock;
+	}
+
+	status = platform_semaphore_init (&scheduler->state->done);
+	if (status != 0) {
+		goto free_work;
+	}
+
+	return 0;
+
+free_work:
+	platform_semaphore_free (&scheduler->state->work);
+free_lock:
+	platform_mutex_free (&scheduler->state->lock);
+	return status;
+}
+
+/**
+ * Release the resources used by a verification scheduler.  No verification can be in progress.
+ *
+ * @param scheduler The scheduler to release.
+ */
+void host_fw_verify_scheduler_release (const struct host_fw_verify_scheduler *scheduler)
+{
+	if (scheduler) {
+		platform_semaphore_free (&scheduler->state->done);
+		platform_semaphore_free (&scheduler->state->work);
+		platform_mutex_free (&scheduler->state->lock);
+	}
+}
+
+/**
+ * Verify that images from multiple different firmware components on the flash are valid.  Only
+ * images flagged for validation will be checked.
+ *
+ * @param scheduler The scheduler to use for verification.
+ * @param flash The flash that contains the images to validate.
+ * @param img_list An array of firmware images that should be validated.
+ * @param fw_count The number of firmware components in the list.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_scheduler_verify_images_multiple_fw (
+	const struct host_fw_verify_scheduler *scheduler, const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count)
+{
+	return host_fw_verify_scheduler_verify_offset_images_multiple_fw (scheduler, flash, img_list,
+		fw_count, 0);
+}
+
+/**
+ * Verify that images from multiple different firmware components on the flash are valid.  Only
+ * images flagged for validation will be checked.
+ *
+ * All image addresses specified in the PFM will be offset by a fixed amount.
+ *
+ * The calling task verifies images using the first worker.  Any helper workers that are waiting
+ * for a job will verify images in parallel.  This call will not return until all workers have
+ * finished with the images they claimed.
+ *
+ * @param scheduler The scheduler to use for verification.
+ * @param flash The flash that contains the images to validate.
+ * @param img_list An array of firmware images that should be validated.
+ * @param fw_count The number of firmware components in the list.
+ * @param offset The offset to apply to image addresses.
+ *
+ * @return 0 if all images that should be validated are good or an error code.  If multiple
+ * images are not valid, the error for the first of these images in the list is reported.
+ */
+int host_fw_verify_scheduler_verify_offset_images_multiple_fw (
+	const struct host_fw_verify_scheduler *scheduler, const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset)
+{
+	struct host_fw_verify_scheduler_state *state;
+	int status;
+
+	if ((scheduler == NULL) || (flash == NULL) || (img_list == NULL)) {
+		return HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	state = scheduler->state;
+
+	platform_mutex_lock (&state->lock);
+
+	if (state->active) {
+		platform_mutex_unlock (&state->lock);
+		return HOST_FW_VERIFY_SCHEDULER_BUSY;
+	}
+
+	state->flash = flash;
+	state->img_list = img_list;
+	state->fw_count = fw_count;
+	state->offset = offset;
+	state->next_fw = 0;
+	state->next_img = 0;
+	state->next_seq = 0;
+	state->fail_seq = SIZE_MAX;
+	state->fail_status = 0;
+	state->running = 0;
+	state->waiting = false;
+	state->active = true;
+
+	platform_mutex_unlock (&state->lock);
+
+	/* Only one helper is woken here.  Each helper that joins the job wakes the next one, so this
+	 * doesn't depend on the semaphore being able to count. */
+	if (scheduler->worker_count > 1) {
+		platform_semaphore_post (&state->work);
+	}
+
+	host_fw_verify_scheduler_process_images (scheduler, &scheduler->workers[0]);
+
+	/* All images have been claimed.  Stop any more helpers from joining the job and wait for the
+	 * ones still working to finish. */
+	platform_mutex_lock (&state->lock);
+
+	state->active = false;
+
+	/* Helpers only signal for work while the job is active, so a wakeup that wasn't consumed can be
+	 * discarded now without being replaced. */
+	platform_semaphore_reset (&state->work);
+
+	if (state->running != 0) {
+		state->waiting = true;
+		platform_mutex_unlock (&state->lock);
+
+		platform_semaphore_wait (&state->done, 0);
+
+		platform_mutex_lock (&state->lock);
+	}
+
+	status = state->fail_status;
+
+	platform_mutex_unlock (&state->lock);
+
+	return status;
+}
+
+/**
+ * Run a helper worker for the scheduler.  This will wait for a verification job to be started and
+ * then verify images from that job until there are no more images to claim.
+ *
+ * This must be called repeatedly from a task dedicated to the worker.  Each helper worker must be
+ * run from a different task.
+ *
+ * @param scheduler The scheduler the worker belongs to.
+ * @param worker Index of the worker being run.  This cannot be the first worker, since that worker
+ * is used by the task requesting verification.
+ * @param ms_timeout The amount of time to wait for a job to be started, in milliseconds.
+ * Specifying a timeout of 0 will wait indefinitely.
+ *
+ * @return 0 if the worker was woken up, 1 if the timeout expired, or an error code.  A worker can
+ * be woken up after the job has already completed, in which case no images will be verified.
+ */
+int host_fw_verify_scheduler_run_worker (const struct host_fw_verify_scheduler *scheduler,
+	size_t worker, uint32_t ms_timeout)
+{
+	struct host_fw_verify_scheduler_state *state;
+	int status;
+
+	if (scheduler == NULL) {
+		return HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	if ((worker == 0) || (worker >= scheduler->worker_count)) {
+		return HOST_FW_VERIFY_SCHEDULER_INVALID_WORKER;
+	}
+
+	state = scheduler->state;
+
+	status = platform_semaphore_wait (&state->work, ms_timeout);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&state->lock);
+
+	if (!state->active) {
+		platform_mutex_unlock (&state->lock);
+		return 0;
+	}
+
+	state->running++;
+
+	/* Wake another helper if there are any left waiting and images for them to verify. */
+	if ((state->running < (scheduler->worker_count - 1)) &&
+		host_fw_verify_scheduler_has_images (state)) {
+		platform_semaphore_post (&state->work);
+	}
+
+	platform_mutex_unlock (&state->lock);
+
+	host_fw_verify_scheduler_process_images (scheduler, &scheduler->workers[worker]);
+
+	platform_mutex_lock (&state->lock);
+
+	state->running--;
+	if ((state->running == 0) && state->waiting) {
+		platform_semaphore_post (&state->done);
+	}
+
+	platform_mutex_unlock (&state->lock);
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HOST_FW_VERIFY_SCHEDULER_H_
+#define HOST_FW_VERIFY_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+#include "platform_api.h"
+#include "manifest/pfm/pfm.h"
+#include "flash/spi_flash.h"
+#include "crypto/hash.h"
+#include "crypto/rsa.h"
+
+
+/**
+ * Engines used by a single verification worker.  Engines are never shared between workers, so
+ * each worker must have its own instances.
+ */
+struct host_fw_verify_worker {
+	struct hash_engine *hash;			/**< Hash engine used by the worker. */
+	struct rsa_engine *rsa;				/**< RSA engine used by the worker. */
+};
+
+/**
+ * Variable context for a verification scheduler.
+ */
+struct host_fw_verify_scheduler_state {
+	platform_mutex lock;					/**< Synchronization for the verification job. */
+	platform_semaphore work;				/**< Signaled to wake the next helper worker for the job. */
+	platform_semaphore done;				/**< Signaled when the last busy helper finishes a job. */
+	const struct spi_flash *flash;			/**< Flash that contains the images being verified. */
+	const struct pfm_image_list *img_list;	/**< Image lists for each firmware component. */
+	size_t fw_count;						/**< Number of firmware components being verified. */
+	uint32_t offset;						/**< Offset to apply to image addresses. */
+	size_t next_fw;							/**< Firmware component of the next image to verify. */
+	size_t next_img;						/**< Index of the next image to verify. */
+	size_t next_seq;						/**< Position of the next image across all components. */
+	size_t fail_seq;						/**< Position of the first image that failed. */
+	int fail_status;						/**< Verification status of the first image that failed. */
+	size_t running;							/**< Number of helper workers processing the job. */
+	bool active;							/**< Flag indicating a job is in progress. */
+	bool waiting;							/**< Flag indicating the job owner waits for helpers. */
+};
+
+/**
+ * Verifies images from multiple firmware components using a pool of workers.  Images are
+ * independent of each other, so each image is claimed by the next available worker and checked
+ * with that worker's engines.  The result is the same as sequential verification:  the error
+ * reported is from the first failing image in list order.
+ *
+ * The scheduler does not create any tasks.  The caller requesting verification always acts as the
+ * first worker.  Every additional worker needs a task provided by the platform that repeatedly
+ * calls host_fw_verify_scheduler_run_worker.  With a single worker, or if no helper tasks are
+ * running, all images are verified by the calling task.
+ *
+ * Helper workers share the flash device with the caller.  Flash accesses are serialized by the
+ * flash driver, but hashing and signature verification for different images will run in
+ * parallel.
+ */
+struct host_fw_verify_scheduler {
+	struct host_fw_verify_scheduler_state *state;	/**< Variable context for the scheduler. */
+	const struct host_fw_verify_worker *workers;	/**< Engines for each worker. */
+	size_t worker_count;							/**< The number of workers. */
+};
+
+
+int host_fw_verify_scheduler_init (struct host_fw_verify_scheduler *scheduler,
+	struct host_fw_verify_scheduler_state *state, const struct host_fw_verify_worker *workers,
+	size_t worker_count);
+int host_fw_verify_scheduler_init_state (const struct host_fw_verify_scheduler *scheduler);
+void host_fw_verify_scheduler_release (const struct host_fw_verify_scheduler *scheduler);
+
+int host_fw_verify_scheduler_verify_images_multiple_fw (
+	const struct host_fw_verify_scheduler *scheduler, const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count);
+int host_fw_verify_scheduler_verify_offset_images_multiple_fw (
+	const struct host_fw_verify_scheduler *scheduler, const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset);
+
+int host_fw_verify_scheduler_run_worker (const struct host_fw_verify_scheduler *scheduler,
+	size_t worker, uint32_t ms_timeout);
+
+
+#define	HOST_FW_VERIFY_SCHEDULER_ERROR(code)		ROT_ERROR (ROT_MODULE_HOST_FW_VERIFY_SCHEDULER, code)
+
+/**
+ * Error codes that can be generated by the host firmware verification scheduler.
+ */
+enum {
+	HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT = HOST_FW_VERIFY_SCHEDULER_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	HOST_FW_VERIFY_SCHEDULER_NO_MEMORY = HOST_FW_VERIFY_SCHEDULER_ERROR (0x01),			/**< Memory allocation failed. */
+	HOST_FW_VERIFY_SCHEDULER_NO_WORKERS = HOST_FW_VERIFY_SCHEDULER_ERROR (0x02),		/**< No workers were provided to the scheduler. */
+	HOST_FW_VERIFY_SCHEDULER_BUSY = HOST_FW_VERIFY_SCHEDULER_ERROR (0x03),				/**< Verification is already in progress. */
+	HOST_FW_VERIFY_SCHEDULER_INVALID_WORKER = HOST_FW_VERIFY_SCHEDULER_ERROR (0x04),	/**< The worker index is not for a helper worker. */
+};
+
+
+#endif /* HOST_FW_VERIFY_SCHEDULER_H_ */
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HOST_FW_VERIFY_SCHEDULER_STATIC_H_
+#define HOST_FW_VERIFY_SCHEDULER_STATIC_H_
+
+#include "host_fw_verify_scheduler.h"
+
+
+/**
+ * Initialize a static instance of a host firmware verification scheduler.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the scheduler.
+ * @param workers_ptr Engines for each worker.
+ * @param count The number of workers.
+ */
+#define	host_fw_verify_scheduler_static_init(state_ptr, workers_ptr, count)	{ \
+		.state = state_ptr, \
+		.workers = workers_ptr, \
+		.worker_count = count, \
+	}
+
+
+#endif /* HOST_FW_VERIFY_SCHEDULER_STATIC_H_ */
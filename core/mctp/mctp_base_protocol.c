@@ -133,7 +133,8 @@ int mctp_base_protocol_interpret (uint8_t *buf, size_t buf_len, uint8_t dest_add
  * @param buf Payload for the packet.
  * @param buf_len Length of the payload.
  * @param out_buf Output for the constructed packet.  It is allowed to have the output buffer
- * overlap the input buffer.
+ * overlap the input buffer.  If the payload is already at the payload location in the output
+ * buffer, the packet is constructed around it without copying the payload.
  * @param out_buf_len Maximum constructed packet length.
  * @param source_addr Source SMBus address.
  * @param dest_eid Destination EID for the packet.
@@ -170,7 +171,10 @@ int mctp_base_protocol_construct (uint8_t *buf, size_t buf_len, uint8_t *out_buf
 		return MCTP_BASE_PROTOCOL_BUF_TOO_SMALL;
 	}
 
-	memmove (&out_buf[msg_offset], buf, buf_len);
+	if (buf != &out_buf[msg_offset]) {
+		memmove (&out_buf[msg_offset], buf, buf_len);
+	}
+
 	memset (header, 0, sizeof (struct mctp_base_protocol_transport_header));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
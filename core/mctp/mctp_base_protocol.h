@@ -225,6 +225,8 @@ enum {
 	MCTP_BASE_PROTOCOL_UNSUPPORTED_OPERATION = MCTP_BASE_PROTOCOL_ERROR (0x0f),	/**< Requested operation not supported by device. */
 	MCTP_BASE_PROTOCOL_ERROR_RESPONSE = MCTP_BASE_PROTOCOL_ERROR (0x10),		/**< Error response received. */
 	MCTP_BASE_PROTOCOL_FAIL_RESPONSE = MCTP_BASE_PROTOCOL_ERROR (0x11),			/**< Response processing failed. */
+	MCTP_BASE_PROTOCOL_NO_TAG_AVAILABLE = MCTP_BASE_PROTOCOL_ERROR (0x12),		/**< All message tags are in use by outstanding requests. */
+	MCTP_BASE_PROTOCOL_TOO_MANY_REQUESTS = MCTP_BASE_PROTOCOL_ERROR (0x13),		/**< The maximum number of requests are already waiting for a response. */
 };
 
 
@@ -38,6 +38,7 @@ int mctp_interface_init (struct mctp_interface *mctp, struct cmd_interface *cmd_
 #ifdef CMD_ENABLE_ISSUE_REQUEST
 	int status;
 #endif
+	int i;
 
 	if ((mctp == NULL) || (cmd_cerberus == NULL) || (cmd_mctp == NULL) || (device_mgr == NULL)) {
 		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
@@ -46,15 +47,21 @@ int mctp_interface_init (struct mctp_interface *mctp, struct cmd_interface *cmd_
 	memset (mctp, 0, sizeof (struct mctp_interface));
 
 #ifdef CMD_ENABLE_ISSUE_REQUEST
-	status = platform_semaphore_init (&mctp->wait_for_response);
+	status = platform_mutex_init (&mctp->lock);
 	if (status != 0) {
 		return status;
 	}
 
-	status = platform_mutex_init (&mctp->lock);
-	if (status != 0) {
-		platform_semaphore_free (&mctp->wait_for_response);
-		return status;
+	for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+		status = platform_semaphore_init (&mctp->pending[i].complete);
+		if (status != 0) {
+			while (i-- > 0) {
+				platform_semaphore_free (&mctp->pending[i].complete);
+			}
+
+			platform_mutex_free (&mctp->lock);
+			return status;
+		}
 	}
 #endif
 
@@ -67,6 +74,13 @@ int mctp_interface_init (struct mctp_interface *mctp, struct cmd_interface *cmd_
 	mctp->req_buffer.data =
 		&mctp->msg_buffer[sizeof (mctp->msg_buffer) - MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
 	mctp->resp_buffer.data = mctp->msg_buffer;
+	mctp->resp_packets.data = mctp->msg_buffer;
+	mctp->resp_packets.length = sizeof (mctp->msg_buffer);
+	mctp->resp_packets.header_len = sizeof (struct mctp_base_protocol_transport_header);
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		mctp->msg_contexts[i].msg.data = mctp->msg_contexts[i].data;
+	}
 
 	return 0;
 }
@@ -78,9 +92,16 @@ int mctp_interface_init (struct mctp_interface *mctp, struct cmd_interface *cmd_
  */
 void mctp_interface_deinit (struct mctp_interface *mctp)
 {
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+	int i;
+#endif
+
 	if (mctp != NULL) {
 #ifdef CMD_ENABLE_ISSUE_REQUEST
-		platform_semaphore_free (&mctp->wait_for_response);
+		for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+			platform_semaphore_free (&mctp->pending[i].complete);
+		}
+
 		platform_mutex_free (&mctp->lock);
 #endif
 	}
@@ -105,11 +126,276 @@ int mctp_interface_set_channel_id (struct mctp_interface *mctp, int channel_id)
 	return 0;
 }
 
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+/**
+ * Find the request that is waiting for a response.  This must be called while holding the lock.
+ *
+ * @param mctp The MCTP interface to search.
+ * @param eid EID of the device that sent the response.
+ * @param msg_tag Message tag of the response.
+ *
+ * @return The pending request or null if no request is waiting for the response.
+ */
+static struct mctp_interface_pending_request* mctp_interface_find_pending_request (
+	struct mctp_interface *mctp, uint8_t eid, uint8_t msg_tag)
+{
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+		if (mctp->pending[i].active && (mctp->pending[i].eid == eid) &&
+			(mctp->pending[i].msg_tag == msg_tag)) {
+			return &mctp->pending[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Stop waiting for the response to a request.  This must be called while holding the lock.
+ *
+ * @param mctp The MCTP interface that sent the request.
+ * @param pending The request to release.
+ */
+static void mctp_interface_release_pending_request (struct mctp_interface *mctp,
+	struct mctp_interface_pending_request *pending)
+{
+	pending->active = false;
+
+	if (pending->no_wait) {
+		mctp->outstanding_requests--;
+		if ((mctp->outstanding_requests == 0) &&
+			(mctp->rsp_state == MCTP_INTERFACE_RESPONSE_WAITING)) {
+			mctp->rsp_state = MCTP_INTERFACE_RESPONSE_IDLE;
+		}
+	}
+}
+
+/**
+ * Stop waiting for the responses to all requests sent to a device without waiting.  This must be
+ * called while holding the lock.
+ *
+ * @param mctp The MCTP interface that sent the requests.
+ * @param eid EID of the device the requests were sent to.
+ */
+static void mctp_interface_release_no_wait_requests (struct mctp_interface *mctp, uint8_t eid)
+{
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+		if (mctp->pending[i].active && mctp->pending[i].no_wait && (mctp->pending[i].eid == eid)) {
+			mctp_interface_release_pending_request (mctp, &mctp->pending[i]);
+		}
+	}
+}
+
+/**
+ * Allocate a message tag and pending request entry for a new request.  The tag will not be in use
+ * by any other request to the same device.  This must be called while holding the lock.
+ *
+ * If every entry is in use, the oldest request that is not being waited on is discarded.
+ *
+ * @param mctp The MCTP interface sending the request.
+ * @param eid EID of the device the request will be sent to.
+ * @param no_wait Flag indicating the requester will not wait for the response.
+ * @param pending Output for the pending request entry.
+ *
+ * @return 0 if the request entry was allocated or an error code.
+ */
+static int mctp_interface_alloc_pending_request (struct mctp_interface *mctp, uint8_t eid,
+	bool no_wait, struct mctp_interface_pending_request **pending)
+{
+	struct mctp_interface_pending_request *entry = NULL;
+	struct mctp_interface_pending_request *oldest = NULL;
+	uint8_t tags_used = 0;
+	uint8_t msg_tag;
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+		if (!mctp->pending[i].active) {
+			if (entry == NULL) {
+				entry = &mctp->pending[i];
+			}
+		}
+		else {
+			if (mctp->pending[i].eid == eid) {
+				tags_used |= (1U << mctp->pending[i].msg_tag);
+			}
+
+			if (mctp->pending[i].no_wait && ((oldest == NULL) ||
+				((mctp->pending[i].sequence - oldest->sequence) & 0x80000000))) {
+				oldest = &mctp->pending[i];
+			}
+		}
+	}
+
+	for (i = 0; i < 8; i++) {
+		msg_tag = (mctp->response_msg_tag + i) % 8;
+		if (!(tags_used & (1U << msg_tag))) {
+			break;
+		}
+	}
+
+	if (i == 8) {
+		return MCTP_BASE_PROTOCOL_NO_TAG_AVAILABLE;
+	}
+
+	if (entry == NULL) {
+		if (oldest == NULL) {
+			return MCTP_BASE_PROTOCOL_TOO_MANY_REQUESTS;
+		}
+
+		mctp_interface_release_pending_request (mctp, oldest);
+		entry = oldest;
+	}
+
+	entry->eid = eid;
+	entry->msg_tag = msg_tag;
+	entry->no_wait = no_wait;
+	entry->state = MCTP_INTERFACE_RESPONSE_WAITING;
+	entry->sequence = ++mctp->pending_count;
+	entry->active = true;
+
+	if (no_wait) {
+		mctp->outstanding_requests++;
+		mctp->rsp_state = MCTP_INTERFACE_RESPONSE_WAITING;
+	}
+
+	*pending = entry;
+	return 0;
+}
+
+/**
+ * Complete a request after the response has been processed.
+ *
+ * @param mctp The MCTP interface that sent the request.
+ * @param eid EID of the device that sent the response.
+ * @param msg_tag Message tag of the response.
+ * @param state The result of processing the response.
+ */
+static void mctp_interface_complete_pending_request (struct mctp_interface *mctp, uint8_t eid,
+	uint8_t msg_tag, enum mctp_interface_response_state state)
+{
+	struct mctp_interface_pending_request *pending;
+
+	platform_mutex_lock (&mctp->lock);
+
+	mctp->response_msg_tag = (msg_tag + 1) % 8;
+
+	pending = mctp_interface_find_pending_request (mctp, eid, msg_tag);
+	if (pending != NULL) {
+		pending->state = state;
+
+		if (pending->no_wait) {
+			mctp_interface_release_pending_request (mctp, pending);
+			if (mctp->outstanding_requests == 0) {
+				mctp->rsp_state = state;
+			}
+		}
+		else {
+			/* The requester releases the entry once it wakes up. */
+			platform_semaphore_post (&pending->complete);
+		}
+	}
+
+	platform_mutex_unlock (&mctp->lock);
+}
+#endif
+
+/**
+ * Find the context reassembling a message.  Any context that has not received a packet within the
+ * timeout is discarded.
+ *
+ * @param mctp The MCTP interface to search.
+ * @param src_eid Source EID of the message.
+ * @param msg_tag Message tag of the message.
+ * @param tag_owner Tag owner of the message.
+ *
+ * @return The context for the message or null if the message is not being reassembled.
+ */
+static struct mctp_interface_msg_context* mctp_interface_find_msg_context (
+	struct mctp_interface *mctp, uint8_t src_eid, uint8_t msg_tag, uint8_t tag_owner)
+{
+	struct mctp_interface_msg_context *context;
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		context = &mctp->msg_contexts[i];
+		if (!context->active) {
+			continue;
+		}
+
+		if (platform_has_timeout_expired (&context->timeout) == 1) {
+			context->active = false;
+			continue;
+		}
+
+		if ((context->msg.source_eid == src_eid) && (context->msg_tag == msg_tag) &&
+			(context->tag_owner == tag_owner)) {
+			return context;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Get a context to start reassembling a new message.  If every context is in use, the one that
+ * least recently received a packet is discarded.
+ *
+ * @param mctp The MCTP interface to get a context from.
+ *
+ * @return The context to use for the new message.
+ */
+static struct mctp_interface_msg_context* mctp_interface_alloc_msg_context (
+	struct mctp_interface *mctp)
+{
+	struct mctp_interface_msg_context *oldest = &mctp->msg_contexts[0];
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		if (!mctp->msg_contexts[i].active) {
+			return &mctp->msg_contexts[i];
+		}
+
+		if ((mctp->msg_contexts[i].last_used - oldest->last_used) & 0x80000000) {
+			oldest = &mctp->msg_contexts[i];
+		}
+	}
+
+	return oldest;
+}
+
+/**
+ * Check if any message is being reassembled.
+ *
+ * @param mctp The MCTP interface to check.
+ * @param src_eid Source EID to check for messages from.
+ * @param any_eid Flag to check for messages from any source EID.
+ *
+ * @return true if a matching message is being reassembled.
+ */
+static bool mctp_interface_is_reassembling (struct mctp_interface *mctp, uint8_t src_eid,
+	bool any_eid)
+{
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		if (mctp->msg_contexts[i].active &&
+			(any_eid || (mctp->msg_contexts[i].msg.source_eid == src_eid))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /**
  * Generate packets for full MCTP message from payload
  *
  * @param device_mgr Device manager instance to utilize
- * @param payload Buffer with payload bytes
+ * @param payload Buffer with payload bytes.  Null if the payload has already been written to the
+ * payload location of each packet in buf.
  * @param payload_len Length of payload bytes
  * @param buf Buffer to fill with generated MCTP packets
  * @param max_buf_len Maximum length of buf
@@ -131,6 +417,7 @@ static int mctp_interface_generate_packets_from_payload (struct device_manager *
 	uint8_t packet_seq = 0;
 	size_t max_packet_payload;
 	size_t packet_payload_len;
+	uint8_t *packet_payload;
 	size_t i_payload = 0;
 	size_t i_buf = 0;
 	bool som = true;
@@ -148,7 +435,14 @@ static int mctp_interface_generate_packets_from_payload (struct device_manager *
 			packet_payload_len = payload_len;
 		}
 
-		status = mctp_base_protocol_construct (&payload[i_payload], packet_payload_len, &buf[i_buf],
+		if (payload != NULL) {
+			packet_payload = &payload[i_payload];
+		}
+		else {
+			packet_payload = &buf[i_buf + sizeof (struct mctp_base_protocol_transport_header)];
+		}
+
+		status = mctp_base_protocol_construct (packet_payload, packet_payload_len, &buf[i_buf],
 			max_buf_len - i_buf, src_addr, dest_eid, src_eid, som, eom, packet_seq, msg_tag,
 			tag_owner, dest_addr);
 		if (ROT_IS_ERROR (status)) {
@@ -174,6 +468,8 @@ static int mctp_interface_generate_packets_from_payload (struct device_manager *
  * Construct an MCTP packet for an error response.
  *
  * @param mctp MCTP interface instance.
+ * @param context The context of the message that caused the error.  The message is discarded if
+ * an error response is generated.  Null if the error is not for a message being reassembled.
  * @param cerberus_eid EID of Cerberus device.
  * @param packets Output for the buffer containing the error message.
  * @param error_code Identifier for the error.
@@ -188,10 +484,10 @@ static int mctp_interface_generate_packets_from_payload (struct device_manager *
  *
  * @return 0 if the packet was successfully constructed or an error code.
  */
-static int mctp_interface_generate_error_packet (struct mctp_interface *mctp, int cerberus_eid,
-	struct cmd_message **message, uint8_t error_code, uint32_t error_data, uint8_t src_eid,
-	uint8_t dest_eid, uint8_t msg_tag, uint8_t response_addr, uint8_t source_addr, uint8_t cmd_set,
-	uint8_t tag_owner)
+static int mctp_interface_generate_error_packet (struct mctp_interface *mctp,
+	struct mctp_interface_msg_context *context, int cerberus_eid, struct cmd_message **message,
+	uint8_t error_code, uint32_t error_data, uint8_t src_eid, uint8_t dest_eid, uint8_t msg_tag,
+	uint8_t response_addr, uint8_t source_addr, uint8_t cmd_set, uint8_t tag_owner)
 {
 	int status;
 
@@ -207,8 +503,13 @@ static int mctp_interface_generate_error_packet (struct mctp_interface *mctp, in
 		return 0;
 	}
 
-	mctp_interface_reset_message_processing (mctp);
+	if (context != NULL) {
+		context->active = false;
+	}
 
+	mctp->req_buffer.data =
+		&mctp->msg_buffer[sizeof (mctp->msg_buffer) - MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	mctp->req_buffer.length = 0;
 	mctp->req_buffer.max_response = MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT;
 	status = mctp->cmd_cerberus->generate_error_packet (mctp->cmd_cerberus, &mctp->req_buffer,
 		error_code, error_data, cmd_set);
@@ -249,6 +550,8 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 	struct cmd_message **tx_message)
 {
 	struct cerberus_protocol_header *header;
+	struct mctp_base_protocol_transport_header *transport;
+	struct mctp_interface_msg_context *context = NULL;
 	uint32_t msg1 = 0;
 	uint32_t msg2 = 0;
 	uint8_t i_byte;
@@ -265,6 +568,11 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 	size_t payload_len;
 	bool som;
 	bool eom;
+	bool packetized = false;
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+	enum mctp_interface_response_state rsp_state;
+	bool pending;
+#endif
 	int cerberus_eid;
 	int status;
 
@@ -281,10 +589,20 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 
 	*tx_message = NULL;
 
+	/* Packets after the first only carry the message type in the context of the message they
+	 * belong to, so find that context before parsing the packet. */
+	if (rx_packet->pkt_size > sizeof (struct mctp_base_protocol_transport_header)) {
+		transport = (struct mctp_base_protocol_transport_header*) rx_packet->data;
+		context = mctp_interface_find_msg_context (mctp, transport->source_eid,
+			transport->msg_tag, transport->tag_owner);
+		if (!transport->som && (context != NULL)) {
+			mctp->msg_type = context->msg_type;
+		}
+	}
+
 	status = mctp_base_protocol_interpret (rx_packet->data, rx_packet->pkt_size,
 		rx_packet->dest_addr, &source_addr, &som, &eom, &src_eid, &dest_eid, &payload, &payload_len,
 		&msg_tag, &packet_seq, &crc, &mctp->msg_type, &tag_owner);
-	
 
 	response_addr = source_addr;
 
@@ -306,87 +624,111 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 
 		if ((status == MCTP_BASE_PROTOCOL_INVALID_MSG) ||
 			(status == MCTP_BASE_PROTOCOL_UNSUPPORTED_MSG)) {
-			return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+			return mctp_interface_generate_error_packet (mctp, context, cerberus_eid, tx_message,
 				CERBERUS_PROTOCOL_ERROR_INVALID_REQ, status, src_eid, dest_eid, msg_tag,
 				response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 		}
 		else if (status == MCTP_BASE_PROTOCOL_BAD_CHECKSUM) {
-			return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+			return mctp_interface_generate_error_packet (mctp, context, cerberus_eid, tx_message,
 				CERBERUS_PROTOCOL_ERROR_INVALID_CHECKSUM, crc, src_eid, dest_eid, msg_tag,
 				response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 		}
+		else if (context != NULL) {
+			context->active = false;
+			mctp->req_buffer.length = 0;
+			return status;
+		}
 		else {
+			/* The packet can't be associated with any message, so discard them all. */
 			mctp_interface_reset_message_processing (mctp);
 			return status;
 		}
 	}
 
-
-
-
 	if ((dest_eid != cerberus_eid) && (dest_eid != MCTP_BASE_PROTOCOL_NULL_EID)) {
 		return 0;
 	}
 
 	if (tag_owner == MCTP_BASE_PROTOCOL_TO_RESPONSE) {
-		if ((mctp->rsp_state != MCTP_INTERFACE_RESPONSE_WAITING) ||
-			(src_eid != mctp->response_eid) || (msg_tag != mctp->response_msg_tag)) {
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+		platform_mutex_lock (&mctp->lock);
+		pending = (mctp_interface_find_pending_request (mctp, src_eid, msg_tag) != NULL);
+		platform_mutex_unlock (&mctp->lock);
+
+		if (!pending) {
 			return MCTP_BASE_PROTOCOL_UNEXPECTED_PKT;
 		}
+#else
+		return MCTP_BASE_PROTOCOL_UNEXPECTED_PKT;
+#endif
 	}
 
 	if (som) {
-		mctp->req_buffer.length = 0;
-		mctp->req_buffer.source_eid = src_eid;
-		mctp->req_buffer.source_addr = source_addr;
-		mctp->req_buffer.target_eid = dest_eid;
-		mctp->start_packet_len = payload_len;
-		mctp->req_buffer.channel_id = mctp->channel_id;
-		mctp->packet_seq = 0;
-		mctp->msg_tag = msg_tag;
-	}
-	else if (mctp->start_packet_len == 0) {
-		// If this packet is not a SOM, and we haven't received a SOM packet yet
-		return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+		if (context == NULL) {
+			context = mctp_interface_alloc_msg_context (mctp);
+		}
+
+		context->msg.length = 0;
+		context->msg.source_eid = src_eid;
+		context->msg.source_addr = source_addr;
+		context->msg.target_eid = dest_eid;
+		context->msg.channel_id = mctp->channel_id;
+		context->start_packet_len = payload_len;
+		context->packet_seq = 0;
+		context->msg_tag = msg_tag;
+		context->tag_owner = tag_owner;
+		context->msg_type = mctp->msg_type;
+		context->active = true;
+	}
+	else if (context == NULL) {
+		/* If this packet is not a SOM, and there is no message it belongs to.  A message from a
+		 * different endpoint being reassembled means this packet was just not meant to continue
+		 * it. */
+		if (mctp_interface_is_reassembling (mctp, src_eid, false)) {
+			return mctp_interface_generate_error_packet (mctp, NULL, cerberus_eid, tx_message,
+				CERBERUS_PROTOCOL_ERROR_INVALID_REQ, 0, src_eid, dest_eid, msg_tag, response_addr,
+				rx_packet->dest_addr, cmd_set, tag_owner);
+		}
+		else if (mctp_interface_is_reassembling (mctp, src_eid, true)) {
+			return 0;
+		}
+
+		return mctp_interface_generate_error_packet (mctp, NULL, cerberus_eid, tx_message,
 			CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, 0, src_eid, dest_eid, msg_tag, response_addr,
 			rx_packet->dest_addr, cmd_set, tag_owner);
 	}
-	else if (packet_seq != mctp->packet_seq) {
-		return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+	else if (packet_seq != context->packet_seq) {
+		return mctp_interface_generate_error_packet (mctp, context, cerberus_eid, tx_message,
 			CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW, 0, src_eid, dest_eid, msg_tag, response_addr,
 			rx_packet->dest_addr, cmd_set, tag_owner);
 	}
-	else if (msg_tag != mctp->msg_tag) {
-		return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
-			CERBERUS_PROTOCOL_ERROR_INVALID_REQ, 0, src_eid, dest_eid, msg_tag, response_addr,
-			rx_packet->dest_addr, cmd_set, tag_owner);
-	}
-	else if (src_eid != mctp->req_buffer.source_eid) {
-		return 0;
-	}
-	else {
-		if (((int) payload_len != mctp->start_packet_len) &&
-		   !(eom && ((int) payload_len < mctp->start_packet_len))) {
-			// Can only have different size than SOM if EOM and smaller than SOM
-			return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
-				CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, payload_len, src_eid, dest_eid, msg_tag,
-				response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
-		}
+	else if (((int) payload_len != context->start_packet_len) &&
+		!(eom && ((int) payload_len < context->start_packet_len))) {
+		// Can only have different size than SOM if EOM and smaller than SOM
+		return mctp_interface_generate_error_packet (mctp, context, cerberus_eid, tx_message,
+			CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, payload_len, src_eid, dest_eid, msg_tag,
+			response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 	}
 
-	
-
-	if ((payload_len + mctp->req_buffer.length) > MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY) {
-		return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
-			CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW, payload_len + mctp->req_buffer.length,
+	if ((payload_len + context->msg.length) > MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY) {
+		return mctp_interface_generate_error_packet (mctp, context, cerberus_eid, tx_message,
+			CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW, payload_len + context->msg.length,
 			src_eid, dest_eid, msg_tag, response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 	}
 
 	// Assemble packets into message and process message when EOM is received
-	memcpy (&mctp->req_buffer.data[mctp->req_buffer.length], payload, payload_len);
-	mctp->req_buffer.length += payload_len;
-	mctp->packet_seq = (mctp->packet_seq + 1) % 4;
-;
+	memcpy (&context->msg.data[context->msg.length], payload, payload_len);
+	context->msg.length += payload_len;
+	context->packet_seq = (context->packet_seq + 1) % 4;
+	context->last_used = ++mctp->msg_context_count;
+	platform_init_timeout (MCTP_INTERFACE_MSG_CONTEXT_TIMEOUT_MS, &context->timeout);
+
+	mctp->req_buffer = context->msg;
+	if (eom) {
+		/* The message is processed from the context buffer.  It will not be reused until a new
+		 * message is started. */
+		context->active = false;
+	}
 
 	if (eom) {
 		if (tag_owner == MCTP_BASE_PROTOCOL_TO_RESPONSE) {
@@ -424,25 +766,23 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 			}
 
 			if (status == CMD_HANDLER_ERROR_MESSAGE) {
-				mctp->rsp_state = MCTP_INTERFACE_RESPONSE_ERROR;
+				rsp_state = MCTP_INTERFACE_RESPONSE_ERROR;
 				status = 0;
 			}
 			else if (status != 0) {
-				mctp->rsp_state = MCTP_INTERFACE_RESPONSE_FAIL;
+				rsp_state = MCTP_INTERFACE_RESPONSE_FAIL;
 			}
 			else {
-				mctp->rsp_state = MCTP_INTERFACE_RESPONSE_SUCCESS;
+				rsp_state = MCTP_INTERFACE_RESPONSE_SUCCESS;
 			}
 
-			mctp->response_msg_tag = (mctp->response_msg_tag + 1) % 8;
-
-			platform_semaphore_post (&mctp->wait_for_response);
+			mctp_interface_complete_pending_request (mctp, src_eid, msg_tag, rsp_state);
 
 			return status;
 #else
-		/* If flag is not defined, we will never issue requests, so rsp_state will always be
-		 * MCTP_INTERFACE_RESPONSE_IDLE and any response packets will be rejected in the earlier
-		 * check. Therefore, we dont need to do anything here in that case. */
+		/* If flag is not defined, we will never issue requests, so there are no pending requests
+		 * and any response packets will be rejected in the earlier check. Therefore, we dont need
+		 * to do anything here in that case. */
 #endif
 		}
 		else if (MCTP_BASE_PROTOCOL_IS_CONTROL_MSG (mctp->msg_type)) {
@@ -461,8 +801,20 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 			mctp->req_buffer.max_response = device_manager_get_max_message_len_by_eid (
 				mctp->device_manager, src_eid);
 
-	
+			/* PLDM responses can be written directly into the response packets, avoiding an extra
+			 * copy of large responses through the request buffer. */
+			mctp->resp_packets.payload_len = device_manager_get_max_transmission_unit_by_eid (
+				mctp->device_manager, src_eid);
+			mctp->resp_packets.pkt_len = mctp_protocol_packet_len (mctp->resp_packets.payload_len);
+			mctp->req_buffer.packets = &mctp->resp_packets;
+			mctp->req_buffer.packetized = false;
+
 			status = mctp->cmd_pldm->process_request (mctp->cmd_pldm, &mctp->req_buffer);
+
+			packetized = mctp->req_buffer.packetized;
+			mctp->req_buffer.packets = NULL;
+			mctp->req_buffer.packetized = false;
+
 			if (status != 0) {
 				debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
 					MCTP_LOGGING_MCTP_PLDM_REQ_FAIL, status, mctp->channel_id);
@@ -486,19 +838,19 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 			}
 
 			if (status != 0) {
-				return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+				return mctp_interface_generate_error_packet (mctp, NULL, cerberus_eid, tx_message,
 					CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid, dest_eid, msg_tag,
 					response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 			}
 			else if (mctp->req_buffer.length == 0) {
-				return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+				return mctp_interface_generate_error_packet (mctp, NULL, cerberus_eid, tx_message,
 					CERBERUS_PROTOCOL_NO_ERROR, status, src_eid, dest_eid, msg_tag, response_addr,
 					rx_packet->dest_addr, cmd_set, tag_owner);
 			}
 
 			if (mctp->req_buffer.length >
 				device_manager_get_max_message_len_by_eid (mctp->device_manager, src_eid)) {
-				return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+				return mctp_interface_generate_error_packet (mctp, NULL, cerberus_eid, tx_message,
 					CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, MCTP_BASE_PROTOCOL_MSG_TOO_LARGE, src_eid,
 					dest_eid, msg_tag, response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 			}
@@ -510,13 +862,13 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 
 		if (mctp->req_buffer.length > 0) {
 			status = mctp_interface_generate_packets_from_payload (mctp->device_manager,
-				mctp->req_buffer.data, mctp->req_buffer.length, mctp->resp_buffer.data,
-				sizeof (mctp->msg_buffer), mctp->req_buffer.source_eid, response_addr,
-				mctp->req_buffer.target_eid, rx_packet->dest_addr, mctp->msg_tag,
+				(packetized) ? NULL : mctp->req_buffer.data, mctp->req_buffer.length,
+				mctp->resp_buffer.data, sizeof (mctp->msg_buffer), mctp->req_buffer.source_eid,
+				response_addr, mctp->req_buffer.target_eid, rx_packet->dest_addr, msg_tag,
 				MCTP_BASE_PROTOCOL_TO_RESPONSE, &mctp->resp_buffer.pkt_size);
 			if (ROT_IS_ERROR (status)) {
-				if (MCTP_BASE_PROTOCOL_IS_VENDOR_MSG (mctp->req_buffer.data[0])) {
-					return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+				if (!packetized && MCTP_BASE_PROTOCOL_IS_VENDOR_MSG (mctp->req_buffer.data[0])) {
+					return mctp_interface_generate_error_packet (mctp, NULL, cerberus_eid, tx_message,
 						CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid, dest_eid, msg_tag,
 						response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 				}
@@ -547,8 +899,13 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
  */
 void mctp_interface_reset_message_processing (struct mctp_interface *mctp)
 {
+	int i;
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		mctp->msg_contexts[i].active = false;
+	}
+
 	mctp->req_buffer.length = 0;
-	mctp->start_packet_len = 0;
 }
 
 #ifdef CMD_ENABLE_ISSUE_REQUEST
@@ -557,6 +914,10 @@ void mctp_interface_reset_message_processing (struct mctp_interface *mctp)
  * full message has been transmitted and a response has been received or the operation times out,
  * unless a timeout_ms of 0 is set at which point request is sent and function returns immediately.
  *
+ * Requests to different destinations can be issued concurrently from different tasks.  Each request
+ * is assigned a message tag not in use by another request to the same destination, and responses
+ * are matched to the request by EID and message tag.
+ *
  * @param mctp MCTP instance that will be processing the request message.
  * @param channel Command channel to use for transmitting the packets.
  * @param dest_addr The destination address for the request.
@@ -569,7 +930,10 @@ void mctp_interface_reset_message_processing (struct mctp_interface *mctp)
  * @param max_length Maximum length of the message buffer.  This buffer should be
  * MCTP_BASE_PROTOCOL_MAX_MESSAGE_LEN bytes to ensure any message packetized in any way can fit.
  * @param timeout_ms Timeout period in milliseconds to wait for response to be received.  If
- * wait for response not needed, set to 0.
+ * wait for response not needed, set to 0.  Multiple requests with a timeout of 0 can be issued to
+ * the same destination EID before any response is received, up to the number of available message
+ * tags.  Responses can be received in any order.  A request that waits for a response discards
+ * any requests to the same destination EID that were sent without waiting.
  *
  * @return 0 if the request was transmitted successfully or an error code.
  */
@@ -577,9 +941,11 @@ int mctp_interface_issue_request (struct mctp_interface *mctp, struct cmd_channe
 	uint8_t dest_addr, uint8_t dest_eid, uint8_t *request, size_t length, uint8_t *msg_buffer,
 	size_t max_length, uint32_t timeout_ms)
 {
+	struct mctp_interface_pending_request *pending;
 	struct cmd_message cmd_msg;
 	size_t max_transmission_unit;
 	size_t num_packets;
+	uint32_t sequence;
 	int src_eid;
 	int src_addr;
 	int status;
@@ -620,55 +986,85 @@ int mctp_interface_issue_request (struct mctp_interface *mctp, struct cmd_channe
 		}
 	}
 
+	platform_mutex_lock (&mctp->lock);
+
+	/* A request that will be waited on replaces any requests to the same endpoint that were sent
+	 * without waiting.  Requests to other endpoints remain pending. */
+	if (timeout_ms != 0) {
+		mctp_interface_release_no_wait_requests (mctp, dest_eid);
+	}
+
+	status = mctp_interface_alloc_pending_request (mctp, dest_eid, (timeout_ms == 0), &pending);
+	if (status != 0) {
+		platform_mutex_unlock (&mctp->lock);
+		return status;
+	}
+
 	status = mctp_interface_generate_packets_from_payload (mctp->device_manager, request, length,
-		msg_buffer, max_length, dest_eid, dest_addr, src_eid, src_addr, mctp->response_msg_tag,
+		msg_buffer, max_length, dest_eid, dest_addr, src_eid, src_addr, pending->msg_tag,
 		MCTP_BASE_PROTOCOL_TO_REQUEST, &cmd_msg.pkt_size);
 	if (ROT_IS_ERROR (status)) {
-		return status;
+		goto release;
 	}
 
 	cmd_msg.msg_size = status;
 	cmd_msg.data = msg_buffer;
 	cmd_msg.dest_addr = dest_addr;
 
-	platform_mutex_lock (&mctp->lock);
-
-	mctp->rsp_state = MCTP_INTERFACE_RESPONSE_WAITING;
-	mctp->response_eid = dest_eid;
-
-	status = platform_semaphore_reset (&mctp->wait_for_response);
+	status = platform_semaphore_reset (&pending->complete);
 	if (status != 0) {
-		goto exit;
+		goto release;
 	}
 
+	sequence = pending->sequence;
+	platform_mutex_unlock (&mctp->lock);
+
+	/* The lock is not held while sending or waiting so responses can be processed and other
+	 * requests can be sent in the meantime.  Only the pending entry is shared state, and it is
+	 * only accessed again under the lock.  The packets were built in msg_buffer, which is owned by
+	 * this request, and the channel sends each message as a whole while holding its own lock, so
+	 * the packets of concurrent requests and responses are never interleaved. */
 	status = cmd_channel_send_message (channel, &cmd_msg);
 	if (status != 0) {
-		goto exit;
+		platform_mutex_lock (&mctp->lock);
+
+		/* A request sent without waiting could have already been discarded to make room for
+		 * another request. */
+		if (pending->active && (pending->sequence == sequence)) {
+			goto release;
+		}
+
+		goto unlock;
 	}
 
 	if (timeout_ms == 0) {
-		goto unlock;
+		return 0;
 	}
 
-	status = platform_semaphore_wait (&mctp->wait_for_response, timeout_ms);
-	if (status == 1) {
+	status = platform_semaphore_wait (&pending->complete, timeout_ms);
+
+	platform_mutex_lock (&mctp->lock);
+
+	if ((status == 1) && (pending->state == MCTP_INTERFACE_RESPONSE_WAITING)) {
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
-			MCTP_LOGGING_RSP_TIMEOUT, (mctp->response_eid << 8) | mctp->response_msg_tag,
-			timeout_ms);
+			MCTP_LOGGING_RSP_TIMEOUT, (dest_eid << 8) | pending->msg_tag, timeout_ms);
 
-		mctp->response_msg_tag = (mctp->response_msg_tag + 1) % 8;
+		mctp->response_msg_tag = (pending->msg_tag + 1) % 8;
 
 		status = MCTP_BASE_PROTOCOL_RESPONSE_TIMEOUT;
 	}
-	else if (mctp->rsp_state == MCTP_INTERFACE_RESPONSE_ERROR) {
+	else if (pending->state == MCTP_INTERFACE_RESPONSE_ERROR) {
 		status = MCTP_BASE_PROTOCOL_ERROR_RESPONSE;
 	}
-	else if (mctp->rsp_state == MCTP_INTERFACE_RESPONSE_FAIL) {
+	else if (pending->state == MCTP_INTERFACE_RESPONSE_FAIL) {
 		status = MCTP_BASE_PROTOCOL_FAIL_RESPONSE;
 	}
+	else {
+		status = 0;
+	}
 
-exit:
-	mctp->rsp_state = MCTP_INTERFACE_RESPONSE_IDLE;
+release:
+	mctp_interface_release_pending_request (mctp, pending);
 
 unlock:
 	platform_mutex_unlock (&mctp->lock);
@@ -676,6 +1072,72 @@ unlock:
 	return status;
 }
 
+/**
+ * Stop waiting for the responses to requests that were sent to a device without waiting.  A
+ * response received for one of these requests after it has been canceled is dropped.  Requests
+ * that are being waited on are not affected and end when their own timeout expires.
+ *
+ * Requests sent without waiting otherwise stay pending until their response is received, so this
+ * must be called once the responses are no longer expected, such as when an exchange with the
+ * device is aborted.
+ *
+ * @param mctp The MCTP interface that sent the requests.
+ * @param dest_eid EID of the device the requests were sent to.
+ *
+ * @return 0 if the requests were canceled or an error code.
+ */
+int mctp_interface_cancel_requests (struct mctp_interface *mctp, uint8_t dest_eid)
+{
+	if (mctp == NULL) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&mctp->lock);
+	mctp_interface_release_no_wait_requests (mctp, dest_eid);
+	platform_mutex_unlock (&mctp->lock);
+
+	return 0;
+}
+
+/**
+ * Get the number of requests sent to a device without waiting that are still waiting for a
+ * response.
+ *
+ * @param mctp The MCTP interface that sent the requests.
+ * @param dest_eid EID of the device the requests were sent to.
+ * @param rsp_state Optional output for the state of the requests sent without waiting.  Once no
+ * requests are outstanding to any device, this is the result of the last response received.
+ *
+ * @return The number of outstanding requests or an error code.
+ */
+int mctp_interface_get_outstanding_requests (struct mctp_interface *mctp, uint8_t dest_eid,
+	enum mctp_interface_response_state *rsp_state)
+{
+	int count = 0;
+	int i;
+
+	if (mctp == NULL) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&mctp->lock);
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+		if (mctp->pending[i].active && mctp->pending[i].no_wait &&
+			(mctp->pending[i].eid == dest_eid)) {
+			count++;
+		}
+	}
+
+	if (rsp_state != NULL) {
+		*rsp_state = mctp->rsp_state;
+	}
+
+	platform_mutex_unlock (&mctp->lock);
+
+	return count;
+}
+
 /**
  * Generate and send a MCTP control protocol Discovery Notify request to MCTP bridge, then return
  * immediately without waiting for response.
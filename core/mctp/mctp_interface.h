@@ -24,6 +24,68 @@ enum mctp_interface_response_state {
 	MCTP_INTERFACE_RESPONSE_SUCCESS,						/**< Successfully received response from target. */
 };
 
+/**
+ * The number of messages that can be reassembled at the same time, such as requests from different
+ * endpoints.  Each context reserves a buffer for the largest supported message body, so every
+ * context adds MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY bytes (4 kB) of RAM to each MCTP interface in
+ * addition to msg_buffer.  The default of 2 contexts needs 8 kB.
+ *
+ * The context buffers can't be backed by msg_buffer, since responses are built in msg_buffer while
+ * other messages may still be partially received.
+ */
+#ifndef MCTP_INTERFACE_MAX_MSG_CONTEXTS
+#define MCTP_INTERFACE_MAX_MSG_CONTEXTS						2
+#endif
+
+/**
+ * The time a partially received message is kept without receiving another packet for it.
+ */
+#ifndef MCTP_INTERFACE_MSG_CONTEXT_TIMEOUT_MS
+#define MCTP_INTERFACE_MSG_CONTEXT_TIMEOUT_MS				MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS
+#endif
+
+/**
+ * The number of requests that can be waiting for a response at the same time.  Requests to
+ * different endpoints can each be waiting, but no more than 8 can be sent to the same endpoint.
+ */
+#ifndef MCTP_INTERFACE_MAX_PENDING_REQUESTS
+#define MCTP_INTERFACE_MAX_PENDING_REQUESTS					8
+#endif
+
+
+/**
+ * Context for reassembling a single message from its packets.  Packets are matched to the message
+ * by source EID, message tag, and tag owner.
+ */
+struct mctp_interface_msg_context {
+	struct cmd_interface_msg msg;							/**< The message being reassembled. */
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];		/**< Buffer for the message body. */
+	platform_clock timeout;									/**< Time at which the partial message is discarded. */
+	uint32_t last_used;										/**< Order in which contexts last received a packet. */
+	int start_packet_len;									/**< Length of MCTP start packet */
+	uint8_t packet_seq;										/**< Next expected MCTP packet sequence */
+	uint8_t msg_tag;										/**< MCTP message tag of the message */
+	uint8_t tag_owner;										/**< MCTP tag owner of the message */
+	uint8_t msg_type;										/**< MCTP message type of the message */
+	bool active;											/**< Flag indicating a message is being reassembled. */
+};
+
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+/**
+ * A request that has been sent and is waiting for a response.  Responses are matched to the request
+ * by the EID of the device the request was sent to and the message tag of the request.
+ */
+struct mctp_interface_pending_request {
+	platform_semaphore complete;							/**< Semaphore used by requester to wait for response. */
+	enum mctp_interface_response_state state;				/**< State of the request. */
+	uint32_t sequence;										/**< Order in which requests were sent. */
+	uint8_t eid;											/**< MCTP EID of the device the request was sent to. */
+	uint8_t msg_tag;										/**< MCTP message tag of the request. */
+	bool no_wait;											/**< Flag indicating the requester is not waiting for the response. */
+	bool active;											/**< Flag indicating the request is waiting for a response. */
+};
+#endif
+
 /**
  * MCTP interface context
  */
@@ -35,18 +97,19 @@ struct mctp_interface {
 	struct device_manager *device_manager;					/**< Device manager linked to command interface */
 	uint8_t msg_buffer[MCTP_BASE_PROTOCOL_MAX_MESSAGE_LEN];	/**< Buffer for MCTP messages */
 	struct cmd_message resp_buffer;							/**< Buffer for transmitting responses */
+	struct cmd_interface_msg_packets resp_packets;			/**< Layout of the response buffer for responses written directly into packets */
 	struct cmd_interface_msg req_buffer;					/**< Buffer for request processing */
-	int start_packet_len;									/**< Length of MCTP start packet */
-	uint8_t packet_seq;										/**< Current MCTP exchange packet sequence */
-	uint8_t msg_tag;										/**< Current MCTP exchange message tag */
+	struct mctp_interface_msg_context msg_contexts[MCTP_INTERFACE_MAX_MSG_CONTEXTS];	/**< Messages being reassembled */
+	uint32_t msg_context_count;								/**< Counter for ordering the use of message contexts */
 	uint8_t msg_type;										/**< Current MCTP exchange message type */
 	int channel_id;											/**< Channel ID associated with the interface. */
-	uint8_t response_eid;									/**< MCTP EID for device we expect a response from */
-	uint8_t response_msg_tag;								/**< MCTP message tag for transaction we expect response for */
-	enum mctp_interface_response_state rsp_state;			/**< State of transactions started by device */
+	uint8_t response_msg_tag;								/**< First MCTP message tag to try for the next request */
+	uint8_t outstanding_requests;							/**< Number of requests sent without waiting still waiting for a response */
+	enum mctp_interface_response_state rsp_state;			/**< State of requests sent without waiting */
 #ifdef CMD_ENABLE_ISSUE_REQUEST
-	platform_semaphore wait_for_response;					/**< Semaphore used by requester to wait for response. */
-	platform_mutex lock;									/**< Synchronization for shared interfaces */
+	struct mctp_interface_pending_request pending[MCTP_INTERFACE_MAX_PENDING_REQUESTS];	/**< Requests waiting for a response */
+	uint32_t pending_count;									/**< Counter for ordering pending requests */
+	platform_mutex lock;									/**< Synchronization for the pending requests */
 #endif
 };
 
@@ -66,6 +129,9 @@ void mctp_interface_reset_message_processing (struct mctp_interface *mctp);
 int mctp_interface_issue_request (struct mctp_interface *mctp, struct cmd_channel *channel,
 	uint8_t dest_addr, uint8_t dest_eid, uint8_t *request, size_t length, uint8_t *msg_buffer,
 	size_t max_buffer, uint32_t timeout_ms);
+int mctp_interface_cancel_requests (struct mctp_interface *mctp, uint8_t dest_eid);
+int mctp_interface_get_outstanding_requests (struct mctp_interface *mctp, uint8_t dest_eid,
+	enum mctp_interface_response_state *rsp_state);
 
 int mctp_interface_send_discovery_notify (struct mctp_interface *mctp, struct cmd_channel *channel);
 #endif
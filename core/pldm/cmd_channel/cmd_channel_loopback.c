@@ -0,0 +1,267 @@
+#include <stddef.h>
+#include <string.h>
+#include "cmd_channel_loopback.h"
+
+
+/**
+ * Receive a packet sent by the connected channel.
+ *
+ * @param channel The channel to receive a packet from.
+ * @param packet Output for the packet data being received.
+ * @param ms_timeout The amount of time to wait for a received packet, in milliseconds.  A negative value will wait
+ * forever, and a value of 0 will return immediately.
+ *
+ * @return 0 if a packet was successfully received or an error code.
+ */
+static int cmd_channel_loopback_receive_packet(struct cmd_channel *channel, struct cmd_packet *packet, int ms_timeout)
+{
+    struct cmd_channel_loopback *loopback = (struct cmd_channel_loopback*) channel;
+    struct cmd_channel_loopback_queue *queue;
+    int status;
+
+    if (loopback == NULL || packet == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    queue = loopback->rx;
+
+    if (ms_timeout < 0) {
+        status = platform_semaphore_wait(&queue->ready, 0);
+    }
+    else if (ms_timeout == 0) {
+        status = platform_semaphore_try_wait(&queue->ready);
+    }
+    else {
+        status = platform_semaphore_wait(&queue->ready, ms_timeout);
+    }
+
+    if (status == 1) {
+        return CMD_CHANNEL_RX_TIMEOUT;
+    }
+    else if (status != 0) {
+        return status;
+    }
+
+    platform_mutex_lock(&queue->lock);
+
+    memcpy(packet->data, queue->packets[queue->head].data, queue->packets[queue->head].pkt_size);
+    packet->pkt_size = queue->packets[queue->head].pkt_size;
+    queue->head = (queue->head + 1) % CMD_CHANNEL_LOOPBACK_QUEUE_LEN;
+    queue->count--;
+
+    platform_mutex_unlock(&queue->lock);
+
+    packet->dest_addr = (uint8_t) cmd_channel_get_id(channel);
+    packet->state = CMD_VALID_PACKET;
+    packet->timeout_valid = false;
+
+    return 0;
+}
+
+/**
+ * Send a packet to the connected channel.  The packet is queued and the call never blocks.
+ *
+ * @param channel The channel to send a packet on.
+ * @param packet The packet to send.
+ *
+ * @return 0 if the the packet was successfully sent or an error code.
+ */
+static int cmd_channel_loopback_send_packet(struct cmd_channel *channel, struct cmd_packet *packet)
+{
+    struct cmd_channel_loopback *loopback = (struct cmd_channel_loopback*) channel;
+    struct cmd_channel_loopback_queue *queue;
+    struct cmd_packet *entry;
+    int status;
+
+    if (loopback == NULL || packet == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    if (packet->pkt_size == 0 || packet->pkt_size > CMD_MAX_PACKET_SIZE) {
+        return CMD_CHANNEL_INVALID_PKT_SIZE;
+    }
+
+    queue = loopback->tx;
+
+    platform_mutex_lock(&queue->lock);
+
+    if (queue->count == CMD_CHANNEL_LOOPBACK_QUEUE_LEN) {
+        platform_mutex_unlock(&queue->lock);
+        return CMD_CHANNEL_TX_FAILED;
+    }
+
+    entry = &queue->packets[(queue->head + queue->count) % CMD_CHANNEL_LOOPBACK_QUEUE_LEN];
+    memcpy(entry->data, packet->data, packet->pkt_size);
+    entry->pkt_size = packet->pkt_size;
+    queue->count++;
+
+    platform_mutex_unlock(&queue->lock);
+
+    status = platform_semaphore_post(&queue->ready);
+    if (status != 0) {
+        return CMD_CHANNEL_TX_FAILED;
+    }
+
+    return 0;
+}
+
+/**
+ * Send all packets of a message to the connected channel.  The packets are queued together, so the
+ * receiver will never see part of the message, and the call never blocks.
+ *
+ * @param channel The channel to send the packets on.
+ * @param message The packetized message to send.
+ *
+ * @return 0 if the the packets were successfully sent or an error code.
+ */
+static int cmd_channel_loopback_send_packets(struct cmd_channel *channel, struct cmd_message *message)
+{
+    struct cmd_channel_loopback *loopback = (struct cmd_channel_loopback*) channel;
+    struct cmd_channel_loopback_queue *queue;
+    struct cmd_packet *entry;
+    const uint8_t *pkt_pos;
+    size_t msg_len;
+    size_t pkt_len;
+    size_t num_packets;
+    size_t i;
+    int status;
+
+    if (loopback == NULL || message == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    if (message->pkt_size == 0 || message->pkt_size > CMD_MAX_PACKET_SIZE) {
+        return CMD_CHANNEL_INVALID_PKT_SIZE;
+    }
+
+    if (message->msg_size == 0) {
+        return 0;
+    }
+
+    queue = loopback->tx;
+    num_packets = (message->msg_size + message->pkt_size - 1) / message->pkt_size;
+
+    platform_mutex_lock(&queue->lock);
+
+    if ((CMD_CHANNEL_LOOPBACK_QUEUE_LEN - queue->count) < num_packets) {
+        platform_mutex_unlock(&queue->lock);
+        return CMD_CHANNEL_TX_FAILED;
+    }
+
+    pkt_pos = message->data;
+    msg_len = message->msg_size;
+
+    for (i = 0; i < num_packets; i++) {
+        pkt_len = (msg_len < message->pkt_size) ? msg_len : message->pkt_size;
+
+        entry = &queue->packets[(queue->head + queue->count) % CMD_CHANNEL_LOOPBACK_QUEUE_LEN];
+        memcpy(entry->data, pkt_pos, pkt_len);
+        entry->pkt_size = pkt_len;
+        queue->count++;
+
+        pkt_pos += pkt_len;
+        msg_len -= pkt_len;
+    }
+
+    platform_mutex_unlock(&queue->lock);
+
+    for (i = 0; i < num_packets; i++) {
+        status = platform_semaphore_post(&queue->ready);
+        if (status != 0) {
+            return CMD_CHANNEL_TX_FAILED;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Initialize a queue for one direction of a loopback link.
+ *
+ * @param queue The queue to initialize.
+ *
+ * @return 0 if the queue was initialized successfully or an error code.
+ */
+int cmd_channel_loopback_queue_init(struct cmd_channel_loopback_queue *queue)
+{
+    int status;
+
+    if (queue == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    memset(queue, 0, sizeof (struct cmd_channel_loopback_queue));
+
+    status = platform_mutex_init(&queue->lock);
+    if (status != 0) {
+        return status;
+    }
+
+    status = platform_semaphore_init(&queue->ready);
+    if (status != 0) {
+        platform_mutex_free(&queue->lock);
+        return status;
+    }
+
+    return 0;
+}
+
+/**
+ * Release the resources used by a loopback queue.
+ *
+ * @param queue The queue to release.
+ */
+void cmd_channel_loopback_queue_release(struct cmd_channel_loopback_queue *queue)
+{
+    if (queue != NULL) {
+        platform_semaphore_free(&queue->ready);
+        platform_mutex_free(&queue->lock);
+    }
+}
+
+/**
+ * Initialize one end of a loopback link.  The other end is initialized with the queues swapped.
+ *
+ * @param channel The channel to initialize.
+ * @param id An ID to associate with the command channel.  Received packets use this as the destination address.
+ * @param rx The queue of packets sent to this channel.
+ * @param tx The queue of packets sent by this channel.
+ *
+ * @return 0 if the channel was initialized successfully or an error code.
+ */
+int cmd_channel_loopback_init(struct cmd_channel_loopback *channel, int id, struct cmd_channel_loopback_queue *rx,
+    struct cmd_channel_loopback_queue *tx)
+{
+    int status;
+
+    if (channel == NULL || rx == NULL || tx == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    memset(channel, 0, sizeof (struct cmd_channel_loopback));
+
+    status = cmd_channel_init(&channel->base, id);
+    if (status != 0) {
+        return status;
+    }
+
+    channel->base.receive_packet = cmd_channel_loopback_receive_packet;
+    channel->base.send_packet = cmd_channel_loopback_send_packet;
+    channel->base.send_packets = cmd_channel_loopback_send_packets;
+    channel->rx = rx;
+    channel->tx = tx;
+
+    return 0;
+}
+
+/**
+ * Release the resources used by a loopback channel.  The queues must be released separately.
+ *
+ * @param channel The channel to release.
+ */
+void cmd_channel_loopback_release(struct cmd_channel_loopback *channel)
+{
+    if (channel != NULL) {
+        cmd_channel_release(&channel->base);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef COMMAND_CHANNEL_LOOPBACK_H_
+#define COMMAND_CHANNEL_LOOPBACK_H_
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_api.h"
+#include "cmd_interface/cmd_channel.h"
+
+
+/**
+ * Maximum number of packets that can be queued in one direction of a loopback link. A full transfer window of
+ * RequestFirmwareData responses must fit, since the receiver may be sending its own requests at the same time.
+ */
+#ifndef CMD_CHANNEL_LOOPBACK_QUEUE_LEN
+#define CMD_CHANNEL_LOOPBACK_QUEUE_LEN              512
+#endif
+
+/**
+ * Packets travelling in one direction between two loopback channels.
+ */
+struct cmd_channel_loopback_queue {
+    struct cmd_packet packets[CMD_CHANNEL_LOOPBACK_QUEUE_LEN];                      /**< Packets waiting to be received. */
+    size_t head;                                                                    /**< Index of the oldest packet. */
+    size_t count;                                                                   /**< Number of packets in the queue. */
+    platform_mutex lock;                                                            /**< Synchronization for queue access. */
+    platform_semaphore ready;                                                       /**< Counts the packets available to receive. */
+};
+
+/**
+ * A command channel connected to another command channel in the same process.
+ *
+ * Two channels share a pair of queues, with the transmit queue of one channel being the receive queue of the other.
+ * This allows the UA and FD sides of a firmware update to run in separate tasks of one process without any socket
+ * overhead, which makes the channel suitable for measuring the PLDM stack itself.
+ */
+struct cmd_channel_loopback {
+    struct cmd_channel base;                                                        /**< Base command channel. */
+    struct cmd_channel_loopback_queue *rx;                                          /**< Queue of packets sent to this channel. */
+    struct cmd_channel_loopback_queue *tx;                                          /**< Queue of packets sent by this channel. */
+};
+
+
+int cmd_channel_loopback_queue_init(struct cmd_channel_loopback_queue *queue);
+void cmd_channel_loopback_queue_release(struct cmd_channel_loopback_queue *queue);
+
+int cmd_channel_loopback_init(struct cmd_channel_loopback *channel, int id, struct cmd_channel_loopback_queue *rx,
+    struct cmd_channel_loopback_queue *tx);
+void cmd_channel_loopback_release(struct cmd_channel_loopback *channel);
+
+
+/* This module will be treated as an extension of the command channel and use CMD_CHANNEL_* error codes. */
+
+
+#endif /* COMMAND_CHANNEL_LOOPBACK_H_ */
@@ -0,0 +1,357 @@
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include "cmd_channel_shm.h"
+
+
+/**
+ * Reduce a free running ring index to a slot in the ring.
+ */
+#define CMD_CHANNEL_SHM_SLOT(index)                 ((index) & (CMD_CHANNEL_SHM_RING_LEN - 1))
+
+
+/**
+ * Wait for the producer to add a packet to the receive ring.
+ *
+ * @param shm The channel waiting for a packet.
+ * @param head The index of the next packet to read.
+ * @param timeout The time at which to stop waiting, or null to wait forever.
+ *
+ * @return 0 if the ring may have a packet available or an error code.
+ */
+static int cmd_channel_shm_wait(struct cmd_channel_shm *shm, uint32_t head, const platform_clock *timeout)
+{
+    struct cmd_channel_shm_ring *ring = shm->rx;
+    struct pollfd event;
+    uint64_t count;
+    uint32_t remaining = 0;
+    int status;
+
+    if (timeout != NULL) {
+        status = platform_get_timeout_remaining(timeout, &remaining);
+        if ((status != 0) || (remaining == 0)) {
+            return CMD_CHANNEL_RX_TIMEOUT;
+        }
+    }
+
+    /* The waiting flag and tail are accessed with sequential consistency on both sides, so either the producer sees
+     * the flag and signals the eventfd or the packet is seen here before sleeping. */
+    __atomic_store_n(&ring->waiting, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST) != head) {
+        __atomic_store_n(&ring->waiting, 0, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    event.fd = shm->rx_event;
+    event.events = POLLIN;
+    event.revents = 0;
+
+    do {
+        status = poll(&event, 1, (timeout != NULL) ? (int) remaining : -1);
+    } while ((status < 0) && (errno == EINTR));
+
+    __atomic_store_n(&ring->waiting, 0, __ATOMIC_RELAXED);
+
+    if (status < 0) {
+        return CMD_CHANNEL_RX_FAILED;
+    }
+    else if (status == 0) {
+        return CMD_CHANNEL_RX_TIMEOUT;
+    }
+
+    /* Clear the eventfd.  Any signal that arrives after this will just cause an extra check of the ring. */
+    if ((read(shm->rx_event, &count, sizeof (count)) < 0) && (errno != EAGAIN)) {
+        return CMD_CHANNEL_RX_FAILED;
+    }
+
+    return 0;
+}
+
+/**
+ * Make packets written to the transmit ring available to the other end of the link.
+ *
+ * @param shm The channel that wrote the packets.
+ * @param tail The new tail of the transmit ring.
+ *
+ * @return 0 if the packets were published or an error code.
+ */
+static int cmd_channel_shm_publish(struct cmd_channel_shm *shm, uint32_t tail)
+{
+    uint64_t signal = 1;
+
+    __atomic_store_n(&shm->tx->tail, tail, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&shm->tx->waiting, __ATOMIC_SEQ_CST)) {
+        if (write(shm->tx_event, &signal, sizeof (signal)) != sizeof (signal)) {
+            return CMD_CHANNEL_TX_FAILED;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Receive a packet sent by the other end of the link.
+ *
+ * @param channel The channel to receive a packet from.
+ * @param packet Output for the packet data being received.
+ * @param ms_timeout The amount of time to wait for a received packet, in milliseconds.  A negative value will wait
+ * forever, and a value of 0 will return immediately.
+ *
+ * @return 0 if a packet was successfully received or an error code.
+ */
+static int cmd_channel_shm_receive_packet(struct cmd_channel *channel, struct cmd_packet *packet, int ms_timeout)
+{
+    struct cmd_channel_shm *shm = (struct cmd_channel_shm*) channel;
+    struct cmd_channel_shm_ring *ring;
+    struct cmd_channel_shm_slot *slot;
+    platform_clock timeout;
+    uint32_t head;
+    int status;
+
+    if (shm == NULL || packet == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    ring = shm->rx;
+    head = ring->head;
+
+    if (ms_timeout > 0) {
+        status = platform_init_timeout(ms_timeout, &timeout);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    while (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == head) {
+        if (ms_timeout == 0) {
+            return CMD_CHANNEL_RX_TIMEOUT;
+        }
+
+        status = cmd_channel_shm_wait(shm, head, (ms_timeout > 0) ? &timeout : NULL);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    slot = &ring->slots[CMD_CHANNEL_SHM_SLOT(head)];
+    if (slot->pkt_size > sizeof (packet->data)) {
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+        return CMD_CHANNEL_INVALID_PKT_SIZE;
+    }
+
+    memcpy(packet->data, slot->data, slot->pkt_size);
+    packet->pkt_size = slot->pkt_size;
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+    packet->dest_addr = (uint8_t) cmd_channel_get_id(channel);
+    packet->state = CMD_VALID_PACKET;
+    packet->timeout_valid = false;
+
+    return 0;
+}
+
+/**
+ * Send a packet to the other end of the link.  The packet is queued and the call never blocks.
+ *
+ * @param channel The channel to send a packet on.
+ * @param packet The packet to send.
+ *
+ * @return 0 if the the packet was successfully sent or an error code.
+ */
+static int cmd_channel_shm_send_packet(struct cmd_channel *channel, struct cmd_packet *packet)
+{
+    struct cmd_channel_shm *shm = (struct cmd_channel_shm*) channel;
+    struct cmd_channel_shm_slot *slot;
+    uint32_t tail;
+
+    if (shm == NULL || packet == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    if (packet->pkt_size == 0 || packet->pkt_size > CMD_MAX_PACKET_SIZE) {
+        return CMD_CHANNEL_INVALID_PKT_SIZE;
+    }
+
+    tail = shm->tx->tail;
+    if ((tail - __atomic_load_n(&shm->tx->head, __ATOMIC_ACQUIRE)) == CMD_CHANNEL_SHM_RING_LEN) {
+        return CMD_CHANNEL_TX_FAILED;
+    }
+
+    slot = &shm->tx->slots[CMD_CHANNEL_SHM_SLOT(tail)];
+    memcpy(slot->data, packet->data, packet->pkt_size);
+    slot->pkt_size = packet->pkt_size;
+
+    return cmd_channel_shm_publish(shm, tail + 1);
+}
+
+/**
+ * Send all packets of a message to the other end of the link.  The packets are published together, so the receiver
+ * is woken at most once for the message, and the call never blocks.
+ *
+ * @param channel The channel to send the packets on.
+ * @param message The packetized message to send.
+ *
+ * @return 0 if the the packets were successfully sent or an error code.
+ */
+static int cmd_channel_shm_send_packets(struct cmd_channel *channel, struct cmd_message *message)
+{
+    struct cmd_channel_shm *shm = (struct cmd_channel_shm*) channel;
+    struct cmd_channel_shm_slot *slot;
+    const uint8_t *pkt_pos;
+    size_t msg_len;
+    size_t pkt_len;
+    size_t num_packets;
+    uint32_t tail;
+
+    if (shm == NULL || message == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    if (message->pkt_size == 0 || message->pkt_size > CMD_MAX_PACKET_SIZE) {
+        return CMD_CHANNEL_INVALID_PKT_SIZE;
+    }
+
+    if (message->msg_size == 0) {
+        return 0;
+    }
+
+    num_packets = (message->msg_size + message->pkt_size - 1) / message->pkt_size;
+
+    tail = shm->tx->tail;
+    if ((CMD_CHANNEL_SHM_RING_LEN - (tail - __atomic_load_n(&shm->tx->head, __ATOMIC_ACQUIRE))) < num_packets) {
+        return CMD_CHANNEL_TX_FAILED;
+    }
+
+    pkt_pos = message->data;
+    msg_len = message->msg_size;
+
+    while (msg_len > 0) {
+        pkt_len = (msg_len < message->pkt_size) ? msg_len : message->pkt_size;
+
+        slot = &shm->tx->slots[CMD_CHANNEL_SHM_SLOT(tail)];
+        memcpy(slot->data, pkt_pos, pkt_len);
+        slot->pkt_size = pkt_len;
+        tail++;
+
+        pkt_pos += pkt_len;
+        msg_len -= pkt_len;
+    }
+
+    return cmd_channel_shm_publish(shm, tail);
+}
+
+/**
+ * Create the shared memory and event notifications for a link between two channels.  This must be done before forking
+ * if the two ends of the link will be run in different processes.
+ *
+ * @param link The link to initialize.
+ *
+ * @return 0 if the link was initialized successfully or an error code.
+ */
+int cmd_channel_shm_link_init(struct cmd_channel_shm_link *link)
+{
+    int i;
+
+    if (link == NULL) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    memset(link, 0, sizeof (struct cmd_channel_shm_link));
+
+    /* An anonymous mapping is zero filled, so the rings start empty. */
+    link->region = mmap(NULL, sizeof (struct cmd_channel_shm_region), PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (link->region == MAP_FAILED) {
+        link->region = NULL;
+        return CMD_CHANNEL_SHM_INIT_FAILURE;
+    }
+
+    for (i = 0; i < 2; i++) {
+        link->event_fd[i] = eventfd(0, EFD_NONBLOCK);
+        if (link->event_fd[i] < 0) {
+            while (i-- > 0) {
+                close(link->event_fd[i]);
+            }
+
+            munmap(link->region, sizeof (struct cmd_channel_shm_region));
+            link->region = NULL;
+            return CMD_CHANNEL_SHM_INIT_FAILURE;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Release the resources used by a shared memory link.  Both channels using the link must be released first.  When the
+ * ends of the link are in different processes, each process releases its own copy of the link.
+ *
+ * @param link The link to release.
+ */
+void cmd_channel_shm_link_release(struct cmd_channel_shm_link *link)
+{
+    if ((link != NULL) && (link->region != NULL)) {
+        close(link->event_fd[0]);
+        close(link->event_fd[1]);
+        munmap(link->region, sizeof (struct cmd_channel_shm_region));
+        link->region = NULL;
+    }
+}
+
+/**
+ * Initialize one end of a shared memory link.  The other end is initialized with the other side of the same link,
+ * either in the same process or in a process forked after the link was created.
+ *
+ * @param channel The channel to initialize.
+ * @param id An ID to associate with the command channel.  Received packets use this as the destination address.
+ * @param link The link the channel will use.
+ * @param side The end of the link the channel is for.
+ *
+ * @return 0 if the channel was initialized successfully or an error code.
+ */
+int cmd_channel_shm_init(struct cmd_channel_shm *channel, int id, struct cmd_channel_shm_link *link,
+    enum cmd_channel_shm_side side)
+{
+    int rx = (side == CMD_CHANNEL_SHM_SIDE_A) ? 1 : 0;
+    int status;
+
+    if (channel == NULL || link == NULL || link->region == NULL ||
+        (side != CMD_CHANNEL_SHM_SIDE_A && side != CMD_CHANNEL_SHM_SIDE_B)) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    memset(channel, 0, sizeof (struct cmd_channel_shm));
+
+    status = cmd_channel_init(&channel->base, id);
+    if (status != 0) {
+        return status;
+    }
+
+    channel->base.receive_packet = cmd_channel_shm_receive_packet;
+    channel->base.send_packet = cmd_channel_shm_send_packet;
+    channel->base.send_packets = cmd_channel_shm_send_packets;
+    channel->rx = &link->region->ring[rx];
+    channel->tx = &link->region->ring[!rx];
+    channel->rx_event = link->event_fd[rx];
+    channel->tx_event = link->event_fd[!rx];
+
+    return 0;
+}
+
+/**
+ * Release the resources used by a shared memory channel.  The link must be released separately.
+ *
+ * @param channel The channel to release.
+ */
+void cmd_channel_shm_release(struct cmd_channel_shm *channel)
+{
+    if (channel != NULL) {
+        cmd_channel_release(&channel->base);
+    }
+}
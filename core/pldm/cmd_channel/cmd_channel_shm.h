@@ -0,0 +1,105 @@
+#ifndef COMMAND_CHANNEL_SHM_H_
+#define COMMAND_CHANNEL_SHM_H_
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_api.h"
+#include "cmd_interface/cmd_channel.h"
+
+
+/**
+ * Number of packets that can be queued in one direction of a shared memory link. This must be a power of two.
+ */
+#ifndef CMD_CHANNEL_SHM_RING_LEN
+#define CMD_CHANNEL_SHM_RING_LEN                    512
+#endif
+
+#if (CMD_CHANNEL_SHM_RING_LEN & (CMD_CHANNEL_SHM_RING_LEN - 1)) != 0
+#error "CMD_CHANNEL_SHM_RING_LEN must be a power of two."
+#endif
+
+/**
+ * Size used to keep the indexes updated by each side of a ring in separate cache lines.
+ */
+#define CMD_CHANNEL_SHM_CACHE_LINE                  64
+
+
+/**
+ * The two ends of a shared memory link.
+ */
+enum cmd_channel_shm_side {
+    CMD_CHANNEL_SHM_SIDE_A = 0,                                                     /**< The end that sends on ring 0 and receives on ring 1. */
+    CMD_CHANNEL_SHM_SIDE_B,                                                         /**< The end that sends on ring 1 and receives on ring 0. */
+};
+
+/**
+ * A single packet in a shared memory ring.
+ */
+struct cmd_channel_shm_slot {
+    uint16_t pkt_size;                                                              /**< Length of the packet data. */
+    uint8_t data[CMD_MAX_PACKET_SIZE];                                              /**< The packet data. */
+};
+
+/**
+ * Single producer, single consumer ring of packets travelling in one direction of a shared memory link.
+ *
+ * The producer only writes the tail and the consumer only writes the head, so no lock is needed. Both indexes run
+ * freely and are reduced to a slot when used. The consumer sets the waiting flag before it sleeps, and the producer
+ * only signals the eventfd when that flag is set, so a busy link does not need a system call for each packet.
+ */
+struct cmd_channel_shm_ring {
+    uint32_t tail;                                                                  /**< Index of the next packet to write.  Updated by the producer. */
+    uint32_t waiting;                                                               /**< Flag indicating the consumer is waiting for a packet. */
+    uint8_t pad_tail[CMD_CHANNEL_SHM_CACHE_LINE - (2 * sizeof (uint32_t))];         /**< Keep the producer index in its own cache line. */
+    uint32_t head;                                                                  /**< Index of the next packet to read.  Updated by the consumer. */
+    uint8_t pad_head[CMD_CHANNEL_SHM_CACHE_LINE - sizeof (uint32_t)];               /**< Keep the consumer index in its own cache line. */
+    struct cmd_channel_shm_slot slots[CMD_CHANNEL_SHM_RING_LEN];                    /**< Storage for the queued packets. */
+};
+
+/**
+ * The shared memory between both ends of a link.
+ */
+struct cmd_channel_shm_region {
+    struct cmd_channel_shm_ring ring[2];                                            /**< The rings for each direction of the link. */
+};
+
+/**
+ * The resources shared by both ends of a link.
+ *
+ * The region is an anonymous MAP_SHARED mapping, and each ring has an eventfd to wake a waiting consumer. The
+ * mapping and file descriptors are inherited by a forked child, so the two ends can be run in one process or in a
+ * parent and child process.
+ */
+struct cmd_channel_shm_link {
+    struct cmd_channel_shm_region *region;                                          /**< The shared rings. */
+    int event_fd[2];                                                                /**< eventfd used to signal each ring. */
+};
+
+/**
+ * A command channel that exchanges packets with the other end of a shared memory link.
+ *
+ * Sends on a channel are serialized by the base channel and only one task may receive from a channel, so each ring
+ * has a single producer and a single consumer.
+ */
+struct cmd_channel_shm {
+    struct cmd_channel base;                                                        /**< Base command channel. */
+    struct cmd_channel_shm_ring *rx;                                                /**< Ring of packets sent to this channel. */
+    struct cmd_channel_shm_ring *tx;                                                /**< Ring of packets sent by this channel. */
+    int rx_event;                                                                   /**< eventfd signaled when packets are sent to this channel. */
+    int tx_event;                                                                   /**< eventfd to signal when packets are sent by this channel. */
+};
+
+
+int cmd_channel_shm_link_init(struct cmd_channel_shm_link *link);
+void cmd_channel_shm_link_release(struct cmd_channel_shm_link *link);
+
+int cmd_channel_shm_init(struct cmd_channel_shm *channel, int id, struct cmd_channel_shm_link *link,
+    enum cmd_channel_shm_side side);
+void cmd_channel_shm_release(struct cmd_channel_shm *channel);
+
+
+/* This module will be treated as an extension of the command channel and use CMD_CHANNEL_* error codes. */
+
+
+#endif /* COMMAND_CHANNEL_SHM_H_ */
@@ -1,13 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/epoll.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <sys/time.h>
+#include <poll.h>
+#include <time.h>
 #include "platform_api.h"
 #include "cmd_channel_tcp.h"
 #include "platform_io.h"
@@ -22,7 +27,363 @@ void print_packet_data(const uint8_t *data, size_t len) {
 }
 
 
+/**
+ * An inbound connection from the peer and the stream data received on it that has not yet been
+ * returned as a packet.
+ */
+struct cmd_channel_tcp_connection {
+    int fd;                                                                         /**< The connection socket or -1 if the connection is closed. */
+    size_t length;                                                                  /**< Amount of unprocessed data in the buffer. */
+    uint8_t buffer[CMD_CHANNEL_TCP_RX_BUFFER_LEN];                                  /**< Stream data received on the connection. */
+};
+
+/* Epoll user data used to identify the listening socket. */
+#define CMD_CHANNEL_TCP_LISTEN_EVENT                CMD_CHANNEL_TCP_MAX_CONNECTIONS
+
 int global_server_fd = -1;
+static int global_epoll_fd = -1;
+static int global_client_fd = -1;
+static struct cmd_channel_tcp_connection global_connections[CMD_CHANNEL_TCP_MAX_CONNECTIONS];
+
+
+/**
+ * Get the current time from a monotonic clock in milliseconds.
+ */
+static long get_time_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
+/**
+ * Put a socket into non-blocking mode.
+ *
+ * @param fd The socket to update.
+ *
+ * @return 0 on success or an error code.
+ */
+static int set_non_blocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        return CMD_CHANNEL_FCNTL_ERROR;
+    }
+    return 0;
+}
+
+/**
+ * Close an inbound connection. Any complete packets still in the buffer remain available.
+ *
+ * @param conn The connection to close.
+ */
+static void close_connection(struct cmd_channel_tcp_connection *conn) {
+    if (conn->fd != -1) {
+        epoll_ctl(global_epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+        close(conn->fd);
+        conn->fd = -1;
+    }
+}
+
+/**
+ * Register a connected socket as an inbound connection for receive events.
+ *
+ * @param fd The connected socket.  The socket is not closed on failure.
+ *
+ * @return 0 if the connection was registered or an error code.
+ */
+static int add_connection(int fd) {
+    struct cmd_channel_tcp_connection *conn = NULL;
+    struct epoll_event event;
+    int i;
+
+    for (i = 0; i < CMD_CHANNEL_TCP_MAX_CONNECTIONS; i++) {
+        if (global_connections[i].fd == -1 && global_connections[i].length == 0) {
+            conn = &global_connections[i];
+            break;
+        }
+    }
+
+    if (conn == NULL) {
+        return CMD_CHANNEL_SOC_MAX_CONNECTIONS_ERROR;
+    }
+
+    if (set_non_blocking(fd) != 0) {
+        return CMD_CHANNEL_FCNTL_ERROR;
+    }
+
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.u32 = i;
+    if (epoll_ctl(global_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        return CMD_CHANNEL_EPOLL_ERROR;
+    }
+
+    conn->fd = fd;
+    conn->length = 0;
+    return 0;
+}
+
+/**
+ * Accept all pending connections on the listening socket and register them for receive events.
+ */
+static void accept_connections() {
+    int client_socket;
+
+    while ((client_socket = accept(global_server_fd, NULL, NULL)) >= 0) {
+        if (add_connection(client_socket) != 0) {
+            close(client_socket);
+        }
+    }
+}
+
+/**
+ * Read all data available on an inbound connection into its buffer. The connection is closed if the peer
+ * has closed it or an error occurs.
+ *
+ * @param conn The connection to read from.
+ */
+static void read_connection(struct cmd_channel_tcp_connection *conn) {
+    while (conn->length < sizeof (conn->buffer)) {
+        ssize_t bytes = read(conn->fd, &conn->buffer[conn->length], sizeof (conn->buffer) - conn->length);
+        if (bytes > 0) {
+            conn->length += bytes;
+        }
+        else if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            if (bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                close_connection(conn);
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * Remove the next complete packet from the buffer of an inbound connection.
+ *
+ * @param conn The connection to get the packet from.
+ * @param packet Output for the packet data.
+ *
+ * @return 1 if a packet was returned, 0 if there is no complete packet buffered, or an error code if the stream
+ * contains an invalid frame.
+ */
+static int extract_packet(struct cmd_channel_tcp_connection *conn, struct cmd_packet *packet) {
+    size_t pkt_len;
+    size_t frame_len;
+
+    if (conn->length < CMD_CHANNEL_TCP_FRAME_HEADER_LEN) {
+        return 0;
+    }
+
+    pkt_len = (conn->buffer[0] << 8) | conn->buffer[1];
+    if (pkt_len == 0 || pkt_len > MCTP_BASE_PROTOCOL_MAX_PACKET_LEN) {
+        return CMD_CHANNEL_PKT_TOO_LARGE_ERROR;
+    }
+
+    frame_len = CMD_CHANNEL_TCP_FRAME_HEADER_LEN + pkt_len;
+    if (conn->length < frame_len) {
+        return 0;
+    }
+
+    memcpy(packet->data, &conn->buffer[CMD_CHANNEL_TCP_FRAME_HEADER_LEN], pkt_len);
+    packet->pkt_size = pkt_len;
+
+    conn->length -= frame_len;
+    memmove(conn->buffer, &conn->buffer[frame_len], conn->length);
+
+    return 1;
+}
+
+/**
+ * Check if the persistent connection to the peer is still open. The peer never sends data on this
+ * connection, so any readable event means the peer has closed it.
+ *
+ * @param fd The connection to check.
+ *
+ * @return true if the connection is still usable.
+ */
+static bool is_client_connected(int fd) {
+    uint8_t byte;
+    ssize_t bytes = recv(fd, &byte, sizeof (byte), MSG_PEEK | MSG_DONTWAIT);
+
+    if (bytes == 0) {
+        return false;
+    }
+    else if (bytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Open the persistent connection to the peer, retrying until the peer is listening or the timeout expires.
+ *
+ * @param ms_timeout The amount of time to wait for the peer, in milliseconds.
+ *
+ * @return 0 if the connection was opened or an error code.
+ */
+static int connect_to_peer(int ms_timeout) {
+    struct sockaddr_in serv_addr;
+    int opt = 1;
+    long start;
+    int sock;
+
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+
+// If Cerberus is the FD then it should connect to the UA port
+#if PLDM_TESTING_ENABLE_FIRMWARE_DEVICE == 1
+    serv_addr.sin_port = htons(PLDM_TESTING_UPDATE_AGENT_PORT);
+#else
+    serv_addr.sin_port = htons(PLDM_TESTING_FIRMWARE_DEVICE_PORT);
+#endif
+
+    if (inet_pton(AF_INET, "127.0.0.1", &serv_addr.sin_addr) <= 0) {
+        return CMD_CHANNEL_SOC_INET_ERROR;
+    }
+
+    start = get_time_ms();
+    do {
+        if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+            return CMD_CHANNEL_CREATE_SOC_ERROR;
+        }
+
+        if (connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) == 0) {
+            /* Packets are small and latency sensitive, so don't let them wait to be coalesced. */
+            setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+
+            if (set_non_blocking(sock) != 0) {
+                close(sock);
+                return CMD_CHANNEL_FCNTL_ERROR;
+            }
+
+            global_client_fd = sock;
+            return 0;
+        }
+
+        close(sock);
+        usleep(10000);
+    } while ((get_time_ms() - start) < ms_timeout);
+
+    platform_printf("Time-out reached.\n");
+    return CMD_CHANNEL_SOC_CONNECT_ERROR;
+}
+
+/**
+ * Write a sequence of complete frames to the persistent connection to the peer with as few system calls as
+ * possible.  The I/O vector is updated as data is written.
+ *
+ * @param iov The frame data to write.
+ * @param iov_count The number of entries in the I/O vector.
+ * @param ms_timeout The amount of time to wait for the connection to accept the data, in milliseconds.
+ * @param written Output for the number of bytes written to the connection, even if not all frames were written.
+ *
+ * @return 0 if the frames were written or an error code.
+ */
+static int write_frames(struct iovec *iov, size_t iov_count, int ms_timeout, size_t *written) {
+    long start = get_time_ms();
+    struct msghdr msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_count;
+    *written = 0;
+
+    while (msg.msg_iovlen > 0) {
+        ssize_t bytes = sendmsg(global_client_fd, &msg, MSG_NOSIGNAL);
+        if (bytes > 0) {
+            *written += bytes;
+
+            while ((msg.msg_iovlen > 0) && ((size_t) bytes >= msg.msg_iov->iov_len)) {
+                bytes -= msg.msg_iov->iov_len;
+                msg.msg_iov++;
+                msg.msg_iovlen--;
+            }
+
+            if (bytes > 0) {
+                msg.msg_iov->iov_base = (uint8_t*) msg.msg_iov->iov_base + bytes;
+                msg.msg_iov->iov_len -= bytes;
+            }
+        }
+        else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd pfd = {.fd = global_client_fd, .events = POLLOUT};
+            long remaining = ms_timeout - (get_time_ms() - start);
+
+            if (remaining <= 0 || poll(&pfd, 1, remaining) <= 0) {
+                return CMD_CHANNEL_SOC_TIMEOUT_ERROR;
+            }
+        }
+        else if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            return CMD_CHANNEL_SOC_SEND_ERROR;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Send a sequence of complete frames to the peer, opening the persistent connection if necessary.
+ *
+ * @param frames The frame data to send.
+ * @param iov_count The number of entries in the I/O vector.  This can't be more than two entries for each packet in
+ * a batch.
+ *
+ * @return 0 if the frames were sent or an error code.
+ */
+static int send_frames(const struct iovec *frames, size_t iov_count) {
+    struct iovec iov[CMD_CHANNEL_TCP_MAX_BATCH_PACKETS * 2];
+    int ms_timeout = PLDM_TESTING_MS_TIMEOUT;
+    size_t written;
+    int attempt;
+    int status;
+
+    if (iov_count > (sizeof(iov) / sizeof(iov[0]))) {
+        return CMD_CHANNEL_INVALID_ARGUMENT;
+    }
+
+    /* If the peer restarted, the old connection is dropped and the frames are sent on a new one. */
+    for (attempt = 0; attempt < 2; attempt++) {
+        if (global_client_fd != -1 && !is_client_connected(global_client_fd)) {
+            close(global_client_fd);
+            global_client_fd = -1;
+        }
+
+        if (global_client_fd == -1) {
+            status = connect_to_peer(ms_timeout);
+            if (status != 0) {
+                return status;
+            }
+        }
+
+        /* Writing updates the I/O vector, so every attempt starts again from the original frames. */
+        memcpy(iov, frames, iov_count * sizeof(struct iovec));
+
+        status = write_frames(iov, iov_count, ms_timeout, &written);
+        if (status == 0) {
+            return 0;
+        }
+
+        if (written != 0) {
+            /* The peer may have received part of a frame, so the stream can't be used for any more frames.  Resending
+             * the frames could deliver some of them twice. */
+            close(global_client_fd);
+            global_client_fd = -1;
+            return status;
+        }
+
+        if (status != CMD_CHANNEL_SOC_SEND_ERROR) {
+            return status;
+        }
+
+        close(global_client_fd);
+        global_client_fd = -1;
+    }
+
+    return status;
+}
 
 int initialize_global_server_socket() {
     if (global_server_fd != -1) {
@@ -30,9 +391,17 @@ int initialize_global_server_socket() {
     }
 
     struct sockaddr_in address;
+    struct epoll_event event;
     int opt = 1;
+    int i;
 
-    if ((global_server_fd = socket(AF_INET, SOCK_STREAM, 0)) == 0) {
+    for (i = 0; i < CMD_CHANNEL_TCP_MAX_CONNECTIONS; i++) {
+        global_connections[i].fd = -1;
+        global_connections[i].length = 0;
+    }
+
+    if ((global_server_fd = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        global_server_fd = -1;
         return CMD_CHANNEL_CREATE_SOC_ERROR;
     }
 
@@ -62,11 +431,82 @@ int initialize_global_server_socket() {
         return CMD_CHANNEL_SOC_LISTEN_ERROR;
     }
 
+    if (set_non_blocking(global_server_fd) != 0) {
+        close(global_server_fd);
+        global_server_fd = -1;
+        return CMD_CHANNEL_FCNTL_ERROR;
+    }
+
+    global_epoll_fd = epoll_create1(0);
+    event.events = EPOLLIN;
+    event.data.u32 = CMD_CHANNEL_TCP_LISTEN_EVENT;
+    if (global_epoll_fd < 0 || epoll_ctl(global_epoll_fd, EPOLL_CTL_ADD, global_server_fd, &event) < 0) {
+        if (global_epoll_fd >= 0) {
+            close(global_epoll_fd);
+            global_epoll_fd = -1;
+        }
+        close(global_server_fd);
+        global_server_fd = -1;
+        return CMD_CHANNEL_EPOLL_ERROR;
+    }
+
     return 0;
 }
 
+/**
+ * Receive packets on a stream socket that is already connected to the peer instead of one accepted on the listening
+ * socket.  The server socket must be initialized first.
+ *
+ * @param fd The connected socket.  The channel takes ownership of the socket if it is added.
+ *
+ * @return 0 if the connection was added or an error code.
+ */
+int add_global_server_connection(int fd) {
+    if (global_server_fd == -1) {
+        return CMD_CHANNEL_CREATE_SOC_ERROR;
+    }
+
+    return add_connection(fd);
+}
+
+/**
+ * Send packets on a stream socket that is already connected to the peer instead of connecting to the peer port.  Any
+ * existing connection to the peer is closed.
+ *
+ * @param fd The connected socket.  The channel takes ownership of the socket if it is used.
+ *
+ * @return 0 if the connection will be used or an error code.
+ */
+int set_global_client_connection(int fd) {
+    if (set_non_blocking(fd) != 0) {
+        return CMD_CHANNEL_FCNTL_ERROR;
+    }
+
+    if (global_client_fd != -1) {
+        close(global_client_fd);
+    }
+    global_client_fd = fd;
+    return 0;
+}
 
 void close_global_server_socket() {
+    int i;
+
+    for (i = 0; i < CMD_CHANNEL_TCP_MAX_CONNECTIONS; i++) {
+        close_connection(&global_connections[i]);
+        global_connections[i].length = 0;
+    }
+
+    if (global_client_fd != -1) {
+        close(global_client_fd);
+        global_client_fd = -1;
+    }
+
+    if (global_epoll_fd != -1) {
+        close(global_epoll_fd);
+        global_epoll_fd = -1;
+    }
+
     close(global_server_fd);
     global_server_fd = -1;
     usleep(100000);
@@ -88,32 +528,63 @@ int receive_packet(struct cmd_channel *channel, struct cmd_packet *packet, int m
         return CMD_CHANNEL_CREATE_SOC_ERROR;
     }
 
-    int client_socket;
-    struct sockaddr_in address;
-    int addrlen = sizeof(address);
+    struct epoll_event events[CMD_CHANNEL_TCP_MAX_CONNECTIONS + 1];
+    long start = get_time_ms();
+    bool polled = false;
+    int num_events;
+    int status;
+    int i;
+
+    while (1) {
+        /* Return packets already buffered before waiting for more data. */
+        for (i = 0; i < CMD_CHANNEL_TCP_MAX_CONNECTIONS; i++) {
+            status = extract_packet(&global_connections[i], packet);
+            if (status == 1) {
+                packet->dest_addr = (uint8_t)cmd_channel_get_id(channel);
+                return 0;
+            }
+            else if (status != 0) {
+                /* The stream can't be resynchronized after an invalid frame. */
+                close_connection(&global_connections[i]);
+                global_connections[i].length = 0;
+            }
+        }
 
-    struct timeval start, now;
-    gettimeofday(&start, NULL);
-    long elapsed_ms;
+        int remaining = -1;
+        if (ms_timeout >= 0) {
+            remaining = ms_timeout - (get_time_ms() - start);
+            if (remaining < 0) {
+                remaining = 0;
+            }
+            if (remaining == 0 && polled) {
+                break;
+            }
+        }
 
-    do {
-        client_socket = accept(global_server_fd, (struct sockaddr *)&address, (socklen_t*)&addrlen);
-        gettimeofday(&now, NULL);
-        elapsed_ms = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_usec - start.tv_usec) / 1000;
-    } while (client_socket < 0 && elapsed_ms < ms_timeout);
+        num_events = epoll_wait(global_epoll_fd, events, CMD_CHANNEL_TCP_MAX_CONNECTIONS + 1, remaining);
+        polled = true;
+        if (num_events < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return CMD_CHANNEL_EPOLL_ERROR;
+        }
 
-    if (client_socket < 0) {
-        platform_printf("Time-out reached.\n");
-        return CMD_CHANNEL_SOC_ACCEPT_ERROR;
+        for (i = 0; i < num_events; i++) {
+            if (events[i].data.u32 == CMD_CHANNEL_TCP_LISTEN_EVENT) {
+                accept_connections();
+            }
+            else if (global_connections[events[i].data.u32].fd != -1) {
+                read_connection(&global_connections[events[i].data.u32]);
+            }
+        }
     }
 
-    ssize_t valread = read(client_socket, packet->data, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN);
-    packet->pkt_size = valread;
-    packet->dest_addr = (uint8_t)cmd_channel_get_id(channel);
-
-    close(client_socket);
-
-    return 0;
+    /* An empty poll is expected and not worth reporting. */
+    if (ms_timeout != 0) {
+        platform_printf("Time-out reached.\n");
+    }
+    return CMD_CHANNEL_SOC_TIMEOUT_ERROR;
 }
 
 
@@ -131,47 +602,67 @@ int receive_packet(struct cmd_channel *channel, struct cmd_packet *packet, int m
 * @return 0 if the the packet was successfully sent or an error code.
 */
 int send_packet(struct cmd_channel *channel, struct cmd_packet *packet) {
-    struct sockaddr_in serv_addr;
-    int sock = 0;
-    int ms_timeout = PLDM_TESTING_MS_TIMEOUT;
+    uint8_t header[CMD_CHANNEL_TCP_FRAME_HEADER_LEN];
+    struct iovec iov[2];
 
-    memset(&serv_addr, '0', sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
+    if (packet->pkt_size == 0 || packet->pkt_size > MCTP_BASE_PROTOCOL_MAX_PACKET_LEN) {
+        return CMD_CHANNEL_PKT_TOO_LARGE_ERROR;
+    }
 
-// If Cerberus is the FD then it should connect to the UA port
-#if PLDM_TESTING_ENABLE_FIRMWARE_DEVICE == 1
-    serv_addr.sin_port = htons(PLDM_TESTING_UPDATE_AGENT_PORT);
-#else
-    serv_addr.sin_port = htons(PLDM_TESTING_FIRMWARE_DEVICE_PORT);
-#endif
+    header[0] = (packet->pkt_size >> 8) & 0xff;
+    header[1] = packet->pkt_size & 0xff;
 
-    if (inet_pton(AF_INET, "127.0.0.1", &serv_addr.sin_addr) <= 0) {
-        return CMD_CHANNEL_SOC_INET_ERROR;
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = packet->data;
+    iov[1].iov_len = packet->pkt_size;
+
+    return send_frames(iov, 2);
+}
+
+/**
+* Send all packets of a packetized message over a communication channel.  Frames for as many packets as
+* possible are written to the connection with a single system call.
+*
+* @param channel The channel to send the packets on.
+* @param message The packetized message to send.
+*
+* @return 0 if the packets were successfully sent or an error code.
+*/
+int send_packets(struct cmd_channel *channel, struct cmd_message *message) {
+    uint8_t headers[CMD_CHANNEL_TCP_MAX_BATCH_PACKETS][CMD_CHANNEL_TCP_FRAME_HEADER_LEN];
+    struct iovec iov[CMD_CHANNEL_TCP_MAX_BATCH_PACKETS * 2];
+    uint8_t *pkt_pos = message->data;
+    size_t msg_len = message->msg_size;
+    size_t pkt_len;
+    size_t count;
+    int status;
+
+    if (message->pkt_size == 0 || message->pkt_size > MCTP_BASE_PROTOCOL_MAX_PACKET_LEN) {
+        return CMD_CHANNEL_PKT_TOO_LARGE_ERROR;
     }
 
-    struct timeval start, now;
-    gettimeofday(&start, NULL);
-    long elapsed_ms = 0;
+    while (msg_len > 0) {
+        for (count = 0; (count < CMD_CHANNEL_TCP_MAX_BATCH_PACKETS) && (msg_len > 0); count++) {
+            pkt_len = (msg_len < message->pkt_size) ? msg_len : message->pkt_size;
 
-    while (elapsed_ms < ms_timeout) {
-        if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
-            return CMD_CHANNEL_CREATE_SOC_ERROR;
-        }
+            headers[count][0] = (pkt_len >> 8) & 0xff;
+            headers[count][1] = pkt_len & 0xff;
 
-        int result = connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr));
-        if (result == 0) {
-            send(sock, packet->data, packet->pkt_size, 0);
-            close(sock);
-            return 0;
-        } else {
-            close(sock);
-            usleep(100000);
+            iov[count * 2].iov_base = headers[count];
+            iov[count * 2].iov_len = CMD_CHANNEL_TCP_FRAME_HEADER_LEN;
+            iov[(count * 2) + 1].iov_base = pkt_pos;
+            iov[(count * 2) + 1].iov_len = pkt_len;
+
+            pkt_pos += pkt_len;
+            msg_len -= pkt_len;
         }
 
-        gettimeofday(&now, NULL);
-        elapsed_ms = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_usec - start.tv_usec) / 1000;
+        status = send_frames(iov, count * 2);
+        if (status != 0) {
+            return status;
+        }
     }
 
-    platform_printf("Time-out reached.\n");
-    return CMD_CHANNEL_SOC_CONNECT_ERROR;
+    return 0;
 }
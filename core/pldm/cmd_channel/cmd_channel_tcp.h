@@ -7,6 +7,30 @@
 #include "cmd_interface/cmd_channel.h"
 #include "cmd_interface/cmd_interface.h"
 
+
+/**
+ * Packets are sent over a single persistent TCP connection to the peer. Each packet is framed with a 2 byte,
+ * big endian length so several packets can be received in a single stream read.
+ */
+#define CMD_CHANNEL_TCP_FRAME_HEADER_LEN            2
+
+/**
+ * Maximum number of inbound connections that can be open at once. A peer normally only keeps one connection
+ * open, but a stale connection can remain while the peer reconnects.
+ */
+#define CMD_CHANNEL_TCP_MAX_CONNECTIONS             4
+
+/**
+ * Size of the receive buffer for each inbound connection.
+ */
+#define CMD_CHANNEL_TCP_RX_BUFFER_LEN               (8 * (CMD_CHANNEL_TCP_FRAME_HEADER_LEN + MCTP_BASE_PROTOCOL_MAX_PACKET_LEN))
+
+/**
+ * Maximum number of packets written to the connection in a single system call when sending a message.
+ */
+#define CMD_CHANNEL_TCP_MAX_BATCH_PACKETS           32
+
+
 enum {
     CMD_CHANNEL_CREATE_SOC_ERROR = -1000,
     CMD_CHANNEL_SET_SOC_OPT_ERROR,
@@ -16,10 +40,18 @@ enum {
     CMD_CHANNEL_SOC_INET_ERROR,
     CMD_CHANNEL_SOC_CONNECT_ERROR,
     CMD_CHANNEL_FCNTL_ERROR,
+    CMD_CHANNEL_EPOLL_ERROR,
+    CMD_CHANNEL_SOC_SEND_ERROR,
+    CMD_CHANNEL_SOC_TIMEOUT_ERROR,
+    CMD_CHANNEL_PKT_TOO_LARGE_ERROR,
+    CMD_CHANNEL_SOC_MAX_CONNECTIONS_ERROR,
 };
 
 int initialize_global_server_socket();
+int add_global_server_connection(int fd);
+int set_global_client_connection(int fd);
 int send_packet(struct cmd_channel *channel, struct cmd_packet *packet);
+int send_packets(struct cmd_channel *channel, struct cmd_message *message);
 int receive_packet(struct cmd_channel *channel, struct cmd_packet *packet, int ms_timeout);
 void close_global_server_socket();
 
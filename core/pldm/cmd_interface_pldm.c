@@ -90,7 +90,8 @@ static int cmd_interface_pldm_process_request (struct cmd_interface *intf,
             break;
         case PLDM_UPDATE_COMPONENT:
             status = pldm_fwup_process_update_component_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info,
-                interface->fwup_mgr->fd_mgr.update_info.comp_entries, request);
+                interface->fwup_mgr->fd_mgr.update_info.comp_entries, interface->fwup_mgr->fd_mgr.flash_mgr,
+                &interface->fwup_mgr->fd_mgr.comp_hash, request);
             break;
         case PLDM_ACTIVATE_FIRMWARE:
             status = pldm_fwup_process_activate_firmware_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info, request);
@@ -99,11 +100,12 @@ static int cmd_interface_pldm_process_request (struct cmd_interface *intf,
             status = pldm_fwup_process_get_status_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info, request);
             break;
         case PLDM_CANCEL_UPDATE_COMPONENT:
-            status = pldm_fwup_process_cancel_update_component_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info, request);
+            status = pldm_fwup_process_cancel_update_component_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info,
+                interface->fwup_mgr->fd_mgr.flash_mgr, &interface->fwup_mgr->fd_mgr.comp_hash, request);
             break;
         case PLDM_CANCEL_UPDATE:
             status = pldm_fwup_process_cancel_update_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info,
-                interface->fwup_mgr->fd_mgr.flash_mgr, request);
+                interface->fwup_mgr->fd_mgr.flash_mgr, &interface->fwup_mgr->fd_mgr.comp_hash, request);
             break;
         //Update Agent
         case PLDM_GET_PACKAGE_DATA:
@@ -166,7 +168,7 @@ static int cmd_interface_pldm_process_response (struct cmd_interface *intf,
             break;
         case PLDM_REQUEST_FIRMWARE_DATA:
             status = pldm_fwup_process_request_firmware_data_response(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info,
-                interface->fwup_mgr->fd_mgr.flash_mgr, response);
+                interface->fwup_mgr->fd_mgr.flash_mgr, &interface->fwup_mgr->fd_mgr.comp_hash, response);
             break;
         case PLDM_TRANSFER_COMPLETE:
             status = pldm_fwup_process_transfer_complete_response(&interface->fwup_mgr->fd_mgr.state, response);
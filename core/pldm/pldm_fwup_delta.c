@@ -0,0 +1,565 @@
+#include <stddef.h>
+#include <string.h>
+#include "pldm_fwup_delta.h"
+#include "flash/flash_util.h"
+
+
+/**
+ * Write data to flash and check that all of it was written.
+ *
+ * @param flash The flash to write to.
+ * @param addr The flash address to write to.
+ * @param data The data to write.
+ * @param length The length of the data.
+ *
+ * @return 0 if the data was written or an error code.
+ */
+static int pldm_fwup_delta_write(const struct flash *flash, uint32_t addr, const uint8_t *data, size_t length)
+{
+    int status = flash->write(flash, addr, data, length);
+
+    if (ROT_IS_ERROR(status)) {
+        return status;
+    }
+
+    return ((size_t) status == length) ? 0 : FLASH_UTIL_INCOMPLETE_WRITE;
+}
+
+/**
+ * Store a value in little endian byte order.
+ *
+ * @param raw The buffer to store the value in.
+ * @param value The value to store.
+ * @param length The number of bytes to store.
+ */
+static void pldm_fwup_delta_put_le(uint8_t *raw, uint32_t value, size_t length)
+{
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        raw[i] = (uint8_t) (value >> (i * 8));
+    }
+}
+
+/**
+ * Load a value stored in little endian byte order.
+ *
+ * @param raw The buffer that contains the value.
+ * @param length The number of bytes to load.
+ *
+ * @return The value.
+ */
+static uint32_t pldm_fwup_delta_get_le(const uint8_t *raw, size_t length)
+{
+    uint32_t value = 0;
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        value |= ((uint32_t) raw[i]) << (i * 8);
+    }
+
+    return value;
+}
+
+/**
+ * Encode the header of the block digests as it is stored in the package data.  All fields are little endian.
+ *
+ * @param header The header to encode.
+ * @param raw Output for the encoded header.
+ */
+static void pldm_fwup_delta_encode_header(const struct pldm_fwup_delta_header *header,
+    uint8_t raw[sizeof (struct pldm_fwup_delta_header)])
+{
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_header, marker)], header->marker,
+        sizeof (header->marker));
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_header, hash_type)], header->hash_type,
+        sizeof (header->hash_type));
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_header, block_size)], header->block_size,
+        sizeof (header->block_size));
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_header, num_components)], header->num_components,
+        sizeof (header->num_components));
+}
+
+/**
+ * Decode the header of the block digests stored in the package data.
+ *
+ * @param raw The encoded header.
+ * @param header Output for the decoded header.
+ */
+static void pldm_fwup_delta_decode_header(const uint8_t raw[sizeof (struct pldm_fwup_delta_header)],
+    struct pldm_fwup_delta_header *header)
+{
+    header->marker = pldm_fwup_delta_get_le(&raw[offsetof (struct pldm_fwup_delta_header, marker)],
+        sizeof (header->marker));
+    header->hash_type = pldm_fwup_delta_get_le(&raw[offsetof (struct pldm_fwup_delta_header, hash_type)],
+        sizeof (header->hash_type));
+    header->block_size = pldm_fwup_delta_get_le(&raw[offsetof (struct pldm_fwup_delta_header, block_size)],
+        sizeof (header->block_size));
+    header->num_components = pldm_fwup_delta_get_le(&raw[offsetof (struct pldm_fwup_delta_header, num_components)],
+        sizeof (header->num_components));
+}
+
+/**
+ * Encode the block digest entry of a component as it is stored in the package data.  All fields are little endian.
+ *
+ * @param entry The component entry to encode.
+ * @param raw Output for the encoded entry.
+ */
+static void pldm_fwup_delta_encode_component(const struct pldm_fwup_delta_component *entry,
+    uint8_t raw[sizeof (struct pldm_fwup_delta_component)])
+{
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_component, comp_classification)],
+        entry->comp_classification, sizeof (entry->comp_classification));
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_component, comp_identifier)],
+        entry->comp_identifier, sizeof (entry->comp_identifier));
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_component, comp_img_size)], entry->comp_img_size,
+        sizeof (entry->comp_img_size));
+    pldm_fwup_delta_put_le(&raw[offsetof (struct pldm_fwup_delta_component, digest_offset)], entry->digest_offset,
+        sizeof (entry->digest_offset));
+}
+
+/**
+ * Decode the block digest entry of a component stored in the package data.
+ *
+ * @param raw The encoded entry.
+ * @param entry Output for the decoded component entry.
+ */
+static void pldm_fwup_delta_decode_component(const uint8_t raw[sizeof (struct pldm_fwup_delta_component)],
+    struct pldm_fwup_delta_component *entry)
+{
+    entry->comp_classification = pldm_fwup_delta_get_le(
+        &raw[offsetof (struct pldm_fwup_delta_component, comp_classification)], sizeof (entry->comp_classification));
+    entry->comp_identifier = pldm_fwup_delta_get_le(
+        &raw[offsetof (struct pldm_fwup_delta_component, comp_identifier)], sizeof (entry->comp_identifier));
+    entry->comp_img_size = pldm_fwup_delta_get_le(&raw[offsetof (struct pldm_fwup_delta_component, comp_img_size)],
+        sizeof (entry->comp_img_size));
+    entry->digest_offset = pldm_fwup_delta_get_le(&raw[offsetof (struct pldm_fwup_delta_component, digest_offset)],
+        sizeof (entry->digest_offset));
+}
+
+/**
+ * Get the number of blocks needed to cover a component image.
+ *
+ * @param comp_img_size The size of the component image.
+ * @param block_size The size of each block.
+ *
+ * @return The number of blocks.
+ */
+static uint32_t pldm_fwup_delta_get_num_blocks(uint32_t comp_img_size, uint32_t block_size)
+{
+    return (uint32_t) (((uint64_t) comp_img_size + block_size - 1) / block_size);
+}
+
+/**
+ * Calculate block digests for the component images of a firmware update and store them as the package data the UA
+ * sends to the FD.  An FD that supports delta updates uses the digests to request only the blocks of each component
+ * that differ from its active image.
+ *
+ * @param flash_mgr The flash manager for the UA.  The block digests replace any existing package data.
+ * @param comp_entries The component images that will be sent to the FD.
+ * @param num_components The number of component images.
+ * @param block_size The size of each block of a component image.
+ * @param hash The hash engine to use for the block digests.
+ * @param type The type of hash to use for the block digests.
+ *
+ * @return 0 if the block digests were stored or an error code.
+ *
+ * @note For AMI, the package data is otherwise unused by this implementation.  A package that needs its own package
+ *       data can't use delta updates.
+ */
+int pldm_fwup_delta_generate(struct pldm_fwup_flash_manager *flash_mgr,
+    const struct pldm_fwup_fup_component_image_entry *comp_entries, uint16_t num_components, uint32_t block_size,
+    struct hash_engine *hash, enum hash_type type)
+{
+    struct pldm_fwup_delta_header header;
+    struct pldm_fwup_delta_component entry;
+    uint8_t raw_header[sizeof (struct pldm_fwup_delta_header)];
+    uint8_t raw_entry[sizeof (struct pldm_fwup_delta_component)];
+    uint8_t digest[HASH_MAX_HASH_LEN];
+    uint32_t addr;
+    uint32_t offset;
+    uint32_t length;
+    size_t total;
+    int hash_length;
+    int i;
+    int status;
+
+    if ((flash_mgr == NULL) || (flash_mgr->flash == NULL) || (flash_mgr->comp_regions == NULL) ||
+        (comp_entries == NULL) || (num_components == 0) || (block_size == 0) || (hash == NULL)) {
+        return PLDM_FWUP_DELTA_INVALID_ARGUMENT;
+    }
+
+    hash_length = hash_get_hash_length(type);
+    if (ROT_IS_ERROR(hash_length)) {
+        return PLDM_FWUP_DELTA_UNSUPPORTED_HASH;
+    }
+
+    total = sizeof (header) + (num_components * sizeof (entry));
+    for (i = 0; i < num_components; i++) {
+        if (pldm_fwup_delta_get_num_blocks(comp_entries[i].comp_size, block_size) > PLDM_FWUP_PROTOCOL_MAX_DELTA_BLOCKS) {
+            return PLDM_FWUP_DELTA_TOO_MANY_BLOCKS;
+        }
+        total += pldm_fwup_delta_get_num_blocks(comp_entries[i].comp_size, block_size) * hash_length;
+    }
+
+    /* RequestUpdate reports the package data length in 16 bits. */
+    if (total > UINT16_MAX) {
+        return PLDM_FWUP_DELTA_PACKAGE_DATA_TOO_LARGE;
+    }
+
+    if (total > flash_mgr->package_data_region.length) {
+        return PLDM_FWUP_DELTA_SMALL_PACKAGE_REGION;
+    }
+
+    status = flash_sector_erase_region(flash_mgr->flash, flash_mgr->package_data_region.start_addr, total);
+    if (status != 0) {
+        return status;
+    }
+
+    header.marker = PLDM_FWUP_DELTA_MARKER;
+    header.hash_type = type;
+    header.block_size = block_size;
+    header.num_components = num_components;
+
+    addr = flash_mgr->package_data_region.start_addr;
+    pldm_fwup_delta_encode_header(&header, raw_header);
+    status = pldm_fwup_delta_write(flash_mgr->flash, addr, raw_header, sizeof (raw_header));
+    if (status != 0) {
+        return status;
+    }
+
+    /* Digests follow the component table, in the same order as the components. */
+    offset = sizeof (header) + (num_components * sizeof (entry));
+    for (i = 0; i < num_components; i++) {
+        entry.comp_classification = comp_entries[i].comp_classification;
+        entry.comp_identifier = comp_entries[i].comp_identifier;
+        entry.comp_img_size = comp_entries[i].comp_size;
+        entry.digest_offset = offset;
+
+        pldm_fwup_delta_encode_component(&entry, raw_entry);
+        status = pldm_fwup_delta_write(flash_mgr->flash, addr + sizeof (header) + (i * sizeof (entry)), raw_entry,
+            sizeof (raw_entry));
+        if (status != 0) {
+            return status;
+        }
+
+        for (length = 0; length < comp_entries[i].comp_size; length += block_size) {
+            status = flash_hash_contents(flash_mgr->flash, flash_mgr->comp_regions[i].start_addr + length,
+                ((comp_entries[i].comp_size - length) < block_size) ? (comp_entries[i].comp_size - length) : block_size,
+                hash, type, digest, sizeof (digest));
+            if (status != 0) {
+                return status;
+            }
+
+            status = pldm_fwup_delta_write(flash_mgr->flash, addr + offset, digest, hash_length);
+            if (status != 0) {
+                return status;
+            }
+            offset += hash_length;
+        }
+    }
+
+    flash_mgr->package_data_size = total;
+
+    return 0;
+}
+
+/**
+ * Find the block digests for a component in the package data received by the FD.
+ *
+ * @param flash_mgr The flash manager for the FD.
+ * @param package_data_len The length of the package data received from the UA.
+ * @param comp_entry The component being updated.
+ * @param comp_img_size The size of the component image being updated.
+ * @param header Output for the header of the block digests.
+ * @param entry Output for the entry of the component.
+ *
+ * @return 1 if block digests were found for the component, 0 if not, or an error code.
+ */
+static int pldm_fwup_delta_find_component(struct pldm_fwup_flash_manager *flash_mgr, size_t package_data_len,
+    const struct pldm_fwup_protocol_component_entry *comp_entry, uint32_t comp_img_size,
+    struct pldm_fwup_delta_header *header, struct pldm_fwup_delta_component *entry)
+{
+    uint8_t raw_header[sizeof (struct pldm_fwup_delta_header)];
+    uint8_t raw_entry[sizeof (struct pldm_fwup_delta_component)];
+    uint32_t addr = flash_mgr->package_data_region.start_addr;
+    int i;
+    int status;
+
+    if (package_data_len < sizeof (*header)) {
+        return 0;
+    }
+
+    status = flash_mgr->flash->read(flash_mgr->flash, addr, raw_header, sizeof (raw_header));
+    if (status != 0) {
+        return status;
+    }
+
+    pldm_fwup_delta_decode_header(raw_header, header);
+
+    if ((header->marker != PLDM_FWUP_DELTA_MARKER) || (header->block_size == 0) ||
+        ((sizeof (*header) + (header->num_components * sizeof (*entry))) > package_data_len)) {
+        return 0;
+    }
+
+    for (i = 0; i < header->num_components; i++) {
+        status = flash_mgr->flash->read(flash_mgr->flash, addr + sizeof (*header) + (i * sizeof (*entry)),
+            raw_entry, sizeof (raw_entry));
+        if (status != 0) {
+            return status;
+        }
+
+        pldm_fwup_delta_decode_component(raw_entry, entry);
+
+        if ((entry->comp_classification == comp_entry->comp_classification) &&
+            (entry->comp_identifier == comp_entry->comp_identifier) && (entry->comp_img_size == comp_img_size)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Start determining which blocks of a component image differ from the active image on the FD.  The block digests
+ * provided by the UA in the package data are located, but no blocks are compared until
+ * pldm_fwup_delta_continue_map is called.
+ *
+ * @param map The map of changed blocks to build.
+ * @param flash_mgr The flash manager for the FD.
+ * @param package_data_len The length of the package data received from the UA.
+ * @param comp_num The index of the component in the component table.
+ * @param comp_entry The component being updated.
+ * @param comp_img_size The size of the component image being updated.
+ *
+ * @return 0 if the map was started or an error code.  If the package data has no block digests for the component or
+ * the active image can't be used, the map is left inactive, no blocks need to be compared, and 0 is returned.
+ */
+int pldm_fwup_delta_start_map(struct pldm_fwup_fd_delta_map *map, struct pldm_fwup_flash_manager *flash_mgr,
+    size_t package_data_len, uint16_t comp_num, const struct pldm_fwup_protocol_component_entry *comp_entry,
+    uint32_t comp_img_size)
+{
+    struct pldm_fwup_delta_header header;
+    struct pldm_fwup_delta_component entry;
+    const struct flash_region *active;
+    const struct flash_region *staging;
+    uint32_t num_blocks;
+    int hash_length;
+    int status;
+
+    if ((map == NULL) || (flash_mgr == NULL) || (flash_mgr->flash == NULL) || (comp_entry == NULL)) {
+        return PLDM_FWUP_DELTA_INVALID_ARGUMENT;
+    }
+
+    memset(map, 0, sizeof (struct pldm_fwup_fd_delta_map));
+
+    if ((flash_mgr->active_comp_regions == NULL) || (flash_mgr->comp_regions == NULL) || (comp_img_size == 0)) {
+        return 0;
+    }
+
+    status = pldm_fwup_delta_find_component(flash_mgr, package_data_len, comp_entry, comp_img_size, &header, &entry);
+    if (status != 1) {
+        return status;
+    }
+
+    hash_length = hash_get_hash_length(header.hash_type);
+    if (ROT_IS_ERROR(hash_length)) {
+        return 0;
+    }
+
+    num_blocks = pldm_fwup_delta_get_num_blocks(comp_img_size, header.block_size);
+    if ((num_blocks > PLDM_FWUP_PROTOCOL_MAX_DELTA_BLOCKS) ||
+        (((uint64_t) entry.digest_offset + ((uint64_t) num_blocks * hash_length)) > package_data_len)) {
+        return 0;
+    }
+
+    /* Unchanged blocks are copied from the active image, so it must not be overwritten by the download. */
+    active = &flash_mgr->active_comp_regions[comp_num];
+    staging = &flash_mgr->comp_regions[comp_num];
+    if ((active->start_addr < (staging->start_addr + staging->length)) &&
+        (staging->start_addr < (active->start_addr + active->length))) {
+        return 0;
+    }
+
+    map->block_size = header.block_size;
+    map->num_blocks = num_blocks;
+    map->hash_type = header.hash_type;
+    map->comp_img_size = comp_img_size;
+    map->digest_addr = flash_mgr->package_data_region.start_addr + entry.digest_offset;
+    map->active_addr = active->start_addr;
+    map->active_length = active->length;
+    map->building = true;
+
+    return 0;
+}
+
+/**
+ * Compare the next blocks of a component image against the active image on the FD.  Once every block has been
+ * compared, the map is active if some blocks are unchanged.
+ *
+ * @param map The map of changed blocks being built.
+ * @param flash The flash that contains the package data and the active image.
+ * @param hash The hash engine to use to hash the active image.  No hash can be active on the engine.
+ * @param max_blocks The maximum number of blocks to compare.
+ *
+ * @return 0 if the blocks were compared or an error code.  On error, the map is left inactive.
+ */
+int pldm_fwup_delta_continue_map(struct pldm_fwup_fd_delta_map *map, const struct flash *flash,
+    struct hash_engine *hash, uint32_t max_blocks)
+{
+    uint8_t expected[HASH_MAX_HASH_LEN];
+    uint8_t digest[HASH_MAX_HASH_LEN];
+    uint32_t end;
+    uint32_t block;
+    uint32_t offset;
+    uint32_t length;
+    int hash_length;
+    int status;
+
+    if ((map == NULL) || (flash == NULL) || (hash == NULL)) {
+        return PLDM_FWUP_DELTA_INVALID_ARGUMENT;
+    }
+
+    if (!map->building) {
+        return 0;
+    }
+
+    hash_length = hash_get_hash_length(map->hash_type);
+    end = ((map->num_blocks - map->next_block) < max_blocks) ? map->num_blocks : (map->next_block + max_blocks);
+
+    for (block = map->next_block; block < end; block++) {
+        offset = block * map->block_size;
+        length = ((map->comp_img_size - offset) < map->block_size) ? (map->comp_img_size - offset) : map->block_size;
+
+        if ((offset + length) > map->active_length) {
+            map->changed[block / 8] |= (1 << (block % 8));
+            map->changed_blocks++;
+            continue;
+        }
+
+        status = flash->read(flash, map->digest_addr + (block * hash_length), expected, hash_length);
+        if (status != 0) {
+            goto fail;
+        }
+
+        status = flash_hash_contents(flash, map->active_addr + offset, length, hash, map->hash_type, digest,
+            sizeof (digest));
+        if (status != 0) {
+            goto fail;
+        }
+
+        if (memcmp(digest, expected, hash_length) != 0) {
+            map->changed[block / 8] |= (1 << (block % 8));
+            map->changed_blocks++;
+        }
+    }
+
+    map->next_block = end;
+    if (end == map->num_blocks) {
+        map->building = false;
+        map->active = (map->changed_blocks < map->num_blocks);
+    }
+
+    return 0;
+
+fail:
+    memset(map, 0, sizeof (struct pldm_fwup_fd_delta_map));
+    return status;
+}
+
+/**
+ * Check if blocks of a component image still need to be compared against the active image.
+ *
+ * @param map The map of changed blocks.
+ *
+ * @return true if the map is still being built.
+ */
+bool pldm_fwup_delta_is_map_pending(const struct pldm_fwup_fd_delta_map *map)
+{
+    return map->building;
+}
+
+/**
+ * Determine which blocks of a component image differ from the active image on the FD.  Every block is compared
+ * before returning.
+ *
+ * @param map The map of changed blocks to build.  The map is only active if some blocks are unchanged.
+ * @param flash_mgr The flash manager for the FD.
+ * @param package_data_len The length of the package data received from the UA.
+ * @param comp_num The index of the component in the component table.
+ * @param comp_entry The component being updated.
+ * @param comp_img_size The size of the component image being updated.
+ * @param hash The hash engine to use to hash the active image.  No hash can be active on the engine.
+ *
+ * @return 0 if the map was built or an error code.  If the package data has no block digests for the component or
+ * the active image can't be used, the map is left inactive and 0 is returned.
+ */
+int pldm_fwup_delta_build_map(struct pldm_fwup_fd_delta_map *map, struct pldm_fwup_flash_manager *flash_mgr,
+    size_t package_data_len, uint16_t comp_num, const struct pldm_fwup_protocol_component_entry *comp_entry,
+    uint32_t comp_img_size, struct hash_engine *hash)
+{
+    int status;
+
+    if (hash == NULL) {
+        return PLDM_FWUP_DELTA_INVALID_ARGUMENT;
+    }
+
+    status = pldm_fwup_delta_start_map(map, flash_mgr, package_data_len, comp_num, comp_entry, comp_img_size);
+    if (status != 0) {
+        return status;
+    }
+
+    return pldm_fwup_delta_continue_map(map, flash_mgr->flash, hash, map->num_blocks);
+}
+
+/**
+ * Check if the data at an offset of the component image must be requested from the UA.
+ *
+ * @param map The map of changed blocks.
+ * @param offset The offset in the component image.
+ *
+ * @return true if the data differs from the active image or the map is not active.
+ */
+bool pldm_fwup_delta_is_changed(const struct pldm_fwup_fd_delta_map *map, uint32_t offset)
+{
+    uint32_t block;
+
+    if (!map->active) {
+        return true;
+    }
+
+    block = offset / map->block_size;
+    if (block >= map->num_blocks) {
+        return true;
+    }
+
+    return (map->changed[block / 8] & (1 << (block % 8))) != 0;
+}
+
+/**
+ * Find the end of the run of blocks that are either all changed or all unchanged, starting at an offset of the
+ * component image.
+ *
+ * @param map The map of changed blocks.
+ * @param offset The offset in the component image.
+ * @param limit The largest offset to return.
+ *
+ * @return The offset following the run, capped at the limit.  This is the limit if the map is not active.
+ */
+uint32_t pldm_fwup_delta_get_run_end(const struct pldm_fwup_fd_delta_map *map, uint32_t offset, uint32_t limit)
+{
+    bool changed;
+    uint64_t end;
+
+    if (!map->active) {
+        return limit;
+    }
+
+    changed = pldm_fwup_delta_is_changed(map, offset);
+    end = ((uint64_t) (offset / map->block_size) + 1) * map->block_size;
+    while ((end < limit) && (pldm_fwup_delta_is_changed(map, end) == changed)) {
+        end += map->block_size;
+    }
+
+    return (end < limit) ? end : limit;
+}
@@ -0,0 +1,78 @@
+#ifndef PLDM_FWUP_DELTA_H_
+#define PLDM_FWUP_DELTA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "crypto/hash.h"
+#include "flash/flash.h"
+#include "pldm_fwup_manager.h"
+#include "pldm_fwup_protocol.h"
+#include "status/rot_status.h"
+
+
+/**
+ * Marker identifying block digests in the package data of a firmware update.
+ */
+#define PLDM_FWUP_DELTA_MARKER                                                      0x544c4450
+
+#pragma pack(push, 1)
+/**
+ * Header of the block digests the UA places in the package data of a firmware update.
+ *
+ * The header is followed by one entry for each component with block digests. The digests of each component are stored
+ * in block order at the offset given by its entry.  All multi-byte fields are stored in little endian byte order, like
+ * other PLDM data.
+ */
+struct pldm_fwup_delta_header {
+    uint32_t marker;                                                                /**< Marker identifying the block digests. */
+    uint8_t hash_type;                                                              /**< The type of hash used for every block digest. */
+    uint32_t block_size;                                                            /**< The size of each block of a component image. */
+    uint16_t num_components;                                                        /**< The number of component entries that follow. */
+};
+
+/**
+ * Block digests for a single component image.
+ */
+struct pldm_fwup_delta_component {
+    uint16_t comp_classification;                                                   /**< The classification of the component. */
+    uint16_t comp_identifier;                                                       /**< The identifier of the component. */
+    uint32_t comp_img_size;                                                         /**< The size of the component image the digests were calculated for. */
+    uint32_t digest_offset;                                                         /**< Offset of the first block digest from the start of the package data. */
+};
+#pragma pack(pop)
+
+
+int pldm_fwup_delta_generate(struct pldm_fwup_flash_manager *flash_mgr,
+    const struct pldm_fwup_fup_component_image_entry *comp_entries, uint16_t num_components, uint32_t block_size,
+    struct hash_engine *hash, enum hash_type type);
+
+int pldm_fwup_delta_start_map(struct pldm_fwup_fd_delta_map *map, struct pldm_fwup_flash_manager *flash_mgr,
+    size_t package_data_len, uint16_t comp_num, const struct pldm_fwup_protocol_component_entry *comp_entry,
+    uint32_t comp_img_size);
+int pldm_fwup_delta_continue_map(struct pldm_fwup_fd_delta_map *map, const struct flash *flash,
+    struct hash_engine *hash, uint32_t max_blocks);
+bool pldm_fwup_delta_is_map_pending(const struct pldm_fwup_fd_delta_map *map);
+int pldm_fwup_delta_build_map(struct pldm_fwup_fd_delta_map *map, struct pldm_fwup_flash_manager *flash_mgr,
+    size_t package_data_len, uint16_t comp_num, const struct pldm_fwup_protocol_component_entry *comp_entry,
+    uint32_t comp_img_size, struct hash_engine *hash);
+
+bool pldm_fwup_delta_is_changed(const struct pldm_fwup_fd_delta_map *map, uint32_t offset);
+uint32_t pldm_fwup_delta_get_run_end(const struct pldm_fwup_fd_delta_map *map, uint32_t offset, uint32_t limit);
+
+
+#define	PLDM_FWUP_DELTA_ERROR(code)                                                 ROT_ERROR (ROT_MODULE_PLDM_FWUP_DELTA, code)
+
+/**
+ * Error codes that can be generated when handling block digests for delta updates.
+ */
+enum {
+    PLDM_FWUP_DELTA_INVALID_ARGUMENT = PLDM_FWUP_DELTA_ERROR (0x00),                /**< Input parameter is null or not valid. */
+    PLDM_FWUP_DELTA_UNSUPPORTED_HASH = PLDM_FWUP_DELTA_ERROR (0x01),                /**< The hash algorithm is not supported. */
+    PLDM_FWUP_DELTA_TOO_MANY_BLOCKS = PLDM_FWUP_DELTA_ERROR (0x02),                 /**< A component has more blocks than can be tracked. */
+    PLDM_FWUP_DELTA_SMALL_PACKAGE_REGION = PLDM_FWUP_DELTA_ERROR (0x03),            /**< The package data region is too small for the block digests. */
+    PLDM_FWUP_DELTA_PACKAGE_DATA_TOO_LARGE = PLDM_FWUP_DELTA_ERROR (0x04)           /**< The block digests exceed the maximum package data length. */
+};
+
+
+#endif /* PLDM_FWUP_DELTA_H_ */
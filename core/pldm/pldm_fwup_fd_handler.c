@@ -0,0 +1,564 @@
+#include <string.h>
+#include "pldm_fwup_fd_handler.h"
+#include "pldm_fwup_fd_handler_static.h"
+#include "cmd_interface_pldm.h"
+#include "pldm_fwup_protocol.h"
+#include "common/unused.h"
+
+#include "libpldm/firmware_update.h"
+
+
+/**
+ * Get the FD manager used by the firmware update handler.
+ *
+ * @param fd The FD task handler.
+ *
+ * @return The FD manager.
+ */
+static struct pldm_fwup_fd_manager* pldm_fwup_fd_handler_get_fd_manager(const struct pldm_fwup_fd_handler *fd)
+{
+    struct cmd_interface_pldm *interface = (struct cmd_interface_pldm*) fd->fwup->mctp->cmd_pldm;
+
+    return &interface->fwup_mgr->fd_mgr;
+}
+
+/**
+ * Move the update to a new step and restart the time allowed to receive the next expected message.
+ *
+ * @param fd The FD task handler.
+ * @param step The next step of the update.
+ */
+static void pldm_fwup_fd_handler_set_step(const struct pldm_fwup_fd_handler *fd, enum pldm_fwup_fd_handler_step step)
+{
+    fd->state->step = step;
+    fd->state->rsp_pending = false;
+    platform_init_timeout(fd->fwup->timeout_ms, &fd->state->timeout);
+}
+
+/**
+ * Stop waiting for the responses to any requests sent to the UA.  Requests are sent without waiting, so the MCTP
+ * interface keeps them pending until a response is received.
+ *
+ * @param fd The FD task handler.
+ */
+static void pldm_fwup_fd_handler_cancel_requests(const struct pldm_fwup_fd_handler *fd)
+{
+    mctp_interface_cancel_requests(fd->fwup->mctp, fd->state->ua_eid);
+}
+
+/**
+ * End the update that is running.  Any responses still expected from the UA are no longer waited on.
+ *
+ * @param fd The FD task handler.
+ * @param status The result of the update.
+ */
+static void pldm_fwup_fd_handler_finish(const struct pldm_fwup_fd_handler *fd, int status)
+{
+    pldm_fwup_fd_handler_cancel_requests(fd);
+
+    fd->state->step = PLDM_FWUP_FD_HANDLER_STEP_IDLE;
+    fd->state->rsp_pending = false;
+    fd->state->status = status;
+}
+
+/**
+ * Delay the next execution of the handler.
+ *
+ * @param fd The FD task handler.
+ * @param ms_delay The time to wait before the handler runs again, in milliseconds.
+ */
+static void pldm_fwup_fd_handler_schedule(const struct pldm_fwup_fd_handler *fd, uint32_t ms_delay)
+{
+    fd->state->next_valid = (platform_init_timeout(ms_delay, &fd->state->next) == 0);
+}
+
+/**
+ * Receive and process a packet from the UA without waiting for one to arrive.
+ *
+ * @param fd The FD task handler.
+ *
+ * @return true if a complete PLDM message was processed.
+ */
+static bool pldm_fwup_fd_handler_receive(const struct pldm_fwup_fd_handler *fd)
+{
+    struct mctp_interface *mctp = fd->fwup->mctp;
+    int status;
+
+    /* Channels report an empty poll with different errors, so a failure here does not end the update. The update
+     * fails once the expected message has not been received in time. */
+    status = cmd_channel_receive_and_process(fd->fwup->channel, mctp, 0);
+    if (status != 0 || mctp->req_buffer.length != 0) {
+        return false;
+    }
+
+    mctp_interface_reset_message_processing(mctp);
+    return MCTP_BASE_PROTOCOL_IS_PLDM_MSG(mctp->msg_type);
+}
+
+/**
+ * Send the request for the current step to the UA, if it has not been sent, and check for the response.
+ *
+ * @param fd The FD task handler.
+ * @param fd_mgr The FD manager.
+ * @param command The PLDM firmware update command to send.
+ *
+ * @return 1 if the response was processed, 0 if it has not been received, or an error code.
+ */
+static int pldm_fwup_fd_handler_exchange(const struct pldm_fwup_fd_handler *fd, struct pldm_fwup_fd_manager *fd_mgr,
+    int command)
+{
+    enum mctp_interface_response_state rsp_state;
+    int status;
+
+    if (!fd->state->rsp_pending) {
+        status = pldm_fwup_handler_send_full_mctp_message(fd->fwup, command, fd->state->ua_eid, fd->state->ua_addr);
+        if (status != 0) {
+            return status;
+        }
+
+        fd->state->rsp_pending = true;
+        platform_init_timeout(fd->fwup->timeout_ms, &fd->state->timeout);
+    }
+
+    /* Only requests sent to the UA are checked, since the MCTP interface can be waiting for responses from other
+     * devices at the same time. */
+    pldm_fwup_fd_handler_receive(fd);
+    status = mctp_interface_get_outstanding_requests(fd->fwup->mctp, fd->state->ua_eid, &rsp_state);
+    if (status != 0) {
+        return (status > 0) ? 0 : status;
+    }
+
+    fd->state->rsp_pending = false;
+    if (rsp_state == MCTP_INTERFACE_RESPONSE_ERROR) {
+        return MCTP_BASE_PROTOCOL_ERROR_RESPONSE;
+    }
+    else if (rsp_state == MCTP_INTERFACE_RESPONSE_FAIL) {
+        return MCTP_BASE_PROTOCOL_FAIL_RESPONSE;
+    }
+
+    status = pldm_fwup_handler_check_operation_status(0, fd_mgr->state.previous_completion_code);
+    return (status == 0) ? 1 : status;
+}
+
+/**
+ * Check the last command processed by the FD while waiting for a command from the UA.
+ *
+ * @param fd_mgr The FD manager.
+ * @param command The command that is expected.
+ *
+ * @return 1 if the expected command was processed, 0 if a different command was processed, or an error code.
+ */
+static int pldm_fwup_fd_handler_check_command(struct pldm_fwup_fd_manager *fd_mgr, int command)
+{
+    int status;
+
+    if (fd_mgr->state.previous_cmd == PLDM_CANCEL_UPDATE) {
+        return PLDM_FWUP_HANDLER_UPDATE_CANCELED;
+    }
+
+    status = pldm_fwup_handler_check_operation_status(0, fd_mgr->state.previous_completion_code);
+    if (status != 0) {
+        return status;
+    }
+
+    return (fd_mgr->state.previous_cmd == (enum pldm_firmware_update_commands) command);
+}
+
+/**
+ * Move to the step following the transfer of package data.
+ *
+ * @param fd The FD task handler.
+ * @param fd_mgr The FD manager.
+ */
+static void pldm_fwup_fd_handler_finish_package_data(const struct pldm_fwup_fd_handler *fd,
+    struct pldm_fwup_fd_manager *fd_mgr)
+{
+    if (fd_mgr->flash_mgr->device_meta_data_size > 0) {
+        pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_DEVICE_META_DATA);
+    }
+    else {
+        pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_PASS_COMPONENT_TABLE);
+    }
+}
+
+/**
+ * Run the current step of the update.
+ *
+ * @param fd The FD task handler.
+ * @param fd_mgr The FD manager.
+ * @param progress Output indicating a message was processed or the update moved to another step.
+ *
+ * @return 0 if the step ran successfully or an error code.
+ */
+static int pldm_fwup_fd_handler_run_step(const struct pldm_fwup_fd_handler *fd, struct pldm_fwup_fd_manager *fd_mgr,
+    bool *progress)
+{
+    struct pldm_fwup_fd_handler_state *state = fd->state;
+    struct pldm_fwup_fd_write_buffer *write_buffer = &fd_mgr->update_info.write_buffer;
+    enum pldm_firmware_update_commands previous_cmd;
+    int status = 0;
+
+    switch (state->step) {
+        case PLDM_FWUP_FD_HANDLER_STEP_IDLE:
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_REQUEST_UPDATE:
+            /* Inventory commands may be received before RequestUpdate. */
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            previous_cmd = fd_mgr->state.previous_cmd;
+            if (*progress && (previous_cmd == PLDM_QUERY_DEVICE_IDENTIFIERS || previous_cmd == PLDM_GET_FIRMWARE_PARAMETERS ||
+                previous_cmd == PLDM_REQUEST_UPDATE)) {
+                status = pldm_fwup_handler_check_operation_status(0, fd_mgr->state.previous_completion_code);
+                if (status == 0 && previous_cmd == PLDM_REQUEST_UPDATE) {
+                    if (fd_mgr->update_info.package_data_len > 0) {
+                        pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_GET_PACKAGE_DATA);
+                    }
+                    else {
+                        pldm_fwup_fd_handler_finish_package_data(fd, fd_mgr);
+                    }
+                }
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_GET_PACKAGE_DATA:
+            status = pldm_fwup_fd_handler_exchange(fd, fd_mgr, PLDM_GET_PACKAGE_DATA);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+
+                /* The transfer operation flag returns to the first part once all of the package data is received. */
+                if (fd_mgr->get_cmd_state.transfer_op_flag == PLDM_GET_FIRSTPART) {
+                    reset_get_cmd_state(&fd_mgr->get_cmd_state);
+                    pldm_fwup_fd_handler_finish_package_data(fd, fd_mgr);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_DEVICE_META_DATA:
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            if (*progress) {
+                status = pldm_fwup_fd_handler_check_command(fd_mgr, PLDM_GET_DEVICE_METADATA);
+                if (status == 1) {
+                    status = 0;
+                    if (fd_mgr->get_cmd_state.transfer_flag == PLDM_END ||
+                        fd_mgr->get_cmd_state.transfer_flag == PLDM_START_AND_END) {
+                        reset_get_cmd_state(&fd_mgr->get_cmd_state);
+                        pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_PASS_COMPONENT_TABLE);
+                    }
+                }
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_PASS_COMPONENT_TABLE:
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            if (*progress) {
+                status = pldm_fwup_fd_handler_check_command(fd_mgr, PLDM_PASS_COMPONENT_TABLE);
+                if (status == 1) {
+                    status = 0;
+                    if (fd_mgr->update_info.comp_transfer_flag == PLDM_END ||
+                        fd_mgr->update_info.comp_transfer_flag == PLDM_START_AND_END) {
+                        state->components_updated = 0;
+                        pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_UPDATE_COMPONENT);
+                    }
+                }
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_UPDATE_COMPONENT:
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            if (*progress) {
+                status = pldm_fwup_fd_handler_check_command(fd_mgr, PLDM_UPDATE_COMPONENT);
+                if (status == 1) {
+                    status = 0;
+
+                    /* Wait the time given to the UA in the response before requesting firmware data. */
+                    pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_START_DOWNLOAD);
+                    platform_init_timeout(fd_mgr->update_info.time_before_req_fw_data * 1000, &state->download_start);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_START_DOWNLOAD:
+            if (platform_has_timeout_expired(&state->download_start) == 0) {
+                /* Use the wait to erase the component region ahead of the download. */
+                *progress = true;
+                if (is_write_buffer_pre_erase_pending(write_buffer)) {
+                    status = continue_write_buffer_pre_erase(write_buffer, fd_mgr->flash_mgr->flash,
+                        PLDM_FWUP_PROTOCOL_PRE_ERASE_SECTORS);
+                }
+                else {
+                    state->next = state->download_start;
+                    state->next_valid = true;
+                }
+                break;
+            }
+
+            status = pldm_fwup_handler_start_download_fd(fd->fwup, fd_mgr, state->ua_eid);
+            if (status == 0) {
+                *progress = true;
+                pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_DOWNLOAD);
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_DOWNLOAD:
+            if (is_fd_delta_pending(&fd_mgr->update_info, &fd_mgr->comp_hash)) {
+                /* Compare the active image and rebuild the hash of data already written a chunk at a time before
+                 * requesting any data. */
+                *progress = true;
+                status = continue_fd_delta(fd_mgr->flash_mgr, &fd_mgr->update_info, &fd_mgr->comp_hash,
+                    PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+                break;
+            }
+
+            status = pldm_fwup_handler_fill_transfer_window_fd(fd->fwup, fd_mgr, state->ua_eid, state->ua_addr);
+            if (status != 0) {
+                break;
+            }
+
+            if (pldm_fwup_handler_is_download_complete_fd(fd_mgr)) {
+                *progress = true;
+                pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_TRANSFER_COMPLETE);
+                break;
+            }
+
+            if (pldm_fwup_handler_is_local_copy_pending_fd(fd_mgr)) {
+                /* Copy the next chunk of unchanged data on the next execution. */
+                *progress = true;
+                break;
+            }
+
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            if (*progress) {
+                status = pldm_fwup_fd_handler_check_command(fd_mgr, PLDM_REQUEST_FIRMWARE_DATA);
+                if (status == 0 && fd_mgr->state.previous_cmd == PLDM_CANCEL_UPDATE_COMPONENT) {
+                    /* Responses to firmware data requests for the canceled component are no longer needed. */
+                    pldm_fwup_fd_handler_cancel_requests(fd);
+                    pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_UPDATE_COMPONENT);
+                }
+                else if (status == 1) {
+                    status = 0;
+                }
+            }
+            else {
+                /* Keep erasing ahead of the data while waiting for responses. */
+                status = continue_write_buffer_pre_erase(write_buffer, fd_mgr->flash_mgr->flash,
+                    PLDM_FWUP_PROTOCOL_PRE_ERASE_SECTORS);
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_TRANSFER_COMPLETE:
+            status = pldm_fwup_fd_handler_exchange(fd, fd_mgr, PLDM_TRANSFER_COMPLETE);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+                pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_VERIFY_COMPLETE);
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_VERIFY_COMPLETE:
+            status = pldm_fwup_fd_handler_exchange(fd, fd_mgr, PLDM_VERIFY_COMPLETE);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+                pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_APPLY_COMPLETE);
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_APPLY_COMPLETE:
+            status = pldm_fwup_fd_handler_exchange(fd, fd_mgr, PLDM_APPLY_COMPLETE);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+
+                state->components_updated++;
+                if (state->components_updated < fd_mgr->update_info.num_components) {
+                    pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_UPDATE_COMPONENT);
+                }
+                else {
+                    pldm_fwup_fd_handler_set_step(fd, PLDM_FWUP_FD_HANDLER_STEP_ACTIVATE_FIRMWARE);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_FD_HANDLER_STEP_ACTIVATE_FIRMWARE:
+            *progress = pldm_fwup_fd_handler_receive(fd);
+            if (*progress) {
+                status = pldm_fwup_fd_handler_check_command(fd_mgr, PLDM_ACTIVATE_FIRMWARE);
+                if (status == 1) {
+                    status = 0;
+                    pldm_fwup_fd_handler_finish(fd, 0);
+                }
+            }
+            break;
+
+        default:
+            status = PLDM_FWUP_HANDLER_INVALID_STATE_TRANSITION;
+            break;
+    }
+
+    return status;
+}
+
+const platform_clock* pldm_fwup_fd_handler_get_next_execution(const struct periodic_task_handler *handler)
+{
+    const struct pldm_fwup_fd_handler *fd = (const struct pldm_fwup_fd_handler*) handler;
+
+    if (fd->state->next_valid) {
+        return &fd->state->next;
+    }
+    else {
+        return NULL;
+    }
+}
+
+void pldm_fwup_fd_handler_execute(const struct periodic_task_handler *handler)
+{
+    const struct pldm_fwup_fd_handler *fd = (const struct pldm_fwup_fd_handler*) handler;
+    struct pldm_fwup_fd_handler_state *state = fd->state;
+    bool progress = false;
+    int status;
+
+    state->next_valid = false;
+
+    status = pldm_fwup_fd_handler_run_step(fd, pldm_fwup_fd_handler_get_fd_manager(fd), &progress);
+    if (status != 0) {
+        pldm_fwup_fd_handler_finish(fd, status);
+        return;
+    }
+
+    if (progress) {
+        if (!state->next_valid) {
+            platform_init_timeout(fd->fwup->timeout_ms, &state->timeout);
+        }
+        return;
+    }
+
+    if (state->step != PLDM_FWUP_FD_HANDLER_STEP_IDLE && fd->fwup->timeout_ms >= 0 &&
+        platform_has_timeout_expired(&state->timeout) == 1) {
+        pldm_fwup_fd_handler_finish(fd, PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT);
+        return;
+    }
+
+    /* Nothing was received, so give other handlers in the task a chance to run before polling again. */
+    pldm_fwup_fd_handler_schedule(fd, PLDM_FWUP_PROTOCOL_POLL_INTERVAL_MS);
+}
+
+/**
+ * Initialize a handler for running a PLDM firmware update from a periodic task.
+ *
+ * @param handler The FD task handler to initialize.
+ * @param state Variable context for the handler.  This must be uninitialized.
+ * @param fwup The firmware update handler with the command channel and MCTP instance connected to the UA.
+ *
+ * @return 0 if the handler was successfully initialized or an error code.
+ */
+int pldm_fwup_fd_handler_init(struct pldm_fwup_fd_handler *handler, struct pldm_fwup_fd_handler_state *state,
+    struct pldm_fwup_handler *fwup)
+{
+    if (handler == NULL || state == NULL || fwup == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    memset(handler, 0, sizeof (struct pldm_fwup_fd_handler));
+
+    handler->base.get_next_execution = pldm_fwup_fd_handler_get_next_execution;
+    handler->base.execute = pldm_fwup_fd_handler_execute;
+
+    handler->state = state;
+    handler->fwup = fwup;
+
+    return pldm_fwup_fd_handler_init_state(handler);
+}
+
+/**
+ * Initialize only the variable state for an FD task handler.  The rest of the handler is assumed to have already
+ * been initialized.
+ *
+ * @param handler The FD task handler that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int pldm_fwup_fd_handler_init_state(const struct pldm_fwup_fd_handler *handler)
+{
+    if (handler == NULL || handler->state == NULL || handler->fwup == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    memset(handler->state, 0, sizeof (struct pldm_fwup_fd_handler_state));
+
+    return 0;
+}
+
+/**
+ * Release the resources used by an FD task handler.
+ *
+ * @param handler The FD task handler to release.
+ */
+void pldm_fwup_fd_handler_release(const struct pldm_fwup_fd_handler *handler)
+{
+    UNUSED(handler);
+}
+
+/**
+ * Start a firmware update with Cerberus operating as the Firmware Device. The update is run by subsequent executions
+ * of the handler.
+ *
+ * @param handler The FD task handler.
+ * @param ua_eid The endpoint ID of the update agent.
+ * @param ua_addr The SMBus address of the update agent.
+ *
+ * @return 0 if the update was started or an error code.
+ */
+int pldm_fwup_fd_handler_start(const struct pldm_fwup_fd_handler *handler, uint8_t ua_eid, uint8_t ua_addr)
+{
+    struct pldm_fwup_fd_manager *fd_mgr;
+
+    if (handler == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    if (handler->fwup->mode != PLDM_FWUP_HANDLER_FD_MODE) {
+        return PLDM_FWUP_HANDLER_INCORRECT_MODE;
+    }
+
+    fd_mgr = pldm_fwup_fd_handler_get_fd_manager(handler);
+    if (fd_mgr->fw_parameters == NULL || fd_mgr->flash_mgr->device_meta_data_region.length == 0 ||
+        fd_mgr->flash_mgr->package_data_region.length == 0 || fd_mgr->flash_mgr->flash == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_FD_MANAGER_STATE;
+    }
+
+    if (handler->state->step != PLDM_FWUP_FD_HANDLER_STEP_IDLE) {
+        return PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS;
+    }
+
+    handler->state->ua_eid = ua_eid;
+    handler->state->ua_addr = ua_addr;
+    handler->state->components_updated = 0;
+    handler->state->status = PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS;
+    handler->state->next_valid = false;
+    pldm_fwup_fd_handler_set_step(handler, PLDM_FWUP_FD_HANDLER_STEP_REQUEST_UPDATE);
+
+    return 0;
+}
+
+/**
+ * Get the result of the firmware update run by the handler.
+ *
+ * @param handler The FD task handler to query.
+ *
+ * @return 0 if the last update was successful, PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS if an update is still running, or
+ * the error code that ended the last update.
+ */
+int pldm_fwup_fd_handler_get_status(const struct pldm_fwup_fd_handler *handler)
+{
+    if (handler == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    if (handler->state->step != PLDM_FWUP_FD_HANDLER_STEP_IDLE) {
+        return PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS;
+    }
+
+    return handler->state->status;
+}
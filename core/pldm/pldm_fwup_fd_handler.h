@@ -0,0 +1,76 @@
+#ifndef PLDM_FWUP_FD_HANDLER_H_
+#define PLDM_FWUP_FD_HANDLER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "pldm_fwup_handler.h"
+#include "system/periodic_task.h"
+
+
+/**
+ * The steps of a firmware update run by the FD task handler.
+ */
+enum pldm_fwup_fd_handler_step {
+    PLDM_FWUP_FD_HANDLER_STEP_IDLE,                                                 /**< No update is running. */
+    PLDM_FWUP_FD_HANDLER_STEP_REQUEST_UPDATE,                                       /**< Waiting for inventory commands and RequestUpdate. */
+    PLDM_FWUP_FD_HANDLER_STEP_GET_PACKAGE_DATA,                                     /**< Requesting package data from the UA. */
+    PLDM_FWUP_FD_HANDLER_STEP_DEVICE_META_DATA,                                     /**< Sending device meta data to the UA. */
+    PLDM_FWUP_FD_HANDLER_STEP_PASS_COMPONENT_TABLE,                                 /**< Receiving the component table. */
+    PLDM_FWUP_FD_HANDLER_STEP_UPDATE_COMPONENT,                                     /**< Waiting for UpdateComponent. */
+    PLDM_FWUP_FD_HANDLER_STEP_START_DOWNLOAD,                                       /**< Waiting to request firmware data. */
+    PLDM_FWUP_FD_HANDLER_STEP_DOWNLOAD,                                             /**< Requesting firmware data. */
+    PLDM_FWUP_FD_HANDLER_STEP_TRANSFER_COMPLETE,                                    /**< Reporting the result of the transfer. */
+    PLDM_FWUP_FD_HANDLER_STEP_VERIFY_COMPLETE,                                      /**< Reporting the result of verification. */
+    PLDM_FWUP_FD_HANDLER_STEP_APPLY_COMPLETE,                                       /**< Reporting the result of applying the component. */
+    PLDM_FWUP_FD_HANDLER_STEP_ACTIVATE_FIRMWARE,                                    /**< Waiting for ActivateFirmware. */
+};
+
+/**
+ * Variable context for the FD task handler.
+ */
+struct pldm_fwup_fd_handler_state {
+    enum pldm_fwup_fd_handler_step step;                                            /**< The current step of the update. */
+    uint8_t ua_eid;                                                                 /**< The endpoint ID of the update agent. */
+    uint8_t ua_addr;                                                                /**< The SMBus address of the update agent. */
+    bool rsp_pending;                                                               /**< Flag indicating a request was sent and the response is expected. */
+    uint16_t components_updated;                                                    /**< The number of components updated. */
+    platform_clock next;                                                            /**< Time at which the handler should next run. */
+    bool next_valid;                                                                /**< Flag indicating the next execution time has been set. */
+    platform_clock timeout;                                                         /**< Time by which the next expected message must be received. */
+    platform_clock download_start;                                                  /**< Time the FD told the UA it would start requesting firmware data. */
+    int status;                                                                     /**< The result of the last update. */
+};
+
+/**
+ * Handler for running a PLDM firmware update from a periodic task while Cerberus is operating as the Firmware Device.
+ *
+ * Each execution processes at most one received packet or sends the requests for the current step, so the task is
+ * never blocked waiting for the UA. Waits specified by the protocol are scheduled as the next execution time of the
+ * handler instead of sleeping.
+ *
+ * @note For AMI, the handler takes the place of the command channel handler for the channel connected to the UA.
+ *          Messages received on the channel that are not part of the update, such as GetStatus or Cerberus protocol
+ *          commands, are processed at any time, including when no update is running.
+ */
+struct pldm_fwup_fd_handler {
+    struct periodic_task_handler base;                                              /**< Base interface for task integration. */
+    struct pldm_fwup_fd_handler_state *state;                                       /**< Variable context for the handler. */
+    struct pldm_fwup_handler *fwup;                                                 /**< The firmware update handler with the channel to the UA. */
+};
+
+
+int pldm_fwup_fd_handler_init(struct pldm_fwup_fd_handler *handler, struct pldm_fwup_fd_handler_state *state,
+    struct pldm_fwup_handler *fwup);
+int pldm_fwup_fd_handler_init_state(const struct pldm_fwup_fd_handler *handler);
+void pldm_fwup_fd_handler_release(const struct pldm_fwup_fd_handler *handler);
+
+int pldm_fwup_fd_handler_start(const struct pldm_fwup_fd_handler *handler, uint8_t ua_eid, uint8_t ua_addr);
+int pldm_fwup_fd_handler_get_status(const struct pldm_fwup_fd_handler *handler);
+
+
+/* This module will be treated as an extension of the firmware update handler and use PLDM_FWUP_HANDLER_* error
+ * codes. */
+
+
+#endif /* PLDM_FWUP_FD_HANDLER_H_ */
@@ -0,0 +1,38 @@
+#ifndef PLDM_FWUP_FD_HANDLER_STATIC_H_
+#define PLDM_FWUP_FD_HANDLER_STATIC_H_
+
+#include "platform_api.h"
+#include "pldm_fwup_fd_handler.h"
+
+
+/* Internal functions declared to allow for static initialization. */
+const platform_clock* pldm_fwup_fd_handler_get_next_execution(const struct periodic_task_handler *handler);
+void pldm_fwup_fd_handler_execute(const struct periodic_task_handler *handler);
+
+
+/**
+ * Constant initializer for the FD update task API.
+ */
+#define	PLDM_FWUP_FD_HANDLER_API_INIT  { \
+        .get_next_execution = pldm_fwup_fd_handler_get_next_execution, \
+        .execute = pldm_fwup_fd_handler_execute \
+    }
+
+
+/**
+ * Initialize a static instance of a handler for running a PLDM firmware update as the Firmware Device.  This does not
+ * initialize the handler state.  This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the handler.
+ * @param fwup_ptr The firmware update handler with the command channel and MCTP instance connected to the UA.
+ */
+#define	pldm_fwup_fd_handler_static_init(state_ptr, fwup_ptr)	{ \
+        .base = PLDM_FWUP_FD_HANDLER_API_INIT, \
+        .state = state_ptr, \
+        .fwup = fwup_ptr \
+    }
+
+
+#endif /* PLDM_FWUP_FD_HANDLER_STATIC_H_ */
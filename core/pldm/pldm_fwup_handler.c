@@ -3,6 +3,7 @@
 #include "cmd_interface/cmd_interface.h"
 #include "cmd_interface_pldm.h"
 #include "pldm_fwup_protocol_commands.h"
+#include "pldm_fwup_delta.h"
 #include "pldm_fwup_protocol.h"
 #include "common/unused.h"
 #include "cmd_interface/cmd_channel.h"
@@ -38,7 +39,8 @@ int pldm_fwup_handler_generate_request(struct cmd_interface *intf, int command,
             status = pldm_fwup_generate_request_firmware_data_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info, buffer, buf_len);
             break;
         case PLDM_TRANSFER_COMPLETE:
-            status = pldm_fwup_generate_transfer_complete_request(&interface->fwup_mgr->fd_mgr.state, buffer, buf_len);
+            status = pldm_fwup_generate_transfer_complete_request(&interface->fwup_mgr->fd_mgr.state, &interface->fwup_mgr->fd_mgr.update_info,
+                interface->fwup_mgr->fd_mgr.flash_mgr, &interface->fwup_mgr->fd_mgr.comp_hash, buffer, buf_len);
             break;
         case PLDM_VERIFY_COMPLETE:
             status = pldm_fwup_generate_verify_complete_request(&interface->fwup_mgr->fd_mgr.state, buffer, buf_len);
@@ -111,6 +113,28 @@ int pldm_fwup_handler_receive_and_respond_full_mctp_message(struct cmd_channel *
     return status;
 }
 
+/**
+ * Generate a request and send it as a full MCTP message without waiting for the response.
+ * 
+ * @param handler The firmware update handler.
+ * @param command The PLDM firmware update command
+ * @param fd_eid The endpoint ID of the device to send the message to.
+ * @param fd_addr The SMBus address of the firmware device to send the message to.
+ * 
+ * @return 0 if the MCTP message was sent otherwise an error code.
+*/
+int pldm_fwup_handler_send_full_mctp_message(struct pldm_fwup_handler *handler, int command, uint8_t fd_eid, uint8_t fd_addr)
+{
+    int req_length = pldm_fwup_handler_generate_request(handler->mctp->cmd_pldm, command, handler->req_buffer, sizeof (handler->req_buffer));
+    if (ROT_IS_ERROR(req_length)) {
+        return req_length;
+    }
+
+    /* The response is received separately, so several requests can be outstanding at once. */
+    return mctp_interface_issue_request(handler->mctp, handler->channel, fd_addr, fd_eid, handler->req_buffer, 
+        req_length, handler->req_buffer, sizeof (handler->req_buffer), 0);
+}
+
 /**
  * Send a full MCTP message, receive a response, and process it.  
  * 
@@ -124,17 +148,7 @@ int pldm_fwup_handler_receive_and_respond_full_mctp_message(struct cmd_channel *
 */
 int pldm_fwup_handler_send_and_receive_full_mctp_message(struct pldm_fwup_handler *handler, int command, uint8_t fd_eid, uint8_t fd_addr)
 {
-    int status;
-    int req_length = pldm_fwup_handler_generate_request(handler->mctp->cmd_pldm, command, handler->req_buffer, sizeof (handler->req_buffer));
-    if (ROT_IS_ERROR(req_length) && req_length == CMD_HANDLER_PLDM_TRANSPORT_ERROR) {
-        return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
-    } 
-    else if (ROT_IS_ERROR(req_length) && req_length == PLDM_FWUP_HANDLER_UNKNOWN_REQUEST) {
-        return PLDM_FWUP_HANDLER_UNKNOWN_REQUEST;
-    }
-    
-    status = mctp_interface_issue_request(handler->mctp, handler->channel, fd_addr, fd_eid, handler->req_buffer, 
-        req_length, handler->req_buffer, sizeof (handler->req_buffer), 0); // Not performing parallel operations so set time out to zero.
+    int status = pldm_fwup_handler_send_full_mctp_message(handler, command, fd_eid, fd_addr);
     if (status != 0) {
         return status;
     }
@@ -312,6 +326,203 @@ int pldm_fwup_handler_run_update_ua(struct pldm_fwup_handler *handler, bool inve
     return 0;
 }
 
+/**
+ * Prepare the FD to download the component image currently being updated.
+ * 
+ * @param handler The firmware update handler.
+ * @param fd_mgr The FD manager.
+ * @param ua_eid The endpoint ID of the update agent.
+ * 
+ * @return 0 if the download can start otherwise an error code.
+ */
+int pldm_fwup_handler_start_download_fd(struct pldm_fwup_handler *handler, struct pldm_fwup_fd_manager *fd_mgr,
+    uint8_t ua_eid)
+{
+    struct pldm_fwup_fd_update_info *update_info = &fd_mgr->update_info;
+
+    if (update_info->max_transfer_size == 0) {
+        return PLDM_FWUP_HANDLER_INVALID_FD_MANAGER_STATE;
+    }
+
+    /* Start after any data that was confirmed written before a previous attempt at this component was interrupted. */
+    reset_transfer_window(&update_info->transfer_window, update_info->max_outstanding_transfer_req);
+    reset_transfer_tuning(&update_info->transfer_tuning, update_info->max_transfer_size,
+        device_manager_get_max_transmission_unit_by_eid(handler->mctp->device_manager, ua_eid));
+    update_info->current_comp_img_offset = update_info->current_comp_img_confirmed;
+
+    /* Without block digests for the component every block is requested. The blocks are compared against the active
+     * image with continue_fd_delta before any requests are sent, which also rebuilds the running hash of any data
+     * written before the download resumed. */
+    return start_fd_delta(fd_mgr->flash_mgr, update_info, &fd_mgr->comp_hash);
+}
+
+/**
+ * Issue RequestFirmwareData requests until the transfer window is full or every part of the component image has been
+ * requested. Requests the UA asked to be retried are issued again first.
+ * 
+ * When the next data is unchanged from the active image, at most one chunk of it is copied locally instead and no
+ * further requests are sent by this call.
+ * 
+ * @param handler The firmware update handler.
+ * @param fd_mgr The FD manager.
+ * @param ua_eid The endpoint ID of the update agent.
+ * @param ua_addr The SMBus address of the update agent.
+ * 
+ * @return 0 if the requests were sent otherwise an error code.
+ */
+int pldm_fwup_handler_fill_transfer_window_fd(struct pldm_fwup_handler *handler, struct pldm_fwup_fd_manager *fd_mgr,
+    uint8_t ua_eid, uint8_t ua_addr)
+{
+    struct pldm_fwup_fd_update_info *update_info = &fd_mgr->update_info;
+    struct pldm_fwup_fd_transfer_window *window = &update_info->transfer_window;
+    int status;
+
+    while ((update_info->current_comp_img_offset < update_info->current_comp_img_size || window->retries > 0) &&
+        window->outstanding < window->size) {
+        if (window->retries == 0 &&
+            !pldm_fwup_delta_is_changed(&update_info->delta, update_info->current_comp_img_offset)) {
+            /* Unchanged data is copied from the active image once everything before it has been written. */
+            if (window->outstanding != 0) {
+                break;
+            }
+
+            return pldm_fwup_copy_unchanged_firmware_data(&fd_mgr->state, update_info, fd_mgr->flash_mgr,
+                &fd_mgr->comp_hash, PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+        }
+
+        status = pldm_fwup_handler_send_full_mctp_message(handler, PLDM_REQUEST_FIRMWARE_DATA, ua_eid, ua_addr);
+        if (status != 0) {
+            return status;
+        }
+        update_info->current_comp_img_offset += update_info->last_request_length;
+    }
+
+    return 0;
+}
+
+/**
+ * Check if unchanged data at the current offset of the component image can be copied from the active image. No
+ * response is expected from the UA until it has been copied.
+ * 
+ * @param fd_mgr The FD manager.
+ * 
+ * @return true if pldm_fwup_handler_fill_transfer_window_fd will copy data on the next call.
+ */
+bool pldm_fwup_handler_is_local_copy_pending_fd(const struct pldm_fwup_fd_manager *fd_mgr)
+{
+    const struct pldm_fwup_fd_update_info *update_info = &fd_mgr->update_info;
+
+    return (update_info->current_comp_img_offset < update_info->current_comp_img_size) &&
+        (update_info->transfer_window.outstanding == 0) && (update_info->transfer_window.retries == 0) &&
+        !pldm_fwup_delta_is_changed(&update_info->delta, update_info->current_comp_img_offset);
+}
+
+/**
+ * Check if every part of the component image currently being updated has been received.
+ * 
+ * @param fd_mgr The FD manager.
+ * 
+ * @return true if the download is complete.
+ */
+bool pldm_fwup_handler_is_download_complete_fd(const struct pldm_fwup_fd_manager *fd_mgr)
+{
+    const struct pldm_fwup_fd_update_info *update_info = &fd_mgr->update_info;
+
+    return (update_info->current_comp_img_offset >= update_info->current_comp_img_size) &&
+        (update_info->transfer_window.outstanding == 0) && (update_info->transfer_window.retries == 0);
+}
+
+/**
+ * Wait the time given to the UA before the FD starts requesting firmware data. The component region is erased ahead of
+ * the download while waiting. Sectors that are still not erased when the time is up are erased as data reaches them.
+ * 
+ * @param fd_mgr The FD manager.
+ * 
+ * @return 0 if the download can start otherwise an error code.
+ */
+static int pldm_fwup_handler_wait_before_download_fd(struct pldm_fwup_fd_manager *fd_mgr)
+{
+    struct pldm_fwup_fd_write_buffer *write_buffer = &fd_mgr->update_info.write_buffer;
+    platform_clock download_start;
+    uint32_t remaining;
+    int status;
+
+    status = platform_init_timeout(fd_mgr->update_info.time_before_req_fw_data * 1000, &download_start);
+    if (status != 0) {
+        return status;
+    }
+
+    while (is_write_buffer_pre_erase_pending(write_buffer) && platform_has_timeout_expired(&download_start) == 0) {
+        status = continue_write_buffer_pre_erase(write_buffer, fd_mgr->flash_mgr->flash,
+            PLDM_FWUP_PROTOCOL_PRE_ERASE_SECTORS);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    status = platform_get_timeout_remaining(&download_start, &remaining);
+    if (status == 0 && remaining != 0) {
+        platform_msleep(remaining);
+    }
+
+    return 0;
+}
+
+/**
+ * Download the component image currently being updated from the UA using RequestFirmwareData commands.
+ * 
+ * Up to the negotiated number of outstanding transfer requests are kept in flight at once. Each time a response is
+ * received and processed, another request is issued until the whole image has been requested. The length of each
+ * request is tuned to the throughput of the link, within the negotiated maximum and the MTU of the UA.
+ * 
+ * @param handler The firmware update handler.
+ * @param fd_mgr The FD manager.
+ * @param ua_eid The endpoint ID of the update agent.  
+ * @param ua_addr The SMBus address of the update agent. 
+ * 
+ * @return 0 if the component image was downloaded otherwise an error code.
+ */
+static int pldm_fwup_handler_download_component_fd(struct pldm_fwup_handler *handler, struct pldm_fwup_fd_manager *fd_mgr,
+    uint8_t ua_eid, uint8_t ua_addr)
+{
+    int status;
+
+    status = pldm_fwup_handler_start_download_fd(handler, fd_mgr, ua_eid);
+    if (status != 0) {
+        return status;
+    }
+
+    while (is_fd_delta_pending(&fd_mgr->update_info, &fd_mgr->comp_hash)) {
+        status = continue_fd_delta(fd_mgr->flash_mgr, &fd_mgr->update_info, &fd_mgr->comp_hash,
+            PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    while (!pldm_fwup_handler_is_download_complete_fd(fd_mgr)) {
+
+        /* Fill the window with retried requests and requests for the next parts of the image. */
+        status = pldm_fwup_handler_fill_transfer_window_fd(handler, fd_mgr, ua_eid, ua_addr);
+        if (status != 0) {
+            return status;
+        }
+
+        /* Unchanged data is copied a chunk at a time, with no response expected from the UA. */
+        if (pldm_fwup_handler_is_local_copy_pending_fd(fd_mgr)) {
+            continue;
+        }
+
+        /* Receive the next response. Data is committed to flash in offset order as responses arrive. */
+        status = pldm_fwup_handler_receive_and_respond_full_mctp_message(handler->channel, handler->mctp, handler->timeout_ms);
+        if ((status = pldm_fwup_handler_check_operation_status(status, fd_mgr->state.previous_completion_code)) != 0) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * Internal reference to the function that will execute a firmware update when Cerberus is operating as the Update Agent
  * 
@@ -413,21 +624,18 @@ int pldm_fwup_handler_start_update_fd(struct pldm_fwup_handler *handler, uint8_t
         }
 
 
-        platform_msleep(PLDM_FWUP_PROTOCOL_TIME_BERFORE_REQ_FW_DATA * 1000);
+        /* Wait the time given to the UA in the UpdateComponent response before requesting firmware data. */
+        status = pldm_fwup_handler_wait_before_download_fd(fd_mgr);
+        if (status != 0) {
+            return status;
+        }
 
 
-        uint32_t current_comp_img_size = fd_mgr->update_info.current_comp_img_size;
-        uint32_t max_transfer_size = fd_mgr->update_info.max_transfer_size;
-        for (fd_mgr->update_info.current_comp_img_offset = 0; 
-            fd_mgr->update_info.current_comp_img_offset < current_comp_img_size;
-            fd_mgr->update_info.current_comp_img_offset += max_transfer_size) {
-            
-            /* The FD will send RequestFirmwareData commands to the UA to transfer parts of the firmware component image.
-             * The transfer will continue so long as the offset is less than the size of the image being transferred. */
-            status = pldm_fwup_handler_send_and_receive_full_mctp_message(handler, PLDM_REQUEST_FIRMWARE_DATA, ua_eid, ua_addr);
-            if ((status = pldm_fwup_handler_check_operation_status(status, fd_mgr->state.previous_completion_code)) != 0) {
-                return status;
-            }
+        /* The FD will send RequestFirmwareData commands to the UA to transfer parts of the firmware component image.
+         * The transfer will continue so long as the offset is less than the size of the image being transferred. */
+        status = pldm_fwup_handler_download_component_fd(handler, fd_mgr, ua_eid, ua_addr);
+        if (status != 0) {
+            return status;
         }
 
 
@@ -438,7 +646,8 @@ int pldm_fwup_handler_start_update_fd(struct pldm_fwup_handler *handler, uint8_t
         }
 
 
-        /* The specifics on how the FD verifies the component image is left up to the AMI team. For now the FD will immediately send
+        /* The specifics on how the FD verifies the component image is left up to the AMI team. If a hash engine was configured, the
+         * digest of the image was calculated during the download and is already available. For now the FD will immediately send
          * the VerifyComplete command. After verification the FD will transition to the Apply state. */
         status = pldm_fwup_handler_send_and_receive_full_mctp_message(handler, PLDM_VERIFY_COMPLETE, ua_eid, ua_addr);
         if ((status = pldm_fwup_handler_check_operation_status(status, fd_mgr->state.previous_completion_code)) != 0) {
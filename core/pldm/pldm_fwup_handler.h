@@ -21,9 +21,10 @@ enum pldm_fwup_handler_mode {
  * The handler contains two internal references to functions that will execute an update when Cerberus 
  * is operating as the Update Agent or as the Firmware Device. 
  * 
- * @note For AMI, the firmware update is performed linearly and does not use the event/periodic task handlers. Parallelization is left up to the AMI team
- *          and if used changes will have to be made to the FWUP manager and protocol commands. Also, GetStatus is the only PLDM command 
- *          not utilized during the update process. 
+ * @note For AMI, the firmware update is performed linearly and blocks the calling task until it completes. When Cerberus is
+ *          operating as the Firmware Device, pldm_fwup_fd_handler runs the same update from a periodic task without blocking.
+ *          pldm_fwup_ua_handler does the same when Cerberus is operating as the Update Agent.
+ *          Also, GetStatus is the only PLDM command not utilized during the update process. 
  */
 struct pldm_fwup_handler {
     struct cmd_channel *channel;                                                    /**< Command channel for receiving messages. */
@@ -67,7 +68,15 @@ int pldm_fwup_handler_set_mode(struct pldm_fwup_handler *handler, enum pldm_fwup
 // Internal functions
 int pldm_fwup_handler_generate_request(struct cmd_interface *intf, int command, uint8_t *buffer, size_t buf_len);
 int pldm_fwup_handler_receive_and_respond_full_mctp_message(struct cmd_channel *channel, struct mctp_interface *mctp, int timeout_ms);
+int pldm_fwup_handler_send_full_mctp_message(struct pldm_fwup_handler *handler, int command, uint8_t fd_eid, uint8_t fd_addr);
 int pldm_fwup_handler_send_and_receive_full_mctp_message(struct pldm_fwup_handler *handler, int command, uint8_t fd_eid, uint8_t fd_addr);
+int pldm_fwup_handler_check_operation_status(int transport_status, int protocol_status);
+int pldm_fwup_handler_start_download_fd(struct pldm_fwup_handler *handler, struct pldm_fwup_fd_manager *fd_mgr,
+    uint8_t ua_eid);
+int pldm_fwup_handler_fill_transfer_window_fd(struct pldm_fwup_handler *handler, struct pldm_fwup_fd_manager *fd_mgr,
+    uint8_t ua_eid, uint8_t ua_addr);
+bool pldm_fwup_handler_is_local_copy_pending_fd(const struct pldm_fwup_fd_manager *fd_mgr);
+bool pldm_fwup_handler_is_download_complete_fd(const struct pldm_fwup_fd_manager *fd_mgr);
 
 
 #define	PLDM_FWUP_HANDLER_ERROR(code)                                               ROT_ERROR (ROT_MODULE_PLDM_FWUP_HANDLER, code)
@@ -83,7 +92,10 @@ enum {
     PLDM_FWUP_HANDLER_INVALID_CMD_OPERATION = PLDM_FWUP_HANDLER_ERROR (0x04),       /**< Invalid command operation based on sequence of events. */
     PLDM_FWUP_HANDLER_INVALID_UA_MANAGER_STATE = PLDM_FWUP_HANDLER_ERROR (0x05),    /**< Invalid update agent manager state. */
     PLDM_FWUP_HANDLER_INVALID_FD_MANAGER_STATE = PLDM_FWUP_HANDLER_ERROR (0x06),    /**< Invalid firmware device manager state. */
-    PLDM_FWUP_HANDLER_COMMAND_NOT_EXPECTED = PLDM_FWUP_HANDLER_ERROR (0x07)         /**< Command received was not expected based on sequence of events. */
+    PLDM_FWUP_HANDLER_COMMAND_NOT_EXPECTED = PLDM_FWUP_HANDLER_ERROR (0x07),        /**< Command received was not expected based on sequence of events. */
+    PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS = PLDM_FWUP_HANDLER_ERROR (0x08),          /**< A firmware update is still being run. */
+    PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT = PLDM_FWUP_HANDLER_ERROR (0x09),            /**< An expected message was not received in time. */
+    PLDM_FWUP_HANDLER_UPDATE_CANCELED = PLDM_FWUP_HANDLER_ERROR (0x0a)              /**< The UA canceled the firmware update. */
 };
 
 
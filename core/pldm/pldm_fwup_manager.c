@@ -1,6 +1,9 @@
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include "pldm_fwup_manager.h"
+#include "pldm_fwup_delta.h"
+#include "crypto/checksum.h"
 
 
 
@@ -57,6 +60,32 @@ void pldm_fwup_manager_deinit(struct pldm_fwup_manager *fwup_mgr)
         memset(fwup_mgr, 0, sizeof (struct pldm_fwup_manager));
     }
 }
+/**
+ * Configure the FD to hash each component image as it is downloaded.
+ * 
+ * @param fwup_mgr The PLDM FWUP manager instance to configure.
+ * @param hash The hash engine to use or null to disable hashing of component images.
+ * @param type The type of hash to calculate.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int pldm_fwup_manager_set_comp_hash(struct pldm_fwup_manager *fwup_mgr, struct hash_engine *hash, enum hash_type type)
+{
+    if (fwup_mgr == NULL) {
+        return PLDM_FWUP_MANAGER_INVALID_ARGUMENT;
+    }
+
+    if (hash != NULL && !hash_is_alg_supported(type)) {
+        return PLDM_FWUP_MANAGER_UNSUPPORTED_HASH;
+    }
+
+    cancel_comp_hash(&fwup_mgr->fd_mgr.comp_hash);
+    fwup_mgr->fd_mgr.comp_hash.hash = hash;
+    fwup_mgr->fd_mgr.comp_hash.type = type;
+    fwup_mgr->fd_mgr.comp_hash.digest_len = 0;
+
+    return 0;
+}
 
 
 /**
@@ -70,4 +99,961 @@ void reset_get_cmd_state(struct pldm_fwup_protocol_multipart_transfer *get_cmd_s
     get_cmd_state->next_data_transfer_handle = 0;
     get_cmd_state->transfer_op_flag = PLDM_GET_FIRSTPART;
     get_cmd_state->transfer_flag = PLDM_START;
-}
\ No newline at end of file
+}
+
+/**
+ * Reset the window of outstanding RequestFirmwareData requests.
+ * 
+ * @param window The transfer window to reset.
+ * @param size The number of requests that can be outstanding at once. This is limited to the number of slots
+ * available in the window and will be at least one.
+*/
+void reset_transfer_window(struct pldm_fwup_fd_transfer_window *window, uint8_t size)
+{
+    memset(window, 0, sizeof (struct pldm_fwup_fd_transfer_window));
+
+    if (size == 0) {
+        size = 1;
+    }
+    else if (size > PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ) {
+        size = PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ;
+    }
+    window->size = size;
+}
+
+/**
+ * Round a RequestFirmwareData length down so the response fills whole MCTP packets.
+ * 
+ * @param tuning The transfer tuning state.
+ * @param size The length to round.
+ * 
+ * @return The rounded length, limited to the tuning bounds.
+*/
+static uint32_t align_transfer_size(const struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t size)
+{
+    /* The response carries a completion code in addition to the firmware data. */
+    size_t overhead = PLDM_MCTP_BINDING_MSG_OVERHEAD + 1;
+    size_t packets;
+    size_t aligned;
+
+    if (size >= tuning->max_size) {
+        return tuning->max_size;
+    }
+
+    if (tuning->packet_payload > overhead) {
+        packets = (size + overhead) / tuning->packet_payload;
+        aligned = (packets * tuning->packet_payload) - overhead;
+        if (packets != 0 && aligned >= tuning->min_size) {
+            size = aligned;
+        }
+    }
+
+    if (size < tuning->min_size) {
+        size = tuning->min_size;
+    }
+
+    return size;
+}
+
+/**
+ * Start a new throughput measurement window.
+ * 
+ * @param tuning The transfer tuning state.
+*/
+static void start_transfer_tuning_window(struct pldm_fwup_fd_transfer_tuning *tuning)
+{
+    tuning->window_bytes = 0;
+    tuning->window_count = 0;
+    platform_init_current_tick(&tuning->window_start);
+}
+
+/**
+ * Reset the tuning of the RequestFirmwareData length at the start of a component download.
+ * 
+ * @param tuning The transfer tuning state to reset.
+ * @param max_size The negotiated maximum transfer size.
+ * @param packet_payload The MCTP payload per packet to the UA or 0 if it is not known.
+*/
+void reset_transfer_tuning(struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t max_size, size_t packet_payload)
+{
+    memset(tuning, 0, sizeof (struct pldm_fwup_fd_transfer_tuning));
+
+    tuning->max_size = max_size;
+    tuning->min_size = (max_size < PLDM_FWUP_BASELINE_TRANSFER_SIZE) ? max_size : PLDM_FWUP_BASELINE_TRANSFER_SIZE;
+    tuning->packet_payload = packet_payload;
+    tuning->size = max_size;
+    tuning->best_size = max_size;
+
+    start_transfer_tuning_window(tuning);
+}
+
+/**
+ * Get the length of firmware data to request with the next RequestFirmwareData request.
+ * 
+ * @param update_info Update information retained by FD.
+ * 
+ * @return The length to request. This is the negotiated maximum if the length is not being tuned. The length never
+ * extends past the changed data at the current offset of a delta update.
+*/
+uint32_t get_transfer_size(const struct pldm_fwup_fd_update_info *update_info)
+{
+    uint32_t size = update_info->transfer_tuning.size;
+    uint32_t end;
+
+    if (size == 0) {
+        size = update_info->max_transfer_size;
+    }
+
+    /* Don't request any unchanged data that follows, since it will be copied from the active image. */
+    end = pldm_fwup_delta_get_run_end(&update_info->delta, update_info->current_comp_img_offset,
+        update_info->current_comp_img_size);
+    if (end > update_info->current_comp_img_offset && (end - update_info->current_comp_img_offset) < size) {
+        size = end - update_info->current_comp_img_offset;
+    }
+
+    return size;
+}
+
+/**
+ * Account for a successful RequestFirmwareData response. Once a full window of responses has been received, the
+ * throughput is measured and the length is grown if it is no worse than the best seen, otherwise the length that
+ * achieved the best throughput is restored.
+ * 
+ * @param tuning The transfer tuning state.
+ * @param length The length of firmware data received.
+*/
+void update_transfer_tuning(struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t length)
+{
+    platform_clock now;
+
+    if (tuning->size == 0) {
+        return;
+    }
+
+    platform_init_current_tick(&now);
+    update_transfer_tuning_window(tuning, length, platform_get_duration(&tuning->window_start, &now));
+}
+
+/**
+ * Account for a successful RequestFirmwareData response using a known duration for the measurement window instead
+ * of reading the platform clock.
+ * 
+ * @param tuning The transfer tuning state.
+ * @param length The length of firmware data received.
+ * @param window_ms The time in milliseconds since the current measurement window started. This is only used when
+ * the response completes the window.
+*/
+void update_transfer_tuning_window(struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t length,
+    uint32_t window_ms)
+{
+    uint32_t rate;
+
+    if (tuning->size == 0) {
+        return;
+    }
+
+    tuning->window_bytes += length;
+    tuning->window_count++;
+    if (tuning->window_count < PLDM_FWUP_PROTOCOL_TRANSFER_TUNING_WINDOW) {
+        return;
+    }
+
+    if (window_ms == 0) {
+        window_ms = 1;
+    }
+    rate = (uint32_t) (((uint64_t) tuning->window_bytes * 1000) / window_ms);
+
+    if (rate >= tuning->best_rate) {
+        tuning->best_rate = rate;
+        tuning->best_size = tuning->size;
+        tuning->size = align_transfer_size(tuning, tuning->size * 2);
+        if (tuning->size <= tuning->best_size) {
+            /* Doubling did not reach another whole packet, so grow by one packet instead. */
+            tuning->size = align_transfer_size(tuning, tuning->best_size + tuning->packet_payload);
+        }
+    }
+    else {
+        /* Let the best rate decay so a link that has slowed down does not pin the length forever. */
+        tuning->best_rate -= tuning->best_rate / 8;
+        tuning->size = tuning->best_size;
+    }
+
+    start_transfer_tuning_window(tuning);
+}
+
+/**
+ * Account for a RequestFirmwareData request the UA asked to be retried by halving the requested length.
+ * 
+ * @param tuning The transfer tuning state.
+*/
+void retry_transfer_tuning(struct pldm_fwup_fd_transfer_tuning *tuning)
+{
+    if (tuning->size == 0) {
+        return;
+    }
+
+    tuning->size = align_transfer_size(tuning, tuning->size / 2);
+    tuning->best_size = tuning->size;
+    tuning->best_rate = 0;
+
+    start_transfer_tuning_window(tuning);
+}
+
+/**
+ * Reset the FD write buffer to start staging data at a new flash address.
+ * 
+ * @param buffer The write buffer to reset. Any buffered data is discarded.
+ * @param flash The flash device the data will be written to.
+ * @param addr The flash address of the next data to be written. If this is not sector aligned, the sector containing
+ * it is assumed to already be erased.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int reset_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr)
+{
+    int status;
+
+    buffer->addr = addr;
+    buffer->length = 0;
+    buffer->flushed = addr;
+
+    status = flash->get_sector_size(flash, &buffer->sector_size);
+    if (status != 0) {
+        buffer->sector_size = 0;
+        return status;
+    }
+
+    buffer->erased = FLASH_REGION_BASE(addr + buffer->sector_size - 1, buffer->sector_size);
+    buffer->erase_end = buffer->erased;
+    return 0;
+}
+
+/**
+ * Erase the sectors of a range of flash that the write buffer has not erased yet.
+ * 
+ * @param buffer The write buffer tracking the erased sectors.
+ * @param flash The flash device being written to.
+ * @param addr The first flash address that will be written.
+ * @param end The flash address following the last byte that will be written.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+static int erase_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr,
+    uint32_t end)
+{
+    int status;
+
+    if (buffer->sector_size == 0) {
+        status = flash->get_sector_size(flash, &buffer->sector_size);
+        if (status != 0) {
+            buffer->sector_size = 0;
+            return status;
+        }
+        buffer->erased = 0;
+    }
+
+    /* Sectors before the data have been either erased already or skipped entirely, so erasing starts from the sector
+     * containing the data. */
+    if (buffer->erased < FLASH_REGION_BASE(addr, buffer->sector_size)) {
+        buffer->erased = FLASH_REGION_BASE(addr, buffer->sector_size);
+    }
+    while (buffer->erased < end) {
+        status = flash->sector_erase(flash, buffer->erased);
+        if (status != 0) {
+            return status;
+        }
+        buffer->erased += buffer->sector_size;
+    }
+
+    return 0;
+}
+
+/**
+ * Write all buffered data to flash, erasing any sectors that have not been erased yet.
+ * 
+ * @param buffer The write buffer to flush.
+ * @param flash The flash device to write to.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int flush_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash)
+{
+    uint32_t end = buffer->addr + buffer->length;
+    int status;
+
+    if (buffer->length == 0) {
+        return 0;
+    }
+
+    status = erase_write_buffer(buffer, flash, buffer->addr, end);
+    if (status != 0) {
+        return status;
+    }
+
+    status = flash->write(flash, buffer->addr, buffer->data, buffer->length);
+    if (ROT_IS_ERROR(status)) {
+        return status;
+    }
+
+    buffer->flushed = end;
+    buffer->addr = end;
+    buffer->length = 0;
+    return 0;
+}
+
+/**
+ * Stage firmware data to be written to flash. Data is written once the buffer fills up to the next buffer-aligned
+ * address or when data that does not follow the buffered data is added.
+ * 
+ * @param buffer The write buffer to add to.
+ * @param flash The flash device to write to.
+ * @param addr The flash address of the data.
+ * @param data The data to write.
+ * @param length The length of the data.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int append_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr,
+    const uint8_t *data, size_t length)
+{
+    uint32_t limit;
+    size_t copy;
+    int status;
+
+    if (buffer->length != 0 && addr != (buffer->addr + buffer->length)) {
+        status = flush_write_buffer(buffer, flash);
+        if (status != 0) {
+            return status;
+        }
+    }
+    if (buffer->length == 0) {
+        buffer->addr = addr;
+    }
+
+    while (length > 0) {
+        limit = PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE - (buffer->addr % PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE);
+        copy = limit - buffer->length;
+        if (copy > length) {
+            copy = length;
+        }
+
+        memcpy(&buffer->data[buffer->length], data, copy);
+        buffer->length += copy;
+        data += copy;
+        length -= copy;
+
+        if (buffer->length == limit) {
+            status = flush_write_buffer(buffer, flash);
+            if (status != 0) {
+                return status;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Copy data that is already in flash to follow the data written through the write buffer. Any buffered data is written
+ * first, and sectors are erased as needed just like data written from the buffer.
+ * 
+ * @param buffer The write buffer.
+ * @param flash The flash device to copy within.
+ * @param addr The flash address to copy the data to. This must follow the buffered data.
+ * @param src_addr The flash address to copy the data from. This must not share an erase block with the destination.
+ * @param length The length of the data to copy.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int copy_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr,
+    uint32_t src_addr, size_t length)
+{
+    int status;
+
+    status = flush_write_buffer(buffer, flash);
+    if (status != 0) {
+        return status;
+    }
+
+    status = erase_write_buffer(buffer, flash, addr, addr + length);
+    if (status != 0) {
+        return status;
+    }
+
+    status = flash_copy_to_blank(flash, addr, src_addr, length);
+    if (status != 0) {
+        return status;
+    }
+
+    buffer->flushed = addr + length;
+    buffer->addr = addr + length;
+    return 0;
+}
+
+/**
+ * Start erasing the sectors that will be written through the write buffer ahead of the data. Sectors are erased a few
+ * at a time by continue_write_buffer_pre_erase, and any sector the data reaches first is erased when it is flushed.
+ * 
+ * @param buffer The write buffer. This must have been reset to the address of the first data to be written.
+ * @param end The flash address following the last byte that will be written.
+*/
+void start_write_buffer_pre_erase(struct pldm_fwup_fd_write_buffer *buffer, uint32_t end)
+{
+    buffer->erase_end = end;
+}
+
+/**
+ * Check if there are sectors left to erase ahead of the data.
+ * 
+ * @param buffer The write buffer.
+ * 
+ * @return true if more sectors need to be erased.
+*/
+bool is_write_buffer_pre_erase_pending(const struct pldm_fwup_fd_write_buffer *buffer)
+{
+    return (buffer->sector_size != 0) && (buffer->erased < buffer->erase_end);
+}
+
+/**
+ * Erase the next sectors ahead of the data written through the write buffer. The time taken is measured to estimate
+ * how long the remaining sectors will take.
+ * 
+ * @param buffer The write buffer.
+ * @param flash The flash device being written to.
+ * @param max_sectors The maximum number of sectors to erase.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int continue_write_buffer_pre_erase(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash,
+    uint32_t max_sectors)
+{
+    platform_clock start;
+    platform_clock now;
+    uint32_t count = 0;
+    uint32_t elapsed;
+    int status;
+
+    platform_init_current_tick(&start);
+    while ((count < max_sectors) && is_write_buffer_pre_erase_pending(buffer)) {
+        status = flash->sector_erase(flash, buffer->erased);
+        if (status != 0) {
+            return status;
+        }
+        buffer->erased += buffer->sector_size;
+        count++;
+    }
+
+    if (count != 0) {
+        platform_init_current_tick(&now);
+        elapsed = platform_get_duration(&start, &now) / count;
+        if (elapsed == 0) {
+            elapsed = 1;
+        }
+
+        /* Average with the previous measurement to smooth out variation between sectors. */
+        if (buffer->erase_time_ms != 0) {
+            elapsed = (buffer->erase_time_ms + elapsed) / 2;
+        }
+        buffer->erase_time_ms = elapsed;
+    }
+
+    return 0;
+}
+
+/**
+ * Estimate the time needed to erase the sectors up to an address that have not been erased yet.
+ * 
+ * @param buffer The write buffer.
+ * @param end The flash address following the last byte that needs to be erased. Sectors past the range being erased
+ * ahead of the data are not counted.
+ * 
+ * @return The estimated time in milliseconds. The platform default is used for each sector until an erase has been
+ * measured.
+*/
+uint32_t get_write_buffer_pre_erase_time(const struct pldm_fwup_fd_write_buffer *buffer, uint32_t end)
+{
+    uint32_t sector_time = buffer->erase_time_ms;
+    uint32_t sectors;
+
+    if (end > buffer->erase_end) {
+        end = buffer->erase_end;
+    }
+    if (buffer->sector_size == 0 || end <= buffer->erased) {
+        return 0;
+    }
+
+    if (sector_time == 0) {
+        sector_time = PLDM_FWUP_PROTOCOL_SECTOR_ERASE_TIME_MS;
+    }
+
+    sectors = ((end - buffer->erased) + buffer->sector_size - 1) / buffer->sector_size;
+    return sectors * sector_time;
+}
+
+/**
+ * Start hashing a new component image. Any digest from a previous component is discarded.
+ * 
+ * @param comp_hash The component hash context. Nothing is done if no hash engine has been configured.
+ * 
+ * @note If a hash can't be started on the engine, the digest will be calculated from flash once the transfer is
+ * complete.
+*/
+void start_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    cancel_comp_hash(comp_hash);
+    comp_hash->digest_len = 0;
+    comp_hash->rebuild = false;
+
+    if (comp_hash->hash != NULL) {
+        comp_hash->in_order = (hash_start_new_hash(comp_hash->hash, comp_hash->type) == 0);
+        comp_hash->active = comp_hash->in_order;
+    }
+}
+
+/**
+ * Add firmware data that was written to flash to the running hash of the component image.
+ * 
+ * Data must be added in offset order to be hashed. Data that was already hashed is skipped. If there is a gap in the
+ * data, the running hash is abandoned and the digest will be calculated from flash once the transfer is complete.
+ * 
+ * @param comp_hash The component hash context.
+ * @param offset The offset of the data in the component image.
+ * @param data The firmware data.
+ * @param length The length of the firmware data.
+ * @param comp_img_size The size of the component image. Any data past the end of the image is not hashed.
+*/
+void update_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash, uint32_t offset, const uint8_t *data, size_t length,
+    uint32_t comp_img_size)
+{
+    size_t end;
+    size_t skip;
+
+    if (!comp_hash->active) {
+        return;
+    }
+
+    if (offset > comp_hash->hashed_len) {
+        cancel_comp_hash(comp_hash);
+        return;
+    }
+
+    end = offset + length;
+    if (end > comp_img_size) {
+        end = comp_img_size;
+    }
+    if (end <= comp_hash->hashed_len) {
+        return;
+    }
+
+    skip = comp_hash->hashed_len - offset;
+    if (comp_hash->hash->update(comp_hash->hash, &data[skip], end - comp_hash->hashed_len) != 0) {
+        cancel_comp_hash(comp_hash);
+        return;
+    }
+    comp_hash->hashed_len = end;
+}
+
+/**
+ * Complete the hash of the downloaded component image.
+ * 
+ * If the running hash covers the entire image, it is finished directly. Otherwise, the image is read back from
+ * flash to calculate the digest.
+ * 
+ * @param comp_hash The component hash context. Nothing is done if no hash engine has been configured.
+ * @param flash_mgr The flash manager for the FD.
+ * @param comp_num The component that was downloaded.
+ * @param comp_img_size The size of the component image.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int finish_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash, struct pldm_fwup_flash_manager *flash_mgr,
+    uint16_t comp_num, uint32_t comp_img_size)
+{
+    int hash_length;
+    int status;
+
+    comp_hash->digest_len = 0;
+    if (comp_hash->hash == NULL) {
+        return 0;
+    }
+
+    hash_length = hash_get_hash_length(comp_hash->type);
+    if (ROT_IS_ERROR(hash_length)) {
+        cancel_comp_hash(comp_hash);
+        return hash_length;
+    }
+
+    if (comp_hash->active && comp_hash->hashed_len == comp_img_size) {
+        status = comp_hash->hash->finish(comp_hash->hash, comp_hash->digest, sizeof (comp_hash->digest));
+        if (status != 0) {
+            cancel_comp_hash(comp_hash);
+            return status;
+        }
+        comp_hash->active = false;
+    }
+    else {
+        cancel_comp_hash(comp_hash);
+        status = flash_hash_contents(flash_mgr->flash, flash_mgr->comp_regions[comp_num].start_addr, comp_img_size,
+            comp_hash->hash, comp_hash->type, comp_hash->digest, sizeof (comp_hash->digest));
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    comp_hash->digest_len = hash_length;
+    return 0;
+}
+
+/**
+ * Stop hashing the current component image.
+ * 
+ * @param comp_hash The component hash context.
+*/
+void cancel_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    if (comp_hash->active) {
+        comp_hash->hash->cancel(comp_hash->hash);
+    }
+    comp_hash->active = false;
+    comp_hash->in_order = false;
+    comp_hash->hashed_len = 0;
+}
+
+/**
+ * Add firmware data that was copied to flash to the running hash of the component image. The same rules apply as for
+ * data added with update_comp_hash.
+ * 
+ * @param comp_hash The component hash context.
+ * @param flash The flash device containing the data.
+ * @param addr The flash address of the data.
+ * @param offset The offset of the data in the component image.
+ * @param length The length of the data.
+ * @param comp_img_size The size of the component image. Any data past the end of the image is not hashed.
+*/
+void update_comp_hash_from_flash(struct pldm_fwup_fd_comp_hash *comp_hash, const struct flash *flash, uint32_t addr,
+    uint32_t offset, size_t length, uint32_t comp_img_size)
+{
+    size_t end;
+    size_t skip;
+
+    if (!comp_hash->active) {
+        return;
+    }
+
+    if (offset > comp_hash->hashed_len) {
+        cancel_comp_hash(comp_hash);
+        return;
+    }
+
+    end = offset + length;
+    if (end > comp_img_size) {
+        end = comp_img_size;
+    }
+    if (end <= comp_hash->hashed_len) {
+        return;
+    }
+
+    skip = comp_hash->hashed_len - offset;
+    if (flash_hash_update_contents(flash, addr + skip, end - comp_hash->hashed_len, comp_hash->hash) != 0) {
+        cancel_comp_hash(comp_hash);
+        return;
+    }
+    comp_hash->hashed_len = end;
+}
+
+/**
+ * Add the start of a component image that is already in flash to a newly started running hash.
+ * 
+ * @param comp_hash The component hash context.
+ * @param flash_mgr The flash manager for the FD.
+ * @param comp_num The component being downloaded.
+ * @param length The length of the image to hash.
+*/
+static void rebuild_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash, struct pldm_fwup_flash_manager *flash_mgr,
+    uint16_t comp_num, uint32_t length)
+{
+    if (!comp_hash->active || (length == 0)) {
+        return;
+    }
+
+    if (flash_hash_update_contents(flash_mgr->flash, flash_mgr->comp_regions[comp_num].start_addr, length,
+        comp_hash->hash) != 0) {
+        cancel_comp_hash(comp_hash);
+    }
+    else {
+        comp_hash->hashed_len = length;
+    }
+}
+
+/**
+ * Calculate the CRC of an FD transfer checkpoint.
+ * 
+ * @param checkpoint The checkpoint to calculate the CRC for.
+ * 
+ * @return The CRC of the checkpoint data.
+*/
+static uint8_t fd_checkpoint_crc(const struct pldm_fwup_fd_checkpoint *checkpoint)
+{
+    const uint8_t *data = (const uint8_t*) checkpoint;
+    size_t remaining = offsetof (struct pldm_fwup_fd_checkpoint, crc);
+    size_t length;
+    uint8_t crc = 0;
+
+    while (remaining > 0) {
+        length = (remaining > UINT8_MAX) ? UINT8_MAX : remaining;
+        crc = checksum_update_smbus_crc8(crc, data, length);
+        data += length;
+        remaining -= length;
+    }
+
+    return crc;
+}
+
+/**
+ * Build the checkpoint for the current state of a component transfer.
+ * 
+ * @param checkpoint The checkpoint to build.
+ * @param update_info Update information retained by FD.
+ * @param comp_hash The running hash of the component image.
+*/
+static void build_fd_checkpoint(struct pldm_fwup_fd_checkpoint *checkpoint, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    memset(checkpoint, 0, sizeof (struct pldm_fwup_fd_checkpoint));
+
+    checkpoint->marker = PLDM_FWUP_FD_CHECKPOINT_MARKER;
+    checkpoint->comp_num = update_info->current_comp_num;
+    if (update_info->comp_entries != NULL) {
+        checkpoint->comp_classification = update_info->comp_entries[update_info->current_comp_num].comp_classification;
+        checkpoint->comp_identifier = update_info->comp_entries[update_info->current_comp_num].comp_identifier;
+    }
+    checkpoint->comp_comparison_stamp = update_info->current_comp_comparison_stamp;
+    checkpoint->comp_img_size = update_info->current_comp_img_size;
+    checkpoint->offset = update_info->current_comp_img_confirmed;
+    checkpoint->comp_img_set_ver.version_str_type = update_info->comp_img_set_ver.version_str_type;
+    checkpoint->comp_img_set_ver.version_str_length = update_info->comp_img_set_ver.version_str_length;
+    memcpy(checkpoint->comp_img_set_ver.version_str, update_info->comp_img_set_ver.version_str,
+        update_info->comp_img_set_ver.version_str_length);
+
+    if (comp_hash != NULL && comp_hash->active) {
+        checkpoint->hash_type = comp_hash->type;
+        checkpoint->hashed_len = comp_hash->hashed_len;
+    }
+}
+
+/**
+ * Save the progress of the current component transfer to the checkpoint region of the FD flash.
+ * 
+ * @param flash_mgr The flash manager for the FD. Nothing is saved if there is no checkpoint region.
+ * @param update_info Update information retained by FD.
+ * @param comp_hash The running hash of the component image.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int save_fd_checkpoint(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    struct pldm_fwup_fd_checkpoint checkpoint;
+
+    if (flash_mgr->checkpoint_region.length == 0) {
+        return 0;
+    }
+
+    if (flash_mgr->checkpoint_region.length < sizeof (checkpoint)) {
+        return PLDM_FWUP_MANAGER_SMALL_CHECKPOINT_REGION;
+    }
+
+    build_fd_checkpoint(&checkpoint, update_info, comp_hash);
+    checkpoint.crc = fd_checkpoint_crc(&checkpoint);
+
+    return flash_sector_program_data(flash_mgr->flash, flash_mgr->checkpoint_region.start_addr,
+        (const uint8_t*) &checkpoint, sizeof (checkpoint));
+}
+
+/**
+ * Prepare the transfer of the current component, resuming from a saved checkpoint when one exists for the same
+ * component of the same component image set.
+ * 
+ * The running hash must already be started for the component. When resuming, the data that was already written to
+ * flash is added to it.
+ * 
+ * @param flash_mgr The flash manager for the FD.
+ * @param update_info Update information retained by FD. The transfer offsets will be updated.
+ * @param comp_hash The running hash of the component image.
+ * 
+ * @return 0 on success otherwise an error code. If a checkpoint can't be used, the transfer starts from the
+ * beginning of the image.
+*/
+int resume_fd_checkpoint(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    struct pldm_fwup_fd_checkpoint saved;
+    struct pldm_fwup_fd_checkpoint expected;
+    int status;
+
+    update_info->current_comp_img_offset = 0;
+    update_info->current_comp_img_confirmed = 0;
+    update_info->next_checkpoint = PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL;
+
+    if (flash_mgr->checkpoint_region.length < sizeof (saved)) {
+        return 0;
+    }
+
+    status = flash_mgr->flash->read(flash_mgr->flash, flash_mgr->checkpoint_region.start_addr, (uint8_t*) &saved,
+        sizeof (saved));
+    if (status != 0) {
+        return status;
+    }
+
+    if ((saved.marker != PLDM_FWUP_FD_CHECKPOINT_MARKER) || (saved.crc != fd_checkpoint_crc(&saved))) {
+        return 0;
+    }
+
+    /* Only the transfer progress may differ from the checkpoint of the component being updated. */
+    build_fd_checkpoint(&expected, update_info, NULL);
+    expected.offset = saved.offset;
+    expected.hash_type = saved.hash_type;
+    expected.hashed_len = saved.hashed_len;
+    expected.crc = saved.crc;
+    if ((memcmp(&saved, &expected, sizeof (saved)) != 0) || (saved.offset > saved.comp_img_size)) {
+        return 0;
+    }
+
+    rebuild_comp_hash(comp_hash, flash_mgr, saved.comp_num, saved.offset);
+
+    update_info->current_comp_img_offset = saved.offset;
+    update_info->current_comp_img_confirmed = saved.offset;
+    update_info->next_checkpoint = saved.offset + PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL;
+
+    return 0;
+}
+
+/**
+ * Remove the transfer checkpoint from the FD flash.
+ * 
+ * @param flash_mgr The flash manager for the FD. Nothing is done if there is no checkpoint region.
+ * 
+ * @return 0 on success otherwise an error code.
+*/
+int clear_fd_checkpoint(struct pldm_fwup_flash_manager *flash_mgr)
+{
+    if (flash_mgr->checkpoint_region.length == 0) {
+        return 0;
+    }
+
+    return flash_sector_erase_region(flash_mgr->flash, flash_mgr->checkpoint_region.start_addr,
+        sizeof (struct pldm_fwup_fd_checkpoint));
+}
+
+/**
+ * Start comparing the component being downloaded against the active image on the FD so that unchanged blocks are
+ * copied locally instead of being requested from the UA.  The blocks are compared by continue_fd_delta.
+ * 
+ * The active image is hashed with the component hash engine, so any running hash of the component is stopped while
+ * blocks are compared.  When the download resumes after data was already written, such as after a checkpoint was
+ * restored, the running hash is rebuilt afterwards from the data written to flash.  Every block is compared, including
+ * the blocks before the point the download resumes from, but only the data after that point is requested or copied.
+ * 
+ * @param flash_mgr The flash manager for the FD. Nothing is compared if there are no active component regions.
+ * @param update_info Update information retained by FD. The delta map will be updated.
+ * @param comp_hash The running hash of the component image. Nothing is compared if no hash engine has been configured.
+ * 
+ * @return 0 on success otherwise an error code. If the blocks can't be compared, the whole image is requested from
+ * the UA.
+*/
+int start_fd_delta(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    int status;
+
+    memset(&update_info->delta, 0, sizeof (update_info->delta));
+    if (comp_hash->hash == NULL || flash_mgr->active_comp_regions == NULL || update_info->comp_entries == NULL) {
+        return 0;
+    }
+
+    status = pldm_fwup_delta_start_map(&update_info->delta, flash_mgr, update_info->package_data_len,
+        update_info->current_comp_num, &update_info->comp_entries[update_info->current_comp_num],
+        update_info->current_comp_img_size);
+    if ((status != 0) || !pldm_fwup_delta_is_map_pending(&update_info->delta)) {
+        return status;
+    }
+
+    comp_hash->rebuild = comp_hash->active;
+    cancel_comp_hash(comp_hash);
+
+    return 0;
+}
+
+/**
+ * Check if the FD still has to compare blocks of the component against the active image or restart the running hash
+ * of the component before requesting firmware data.
+ * 
+ * @param update_info Update information retained by FD.
+ * @param comp_hash The running hash of the component image.
+ * 
+ * @return true if continue_fd_delta must be called again.
+*/
+bool is_fd_delta_pending(const struct pldm_fwup_fd_update_info *update_info,
+    const struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    return pldm_fwup_delta_is_map_pending(&update_info->delta) || comp_hash->rebuild;
+}
+
+/**
+ * Continue the work started by start_fd_delta.  Each call either compares blocks of the active image or, once every
+ * block has been compared, adds data written before the download resumed to the restarted running hash.  The work is
+ * done when is_fd_delta_pending returns false.
+ * 
+ * @param flash_mgr The flash manager for the FD.
+ * @param update_info Update information retained by FD. The delta map will be updated.
+ * @param comp_hash The running hash of the component image.
+ * @param max_length The maximum length of flash data to process.  This is rounded down to whole blocks when comparing
+ * the active image, but at least one block is compared on each call.
+ * 
+ * @return 0 on success otherwise an error code.  If the running hash can't be started again, 0 is returned and the
+ * digest will be calculated from flash once the transfer is complete.  An error comparing blocks or reading the written
+ * data leaves the delta map or the running hash inactive.
+*/
+int continue_fd_delta(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash, uint32_t max_length)
+{
+    uint32_t length;
+    int status;
+
+    if (pldm_fwup_delta_is_map_pending(&update_info->delta)) {
+        length = max_length / update_info->delta.block_size;
+
+        return pldm_fwup_delta_continue_map(&update_info->delta, flash_mgr->flash, comp_hash->hash,
+            (length != 0) ? length : 1);
+    }
+
+    if (!comp_hash->rebuild) {
+        return 0;
+    }
+
+    if (!comp_hash->active) {
+        start_comp_hash(comp_hash);
+        if (!comp_hash->active) {
+            return 0;
+        }
+    }
+
+    length = update_info->current_comp_img_confirmed - comp_hash->hashed_len;
+    if (length > max_length) {
+        length = max_length;
+    }
+
+    status = flash_hash_update_contents(flash_mgr->flash,
+        flash_mgr->comp_regions[update_info->current_comp_num].start_addr + comp_hash->hashed_len, length,
+        comp_hash->hash);
+    if (status != 0) {
+        cancel_comp_hash(comp_hash);
+        comp_hash->rebuild = false;
+        return status;
+    }
+
+    comp_hash->hashed_len += length;
+    comp_hash->rebuild = (comp_hash->hashed_len < update_info->current_comp_img_confirmed);
+
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include "pldm_fwup_protocol.h"
 #include "flash/flash_updater.h"
 #include "flash/flash_util.h"
+#include "crypto/hash.h"
+#include "platform_api.h"
 #include "status/rot_status.h"
 
 
@@ -19,6 +21,8 @@ struct pldm_fwup_flash_manager {
     struct flash_region device_meta_data_region;                                    /**< Flash region that contains the FD meta data. */
     size_t device_meta_data_size;                                                   /**< Size of the FD meta data. */
     struct flash_region *comp_regions;                                              /**< The flash regions to write firmware images to. */
+    struct flash_region checkpoint_region;                                          /**< Flash region for FD transfer checkpoints.  Length 0 disables checkpoints. */
+    struct flash_region *active_comp_regions;                                       /**< The flash regions containing the active firmware images.  Null disables delta updates. */
 };
 
 /**
@@ -60,6 +64,7 @@ struct pldm_fwup_ua_update_info {
 struct pldm_fwup_ua_state {
     enum pldm_firmware_update_commands previous_cmd;                                /**< Previous FWUP command. */
     enum pldm_firmware_update_completion_codes previous_completion_code;            /**< Last received completion code. */
+    uint8_t instance_id;                                                            /**< Instance ID for the next request issued by the UA. */
 };
 
 /**
@@ -89,6 +94,91 @@ struct pldm_fwup_fd_state {
     enum pldm_firmware_update_completion_codes previous_completion_code;            /**< Previous completion code. */
 };
 
+/**
+ * A single RequestFirmwareData request issued by the FD that has not yet been committed to flash.
+ */
+struct pldm_fwup_fd_transfer_slot {
+    struct pldm_fwup_protocol_request_firmware req;                                 /**< The offset and length of the requested firmware data. */
+    uint8_t instance_id;                                                            /**< The instance ID the request was issued with. */
+    bool8_t in_use;                                                                 /**< Flag indicating the request is outstanding or waiting to be committed. */
+    bool8_t received;                                                               /**< Flag indicating the response was received out of order and is buffered. */
+    bool8_t retry;                                                                  /**< Flag indicating the UA asked for the request to be issued again. */
+    uint8_t retries;                                                                /**< Number of times the request has been issued again. */
+    uint32_t data_len;                                                              /**< Length of the buffered firmware data. */
+    uint8_t data[PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE];                             /**< Firmware data waiting for earlier offsets to be committed. */
+};
+
+/**
+ * Window of RequestFirmwareData requests the FD can have outstanding at once.
+ * 
+ * @note Responses are matched to requests by instance ID. Data is always written to flash in offset order, so
+ * a response received before the one for a lower offset is buffered in its slot until it can be committed.
+ * A slot waiting to be issued again keeps its place in the window but is not counted as outstanding.
+ */
+struct pldm_fwup_fd_transfer_window {
+    uint8_t size;                                                                   /**< Number of requests that can be outstanding at once. */
+    uint8_t outstanding;                                                            /**< Number of requests waiting for a response or to be committed. */
+    uint8_t retries;                                                                /**< Number of slots waiting for their request to be issued again. */
+    struct pldm_fwup_fd_transfer_slot slots[PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ];  /**< The outstanding requests. */
+};
+
+/**
+ * Staging buffer that coalesces firmware data received by the FD into larger flash writes.
+ * 
+ * @note Writes are aligned to the buffer size, which should be a multiple of the flash page size. Each sector is
+ * erased the first time data is flushed to it, unless it was already erased ahead of the data in the background.
+ */
+struct pldm_fwup_fd_write_buffer {
+    uint32_t addr;                                                                  /**< Flash address of the first buffered byte. */
+    uint32_t length;                                                                /**< Number of bytes buffered. */
+    uint32_t flushed;                                                               /**< Flash address following the last data written to flash. */
+    uint32_t erased;                                                                /**< Flash address following the last sector erased. */
+    uint32_t sector_size;                                                           /**< Erase sector size of the flash.  0 if not yet known. */
+    uint32_t erase_end;                                                             /**< Flash address where erasing ahead of the data stops. */
+    uint32_t erase_time_ms;                                                         /**< Measured time to erase a single sector.  0 if not yet measured. */
+    uint8_t data[PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE];                             /**< Data waiting to be written to flash. */
+};
+
+/**
+ * Tuning of the length of firmware data the FD requests with each RequestFirmwareData request.
+ * 
+ * @note The length starts at the negotiated maximum. It is halved each time the UA asks for a request to be retried
+ * and doubled again after a window of responses whose measured throughput is no worse than the best seen. Lengths
+ * below the maximum are rounded down so the response fills whole MCTP packets.
+ */
+struct pldm_fwup_fd_transfer_tuning {
+    uint32_t size;                                                                  /**< The length of the next RequestFirmwareData request. */
+    uint32_t min_size;                                                              /**< The smallest length that will be requested. */
+    uint32_t max_size;                                                              /**< The negotiated maximum transfer size. */
+    size_t packet_payload;                                                          /**< MCTP payload per packet to the UA.  0 if not known. */
+    uint32_t best_size;                                                             /**< The length that achieved the best throughput. */
+    uint32_t best_rate;                                                             /**< The best throughput measured, in bytes per second. */
+    platform_clock window_start;                                                    /**< Time the current measurement window started. */
+    uint32_t window_bytes;                                                          /**< Firmware data received in the current measurement window. */
+    uint8_t window_count;                                                           /**< Responses received in the current measurement window. */
+};
+
+/**
+ * Blocks of the component image being downloaded by the FD that differ from the active image.
+ * 
+ * @note The map is only active when the UA provided block digests for the component in its package data. Blocks
+ * that match are copied from the active image instead of being requested from the UA.
+ */
+struct pldm_fwup_fd_delta_map {
+    bool8_t active;                                                                 /**< Flag indicating unchanged blocks are copied locally. */
+    uint32_t block_size;                                                            /**< The size of each block of the image. */
+    uint32_t num_blocks;                                                            /**< The number of blocks in the image. */
+    uint32_t changed_blocks;                                                        /**< The number of blocks that must be requested from the UA. */
+    uint8_t changed[(PLDM_FWUP_PROTOCOL_MAX_DELTA_BLOCKS + 7) / 8];                 /**< Bitmap of the blocks that differ from the active image. */
+    bool8_t building;                                                               /**< Flag indicating blocks are still being compared against the active image. */
+    uint8_t hash_type;                                                              /**< The type of hash used for the block digests. */
+    uint32_t next_block;                                                            /**< The next block to compare against the active image. */
+    uint32_t comp_img_size;                                                         /**< The size of the component image being downloaded. */
+    uint32_t digest_addr;                                                           /**< Flash address of the block digests for the component. */
+    uint32_t active_addr;                                                           /**< Flash address of the active image. */
+    uint32_t active_length;                                                         /**< The length of the active image region. */
+};
+
 /**
  * Variable context that the FD needs to retain from the UA during a firmware update. 
  * 
@@ -108,6 +198,60 @@ struct pldm_fwup_fd_update_info {
 	bitfield32_t current_comp_update_option_flags;                                  /**< The update options requested by the UA for the component being updated. */
     bool8_t self_contained_activation_req;                                          /**< The activation method requested by the UA. */
     struct pldm_fwup_protocol_component_entry *comp_entries;                        /**< The component table received from the UA. */
+    struct pldm_fwup_fd_transfer_window transfer_window;                            /**< RequestFirmwareData requests that are currently outstanding. */
+    uint32_t current_comp_comparison_stamp;                                         /**< The comparison stamp of the component being updated. */
+    uint32_t current_comp_img_confirmed;                                            /**< Length of the component image that has been written to flash. */
+    uint32_t next_checkpoint;                                                       /**< The confirmed length at which the next checkpoint is saved. */
+    struct pldm_fwup_fd_write_buffer write_buffer;                                  /**< Firmware data waiting to be written to flash. */
+    struct pldm_fwup_fd_transfer_tuning transfer_tuning;                            /**< Tuning of the RequestFirmwareData length. */
+    uint32_t last_request_length;                                                   /**< Length requested by the last new RequestFirmwareData request.  0 if it was a retry. */
+    struct pldm_fwup_fd_delta_map delta;                                            /**< Blocks of the image that differ from the active image. */
+    uint16_t time_before_req_fw_data;                                               /**< Time given to the UA before firmware data is requested, in seconds. */
+};
+
+/**
+ * Marker identifying a valid FD transfer checkpoint in flash.
+ */
+#define PLDM_FWUP_FD_CHECKPOINT_MARKER                                              0x504b4350
+
+#pragma pack(push, 1)
+/**
+ * Progress of a component transfer that is saved to flash by the FD so the transfer can resume after a reset or a
+ * dropped link instead of starting over.
+ * 
+ * @note Hash engines cannot export an active context, so the partial hash state is recorded as the hash type and
+ * the length that was hashed. On resume, the hash is rebuilt from the data already in flash.
+ */
+struct pldm_fwup_fd_checkpoint {
+    uint32_t marker;                                                                /**< Marker identifying a valid checkpoint. */
+    uint16_t comp_num;                                                              /**< The index of the component in the component table. */
+    uint16_t comp_classification;                                                   /**< The classification of the component. */
+    uint16_t comp_identifier;                                                       /**< The identifier of the component. */
+    uint32_t comp_comparison_stamp;                                                 /**< The comparison stamp of the component. */
+    uint32_t comp_img_size;                                                         /**< The size of the component image. */
+    uint32_t offset;                                                                /**< Length of the image confirmed written to flash. */
+    uint8_t hash_type;                                                              /**< The type of the running hash of the component. */
+    uint32_t hashed_len;                                                            /**< Length of the image covered by the running hash.  0 if not hashing. */
+    struct pldm_fwup_protocol_version_string comp_img_set_ver;                      /**< The component image set version being updated. */
+    uint8_t crc;                                                                    /**< CRC-8 of the preceding checkpoint data. */
+};
+#pragma pack(pop)
+
+/**
+ * Running hash of the component image being downloaded by the FD.
+ * 
+ * Firmware data is added to the hash as it is written to flash, so the digest of the component is available as soon
+ * as the transfer completes without reading the image back from flash.
+ */
+struct pldm_fwup_fd_comp_hash {
+    struct hash_engine *hash;                                                       /**< Hash engine for the component image.  Null if not hashing. */
+    enum hash_type type;                                                            /**< The type of hash to calculate. */
+    bool active;                                                                    /**< Flag indicating a hash context is active on the engine. */
+    bool in_order;                                                                  /**< Flag indicating all data has been hashed in offset order. */
+    uint32_t hashed_len;                                                            /**< The length of the component image that has been hashed. */
+    bool rebuild;                                                                   /**< Flag indicating data already written to flash must be added to a restarted hash. */
+    uint8_t digest[HASH_MAX_HASH_LEN];                                              /**< The digest of the last downloaded component image. */
+    size_t digest_len;                                                              /**< The length of the digest.  0 if no digest is available. */
 };
 
 /**
@@ -119,6 +263,7 @@ struct pldm_fwup_fd_manager {
     struct pldm_fwup_protocol_multipart_transfer get_cmd_state;                     /**< Variable context for the three Get commands. */
     struct pldm_fwup_flash_manager *flash_mgr;                                      /**< Flash manager for a firmware update. */
     struct pldm_fwup_fd_update_info update_info;                                    /**< Information retained during the firmware update. */
+    struct pldm_fwup_fd_comp_hash comp_hash;                                        /**< Running hash of the component image being downloaded. */
 };
 
 
@@ -141,7 +286,51 @@ int pldm_fwup_manager_init(struct pldm_fwup_manager *fwup_mgr,
     struct pldm_fwup_protocol_version_string *fup_comp_img_set_ver, uint16_t num_components);
 void pldm_fwup_manager_deinit(struct pldm_fwup_manager *fwup_mgr);
 
+int pldm_fwup_manager_set_comp_hash(struct pldm_fwup_manager *fwup_mgr, struct hash_engine *hash, enum hash_type type);
+
 void reset_get_cmd_state(struct pldm_fwup_protocol_multipart_transfer *get_cmd_state);
+void reset_transfer_window(struct pldm_fwup_fd_transfer_window *window, uint8_t size);
+
+void reset_transfer_tuning(struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t max_size, size_t packet_payload);
+uint32_t get_transfer_size(const struct pldm_fwup_fd_update_info *update_info);
+void update_transfer_tuning(struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t length);
+void update_transfer_tuning_window(struct pldm_fwup_fd_transfer_tuning *tuning, uint32_t length,
+    uint32_t window_ms);
+void retry_transfer_tuning(struct pldm_fwup_fd_transfer_tuning *tuning);
+
+int reset_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr);
+int append_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr,
+    const uint8_t *data, size_t length);
+int flush_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash);
+int copy_write_buffer(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash, uint32_t addr,
+    uint32_t src_addr, size_t length);
+void start_write_buffer_pre_erase(struct pldm_fwup_fd_write_buffer *buffer, uint32_t end);
+bool is_write_buffer_pre_erase_pending(const struct pldm_fwup_fd_write_buffer *buffer);
+int continue_write_buffer_pre_erase(struct pldm_fwup_fd_write_buffer *buffer, const struct flash *flash,
+    uint32_t max_sectors);
+uint32_t get_write_buffer_pre_erase_time(const struct pldm_fwup_fd_write_buffer *buffer, uint32_t end);
+
+void start_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash);
+void update_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash, uint32_t offset, const uint8_t *data, size_t length,
+    uint32_t comp_img_size);
+int finish_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash, struct pldm_fwup_flash_manager *flash_mgr,
+    uint16_t comp_num, uint32_t comp_img_size);
+void cancel_comp_hash(struct pldm_fwup_fd_comp_hash *comp_hash);
+void update_comp_hash_from_flash(struct pldm_fwup_fd_comp_hash *comp_hash, const struct flash *flash, uint32_t addr,
+    uint32_t offset, size_t length, uint32_t comp_img_size);
+
+int start_fd_delta(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash);
+bool is_fd_delta_pending(const struct pldm_fwup_fd_update_info *update_info,
+    const struct pldm_fwup_fd_comp_hash *comp_hash);
+int continue_fd_delta(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash, uint32_t max_length);
+
+int save_fd_checkpoint(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash);
+int resume_fd_checkpoint(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash);
+int clear_fd_checkpoint(struct pldm_fwup_flash_manager *flash_mgr);
 
 
 
@@ -151,7 +340,9 @@ void reset_get_cmd_state(struct pldm_fwup_protocol_multipart_transfer *get_cmd_s
  * Error codes that can be generated by PLDM FWUP manager. 
  */
 enum {
-    PLDM_FWUP_MANAGER_INVALID_ARGUMENT = PLDM_FWUP_MANAGER_ERROR (0x00)     /**< Input parameter is null or not valid. */
+    PLDM_FWUP_MANAGER_INVALID_ARGUMENT = PLDM_FWUP_MANAGER_ERROR (0x00),    /**< Input parameter is null or not valid. */
+    PLDM_FWUP_MANAGER_UNSUPPORTED_HASH = PLDM_FWUP_MANAGER_ERROR (0x01),    /**< The hash algorithm is not supported. */
+    PLDM_FWUP_MANAGER_SMALL_CHECKPOINT_REGION = PLDM_FWUP_MANAGER_ERROR (0x02)  /**< The checkpoint region is too small for a checkpoint. */
 };
 
 #endif /* PLDM_FWUP_MANAGER_H_ */
\ No newline at end of file
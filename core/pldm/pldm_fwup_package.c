@@ -0,0 +1,495 @@
+#include <stddef.h>
+#include <string.h>
+#include "pldm_fwup_package.h"
+#include "crypto/checksum.h"
+
+
+/**
+ * PackageHeaderIdentifier for header format revision 1.0.x.
+ */
+static const uint8_t PLDM_FWUP_PACKAGE_HEADER_ID_1_0[] = {
+    0xf0, 0x18, 0x87, 0x8c, 0xcb, 0x7d, 0x49, 0x43, 0x98, 0x00, 0xa0, 0x2f, 0x05, 0x9a, 0xca, 0x02
+};
+
+/**
+ * PackageHeaderIdentifier for header format revision 1.1.x.
+ */
+static const uint8_t PLDM_FWUP_PACKAGE_HEADER_ID_1_1[] = {
+    0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d, 0x47, 0x18, 0xa0, 0x30, 0xfc, 0x8a, 0x56, 0x58, 0x7d, 0x5a
+};
+
+/**
+ * Length of the fixed fields in the package header information, through PackageVersionStringLength.
+ */
+#define PLDM_FWUP_PACKAGE_HEADER_INFO_LEN                                           36
+
+/**
+ * Length of the fixed fields in a firmware device ID record, through FirmwareDevicePackageDataLength.
+ */
+#define PLDM_FWUP_PACKAGE_DEVICE_RECORD_LEN                                         11
+
+/**
+ * Length of the fixed fields in a component image information entry, through ComponentVersionStringLength.
+ */
+#define PLDM_FWUP_PACKAGE_COMP_INFO_LEN                                             22
+
+/**
+ * Length of the PackageHeaderChecksum.
+ */
+#define PLDM_FWUP_PACKAGE_CHECKSUM_LEN                                              4
+
+
+/**
+ * Context for reading the package header sequentially from flash.
+ *
+ * Flash is read in blocks into a small buffer and the header fields are consumed from that buffer, so each byte of the
+ * header is read from flash exactly once and the checksum is computed as the header is parsed.
+ */
+struct pldm_fwup_package_reader {
+    const struct flash *flash;                                                      /**< The flash containing the package. */
+    uint32_t base;                                                                  /**< Flash address of the start of the package. */
+    size_t limit;                                                                   /**< The number of bytes that can be read from the package. */
+    size_t buffer_pos;                                                              /**< Package offset of the first byte in the buffer. */
+    size_t valid;                                                                   /**< The number of bytes in the buffer. */
+    size_t offset;                                                                  /**< Buffer offset of the next byte to consume. */
+    uint32_t crc;                                                                   /**< CRC32 of the bytes consumed so far. */
+    uint8_t buffer[PLDM_FWUP_PACKAGE_READ_BUFFER_SIZE];                             /**< Buffer for data read from flash. */
+};
+
+/**
+ * Get the package offset of the next byte the reader will consume.
+ *
+ * @param reader The package reader.
+ *
+ * @return The package offset.
+ */
+static size_t pldm_fwup_package_reader_position(const struct pldm_fwup_package_reader *reader)
+{
+    return reader->buffer_pos + reader->offset;
+}
+
+/**
+ * Consume data from the package header.
+ *
+ * @param reader The package reader.
+ * @param data Output for the consumed data.  Set this to null to skip over the data.
+ * @param length The number of bytes to consume.
+ *
+ * @return 0 if the data was consumed successfully or an error code.
+ */
+static int pldm_fwup_package_reader_read(struct pldm_fwup_package_reader *reader, uint8_t *data, size_t length)
+{
+    size_t chunk;
+    int status;
+
+    while (length > 0) {
+        if (reader->offset == reader->valid) {
+            reader->buffer_pos += reader->valid;
+            reader->offset = 0;
+            reader->valid = 0;
+
+            if (reader->buffer_pos >= reader->limit) {
+                return PLDM_FWUP_PACKAGE_TRUNCATED;
+            }
+
+            chunk = reader->limit - reader->buffer_pos;
+            if (chunk > sizeof (reader->buffer)) {
+                chunk = sizeof (reader->buffer);
+            }
+
+            status = reader->flash->read(reader->flash, reader->base + reader->buffer_pos, reader->buffer, chunk);
+            if (status != 0) {
+                return status;
+            }
+
+            reader->valid = chunk;
+        }
+
+        chunk = reader->valid - reader->offset;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        reader->crc = checksum_update_crc32(reader->crc, &reader->buffer[reader->offset], chunk);
+        if (data != NULL) {
+            memcpy(data, &reader->buffer[reader->offset], chunk);
+            data += chunk;
+        }
+
+        reader->offset += chunk;
+        length -= chunk;
+    }
+
+    return 0;
+}
+
+/**
+ * Consume a version string from the package header.
+ *
+ * @param reader The package reader.
+ * @param type The string type read from the header.
+ * @param length The string length read from the header.
+ * @param version Output for the version string.  Set this to null to skip over the string.
+ *
+ * @return 0 if the string was consumed successfully or an error code.
+ */
+static int pldm_fwup_package_reader_read_version(struct pldm_fwup_package_reader *reader, uint8_t type,
+    uint8_t length, struct pldm_fwup_protocol_version_string *version)
+{
+    if (version == NULL) {
+        return pldm_fwup_package_reader_read(reader, NULL, length);
+    }
+
+    memset(version, 0, sizeof (struct pldm_fwup_protocol_version_string));
+    version->version_str_type = type;
+    version->version_str_length = length;
+
+    return pldm_fwup_package_reader_read(reader, version->version_str, length);
+}
+
+/**
+ * Decode a little endian 16-bit value from the package.
+ */
+static uint16_t pldm_fwup_package_get_uint16(const uint8_t *data)
+{
+    return (uint16_t) (data[0] | (data[1] << 8));
+}
+
+/**
+ * Decode a little endian 32-bit value from the package.
+ */
+static uint32_t pldm_fwup_package_get_uint32(const uint8_t *data)
+{
+    return ((uint32_t) data[0]) | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) |
+        ((uint32_t) data[3] << 24);
+}
+
+/**
+ * Parse the firmware device ID records, keeping the details of the selected record.
+ *
+ * @param reader The package reader positioned at DeviceIDRecordCount.
+ * @param package The package details to update with the selected record.
+ * @param flash_mgr The flash manager to update with the package data of the selected record.
+ * @param record Index of the device ID record to select.
+ * @param bitmap Output for the ApplicableComponents bitmap of the selected record.
+ *
+ * @return 0 if the records were parsed successfully or an error code.
+ */
+static int pldm_fwup_package_parse_device_records(struct pldm_fwup_package_reader *reader,
+    struct pldm_fwup_package *package, struct pldm_fwup_flash_manager *flash_mgr, uint8_t record, uint8_t *bitmap)
+{
+    uint8_t header[PLDM_FWUP_PACKAGE_DEVICE_RECORD_LEN];
+    size_t bitmap_len = package->comp_bitmap_bit_length / 8;
+    uint8_t record_count;
+    uint16_t record_len;
+    uint16_t package_data_len;
+    size_t remaining;
+    bool selected;
+    int i;
+    int status;
+
+    status = pldm_fwup_package_reader_read(reader, &record_count, 1);
+    if (status != 0) {
+        return status;
+    }
+
+    if (record >= record_count) {
+        return PLDM_FWUP_PACKAGE_UNKNOWN_RECORD;
+    }
+
+    for (i = 0; i < record_count; i++) {
+        selected = (i == record);
+
+        status = pldm_fwup_package_reader_read(reader, header, sizeof (header));
+        if (status != 0) {
+            return status;
+        }
+
+        record_len = pldm_fwup_package_get_uint16(&header[0]);
+        package_data_len = pldm_fwup_package_get_uint16(&header[9]);
+
+        if (record_len < (sizeof (header) + bitmap_len + header[8] + package_data_len)) {
+            return PLDM_FWUP_PACKAGE_MALFORMED;
+        }
+
+        status = pldm_fwup_package_reader_read(reader, (selected) ? bitmap : NULL, bitmap_len);
+        if (status != 0) {
+            return status;
+        }
+
+        status = pldm_fwup_package_reader_read_version(reader, header[7], header[8],
+            (selected) ? &package->comp_img_set_ver : NULL);
+        if (status != 0) {
+            return status;
+        }
+
+        /* Skip the record descriptors.  The package data is always at the end of the record. */
+        remaining = record_len - sizeof (header) - bitmap_len - header[8];
+        status = pldm_fwup_package_reader_read(reader, NULL, remaining - package_data_len);
+        if (status != 0) {
+            return status;
+        }
+
+        if (selected) {
+            package->device_update_option_flags.value = pldm_fwup_package_get_uint32(&header[3]);
+
+            flash_mgr->package_data_region.start_addr =
+                reader->base + pldm_fwup_package_reader_position(reader);
+            flash_mgr->package_data_region.length = package_data_len;
+            flash_mgr->package_data_size = package_data_len;
+        }
+
+        status = pldm_fwup_package_reader_read(reader, NULL, package_data_len);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Skip over the downstream device ID records present in header format revision 1.1.
+ *
+ * @param reader The package reader positioned at DownstreamDeviceIDRecordCount.
+ *
+ * @return 0 if the records were skipped successfully or an error code.
+ */
+static int pldm_fwup_package_skip_downstream_records(struct pldm_fwup_package_reader *reader)
+{
+    uint8_t record_count;
+    uint8_t record_len[2];
+    uint16_t length;
+    int i;
+    int status;
+
+    status = pldm_fwup_package_reader_read(reader, &record_count, 1);
+    if (status != 0) {
+        return status;
+    }
+
+    for (i = 0; i < record_count; i++) {
+        status = pldm_fwup_package_reader_read(reader, record_len, sizeof (record_len));
+        if (status != 0) {
+            return status;
+        }
+
+        length = pldm_fwup_package_get_uint16(record_len);
+        if (length < sizeof (record_len)) {
+            return PLDM_FWUP_PACKAGE_MALFORMED;
+        }
+
+        status = pldm_fwup_package_reader_read(reader, NULL, length - sizeof (record_len));
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Parse the component image information area, keeping the components applicable to the selected device.
+ *
+ * @param reader The package reader positioned at ComponentImageCount.
+ * @param package The package details to update with the number of components.
+ * @param flash_mgr The flash manager to update with the component locations.
+ * @param bitmap The ApplicableComponents bitmap of the selected device ID record.
+ * @param length Total length of the package.
+ * @param comp_entries Output for the component image information.
+ * @param max_components The maximum number of entries that can be stored.
+ *
+ * @return 0 if the components were parsed successfully or an error code.
+ */
+static int pldm_fwup_package_parse_components(struct pldm_fwup_package_reader *reader,
+    struct pldm_fwup_package *package, struct pldm_fwup_flash_manager *flash_mgr, const uint8_t *bitmap,
+    size_t length, struct pldm_fwup_fup_component_image_entry *comp_entries, size_t max_components)
+{
+    uint8_t info[PLDM_FWUP_PACKAGE_COMP_INFO_LEN];
+    struct pldm_fwup_fup_component_image_entry *entry;
+    uint8_t count[2];
+    uint16_t comp_count;
+    uint32_t location;
+    uint32_t size;
+    bool applicable;
+    int i;
+    int status;
+
+    status = pldm_fwup_package_reader_read(reader, count, sizeof (count));
+    if (status != 0) {
+        return status;
+    }
+
+    comp_count = pldm_fwup_package_get_uint16(count);
+    if (comp_count > package->comp_bitmap_bit_length) {
+        return PLDM_FWUP_PACKAGE_MALFORMED;
+    }
+
+    for (i = 0; i < comp_count; i++) {
+        applicable = ((bitmap[i / 8] & (1U << (i % 8))) != 0);
+
+        status = pldm_fwup_package_reader_read(reader, info, sizeof (info));
+        if (status != 0) {
+            return status;
+        }
+
+        if (!applicable) {
+            status = pldm_fwup_package_reader_read(reader, NULL, info[21]);
+            if (status != 0) {
+                return status;
+            }
+
+            continue;
+        }
+
+        if (package->num_components >= max_components) {
+            return PLDM_FWUP_PACKAGE_TOO_MANY_COMPONENTS;
+        }
+
+        location = pldm_fwup_package_get_uint32(&info[12]);
+        size = pldm_fwup_package_get_uint32(&info[16]);
+        if ((location < package->header_size) || (location > length) || (size > (length - location))) {
+            return PLDM_FWUP_PACKAGE_TRUNCATED;
+        }
+
+        entry = &comp_entries[package->num_components];
+        memset(entry, 0, sizeof (struct pldm_fwup_fup_component_image_entry));
+
+        entry->comp_classification = pldm_fwup_package_get_uint16(&info[0]);
+        entry->comp_identifier = pldm_fwup_package_get_uint16(&info[2]);
+        entry->comp_comparison_stamp = pldm_fwup_package_get_uint32(&info[4]);
+        entry->comp_options.value = pldm_fwup_package_get_uint16(&info[8]);
+        entry->requested_comp_activation_method.value = pldm_fwup_package_get_uint16(&info[10]);
+        entry->comp_size = size;
+
+        status = pldm_fwup_package_reader_read_version(reader, info[20], info[21], &entry->comp_ver);
+        if (status != 0) {
+            return status;
+        }
+
+        flash_mgr->comp_regions[package->num_components].start_addr = reader->base + location;
+        flash_mgr->comp_regions[package->num_components].length = size;
+
+        package->num_components++;
+    }
+
+    return 0;
+}
+
+/**
+ * Parse a DSP0267 firmware update package stored in flash so the UA can use it for an update.
+ *
+ * The package header is parsed in a single pass through a small buffer.  Nothing is copied out of the package other
+ * than the header fields: the package data region and the component regions of the flash manager are set to the
+ * locations of that data within the package, so the UA sends it to the FD directly from the package.
+ *
+ * Only the components marked as applicable in the selected device ID record are added to the component image
+ * information list.
+ *
+ * @param package Output for the details of the package.  The component image set version in this structure should
+ * be provided to the FWUP manager along with the number of components.
+ * @param flash_mgr The UA flash manager.  The package is read from the flash of the manager.  The package data region
+ * and component regions will be updated to point into the package.  The component regions must have room for at
+ * least max_components entries.
+ * @param addr Flash address of the start of the package.
+ * @param length Total length of the package.
+ * @param record Index of the firmware device ID record that applies to the FD being updated.
+ * @param comp_entries Output for the component image information list.
+ * @param max_components The maximum number of components that can be stored.
+ *
+ * @return 0 if the package was parsed successfully or an error code.
+ */
+int pldm_fwup_package_parse(struct pldm_fwup_package *package, struct pldm_fwup_flash_manager *flash_mgr,
+    uint32_t addr, size_t length, uint8_t record, struct pldm_fwup_fup_component_image_entry *comp_entries,
+    size_t max_components)
+{
+    struct pldm_fwup_package_reader reader;
+    uint8_t info[PLDM_FWUP_PACKAGE_HEADER_INFO_LEN];
+    uint8_t bitmap[PLDM_FWUP_PACKAGE_MAX_BITMAP_LENGTH];
+    uint8_t checksum[PLDM_FWUP_PACKAGE_CHECKSUM_LEN];
+    uint32_t crc;
+    int status;
+
+    if (package == NULL || flash_mgr == NULL || flash_mgr->flash == NULL || flash_mgr->comp_regions == NULL ||
+        comp_entries == NULL || length == 0) {
+        return PLDM_FWUP_PACKAGE_INVALID_ARGUMENT;
+    }
+
+    memset(package, 0, sizeof (struct pldm_fwup_package));
+    memset(&reader, 0, sizeof (reader));
+    memset(bitmap, 0, sizeof (bitmap));
+
+    reader.flash = flash_mgr->flash;
+    reader.base = addr;
+    reader.limit = (length < PLDM_FWUP_PACKAGE_HEADER_INFO_LEN) ? length : PLDM_FWUP_PACKAGE_HEADER_INFO_LEN;
+
+    status = pldm_fwup_package_reader_read(&reader, info, sizeof (info));
+    if (status != 0) {
+        return status;
+    }
+
+    package->header_format_rev = info[16];
+    if (!(((package->header_format_rev == PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0) &&
+            (memcmp(info, PLDM_FWUP_PACKAGE_HEADER_ID_1_0, sizeof (PLDM_FWUP_PACKAGE_HEADER_ID_1_0)) == 0)) ||
+        ((package->header_format_rev == PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1) &&
+            (memcmp(info, PLDM_FWUP_PACKAGE_HEADER_ID_1_1, sizeof (PLDM_FWUP_PACKAGE_HEADER_ID_1_1)) == 0)))) {
+        return PLDM_FWUP_PACKAGE_UNSUPPORTED_FORMAT;
+    }
+
+    package->header_size = pldm_fwup_package_get_uint16(&info[17]);
+    package->comp_bitmap_bit_length = pldm_fwup_package_get_uint16(&info[32]);
+
+    if (package->header_size > length) {
+        return PLDM_FWUP_PACKAGE_TRUNCATED;
+    }
+
+    if ((package->comp_bitmap_bit_length == 0) || ((package->comp_bitmap_bit_length % 8) != 0)) {
+        return PLDM_FWUP_PACKAGE_MALFORMED;
+    }
+
+    if ((package->comp_bitmap_bit_length / 8) > sizeof (bitmap)) {
+        return PLDM_FWUP_PACKAGE_BITMAP_TOO_LONG;
+    }
+
+    /* Nothing past the header needs to be parsed.  Reading past the header size means the header is corrupt. */
+    reader.limit = package->header_size;
+
+    status = pldm_fwup_package_reader_read_version(&reader, info[34], info[35], &package->package_ver);
+    if (status != 0) {
+        return status;
+    }
+
+    status = pldm_fwup_package_parse_device_records(&reader, package, flash_mgr, record, bitmap);
+    if (status != 0) {
+        return status;
+    }
+
+    if (package->header_format_rev >= PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1) {
+        status = pldm_fwup_package_skip_downstream_records(&reader);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    status = pldm_fwup_package_parse_components(&reader, package, flash_mgr, bitmap, length, comp_entries,
+        max_components);
+    if (status != 0) {
+        return status;
+    }
+
+    if ((pldm_fwup_package_reader_position(&reader) + sizeof (checksum)) != package->header_size) {
+        return PLDM_FWUP_PACKAGE_MALFORMED;
+    }
+
+    crc = reader.crc;
+    status = pldm_fwup_package_reader_read(&reader, checksum, sizeof (checksum));
+    if (status != 0) {
+        return status;
+    }
+
+    if (pldm_fwup_package_get_uint32(checksum) != crc) {
+        return PLDM_FWUP_PACKAGE_BAD_CHECKSUM;
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef PLDM_FWUP_PACKAGE_H_
+#define PLDM_FWUP_PACKAGE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "flash/flash.h"
+#include "pldm_fwup_manager.h"
+#include "pldm_fwup_protocol.h"
+#include "status/rot_status.h"
+
+
+#ifndef PLDM_FWUP_PACKAGE_READ_BUFFER_SIZE
+#define PLDM_FWUP_PACKAGE_READ_BUFFER_SIZE                                          256
+#endif
+
+/**
+ * The largest ComponentBitmapBitLength supported by the parser, in bytes.
+ */
+#ifndef PLDM_FWUP_PACKAGE_MAX_BITMAP_LENGTH
+#define PLDM_FWUP_PACKAGE_MAX_BITMAP_LENGTH                                         32
+#endif
+
+#define PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0                                     0x01
+#define PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1                                     0x02
+
+/**
+ * Details of a DSP0267 firmware update package obtained while parsing the package header.
+ */
+struct pldm_fwup_package {
+    uint8_t header_format_rev;                                                      /**< The PackageHeaderFormatRevision of the package. */
+    uint16_t header_size;                                                           /**< The size of the package header, including the checksum. */
+    uint16_t comp_bitmap_bit_length;                                                /**< The number of bits in each ApplicableComponents bitmap. */
+    struct pldm_fwup_protocol_version_string package_ver;                           /**< The package version. */
+    struct pldm_fwup_protocol_version_string comp_img_set_ver;                      /**< Component image set version of the selected device ID record. */
+    bitfield32_t device_update_option_flags;                                        /**< Update options of the selected device ID record. */
+    uint16_t num_components;                                                        /**< The number of components applicable to the selected device ID record. */
+};
+
+
+int pldm_fwup_package_parse(struct pldm_fwup_package *package, struct pldm_fwup_flash_manager *flash_mgr,
+    uint32_t addr, size_t length, uint8_t record, struct pldm_fwup_fup_component_image_entry *comp_entries,
+    size_t max_components);
+
+
+#define	PLDM_FWUP_PACKAGE_ERROR(code)                                               ROT_ERROR (ROT_MODULE_PLDM_FWUP_PACKAGE, code)
+
+/**
+ * Error codes that can be generated by the firmware update package parser.
+ */
+enum {
+    PLDM_FWUP_PACKAGE_INVALID_ARGUMENT = PLDM_FWUP_PACKAGE_ERROR (0x00),            /**< Input parameter is null or not valid. */
+    PLDM_FWUP_PACKAGE_UNSUPPORTED_FORMAT = PLDM_FWUP_PACKAGE_ERROR (0x01),          /**< The package header identifier or format revision is not supported. */
+    PLDM_FWUP_PACKAGE_MALFORMED = PLDM_FWUP_PACKAGE_ERROR (0x02),                   /**< A length in the package header is not consistent. */
+    PLDM_FWUP_PACKAGE_TRUNCATED = PLDM_FWUP_PACKAGE_ERROR (0x03),                   /**< The package header or a component extends past the end of the package. */
+    PLDM_FWUP_PACKAGE_BAD_CHECKSUM = PLDM_FWUP_PACKAGE_ERROR (0x04),                /**< The package header checksum does not match. */
+    PLDM_FWUP_PACKAGE_UNKNOWN_RECORD = PLDM_FWUP_PACKAGE_ERROR (0x05),              /**< The requested device ID record is not in the package. */
+    PLDM_FWUP_PACKAGE_TOO_MANY_COMPONENTS = PLDM_FWUP_PACKAGE_ERROR (0x06),         /**< More components apply to the device than can be stored. */
+    PLDM_FWUP_PACKAGE_BITMAP_TOO_LONG = PLDM_FWUP_PACKAGE_ERROR (0x07)              /**< The ApplicableComponents bitmap is larger than supported. */
+};
+
+
+#endif /* PLDM_FWUP_PACKAGE_H_ */
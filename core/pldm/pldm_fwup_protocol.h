@@ -26,6 +26,42 @@
 #define PLDM_FWUP_PROTOCOL_EST_TIME_SELF_CONTAINED_ACTIVATION                           1
 #endif
 
+#ifndef PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE
+#define PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE                                            4096
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL
+#define PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL                                          (64 * 1024)
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_TRANSFER_TUNING_WINDOW
+#define PLDM_FWUP_PROTOCOL_TRANSFER_TUNING_WINDOW                                       8
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_POLL_INTERVAL_MS
+#define PLDM_FWUP_PROTOCOL_POLL_INTERVAL_MS                                             1
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_MAX_TRANSFER_RETRIES
+#define PLDM_FWUP_PROTOCOL_MAX_TRANSFER_RETRIES                                         3
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_PRE_ERASE_SECTORS
+#define PLDM_FWUP_PROTOCOL_PRE_ERASE_SECTORS                                            1
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_SECTOR_ERASE_TIME_MS
+#define PLDM_FWUP_PROTOCOL_SECTOR_ERASE_TIME_MS                                         50
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_MAX_DELTA_BLOCKS
+#define PLDM_FWUP_PROTOCOL_MAX_DELTA_BLOCKS                                             1024
+#endif
+
+#ifndef PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH
+#define PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH                                            (16 * 1024)
+#endif
+
 #pragma pack(push, 1)
 /**
  * Information for a versioning string
@@ -140,7 +176,8 @@ enum {
     CMD_HANDLER_PLDM_UNSUPPORTED_OPERATION = CMD_HANDLER_PLDM_ERROR (0x04),	                /**< The requested operation is not supported. */
     CMD_HANDLER_PLDM_OPERATION_NOT_EXPECTED = CMD_HANDLER_PLDM_ERROR (0x05),                /**< The requested operation was not expected. */
     CMD_HANDLER_PLDM_TRANSPORT_ERROR = CMD_HANDLER_PLDM_ERROR (0x06),                       /**< Transport level error. */
-    CMD_HANDLER_PLDM_PROTOCOL_ERROR = CMD_HANDLER_PLDM_ERROR (0x07)                         /**< Protocol level error. */
+    CMD_HANDLER_PLDM_PROTOCOL_ERROR = CMD_HANDLER_PLDM_ERROR (0x07),                        /**< Protocol level error. */
+    CMD_HANDLER_PLDM_TRANSFER_WINDOW_FULL = CMD_HANDLER_PLDM_ERROR (0x08)                   /**< No more firmware data requests can be outstanding. */
 };
 
 #endif /* PLDM_FWUP_PROTOCOL_H_ */
\ No newline at end of file
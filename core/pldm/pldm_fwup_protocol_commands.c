@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include "pldm_fwup_protocol_commands.h"
 #include "cmd_interface_pldm.h"
+#include "pldm_fwup_delta.h"
 #include "status/rot_status.h"
 #include "common/unused.h"
 #include "common/buffer_util.h"
@@ -21,6 +22,153 @@ void switch_state(struct pldm_fwup_fd_state *state, enum pldm_firmware_device_st
     state->current_state = new_state;
 }
 
+/**
+ * Find the slot in the transfer window for the outstanding request with the lowest offset.
+ * 
+ * @param window The transfer window to search.
+ * 
+ * @return The slot with the lowest offset or NULL if no requests are outstanding.
+*/
+static struct pldm_fwup_fd_transfer_slot* find_lowest_transfer_slot(struct pldm_fwup_fd_transfer_window *window)
+{
+    struct pldm_fwup_fd_transfer_slot *lowest = NULL;
+    int i;
+
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ; i++) {
+        if (window->slots[i].in_use && (lowest == NULL || window->slots[i].req.offset < lowest->req.offset)) {
+            lowest = &window->slots[i];
+        }
+    }
+    return lowest;
+}
+
+/**
+ * Update the length of the component image confirmed written to flash and save a checkpoint when due.
+ * 
+ * @param flash_mgr The flash manager for a PLDM FWUP.
+ * @param update_info Update information retained by FD.
+ * @param comp_hash The running hash of the component image.
+ * 
+ * @return 0 on success or an error code.
+*/
+static int update_transfer_progress(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    uint32_t comp_addr = flash_mgr->comp_regions[update_info->current_comp_num].start_addr;
+    uint32_t flushed = update_info->write_buffer.flushed;
+
+    if (flushed > comp_addr + update_info->current_comp_img_confirmed) {
+        update_info->current_comp_img_confirmed = flushed - comp_addr;
+        if (update_info->current_comp_img_confirmed > update_info->current_comp_img_size) {
+            update_info->current_comp_img_confirmed = update_info->current_comp_img_size;
+        }
+    }
+
+    /* Save the transfer progress periodically. Once the whole image is written, TransferComplete clears it. */
+    if (update_info->current_comp_img_confirmed >= update_info->next_checkpoint &&
+        update_info->current_comp_img_confirmed < update_info->current_comp_img_size) {
+        update_info->next_checkpoint = update_info->current_comp_img_confirmed + PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL;
+        return save_fd_checkpoint(flash_mgr, update_info, comp_hash);
+    }
+
+    return 0;
+}
+
+/**
+ * Mark a transfer slot to be requested again. The slot keeps its place in offset order until the request is issued.
+ * 
+ * @param window The transfer window containing the slot.
+ * @param slot The slot to request again.
+ * 
+ * @return 0 if the slot will be requested again or an error code if it has been retried too many times.
+*/
+static int retry_transfer_slot(struct pldm_fwup_fd_transfer_window *window, struct pldm_fwup_fd_transfer_slot *slot)
+{
+    if (slot->retries >= PLDM_FWUP_PROTOCOL_MAX_TRANSFER_RETRIES) {
+        return CMD_HANDLER_PLDM_PROTOCOL_ERROR;
+    }
+
+    slot->retry = 1;
+    slot->received = 0;
+    slot->retries++;
+    window->outstanding--;
+    window->retries++;
+
+    return 0;
+}
+
+/**
+ * Stage firmware data for a transfer slot to be written to the flash region of the current component and release
+ * the slot. If less data was received than was requested, the slot is kept to request the rest of its range again.
+ * 
+ * @param window The transfer window containing the slot.
+ * @param slot The slot the data was requested with.
+ * @param flash_mgr The flash manager for a PLDM FWUP.
+ * @param update_info Update information retained by FD.
+ * @param comp_hash The running hash of the component image.
+ * @param data The firmware data to write.
+ * @param length The length of the firmware data.
+ * 
+ * @return 0 on success or an error code.
+*/
+static int commit_transfer_slot(struct pldm_fwup_fd_transfer_window *window, struct pldm_fwup_fd_transfer_slot *slot,
+    struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash, const uint8_t *data, size_t length)
+{
+    uint32_t offset = slot->req.offset;
+    bool requeued = false;
+    int status = append_write_buffer(&update_info->write_buffer, flash_mgr->flash,
+        flash_mgr->comp_regions[update_info->current_comp_num].start_addr + offset, data, length);
+
+    if ((status == 0) && (length < slot->req.length)) {
+        /* Nothing after the data that was received can be written until the rest of the range arrives. */
+        slot->req.offset += length;
+        slot->req.length -= length;
+        status = retry_transfer_slot(window, slot);
+        requeued = (status == 0);
+    }
+
+    if (!requeued) {
+        slot->in_use = 0;
+        slot->received = 0;
+        window->outstanding--;
+    }
+
+    if (status != 0) {
+        return status;
+    }
+
+    update_comp_hash(comp_hash, offset, data, length, update_info->current_comp_img_size);
+
+    return update_transfer_progress(flash_mgr, update_info, comp_hash);
+}
+
+/**
+ * Write any firmware data staged for the current component to flash.
+ * 
+ * @param flash_mgr The flash manager for a PLDM FWUP.
+ * @param update_info Update information retained by FD.
+ * @param comp_hash The running hash of the component image.
+ * 
+ * @return 0 on success or an error code.
+*/
+static int flush_transfer_data(struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_update_info *update_info,
+    struct pldm_fwup_fd_comp_hash *comp_hash)
+{
+    int status;
+
+    if (update_info->write_buffer.length == 0) {
+        return 0;
+    }
+
+    status = flush_write_buffer(&update_info->write_buffer, flash_mgr->flash);
+    if (status != 0) {
+        return status;
+    }
+
+    return update_transfer_progress(flash_mgr, update_info, comp_hash);
+}
+
 /*******************
  * FD Inventory commands
  *******************/
@@ -207,6 +355,11 @@ int pldm_fwup_process_request_update_request(struct pldm_fwup_fd_state *state,
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
+    /* Responses received out of order are buffered, so the FD can never request more than it can buffer. */
+    if (max_transfer_size > PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE) {
+        max_transfer_size = PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE;
+    }
+
     update_info->num_components = num_of_comp;
     update_info->max_transfer_size = max_transfer_size;
     update_info->max_outstanding_transfer_req = max_outstanding_transfer_req;
@@ -597,16 +750,20 @@ exit:;
 * @param fwup_state - Variable state context for a PLDM FWUP.
 * @param update_info - Update information retained by FD.
 * @param comp_entries - Component table. 
+* @param flash_mgr - The flash manager for a PLDM FWUP.
+* @param comp_hash - The running hash of the component image.
 * @param request The request data to process.  This will be updated to contain a response.
 *
 * @return 0 if the request was successfully processed and a request was generated or an error code.
 *
 * @note For AMI, not every component response code is handled since some depend on the external state/status of Cerberus. Also the FD enabled update options flags is simply set to
-*       what the UA requested without any additional checks, configuration, etc. The time before RequestFirmwareData field can be changed via the platform config. 
+*       what the UA requested without any additional checks, configuration, etc. The time before RequestFirmwareData field is the
+*       estimated time to erase the flash the first window of requests will be written to, limited by the platform config.
+*       If a checkpoint was saved for the same component of the same component image set, the transfer resumes from the checkpoint.
 */
 int pldm_fwup_process_update_component_request(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_protocol_component_entry *comp_entries, 
-    struct cmd_interface_msg *request)
+    struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *request)
 {
     struct pldm_msg *rq = (struct pldm_msg *)(request->data + PLDM_MCTP_BINDING_MSG_OFFSET);
     size_t rq_payload_length = request->length - PLDM_MCTP_BINDING_MSG_OVERHEAD;
@@ -633,6 +790,8 @@ int pldm_fwup_process_update_component_request(struct pldm_fwup_fd_state *state,
 	bitfield32_t update_option_flags_enabled;
     update_option_flags_enabled.value = update_option_flags.value;
 	uint16_t time_before_req_fw_data = PLDM_FWUP_PROTOCOL_TIME_BERFORE_REQ_FW_DATA;
+    uint32_t erase_length;
+    uint32_t erase_time;
     static uint8_t instance_id = 1;
     if (instance_id >= PLDM_INSTANCE_MAX) {
         instance_id = 1;
@@ -676,6 +835,40 @@ int pldm_fwup_process_update_component_request(struct pldm_fwup_fd_state *state,
     update_info->current_comp_img_size = comp_image_size;
     update_info->current_comp_update_option_flags = update_option_flags_enabled;
     update_info->current_comp_num = comp_num;
+    update_info->current_comp_comparison_stamp = comp_comparison_stamp;
+    reset_transfer_window(&update_info->transfer_window, update_info->max_outstanding_transfer_req);
+    start_comp_hash(comp_hash);
+
+    /* A checkpoint that can't be read leaves the transfer starting from the beginning of the image. */
+    update_info->current_comp_img_offset = 0;
+    update_info->current_comp_img_confirmed = 0;
+    update_info->next_checkpoint = PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL;
+    if (comp_compatibility_resp == PLDM_CCR_COMP_CAN_BE_UPDATED) {
+        resume_fd_checkpoint(flash_mgr, update_info, comp_hash);
+        status = reset_write_buffer(&update_info->write_buffer, flash_mgr->flash,
+            flash_mgr->comp_regions[comp_num].start_addr + update_info->current_comp_img_confirmed);
+        if (status != 0) {
+            return status;
+        }
+
+        /* Erase the rest of the component region in the background, and only ask the UA to wait for the sectors the
+         * first window of requests will be written to. */
+        erase_length = comp_image_size;
+        if (erase_length > flash_mgr->comp_regions[comp_num].length) {
+            erase_length = flash_mgr->comp_regions[comp_num].length;
+        }
+        start_write_buffer_pre_erase(&update_info->write_buffer,
+            flash_mgr->comp_regions[comp_num].start_addr + erase_length);
+
+        erase_time = get_write_buffer_pre_erase_time(&update_info->write_buffer,
+            update_info->write_buffer.flushed +
+            (update_info->max_transfer_size * update_info->transfer_window.size));
+        erase_time = (erase_time + 999) / 1000;
+        if (erase_time < time_before_req_fw_data) {
+            time_before_req_fw_data = erase_time;
+        }
+    }
+    update_info->time_before_req_fw_data = time_before_req_fw_data;
 
 
 exit:;
@@ -710,6 +903,10 @@ exit:;
 * @param buf_len The buffer length.
 *
 * @return 0 if the request was successfully generated or an error code.
+*
+* @note The request is tracked in a free slot of the transfer window so the response can be matched back to its
+*       offset. If every slot in the window is outstanding the request is not generated. A request the UA asked to be
+*       retried is issued again before new data is requested.
 */
 int pldm_fwup_generate_request_firmware_data_request(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, uint8_t *buffer, size_t buf_len)
@@ -720,8 +917,41 @@ int pldm_fwup_generate_request_firmware_data_request(struct pldm_fwup_fd_state *
     }
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
-    uint32_t offset = update_info->current_comp_img_offset;
-    uint32_t length = update_info->max_transfer_size;
+    struct pldm_fwup_fd_transfer_window *window = &update_info->transfer_window;
+    struct pldm_fwup_fd_transfer_slot *slot = NULL;
+    uint8_t window_size = (window->size != 0) ? window->size : 1;
+    int i;
+
+    if (window->outstanding >= window_size) {
+        return CMD_HANDLER_PLDM_TRANSFER_WINDOW_FULL;
+    }
+    /* Requests the UA asked to be retried are issued again before any new data is requested. */
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ && window->retries > 0; i++) {
+        if (window->slots[i].in_use && window->slots[i].retry) {
+            slot = &window->slots[i];
+            break;
+        }
+    }
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ && slot == NULL; i++) {
+        if (!window->slots[i].in_use) {
+            slot = &window->slots[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        return CMD_HANDLER_PLDM_TRANSFER_WINDOW_FULL;
+    }
+
+    uint32_t offset;
+    uint32_t length;
+
+    if (slot->retry) {
+        offset = slot->req.offset;
+        length = slot->req.length;
+    } else {
+        offset = update_info->current_comp_img_offset;
+        length = get_transfer_size(update_info);
+    }
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
     size_t rq_payload_length = sizeof (struct pldm_request_firmware_data_req);
@@ -732,6 +962,20 @@ int pldm_fwup_generate_request_firmware_data_request(struct pldm_fwup_fd_state *
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
+    if (slot->retry) {
+        slot->retry = 0;
+        window->retries--;
+        update_info->last_request_length = 0;
+    } else {
+        slot->req.offset = offset;
+        slot->req.length = length;
+        slot->retries = 0;
+        update_info->last_request_length = length;
+    }
+    slot->instance_id = instance_id;
+    slot->in_use = 1;
+    slot->received = 0;
+    window->outstanding++;
 
     switch_state(state, PLDM_FD_STATE_DOWNLOAD);
     state->previous_cmd = PLDM_REQUEST_FIRMWARE_DATA;
@@ -745,13 +989,20 @@ int pldm_fwup_generate_request_firmware_data_request(struct pldm_fwup_fd_state *
 * @param state - Variable context for a PLDM FWUP.
 * @param update_info - Update information retained by FD.
 * @param flash_mgr - The flash manager for a PLDM FWUP.
+* @param comp_hash - The running hash of the component image.
 * @param response The response data to process.
 *
 * @return 0 if the response was successfully processed or an error code.
+*
+* @note Firmware data is written to flash in offset order. A response for the lowest outstanding offset is written
+*       directly, while any other response is buffered in its transfer slot until all lower offsets have been written.
+*       Data is added to the running hash of the component image as it is written. A failed response, or the part of
+*       the range missing from a short response, is requested again a limited number of times. The length of new
+*       requests is tuned from the measured throughput and from any requests the UA asks to be retried.
 */
 int pldm_fwup_process_request_firmware_data_response(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr, 
-    struct cmd_interface_msg *response)
+    struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *response)
 {
     if (state->previous_cmd != PLDM_REQUEST_FIRMWARE_DATA) {
         return CMD_HANDLER_PLDM_OPERATION_NOT_EXPECTED;
@@ -766,38 +1017,143 @@ int pldm_fwup_process_request_firmware_data_response(struct pldm_fwup_fd_state *
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
-    state->previous_completion_code = completion_code;
+    struct pldm_fwup_fd_transfer_window *window = &update_info->transfer_window;
+    struct pldm_fwup_fd_transfer_slot *slot = NULL;
+    int i;
+
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ; i++) {
+        if (window->slots[i].in_use && !window->slots[i].received && !window->slots[i].retry &&
+            window->slots[i].instance_id == rsp->hdr.instance_id) {
+            slot = &window->slots[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        return CMD_HANDLER_PLDM_OPERATION_NOT_EXPECTED;
+    }
+
     response->length = 0;
     switch_state(state, PLDM_FD_STATE_DOWNLOAD);
     if (completion_code != PLDM_SUCCESS) {
+        /* The range is requested again so no part of the image is skipped. Only once the retries for the slot are
+         * used up is the failure reported, which ends the update. */
+        if (retry_transfer_slot(window, slot) != 0) {
+            slot->in_use = 0;
+            window->outstanding--;
+            state->previous_completion_code = completion_code;
+            return 0;
+        }
+
+        /* New requests use a smaller length when the UA asks for a retry. */
+        if (completion_code == PLDM_FWUP_RETRY_REQUEST_FW_DATA) {
+            retry_transfer_tuning(&update_info->transfer_tuning);
+        }
+        state->previous_completion_code = PLDM_SUCCESS;
         return 0;
     }
 
-    status = flash_mgr->flash->write(flash_mgr->flash, 
-        flash_mgr->comp_regions[update_info->current_comp_num].start_addr + update_info->current_comp_img_offset,
-        rsp->payload + 1, rsp_payload_length - sizeof (completion_code));
-    if (ROT_IS_ERROR(status)) {
+    state->previous_completion_code = completion_code;
+
+    size_t data_len = rsp_payload_length - sizeof (completion_code);
+    if (data_len > slot->req.length) {
+        data_len = slot->req.length;
+    }
+    update_transfer_tuning(&update_info->transfer_tuning, data_len);
+
+    if (slot != find_lowest_transfer_slot(window)) {
+        memcpy(slot->data, rsp->payload + 1, data_len);
+        slot->data_len = data_len;
+        slot->received = 1;
+        return 0;
+    }
+
+    status = commit_transfer_slot(window, slot, flash_mgr, update_info, comp_hash, rsp->payload + 1, data_len);
+    if (status != 0) {
         return status;
-    } else {
-        status = 0;
     }
 
-    return status;
+    /* Commit any buffered responses that are now next in offset order. */
+    while ((slot = find_lowest_transfer_slot(window)) != NULL && slot->received) {
+        status = commit_transfer_slot(window, slot, flash_mgr, update_info, comp_hash, slot->data, slot->data_len);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
+/**
+* Copy the unchanged data at the current offset of the component image from the active image instead of requesting it
+* with RequestFirmwareData.
+*
+* @param state - Variable context for a PLDM FWUP.
+* @param update_info - Update information retained by FD.
+* @param flash_mgr - The flash manager for a PLDM FWUP.
+* @param comp_hash - The running hash of the component image.
+* @param max_length - The maximum length of data to copy. The rest of an unchanged run is copied by later calls.
+*
+* @return 0 if the data was copied or an error code.
+*
+* @note All data before the current offset must already be committed, so no requests can be outstanding. The copied
+*       data is added to the running hash and counts towards the transfer progress just like data received from the UA.
+*/
+int pldm_fwup_copy_unchanged_firmware_data(struct pldm_fwup_fd_state *state,
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, uint32_t max_length)
+{
+    uint32_t offset = update_info->current_comp_img_offset;
+    uint16_t comp_num = update_info->current_comp_num;
+    uint32_t dest_addr;
+    uint32_t end;
+    int status;
+
+    if (offset >= update_info->current_comp_img_size || pldm_fwup_delta_is_changed(&update_info->delta, offset) ||
+        update_info->transfer_window.outstanding != 0 || update_info->transfer_window.retries != 0) {
+        return CMD_HANDLER_PLDM_OPERATION_NOT_EXPECTED;
+    }
+
+    end = pldm_fwup_delta_get_run_end(&update_info->delta, offset, update_info->current_comp_img_size);
+    if ((end - offset) > max_length) {
+        end = offset + max_length;
+    }
+
+    dest_addr = flash_mgr->comp_regions[comp_num].start_addr + offset;
+
+    status = copy_write_buffer(&update_info->write_buffer, flash_mgr->flash, dest_addr,
+        flash_mgr->active_comp_regions[comp_num].start_addr + offset, end - offset);
+    if (status != 0) {
+        return status;
+    }
+
+    update_comp_hash_from_flash(comp_hash, flash_mgr->flash, dest_addr, offset, end - offset,
+        update_info->current_comp_img_size);
+    update_info->current_comp_img_offset = end;
+    switch_state(state, PLDM_FD_STATE_DOWNLOAD);
+
+    return update_transfer_progress(flash_mgr, update_info, comp_hash);
 }
 
 /**
 * Generate a TransferComplete request.
 *
 * @param state - Variable context for a PLDM FWUP.
+* @param update_info - Update information retained by FD.
+* @param flash_mgr - The flash manager for a PLDM FWUP.
+* @param comp_hash - The running hash of the component image.
 * @param buffer The buffer to contain the request data.
 * @param buf_len The buffer length.
 *
 * @return 0 if the request was successfully generated or an error code.
 *
 * @note For AMI, the transfer result is based on what the last completion code received during RequestFirmwareData was set to. 
-*       Checks for all transfer results should be implemented based on specific needs. 
+*       Checks for all transfer results should be implemented based on specific needs. On a successful transfer the digest of
+*       the component image is completed so it is available during the Verify state. If the digest can't be calculated, the
+*       digest length is left at 0.
 */
-int pldm_fwup_generate_transfer_complete_request(struct pldm_fwup_fd_state *state, uint8_t *buffer, size_t buf_len)
+int pldm_fwup_generate_transfer_complete_request(struct pldm_fwup_fd_state *state, 
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, uint8_t *buffer, size_t buf_len)
 {
     static uint8_t instance_id = 1;
     if (instance_id >= PLDM_INSTANCE_MAX) {
@@ -806,11 +1162,17 @@ int pldm_fwup_generate_transfer_complete_request(struct pldm_fwup_fd_state *stat
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     uint8_t transfer_result = 0;
-    if (state->previous_completion_code != 0) {
+    if (flush_transfer_data(flash_mgr, update_info, comp_hash) != 0) {
+        transfer_result = PLDM_FWUP_FD_GENERIC_TRANSFER_ERROR;
+        switch_state(state, PLDM_FD_STATE_DOWNLOAD);
+    }
+    else if (state->previous_completion_code != 0) {
         transfer_result = PLDM_FWUP_FD_GENERIC_TRANSFER_ERROR;
         switch_state(state, PLDM_FD_STATE_DOWNLOAD);
     } else {
         transfer_result = PLDM_FWUP_TRANSFER_SUCCESS;
+        finish_comp_hash(comp_hash, flash_mgr, update_info->current_comp_num, update_info->current_comp_img_size);
+        clear_fd_checkpoint(flash_mgr);
         switch_state(state, PLDM_FD_STATE_VERIFY);
     }
 
@@ -870,6 +1232,7 @@ int pldm_fwup_process_transfer_complete_response(struct pldm_fwup_fd_state *stat
 * @return 0 if the request was successfully generated or an error code.
 *
 * @note For AMI, this is skeleton code. Verification of the requested firmware image is left up to the AMI team and their specific requirements. 
+*       If a hash engine was configured for the FD, the digest of the downloaded image is available in the component hash context.
 * 
 */
 int pldm_fwup_generate_verify_complete_request(struct pldm_fwup_fd_state *state, uint8_t *buffer, size_t buf_len)
@@ -1214,9 +1577,8 @@ int pldm_fwup_process_get_status_request(struct pldm_fwup_fd_state *state,
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
-    state->previous_completion_code = completion_code;
-    state->previous_cmd = PLDM_GET_STATUS;
-    switch_state(state, state->current_state);
+    /* GetStatus can be received at any point of an update, so it doesn't change the state used to sequence the
+     * other commands. */
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
     instance_id += 1;
     return status;
@@ -1227,20 +1589,31 @@ int pldm_fwup_process_get_status_request(struct pldm_fwup_fd_state *state,
  * 
  * @param state - Variable context for a PLDM FWUP.
  * @param update_info - Update information retained by FD.
+ * @param flash_mgr - The flash manager for a PLDM FWUP.
+ * @param comp_hash - The running hash of the component image.
  * @param request - The request data to process. This will be updated to contain a response
  * 
  * @return 0 on success or an error code.
  * 
  * @note For AMI, the busy in background completion code is not checked and will be left to the AMI team. 
+ *       Firmware data that was already received is written to flash so a later transfer of the same component can
+ *       resume from the last checkpoint.
 */
 int pldm_fwup_process_cancel_update_component_request(struct pldm_fwup_fd_state *state, 
-    struct pldm_fwup_fd_update_info *update_info, struct cmd_interface_msg *request)
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *request)
 {
+    flush_transfer_data(flash_mgr, update_info, comp_hash);
+    update_info->write_buffer.length = 0;
+
     switch_state(state, PLDM_FD_STATE_READY_XFER);
     update_info->current_comp_num = 0;
     update_info->current_comp_img_size = 0;
     update_info->current_comp_img_offset = 0;
     update_info->current_comp_update_option_flags.value = 0;
+    reset_transfer_window(&update_info->transfer_window, update_info->max_outstanding_transfer_req);
+    cancel_comp_hash(comp_hash);
+    comp_hash->digest_len = 0;
 
     struct pldm_msg *rsp = (struct pldm_msg *)(request->data + PLDM_MCTP_BINDING_MSG_OFFSET);
 
@@ -1274,6 +1647,7 @@ int pldm_fwup_process_cancel_update_component_request(struct pldm_fwup_fd_state
  * @param state - Variable context for a PLDM FWUP.
  * @param update_info - Update information retained by FD.
  * @param flash_mgr - The flash manager for a PLDM FWUP.
+ * @param comp_hash - The running hash of the component image.
  * @param request - The request data to process. This will be updated to contain a response
  * 
  * @return 0 on success or an error code.
@@ -1282,9 +1656,14 @@ int pldm_fwup_process_cancel_update_component_request(struct pldm_fwup_fd_state
  *       The assignment of the non functioning component indication and bitmap and the busy in background completion code is left to the AMI team.
 */
 int pldm_fwup_process_cancel_update_request(struct pldm_fwup_fd_state *state, 
-    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr, struct cmd_interface_msg *request)
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *request)
 {
+    flush_transfer_data(flash_mgr, update_info, comp_hash);
     switch_state(state, PLDM_FD_STATE_IDLE);
+    cancel_comp_hash(comp_hash);
+    comp_hash->digest_len = 0;
+    clear_fd_checkpoint(flash_mgr);
     memset(update_info->comp_entries, 0, update_info->num_components * sizeof (struct pldm_fwup_protocol_component_entry));
     memset(update_info, 0, sizeof (struct pldm_fwup_fd_update_info));
     flash_mgr->package_data_size = 0;
@@ -1318,6 +1697,26 @@ int pldm_fwup_process_cancel_update_request(struct pldm_fwup_fd_state *state,
     return status;
 }
 
+/*******************
+ * UA Helper functions
+ *******************/
+
+/**
+ * Get the instance ID to use for the next request issued by the UA. Each UA manager has its own instance ID
+ * sequence so that several updates can be run at the same time.
+ * 
+ * @param state - Variable context for the UA.
+ * 
+ * @return The instance ID for the request.
+*/
+static uint8_t ua_next_instance_id(struct pldm_fwup_ua_state *state)
+{
+    if (state->instance_id == 0 || state->instance_id >= PLDM_INSTANCE_MAX) {
+        state->instance_id = 1;
+    }
+    return state->instance_id++;
+}
+
 /*******************
  * UA Inventory commands
  *******************/
@@ -1334,10 +1733,7 @@ int pldm_fwup_process_cancel_update_request(struct pldm_fwup_fd_state *state,
 int pldm_fwup_generate_query_device_identifiers_request(struct pldm_fwup_ua_state *state, uint8_t *buffer, size_t buf_len)
 {
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -1350,7 +1746,6 @@ int pldm_fwup_generate_query_device_identifiers_request(struct pldm_fwup_ua_stat
     }
 
     state->previous_cmd = PLDM_QUERY_DEVICE_IDENTIFIERS;
-    instance_id += 1;
     return PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
@@ -1425,10 +1820,7 @@ int pldm_fwup_process_query_device_identifiers_response(struct pldm_fwup_ua_stat
 int pldm_fwup_generate_get_firmware_parameters_request(struct pldm_fwup_ua_state *state, uint8_t *buffer, size_t buf_len)
 {   
 
-    static uint8_t instance_id;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -1441,7 +1833,6 @@ int pldm_fwup_generate_get_firmware_parameters_request(struct pldm_fwup_ua_state
     }
 
     state->previous_cmd = PLDM_GET_FIRMWARE_PARAMETERS;
-    instance_id += 1;
     return PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
@@ -1537,10 +1928,7 @@ int pldm_fwup_generate_request_update_request(struct pldm_fwup_ua_manager *ua_mg
     uint8_t *buffer, size_t buf_len)
 {
     
-    static uint8_t instance_id;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(&ua_mgr->state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -1566,7 +1954,6 @@ int pldm_fwup_generate_request_update_request(struct pldm_fwup_ua_manager *ua_mg
     }
 
     ua_mgr->state.previous_cmd = PLDM_REQUEST_UPDATE;
-    instance_id += 1;
     return rq_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
@@ -1641,10 +2028,7 @@ int pldm_fwup_process_get_package_data_request(struct pldm_fwup_ua_state *state,
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = rq->hdr.instance_id;
     uint8_t completion_code = PLDM_SUCCESS;
     uint8_t transfer_flag = 0;
     struct variable_field portion_of_package_data;
@@ -1714,7 +2098,6 @@ exit:;
     get_cmd_state->next_data_transfer_handle = next_data_transfer_handle;
     get_cmd_state->transfer_flag = transfer_flag;
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
-    instance_id += 1;
     return status;
 }
 
@@ -1732,10 +2115,7 @@ int pldm_fwup_generate_get_device_meta_data_request(struct pldm_fwup_ua_state *s
     struct pldm_fwup_protocol_multipart_transfer *get_cmd_state,
     uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     uint32_t data_transfer_handle = get_cmd_state->data_transfer_handle;
@@ -1750,7 +2130,6 @@ int pldm_fwup_generate_get_device_meta_data_request(struct pldm_fwup_ua_state *s
     }
 
     state->previous_cmd = PLDM_GET_DEVICE_METADATA;
-    instance_id += 1;
     return PLDM_MCTP_BINDING_MSG_OVERHEAD  + rq_payload_length;
     
 }
@@ -1825,10 +2204,7 @@ int pldm_fwup_process_get_device_meta_data_response(struct pldm_fwup_ua_state *s
 int pldm_fwup_generate_pass_component_table_request(struct pldm_fwup_ua_manager *ua_mgr,
     uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(&ua_mgr->state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     uint8_t comp_num = ua_mgr->current_comp_num;
@@ -1874,7 +2250,6 @@ int pldm_fwup_generate_pass_component_table_request(struct pldm_fwup_ua_manager
     }
 
     ua_mgr->state.previous_cmd = PLDM_PASS_COMPONENT_TABLE;
-    instance_id += 1;
     comp_num += 1;
     return rq_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
@@ -1940,10 +2315,7 @@ int pldm_fwup_generate_update_component_request(struct pldm_fwup_ua_state *state
     uint16_t current_comp_num, struct pldm_fwup_fup_component_image_entry *comp_img_entries,
     struct pldm_fwup_protocol_firmware_parameters *rec_fw_parameters, uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     uint16_t comp_classification = comp_img_entries[current_comp_num].comp_classification;
@@ -1978,7 +2350,6 @@ int pldm_fwup_generate_update_component_request(struct pldm_fwup_ua_state *state
     }
     
     state->previous_cmd = PLDM_UPDATE_COMPONENT;
-    instance_id += 1;
     return rq_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
@@ -2032,6 +2403,48 @@ int pldm_fwup_process_update_component_response(struct pldm_fwup_ua_state *state
     return status;
 }
 
+/**
+ * Read firmware data from flash directly into the payload of the packets that will carry a
+ * RequestFirmwareData response, splitting the read at each packet boundary.
+ *
+ * @param flash The flash containing the firmware data.
+ * @param addr The flash address of the firmware data.
+ * @param length The length of the firmware data.
+ * @param request The request that will be updated with the response.
+ * @param msg_offset The offset of the firmware data within the response message.
+ *
+ * @return 0 on success or an error code.
+*/
+static int read_firmware_data_into_packets(const struct flash *flash, uint32_t addr, uint32_t length,
+    struct cmd_interface_msg *request, size_t msg_offset)
+{
+    uint8_t *payload;
+    size_t payload_len;
+    int status;
+
+    while (length > 0) {
+        payload = cmd_interface_msg_get_packet_payload(request, msg_offset, &payload_len);
+        if (payload == NULL) {
+            return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
+        }
+
+        if (payload_len > length) {
+            payload_len = length;
+        }
+
+        status = flash->read(flash, addr, payload, payload_len);
+        if (ROT_IS_ERROR(status)) {
+            return status;
+        }
+
+        addr += payload_len;
+        msg_offset += payload_len;
+        length -= payload_len;
+    }
+
+    return 0;
+}
+
 /**
 * Process a RequestFirmwareData request and generate a response.
 *
@@ -2039,7 +2452,9 @@ int pldm_fwup_process_update_component_response(struct pldm_fwup_ua_state *state
 * @param current_comp_num - Current component to be updated. 
 * @param comp_img_entries - Component image information entries from the FUP.
 * @param flash_mgr - The flash manager for a PLDM FWUP.
-* @param request The request data to process.  This will be updated to contain a response.
+* @param request The request data to process.  This will be updated to contain a response.  If the
+* transport provides a packet buffer that can hold the response, the firmware data is read from flash
+* directly into the response packets.
 *
 * @return 0 if the request was successfully processed and a request was generated or an error code.
 *
@@ -2061,10 +2476,8 @@ int pldm_fwup_process_request_firmware_data_request(struct pldm_fwup_ua_state *s
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    /* The FD may have several requests outstanding and matches each response by instance ID. */
+    uint8_t instance_id = rq->hdr.instance_id;
     uint8_t completion_code = PLDM_SUCCESS;
 
     struct pldm_msg *rsp = (struct pldm_msg *)(request->data + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -2086,13 +2499,35 @@ int pldm_fwup_process_request_firmware_data_request(struct pldm_fwup_ua_state *s
         state->previous_cmd == PLDM_CANCEL_UPDATE) {
         completion_code = PLDM_FWUP_CANCEL_PENDING;
     } else {
-        status = flash_mgr->flash->read(flash_mgr->flash, 
-            flash_mgr->comp_regions[current_comp_num].start_addr + offset, rsp->payload + 1, length);
-        if (ROT_IS_ERROR(status)) {
-            return status;
+        uint32_t addr = flash_mgr->comp_regions[current_comp_num].start_addr + offset;
+        size_t data_offset = PLDM_MCTP_BINDING_MSG_OVERHEAD + rsp_payload_length;
+        uint8_t *pkt_rsp = NULL;
+        size_t pkt_rsp_len = 0;
+
+        /* Only use the packet buffer when the whole response fits and the response header is contiguous in the
+         * first packet. */
+        if ((length > 0) &&
+            (cmd_interface_msg_get_packet_payload(request, data_offset + length - 1, &pkt_rsp_len) != NULL)) {
+            pkt_rsp = cmd_interface_msg_get_packet_payload(request, 0, &pkt_rsp_len);
+        }
+
+        if ((pkt_rsp != NULL) && (pkt_rsp_len >= data_offset)) {
+            status = read_firmware_data_into_packets(flash_mgr->flash, addr, length, request, data_offset);
+            if (status != 0) {
+                return status;
+            }
+
+            pkt_rsp[0] = request->data[0];
+            rsp = (struct pldm_msg *)(pkt_rsp + PLDM_MCTP_BINDING_MSG_OFFSET);
+            request->packetized = true;
         } else {
-            rsp_payload_length += length;
+            status = flash_mgr->flash->read(flash_mgr->flash, addr, rsp->payload + 1, length);
+            if (ROT_IS_ERROR(status)) {
+                return status;
+            }
         }
+
+        rsp_payload_length += length;
     }
 
     status = encode_request_firmware_data_resp(instance_id, completion_code, rsp, rsp_payload_length);
@@ -2103,7 +2538,6 @@ int pldm_fwup_process_request_firmware_data_request(struct pldm_fwup_ua_state *s
     state->previous_cmd = PLDM_REQUEST_FIRMWARE_DATA;
     state->previous_completion_code = completion_code;
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
-    instance_id += 1;
     return status;
 }
 
@@ -2132,10 +2566,7 @@ int pldm_fwup_process_transfer_complete_request(struct pldm_fwup_ua_state *state
 
     update_info->transfer_result = transfer_result;
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = rq->hdr.instance_id;
     uint8_t completion_code = PLDM_SUCCESS;
     if (state->previous_cmd != PLDM_REQUEST_FIRMWARE_DATA) {
         completion_code = PLDM_FWUP_COMMAND_NOT_EXPECTED;
@@ -2152,7 +2583,6 @@ int pldm_fwup_process_transfer_complete_request(struct pldm_fwup_ua_state *state
     state->previous_cmd = PLDM_TRANSFER_COMPLETE;
     state->previous_completion_code = completion_code;
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
-    instance_id += 1;
     return status;
 
 }
@@ -2181,10 +2611,7 @@ int pldm_fwup_process_verify_complete_request(struct pldm_fwup_ua_state *state,
 
     update_info->verify_result = verify_result;
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = rq->hdr.instance_id;
     uint8_t completion_code = PLDM_SUCCESS;
     if (state->previous_cmd != PLDM_TRANSFER_COMPLETE) {
         completion_code = PLDM_FWUP_COMMAND_NOT_EXPECTED;
@@ -2201,7 +2628,6 @@ int pldm_fwup_process_verify_complete_request(struct pldm_fwup_ua_state *state,
     state->previous_cmd = PLDM_VERIFY_COMPLETE;
     state->previous_completion_code = completion_code;
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
-    instance_id += 1;
     return status;
 }
 
@@ -2231,10 +2657,7 @@ int pldm_fwup_process_apply_complete_request(struct pldm_fwup_ua_state *state,
     update_info->apply_result = apply_result;
     update_info->comp_activation_methods_modification = comp_activation_methods_modification.value;
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = rq->hdr.instance_id;
     uint8_t completion_code = PLDM_SUCCESS;
     if (state->previous_cmd != PLDM_VERIFY_COMPLETE) {
         completion_code = PLDM_FWUP_COMMAND_NOT_EXPECTED;
@@ -2251,7 +2674,6 @@ int pldm_fwup_process_apply_complete_request(struct pldm_fwup_ua_state *state,
     state->previous_cmd = PLDM_APPLY_COMPLETE;
     state->previous_completion_code = completion_code;
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
-    instance_id += 1;
     return status;
 }
 
@@ -2280,10 +2702,7 @@ int pldm_fwup_process_get_meta_data_request(struct pldm_fwup_ua_state *state,
         return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
     }
 
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = rq->hdr.instance_id;
     uint8_t completion_code = PLDM_SUCCESS;
     uint8_t transfer_flag = 0;
     struct variable_field portion_of_meta_data;
@@ -2349,7 +2768,6 @@ exit:;
     get_cmd_state->next_data_transfer_handle = next_data_transfer_handle;
     get_cmd_state->transfer_flag = transfer_flag;
     request->length = rsp_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
-    instance_id += 1;
     return status;
 }
 
@@ -2366,10 +2784,7 @@ exit:;
 */
 int pldm_fwup_generate_activate_firmware_request(struct pldm_fwup_ua_state *state, uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     bool8_t self_contained_activation_req = 1;
@@ -2383,7 +2798,6 @@ int pldm_fwup_generate_activate_firmware_request(struct pldm_fwup_ua_state *stat
     }
     
     state->previous_cmd = PLDM_ACTIVATE_FIRMWARE;
-    instance_id += 1;
     return rq_payload_length + PLDM_MCTP_BINDING_MSG_OVERHEAD;
 
 }
@@ -2436,10 +2850,7 @@ int pldm_fwup_process_activate_firmware_response(struct pldm_fwup_ua_state *stat
 */
 int pldm_fwup_generate_get_status_request(struct pldm_fwup_ua_state *state, uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -2452,7 +2863,6 @@ int pldm_fwup_generate_get_status_request(struct pldm_fwup_ua_state *state, uint
     }
 
     state->previous_cmd = PLDM_GET_STATUS;
-    instance_id += 1;
     return PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
@@ -2524,10 +2934,7 @@ int pldm_fwup_process_get_status_response(struct pldm_fwup_ua_state *state, stru
 */
 int pldm_fwup_generate_cancel_update_component_request(struct pldm_fwup_ua_state *state, uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -2540,7 +2947,6 @@ int pldm_fwup_generate_cancel_update_component_request(struct pldm_fwup_ua_state
     }
 
     state->previous_cmd = PLDM_CANCEL_UPDATE_COMPONENT;
-    instance_id += 1;
     return PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
@@ -2588,10 +2994,7 @@ int pldm_fwup_process_cancel_update_component_response(struct pldm_fwup_ua_state
 */
 int pldm_fwup_generate_cancel_update_request(struct pldm_fwup_ua_state *state, uint8_t *buffer, size_t buf_len)
 {
-    static uint8_t instance_id = 1;
-    if (instance_id >= PLDM_INSTANCE_MAX) {
-        instance_id = 1;
-    }
+    uint8_t instance_id = ua_next_instance_id(state);
     buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
 
     struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
@@ -2604,7 +3007,6 @@ int pldm_fwup_generate_cancel_update_request(struct pldm_fwup_ua_state *state, u
     }
 
     state->previous_cmd = PLDM_CANCEL_UPDATE;
-    instance_id += 1;
     return PLDM_MCTP_BINDING_MSG_OVERHEAD;
 }
 
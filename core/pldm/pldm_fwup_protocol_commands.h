@@ -44,15 +44,20 @@ int pldm_fwup_process_pass_component_table_request(struct pldm_fwup_fd_state *st
 
 int pldm_fwup_process_update_component_request(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_protocol_component_entry *comp_entries, 
-    struct cmd_interface_msg *request);
+    struct pldm_fwup_flash_manager *flash_mgr, struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *request);
 
 int pldm_fwup_generate_request_firmware_data_request(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, uint8_t *buffer, size_t buf_len);
 int pldm_fwup_process_request_firmware_data_response(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr, 
-    struct cmd_interface_msg *response);
-
-int pldm_fwup_generate_transfer_complete_request(struct pldm_fwup_fd_state *state, uint8_t *buffer, size_t buf_len);
+    struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *response);
+int pldm_fwup_copy_unchanged_firmware_data(struct pldm_fwup_fd_state *state,
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, uint32_t max_length);
+
+int pldm_fwup_generate_transfer_complete_request(struct pldm_fwup_fd_state *state, 
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, uint8_t *buffer, size_t buf_len);
 int pldm_fwup_process_transfer_complete_response(struct pldm_fwup_fd_state *state, struct cmd_interface_msg *response);
 
 int pldm_fwup_generate_verify_complete_request(struct pldm_fwup_fd_state *state, uint8_t *buffer, size_t buf_len);
@@ -75,10 +80,12 @@ int pldm_fwup_process_get_status_request(struct pldm_fwup_fd_state *state,
     struct pldm_fwup_fd_update_info *update_info, struct cmd_interface_msg *request);
 
 int pldm_fwup_process_cancel_update_component_request(struct pldm_fwup_fd_state *state, 
-    struct pldm_fwup_fd_update_info *update_info, struct cmd_interface_msg *request);
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *request);
 
 int pldm_fwup_process_cancel_update_request(struct pldm_fwup_fd_state *state, 
-    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr, struct cmd_interface_msg *request);
+    struct pldm_fwup_fd_update_info *update_info, struct pldm_fwup_flash_manager *flash_mgr,
+    struct pldm_fwup_fd_comp_hash *comp_hash, struct cmd_interface_msg *request);
 
 /*******************
  * UA Inventory commands
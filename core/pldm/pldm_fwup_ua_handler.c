@@ -0,0 +1,517 @@
+#include <string.h>
+#include "pldm_fwup_ua_handler.h"
+#include "pldm_fwup_ua_handler_static.h"
+#include "cmd_interface_pldm.h"
+#include "pldm_fwup_protocol.h"
+#include "common/unused.h"
+
+#include "libpldm/firmware_update.h"
+
+
+/**
+ * Get the UA manager used by the firmware update handler.
+ *
+ * @param ua The UA task handler.
+ *
+ * @return The UA manager.
+ */
+static struct pldm_fwup_ua_manager* pldm_fwup_ua_handler_get_ua_manager(const struct pldm_fwup_ua_handler *ua)
+{
+    struct cmd_interface_pldm *interface = (struct cmd_interface_pldm*) ua->fwup->mctp->cmd_pldm;
+
+    return &interface->fwup_mgr->ua_mgr;
+}
+
+/**
+ * Move the update to a new step and restart the time allowed to receive the next expected message.
+ *
+ * @param ua The UA task handler.
+ * @param step The next step of the update.
+ */
+static void pldm_fwup_ua_handler_set_step(const struct pldm_fwup_ua_handler *ua, enum pldm_fwup_ua_handler_step step)
+{
+    ua->state->step = step;
+    ua->state->rsp_pending = false;
+    platform_init_timeout(ua->fwup->timeout_ms, &ua->state->timeout);
+}
+
+/**
+ * End the update that is running.  Any response still expected from the FD is no longer waited on.
+ *
+ * @param ua The UA task handler.
+ * @param status The result of the update.
+ */
+static void pldm_fwup_ua_handler_finish(const struct pldm_fwup_ua_handler *ua, int status)
+{
+    mctp_interface_cancel_requests(ua->fwup->mctp, ua->state->fd_eid);
+
+    ua->state->step = PLDM_FWUP_UA_HANDLER_STEP_IDLE;
+    ua->state->rsp_pending = false;
+    ua->state->status = status;
+}
+
+/**
+ * Delay the next execution of the handler.
+ *
+ * @param ua The UA task handler.
+ * @param ms_delay The time to wait before the handler runs again, in milliseconds.
+ */
+static void pldm_fwup_ua_handler_schedule(const struct pldm_fwup_ua_handler *ua, uint32_t ms_delay)
+{
+    ua->state->next_valid = (platform_init_timeout(ms_delay, &ua->state->next) == 0);
+}
+
+/**
+ * Receive and process a packet from the FD without waiting for one to arrive.
+ *
+ * @param ua The UA task handler.
+ *
+ * @return true if a complete PLDM message was processed.
+ */
+static bool pldm_fwup_ua_handler_receive(const struct pldm_fwup_ua_handler *ua)
+{
+    struct mctp_interface *mctp = ua->fwup->mctp;
+    int status;
+
+    /* As with the FD task handler, an empty poll is not an error.  The update fails once the expected message has not
+     * been received in time. */
+    status = cmd_channel_receive_and_process(ua->fwup->channel, mctp, 0);
+    if (status != 0 || mctp->req_buffer.length != 0) {
+        return false;
+    }
+
+    mctp_interface_reset_message_processing(mctp);
+    return MCTP_BASE_PROTOCOL_IS_PLDM_MSG(mctp->msg_type);
+}
+
+/**
+ * Send the request for the current step to the FD, if it has not been sent, and check for the response.
+ *
+ * @param ua The UA task handler.
+ * @param ua_mgr The UA manager.
+ * @param command The PLDM firmware update command to send.
+ *
+ * @return 1 if the response was processed, 0 if it has not been received, or an error code.
+ */
+static int pldm_fwup_ua_handler_exchange(const struct pldm_fwup_ua_handler *ua, struct pldm_fwup_ua_manager *ua_mgr,
+    int command)
+{
+    enum mctp_interface_response_state rsp_state;
+    int status;
+
+    if (!ua->state->rsp_pending) {
+        status = pldm_fwup_handler_send_full_mctp_message(ua->fwup, command, ua->state->fd_eid, ua->state->fd_addr);
+        if (status != 0) {
+            return status;
+        }
+
+        ua->state->rsp_pending = true;
+        platform_init_timeout(ua->fwup->timeout_ms, &ua->state->timeout);
+    }
+
+    pldm_fwup_ua_handler_receive(ua);
+    status = mctp_interface_get_outstanding_requests(ua->fwup->mctp, ua->state->fd_eid, &rsp_state);
+    if (status != 0) {
+        return (status > 0) ? 0 : status;
+    }
+
+    ua->state->rsp_pending = false;
+    if (rsp_state == MCTP_INTERFACE_RESPONSE_ERROR) {
+        return MCTP_BASE_PROTOCOL_ERROR_RESPONSE;
+    }
+    else if (rsp_state == MCTP_INTERFACE_RESPONSE_FAIL) {
+        return MCTP_BASE_PROTOCOL_FAIL_RESPONSE;
+    }
+
+    status = pldm_fwup_handler_check_operation_status(0, ua_mgr->state.previous_completion_code);
+    return (status == 0) ? 1 : status;
+}
+
+/**
+ * Check the last command processed by the UA while waiting for a command from the FD.
+ *
+ * @param ua_mgr The UA manager.
+ * @param command The command that is expected.
+ *
+ * @return 1 if the expected command was processed, 0 if a different command was processed, or an error code.
+ */
+static int pldm_fwup_ua_handler_check_command(struct pldm_fwup_ua_manager *ua_mgr, int command)
+{
+    int status;
+
+    status = pldm_fwup_handler_check_operation_status(0, ua_mgr->state.previous_completion_code);
+    if (status != 0) {
+        return status;
+    }
+
+    return (ua_mgr->state.previous_cmd == (enum pldm_firmware_update_commands) command);
+}
+
+/**
+ * Move to the step following the transfer of package data.
+ *
+ * @param ua The UA task handler.
+ * @param ua_mgr The UA manager.
+ */
+static void pldm_fwup_ua_handler_finish_package_data(const struct pldm_fwup_ua_handler *ua,
+    struct pldm_fwup_ua_manager *ua_mgr)
+{
+    if (ua_mgr->update_info.fd_meta_data_len > 0) {
+        pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_DEVICE_META_DATA);
+    }
+    else {
+        ua_mgr->current_comp_num = 0;
+        pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_PASS_COMPONENT_TABLE);
+    }
+}
+
+/**
+ * Run the current step of the update.
+ *
+ * @param ua The UA task handler.
+ * @param ua_mgr The UA manager.
+ * @param progress Output indicating a message was processed or the update moved to another step.
+ *
+ * @return 0 if the step ran successfully or an error code.
+ */
+static int pldm_fwup_ua_handler_run_step(const struct pldm_fwup_ua_handler *ua, struct pldm_fwup_ua_manager *ua_mgr,
+    bool *progress)
+{
+    struct pldm_fwup_ua_handler_state *state = ua->state;
+    int status = 0;
+
+    switch (state->step) {
+        case PLDM_FWUP_UA_HANDLER_STEP_IDLE:
+            *progress = pldm_fwup_ua_handler_receive(ua);
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_QUERY_DEVICE_IDENTIFIERS:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_QUERY_DEVICE_IDENTIFIERS);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+                pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_GET_FIRMWARE_PARAMETERS);
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_GET_FIRMWARE_PARAMETERS:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_GET_FIRMWARE_PARAMETERS);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+                pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_REQUEST_UPDATE);
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_REQUEST_UPDATE:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_REQUEST_UPDATE);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+                if (ua_mgr->update_info.fd_will_send_pkg_data_cmd) {
+                    pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_GET_PACKAGE_DATA);
+                }
+                else {
+                    pldm_fwup_ua_handler_finish_package_data(ua, ua_mgr);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_GET_PACKAGE_DATA:
+            *progress = pldm_fwup_ua_handler_receive(ua);
+            if (*progress) {
+                status = pldm_fwup_ua_handler_check_command(ua_mgr, PLDM_GET_PACKAGE_DATA);
+                if (status == 1) {
+                    status = 0;
+                    if (ua_mgr->get_cmd_state.transfer_flag == PLDM_END ||
+                        ua_mgr->get_cmd_state.transfer_flag == PLDM_START_AND_END) {
+                        reset_get_cmd_state(&ua_mgr->get_cmd_state);
+                        pldm_fwup_ua_handler_finish_package_data(ua, ua_mgr);
+                    }
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_DEVICE_META_DATA:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_GET_DEVICE_METADATA);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+
+                /* The transfer operation flag returns to the first part once all of the meta data is received. */
+                if (ua_mgr->get_cmd_state.transfer_op_flag == PLDM_GET_FIRSTPART) {
+                    reset_get_cmd_state(&ua_mgr->get_cmd_state);
+                    ua_mgr->current_comp_num = 0;
+                    pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_PASS_COMPONENT_TABLE);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_PASS_COMPONENT_TABLE:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_PASS_COMPONENT_TABLE);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+
+                ua_mgr->current_comp_num++;
+                if (ua_mgr->current_comp_num >= ua_mgr->num_components) {
+                    ua_mgr->current_comp_num = 0;
+                    pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_UPDATE_COMPONENT);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_UPDATE_COMPONENT:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_UPDATE_COMPONENT);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+
+                /* The FD will not request firmware data until the time given in the request has passed. */
+                pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_START_DOWNLOAD);
+                platform_init_timeout(ua_mgr->comp_img_entries[ua_mgr->current_comp_num].time_before_req_fw_data * 1000,
+                    &state->download_start);
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_START_DOWNLOAD:
+            *progress = true;
+            if (platform_has_timeout_expired(&state->download_start) == 0) {
+                state->next = state->download_start;
+                state->next_valid = true;
+                break;
+            }
+
+            pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_DOWNLOAD);
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_DOWNLOAD:
+            /* Firmware data requests are answered as they are received until the FD reports the transfer is done. */
+            *progress = pldm_fwup_ua_handler_receive(ua);
+            if (*progress) {
+                status = pldm_fwup_ua_handler_check_command(ua_mgr, PLDM_TRANSFER_COMPLETE);
+                if (status == 1) {
+                    status = 0;
+                    pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_VERIFY_COMPLETE);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_VERIFY_COMPLETE:
+            *progress = pldm_fwup_ua_handler_receive(ua);
+            if (*progress) {
+                status = pldm_fwup_ua_handler_check_command(ua_mgr, PLDM_VERIFY_COMPLETE);
+                if (status == 1) {
+                    status = 0;
+                    pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_APPLY_COMPLETE);
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_APPLY_COMPLETE:
+            *progress = pldm_fwup_ua_handler_receive(ua);
+            if (*progress) {
+                status = pldm_fwup_ua_handler_check_command(ua_mgr, PLDM_APPLY_COMPLETE);
+                if (status == 1) {
+                    status = 0;
+
+                    ua_mgr->current_comp_num++;
+                    if (ua_mgr->current_comp_num < ua_mgr->num_components) {
+                        pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_UPDATE_COMPONENT);
+                    }
+                    else {
+                        pldm_fwup_ua_handler_set_step(ua, PLDM_FWUP_UA_HANDLER_STEP_ACTIVATE_FIRMWARE);
+                    }
+                }
+            }
+            break;
+
+        case PLDM_FWUP_UA_HANDLER_STEP_ACTIVATE_FIRMWARE:
+            status = pldm_fwup_ua_handler_exchange(ua, ua_mgr, PLDM_ACTIVATE_FIRMWARE);
+            if (status == 1) {
+                *progress = true;
+                status = 0;
+                pldm_fwup_ua_handler_finish(ua, 0);
+            }
+            break;
+
+        default:
+            status = PLDM_FWUP_HANDLER_INVALID_STATE_TRANSITION;
+            break;
+    }
+
+    return status;
+}
+
+const platform_clock* pldm_fwup_ua_handler_get_next_execution(const struct periodic_task_handler *handler)
+{
+    const struct pldm_fwup_ua_handler *ua = (const struct pldm_fwup_ua_handler*) handler;
+
+    if (ua->state->next_valid) {
+        return &ua->state->next;
+    }
+    else {
+        return NULL;
+    }
+}
+
+void pldm_fwup_ua_handler_execute(const struct periodic_task_handler *handler)
+{
+    const struct pldm_fwup_ua_handler *ua = (const struct pldm_fwup_ua_handler*) handler;
+    struct pldm_fwup_ua_handler_state *state = ua->state;
+    bool progress = false;
+    int status;
+
+    state->next_valid = false;
+
+    status = pldm_fwup_ua_handler_run_step(ua, pldm_fwup_ua_handler_get_ua_manager(ua), &progress);
+    if (status != 0) {
+        pldm_fwup_ua_handler_finish(ua, status);
+        return;
+    }
+
+    if (progress) {
+        if (!state->next_valid) {
+            platform_init_timeout(ua->fwup->timeout_ms, &state->timeout);
+        }
+        return;
+    }
+
+    if (state->step != PLDM_FWUP_UA_HANDLER_STEP_IDLE && ua->fwup->timeout_ms >= 0 &&
+        platform_has_timeout_expired(&state->timeout) == 1) {
+        pldm_fwup_ua_handler_finish(ua, PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT);
+        return;
+    }
+
+    /* Nothing was received, so give other handlers in the task a chance to run before polling again. */
+    pldm_fwup_ua_handler_schedule(ua, PLDM_FWUP_PROTOCOL_POLL_INTERVAL_MS);
+}
+
+/**
+ * Initialize a handler for running a PLDM firmware update from a periodic task.
+ *
+ * @param handler The UA task handler to initialize.
+ * @param state Variable context for the handler.  This must be uninitialized.
+ * @param fwup The firmware update handler with the command channel and MCTP instance connected to the FD.
+ *
+ * @return 0 if the handler was successfully initialized or an error code.
+ */
+int pldm_fwup_ua_handler_init(struct pldm_fwup_ua_handler *handler, struct pldm_fwup_ua_handler_state *state,
+    struct pldm_fwup_handler *fwup)
+{
+    if (handler == NULL || state == NULL || fwup == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    memset(handler, 0, sizeof (struct pldm_fwup_ua_handler));
+
+    handler->base.get_next_execution = pldm_fwup_ua_handler_get_next_execution;
+    handler->base.execute = pldm_fwup_ua_handler_execute;
+
+    handler->state = state;
+    handler->fwup = fwup;
+
+    return pldm_fwup_ua_handler_init_state(handler);
+}
+
+/**
+ * Initialize only the variable state for a UA task handler.  The rest of the handler is assumed to have already
+ * been initialized.
+ *
+ * @param handler The UA task handler that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int pldm_fwup_ua_handler_init_state(const struct pldm_fwup_ua_handler *handler)
+{
+    if (handler == NULL || handler->state == NULL || handler->fwup == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    memset(handler->state, 0, sizeof (struct pldm_fwup_ua_handler_state));
+
+    return 0;
+}
+
+/**
+ * Release the resources used by a UA task handler.
+ *
+ * @param handler The UA task handler to release.
+ */
+void pldm_fwup_ua_handler_release(const struct pldm_fwup_ua_handler *handler)
+{
+    UNUSED(handler);
+}
+
+/**
+ * Start a firmware update with Cerberus operating as the Update Agent. The FD is updated with the component images
+ * contained in the UA manager by subsequent executions of the handler.
+ *
+ * @param handler The UA task handler.
+ * @param inventory_cmds A flag indicating that inventory commands should be issued to the device being updated.
+ * @param fd_eid The endpoint ID of the firmware device to be updated.
+ * @param fd_addr The SMBus address of the firmware device to be updated.
+ *
+ * @return 0 if the update was started or an error code.
+ */
+int pldm_fwup_ua_handler_start(const struct pldm_fwup_ua_handler *handler, bool inventory_cmds, uint8_t fd_eid,
+    uint8_t fd_addr)
+{
+    struct pldm_fwup_ua_manager *ua_mgr;
+
+    if (handler == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    if (handler->fwup->mode != PLDM_FWUP_HANDLER_UA_MODE) {
+        return PLDM_FWUP_HANDLER_INCORRECT_MODE;
+    }
+
+    ua_mgr = pldm_fwup_ua_handler_get_ua_manager(handler);
+    if (ua_mgr->num_components == 0 || ua_mgr->comp_img_entries == NULL ||
+        ua_mgr->fup_comp_img_set_ver == NULL || ua_mgr->flash_mgr->device_meta_data_region.length == 0 ||
+        ua_mgr->flash_mgr->package_data_region.length == 0 || ua_mgr->flash_mgr->comp_regions == NULL ||
+        ua_mgr->flash_mgr->flash == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_UA_MANAGER_STATE;
+    }
+
+    if (handler->state->step != PLDM_FWUP_UA_HANDLER_STEP_IDLE) {
+        return PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS;
+    }
+
+    handler->state->fd_eid = fd_eid;
+    handler->state->fd_addr = fd_addr;
+    handler->state->status = PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS;
+    handler->state->next_valid = false;
+    ua_mgr->current_comp_num = 0;
+
+    if (inventory_cmds) {
+        pldm_fwup_ua_handler_set_step(handler, PLDM_FWUP_UA_HANDLER_STEP_QUERY_DEVICE_IDENTIFIERS);
+    }
+    else {
+        pldm_fwup_ua_handler_set_step(handler, PLDM_FWUP_UA_HANDLER_STEP_REQUEST_UPDATE);
+    }
+
+    return 0;
+}
+
+/**
+ * Get the result of the firmware update run by the handler.
+ *
+ * @param handler The UA task handler to query.
+ *
+ * @return 0 if the last update was successful, PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS if an update is still running, or
+ * the error code that ended the last update.
+ */
+int pldm_fwup_ua_handler_get_status(const struct pldm_fwup_ua_handler *handler)
+{
+    if (handler == NULL) {
+        return PLDM_FWUP_HANDLER_INVALID_ARGUMENT;
+    }
+
+    if (handler->state->step != PLDM_FWUP_UA_HANDLER_STEP_IDLE) {
+        return PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS;
+    }
+
+    return handler->state->status;
+}
@@ -0,0 +1,73 @@
+#ifndef PLDM_FWUP_UA_HANDLER_H_
+#define PLDM_FWUP_UA_HANDLER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "pldm_fwup_handler.h"
+#include "system/periodic_task.h"
+
+
+/**
+ * The steps of a firmware update run by the UA task handler.
+ */
+enum pldm_fwup_ua_handler_step {
+    PLDM_FWUP_UA_HANDLER_STEP_IDLE,                                                 /**< No update is running. */
+    PLDM_FWUP_UA_HANDLER_STEP_QUERY_DEVICE_IDENTIFIERS,                             /**< Querying the identifiers of the FD. */
+    PLDM_FWUP_UA_HANDLER_STEP_GET_FIRMWARE_PARAMETERS,                              /**< Querying the firmware parameters of the FD. */
+    PLDM_FWUP_UA_HANDLER_STEP_REQUEST_UPDATE,                                       /**< Requesting the FD enter update mode. */
+    PLDM_FWUP_UA_HANDLER_STEP_GET_PACKAGE_DATA,                                     /**< Sending package data to the FD. */
+    PLDM_FWUP_UA_HANDLER_STEP_DEVICE_META_DATA,                                     /**< Requesting device meta data from the FD. */
+    PLDM_FWUP_UA_HANDLER_STEP_PASS_COMPONENT_TABLE,                                 /**< Sending the component table. */
+    PLDM_FWUP_UA_HANDLER_STEP_UPDATE_COMPONENT,                                     /**< Requesting the update of a component. */
+    PLDM_FWUP_UA_HANDLER_STEP_START_DOWNLOAD,                                       /**< Waiting for the FD to request firmware data. */
+    PLDM_FWUP_UA_HANDLER_STEP_DOWNLOAD,                                             /**< Sending firmware data to the FD. */
+    PLDM_FWUP_UA_HANDLER_STEP_VERIFY_COMPLETE,                                      /**< Waiting for the result of verification. */
+    PLDM_FWUP_UA_HANDLER_STEP_APPLY_COMPLETE,                                       /**< Waiting for the result of applying the component. */
+    PLDM_FWUP_UA_HANDLER_STEP_ACTIVATE_FIRMWARE,                                    /**< Requesting the FD activate the new firmware. */
+};
+
+/**
+ * Variable context for the UA task handler.
+ */
+struct pldm_fwup_ua_handler_state {
+    enum pldm_fwup_ua_handler_step step;                                            /**< The current step of the update. */
+    uint8_t fd_eid;                                                                 /**< The endpoint ID of the firmware device. */
+    uint8_t fd_addr;                                                                /**< The SMBus address of the firmware device. */
+    bool rsp_pending;                                                               /**< Flag indicating a request was sent and the response is expected. */
+    platform_clock next;                                                            /**< Time at which the handler should next run. */
+    bool next_valid;                                                                /**< Flag indicating the next execution time has been set. */
+    platform_clock timeout;                                                         /**< Time by which the next expected message must be received. */
+    platform_clock download_start;                                                  /**< Time the FD said it would start requesting firmware data. */
+    int status;                                                                     /**< The result of the last update. */
+};
+
+/**
+ * Handler for running a PLDM firmware update from a periodic task while Cerberus is operating as the Update Agent.
+ *
+ * Each execution processes at most one received packet or sends the request for the current step, so the task is
+ * never blocked waiting for the FD. The time the FD asks for before it requests firmware data is scheduled as the next
+ * execution time of the handler instead of sleeping.
+ */
+struct pldm_fwup_ua_handler {
+    struct periodic_task_handler base;                                              /**< Base interface for task integration. */
+    struct pldm_fwup_ua_handler_state *state;                                       /**< Variable context for the handler. */
+    struct pldm_fwup_handler *fwup;                                                 /**< The firmware update handler with the channel to the FD. */
+};
+
+
+int pldm_fwup_ua_handler_init(struct pldm_fwup_ua_handler *handler, struct pldm_fwup_ua_handler_state *state,
+    struct pldm_fwup_handler *fwup);
+int pldm_fwup_ua_handler_init_state(const struct pldm_fwup_ua_handler *handler);
+void pldm_fwup_ua_handler_release(const struct pldm_fwup_ua_handler *handler);
+
+int pldm_fwup_ua_handler_start(const struct pldm_fwup_ua_handler *handler, bool inventory_cmds, uint8_t fd_eid,
+    uint8_t fd_addr);
+int pldm_fwup_ua_handler_get_status(const struct pldm_fwup_ua_handler *handler);
+
+
+/* This module will be treated as an extension of the firmware update handler and use PLDM_FWUP_HANDLER_* error
+ * codes. */
+
+
+#endif /* PLDM_FWUP_UA_HANDLER_H_ */
@@ -0,0 +1,332 @@
+#include <string.h>
+#include <stdlib.h>
+#include "pldm_fwup_ua_orchestrator.h"
+#include "cmd_interface_pldm.h"
+
+
+/**
+ * Get the UA manager used by a firmware update handler.
+ *
+ * @param handler The firmware update handler.
+ *
+ * @return The UA manager or null if the handler is not fully initialized.
+ */
+static struct pldm_fwup_ua_manager* pldm_fwup_ua_orchestrator_get_ua_manager(struct pldm_fwup_handler *handler)
+{
+    struct cmd_interface_pldm *interface;
+
+    if (handler->mctp == NULL || handler->mctp->cmd_pldm == NULL) {
+        return NULL;
+    }
+
+    interface = (struct cmd_interface_pldm*) handler->mctp->cmd_pldm;
+    if (interface->fwup_mgr == NULL) {
+        return NULL;
+    }
+
+    return &interface->fwup_mgr->ua_mgr;
+}
+
+/**
+ * Initialize a UA orchestrator for updating multiple Firmware Devices with the same FUP.
+ *
+ * @param orchestrator The orchestrator to initialize.
+ * @param ua_flash_mgr The FWUP flash manager for the UA containing the package data and component images.
+ * @param fup_comp_img_list The FUP component image information list.
+ * @param fup_comp_img_set_ver The component image set version obtained from the FUP.
+ * @param num_components The number of components in the FUP.
+ *
+ * @return 0 on success otherwise an error code.
+ */
+int pldm_fwup_ua_orchestrator_init(struct pldm_fwup_ua_orchestrator *orchestrator,
+    const struct pldm_fwup_flash_manager *ua_flash_mgr, const struct pldm_fwup_fup_component_image_entry *fup_comp_img_list,
+    struct pldm_fwup_protocol_version_string *fup_comp_img_set_ver, uint16_t num_components)
+{
+    int status;
+
+    if (orchestrator == NULL || ua_flash_mgr == NULL || fup_comp_img_list == NULL || num_components == 0) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    memset(orchestrator, 0, sizeof (struct pldm_fwup_ua_orchestrator));
+
+    status = platform_mutex_init(&orchestrator->lock);
+    if (status != 0) {
+        return status;
+    }
+
+    status = platform_semaphore_init(&orchestrator->all_complete);
+    if (status != 0) {
+        platform_mutex_free(&orchestrator->lock);
+        return status;
+    }
+
+    orchestrator->ua_flash_mgr = ua_flash_mgr;
+    orchestrator->fup_comp_img_list = fup_comp_img_list;
+    orchestrator->fup_comp_img_set_ver = fup_comp_img_set_ver;
+    orchestrator->num_components = num_components;
+
+    return 0;
+}
+
+/**
+ * Release the resources used by a UA orchestrator. No sessions may be running.
+ *
+ * @param orchestrator The orchestrator to release.
+ */
+void pldm_fwup_ua_orchestrator_release(struct pldm_fwup_ua_orchestrator *orchestrator)
+{
+    size_t i;
+
+    if (orchestrator != NULL) {
+        for (i = 0; i < orchestrator->num_sessions; i++) {
+            platform_free(orchestrator->sessions[i].comp_img_entries);
+        }
+
+        platform_semaphore_free(&orchestrator->all_complete);
+        platform_mutex_free(&orchestrator->lock);
+        memset(orchestrator, 0, sizeof (struct pldm_fwup_ua_orchestrator));
+    }
+}
+
+/**
+ * Add a Firmware Device to be updated by the orchestrator.
+ *
+ * The UA manager of the handler is reconfigured to use a session specific view of the UA flash and a session
+ * specific copy of the component image information list, so results reported by one FD are not seen by another.
+ *
+ * @param orchestrator The orchestrator to add the session to.
+ * @param handler The firmware update handler used to communicate with the FD. It must not be shared with any other
+ * session.
+ * @param fd_eid The endpoint ID of the FD to update.
+ * @param fd_addr The SMBus address of the FD to update.
+ * @param device_meta_data_region The flash region used to store the meta data received from this FD.
+ *
+ * @return The index of the new session or an error code. Use ROT_IS_ERROR to check the return value.
+ */
+int pldm_fwup_ua_orchestrator_add_session(struct pldm_fwup_ua_orchestrator *orchestrator, struct pldm_fwup_handler *handler,
+    uint8_t fd_eid, uint8_t fd_addr, const struct flash_region *device_meta_data_region)
+{
+    struct pldm_fwup_ua_session *session;
+    struct pldm_fwup_ua_manager *ua_mgr;
+    size_t entries_len;
+    size_t i;
+
+    if (orchestrator == NULL || handler == NULL || device_meta_data_region == NULL) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    ua_mgr = pldm_fwup_ua_orchestrator_get_ua_manager(handler);
+    if (ua_mgr == NULL) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    if (orchestrator->sessions_remaining != 0) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_UPDATE_ACTIVE;
+    }
+
+    if (orchestrator->num_sessions >= PLDM_FWUP_UA_ORCHESTRATOR_MAX_SESSIONS) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_TOO_MANY_SESSIONS;
+    }
+
+    for (i = 0; i < orchestrator->num_sessions; i++) {
+        if ((orchestrator->sessions[i].ua_mgr == ua_mgr) || (orchestrator->sessions[i].handler == handler)) {
+            return PLDM_FWUP_UA_ORCHESTRATOR_SHARED_MANAGER;
+        }
+    }
+
+    session = &orchestrator->sessions[orchestrator->num_sessions];
+    memset(session, 0, sizeof (struct pldm_fwup_ua_session));
+
+    entries_len = orchestrator->num_components * sizeof (struct pldm_fwup_fup_component_image_entry);
+    session->comp_img_entries = platform_calloc(1, entries_len);
+    if (session->comp_img_entries == NULL) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_NO_MEMORY;
+    }
+    memcpy(session->comp_img_entries, orchestrator->fup_comp_img_list, entries_len);
+
+    memcpy(&session->flash_mgr, orchestrator->ua_flash_mgr, sizeof (struct pldm_fwup_flash_manager));
+    memcpy(&session->flash_mgr.device_meta_data_region, device_meta_data_region, sizeof (struct flash_region));
+    session->flash_mgr.device_meta_data_size = 0;
+
+    session->handler = handler;
+    session->ua_mgr = ua_mgr;
+    session->fd_eid = fd_eid;
+    session->fd_addr = fd_addr;
+    session->status = PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING;
+
+    return orchestrator->num_sessions++;
+}
+
+/**
+ * Prepare every session for a new update. This must be called before any session is run.
+ *
+ * @param orchestrator The orchestrator to start.
+ * @param inventory_cmds A flag indicating that inventory commands should be issued to each FD.
+ *
+ * @return 0 on success otherwise an error code.
+ */
+int pldm_fwup_ua_orchestrator_start(struct pldm_fwup_ua_orchestrator *orchestrator, bool inventory_cmds)
+{
+    struct pldm_fwup_ua_session *session;
+    struct pldm_fwup_ua_manager *ua_mgr;
+    size_t i;
+    int status;
+
+    if (orchestrator == NULL || orchestrator->num_sessions == 0) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    if (orchestrator->sessions_remaining != 0) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_UPDATE_ACTIVE;
+    }
+
+    for (i = 0; i < orchestrator->num_sessions; i++) {
+        status = pldm_fwup_handler_set_mode(orchestrator->sessions[i].handler, PLDM_FWUP_HANDLER_UA_MODE);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    platform_semaphore_reset(&orchestrator->all_complete);
+
+    for (i = 0; i < orchestrator->num_sessions; i++) {
+        session = &orchestrator->sessions[i];
+        ua_mgr = session->ua_mgr;
+
+        memset(&ua_mgr->rec_fw_parameters, 0, sizeof (ua_mgr->rec_fw_parameters));
+        memset(&ua_mgr->state, 0, sizeof (ua_mgr->state));
+        memset(&ua_mgr->update_info, 0, sizeof (ua_mgr->update_info));
+        reset_get_cmd_state(&ua_mgr->get_cmd_state);
+
+        ua_mgr->flash_mgr = &session->flash_mgr;
+        ua_mgr->comp_img_entries = session->comp_img_entries;
+        ua_mgr->fup_comp_img_set_ver = orchestrator->fup_comp_img_set_ver;
+        ua_mgr->num_components = orchestrator->num_components;
+        ua_mgr->current_comp_num = 0;
+
+        session->status = PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING;
+        session->run = false;
+    }
+
+    orchestrator->inventory_cmds = inventory_cmds;
+    orchestrator->sessions_remaining = orchestrator->num_sessions;
+
+    return 0;
+}
+
+/**
+ * Run the update of a single Firmware Device. This blocks until the update of that device completes.
+ *
+ * Each session can only be run once per update. The orchestrator must be started again before a session can be rerun.
+ *
+ * @param orchestrator The orchestrator containing the session.
+ * @param session The index of the session to run.
+ *
+ * @return 0 if the update was successful otherwise an error code.
+ */
+int pldm_fwup_ua_orchestrator_run_session(struct pldm_fwup_ua_orchestrator *orchestrator, size_t session)
+{
+    struct pldm_fwup_ua_session *current;
+    int status;
+
+    if (orchestrator == NULL || session >= orchestrator->num_sessions) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    current = &orchestrator->sessions[session];
+
+    platform_mutex_lock(&orchestrator->lock);
+
+    if (current->run) {
+        platform_mutex_unlock(&orchestrator->lock);
+        return PLDM_FWUP_UA_ORCHESTRATOR_SESSION_ALREADY_RUN;
+    }
+    current->run = true;
+
+    platform_mutex_unlock(&orchestrator->lock);
+
+    status = current->handler->run_update_ua(current->handler, orchestrator->inventory_cmds, current->fd_eid,
+        current->fd_addr);
+
+    platform_mutex_lock(&orchestrator->lock);
+
+    if (current->status == PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING) {
+        current->status = status;
+        if (orchestrator->sessions_remaining != 0) {
+            orchestrator->sessions_remaining--;
+            if (orchestrator->sessions_remaining == 0) {
+                platform_semaphore_post(&orchestrator->all_complete);
+            }
+        }
+    }
+
+    platform_mutex_unlock(&orchestrator->lock);
+
+    return status;
+}
+
+/**
+ * Wait for every session to complete.
+ *
+ * @param orchestrator The orchestrator to wait on.
+ * @param ms_timeout The maximum time to wait in milliseconds. A timeout of 0 will wait forever.
+ *
+ * @return 0 if every update was successful, the status of the first failed session, or an error code if the
+ * sessions did not complete.
+ */
+int pldm_fwup_ua_orchestrator_wait(struct pldm_fwup_ua_orchestrator *orchestrator, uint32_t ms_timeout)
+{
+    size_t i;
+    int status;
+
+    if (orchestrator == NULL || orchestrator->num_sessions == 0) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    platform_mutex_lock(&orchestrator->lock);
+    status = (orchestrator->sessions_remaining == 0) ? 0 : 1;
+    platform_mutex_unlock(&orchestrator->lock);
+
+    if (status != 0) {
+        status = platform_semaphore_wait(&orchestrator->all_complete, ms_timeout);
+        if (status == 1) {
+            return PLDM_FWUP_UA_ORCHESTRATOR_TIMEOUT;
+        }
+        else if (status != 0) {
+            return status;
+        }
+    }
+
+    for (i = 0; i < orchestrator->num_sessions; i++) {
+        if (orchestrator->sessions[i].status != 0) {
+            return orchestrator->sessions[i].status;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Get the result of the update of a single Firmware Device.
+ *
+ * @param orchestrator The orchestrator containing the session.
+ * @param session The index of the session to query.
+ *
+ * @return 0 if the update was successful, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING if the update has not completed,
+ * or the error code reported by the update.
+ */
+int pldm_fwup_ua_orchestrator_get_session_status(struct pldm_fwup_ua_orchestrator *orchestrator, size_t session)
+{
+    int status;
+
+    if (orchestrator == NULL || session >= orchestrator->num_sessions) {
+        return PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT;
+    }
+
+    platform_mutex_lock(&orchestrator->lock);
+    status = orchestrator->sessions[session].status;
+    platform_mutex_unlock(&orchestrator->lock);
+
+    return status;
+}
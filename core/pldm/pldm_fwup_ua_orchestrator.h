@@ -0,0 +1,88 @@
+#ifndef PLDM_FWUP_UA_ORCHESTRATOR_H_
+#define PLDM_FWUP_UA_ORCHESTRATOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "pldm_fwup_handler.h"
+#include "pldm_fwup_manager.h"
+#include "status/rot_status.h"
+
+
+#ifndef PLDM_FWUP_UA_ORCHESTRATOR_MAX_SESSIONS
+#define PLDM_FWUP_UA_ORCHESTRATOR_MAX_SESSIONS                                      16
+#endif
+
+/**
+ * A single update of one Firmware Device run by the orchestrator.
+ */
+struct pldm_fwup_ua_session {
+    struct pldm_fwup_handler *handler;                                              /**< Handler with the channel and MCTP instance used to reach the FD. */
+    struct pldm_fwup_ua_manager *ua_mgr;                                            /**< The UA manager dedicated to this session. */
+    struct pldm_fwup_flash_manager flash_mgr;                                       /**< Session view of the UA flash. Package data and component regions are shared. */
+    struct pldm_fwup_fup_component_image_entry *comp_img_entries;                   /**< Session copy of the component image information list. */
+    uint8_t fd_eid;                                                                 /**< The endpoint ID of the FD being updated. */
+    uint8_t fd_addr;                                                                /**< The SMBus address of the FD being updated. */
+    int status;                                                                     /**< The result of the update. */
+    bool run;                                                                       /**< Flag indicating the session has been run since the update started. */
+};
+
+/**
+ * Runs independent PLDM firmware updates of several Firmware Devices at the same time with Cerberus operating as
+ * the Update Agent.
+ *
+ * Each session has its own UA manager, so the update state, multipart transfer state, and instance IDs of one
+ * session never affect another. The package data and component images are only read during an update and are
+ * shared by every session.
+ *
+ * @note For AMI, the orchestrator does not create tasks itself since task creation is platform specific. The platform
+ *          should call pldm_fwup_ua_orchestrator_run_session from a separate task for each session and wait for all of
+ *          them with pldm_fwup_ua_orchestrator_wait. Each session must use its own command channel, MCTP interface,
+ *          PLDM command interface, and FWUP manager.
+ */
+struct pldm_fwup_ua_orchestrator {
+    const struct pldm_fwup_flash_manager *ua_flash_mgr;                             /**< UA flash containing the package data and component images. */
+    const struct pldm_fwup_fup_component_image_entry *fup_comp_img_list;            /**< The FUP component image information list. */
+    struct pldm_fwup_protocol_version_string *fup_comp_img_set_ver;                 /**< The component image set version from the FUP. */
+    uint16_t num_components;                                                        /**< The number of components in the FUP. */
+    struct pldm_fwup_ua_session sessions[PLDM_FWUP_UA_ORCHESTRATOR_MAX_SESSIONS];   /**< The update sessions. */
+    size_t num_sessions;                                                            /**< The number of sessions added. */
+    bool inventory_cmds;                                                            /**< Flag indicating inventory commands should be issued to each FD. */
+    size_t sessions_remaining;                                                      /**< The number of sessions that have not completed. */
+    platform_mutex lock;                                                            /**< Synchronization for session completion. */
+    platform_semaphore all_complete;                                                /**< Signaled when every session has completed. */
+};
+
+
+int pldm_fwup_ua_orchestrator_init(struct pldm_fwup_ua_orchestrator *orchestrator,
+    const struct pldm_fwup_flash_manager *ua_flash_mgr, const struct pldm_fwup_fup_component_image_entry *fup_comp_img_list,
+    struct pldm_fwup_protocol_version_string *fup_comp_img_set_ver, uint16_t num_components);
+void pldm_fwup_ua_orchestrator_release(struct pldm_fwup_ua_orchestrator *orchestrator);
+
+int pldm_fwup_ua_orchestrator_add_session(struct pldm_fwup_ua_orchestrator *orchestrator, struct pldm_fwup_handler *handler,
+    uint8_t fd_eid, uint8_t fd_addr, const struct flash_region *device_meta_data_region);
+
+int pldm_fwup_ua_orchestrator_start(struct pldm_fwup_ua_orchestrator *orchestrator, bool inventory_cmds);
+int pldm_fwup_ua_orchestrator_run_session(struct pldm_fwup_ua_orchestrator *orchestrator, size_t session);
+int pldm_fwup_ua_orchestrator_wait(struct pldm_fwup_ua_orchestrator *orchestrator, uint32_t ms_timeout);
+int pldm_fwup_ua_orchestrator_get_session_status(struct pldm_fwup_ua_orchestrator *orchestrator, size_t session);
+
+
+#define	PLDM_FWUP_UA_ORCHESTRATOR_ERROR(code)                                       ROT_ERROR (ROT_MODULE_PLDM_FWUP_UA_ORCHESTRATOR, code)
+
+/**
+ * Error codes that can be generated by the UA orchestrator.
+ */
+enum {
+    PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x00),    /**< Input parameter is null or not valid. */
+    PLDM_FWUP_UA_ORCHESTRATOR_NO_MEMORY = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x01),           /**< Memory allocation failed. */
+    PLDM_FWUP_UA_ORCHESTRATOR_TOO_MANY_SESSIONS = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x02),   /**< No more sessions can be added. */
+    PLDM_FWUP_UA_ORCHESTRATOR_SHARED_MANAGER = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x03),      /**< The FWUP manager is already used by another session. */
+    PLDM_FWUP_UA_ORCHESTRATOR_UPDATE_ACTIVE = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x04),       /**< Sessions are still running. */
+    PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x05),     /**< The session has not completed. */
+    PLDM_FWUP_UA_ORCHESTRATOR_TIMEOUT = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x06),             /**< Sessions did not complete before the timeout. */
+    PLDM_FWUP_UA_ORCHESTRATOR_SESSION_ALREADY_RUN = PLDM_FWUP_UA_ORCHESTRATOR_ERROR (0x07)  /**< The session has already been run for the current update. */
+};
+
+
+#endif /* PLDM_FWUP_UA_ORCHESTRATOR_H_ */
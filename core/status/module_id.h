@@ -126,7 +126,11 @@ enum {
 	ROT_MODULE_DME_STRUCTURE = 0x0072,					/**< Parsing and management of the DME structure. */
     ROT_MODULE_PLDM_FWUP_MANAGER = 0x0072,              /**< Manager for a PLDM-based Firmware Update. */
     ROT_MODULE_CMD_HANDLER_PLDM = 0x0073,               /**< Handler for received PLDM protocol messages. */
-    ROT_MODULE_PLDM_FWUP_HANDLER = 0x0074               /**< Handler for executing PLDM-based firmware updates. */
+    ROT_MODULE_PLDM_FWUP_HANDLER = 0x0074,              /**< Handler for executing PLDM-based firmware updates. */
+    ROT_MODULE_PLDM_FWUP_UA_ORCHESTRATOR = 0x0075,      /**< Orchestrator for concurrent PLDM-based firmware updates of multiple devices. */
+    ROT_MODULE_PLDM_FWUP_PACKAGE = 0x0076,              /**< Parser for PLDM firmware update packages. */
+    ROT_MODULE_PLDM_FWUP_DELTA = 0x0077,                /**< Block digests for PLDM delta component updates. */
+    ROT_MODULE_HOST_FW_VERIFY_SCHEDULER = 0x0078        /**< Scheduler for verifying host firmware images on multiple workers. */
 };
 
 
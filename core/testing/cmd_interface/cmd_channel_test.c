@@ -448,6 +448,162 @@ static void cmd_channel_test_receive_and_process_multi_packet_response (CuTest *
 	complete_mock_cmd_channel_test (test, &channel);
 }
 
+static void cmd_channel_test_receive_and_process_multi_packet_response_send_packets (CuTest *test)
+{
+	struct cmd_channel_testing channel;
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet[2];
+	struct cmd_message tx_message;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	const int msg_size = 300;
+	uint8_t response_data[msg_size + 4];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+	uint8_t payload[msg_size];
+	uint8_t msg_data[msg_size + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * 2) + 4];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+
+	memcpy (msg_data, tx_packet[0].data, tx_packet[0].pkt_size);
+	memcpy (&msg_data[tx_packet[0].pkt_size], tx_packet[1].data, tx_packet[1].pkt_size);
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = tx_packet[0].pkt_size + tx_packet[1].pkt_size;
+	tx_message.pkt_size = tx_packet[0].pkt_size;
+	tx_message.dest_addr = tx_packet[0].dest_addr;
+
+	setup_mock_cmd_channel_test (test, &channel);
+	cmd_channel_mock_enable_send_packets (&channel.test);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	memcpy (&response.data[4], payload, msg_size);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet, sizeof (rx_packet), -1);
+
+	status |= mock_expect (&channel.cmd_cerberus.mock, channel.cmd_cerberus.base.process_request,
+		&channel.cmd_cerberus, 0,
+		MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request, &request,
+			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
+	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&channel.test.mock, channel.test.base.send_packets, &channel.test, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message, sizeof (tx_message)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mock_cmd_channel_test (test, &channel);
+}
+
 static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
 {
 	struct cmd_channel_testing channel;
@@ -2745,6 +2901,101 @@ static void cmd_channel_test_send_message_multiple_packets (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void cmd_channel_test_send_message_multiple_packets_send_packets (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet[2];
+	struct cmd_message tx_message;
+	const int msg_size = 300;
+	uint8_t msg_data[msg_size + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * 2) + 4];
+	struct mctp_base_protocol_transport_header *header;
+	uint8_t payload[msg_size];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+	tx_packet[0].timeout_valid = false;
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+	tx_packet[1].timeout_valid = false;
+
+	memcpy (msg_data, tx_packet[0].data, tx_packet[0].pkt_size);
+	memcpy (&msg_data[tx_packet[0].pkt_size], tx_packet[1].data, tx_packet[1].pkt_size);
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = tx_packet[0].pkt_size + tx_packet[1].pkt_size;
+	tx_message.pkt_size = tx_packet[0].pkt_size;
+	tx_message.dest_addr = tx_packet[0].dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mock_enable_send_packets (&channel);
+
+	status = mock_expect (&channel.mock, channel.base.send_packets, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message, sizeof (tx_message)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
 static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
 {
 	struct cmd_channel_mock channel;
@@ -3107,6 +3358,68 @@ static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void cmd_channel_test_send_message_send_packets_failure (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet;
+	struct cmd_message tx_message;
+	struct mctp_base_protocol_transport_header *header;
+	int status;
+
+	TEST_START;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+	tx_packet.timeout_valid = false;
+
+	tx_message.data = tx_packet.data;
+	tx_message.msg_size = tx_packet.pkt_size;
+	tx_message.pkt_size = tx_packet.pkt_size;
+	tx_message.dest_addr = tx_packet.dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mock_enable_send_packets (&channel);
+
+	status = mock_expect (&channel.mock, channel.base.send_packets, &channel,
+		CMD_CHANNEL_TX_FAILED,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message, sizeof (tx_message)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
 
 TEST_SUITE_START (cmd_channel);
 
@@ -3121,6 +3434,7 @@ TEST (cmd_channel_test_validate_packet_for_send_empty);
 TEST (cmd_channel_test_validate_packet_for_send_overflow);
 TEST (cmd_channel_test_receive_and_process_single_packet_response);
 TEST (cmd_channel_test_receive_and_process_multi_packet_response);
+TEST (cmd_channel_test_receive_and_process_multi_packet_response_send_packets);
 TEST (cmd_channel_test_receive_and_process_max_response);
 TEST (cmd_channel_test_receive_and_process_multi_packet_message);
 TEST (cmd_channel_test_receive_and_process_request_processing_timeout);
@@ -3136,10 +3450,12 @@ TEST (cmd_channel_test_receive_and_process_overflow_packet);
 TEST (cmd_channel_test_receive_and_process_multiple_overflow_packet);
 TEST (cmd_channel_test_send_message_single_packet);
 TEST (cmd_channel_test_send_message_multiple_packets);
+TEST (cmd_channel_test_send_message_multiple_packets_send_packets);
 TEST (cmd_channel_test_send_message_multiple_messages);
 TEST (cmd_channel_test_send_message_max_message);
 TEST (cmd_channel_test_send_message_null);
 TEST (cmd_channel_test_send_message_send_failure);
 TEST (cmd_channel_test_send_message_multiple_packets_send_failure);
+TEST (cmd_channel_test_send_message_send_packets_failure);
 
 TEST_SUITE_END;
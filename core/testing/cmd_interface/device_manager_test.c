@@ -1240,6 +1240,73 @@ static void device_manager_test_get_device_num_invalid_eid (CuTest *test)
 	device_manager_release (&manager);
 }
 
+static void device_manager_test_get_device_num_duplicate_eid (CuTest *test)
+{
+	struct device_manager manager;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 3, 0, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 1000, 1000, 1000, 0, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 0, 0xAA, 0xBB, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 2, 0xCC, 0xDD, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 1, 0xCC, 0xDD, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_update_device_eid (&manager, 1, 0xEE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, 2, status);
+
+	status = device_manager_get_device_num (&manager, 0xEE);
+	CuAssertIntEquals (test, 1, status);
+
+	device_manager_release (&manager);
+}
+
+static void device_manager_test_get_device_num_eid_changed (CuTest *test)
+{
+	struct device_manager manager;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 2, 0, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 1000, 1000, 1000, 0, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 0, 0xAA, 0xBB, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 1, 0xCC, 0xDD, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_eid (&manager, 1, 0xEE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+
+	status = device_manager_get_device_num (&manager, 0xEE);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_get_device_addr_by_eid (&manager, 0xEE);
+	CuAssertIntEquals (test, 0xDD, status);
+
+	device_manager_release (&manager);
+}
+
 static void device_manager_test_update_device_eid (CuTest *test)
 {
 	struct device_manager manager;
@@ -1831,6 +1898,50 @@ static void device_manager_test_get_max_message_len_by_eid_remote_device_unknown
 	device_manager_release (&manager);
 }
 
+static void device_manager_test_get_max_message_len_by_eid_remote_device_eid_changed (
+	CuTest *test)
+{
+	struct device_manager manager;
+	struct device_manager_full_capabilities remote;
+	int status;
+	size_t length;
+
+	TEST_START;
+
+	memset (&remote, 0, sizeof (remote));
+	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
+	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
+	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
+	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
+	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
+	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
+
+	status = device_manager_init (&manager, 2, 0, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 1000, 1000, 1000, 0, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 0, 0xAA, 0xBB, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 1, 0xCC, 0xDD, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_capabilities (&manager, 1, &remote);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_eid (&manager, 1, 0xEE);
+	CuAssertIntEquals (test, 0, status);
+
+	length = device_manager_get_max_message_len_by_eid (&manager, 0xEE);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128, length);
+
+	length = device_manager_get_max_message_len_by_eid (&manager, 0xCC);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY, length);
+
+	device_manager_release (&manager);
+}
+
 static void device_manager_test_get_max_message_len_by_eid_null (CuTest *test)
 {
 	struct device_manager manager;
@@ -2235,6 +2346,59 @@ static void device_manager_test_get_max_transmission_unit_by_eid_remote_device_u
 	device_manager_release (&manager);
 }
 
+static void device_manager_test_get_max_transmission_unit_by_eid_local_device_updated (
+	CuTest *test)
+{
+	struct device_manager manager;
+	struct device_manager_full_capabilities local;
+	struct device_manager_full_capabilities remote;
+	int status;
+	size_t length;
+
+	TEST_START;
+
+	memset (&remote, 0, sizeof (remote));
+	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT - 32;
+	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
+	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
+	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
+	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
+	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
+
+	status = device_manager_init (&manager, 2, 0, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 1000, 1000, 1000, 0, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 0, 0xAA, 0xBB, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&manager, 1, 0xCC, 0xDD, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_capabilities (&manager, 1, &remote);
+	CuAssertIntEquals (test, 0, status);
+
+	length = device_manager_get_max_transmission_unit_by_eid (&manager, 0xCC);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT - 32, length);
+
+	status = device_manager_get_device_capabilities (&manager, 0, &local);
+	CuAssertIntEquals (test, 0, status);
+
+	local.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT - 64;
+
+	status = device_manager_update_device_capabilities (&manager, 0, &local);
+	CuAssertIntEquals (test, 0, status);
+
+	length = device_manager_get_max_transmission_unit_by_eid (&manager, 0xCC);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT - 64, length);
+
+	length = device_manager_get_max_transmission_unit_by_eid (&manager, 0xEE);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT - 64, length);
+
+	device_manager_release (&manager);
+}
+
 static void device_manager_test_get_max_transmission_unit_by_eid_null (CuTest *test)
 {
 	struct device_manager manager;
@@ -5954,6 +6118,8 @@ TEST (device_manager_test_get_device_num);
 TEST (device_manager_test_get_device_num_init_ac_rot);
 TEST (device_manager_test_get_device_num_null);
 TEST (device_manager_test_get_device_num_invalid_eid);
+TEST (device_manager_test_get_device_num_duplicate_eid);
+TEST (device_manager_test_get_device_num_eid_changed);
 TEST (device_manager_test_update_device_eid);
 TEST (device_manager_test_update_device_eid_init_ac_rot);
 TEST (device_manager_test_update_device_eid_notify_observers_self);
@@ -5974,6 +6140,7 @@ TEST (device_manager_test_get_max_message_len_by_eid_remote_device);
 TEST (device_manager_test_get_max_message_len_by_eid_remote_device_local_smaller);
 TEST (device_manager_test_get_max_message_len_by_eid_remote_device_no_capabilities);
 TEST (device_manager_test_get_max_message_len_by_eid_remote_device_unknown_device);
+TEST (device_manager_test_get_max_message_len_by_eid_remote_device_eid_changed);
 TEST (device_manager_test_get_max_message_len_by_eid_null);
 TEST (device_manager_test_get_max_transmission_unit_local_device);
 TEST (device_manager_test_get_max_transmission_unit_init_ac_rot);
@@ -5987,6 +6154,7 @@ TEST (device_manager_test_get_max_transmission_unit_by_eid_remote_device);
 TEST (device_manager_test_get_max_transmission_unit_by_eid_remote_device_local_smaller);
 TEST (device_manager_test_get_max_transmission_unit_by_eid_remote_device_no_capabilities);
 TEST (device_manager_test_get_max_transmission_unit_by_eid_remote_device_unknown_device);
+TEST (device_manager_test_get_max_transmission_unit_by_eid_local_device_updated);
 TEST (device_manager_test_get_max_transmission_unit_by_eid_null);
 TEST (device_manager_test_get_reponse_timeout_local_device);
 TEST (device_manager_test_get_reponse_timeout_init_ac_rot);
@@ -12,6 +12,37 @@
 TEST_SUITE_LABEL ("checksum");
 
 
+/**
+ * Reference SMBus CRC8 calculation that processes the data one bit at a time.
+ *
+ * @param crc The initial CRC8 value.
+ * @param data The data to use for the calculation.
+ * @param len Length of the data.
+ *
+ * @return The resulting CRC8.
+ */
+static uint8_t checksum_testing_smbus_crc8 (uint8_t crc, const uint8_t *data, size_t len)
+{
+	size_t i;
+	int j;
+
+	for (i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (j = 0; j < 8; j++) {
+			if ((crc & 0x80) != 0) {
+				crc = (uint8_t) ((crc << 1) ^ 0x07);
+			}
+			else {
+				crc <<= 1;
+			}
+		}
+	}
+
+	return crc;
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -104,6 +135,82 @@ static void checksum_test_update_smbus_crc8 (CuTest *test)
 	CuAssertIntEquals (test, 0x48, crc);
 }
 
+static void checksum_test_update_smbus_crc8_all_lengths (CuTest *test)
+{
+	uint8_t buf[256 + 8];
+	uint8_t crc;
+	uint8_t expected;
+	size_t i;
+	int offset;
+	int len;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = (uint8_t) ((i * 167) + 13);
+	}
+
+	/* Cover every length and alignment so all paths through the calculation are used. */
+	for (offset = 0; offset < 8; offset++) {
+		for (len = 0; len < 256; len++) {
+			expected = checksum_testing_smbus_crc8 (0xd6, &buf[offset], len);
+
+			crc = checksum_update_smbus_crc8 (0xd6, &buf[offset], len);
+			CuAssertIntEquals (test, expected, crc);
+		}
+	}
+}
+
+static void checksum_test_update_smbus_crc8_all_initial_values (CuTest *test)
+{
+	uint8_t buf[255];
+	uint8_t crc;
+	uint8_t expected;
+	size_t i;
+	int initial;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = (uint8_t) (0xff - (i * 29));
+	}
+
+	for (initial = 0; initial < 256; initial++) {
+		expected = checksum_testing_smbus_crc8 (initial, buf, sizeof (buf));
+
+		crc = checksum_update_smbus_crc8 (initial, buf, sizeof (buf));
+		CuAssertIntEquals (test, expected, crc);
+
+		expected = checksum_testing_smbus_crc8 (initial, buf, 1);
+
+		crc = checksum_update_smbus_crc8 (initial, buf, 1);
+		CuAssertIntEquals (test, expected, crc);
+	}
+}
+
+static void checksum_test_update_smbus_crc8_multiple_calls (CuTest *test)
+{
+	uint8_t buf[255];
+	uint8_t crc;
+	uint8_t expected;
+	size_t i;
+	int split;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = (uint8_t) ((i * 71) ^ 0x5a);
+	}
+
+	expected = checksum_testing_smbus_crc8 (0, buf, sizeof (buf));
+
+	for (split = 0; split <= (int) sizeof (buf); split++) {
+		crc = checksum_update_smbus_crc8 (0, buf, split);
+		crc = checksum_update_smbus_crc8 (crc, &buf[split], sizeof (buf) - split);
+		CuAssertIntEquals (test, expected, crc);
+	}
+}
+
 static void checksum_test_update_smbus_crc8_null (CuTest *test)
 {
 	uint8_t crc;
@@ -125,6 +232,50 @@ static void checksum_test_update_smbus_crc8_zero_length (CuTest *test)
 	CuAssertIntEquals (test, 0xaa, crc);
 }
 
+static void checksum_test_crc32 (CuTest *test)
+{
+	uint32_t crc;
+	uint8_t buf[] = "123456789";
+
+	TEST_START;
+
+	crc = checksum_crc32 (buf, sizeof (buf) - 1);
+	CuAssertIntEquals (test, 0xcbf43926, crc);
+}
+
+static void checksum_test_crc32_null (CuTest *test)
+{
+	uint32_t crc;
+
+	TEST_START;
+
+	crc = checksum_crc32 (NULL, 16);
+	CuAssertIntEquals (test, 0, crc);
+}
+
+static void checksum_test_update_crc32 (CuTest *test)
+{
+	uint32_t crc;
+	uint8_t buf[] = "123456789";
+
+	TEST_START;
+
+	crc = checksum_update_crc32 (0, buf, 4);
+	crc = checksum_update_crc32 (crc, &buf[4], 5);
+	CuAssertIntEquals (test, 0xcbf43926, crc);
+}
+
+static void checksum_test_update_crc32_zero_length (CuTest *test)
+{
+	uint32_t crc;
+	uint8_t buf[3] = {0x01, 0x02, 0x03};
+
+	TEST_START;
+
+	crc = checksum_update_crc32 (0x12345678, buf, 0);
+	CuAssertIntEquals (test, 0x12345678, crc);
+}
+
 
 TEST_SUITE_START (checksum);
 
@@ -133,7 +284,14 @@ TEST (checksum_test_crc8_null);
 TEST (checksum_test_crc8_zero_length);
 TEST (checksum_test_init_smbus_crc8);
 TEST (checksum_test_update_smbus_crc8);
+TEST (checksum_test_update_smbus_crc8_all_lengths);
+TEST (checksum_test_update_smbus_crc8_all_initial_values);
+TEST (checksum_test_update_smbus_crc8_multiple_calls);
 TEST (checksum_test_update_smbus_crc8_null);
 TEST (checksum_test_update_smbus_crc8_zero_length);
+TEST (checksum_test_crc32);
+TEST (checksum_test_crc32_null);
+TEST (checksum_test_update_crc32);
+TEST (checksum_test_update_crc32_zero_length);
 
 TEST_SUITE_END;
@@ -21,6 +21,12 @@ static void add_all_flash_tests (CuSuite *suite)
 	/* This is unused when no tests will be executed. */
 	UNUSED (suite);
 
+#if (defined TESTING_RUN_FLASH_CACHED_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_FLASH_CACHED_SUITE
+	TESTING_RUN_SUITE (flash_cached);
+#endif
 #if (defined TESTING_RUN_FLASH_COMMON_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -57,6 +63,12 @@ static void add_all_flash_tests (CuSuite *suite)
 	!defined TESTING_SKIP_FLASH_UTIL_SUITE
 	TESTING_RUN_SUITE (flash_util);
 #endif
+#if (defined TESTING_RUN_FLASH_VIRTUAL_DISK_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_FLASH_VIRTUAL_DISK_SUITE
+	TESTING_RUN_SUITE (flash_virtual_disk);
+#endif
 #if (defined TESTING_RUN_FLASH_VIRTUAL_RAM_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -0,0 +1,997 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "testing.h"
+#include "flash/flash_cached.h"
+#include "flash/flash_cached_static.h"
+#include "testing/mock/flash/flash_mock.h"
+#include "testing/crypto/rsa_testing.h"
+
+
+TEST_SUITE_LABEL ("flash_cached");
+
+
+/**
+ * Number of lines in the cache used for testing.
+ */
+#define	FLASH_CACHED_TESTING_LINES		2
+
+/**
+ * Number of bytes in each line of the cache used for testing.
+ */
+#define	FLASH_CACHED_TESTING_LINE_SIZE	16
+
+
+/**
+ * Dependencies for testing the cached flash.
+ */
+struct flash_cached_testing {
+	struct flash_mock flash;											/**< Mock for the underlying flash. */
+	struct flash_cached_state state;									/**< Variable context for the cache. */
+	struct flash_cached_line lines[FLASH_CACHED_TESTING_LINES];			/**< Cache line tracking. */
+	uint8_t cache[FLASH_CACHED_TESTING_LINES * FLASH_CACHED_TESTING_LINE_SIZE];	/**< Cache storage. */
+	struct flash_cached test;											/**< Cached flash under test. */
+};
+
+
+/**
+ * Initialize a cached flash for testing.
+ *
+ * @param test The test framework.
+ * @param cached Testing components to initialize.
+ */
+static void flash_cached_testing_init (CuTest *test, struct flash_cached_testing *cached)
+{
+	int status;
+
+	status = flash_mock_init (&cached->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_cached_init (&cached->test, &cached->state, &cached->flash.base, cached->lines,
+		cached->cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release cached flash test components and validate all mocks.
+ *
+ * @param test The test framework.
+ * @param cached Testing components to release.
+ */
+static void flash_cached_testing_release (CuTest *test, struct flash_cached_testing *cached)
+{
+	int status;
+
+	status = flash_mock_validate_and_release (&cached->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_release (&cached->test);
+}
+
+/**
+ * Set the expectation for a single line to be read from flash.
+ *
+ * @param test The test framework.
+ * @param cached Testing components to update.
+ * @param address The flash address of the line.
+ */
+static void flash_cached_testing_expect_line_read (CuTest *test,
+	struct flash_cached_testing *cached, uint32_t address)
+{
+	int status;
+
+	status = mock_expect (&cached->flash.mock, cached->flash.base.read, &cached->flash, 0,
+		MOCK_ARG (address), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_CACHED_TESTING_LINE_SIZE));
+	status |= mock_expect_output (&cached->flash.mock, 1, &RSA_PRIVKEY_DER[address],
+		FLASH_CACHED_TESTING_LINE_SIZE, 2);
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Read data through the cache and check that the expected flash contents were returned.
+ *
+ * @param test The test framework.
+ * @param cached Testing components to use.
+ * @param address The flash address to read.
+ * @param length The number of bytes to read.
+ */
+static void flash_cached_testing_read (CuTest *test, struct flash_cached_testing *cached,
+	uint32_t address, size_t length)
+{
+	uint8_t data[FLASH_CACHED_TESTING_LINE_SIZE * 4];
+	int status;
+
+	CuAssertTrue (test, (length <= sizeof (data)));
+
+	status = cached->test.base.read (&cached->test.base, address, data, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (&RSA_PRIVKEY_DER[address], data, length);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Check the cache usage statistics.
+ *
+ * @param test The test framework.
+ * @param cached Testing components to check.
+ * @param hits The expected number of cache hits.
+ * @param misses The expected number of cache misses.
+ */
+static void flash_cached_testing_check_stats (CuTest *test, struct flash_cached_testing *cached,
+	uint32_t hits, uint32_t misses)
+{
+	struct flash_cached_stats stats;
+	int status;
+
+	status = flash_cached_get_stats (&cached->test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, hits, stats.hits);
+	CuAssertIntEquals (test, misses, stats.misses);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_cached_test_init (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&cached.flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, &cached.flash.base, cached.lines,
+		cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, cached.test.base.get_device_size);
+	CuAssertPtrNotNull (test, cached.test.base.read);
+	CuAssertPtrNotNull (test, cached.test.base.get_page_size);
+	CuAssertPtrNotNull (test, cached.test.base.minimum_write_per_page);
+	CuAssertPtrNotNull (test, cached.test.base.write);
+	CuAssertPtrNotNull (test, cached.test.base.get_sector_size);
+	CuAssertPtrNotNull (test, cached.test.base.sector_erase);
+	CuAssertPtrNotNull (test, cached.test.base.get_block_size);
+	CuAssertPtrNotNull (test, cached.test.base.block_erase);
+	CuAssertPtrNotNull (test, cached.test.base.chip_erase);
+
+	flash_cached_testing_check_stats (test, &cached, 0, 0);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_init_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&cached.flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_cached_init (NULL, &cached.state, &cached.flash.base, cached.lines,
+		cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init (&cached.test, NULL, &cached.flash.base, cached.lines,
+		cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, NULL, cached.lines,
+		cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, &cached.flash.base, NULL,
+		cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, &cached.flash.base, cached.lines,
+		NULL, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, &cached.flash.base, cached.lines,
+		cached.cache, 0, FLASH_CACHED_TESTING_LINE_SIZE);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, &cached.flash.base, cached.lines,
+		cached.cache, FLASH_CACHED_TESTING_LINES, 0);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&cached.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_cached_test_init_line_size_not_power_of_two (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&cached.flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_cached_init (&cached.test, &cached.state, &cached.flash.base, cached.lines,
+		cached.cache, 1, 24);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&cached.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_cached_test_static_init (CuTest *test)
+{
+	struct flash_cached_testing cached = {
+		.test = flash_cached_static_init (&cached.state, &cached.flash.base, cached.lines,
+			cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE)
+	};
+	int status;
+
+	TEST_START;
+
+	CuAssertPtrNotNull (test, cached.test.base.get_device_size);
+	CuAssertPtrNotNull (test, cached.test.base.read);
+	CuAssertPtrNotNull (test, cached.test.base.get_page_size);
+	CuAssertPtrNotNull (test, cached.test.base.minimum_write_per_page);
+	CuAssertPtrNotNull (test, cached.test.base.write);
+	CuAssertPtrNotNull (test, cached.test.base.get_sector_size);
+	CuAssertPtrNotNull (test, cached.test.base.sector_erase);
+	CuAssertPtrNotNull (test, cached.test.base.get_block_size);
+	CuAssertPtrNotNull (test, cached.test.base.block_erase);
+	CuAssertPtrNotNull (test, cached.test.base.chip_erase);
+
+	status = flash_mock_init (&cached.flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_cached_init_state (&cached.test);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x104, 4);
+	flash_cached_testing_read (test, &cached, 0x100, 8);
+
+	flash_cached_testing_check_stats (test, &cached, 1, 1);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_static_init_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	struct flash_cached null_state = flash_cached_static_init (NULL, &cached.flash.base,
+		cached.lines, cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	struct flash_cached null_flash = flash_cached_static_init (&cached.state, NULL,
+		cached.lines, cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	struct flash_cached null_lines = flash_cached_static_init (&cached.state, &cached.flash.base,
+		NULL, cached.cache, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	struct flash_cached null_cache = flash_cached_static_init (&cached.state, &cached.flash.base,
+		cached.lines, NULL, FLASH_CACHED_TESTING_LINES, FLASH_CACHED_TESTING_LINE_SIZE);
+	struct flash_cached bad_size = flash_cached_static_init (&cached.state, &cached.flash.base,
+		cached.lines, cached.cache, FLASH_CACHED_TESTING_LINES, 12);
+	int status;
+
+	TEST_START;
+
+	status = flash_cached_init_state (NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init_state (&null_state);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init_state (&null_flash);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init_state (&null_lines);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init_state (&null_cache);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_init_state (&bad_size);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+}
+
+static void flash_cached_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_cached_release (NULL);
+}
+
+static void flash_cached_test_get_device_size (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint32_t size = 0x200000;
+	uint32_t out;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.get_device_size, &cached.flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cached.flash.mock, 0, &size, sizeof (size), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.get_device_size (&cached.test.base, &out);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, size, out);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_get_page_size (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint32_t size = 256;
+	uint32_t out;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.get_page_size, &cached.flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cached.flash.mock, 0, &size, sizeof (size), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.get_page_size (&cached.test.base, &out);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, size, out);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_size_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint32_t out;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = cached.test.base.get_device_size (NULL, &out);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.get_page_size (NULL, &out);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.minimum_write_per_page (NULL, &out);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.get_sector_size (NULL, &out);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.get_block_size (NULL, &out);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_miss_then_hit (CuTest *test)
+{
+	struct flash_cached_testing cached;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x104, 4);
+	flash_cached_testing_check_stats (test, &cached, 0, 1);
+
+	flash_cached_testing_read (test, &cached, 0x108, 8);
+	flash_cached_testing_read (test, &cached, 0x100, 2);
+	flash_cached_testing_check_stats (test, &cached, 2, 1);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_multiple_lines (CuTest *test)
+{
+	struct flash_cached_testing cached;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x110);
+
+	flash_cached_testing_read (test, &cached, 0x108, FLASH_CACHED_TESTING_LINE_SIZE);
+	flash_cached_testing_check_stats (test, &cached, 0, 2);
+
+	flash_cached_testing_read (test, &cached, 0x10c, 8);
+	flash_cached_testing_check_stats (test, &cached, 2, 2);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_full_line_not_cached (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.read, &cached.flash, 0,
+		MOCK_ARG (0x100), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_CACHED_TESTING_LINE_SIZE * 2));
+	status |= mock_expect_output (&cached.flash.mock, 1, &RSA_PRIVKEY_DER[0x100],
+		FLASH_CACHED_TESTING_LINE_SIZE * 2, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x100, FLASH_CACHED_TESTING_LINE_SIZE * 2);
+	flash_cached_testing_check_stats (test, &cached, 0, 2);
+
+	/* The full line read did not populate the cache, so this needs to read flash. */
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_check_stats (test, &cached, 0, 3);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_full_line_cached (CuTest *test)
+{
+	struct flash_cached_testing cached;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x100, FLASH_CACHED_TESTING_LINE_SIZE);
+	flash_cached_testing_check_stats (test, &cached, 1, 1);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_least_recently_used (CuTest *test)
+{
+	struct flash_cached_testing cached;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x000);
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x000, 4);
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+
+	/* Use the first line again so the second line is the oldest. */
+	flash_cached_testing_read (test, &cached, 0x004, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+
+	flash_cached_testing_read (test, &cached, 0x008, 4);
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_check_stats (test, &cached, 2, 4);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_error (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint8_t data[4];
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.read, &cached.flash,
+		FLASH_READ_FAILED, MOCK_ARG (0x100), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FLASH_CACHED_TESTING_LINE_SIZE));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	status = cached.test.base.read (&cached.test.base, 0x104, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	/* The failed line must not be treated as cached. */
+	flash_cached_testing_read (test, &cached, 0x104, 4);
+	flash_cached_testing_check_stats (test, &cached, 0, 2);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_read_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint8_t data[4];
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = cached.test.base.read (NULL, 0x100, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.read (&cached.test.base, 0x100, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_write (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.write, &cached.flash,
+		sizeof (data), MOCK_ARG (0x10c), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)),
+		MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.write (&cached.test.base, 0x10c, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	/* Only the line that was written should be read again. */
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 3);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_write_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint8_t data[4];
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = cached.test.base.write (NULL, 0x100, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_sector_erase (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint32_t sector = 0x100;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x110);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+
+	flash_cached_testing_read (test, &cached, 0x110, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.get_sector_size, &cached.flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cached.flash.mock, 0, &sector, sizeof (sector), -1);
+
+	status |= mock_expect (&cached.flash.mock, cached.flash.base.sector_erase, &cached.flash, 0,
+		MOCK_ARG (0x120));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.sector_erase (&cached.test.base, 0x120);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x110);
+
+	flash_cached_testing_read (test, &cached, 0x110, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 3);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_sector_erase_size_error (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x110);
+
+	flash_cached_testing_read (test, &cached, 0x110, 4);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.get_sector_size, &cached.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.sector_erase (&cached.test.base, 0x100);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	flash_cached_testing_read (test, &cached, 0x110, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 1);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_block_erase (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	uint32_t block = 0x200;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x1f0);
+	flash_cached_testing_expect_line_read (test, &cached, 0x3f0);
+
+	flash_cached_testing_read (test, &cached, 0x1f0, 4);
+	flash_cached_testing_read (test, &cached, 0x3f0, 4);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.get_block_size, &cached.flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cached.flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&cached.flash.mock, cached.flash.base.block_erase, &cached.flash, 0,
+		MOCK_ARG (0x200));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.block_erase (&cached.test.base, 0x200);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x3f0);
+
+	flash_cached_testing_read (test, &cached, 0x1f0, 4);
+	flash_cached_testing_read (test, &cached, 0x3f0, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 3);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_chip_erase (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.chip_erase, &cached.flash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cached.test.base.chip_erase (&cached.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+	flash_cached_testing_check_stats (test, &cached, 0, 4);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_erase_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = cached.test.base.sector_erase (NULL, 0x100);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.block_erase (NULL, 0x100);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = cached.test.base.chip_erase (NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_invalidate (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x110);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x110, 4);
+
+	status = flash_cached_invalidate (&cached.test, 0x10f, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x110, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 3);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_invalidate_zero_length (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+
+	status = flash_cached_invalidate (&cached.test, 0x100, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 1);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_invalidate_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_cached_invalidate (NULL, 0x100, 4);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+}
+
+static void flash_cached_test_invalidate_all (CuTest *test)
+{
+	struct flash_cached_testing cached;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+
+	flash_cached_invalidate_all (&cached.test);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x200);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x200, 4);
+	flash_cached_testing_check_stats (test, &cached, 0, 4);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_invalidate_all_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_cached_invalidate_all (NULL);
+}
+
+static void flash_cached_test_prefetch (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+	flash_cached_testing_expect_line_read (test, &cached, 0x110);
+
+	status = flash_cached_prefetch (&cached.test, 0x10c, 8);
+	CuAssertIntEquals (test, 0, status);
+	flash_cached_testing_check_stats (test, &cached, 0, 2);
+
+	flash_cached_testing_read (test, &cached, 0x100, FLASH_CACHED_TESTING_LINE_SIZE * 2);
+	flash_cached_testing_check_stats (test, &cached, 2, 2);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_prefetch_zero_length (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = flash_cached_prefetch (&cached.test, 0x100, 0);
+	CuAssertIntEquals (test, 0, status);
+	flash_cached_testing_check_stats (test, &cached, 0, 0);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_prefetch_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_cached_prefetch (NULL, 0x100, 4);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+}
+
+static void flash_cached_test_prefetch_read_error (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	status = mock_expect (&cached.flash.mock, cached.flash.base.read, &cached.flash,
+		FLASH_READ_FAILED, MOCK_ARG (0x110), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FLASH_CACHED_TESTING_LINE_SIZE));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_cached_prefetch (&cached.test, 0x100, FLASH_CACHED_TESTING_LINE_SIZE * 2);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 2);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_reset_stats (CuTest *test)
+{
+	struct flash_cached_testing cached;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	flash_cached_testing_expect_line_read (test, &cached, 0x100);
+
+	flash_cached_testing_read (test, &cached, 0x100, 4);
+	flash_cached_testing_read (test, &cached, 0x104, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 1);
+
+	flash_cached_reset_stats (&cached.test);
+	flash_cached_testing_check_stats (test, &cached, 0, 0);
+
+	/* Resetting the statistics does not discard cached data. */
+	flash_cached_testing_read (test, &cached, 0x108, 4);
+	flash_cached_testing_check_stats (test, &cached, 1, 0);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+static void flash_cached_test_reset_stats_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_cached_reset_stats (NULL);
+}
+
+static void flash_cached_test_get_stats_null (CuTest *test)
+{
+	struct flash_cached_testing cached;
+	struct flash_cached_stats stats;
+	int status;
+
+	TEST_START;
+
+	flash_cached_testing_init (test, &cached);
+
+	status = flash_cached_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_cached_get_stats (&cached.test, NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_cached_testing_release (test, &cached);
+}
+
+
+TEST_SUITE_START (flash_cached);
+
+TEST (flash_cached_test_init);
+TEST (flash_cached_test_init_null);
+TEST (flash_cached_test_init_line_size_not_power_of_two);
+TEST (flash_cached_test_static_init);
+TEST (flash_cached_test_static_init_null);
+TEST (flash_cached_test_release_null);
+TEST (flash_cached_test_get_device_size);
+TEST (flash_cached_test_get_page_size);
+TEST (flash_cached_test_size_null);
+TEST (flash_cached_test_read_miss_then_hit);
+TEST (flash_cached_test_read_multiple_lines);
+TEST (flash_cached_test_read_full_line_not_cached);
+TEST (flash_cached_test_read_full_line_cached);
+TEST (flash_cached_test_read_least_recently_used);
+TEST (flash_cached_test_read_error);
+TEST (flash_cached_test_read_null);
+TEST (flash_cached_test_write);
+TEST (flash_cached_test_write_null);
+TEST (flash_cached_test_sector_erase);
+TEST (flash_cached_test_sector_erase_size_error);
+TEST (flash_cached_test_block_erase);
+TEST (flash_cached_test_chip_erase);
+TEST (flash_cached_test_erase_null);
+TEST (flash_cached_test_invalidate);
+TEST (flash_cached_test_invalidate_zero_length);
+TEST (flash_cached_test_invalidate_null);
+TEST (flash_cached_test_invalidate_all);
+TEST (flash_cached_test_invalidate_all_null);
+TEST (flash_cached_test_prefetch);
+TEST (flash_cached_test_prefetch_zero_length);
+TEST (flash_cached_test_prefetch_null);
+TEST (flash_cached_test_prefetch_read_error);
+TEST (flash_cached_test_reset_stats);
+TEST (flash_cached_test_reset_stats_null);
+TEST (flash_cached_test_get_stats_null);
+
+TEST_SUITE_END;
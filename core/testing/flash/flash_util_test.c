@@ -13291,6 +13291,1166 @@ static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void flash_sector_copy_ext_if_changed_test_unchanged (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_changed (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x01, 0x02, 0x03, 0x05};
+	uint8_t blank[sizeof (data)];
+	size_t written = 0;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_multiple_sectors (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	uint8_t old[] = {0x11, 0x12, 0x13, 0x14};
+	uint8_t blank[4];
+	size_t written = 0;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	/* First sector is unchanged. */
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10ffc),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash1.mock, 1, data, 4, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20ffc),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash2.mock, 1, data, 4, 2);
+
+	/* Second sector needs to be updated. */
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x11000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash1.mock, 1, &data[4], 4, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x21000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x21000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x21000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 4, MOCK_ARG (0x21000),
+		MOCK_ARG_PTR_CONTAINS (&data[4], 4), MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20ffc, &flash1.base, 0x10ffc,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 4, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_multiple_compare_blocks (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[FLASH_VERIFICATION_BLOCK + 44];
+	uint8_t old[44];
+	uint8_t blank[sizeof (data)];
+	size_t written = 0;
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	memset (old, 0x55, sizeof (old));
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash1.mock, 1, data, FLASH_VERIFICATION_BLOCK, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash2.mock, 1, data, FLASH_VERIFICATION_BLOCK, 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0,
+		MOCK_ARG (0x10000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (old)));
+	status |= mock_expect_output (&flash1.mock, 1, &data[FLASH_VERIFICATION_BLOCK], sizeof (old),
+		2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
+		MOCK_ARG (0x20000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (old)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash2.mock, 1, blank, FLASH_VERIFICATION_BLOCK, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
+		MOCK_ARG (0x20000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (old)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (old), 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_PAGE_SIZE));
+	status |= mock_expect_output (&flash1.mock, 1, data, FLASH_PAGE_SIZE, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_PAGE_SIZE,
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, FLASH_PAGE_SIZE),
+		MOCK_ARG (FLASH_PAGE_SIZE));
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0,
+		MOCK_ARG (0x10000 + FLASH_PAGE_SIZE), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (data) - FLASH_PAGE_SIZE));
+	status |= mock_expect_output (&flash1.mock, 1, &data[FLASH_PAGE_SIZE],
+		sizeof (data) - FLASH_PAGE_SIZE, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2,
+		sizeof (data) - FLASH_PAGE_SIZE, MOCK_ARG (0x20000 + FLASH_PAGE_SIZE),
+		MOCK_ARG_PTR_CONTAINS (&data[FLASH_PAGE_SIZE], sizeof (data) - FLASH_PAGE_SIZE),
+		MOCK_ARG (sizeof (data) - FLASH_PAGE_SIZE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_same_flash (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x11000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash.base, 0x11000, &flash.base, 0x10000,
+		sizeof (data), NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_null (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (NULL, 0x20000, &flash1.base, 0x10000, 4, &written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, NULL, 0x10000, 4, &written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_no_length (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000, 0,
+		&written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_sector_size_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000, 4,
+		NULL);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_page_size_unsupported (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_MAX_COPY_BLOCK * 2;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000, 4,
+		NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_PAGE_SIZE, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_source_read_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000, 4,
+		NULL);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_destination_read_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), NULL);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_erase_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	uint8_t old[] = {0x11, 0x12, 0x13, 0x14};
+	uint8_t blank[4];
+	size_t written = 0;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	/* First sector is updated. */
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10ffc),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash1.mock, 1, data, 4, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20ffc),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20ffc),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 4, MOCK_ARG (0x20ffc),
+		MOCK_ARG_PTR_CONTAINS (data, 4), MOCK_ARG (4));
+
+	/* Second sector fails to erase. */
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x11000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash1.mock, 1, &data[4], 4, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x21000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2,
+		FLASH_SECTOR_ERASE_FAILED, MOCK_ARG (0x21000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20ffc, &flash1.base, 0x10ffc,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+	CuAssertIntEquals (test, 4, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_not_blank (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x11, 0x12, 0x13, 0x14};
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_write_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x11, 0x12, 0x13, 0x14};
+	uint8_t blank[sizeof (data)];
+	size_t written = 1;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &written);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_same_flash_overlapping_regions (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash.base, 0x11000, &flash.base, 0x10000, 0x1001,
+		NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_COPY_OVERLAP, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_test_same_flash_same_erase_block (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed (&flash.base, 0x10100, &flash.base, 0x10000, 0x10,
+		NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_and_verify_test_changed (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x01, 0x02, 0x03, 0x05};
+	uint8_t blank[sizeof (data)];
+	size_t written = 0;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_and_verify (&flash2.base, 0x20000, &flash1.base,
+		0x10000, sizeof (data), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_and_verify_test_unchanged (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_and_verify (&flash2.base, 0x20000, &flash1.base,
+		0x10000, sizeof (data), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_and_verify_test_mismatch (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x01, 0x02, 0x03, 0x05};
+	uint8_t blank[sizeof (data)];
+	size_t written = 1;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_and_verify (&flash2.base, 0x20000, &flash1.base,
+		0x10000, sizeof (data), &written);
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_and_verify_test_null (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_and_verify (NULL, 0x20000, &flash1.base, 0x10000, 4,
+		&written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_sector_copy_ext_if_changed_and_verify (&flash2.base, 0x20000, NULL, 0x10000, 4,
+		&written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_buffered_test_sector_in_buffer (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[FLASH_VERIFICATION_BLOCK + 44];
+	uint8_t old[44];
+	uint8_t blank[sizeof (data)];
+	uint8_t buffer[sizeof (data) * 2];
+	size_t written = 0;
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+	memset (old, 0x55, sizeof (old));
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	/* The source is read once into the buffer. */
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash2.mock, 1, data, FLASH_VERIFICATION_BLOCK, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
+		MOCK_ARG (0x20000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (old)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash2.mock, 1, blank, FLASH_VERIFICATION_BLOCK, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
+		MOCK_ARG (0x20000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (old)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (old), 2);
+
+	/* The sector is programmed from the buffer without reading the source again. */
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash2.mock, 1, data, FLASH_VERIFICATION_BLOCK, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
+		MOCK_ARG (0x20000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (old)));
+	status |= mock_expect_output (&flash2.mock, 1, &data[FLASH_VERIFICATION_BLOCK], sizeof (old),
+		2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_buffered (&flash2.base, 0x20000, &flash1.base,
+		0x10000, sizeof (data), true, buffer, sizeof (buffer), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_buffered_test_sector_larger_than_buffer (
+	CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	uint8_t old[] = {0x15, 0x16, 0x17, 0x18};
+	uint8_t blank[sizeof (data)];
+	uint8_t buffer[4];
+	size_t written = 0;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (buffer), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (buffer), 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10004),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&flash1.mock, 1, &data[4], sizeof (buffer), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20004),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	/* The buffer doesn't hold the whole sector, so the source must be read again. */
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_buffered (&flash2.base, 0x20000, &flash1.base,
+		0x10000, sizeof (data), false, buffer, sizeof (buffer), &written);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), written);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_if_changed_buffered_test_null (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint8_t buffer[FLASH_VERIFICATION_BLOCK];
+	size_t written = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_if_changed_buffered (NULL, 0x20000, &flash1.base, 0x10000, 4,
+		false, buffer, sizeof (buffer), &written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, written);
+
+	status = flash_sector_copy_ext_if_changed_buffered (&flash2.base, 0x20000, NULL, 0x10000, 4,
+		false, buffer, sizeof (buffer), &written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_sector_copy_ext_if_changed_buffered (&flash2.base, 0x20000, &flash1.base,
+		0x10000, 4, false, NULL, sizeof (buffer), &written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_sector_copy_ext_if_changed_buffered (&flash2.base, 0x20000, &flash1.base,
+		0x10000, 4, false, buffer, 0, &written);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
 static void flash_contents_verification_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
@@ -13315,13 +14475,200 @@ static void flash_contents_verification_test_sha256 (CuTest *test)
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_sha256_no_match_signature (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_sha256_no_match_signature_with_hash_out (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (hash_out, 0, sizeof (hash_out));
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_sha1 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+	uint8_t hash_out[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13333,14 +14680,14 @@ static void flash_contents_verification_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
+static void flash_contents_verification_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13358,19 +14705,218 @@ static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_sha512 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+	uint8_t hash_out[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_unknown (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (NULL, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, 0, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), NULL,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
@@ -13380,11 +14926,12 @@ static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256_no_match_signature (CuTest *test)
+static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
+	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
 	char *data = "Test";
 
@@ -13399,20 +14946,10 @@ static void flash_contents_verification_test_sha256_no_match_signature (CuTest *
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13423,14 +14960,14 @@ static void flash_contents_verification_test_sha256_no_match_signature (CuTest *
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256_no_match_signature_with_hash_out (CuTest *test)
+static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
+	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13443,26 +14980,10 @@ static void flash_contents_verification_test_sha256_no_match_signature_with_hash
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
-	memset (hash_out, 0, sizeof (hash_out));
-
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13473,14 +14994,15 @@ static void flash_contents_verification_test_sha256_no_match_signature_with_hash
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha1 (CuTest *test)
+static void flash_contents_verification_test_read_error_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA1_HASH_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -13493,22 +15015,19 @@ static void flash_contents_verification_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
+	memcpy (hash_out, empty, sizeof (hash_out));
+
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
-	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13520,14 +15039,14 @@ static void flash_contents_verification_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13545,17 +15064,16 @@ static void flash_contents_verification_test_sha384 (CuTest *test)
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13567,14 +15085,15 @@ static void flash_contents_verification_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA512_HASH_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13592,17 +15111,20 @@ static void flash_contents_verification_test_sha512 (CuTest *test)
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13614,12 +15136,13 @@ static void flash_contents_verification_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
 
 	TEST_START;
@@ -13633,9 +15156,23 @@ static void flash_contents_verification_test_unknown (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13646,13 +15183,16 @@ static void flash_contents_verification_test_unknown (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_null (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13665,29 +15205,28 @@ static void flash_contents_verification_test_null (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (NULL, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_contents_verification (&flash.base, 0x4321, 0, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), NULL,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13698,14 +15237,15 @@ static void flash_contents_verification_test_null (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13718,45 +15258,27 @@ static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = signature_verification_mock_validate_and_release (&verification);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-}
-
-static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *test)
-{
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
-	struct flash_mock flash;
-	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
-	int status;
-	char *data = "Test";
-
-	TEST_START;
-
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
-
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
@@ -13766,14 +15288,15 @@ static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *tes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13786,45 +15309,27 @@ static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = signature_verification_mock_validate_and_release (&verification);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-}
-
-static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *test)
-{
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
-	struct flash_mock flash;
-	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
-	int status;
-	char *data = "Test";
-
-	TEST_START;
-
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
-
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
@@ -13834,15 +15339,15 @@ static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_read_error_with_hash_out (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
+	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13855,19 +15360,25 @@ static void flash_contents_verification_test_read_error_with_hash_out (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	memcpy (hash_out, empty, sizeof (hash_out));
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13879,7 +15390,7 @@ static void flash_contents_verification_test_read_error_with_hash_out (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -13899,22 +15410,12 @@ static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, 0, status);
+		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13925,15 +15426,14 @@ static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[2];
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13947,24 +15447,27 @@ static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x8765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
 		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions[0].start_addr = 0x4321;
+	regions[0].length = 1;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
 
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_noncontiguous_contents_verification (&flash.base, regions, 2, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13976,13 +15479,13 @@ static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	int status;
 	char *data = "Test";
 
 	TEST_START;
@@ -13996,23 +15499,36 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_noncontiguous_contents_verification (NULL, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_noncontiguous_contents_verification (&flash.base, NULL, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 0, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, NULL,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14023,16 +15539,15 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature_with_hash_out (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14045,28 +15560,13 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14077,15 +15577,15 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14098,26 +15598,13 @@ static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14128,15 +15615,16 @@ static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha384 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14149,26 +15637,13 @@ static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14179,15 +15654,16 @@ static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha512 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14200,26 +15676,13 @@ static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14230,7 +15693,7 @@ static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_read_error_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -14238,6 +15701,8 @@ static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -14250,12 +15715,22 @@ static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14266,322 +15741,318 @@ static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_multiple_regions (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x8765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, regions, 2, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_null (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
+		0x0d,0x2c,0x02,0x20
+	};
+	uint8_t hash_actual[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_noncontiguous_contents_verification (NULL, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification (&flash.base, NULL, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 0, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, NULL,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x12345;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA1, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
+		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
+		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+	};
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha1 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
+		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
+		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
+		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+	};
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA512, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha384 (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x10000, &regions, 1,
+		&hash.base, (enum hash_type) 10, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha512 (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_read_error_with_hash_out (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -14602,7 +16073,7 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *tes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -14611,8 +16082,8 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *tes
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
@@ -14624,18 +16095,13 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *tes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
-		0x0d,0x2c,0x02,0x20
-	};
-	uint8_t hash_actual[SHA1_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14645,21 +16111,32 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions.start_addr = 0x12345;
-	regions.length = 4;
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		NULL, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14667,31 +16144,28 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
-		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
-		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
-	};
-	uint8_t hash_actual[SHA384_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -14699,560 +16173,561 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha384 (CuTest *tes
 	regions.length = 4;
 
 	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
+	CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
-		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
-		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
-		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
-	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
+		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
 	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
+	CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x10000, &regions, 1,
-		&hash.base, (enum hash_type) 10, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
+		MOCK_ARG (1));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_hash_start_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_expected[] = {
-		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
-		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
-	};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash,
+		HASH_ENGINE_START_SHA256_FAILED);
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_hash_finish_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
+		MOCK_ARG_PTR (hash_actual), MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_null (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		NULL, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_out (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature (
 	CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
-		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature_with_hash_out (
 	CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	struct flash_region regions;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
-		MOCK_ARG (1));
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
 
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
+static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	char *data = "Test";
 
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	TEST_START;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA1, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY,
+		NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_hash_start_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash,
-		HASH_ENGINE_START_SHA256_FAILED);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA512, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_hash_finish_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
-		MOCK_ARG (sizeof (data)));
-	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
-		MOCK_ARG_PTR (hash_actual), MOCK_ARG (SHA256_HASH_LENGTH));
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, (enum hash_type) 10, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNKNOWN_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[2];
 	char *data = "Test";
 
 	TEST_START;
@@ -15266,16 +16741,23 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions[0].start_addr = 0x4321;
+	regions[0].length = 1;
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x90000, regions, 2,
 		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		&RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
@@ -15287,7 +16769,7 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *t
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_out (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
@@ -15295,7 +16777,6 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15308,7 +16789,7 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
@@ -15317,12 +16798,8 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -15332,14 +16809,13 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature (
-	CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	int status;
 	char *data = "Test";
 
 	TEST_START;
@@ -15353,19 +16829,48 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
+	status = flash_verify_noncontiguous_contents_at_offset (NULL, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, NULL, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
 	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		NULL, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, 0,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		NULL, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15374,16 +16879,15 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature_with_hash_out (
-	CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_hash_buffer_too_small (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15396,23 +16900,13 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
 
 	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15421,7 +16915,8 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_read_error_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
@@ -15429,6 +16924,8 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *tes
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -15441,13 +16938,22 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *tes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
 	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY,
-		NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15456,10 +16962,10 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *tes
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
@@ -15470,66 +16976,96 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha384 (CuTest *t
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
@@ -15540,275 +17076,291 @@ static void flash_verify_noncontiguous_contents_at_offset_test_unknown (CuTest *
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, (enum hash_type) 10, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNKNOWN_SIG_HASH, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
 
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x90000, regions, 2,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_null (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_verify_noncontiguous_contents_at_offset (NULL, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, NULL, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 0,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		NULL, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, 0,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		NULL, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_hash_buffer_too_small (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_read_error_with_hash_out (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, (enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = signature_verification_mock_validate_and_release (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[2];
 	char *data = "Test";
 
 	TEST_START;
@@ -15822,20 +17374,27 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
 		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions[0].start_addr = 0x4321;
+	regions[0].length = 1;
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x90000, regions, 2,
 		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
 		0);
 	CuAssertIntEquals (test, 0, status);
@@ -15849,8 +17408,7 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuT
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with_hash_out (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_no_offset (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -15858,7 +17416,6 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15871,7 +17428,7 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
@@ -15884,12 +17441,9 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -15901,14 +17455,13 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	int status;
 	char *data = "Test";
 
 	TEST_START;
@@ -15922,24 +17475,43 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_noncontiguous_contents_verification_at_offset (NULL, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, NULL, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL,
+		NULL, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
 		0);
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15950,16 +17522,16 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature_with_hash_out (
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small (
 	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15972,28 +17544,13 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16004,15 +17561,16 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha1 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16025,26 +17583,13 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16055,15 +17600,16 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha384 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16076,26 +17622,13 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16106,15 +17639,16 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuT
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha512 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16127,26 +17661,13 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha512 (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16157,7 +17678,8 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha512 (CuT
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_read_error_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -16165,6 +17687,8 @@ static void flash_noncontiguous_contents_verification_at_offset_test_unknown (Cu
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -16177,13 +17701,22 @@ static void flash_noncontiguous_contents_verification_at_offset_test_unknown (Cu
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, (enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		NULL, 0);
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16194,532 +17727,551 @@ static void flash_noncontiguous_contents_verification_at_offset_test_unknown (Cu
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_multiple_regions (CuTest *test)
+static void flash_write_and_verify_test (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
-	char *data = "Test";
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_write_and_verify_test_mismatch (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t check[] = {0x01, 0x02, 0x13, 0x04};
+
+	TEST_START;
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, check, sizeof (check), 2);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	CuAssertIntEquals (test, 0, status);
 
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
+static void flash_write_and_verify_test_null (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	TEST_START;
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x90000, regions, 2,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_write_and_verify (NULL, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_write_and_verify (&flash.base, 0x10000, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_no_offset (CuTest *test)
+static void flash_write_and_verify_test_write_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_null (CuTest *test)
+static void flash_write_and_verify_test_incomplete_write (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_noncontiguous_contents_verification_at_offset (NULL, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, NULL, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 0,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		NULL, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data) - 1,
+		MOCK_ARG (0x100fe), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_write_and_verify (&flash.base, 0x100fe, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small (
-	CuTest *test)
+static void flash_write_and_verify_test_verify_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
 
-	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha1 (
-	CuTest *test)
+static void flash_hash_update_contents_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha384 (
-	CuTest *test)
+static void flash_hash_update_contents_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
+		0x0d,0x2c,0x02,0x20
+	};
+	uint8_t hash_actual[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = hash.base.start_sha1 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_update_contents (&flash.base, 0x12345, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha512 (
-	CuTest *test)
+static void flash_hash_update_contents_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
+		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
+		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+	};
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = hash.base.start_sha384 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_read_error_with_hash_out (
-	CuTest *test)
+static void flash_hash_update_contents_test_sha512 (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
-	struct flash_mock flash;
-	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
+		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
+		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
+		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+	};
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
+	status = hash.base.start_sha512 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test (CuTest *test)
+static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
-		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test_mismatch (CuTest *test)
+static void flash_hash_update_contents_test_zero_length (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t check[] = {0x01, 0x02, 0x13, 0x04};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
-		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, check, sizeof (check), 2);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 0, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash_actual, SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test_null (CuTest *test)
+static void flash_hash_update_contents_test_null (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (NULL, 0x10000, data, sizeof (data));
+	status = flash_hash_update_contents (NULL, 0x1122, 4, &hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, NULL, sizeof (data));
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, NULL);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test_write_error (CuTest *test)
+static void flash_hash_update_contents_test_read_error (CuTest *test)
 {
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
-		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_write_and_verify_test_incomplete_write (CuTest *test)
+static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *test)
 {
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data) - 1,
-		MOCK_ARG (0x100fe), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
+		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x1222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x100fe, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_write_and_verify_test_verify_error (CuTest *test)
+static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
 {
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 
 	TEST_START;
 
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
-		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_contents_test_sha256 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
 		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
@@ -16744,7 +18296,10 @@ static void flash_hash_update_contents_test_sha256 (CuTest *test)
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16759,11 +18314,12 @@ static void flash_hash_update_contents_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha1 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
 		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
@@ -16788,7 +18344,10 @@ static void flash_hash_update_contents_test_sha1 (CuTest *test)
 	status = hash.base.start_sha1 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x12345, 4, &hash.base);
+	regions.start_addr = 0x12345;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16803,11 +18362,12 @@ static void flash_hash_update_contents_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha384 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
 		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
@@ -16833,7 +18393,10 @@ static void flash_hash_update_contents_test_sha384 (CuTest *test)
 	status = hash.base.start_sha384 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16848,11 +18411,12 @@ static void flash_hash_update_contents_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha512 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
 		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
@@ -16860,7 +18424,54 @@ static void flash_hash_update_contents_test_sha512 (CuTest *test)
 		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
 		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
 	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha512 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16871,15 +18482,26 @@ static void flash_hash_update_contents_test_sha512 (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha512 (&hash.base);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16894,14 +18516,16 @@ static void flash_hash_update_contents_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
-		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
-		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
 	};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
@@ -16914,24 +18538,32 @@ static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
-		&hash.base);
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16946,11 +18578,12 @@ static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_zero_length (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
@@ -16964,7 +18597,10 @@ static void flash_hash_update_contents_test_zero_length (CuTest *test)
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 0, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 0;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16979,11 +18615,12 @@ static void flash_hash_update_contents_test_zero_length (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 
 	TEST_START;
 
@@ -16993,10 +18630,19 @@ static void flash_hash_update_contents_test_null (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (NULL, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (NULL, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, NULL);
+	status = flash_hash_update_noncontiguous_contents (&flash.base, NULL, 1, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 0, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, NULL);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17005,11 +18651,12 @@ static void flash_hash_update_contents_test_null (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 
 	TEST_START;
 
@@ -17024,7 +18671,10 @@ static void flash_hash_update_contents_test_read_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17034,11 +18684,12 @@ static void flash_hash_update_contents_test_read_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 
 	TEST_START;
 
@@ -17061,8 +18712,10 @@ static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
-		&hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17072,11 +18725,59 @@ static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
+		MOCK_ARG (1));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 
 	TEST_START;
@@ -17096,7 +18797,10 @@ static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17106,7 +18810,7 @@ static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17127,7 +18831,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17139,7 +18843,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17154,7 +18859,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17175,7 +18880,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17187,7 +18892,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 	regions.start_addr = 0x12345;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17202,7 +18908,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17224,7 +18930,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17236,7 +18942,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17251,7 +18958,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17274,7 +18981,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17286,7 +18993,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17301,7 +19009,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17321,15 +19029,15 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
 
@@ -17341,7 +19049,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTes
 	regions.start_addr = 0x1122;
 	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17356,7 +19065,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17377,15 +19086,15 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTe
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
 	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
 
@@ -17394,16 +19103,66 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTe
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17418,7 +19177,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTe
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_zero_length (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17440,7 +19199,8 @@ static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *t
 	regions.start_addr = 0x1122;
 	regions.length = 0;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17455,7 +19215,7 @@ static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17473,16 +19233,20 @@ static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (NULL, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, NULL, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 0, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, NULL);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		NULL);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17491,7 +19255,7 @@ static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17507,14 +19271,15 @@ static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *te
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17524,7 +19289,8 @@ static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *te
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
+	CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17539,7 +19305,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_e
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
 
@@ -17548,14 +19314,15 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_e
 		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x1222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
 	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17565,7 +19332,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_e
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
+	CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17581,7 +19349,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17589,7 +19357,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 		MOCK_ARG (1));
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -17602,7 +19370,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 	regions[2].start_addr = 0x5566;
 	regions[2].length = 1;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17612,7 +19381,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17628,7 +19397,7 @@ static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17640,7 +19409,8 @@ static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuT
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17650,29 +19420,34 @@ static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuT
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[1024];
+	uint8_t data[RSA_ENCRYPT_LEN * 3];
 	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
 	};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN);
+
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG ((RSA_ENCRYPT_LEN * 2) + 16));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
@@ -17681,10 +19456,10 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTe
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.length = (RSA_ENCRYPT_LEN * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x40000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17699,41 +19474,52 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTe
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[RSA_ENCRYPT_LEN + 128];
+	uint8_t data[RSA_ENCRYPT_LEN * 3];
 	uint8_t hash_expected[] = {
-		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
-		0x0d,0x2c,0x02,0x20
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
 	};
-	uint8_t hash_actual[SHA1_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN);
+
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (buffer), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x41122 + sizeof (buffer)), MOCK_ARG_PTR (buffer),
+		MOCK_ARG ((RSA_ENCRYPT_LEN * 2) + 16 - sizeof (buffer)));
+	status |= mock_expect_output (&flash.mock, 1, &data[sizeof (buffer)],
+		sizeof (data) - sizeof (buffer), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha1 (&hash.base);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x12345;
-	regions.length = 4;
+	regions.start_addr = 0x1122;
+	regions.length = (RSA_ENCRYPT_LEN * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
-		&hash.base);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x40000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17748,42 +19534,57 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha1 (CuTest
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	struct flash_region regions[3];
+	uint8_t buffer[1024];
+	uint8_t data[RSA_ENCRYPT_LEN * 3];
 	uint8_t hash_expected[] = {
-		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
-		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
-		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
 	};
-	uint8_t hash_actual[SHA384_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN);
+
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect_output (&flash.mock, 1, data, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75000),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN + 16));
+	status |= mock_expect_output (&flash.mock, 1, &data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_LEN + 16,
+		2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha384 (&hash.base);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions[0].start_addr = 0x1122;
+	regions[0].length = RSA_ENCRYPT_LEN;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
+	regions[1].start_addr = 0x3000;
+	regions[1].length = 0;
+
+	regions[2].start_addr = 0x5000;
+	regions[2].length = RSA_ENCRYPT_LEN + 16;
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x70000, regions, 3,
+		&hash.base, buffer, sizeof (buffer));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17798,43 +19599,59 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha384 (CuTe
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_read_start (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
+	uint8_t data[RSA_ENCRYPT_LEN * 3];
 	uint8_t hash_expected[] = {
-		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
-		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
-		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
-		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
 	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN);
+
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	flash_mock_enable_read_start (&flash);
+
+	status = mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x41122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect_output (&flash.mock, 1, data, RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x41222),
+		MOCK_ARG_PTR (&buffer[RSA_ENCRYPT_LEN]), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect_output (&flash.mock, 1, &data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x41322),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha512 (&hash.base);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.length = (RSA_ENCRYPT_LEN * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x40000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17849,12 +19666,15 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha512 (CuTe
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_read_start_multiple_regions (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[3];
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
+	uint8_t data[RSA_ENCRYPT_LEN * 3];
 	uint8_t hash_expected[] = {
 		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
 		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
@@ -17863,34 +19683,50 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blo
 
 	TEST_START;
 
+	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN);
+
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+	flash_mock_enable_read_start (&flash);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+	status = mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x71122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, data, 16, 2);
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x75000),
+		MOCK_ARG_PTR (&buffer[RSA_ENCRYPT_LEN]), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect_output (&flash.mock, 1, &data[16], RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x75100),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect_output (&flash.mock, 1, &data[RSA_ENCRYPT_LEN + 16], RSA_ENCRYPT_LEN,
+		2);
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 16;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
-		&hash.base);
+	regions[1].start_addr = 0x3000;
+	regions[1].length = 0;
+
+	regions[2].start_addr = 0x5000;
+	regions[2].length = RSA_ENCRYPT_LEN * 2;
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x70000, regions, 3,
+		&hash.base, buffer, sizeof (buffer));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17905,18 +19741,45 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blo
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_zero_length (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_mock_enable_read_start (&flash);
+
+	regions.start_addr = 0x1122;
+	regions.length = 0;
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_update_noncontiguous_contents_buffered_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
 
 	TEST_START;
 
@@ -17926,181 +19789,197 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_reg
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+	status = flash_hash_update_noncontiguous_contents_buffered (NULL, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, NULL, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 0,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		NULL, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, NULL, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_noncontiguous_contents_buffered_test_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
 
-	CuAssertIntEquals (test, 0, status);
+	TEST_START;
 
-	status = hash.base.start_sha256 (&hash.base);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x31122), MOCK_ARG_PTR (buffer), MOCK_ARG (4));
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
-		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_hash_update_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR (buffer), MOCK_ARG (sizeof (data)));
 
-	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_zero_length (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_read_start_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha256 (&hash.base);
-	CuAssertIntEquals (test, 0, status);
+	flash_mock_enable_read_start (&flash);
 
-	regions.start_addr = 0x1122;
-	regions.length = 0;
+	status = mock_expect (&flash.mock, flash.base.read_start, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x31122), MOCK_ARG_PTR (buffer), MOCK_ARG (4));
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash_actual, SHA256_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_read_wait_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	flash_mock_enable_read_start (&flash);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, FLASH_READ_FAILED);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x1122;
+	regions.length = RSA_ENCRYPT_LEN * 2;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		NULL);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_buffered_test_read_start_hash_update_error (
+	CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN * 2];
 
 	TEST_START;
 
@@ -18110,17 +19989,28 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_read_error (
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	flash_mock_enable_read_start (&flash);
+
+	status = mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read_start, &flash, 0, MOCK_ARG (0x31222),
+		MOCK_ARG_PTR (&buffer[RSA_ENCRYPT_LEN]), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR (buffer), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	status |= mock_expect (&flash.mock, flash.base.read_wait, &flash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.length = RSA_ENCRYPT_LEN * 2;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_hash_update_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -18129,135 +20019,198 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_read_error (
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_buffered_test_sha256 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN + 128];
+	uint8_t data[RSA_ENCRYPT_LEN * 3];
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
-		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (buffer), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x41122 + sizeof (buffer)), MOCK_ARG_PTR (buffer),
+		MOCK_ARG ((RSA_ENCRYPT_LEN * 2) + 16 - sizeof (buffer)));
+	status |= mock_expect_output (&flash.mock, 1, &data[sizeof (buffer)],
+		sizeof (data) - sizeof (buffer), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	regions.length = (RSA_ENCRYPT_LEN * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x40000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_buffered_test_null (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
-		MOCK_ARG (1));
+	status = flash_hash_noncontiguous_contents_buffered (NULL, 0x30000, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, NULL, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1, NULL,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, sizeof (hash_actual), buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, 0, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), NULL, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents_buffered (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual), buffer, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_buffered_test_sha256 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[RSA_ENCRYPT_LEN];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_PTR (buffer), MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
+	status = flash_verify_noncontiguous_contents_buffered (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0, buffer, sizeof (buffer));
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void flash_verify_noncontiguous_contents_buffered_test_null_buffer (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t buffer[RSA_ENCRYPT_LEN];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	status = flash_verify_noncontiguous_contents_buffered (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0, NULL, sizeof (buffer));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_buffered (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0, buffer, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
 
@@ -18578,6 +20531,29 @@ TEST (flash_sector_copy_ext_and_verify_test_same_flash_overlapping_source_higher
 TEST (flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block);
 TEST (flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at_source_end);
 TEST (flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at_destination_end);
+TEST (flash_sector_copy_ext_if_changed_test_unchanged);
+TEST (flash_sector_copy_ext_if_changed_test_changed);
+TEST (flash_sector_copy_ext_if_changed_test_multiple_sectors);
+TEST (flash_sector_copy_ext_if_changed_test_multiple_compare_blocks);
+TEST (flash_sector_copy_ext_if_changed_test_same_flash);
+TEST (flash_sector_copy_ext_if_changed_test_null);
+TEST (flash_sector_copy_ext_if_changed_test_no_length);
+TEST (flash_sector_copy_ext_if_changed_test_sector_size_error);
+TEST (flash_sector_copy_ext_if_changed_test_page_size_unsupported);
+TEST (flash_sector_copy_ext_if_changed_test_source_read_error);
+TEST (flash_sector_copy_ext_if_changed_test_destination_read_error);
+TEST (flash_sector_copy_ext_if_changed_test_erase_error);
+TEST (flash_sector_copy_ext_if_changed_test_not_blank);
+TEST (flash_sector_copy_ext_if_changed_test_write_error);
+TEST (flash_sector_copy_ext_if_changed_test_same_flash_overlapping_regions);
+TEST (flash_sector_copy_ext_if_changed_test_same_flash_same_erase_block);
+TEST (flash_sector_copy_ext_if_changed_and_verify_test_changed);
+TEST (flash_sector_copy_ext_if_changed_and_verify_test_unchanged);
+TEST (flash_sector_copy_ext_if_changed_and_verify_test_mismatch);
+TEST (flash_sector_copy_ext_if_changed_and_verify_test_null);
+TEST (flash_sector_copy_ext_if_changed_buffered_test_sector_in_buffer);
+TEST (flash_sector_copy_ext_if_changed_buffered_test_sector_larger_than_buffer);
+TEST (flash_sector_copy_ext_if_changed_buffered_test_null);
 TEST (flash_contents_verification_test_sha256);
 TEST (flash_contents_verification_test_sha256_with_hash_out);
 TEST (flash_contents_verification_test_sha256_no_match_signature);
@@ -18692,5 +20668,21 @@ TEST (flash_hash_update_noncontiguous_contents_at_offset_test_read_error);
 TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks_read_error);
 TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions_read_error);
 TEST (flash_hash_update_noncontiguous_contents_at_offset_test_hash_update_error);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_sha256);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_multiple_blocks);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_multiple_regions);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_read_start);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_read_start_multiple_regions);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_zero_length);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_null);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_read_error);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_hash_update_error);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_read_start_error);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_read_wait_error);
+TEST (flash_hash_update_noncontiguous_contents_buffered_test_read_start_hash_update_error);
+TEST (flash_hash_noncontiguous_contents_buffered_test_sha256);
+TEST (flash_hash_noncontiguous_contents_buffered_test_null);
+TEST (flash_verify_noncontiguous_contents_buffered_test_sha256);
+TEST (flash_verify_noncontiguous_contents_buffered_test_null_buffer);
 
 TEST_SUITE_END;
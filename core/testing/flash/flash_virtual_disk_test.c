@@ -0,0 +1,745 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "flash/flash_virtual_disk.h"
+
+
+TEST_SUITE_LABEL ("flash_virtual_disk");
+
+
+/**
+ * Size of the virtual flash used for testing.  This is not a multiple of the erase chunk size so
+ * erasing the device needs a partial chunk.
+ */
+#define	FLASH_VIRTUAL_DISK_TESTING_SIZE		((VIRTUAL_FLASH_DISK_ERASE_CHUNK * 2) + 512)
+
+
+/**
+ * Dependencies for testing the virtual disk flash.
+ */
+struct flash_virtual_disk_testing {
+	char path[32];								/**< Path to the temporary backing file. */
+	struct flash_virtual_disk_state state;		/**< Variable context for the flash. */
+	struct flash_virtual_disk flash;			/**< The flash being tested. */
+};
+
+
+/**
+ * Create a temporary backing file for the virtual flash filled with a known pattern.
+ *
+ * @param test The testing framework.
+ * @param disk Testing dependencies that will hold the path to the file.
+ */
+static void flash_virtual_disk_testing_create_file (CuTest *test,
+	struct flash_virtual_disk_testing *disk)
+{
+	uint8_t data[FLASH_VIRTUAL_DISK_TESTING_SIZE];
+	size_t i;
+	int fd;
+
+	strcpy (disk->path, "/tmp/flash_virtual_disk_XXXXXX");
+	fd = mkstemp (disk->path);
+	CuAssertTrue (test, (fd >= 0));
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	CuAssertIntEquals (test, sizeof (data), write (fd, data, sizeof (data)));
+	close (fd);
+}
+
+/**
+ * Initialize a virtual flash backed by a temporary file for testing.
+ *
+ * @param test The testing framework.
+ * @param disk Testing dependencies to initialize.
+ */
+static void flash_virtual_disk_testing_init (CuTest *test, struct flash_virtual_disk_testing *disk)
+{
+	int status;
+
+	flash_virtual_disk_testing_create_file (test, disk);
+
+	status = flash_virtual_disk_init (&disk->flash, disk->path, &disk->state,
+		FLASH_VIRTUAL_DISK_TESTING_SIZE);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release virtual flash test dependencies and remove the backing file.
+ *
+ * @param disk Testing dependencies to release.
+ */
+static void flash_virtual_disk_testing_release (struct flash_virtual_disk_testing *disk)
+{
+	flash_virtual_disk_release (&disk->flash);
+	unlink (disk->path);
+}
+
+/**
+ * Read data from the file backing the virtual flash without using the flash API.
+ *
+ * @param test The testing framework.
+ * @param disk Testing dependencies with the backing file.
+ * @param address The address to read from.
+ * @param data Output buffer for the data.
+ * @param length The number of bytes to read.
+ */
+static void flash_virtual_disk_testing_read_file (CuTest *test,
+	struct flash_virtual_disk_testing *disk, uint32_t address, uint8_t *data, size_t length)
+{
+	int fd;
+
+	fd = open (disk->path, O_RDONLY);
+	CuAssertTrue (test, (fd >= 0));
+
+	CuAssertIntEquals (test, length, pread (fd, data, length, address));
+	close (fd);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_virtual_disk_test_init (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	CuAssertPtrNotNull (test, disk.flash.base.get_device_size);
+	CuAssertPtrNotNull (test, disk.flash.base.read);
+	CuAssertPtrNotNull (test, disk.flash.base.get_page_size);
+	CuAssertPtrNotNull (test, disk.flash.base.minimum_write_per_page);
+	CuAssertPtrNotNull (test, disk.flash.base.write);
+	CuAssertPtrNotNull (test, disk.flash.base.get_sector_size);
+	CuAssertPtrNotNull (test, disk.flash.base.sector_erase);
+	CuAssertPtrNotNull (test, disk.flash.base.get_block_size);
+	CuAssertPtrNotNull (test, disk.flash.base.block_erase);
+	CuAssertPtrNotNull (test, disk.flash.base.chip_erase);
+	CuAssertPtrNotNull (test, disk.flash.base.read_start);
+	CuAssertPtrNotNull (test, disk.flash.base.read_wait);
+
+	/* The backing file is not opened until it is first accessed. */
+	CuAssertIntEquals (test, -1, disk.state.fd);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_init_null (CuTest *test)
+{
+	struct flash_virtual_disk_state state;
+	struct flash_virtual_disk flash;
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_disk_init (NULL, "/tmp/flash_virtual_disk", &state, 1024);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_virtual_disk_init (&flash, "/tmp/flash_virtual_disk", NULL, 1024);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_virtual_disk_init (&flash, "/tmp/flash_virtual_disk", &state, 0);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+}
+
+static void flash_virtual_disk_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_virtual_disk_release (NULL);
+}
+
+static void flash_virtual_disk_test_get_device_size (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint32_t bytes;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.get_device_size (&disk.flash.base, &bytes);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_VIRTUAL_DISK_TESTING_SIZE, bytes);
+
+	status = disk.flash.base.get_device_size (NULL, &bytes);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = disk.flash.base.get_device_size (&disk.flash.base, NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t expected[64];
+	uint8_t data[64];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	for (i = 0; i < sizeof (expected); i++) {
+		expected[i] = 0x10 + i;
+	}
+
+	status = disk.flash.base.read (&disk.flash.base, 0x10, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_keeps_file_open (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int fd;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	fd = disk.state.fd;
+	CuAssertTrue (test, (fd >= 0));
+
+	/* Later operations use the same descriptor instead of opening the file again. */
+	status = disk.flash.base.read (&disk.flash.base, 0x100, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, fd, disk.state.fd);
+
+	status = disk.flash.base.write (&disk.flash.base, 0x100, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+	CuAssertIntEquals (test, fd, disk.state.fd);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_null (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read (NULL, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = disk.flash.base.read (&disk.flash.base, 0, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_out_of_range (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read (&disk.flash.base, FLASH_VIRTUAL_DISK_TESTING_SIZE, data,
+		sizeof (data));
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	status = disk.flash.base.read (&disk.flash.base, FLASH_VIRTUAL_DISK_TESTING_SIZE - 8, data,
+		sizeof (data));
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	/* Nothing was accessed. */
+	CuAssertIntEquals (test, -1, disk.state.fd);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_no_file (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+	unlink (disk.path);
+
+	status = disk.flash.base.read (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, -1, disk.state.fd);
+
+	status = disk.flash.base.write (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_past_end_of_file (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	struct flash_virtual_disk_state state;
+	struct flash_virtual_disk flash;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_create_file (test, &disk);
+
+	/* The device is larger than the backing file. */
+	status = flash_virtual_disk_init (&flash, disk.path, &state,
+		FLASH_VIRTUAL_DISK_TESTING_SIZE * 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash.base.read (&flash.base, FLASH_VIRTUAL_DISK_TESTING_SIZE, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	flash_virtual_disk_release (&flash);
+	unlink (disk.path);
+}
+
+static void flash_virtual_disk_test_read_only_file (CuTest *test)
+{
+	struct flash_virtual_disk_state state;
+	struct flash_virtual_disk flash;
+	uint8_t expected[16];
+	uint8_t data[16];
+	int fd;
+	int status;
+
+	TEST_START;
+
+	/* The running test executable can't be opened for writing, even with elevated privileges. */
+	fd = open ("/proc/self/exe", O_RDONLY);
+	CuAssertTrue (test, (fd >= 0));
+
+	CuAssertIntEquals (test, sizeof (expected), pread (fd, expected, sizeof (expected), 0));
+	close (fd);
+
+	status = flash_virtual_disk_init (&flash, "/proc/self/exe", &state, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash.base.read (&flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash.base.write (&flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	status = flash.base.sector_erase (&flash.base, 0);
+	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, status);
+
+	flash_virtual_disk_release (&flash);
+}
+
+static void flash_virtual_disk_test_write (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[64];
+	uint8_t check[64];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = ~i;
+	}
+
+	status = disk.flash.base.write (&disk.flash.base, 0x220, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	/* Written data is visible to other readers of the file without a sync. */
+	flash_virtual_disk_testing_read_file (test, &disk, 0x220, check, sizeof (check));
+
+	status = testing_validate_array (data, check, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_write_null (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.write (NULL, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = disk.flash.base.write (&disk.flash.base, 0, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_write_out_of_range (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.write (&disk.flash.base, FLASH_VIRTUAL_DISK_TESTING_SIZE - 8, data,
+		sizeof (data));
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_file_rewritten_in_place (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t expected[FLASH_VIRTUAL_DISK_TESTING_SIZE];
+	uint8_t data[64];
+	FILE *file;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Rewrite the file the same way the virtual disk setup script does while it is open. */
+	memset (expected, 0x5a, sizeof (expected));
+
+	file = fopen (disk.path, "wb");
+	CuAssertPtrNotNull (test, file);
+	CuAssertIntEquals (test, sizeof (expected), fwrite (expected, 1, sizeof (expected), file));
+	fclose (file);
+
+	status = disk.flash.base.read (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_block_erase (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t expected[VIRTUAL_FLASH_DISK_BLOCK_SIZE * 3];
+	uint8_t data[VIRTUAL_FLASH_DISK_BLOCK_SIZE * 3];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	for (i = 0; i < sizeof (expected); i++) {
+		expected[i] = i;
+	}
+	memset (&expected[VIRTUAL_FLASH_DISK_BLOCK_SIZE], 0xff, VIRTUAL_FLASH_DISK_BLOCK_SIZE);
+
+	/* Any address in the block erases the whole block. */
+	status = disk.flash.base.block_erase (&disk.flash.base, VIRTUAL_FLASH_DISK_BLOCK_SIZE + 0x10);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_read_file (test, &disk, 0, data, sizeof (data));
+
+	status = testing_validate_array (expected, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_block_erase_out_of_range (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.block_erase (NULL, 0);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = disk.flash.base.block_erase (&disk.flash.base, FLASH_VIRTUAL_DISK_TESTING_SIZE);
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_chip_erase (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t expected[FLASH_VIRTUAL_DISK_TESTING_SIZE];
+	uint8_t data[FLASH_VIRTUAL_DISK_TESTING_SIZE];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	memset (expected, 0xff, sizeof (expected));
+
+	/* The device is erased in multiple chunks, with the last one being partial. */
+	status = disk.flash.base.chip_erase (&disk.flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_read_file (test, &disk, 0, data, sizeof (data));
+
+	status = testing_validate_array (expected, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = disk.flash.base.chip_erase (NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_start (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t expected[VIRTUAL_FLASH_DISK_ERASE_CHUNK];
+	uint8_t data[VIRTUAL_FLASH_DISK_ERASE_CHUNK];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	for (i = 0; i < sizeof (expected); i++) {
+		expected[i] = 0x20 + i;
+	}
+
+	status = disk.flash.base.read_start (&disk.flash.base, 0x20, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = disk.flash.base.read_wait (&disk.flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The completed read can't be waited on again. */
+	status = disk.flash.base.read_wait (&disk.flash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_start_already_pending (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[64];
+	uint8_t other[64];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read_start (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = disk.flash.base.read_start (&disk.flash.base, 0x100, other, sizeof (other));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = disk.flash.base.read_wait (&disk.flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_start_release_pending (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[VIRTUAL_FLASH_DISK_ERASE_CHUNK];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read_start (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The read completes before the file is closed. */
+	flash_virtual_disk_testing_release (&disk);
+	CuAssertIntEquals (test, false, disk.state.read_pending);
+}
+
+static void flash_virtual_disk_test_read_start_null (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read_start (NULL, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = disk.flash.base.read_start (&disk.flash.base, 0, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = disk.flash.base.read_wait (NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_read_start_out_of_range (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read_start (&disk.flash.base, FLASH_VIRTUAL_DISK_TESTING_SIZE - 8,
+		data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	status = disk.flash.base.read_wait (&disk.flash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_release_closes_file (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int fd;
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	status = disk.flash.base.read (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	fd = disk.state.fd;
+	CuAssertTrue (test, (fd >= 0));
+
+	flash_virtual_disk_testing_release (&disk);
+	CuAssertIntEquals (test, -1, disk.state.fd);
+
+	status = fcntl (fd, F_GETFD);
+	CuAssertIntEquals (test, -1, status);
+	CuAssertIntEquals (test, EBADF, errno);
+}
+
+static void flash_virtual_disk_test_sync (CuTest *test)
+{
+	struct flash_virtual_disk_testing disk;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	flash_virtual_disk_testing_init (test, &disk);
+
+	/* There is nothing to flush before the file has been opened. */
+	status = flash_virtual_disk_sync (&disk.flash);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, -1, disk.state.fd);
+
+	memset (data, 0x33, sizeof (data));
+
+	status = disk.flash.base.write (&disk.flash.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = flash_virtual_disk_sync (&disk.flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_disk_testing_release (&disk);
+}
+
+static void flash_virtual_disk_test_sync_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_disk_sync (NULL);
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+}
+
+
+TEST_SUITE_START (flash_virtual_disk);
+
+TEST (flash_virtual_disk_test_init);
+TEST (flash_virtual_disk_test_init_null);
+TEST (flash_virtual_disk_test_release_null);
+TEST (flash_virtual_disk_test_get_device_size);
+TEST (flash_virtual_disk_test_read);
+TEST (flash_virtual_disk_test_read_keeps_file_open);
+TEST (flash_virtual_disk_test_read_null);
+TEST (flash_virtual_disk_test_read_out_of_range);
+TEST (flash_virtual_disk_test_read_no_file);
+TEST (flash_virtual_disk_test_read_past_end_of_file);
+TEST (flash_virtual_disk_test_read_only_file);
+TEST (flash_virtual_disk_test_write);
+TEST (flash_virtual_disk_test_write_null);
+TEST (flash_virtual_disk_test_write_out_of_range);
+TEST (flash_virtual_disk_test_file_rewritten_in_place);
+TEST (flash_virtual_disk_test_block_erase);
+TEST (flash_virtual_disk_test_block_erase_out_of_range);
+TEST (flash_virtual_disk_test_chip_erase);
+TEST (flash_virtual_disk_test_read_start);
+TEST (flash_virtual_disk_test_read_start_already_pending);
+TEST (flash_virtual_disk_test_read_start_release_pending);
+TEST (flash_virtual_disk_test_read_start_null);
+TEST (flash_virtual_disk_test_read_start_out_of_range);
+TEST (flash_virtual_disk_test_release_closes_file);
+TEST (flash_virtual_disk_test_sync);
+TEST (flash_virtual_disk_test_sync_null);
+
+TEST_SUITE_END;
@@ -7,7 +7,10 @@
 #include "testing.h"
 #include "host_fw/host_flash_manager_dual.h"
 #include "host_fw/host_state_manager.h"
+#include "host_fw/host_fw_util.h"
 #include "flash/flash_common.h"
+#include "testing/mock/crypto/hash_mock.h"
+#include "testing/mock/crypto/rsa_mock.h"
 #include "testing/mock/flash/flash_master_mock.h"
 #include "testing/mock/host_fw/host_control_mock.h"
 #include "testing/mock/manifest/pfm_mock.h"
@@ -669,10 +672,9 @@ static void host_flash_manager_dual_test_swap_flash_devices_cs1 (CuTest *test)
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_1));
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -727,10 +729,9 @@ static void host_flash_manager_dual_test_swap_flash_devices_cs0 (CuTest *test)
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_0));
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock1, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -789,10 +790,9 @@ static void host_flash_manager_dual_test_swap_flash_devices_activate_pending_pfm
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_1));
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
 	status |= mock_expect (&pending.mock, pending.base.base.activate_pending_manifest, &pending, 0);
 
@@ -902,18 +902,17 @@ static void host_flash_manager_dual_test_swap_flash_devices_cs1_multiple_fw (CuT
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_1));
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x30000, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16,
+		HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x50000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -982,18 +981,17 @@ static void host_flash_manager_dual_test_swap_flash_devices_cs0_multiple_fw (CuT
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_0));
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock1, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock1, 0x30000, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock1,
-		&manager.flash_mock0, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock1, &manager.flash_mock0, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16,
+		HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock1, 0x50000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock1,
-		&manager.flash_mock0, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock1, &manager.flash_mock0, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -1196,7 +1194,7 @@ static void host_flash_manager_dual_test_swap_flash_devices_cs1_data_copy_error
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_1));
 
-	status |= flash_master_mock_expect_xfer (&manager.flash_mock0, FLASH_MASTER_XFER_FAILED,
+	status |= flash_master_mock_expect_xfer (&manager.flash_mock1, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
@@ -1252,7 +1250,7 @@ static void host_flash_manager_dual_test_swap_flash_devices_cs0_data_copy_error
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_0));
 
-	status |= flash_master_mock_expect_xfer (&manager.flash_mock1, FLASH_MASTER_XFER_FAILED,
+	status |= flash_master_mock_expect_xfer (&manager.flash_mock0, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
@@ -1313,10 +1311,9 @@ static void host_flash_manager_dual_test_swap_flash_devices_activate_pending_pfm
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.set_ro_cs, &manager.filter, 0,
 		MOCK_ARG (SPI_FILTER_CS_1));
 
-	status |= flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
 	status |= mock_expect (&pending.mock, pending.base.base.activate_pending_manifest, &pending,
 		MANIFEST_MANAGER_NONE_PENDING);
@@ -1561,6 +1558,166 @@ static void host_flash_manager_dual_test_validate_read_only_flash_cs0 (CuTest *t
 	host_flash_manager_dual_testing_validate_and_release (test, &manager);
 }
 
+static void host_flash_manager_dual_test_validate_read_only_flash_cs0_verify_scheduler (CuTest *test)
+{
+	struct host_flash_manager_dual_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct hash_engine_mock hash;
+	struct rsa_engine_mock rsa;
+	struct host_fw_verify_worker worker;
+	struct host_fw_verify_scheduler_state verify_state;
+	struct host_fw_verify_scheduler verify;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_dual_testing_init (test, &manager, false);
+
+	/* Images are verified with the scheduler engines, so the engines passed in are not used. */
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_init (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	worker.hash = &manager.hash.base;
+	worker.rsa = &manager.rsa.base;
+
+	status = host_fw_verify_scheduler_init (&verify, &verify_state, &worker, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_dual_set_verify_scheduler (&manager.test, &verify);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	status |= spi_flash_set_device_size (&manager.flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_only_flash (&manager.test.base, &manager.pfm.base,
+		NULL, &hash.base, &rsa.base, false, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	CuAssertIntEquals (test, 1, rw_output.writable->count);
+	CuAssertPtrEquals (test, &rw_region, (void*) rw_output.writable->regions);
+	CuAssertPtrEquals (test, &rw_prop, (void*) rw_output.writable->properties);
+
+	status = mock_validate (&manager.flash_mock0.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_validate_and_release (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_release (&verify);
+	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+}
+
+static void host_flash_manager_dual_test_set_verify_scheduler_null (CuTest *test)
+{
+	TEST_START;
+
+	host_flash_manager_dual_set_verify_scheduler (NULL, NULL);
+}
+
 static void host_flash_manager_dual_test_validate_read_only_flash_cs1 (CuTest *test)
 {
 	struct host_flash_manager_dual_testing manager;
@@ -9604,10 +9761,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs0_3byte_c
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -9667,10 +9823,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs1_3byte_c
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -9736,10 +9891,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs0_4byte_c
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -9805,10 +9959,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs1_4byte_c
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -9873,10 +10026,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs0_4byte_c
 
 	status = flash_master_mock_expect_xfer (&manager.flash_mock1, 0, FLASH_EXP_OPCODE (0xb7));
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -9941,10 +10093,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs1_4byte_c
 
 	status = flash_master_mock_expect_xfer (&manager.flash_mock0, 0, FLASH_EXP_OPCODE (0xb7));
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10009,10 +10160,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs0_3byte_c
 
 	status = flash_master_mock_expect_xfer (&manager.flash_mock1, 0, FLASH_EXP_OPCODE (0xe9));
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10077,10 +10227,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs1_3byte_c
 
 	status = flash_master_mock_expect_xfer (&manager.flash_mock0, 0, FLASH_EXP_OPCODE (0xe9));
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10159,10 +10308,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_fixed_3byte
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify (&manager.flash_mock1, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10239,10 +10387,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_fixed_4byte
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify (&manager.flash_mock1, 0x10000,
-		RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN, HOST_FW_COPY_BLOCK);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10313,20 +10460,15 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs0_multipl
 	rw_host.writable = rw_list;
 	rw_host.count = 3;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x30000, 16);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16);
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x50000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10399,20 +10541,15 @@ static void host_flash_manager_dual_test_initialize_flash_protection_cs1_multipl
 	rw_host.writable = rw_list;
 	rw_host.count = 3;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x30000, 16);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16);
 
-	status |= flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock0,
-		0x50000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock0,
-		&manager.flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock0, &manager.flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10572,7 +10709,7 @@ static void host_flash_manager_dual_test_initialize_flash_protection_data_copy_e
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_xfer (&manager.flash_mock1, FLASH_MASTER_XFER_FAILED,
+	status = flash_master_mock_expect_xfer (&manager.flash_mock0, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
@@ -10624,10 +10761,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_dirty_clear
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, SPI_FILTER_CLEAR_DIRTY_FAILED);
@@ -10681,10 +10817,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_filter_addr
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10740,10 +10875,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_filter_flas
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -10800,10 +10934,9 @@ static void host_flash_manager_dual_test_initialize_flash_protection_filter_erro
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify_4byte_explicit (&manager.flash_mock1,
-		0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (&manager.flash_mock1,
-		&manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+		&manager.flash_mock1, &manager.flash_mock0, 0x10000, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
 
 	status |= mock_expect (&manager.filter.mock, manager.filter.base.clear_flash_dirty_state,
 		&manager.filter, 0);
@@ -12476,9 +12609,9 @@ static void host_flash_manager_dual_test_restore_flash_read_write_regions_cs0 (C
 	rw_host.writable = &rw_list;
 	rw_host.count = 1;
 
-	status = flash_master_mock_expect_erase_flash_verify (&manager.flash_mock0, 0x20000, 0x10000);
-	status |= flash_master_mock_expect_copy_flash_verify (&manager.flash_mock0,
-		&manager.flash_mock1, 0x20000, 0x20000, data, sizeof (data));
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&manager.flash_mock0, &manager.flash_mock1, 0x20000, 0x20000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12785,6 +12918,8 @@ TEST (host_flash_manager_dual_test_config_spi_filter_flash_devices_cs1);
 TEST (host_flash_manager_dual_test_config_spi_filter_flash_devices_null);
 TEST (host_flash_manager_dual_test_config_spi_filter_flash_devices_error);
 TEST (host_flash_manager_dual_test_validate_read_only_flash_cs0);
+TEST (host_flash_manager_dual_test_validate_read_only_flash_cs0_verify_scheduler);
+TEST (host_flash_manager_dual_test_set_verify_scheduler_null);
 TEST (host_flash_manager_dual_test_validate_read_only_flash_cs1);
 TEST (host_flash_manager_dual_test_validate_read_only_flash_single_fw);
 TEST (host_flash_manager_dual_test_validate_read_only_flash_multiple_fw);
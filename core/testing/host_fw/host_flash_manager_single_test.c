@@ -8,6 +8,8 @@
 #include "host_fw/host_flash_manager_single.h"
 #include "host_fw/host_state_manager.h"
 #include "flash/flash_common.h"
+#include "testing/mock/crypto/hash_mock.h"
+#include "testing/mock/crypto/rsa_mock.h"
 #include "testing/mock/flash/flash_master_mock.h"
 #include "testing/mock/host_fw/host_control_mock.h"
 #include "testing/mock/manifest/pfm_mock.h"
@@ -1221,6 +1223,165 @@ static void host_flash_manager_single_test_validate_read_only_flash (CuTest *tes
 	host_flash_manager_single_testing_validate_and_release (test, &manager);
 }
 
+static void host_flash_manager_single_test_validate_read_only_flash_verify_scheduler (CuTest *test)
+{
+	struct host_flash_manager_single_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct hash_engine_mock hash;
+	struct rsa_engine_mock rsa;
+	struct host_fw_verify_worker worker;
+	struct host_fw_verify_scheduler_state verify_state;
+	struct host_fw_verify_scheduler verify;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_single_testing_init (test, &manager);
+
+	/* Images are verified with the scheduler engines, so the engines passed in are not used. */
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_init (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	worker.hash = &manager.hash.base;
+	worker.rsa = &manager.rsa.base;
+
+	status = host_fw_verify_scheduler_init (&verify, &verify_state, &worker, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_single_set_verify_scheduler (&manager.test, &verify);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_only_flash (&manager.test.base, &manager.pfm.base,
+		NULL, &hash.base, &rsa.base, false, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	CuAssertIntEquals (test, 1, rw_output.writable->count);
+	CuAssertPtrEquals (test, &rw_region, (void*) rw_output.writable->regions);
+	CuAssertPtrEquals (test, &rw_prop, (void*) rw_output.writable->properties);
+
+	status = mock_validate (&manager.flash_mock0.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_validate_and_release (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_release (&verify);
+	host_flash_manager_single_testing_validate_and_release (test, &manager);
+}
+
+static void host_flash_manager_single_test_set_verify_scheduler_null (CuTest *test)
+{
+	TEST_START;
+
+	host_flash_manager_single_set_verify_scheduler (NULL, NULL);
+}
+
 static void host_flash_manager_single_test_validate_read_only_flash_single_fw (CuTest *test)
 {
 	struct host_flash_manager_single_testing manager;
@@ -9991,6 +10152,8 @@ TEST (host_flash_manager_single_test_config_spi_filter_flash_devices_null);
 TEST (host_flash_manager_single_test_config_spi_filter_flash_devices_allow_writes_error);
 TEST (host_flash_manager_single_test_config_spi_filter_flash_devices_mode_error);
 TEST (host_flash_manager_single_test_validate_read_only_flash);
+TEST (host_flash_manager_single_test_validate_read_only_flash_verify_scheduler);
+TEST (host_flash_manager_single_test_set_verify_scheduler_null);
 TEST (host_flash_manager_single_test_validate_read_only_flash_single_fw);
 TEST (host_flash_manager_single_test_validate_read_only_flash_multiple_fw);
 TEST (host_flash_manager_single_test_validate_read_only_flash_full_validation);
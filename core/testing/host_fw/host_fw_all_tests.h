@@ -51,6 +51,12 @@ static void add_all_host_fw_tests (CuSuite *suite)
 	!defined TESTING_SKIP_HOST_FW_UTIL_SUITE
 	TESTING_RUN_SUITE (host_fw_util);
 #endif
+#if (defined TESTING_RUN_HOST_FW_VERIFY_SCHEDULER_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_HOST_FW_VERIFY_SCHEDULER_SUITE
+	TESTING_RUN_SUITE (host_fw_verify_scheduler);
+#endif
 #if (defined TESTING_RUN_HOST_IRQ_HANDLER_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -6,12 +6,16 @@
 #include <string.h>
 #include "testing.h"
 #include "host_fw/host_fw_util.h"
+#include "host_fw/host_logging.h"
+#include "logging/debug_log.h"
 #include "testing/mock/flash/flash_master_mock.h"
+#include "testing/mock/logging/logging_mock.h"
 #include "testing/mock/spi_filter/spi_filter_interface_mock.h"
 #include "testing/engines/hash_testing_engine.h"
 #include "testing/engines/rsa_testing_engine.h"
 #include "testing/crypto/rsa_testing.h"
 #include "testing/crypto/hash_testing.h"
+#include "testing/logging/debug_log_testing.h"
 
 
 TEST_SUITE_LABEL ("host_fw_util");
@@ -5927,9 +5931,70 @@ static void host_fw_migrate_read_write_data_test (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = RSA_ENCRYPT_LEN;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_unchanged (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_copy_flash_if_changed_unchanged_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -5988,16 +6053,15 @@ static void host_fw_migrate_read_write_data_test_multiple_regions (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
-
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
-		0x30000, RSA_ENCRYPT_TEST2, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
-		0x50000, RSA_ENCRYPT_NOPE, 32);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16,
+		HOST_FW_COPY_BLOCK);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -6864,16 +6928,15 @@ static void host_fw_migrate_read_write_data_test_multiple_diff_ordering (CuTest
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
-
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
-		0x30000, RSA_ENCRYPT_TEST2, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
-		0x50000, RSA_ENCRYPT_NOPE, 32);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16,
+		HOST_FW_COPY_BLOCK);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -6953,9 +7016,9 @@ static void host_fw_migrate_read_write_data_test_no_source_regions (CuTest *test
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -7075,7 +7138,11 @@ static void host_fw_migrate_read_write_data_test_erase_error (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+	status = flash_master_mock_expect_verify_flash (&flash_mock1, 0x10000, RSA_ENCRYPT_TEST,
+		RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_verify_flash (&flash_mock2, 0x10000, flash_mock2.blank,
+		RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
@@ -7141,11 +7208,7 @@ static void host_fw_migrate_read_write_data_test_copy_error (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
-
-	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+	status = flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
@@ -11755,9 +11818,9 @@ static void host_fw_restore_read_write_data_test_restore_flash (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, 0x10000);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, data, sizeof (data));
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -11783,7 +11846,7 @@ static void host_fw_restore_read_write_data_test_restore_flash (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_restore_flash_no_source_device (CuTest *test)
+static void host_fw_restore_read_write_data_test_restore_flash_unchanged (CuTest *test)
 {
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
@@ -11795,9 +11858,15 @@ static void host_fw_restore_read_write_data_test_restore_flash_no_source_device
 	struct spi_flash_state state2;
 	struct spi_flash flash2;
 	int status;
+	uint8_t data[0x10000];
+	size_t i;
 
 	TEST_START;
 
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
@@ -11816,6 +11885,12 @@ static void host_fw_restore_read_write_data_test_restore_flash_no_source_device
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_master_mock_expect_copy_flash_if_changed_unchanged_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
+
+	CuAssertIntEquals (test, 0, status);
+
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
@@ -11825,7 +11900,7 @@ static void host_fw_restore_read_write_data_test_restore_flash_no_source_device
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_restore_read_write_data (&flash2, NULL, &rw_list);
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
@@ -11838,7 +11913,7 @@ static void host_fw_restore_read_write_data_test_restore_flash_no_source_device
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_reserved (CuTest *test)
+static void host_fw_restore_read_write_data_test_restore_flash_debug_log (CuTest *test)
 {
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
@@ -11849,16 +11924,34 @@ static void host_fw_restore_read_write_data_test_reserved (CuTest *test)
 	struct flash_master_mock flash_mock2;
 	struct spi_flash_state state2;
 	struct spi_flash flash2;
+	struct logging_mock logger;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = DEBUG_LOG_SEVERITY_INFO,
+		.component = DEBUG_LOG_COMPONENT_HOST_FW,
+		.msg_index = HOST_LOGGING_RW_DATA_COPIED,
+		.arg1 = 0x10000,
+		.arg2 = 0x10000
+	};
 	int status;
+	uint8_t data[0x10000];
+	size_t i;
 
 	TEST_START;
 
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_init (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
 
+	status = logging_mock_init (&logger);
+	CuAssertIntEquals (test, 0, status);
+
 	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
 	CuAssertIntEquals (test, 0, status);
 
@@ -11871,32 +11964,49 @@ static void host_fw_restore_read_write_data_test_reserved (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
+
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS ((uint8_t*) &entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
-	rw_prop.on_failure = PFM_RW_RESERVED;
+	rw_prop.on_failure = PFM_RW_RESTORE;
 
 	rw_list.regions = &rw_region;
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
+	debug_log = &logger.base;
+
 	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
+	debug_log = NULL;
+
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
 
+	status = logging_mock_validate_and_release (&logger);
+	CuAssertIntEquals (test, 0, status);
+
 	spi_flash_release (&flash1);
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_multiple_regions (CuTest *test)
+static void host_fw_restore_read_write_data_test_restore_flash_unchanged_debug_log (CuTest *test)
 {
-	struct flash_region rw_region[4];
-	struct pfm_read_write rw_prop[4];
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
 	struct pfm_read_write_regions rw_list;
 	struct flash_master_mock flash_mock1;
 	struct spi_flash_state state1;
@@ -11904,6 +12014,7 @@ static void host_fw_restore_read_write_data_test_multiple_regions (CuTest *test)
 	struct flash_master_mock flash_mock2;
 	struct spi_flash_state state2;
 	struct spi_flash flash2;
+	struct logging_mock logger;
 	int status;
 	uint8_t data[0x10000];
 	size_t i;
@@ -11920,6 +12031,9 @@ static void host_fw_restore_read_write_data_test_multiple_regions (CuTest *test)
 	status = flash_master_mock_init (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
 
+	status = logging_mock_init (&logger);
+	CuAssertIntEquals (test, 0, status);
+
 	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
 	CuAssertIntEquals (test, 0, status);
 
@@ -11932,49 +12046,43 @@ static void host_fw_restore_read_write_data_test_multiple_regions (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	for (i = 0; i < 3; i++) {
-		status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000 + (0x10000 * i));
-	}
-	status |= flash_master_mock_expect_blank_check (&flash_mock2, 0x40000, 0x30000);
-
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x100000, 0x10000);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x100000,
-		0x100000, data, sizeof (data));
+	/* No sectors are programmed, so nothing is logged. */
+	status = flash_master_mock_expect_copy_flash_if_changed_unchanged_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x10000;
-	rw_region[1].start_addr = 0x40000;
-	rw_region[1].length = 0x30000;
-	rw_region[2].start_addr = 0x100000;
-	rw_region[2].length = 0x10000;
-	rw_region[3].start_addr = 0x500000;
-	rw_region[3].length = 0x100000;
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_ERASE;
-	rw_prop[2].on_failure = PFM_RW_RESTORE;
-	rw_prop[3].on_failure = PFM_RW_RESERVED;
+	rw_prop.on_failure = PFM_RW_RESTORE;
 
-	rw_list.regions = rw_region;
-	rw_list.properties = rw_prop;
-	rw_list.count = 4;
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	debug_log = &logger.base;
 
 	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
+	debug_log = NULL;
+
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
 
+	status = logging_mock_validate_and_release (&logger);
+	CuAssertIntEquals (test, 0, status);
+
 	spi_flash_release (&flash1);
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_null (CuTest *test)
+static void host_fw_restore_read_write_data_test_restore_flash_no_source_device (CuTest *test)
 {
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
@@ -12010,17 +12118,14 @@ static void host_fw_restore_read_write_data_test_null (CuTest *test)
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
-	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+	rw_prop.on_failure = PFM_RW_RESTORE;
 
 	rw_list.regions = &rw_region;
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_restore_read_write_data (NULL, &flash1, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
-
-	status = host_fw_restore_read_write_data (&flash2, &flash1, NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	status = host_fw_restore_read_write_data (&flash2, NULL, &rw_list);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -12032,7 +12137,7 @@ static void host_fw_restore_read_write_data_test_null (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_erase_flash_error (CuTest *test)
+static void host_fw_restore_read_write_data_test_reserved (CuTest *test)
 {
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
@@ -12065,21 +12170,17 @@ static void host_fw_restore_read_write_data_test_erase_flash_error (CuTest *test
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-	CuAssertIntEquals (test, 0, status);
-
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
-	rw_prop.on_failure = PFM_RW_ERASE;
+	rw_prop.on_failure = PFM_RW_RESERVED;
 
 	rw_list.regions = &rw_region;
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
 	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -12091,10 +12192,10 @@ static void host_fw_restore_read_write_data_test_erase_flash_error (CuTest *test
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *test)
+static void host_fw_restore_read_write_data_test_multiple_regions (CuTest *test)
 {
-	struct flash_region rw_region;
-	struct pfm_read_write rw_prop;
+	struct flash_region rw_region[4];
+	struct pfm_read_write rw_prop[4];
 	struct pfm_read_write_regions rw_list;
 	struct flash_master_mock flash_mock1;
 	struct spi_flash_state state1;
@@ -12103,9 +12204,15 @@ static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *te
 	struct spi_flash_state state2;
 	struct spi_flash flash2;
 	int status;
+	uint8_t data[0x10000];
+	size_t i;
 
 	TEST_START;
 
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
@@ -12124,21 +12231,37 @@ static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *te
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	for (i = 0; i < 3; i++) {
+		status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000 + (0x10000 * i));
+	}
+	status |= flash_master_mock_expect_blank_check (&flash_mock2, 0x40000, 0x30000);
+
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x100000, 0x100000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
+
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x10000;
+	rw_region[1].start_addr = 0x40000;
+	rw_region[1].length = 0x30000;
+	rw_region[2].start_addr = 0x100000;
+	rw_region[2].length = 0x10000;
+	rw_region[3].start_addr = 0x500000;
+	rw_region[3].length = 0x100000;
 
-	rw_prop.on_failure = PFM_RW_RESTORE;
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_ERASE;
+	rw_prop[2].on_failure = PFM_RW_RESTORE;
+	rw_prop[3].on_failure = PFM_RW_RESERVED;
 
-	rw_list.regions = &rw_region;
-	rw_list.properties = &rw_prop;
-	rw_list.count = 1;
+	rw_list.regions = rw_region;
+	rw_list.properties = rw_prop;
+	rw_list.count = 4;
 
 	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -12150,10 +12273,10 @@ static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *te
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_read_write_data_test_multiple_regions_error (CuTest *test)
+static void host_fw_restore_read_write_data_test_null (CuTest *test)
 {
-	struct flash_region rw_region[4];
-	struct pfm_read_write rw_prop[4];
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
 	struct pfm_read_write_regions rw_list;
 	struct flash_master_mock flash_mock1;
 	struct spi_flash_state state1;
@@ -12183,30 +12306,20 @@ static void host_fw_restore_read_write_data_test_multiple_regions_error (CuTest
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-	CuAssertIntEquals (test, 0, status);
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
 
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x10000;
-	rw_region[1].start_addr = 0x40000;
-	rw_region[1].length = 0x30000;
-	rw_region[2].start_addr = 0x100000;
-	rw_region[2].length = 0x10000;
-	rw_region[3].start_addr = 0x500000;
-	rw_region[3].length = 0x100000;
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_ERASE;
-	rw_prop[2].on_failure = PFM_RW_RESTORE;
-	rw_prop[3].on_failure = PFM_RW_RESERVED;
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
 
-	rw_list.regions = rw_region;
-	rw_list.properties = rw_prop;
-	rw_list.count = 4;
+	status = host_fw_restore_read_write_data (NULL, &flash1, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = host_fw_restore_read_write_data (&flash2, &flash1, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -12218,19 +12331,205 @@ static void host_fw_restore_read_write_data_test_multiple_regions_error (CuTest
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_verify_images_multiple_fw_test (CuTest *test)
+static void host_fw_restore_read_write_data_test_erase_flash_error (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list list;
-	struct flash_master_mock flash_mock;
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
-	int status;
-	char *data = "Test";
-
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_ERASE;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_RESTORE;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_read_write_data_test_multiple_regions_error (CuTest *test)
+{
+	struct flash_region rw_region[4];
+	struct pfm_read_write rw_prop[4];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x10000;
+	rw_region[1].start_addr = 0x40000;
+	rw_region[1].length = 0x30000;
+	rw_region[2].start_addr = 0x100000;
+	rw_region[2].length = 0x10000;
+	rw_region[3].start_addr = 0x500000;
+	rw_region[3].length = 0x100000;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_ERASE;
+	rw_prop[2].on_failure = PFM_RW_RESTORE;
+	rw_prop[3].on_failure = PFM_RW_RESERVED;
+
+	rw_list.regions = rw_region;
+	rw_list.properties = rw_prop;
+	rw_list.count = 4;
+
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_verify_images_multiple_fw_test (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
@@ -12902,27 +13201,513 @@ static void host_fw_verify_offset_images_multiple_fw_test_invalid (CuTest *test)
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	list.images_sig = &sig;
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test)
+{
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[3];
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
+
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTest *test)
+{
+	struct flash_region region[3];
+	struct pfm_image_hash img_hash[3];
+	struct pfm_image_list list[3];
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
+
+	img_hash[0].regions = &region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
+
+	img_hash[1].regions = &region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA384_TEST2_HASH, SHA384_HASH_LENGTH);
+	img_hash[1].hash_length = SHA384_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA384;
+	img_hash[1].always_validate = 1;
+
+	img_hash[2].regions = &region[2];
+	img_hash[2].count = 1;
+	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
+	img_hash[2].hash_length = SHA512_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA512;
+	img_hash[2].always_validate = 1;
+
+	list[0].images_hash = &img_hash[0];
+	list[0].images_sig = NULL;
+	list[0].count = 1;
+
+	list[1].images_hash = &img_hash[1];
+	list[1].images_sig = NULL;
+	list[1].count = 1;
+
+	list[2].images_hash = &img_hash[2];
+	list[2].images_sig = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_null (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (NULL, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, NULL, 1, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, NULL,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_is_image_validation_required_test (CuTest *test)
+{
+	struct pfm_image_signature sig[2];
+	struct pfm_image_hash img_hash[2];
+	struct pfm_image_list list;
+
+	TEST_START;
+
+	sig[0].always_validate = 1;
+	sig[1].always_validate = 0;
+
+	list.images_sig = sig;
 	list.images_hash = NULL;
-	list.count = 1;
+	list.count = 2;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, true, host_fw_is_image_validation_required (&list, 0));
+	CuAssertIntEquals (test, false, host_fw_is_image_validation_required (&list, 1));
 
-	status = flash_master_mock_validate_and_release (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
+	img_hash[0].always_validate = 0;
+	img_hash[1].always_validate = 1;
 
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
+	list.images_sig = NULL;
+	list.images_hash = img_hash;
+
+	CuAssertIntEquals (test, false, host_fw_is_image_validation_required (&list, 0));
+	CuAssertIntEquals (test, true, host_fw_is_image_validation_required (&list, 1));
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test)
+static void host_fw_verify_offset_image_test (CuTest *test)
 {
-	struct flash_region region[3];
-	struct pfm_image_signature sig[3];
-	struct pfm_image_list list[3];
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -12931,7 +13716,6 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
-	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -12952,27 +13736,15 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
 		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
-
 	CuAssertIntEquals (test, 0, status);
 
 	region[0].start_addr = 0x10000;
 	region[0].length = strlen (data1);
 	region[1].start_addr = 0x20000;
 	region[1].length = strlen (data2);
-	region[2].start_addr = 0x30000;
-	region[2].length = strlen (data3);
 
 	sig[0].regions = &region[0];
 	sig[0].count = 1;
@@ -12986,29 +13758,13 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
 	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
-
-	sig[2].regions = &region[2];
-	sig[2].count = 1;
-	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
-	sig[2].sig_length = RSA_ENCRYPT_LEN;
-	sig[2].always_validate = 1;
-
-	list[0].images_sig = &sig[0];
-	list[0].images_hash = NULL;
-	list[0].count = 1;
-
-	list[1].images_sig = &sig[1];
-	list[1].images_hash = NULL;
-	list[1].count = 1;
+	sig[1].always_validate = 0;
 
-	list[2].images_sig = &sig[2];
-	list[2].images_hash = NULL;
-	list[2].count = 1;
+	list.images_sig = sig;
+	list.images_hash = NULL;
+	list.count = 2;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_image (&flash, &list, 1, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -13019,10 +13775,10 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
+static void host_fw_verify_offset_image_test_invalid (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_hash img_hash;
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
@@ -13030,7 +13786,8 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data = "Test";
+	char *data1 = "Test";
+	char *data2 = "Test2";
 
 	TEST_START;
 
@@ -13051,28 +13808,38 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
 
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
 
-	img_hash.regions = &region;
-	img_hash.count = 1;
-	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash.hash_length = SHA256_HASH_LENGTH;
-	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	list.images_hash = &img_hash;
-	list.images_sig = NULL;
-	list.count = 1;
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 0;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	list.images_sig = sig;
+	list.images_hash = NULL;
+	list.count = 2;
+
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+
+	status = host_fw_verify_offset_image (&flash, &list, 0, 0x400000, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13082,7 +13849,7 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTest *test)
+static void host_fw_verify_offset_image_test_hashes (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_hash img_hash;
@@ -13115,7 +13882,7 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTe
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -13127,13 +13894,13 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTe
 	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
 	img_hash.hash_length = SHA256_HASH_LENGTH;
 	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	img_hash.always_validate = 0;
 
 	list.images_hash = &img_hash;
 	list.images_sig = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_image (&flash, &list, 0, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -13144,7 +13911,7 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTe
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest *test)
+static void host_fw_verify_offset_image_test_hashes_invalid (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_hash img_hash;
@@ -13195,8 +13962,7 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest
 	list.images_sig = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_image (&flash, &list, 0, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -13207,11 +13973,11 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTest *test)
+static void host_fw_verify_offset_image_test_null (CuTest *test)
 {
-	struct flash_region region[3];
-	struct pfm_image_hash img_hash[3];
-	struct pfm_image_list list[3];
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -13220,7 +13986,6 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTes
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
-	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -13239,133 +14004,42 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTes
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
-
-	CuAssertIntEquals (test, 0, status);
-
 	region[0].start_addr = 0x10000;
 	region[0].length = strlen (data1);
 	region[1].start_addr = 0x20000;
 	region[1].length = strlen (data2);
-	region[2].start_addr = 0x30000;
-	region[2].length = strlen (data3);
-
-	img_hash[0].regions = &region[0];
-	img_hash[0].count = 1;
-	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash[0].hash_length = SHA256_HASH_LENGTH;
-	img_hash[0].hash_type = HASH_TYPE_SHA256;
-	img_hash[0].always_validate = 1;
-
-	img_hash[1].regions = &region[1];
-	img_hash[1].count = 1;
-	memcpy (img_hash[1].hash, SHA384_TEST2_HASH, SHA384_HASH_LENGTH);
-	img_hash[1].hash_length = SHA384_HASH_LENGTH;
-	img_hash[1].hash_type = HASH_TYPE_SHA384;
-	img_hash[1].always_validate = 1;
-
-	img_hash[2].regions = &region[2];
-	img_hash[2].count = 1;
-	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
-	img_hash[2].hash_length = SHA512_HASH_LENGTH;
-	img_hash[2].hash_type = HASH_TYPE_SHA512;
-	img_hash[2].always_validate = 1;
-
-	list[0].images_hash = &img_hash[0];
-	list[0].images_sig = NULL;
-	list[0].count = 1;
-
-	list[1].images_hash = &img_hash[1];
-	list[1].images_sig = NULL;
-	list[1].count = 1;
-
-	list[2].images_hash = &img_hash[2];
-	list[2].images_sig = NULL;
-	list[2].count = 1;
-
-	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_validate_and_release (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
-}
-
-static void host_fw_verify_offset_images_multiple_fw_test_null (CuTest *test)
-{
-	struct flash_region region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list list;
-	struct flash_master_mock flash_mock;
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
-	int status;
-	char *data = "Test";
-
-	TEST_START;
-
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &flash_mock.base);
-	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	sig.regions = &region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 0;
 
-	list.images_sig = &sig;
+	list.images_sig = sig;
 	list.images_hash = NULL;
-	list.count = 1;
+	list.count = 2;
 
-	status = host_fw_verify_offset_images_multiple_fw (NULL, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_image (NULL, &list, 0, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, NULL, 1, 0x400000, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_image (&flash, NULL, 0, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, NULL,
-		&rsa.base);
+	status = host_fw_verify_offset_image (&flash, &list, 0, 0x400000, NULL, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		NULL);
+	status = host_fw_verify_offset_image (&flash, &list, 0, 0x400000, &hash.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_image (&flash, &list, 2, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -14050,9 +14724,9 @@ static void host_fw_restore_read_write_data_multiple_fw_test_multiple (CuTest *t
 	}
 	status |= flash_master_mock_expect_blank_check (&flash_mock2, 0x40000, 0x30000);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x100000, 0x10000);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x100000,
-		0x100000, data, sizeof (data));
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x100000, 0x100000, data, sizeof (data),
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -14827,9 +15501,9 @@ static void host_fw_migrate_read_write_data_multiple_fw_test (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -14889,17 +15563,17 @@ static void host_fw_migrate_read_write_data_multiple_fw_test_multiple (CuTest *t
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
-		0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16,
+		HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
-		0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -15051,9 +15725,9 @@ static void host_fw_migrate_read_write_data_multiple_fw_test_diff_regions (CuTes
 
 	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 64);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x90000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x90000,
-		0x90000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x90000, 0x90000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -15167,17 +15841,17 @@ static void host_fw_migrate_read_write_data_multiple_fw_test_no_source_regions (
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
-		0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x30000, 0x30000, RSA_ENCRYPT_TEST2, 16,
+		HOST_FW_COPY_BLOCK);
 
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
-		0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x50000, 0x50000, RSA_ENCRYPT_NOPE, 32,
+		HOST_FW_COPY_BLOCK);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -15314,10 +15988,12 @@ static void host_fw_migrate_read_write_data_multiple_fw_test_erase_error (CuTest
 	status = spi_flash_set_device_size (&flash2, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status = flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+		&flash_mock2, &flash_mock1, 0x10000, 0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN,
+		HOST_FW_COPY_BLOCK);
 
+	status |= flash_master_mock_expect_verify_flash (&flash_mock1, 0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_verify_flash (&flash_mock2, 0x30000, flash_mock2.blank, 16);
 	status |= flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
@@ -15447,6 +16123,7 @@ TEST (host_fw_full_flash_verification_test_hashes_partial_validation);
 TEST (host_fw_full_flash_verification_test_hashes_invalid_image);
 TEST (host_fw_full_flash_verification_test_null);
 TEST (host_fw_migrate_read_write_data_test);
+TEST (host_fw_migrate_read_write_data_test_unchanged);
 TEST (host_fw_migrate_read_write_data_test_multiple_regions);
 TEST (host_fw_migrate_read_write_data_test_different_addresses);
 TEST (host_fw_migrate_read_write_data_test_multiple_diff_addresses);
@@ -15536,6 +16213,9 @@ TEST (host_fw_are_images_different_test_null);
 TEST (host_fw_restore_read_write_data_test_do_nothing);
 TEST (host_fw_restore_read_write_data_test_erase_flash);
 TEST (host_fw_restore_read_write_data_test_restore_flash);
+TEST (host_fw_restore_read_write_data_test_restore_flash_unchanged);
+TEST (host_fw_restore_read_write_data_test_restore_flash_debug_log);
+TEST (host_fw_restore_read_write_data_test_restore_flash_unchanged_debug_log);
 TEST (host_fw_restore_read_write_data_test_restore_flash_no_source_device);
 TEST (host_fw_restore_read_write_data_test_reserved);
 TEST (host_fw_restore_read_write_data_test_multiple_regions);
@@ -15559,6 +16239,12 @@ TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset);
 TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_invalid);
 TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_multiple);
 TEST (host_fw_verify_offset_images_multiple_fw_test_null);
+TEST (host_fw_is_image_validation_required_test);
+TEST (host_fw_verify_offset_image_test);
+TEST (host_fw_verify_offset_image_test_invalid);
+TEST (host_fw_verify_offset_image_test_hashes);
+TEST (host_fw_verify_offset_image_test_hashes_invalid);
+TEST (host_fw_verify_offset_image_test_null);
 TEST (host_fw_full_flash_verification_multiple_fw_test);
 TEST (host_fw_full_flash_verification_multiple_fw_test_multiple);
 TEST (host_fw_full_flash_verification_multiple_fw_test_hashes);
@@ -0,0 +1,1303 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "common/array_size.h"
+#include "host_fw/host_fw_verify_scheduler.h"
+#include "host_fw/host_fw_verify_scheduler_static.h"
+#include "host_fw/host_fw_util.h"
+#include "flash/flash_virtual_ram.h"
+#include "testing/mock/flash/flash_master_mock.h"
+#include "testing/engines/hash_testing_engine.h"
+#include "testing/engines/rsa_testing_engine.h"
+#include "testing/crypto/rsa_testing.h"
+#include "testing/crypto/hash_testing.h"
+
+
+TEST_SUITE_LABEL ("host_fw_verify_scheduler");
+
+
+/**
+ * Maximum number of workers used for testing.
+ */
+#define	HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS	3
+
+
+/**
+ * Dependencies for testing the verification scheduler.
+ */
+struct host_fw_verify_scheduler_testing {
+	struct flash_master_mock flash_mock;									/**< Mock for the flash device. */
+	struct spi_flash_state flash_state;										/**< Variable context for the flash. */
+	struct spi_flash flash;													/**< Flash containing the images. */
+	HASH_TESTING_ENGINE hash[HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS];		/**< Hash engines for each worker. */
+	RSA_TESTING_ENGINE rsa[HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS];		/**< RSA engines for each worker. */
+	struct host_fw_verify_worker workers[HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS];	/**< Worker engines. */
+	struct host_fw_verify_scheduler_state state;							/**< Variable context for the scheduler. */
+	struct host_fw_verify_scheduler test;									/**< Scheduler under test. */
+};
+
+
+/**
+ * Initialize the dependencies for scheduler testing.
+ *
+ * @param test The testing framework.
+ * @param scheduler Testing components to initialize.
+ */
+static void host_fw_verify_scheduler_testing_init_dependencies (CuTest *test,
+	struct host_fw_verify_scheduler_testing *scheduler)
+{
+	int status;
+	int i;
+
+	for (i = 0; i < HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS; i++) {
+		status = HASH_TESTING_ENGINE_INIT (&scheduler->hash[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		status = RSA_TESTING_ENGINE_INIT (&scheduler->rsa[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		scheduler->workers[i].hash = &scheduler->hash[i].base;
+		scheduler->workers[i].rsa = &scheduler->rsa[i].base;
+	}
+
+	status = flash_master_mock_init (&scheduler->flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&scheduler->flash, &scheduler->flash_state,
+		&scheduler->flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&scheduler->flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a verification scheduler for testing.
+ *
+ * @param test The testing framework.
+ * @param scheduler Testing components to initialize.
+ * @param worker_count The number of workers to use.
+ */
+static void host_fw_verify_scheduler_testing_init (CuTest *test,
+	struct host_fw_verify_scheduler_testing *scheduler, size_t worker_count)
+{
+	int status;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, scheduler);
+
+	status = host_fw_verify_scheduler_init (&scheduler->test, &scheduler->state,
+		scheduler->workers, worker_count);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release the dependencies used for scheduler testing and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param scheduler Testing components to release.
+ */
+static void host_fw_verify_scheduler_testing_release_dependencies (CuTest *test,
+	struct host_fw_verify_scheduler_testing *scheduler)
+{
+	int status;
+	int i;
+
+	status = flash_master_mock_validate_and_release (&scheduler->flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&scheduler->flash);
+
+	for (i = 0; i < HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS; i++) {
+		HASH_TESTING_ENGINE_RELEASE (&scheduler->hash[i]);
+		RSA_TESTING_ENGINE_RELEASE (&scheduler->rsa[i]);
+	}
+}
+
+/**
+ * Release a verification scheduler used for testing and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param scheduler Testing components to release.
+ */
+static void host_fw_verify_scheduler_testing_release (CuTest *test,
+	struct host_fw_verify_scheduler_testing *scheduler)
+{
+	host_fw_verify_scheduler_testing_release_dependencies (test, scheduler);
+	host_fw_verify_scheduler_release (&scheduler->test);
+}
+
+/**
+ * Set the expectation for image data to be read from flash.
+ *
+ * @param test The testing framework.
+ * @param scheduler Testing components to update.
+ * @param addr The flash address of the image data.
+ * @param data The image data.
+ */
+static void host_fw_verify_scheduler_testing_expect_read (CuTest *test,
+	struct host_fw_verify_scheduler_testing *scheduler, uint32_t addr, const char *data)
+{
+	int status;
+
+	status = flash_master_mock_expect_rx_xfer (&scheduler->flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&scheduler->flash_mock, 0, (uint8_t*) data,
+		strlen (data), FLASH_EXP_READ_CMD (0x03, addr, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set up a signed image for a single region of flash.
+ *
+ * @param sig The image signature to initialize.
+ * @param region The region to use for the image.
+ * @param addr The flash address of the image.
+ * @param data The image data.
+ * @param signature The signature of the image.
+ * @param always_validate Flag indicating if the image should be validated.
+ */
+static void host_fw_verify_scheduler_testing_init_sig (struct pfm_image_signature *sig,
+	struct flash_region *region, uint32_t addr, const char *data, const uint8_t *signature,
+	uint8_t always_validate)
+{
+	region->start_addr = addr;
+	region->length = strlen (data);
+
+	sig->regions = region;
+	sig->count = 1;
+	memcpy (&sig->key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig->signature, signature, RSA_ENCRYPT_LEN);
+	sig->sig_length = RSA_ENCRYPT_LEN;
+	sig->always_validate = always_validate;
+}
+
+
+/**
+ * Size of the virtual flash used for verification on multiple threads.
+ */
+#define	HOST_FW_VERIFY_SCHEDULER_TESTING_FLASH_SIZE		0x410000
+
+/**
+ * Length of the first image used for verification on multiple threads.  This image takes long
+ * enough to verify that helper workers will have woken up and claimed the other images.
+ */
+#define	HOST_FW_VERIFY_SCHEDULER_TESTING_LARGE_IMAGE	0x400000
+
+/**
+ * Number of small images used for verification on multiple threads.
+ */
+#define	HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES	16
+
+/**
+ * Storage for the virtual flash used for verification on multiple threads.
+ */
+static uint8_t host_fw_verify_scheduler_testing_flash_buffer[
+	HOST_FW_VERIFY_SCHEDULER_TESTING_FLASH_SIZE];
+
+/**
+ * Host flash for verification on multiple threads.  The scheduler only reads host flash through the
+ * base flash API, so reads are forwarded to a virtual flash in RAM that can be safely accessed by
+ * all workers.
+ */
+struct host_fw_verify_scheduler_testing_host_flash {
+	struct spi_flash base;						/**< Host flash used by the scheduler. */
+	struct flash_virtual_ram_state ram_state;	/**< Variable context for the virtual flash. */
+	struct flash_virtual_ram ram;				/**< Virtual flash containing the images. */
+};
+
+/**
+ * Context for a helper worker running on a separate thread.
+ */
+struct host_fw_verify_scheduler_testing_helper {
+	const struct host_fw_verify_scheduler *scheduler;	/**< The scheduler the worker belongs to. */
+	size_t worker;										/**< Index of the worker. */
+	int status;											/**< Result of running the worker. */
+	platform_semaphore finished;						/**< Signaled when the worker returns. */
+	platform_timer thread;								/**< Timer used to run the worker. */
+};
+
+/**
+ * Read from the virtual flash backing a host flash.
+ *
+ * @param flash The host flash to read.
+ * @param address The address to start reading from.
+ * @param data Output for the data.
+ * @param length The number of bytes to read.
+ *
+ * @return 0 if the read was successful or an error code.
+ */
+static int host_fw_verify_scheduler_testing_host_flash_read (const struct flash *flash,
+	uint32_t address, uint8_t *data, size_t length)
+{
+	const struct host_fw_verify_scheduler_testing_host_flash *host =
+		(const struct host_fw_verify_scheduler_testing_host_flash*) flash;
+
+	return host->ram.base.read (&host->ram.base, address, data, length);
+}
+
+/**
+ * Initialize a host flash backed by virtual flash.
+ *
+ * @param test The testing framework.
+ * @param host The host flash to initialize.
+ */
+static void host_fw_verify_scheduler_testing_init_host_flash (CuTest *test,
+	struct host_fw_verify_scheduler_testing_host_flash *host)
+{
+	int status;
+
+	memset (host, 0, sizeof (*host));
+
+	status = flash_virtual_ram_init (&host->ram, &host->ram_state,
+		host_fw_verify_scheduler_testing_flash_buffer, HOST_FW_VERIFY_SCHEDULER_TESTING_FLASH_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	host->base.base.read = host_fw_verify_scheduler_testing_host_flash_read;
+}
+
+/**
+ * Release a host flash backed by virtual flash.
+ *
+ * @param host The host flash to release.
+ */
+static void host_fw_verify_scheduler_testing_release_host_flash (
+	struct host_fw_verify_scheduler_testing_host_flash *host)
+{
+	flash_virtual_ram_release (&host->ram);
+}
+
+/**
+ * Timer handler to run a helper worker.  Timer notifications run on their own thread, so this
+ * allows the worker to run in parallel with the test.
+ *
+ * @param context The helper being run.
+ */
+static void host_fw_verify_scheduler_testing_helper_run (void *context)
+{
+	struct host_fw_verify_scheduler_testing_helper *helper = context;
+
+	helper->status = host_fw_verify_scheduler_run_worker (helper->scheduler, helper->worker, 500);
+	platform_semaphore_post (&helper->finished);
+}
+
+/**
+ * Start a helper worker on a separate thread.  The helper will wait for a single job.
+ *
+ * @param test The testing framework.
+ * @param helper The helper to start.
+ * @param scheduler The scheduler the worker belongs to.
+ * @param worker Index of the worker.
+ */
+static void host_fw_verify_scheduler_testing_start_helper (CuTest *test,
+	struct host_fw_verify_scheduler_testing_helper *helper,
+	const struct host_fw_verify_scheduler *scheduler, size_t worker)
+{
+	int status;
+
+	helper->scheduler = scheduler;
+	helper->worker = worker;
+	helper->status = -1;
+
+	status = platform_semaphore_init (&helper->finished);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_timer_create (&helper->thread, host_fw_verify_scheduler_testing_helper_run,
+		helper);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_timer_arm_one_shot (&helper->thread, 1);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Wait for a helper worker to return and release it.
+ *
+ * @param test The testing framework.
+ * @param helper The helper to wait for.
+ *
+ * @return The status returned by the worker.
+ */
+static int host_fw_verify_scheduler_testing_finish_helper (CuTest *test,
+	struct host_fw_verify_scheduler_testing_helper *helper)
+{
+	int status;
+
+	status = platform_semaphore_wait (&helper->finished, 10000);
+	CuAssertIntEquals (test, 0, status);
+
+	platform_timer_delete (&helper->thread);
+	platform_semaphore_free (&helper->finished);
+
+	return helper->status;
+}
+
+/**
+ * Set up the images used for verification on multiple threads.  The first firmware component has
+ * one large image identified by hash.  The second component has small signed images.  Every image
+ * is valid.
+ *
+ * @param test The testing framework.
+ * @param scheduler Testing components to use for calculating image hashes.
+ * @param region Regions for each image.
+ * @param img_hash The hash for the large image.
+ * @param sig Signatures for the small images.
+ * @param list The image lists for both components.
+ */
+static void host_fw_verify_scheduler_testing_init_threaded_images (CuTest *test,
+	struct host_fw_verify_scheduler_testing *scheduler, struct flash_region *region,
+	struct pfm_image_hash *img_hash, struct pfm_image_signature *sig, struct pfm_image_list *list)
+{
+	const char *data = "Test";
+	uint32_t addr;
+	size_t i;
+	int status;
+
+	for (i = 0; i < HOST_FW_VERIFY_SCHEDULER_TESTING_LARGE_IMAGE; i++) {
+		host_fw_verify_scheduler_testing_flash_buffer[i] = i * 7;
+	}
+
+	region[0].start_addr = 0;
+	region[0].length = HOST_FW_VERIFY_SCHEDULER_TESTING_LARGE_IMAGE;
+
+	img_hash->regions = &region[0];
+	img_hash->count = 1;
+	img_hash->hash_length = SHA256_HASH_LENGTH;
+	img_hash->hash_type = HASH_TYPE_SHA256;
+	img_hash->always_validate = 1;
+
+	status = scheduler->hash[0].base.calculate_sha256 (&scheduler->hash[0].base,
+		host_fw_verify_scheduler_testing_flash_buffer, HOST_FW_VERIFY_SCHEDULER_TESTING_LARGE_IMAGE,
+		img_hash->hash, sizeof (img_hash->hash));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES; i++) {
+		addr = HOST_FW_VERIFY_SCHEDULER_TESTING_LARGE_IMAGE + (i * 0x100);
+		memcpy (&host_fw_verify_scheduler_testing_flash_buffer[addr], data, strlen (data));
+
+		host_fw_verify_scheduler_testing_init_sig (&sig[i], &region[i + 1], addr, data,
+			RSA_SIGNATURE_TEST, 1);
+	}
+
+	list[0].images_hash = img_hash;
+	list[0].images_sig = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = sig;
+	list[1].images_hash = NULL;
+	list[1].count = HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES;
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+static void host_fw_verify_scheduler_test_init (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, &scheduler);
+
+	status = host_fw_verify_scheduler_init (&scheduler.test, &scheduler.state, scheduler.workers,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &scheduler.state, scheduler.test.state);
+	CuAssertPtrEquals (test, scheduler.workers, (void*) scheduler.test.workers);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS,
+		scheduler.test.worker_count);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_init_null (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, &scheduler);
+
+	status = host_fw_verify_scheduler_init (NULL, &scheduler.state, scheduler.workers,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_init (&scheduler.test, NULL, scheduler.workers,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_init (&scheduler.test, &scheduler.state, NULL,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	host_fw_verify_scheduler_testing_release_dependencies (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_init_no_workers (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, &scheduler);
+
+	status = host_fw_verify_scheduler_init (&scheduler.test, &scheduler.state, scheduler.workers,
+		0);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_NO_WORKERS, status);
+
+	host_fw_verify_scheduler_testing_release_dependencies (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_init_null_worker_engine (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, &scheduler);
+
+	scheduler.workers[1].hash = NULL;
+
+	status = host_fw_verify_scheduler_init (&scheduler.test, &scheduler.state, scheduler.workers,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	scheduler.workers[1].hash = &scheduler.hash[1].base;
+	scheduler.workers[2].rsa = NULL;
+
+	status = host_fw_verify_scheduler_init (&scheduler.test, &scheduler.state, scheduler.workers,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	host_fw_verify_scheduler_testing_release_dependencies (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_static_init (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler = {
+		.test = host_fw_verify_scheduler_static_init (&scheduler.state, scheduler.workers,
+			HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS)
+	};
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	char *data = "Test";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, &scheduler);
+
+	status = host_fw_verify_scheduler_init_state (&scheduler.test);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig, &region, 0x10000, data, RSA_SIGNATURE_TEST,
+		1);
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		&list, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_static_init_null (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct host_fw_verify_scheduler null_state = host_fw_verify_scheduler_static_init (NULL,
+		scheduler.workers, HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	struct host_fw_verify_scheduler null_workers =
+		host_fw_verify_scheduler_static_init (&scheduler.state, NULL,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	struct host_fw_verify_scheduler no_workers =
+		host_fw_verify_scheduler_static_init (&scheduler.state, scheduler.workers, 0);
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init_dependencies (test, &scheduler);
+
+	status = host_fw_verify_scheduler_init_state (NULL);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_init_state (&null_state);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_init_state (&null_workers);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_init_state (&no_workers);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_NO_WORKERS, status);
+
+	host_fw_verify_scheduler_testing_release_dependencies (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	host_fw_verify_scheduler_release (NULL);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[3];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 1);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x30000, data3);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST2, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[2], &region[2], 0x30000, data3,
+		RSA_SIGNATURE_NOPE, 1);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_multiple_images (
+	CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[2];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 1);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x30000, data3);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST2, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[2], &region[2], 0x30000, data3,
+		RSA_SIGNATURE_NOPE, 1);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 2;
+
+	list[1].images_sig = &sig[2];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_multiple_workers (
+	CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[3];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+
+	/* No helper tasks are running, so all images will be verified by the caller. */
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x30000, data3);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST2, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[2], &region[2], 0x30000, data3,
+		RSA_SIGNATURE_NOPE, 1);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The wakeup for helpers is discarded once the job is done. */
+	status = host_fw_verify_scheduler_run_worker (&scheduler.test, 1, 10);
+	CuAssertIntEquals (test, 1, status);
+
+	status = host_fw_verify_scheduler_run_worker (&scheduler.test, 2, 10);
+	CuAssertIntEquals (test, 1, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_hashes (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[2];
+	struct pfm_image_hash img_hash[2];
+	struct pfm_image_list list[2];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+
+	img_hash[0].regions = &region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
+
+	img_hash[1].regions = &region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash[1].hash_length = SHA256_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA256;
+	img_hash[1].always_validate = 1;
+
+	list[0].images_hash = &img_hash[0];
+	list[0].images_sig = NULL;
+	list[0].count = 1;
+
+	list[1].images_hash = &img_hash[1];
+	list[1].images_sig = NULL;
+	list[1].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_hashes_invalid (
+	CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	char *data = "Test";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		&list, 1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_invalid (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[3];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+
+	/* Images after the failed one don't need to be verified. */
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[2], &region[2], 0x30000, data3,
+		RSA_SIGNATURE_NOPE, 1);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 3);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_not_validated (
+	CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[3];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_NOPE, 0);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST2, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[2], &region[2], 0x30000, data3,
+		RSA_SIGNATURE_TEST, 0);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_no_images (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct pfm_image_list list[2];
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	list[0].images_sig = NULL;
+	list[0].images_hash = NULL;
+	list[0].count = 0;
+
+	list[1].images_sig = NULL;
+	list[1].images_hash = NULL;
+	list[1].count = 0;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_flash_error (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list[2];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	status = flash_master_mock_expect_xfer (&scheduler.flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST2, 1);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		list, 2);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_reuse (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x10000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x20000, data2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST, 1);
+
+	list.images_sig = sig;
+	list.images_hash = NULL;
+	list.count = 2;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		&list, 1);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		&list, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_busy (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	char *data = "Test";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig, &region, 0x10000, data, RSA_SIGNATURE_TEST,
+		1);
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	scheduler.state.active = true;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		&list, 1);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_BUSY, status);
+
+	scheduler.state.active = false;
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_images_multiple_fw_null (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	char *data = "Test";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig, &region, 0x10000, data, RSA_SIGNATURE_TEST,
+		1);
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (NULL, &scheduler.flash, &list, 1);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, NULL, &list, 1);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &scheduler.flash,
+		NULL, 1);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_offset_images_multiple_fw (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list[2];
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x410000, data1);
+	host_fw_verify_scheduler_testing_expect_read (test, &scheduler, 0x420000, data2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig[0], &region[0], 0x10000, data1,
+		RSA_SIGNATURE_TEST, 1);
+	host_fw_verify_scheduler_testing_init_sig (&sig[1], &region[1], 0x20000, data2,
+		RSA_SIGNATURE_TEST2, 1);
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	status = host_fw_verify_scheduler_verify_offset_images_multiple_fw (&scheduler.test,
+		&scheduler.flash, list, 2, 0x400000);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_verify_offset_images_multiple_fw_null (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	char *data = "Test";
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	host_fw_verify_scheduler_testing_init_sig (&sig, &region, 0x10000, data, RSA_SIGNATURE_TEST,
+		1);
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_scheduler_verify_offset_images_multiple_fw (NULL, &scheduler.flash,
+		&list, 1, 0x400000);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_verify_offset_images_multiple_fw (&scheduler.test, NULL,
+		&list, 1, 0x400000);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_scheduler_verify_offset_images_multiple_fw (&scheduler.test,
+		&scheduler.flash, NULL, 1, 0x400000);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_run_worker_timeout (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	status = host_fw_verify_scheduler_run_worker (&scheduler.test, 1, 10);
+	CuAssertIntEquals (test, 1, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_run_worker_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = host_fw_verify_scheduler_run_worker (NULL, 1, 10);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_ARGUMENT, status);
+}
+
+static void host_fw_verify_scheduler_test_run_worker_invalid_worker (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler, 2);
+
+	status = host_fw_verify_scheduler_run_worker (&scheduler.test, 0, 10);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_WORKER, status);
+
+	status = host_fw_verify_scheduler_run_worker (&scheduler.test, 2, 10);
+	CuAssertIntEquals (test, HOST_FW_VERIFY_SCHEDULER_INVALID_WORKER, status);
+
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+
+static void host_fw_verify_scheduler_test_run_worker_threaded (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct host_fw_verify_scheduler_testing_host_flash host;
+	struct host_fw_verify_scheduler_testing_helper
+		helper[HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS - 1];
+	struct flash_region region[HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES + 1];
+	struct pfm_image_hash img_hash;
+	struct pfm_image_signature sig[HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES];
+	struct pfm_image_list list[2];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	host_fw_verify_scheduler_testing_init_host_flash (test, &host);
+	host_fw_verify_scheduler_testing_init_threaded_images (test, &scheduler, region, &img_hash, sig,
+		list);
+
+	for (i = 0; i < ARRAY_SIZE (helper); i++) {
+		host_fw_verify_scheduler_testing_start_helper (test, &helper[i], &scheduler.test, i + 1);
+	}
+
+	/* Give the helpers time to start waiting for the job. */
+	platform_msleep (50);
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &host.base,
+		list, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The first helper is woken by the caller and wakes the second helper in turn.  A helper that
+	 * doesn't wake before the job is done will time out. */
+	for (i = 0; i < ARRAY_SIZE (helper); i++) {
+		status = host_fw_verify_scheduler_testing_finish_helper (test, &helper[i]);
+		CuAssertTrue (test, ((status == 0) || (status == 1)));
+	}
+
+	/* No wakeup is left behind after the job. */
+	status = host_fw_verify_scheduler_run_worker (&scheduler.test, 1, 10);
+	CuAssertIntEquals (test, 1, status);
+
+	host_fw_verify_scheduler_testing_release_host_flash (&host);
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+static void host_fw_verify_scheduler_test_run_worker_threaded_first_failure (CuTest *test)
+{
+	struct host_fw_verify_scheduler_testing scheduler;
+	struct host_fw_verify_scheduler_testing_host_flash host;
+	struct host_fw_verify_scheduler_testing_helper
+		helper[HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS - 1];
+	struct flash_region region[HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES + 1];
+	struct pfm_image_hash img_hash;
+	struct pfm_image_signature sig[HOST_FW_VERIFY_SCHEDULER_TESTING_SMALL_IMAGES];
+	struct pfm_image_list list[2];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_scheduler_testing_init (test, &scheduler,
+		HOST_FW_VERIFY_SCHEDULER_TESTING_WORKERS);
+	host_fw_verify_scheduler_testing_init_host_flash (test, &host);
+	host_fw_verify_scheduler_testing_init_threaded_images (test, &scheduler, region, &img_hash, sig,
+		list);
+
+	/* The large image is verified by the caller and fails long after the helpers have found a
+	 * bad signature in a later image. */
+	img_hash.hash[0] ^= 0x55;
+	memcpy (&sig[3].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+
+	for (i = 0; i < ARRAY_SIZE (helper); i++) {
+		host_fw_verify_scheduler_testing_start_helper (test, &helper[i], &scheduler.test, i + 1);
+	}
+
+	platform_msleep (50);
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &host.base,
+		list, 2);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+
+	for (i = 0; i < ARRAY_SIZE (helper); i++) {
+		status = host_fw_verify_scheduler_testing_finish_helper (test, &helper[i]);
+		CuAssertTrue (test, ((status == 0) || (status == 1)));
+	}
+
+	/* With a good large image, the bad signature is the first failure, even though a later image
+	 * fails faster. */
+	img_hash.hash[0] ^= 0x55;
+	region[10].start_addr = HOST_FW_VERIFY_SCHEDULER_TESTING_FLASH_SIZE;
+
+	for (i = 0; i < ARRAY_SIZE (helper); i++) {
+		host_fw_verify_scheduler_testing_start_helper (test, &helper[i], &scheduler.test, i + 1);
+	}
+
+	platform_msleep (50);
+
+	status = host_fw_verify_scheduler_verify_images_multiple_fw (&scheduler.test, &host.base,
+		list, 2);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	for (i = 0; i < ARRAY_SIZE (helper); i++) {
+		status = host_fw_verify_scheduler_testing_finish_helper (test, &helper[i]);
+		CuAssertTrue (test, ((status == 0) || (status == 1)));
+	}
+
+	host_fw_verify_scheduler_testing_release_host_flash (&host);
+	host_fw_verify_scheduler_testing_release (test, &scheduler);
+}
+
+TEST_SUITE_START (host_fw_verify_scheduler);
+
+TEST (host_fw_verify_scheduler_test_init);
+TEST (host_fw_verify_scheduler_test_init_null);
+TEST (host_fw_verify_scheduler_test_init_no_workers);
+TEST (host_fw_verify_scheduler_test_init_null_worker_engine);
+TEST (host_fw_verify_scheduler_test_static_init);
+TEST (host_fw_verify_scheduler_test_static_init_null);
+TEST (host_fw_verify_scheduler_test_release_null);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_multiple_images);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_multiple_workers);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_hashes);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_hashes_invalid);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_invalid);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_not_validated);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_no_images);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_flash_error);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_reuse);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_busy);
+TEST (host_fw_verify_scheduler_test_verify_images_multiple_fw_null);
+TEST (host_fw_verify_scheduler_test_verify_offset_images_multiple_fw);
+TEST (host_fw_verify_scheduler_test_verify_offset_images_multiple_fw_null);
+TEST (host_fw_verify_scheduler_test_run_worker_timeout);
+TEST (host_fw_verify_scheduler_test_run_worker_null);
+TEST (host_fw_verify_scheduler_test_run_worker_invalid_worker);
+TEST (host_fw_verify_scheduler_test_run_worker_threaded);
+TEST (host_fw_verify_scheduler_test_run_worker_threaded_first_failure);
+
+TEST_SUITE_END;
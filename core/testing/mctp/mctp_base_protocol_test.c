@@ -1484,6 +1484,41 @@ static void mctp_base_protocol_test_construct_control_message_overlapping_buffer
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void mctp_base_protocol_test_construct_control_message_payload_in_place (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t out_buf[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+
+	TEST_START;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_CONTROL_MSG;
+	buf[1] = 0xAA;
+	buf[2] = 0xBB;
+	buf[3] = 0xCC;
+	buf[4] = 0xDD;
+	buf[5] = 0xEE;
+
+	memcpy (&out_buf[7], buf, sizeof (buf));
+
+	status = mctp_base_protocol_construct (&out_buf[7], sizeof (buf), out_buf, sizeof (out_buf),
+		0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PACKET_OVERHEAD + sizeof (buf), status);
+	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, out_buf[0]);
+	CuAssertIntEquals (test, sizeof (struct mctp_base_protocol_transport_header) + sizeof (buf) - 2,
+		out_buf[1]);
+	CuAssertIntEquals (test, 0xAB, out_buf[2]);
+	CuAssertIntEquals (test, 0x01, out_buf[3]);
+	CuAssertIntEquals (test, 0x0A, out_buf[4]);
+	CuAssertIntEquals (test, 0x0B, out_buf[5]);
+	CuAssertIntEquals (test, 0x92, out_buf[6]);
+	CuAssertIntEquals (test, checksum_crc8 (0xBA, out_buf, 7 + sizeof (buf)),
+		out_buf[7 + sizeof (buf)]);
+
+	status = testing_validate_array (buf, &out_buf[7], sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+}
+
 static void mctp_base_protocol_test_construct_control_message_not_som (CuTest *test)
 {
 	int status;
@@ -1971,6 +2006,7 @@ TEST (mctp_base_protocol_test_interpret_dest_eid_matches_src_eid);
 TEST (mctp_base_protocol_test_construct_control_message);
 TEST (mctp_base_protocol_test_construct_control_message_overlapping_buffer);
 TEST (mctp_base_protocol_test_construct_control_message_overlapping_buffer_at_beginning);
+TEST (mctp_base_protocol_test_construct_control_message_payload_in_place);
 TEST (mctp_base_protocol_test_construct_control_message_not_som);
 TEST (mctp_base_protocol_test_construct_vendor_defined_message);
 TEST (mctp_base_protocol_test_construct_vendor_defined_message_overlapping_buffer);
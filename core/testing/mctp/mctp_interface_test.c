@@ -44,6 +44,7 @@ struct mctp_interface_testing {
 	struct cmd_interface_mock cmd_cerberus;			/**< Command interface for Cerberus protocol mock instance. */
 	struct cmd_interface_mock cmd_mctp;				/**< MCTP control protocol command interface mock instance. */
 	struct cmd_interface_mock cmd_spdm;				/**< Command interface for SPDM protocol mock instance. */
+	struct cmd_interface_mock cmd_pldm;				/**< Command interface for PLDM protocol mock instance. */
 	struct device_manager device_mgr;				/**< Device manager. */
 	struct mctp_interface mctp;						/**< MCTP interface instance */
 };
@@ -58,6 +59,15 @@ struct mctp_interface_test_callback_context {
 	int expected_status;							/**< Expected process_packet completion status. */
 };
 
+/**
+ * Context for generating a response directly in the response packets.
+ */
+struct mctp_interface_test_packetized_context {
+	CuTest *test;									/**< Test framework. */
+	const uint8_t *response;						/**< Response data to write to the packets. */
+	size_t length;									/**< Length of the response. */
+};
+
 
 /**
  * Helper function to setup the MCTP interface to use mock instances
@@ -80,13 +90,16 @@ static void setup_mctp_interface_with_interface_mock_test_common (CuTest *test,
 	status = cmd_interface_mock_init (&mctp->cmd_spdm);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_interface_mock_init (&mctp->cmd_pldm);
+	CuAssertIntEquals (test, 0, status);
+
 	if (spdm_supported) {
 		status = mctp_interface_init (&mctp->mctp, &mctp->cmd_cerberus.base, &mctp->cmd_mctp.base,
-			&mctp->cmd_spdm.base, NULL, &mctp->device_mgr);
+			&mctp->cmd_spdm.base, &mctp->cmd_pldm.base, &mctp->device_mgr);
 	}
 	else {
 		status = mctp_interface_init (&mctp->mctp, &mctp->cmd_cerberus.base, &mctp->cmd_mctp.base,
-			NULL, NULL, &mctp->device_mgr);
+			NULL, &mctp->cmd_pldm.base, &mctp->device_mgr);
 	}
 
 	CuAssertIntEquals (test, 0, status);
@@ -173,6 +186,9 @@ static void complete_mctp_interface_with_interface_mock_test (CuTest *test,
 	status = cmd_interface_mock_validate_and_release (&mctp->cmd_spdm);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_interface_mock_validate_and_release (&mctp->cmd_pldm);
+	CuAssertIntEquals (test, 0, status);
+
 	status = cmd_channel_mock_validate_and_release (&mctp->channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -203,6 +219,45 @@ static int64_t mctp_interface_testing_process_packet_callback (const struct mock
 	return 0;
 }
 
+/**
+ * Callback function which writes a response directly into the response packets provided with the
+ * request.
+ *
+ * @param expected The expectation that is being used to validate the current call on the mock.
+ * @param called The context for the actual call on the mock.
+ *
+ * @return This function always returns 0
+ */
+static int64_t mctp_interface_testing_packetized_response_callback (
+	const struct mock_call *expected, const struct mock_call *called)
+{
+	struct mctp_interface_test_packetized_context *context = expected->context;
+	struct cmd_interface_msg *request =
+		(struct cmd_interface_msg*) ((uintptr_t) called->argv[0].value);
+	size_t offset = 0;
+	size_t length;
+	uint8_t *payload;
+
+	CuAssertPtrNotNull (context->test, request->packets);
+
+	while (offset < context->length) {
+		payload = cmd_interface_msg_get_packet_payload (request, offset, &length);
+		CuAssertPtrNotNull (context->test, payload);
+
+		if (length > (context->length - offset)) {
+			length = context->length - offset;
+		}
+
+		memcpy (payload, &context->response[offset], length);
+		offset += length;
+	}
+
+	request->length = context->length;
+	request->packetized = true;
+
+	return 0;
+}
+
 /**
  * Helper function that generates an MCTP request and calls issue_request.
  *
@@ -262,6 +317,245 @@ static void mctp_interface_testing_generate_and_issue_request (CuTest *test,
 	CuAssertIntEquals (test, issue_request_status, status);
 }
 
+/**
+ * Helper function to construct one packet of a two packet vendor defined request.
+ *
+ * @param rx The packet to construct.
+ * @param src_eid Source EID of the request.
+ * @param source_addr SMBus address of the requester.
+ * @param msg_tag Message tag of the request.
+ * @param som Flag indicating the packet is the first packet of the request.
+ */
+static void mctp_interface_testing_build_two_packet_request (struct cmd_packet *rx,
+	uint8_t src_eid, uint8_t source_addr, uint8_t msg_tag, bool som)
+{
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx->data;
+	int i;
+
+	memset (rx, 0, sizeof (*rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = (source_addr << 1) | 1;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = src_eid;
+	header->som = som;
+	header->eom = !som;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = msg_tag;
+	header->packet_seq = (som) ? 0 : 1;
+
+	for (i = 7; i < 17; i++) {
+		rx->data[i] = src_eid + msg_tag + i;
+	}
+
+	if (som) {
+		rx->data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+		rx->data[8] = 0x00;
+		rx->data[9] = 0x00;
+		rx->data[10] = 0x00;
+	}
+
+	rx->data[17] = checksum_crc8 (0xBA, rx->data, 17);
+	rx->pkt_size = 18;
+	rx->dest_addr = 0x5D;
+}
+
+/**
+ * Helper function to process the last packet of a two packet request and check the response is
+ * sent to the requester.
+ *
+ * @param test The test framework.
+ * @param mctp The testing instances to utilize.
+ * @param som The first packet of the request.
+ * @param eom The last packet of the request.
+ */
+static void mctp_interface_testing_complete_two_packet_request (CuTest *test,
+	struct mctp_interface_testing *mctp, struct cmd_packet *som, struct cmd_packet *eom)
+{
+	struct mctp_base_protocol_transport_header *rx_header =
+		(struct mctp_base_protocol_transport_header*) som->data;
+	struct mctp_base_protocol_transport_header *header;
+	struct cmd_message *tx;
+	uint8_t data[20];
+	struct cmd_interface_msg request;
+	uint8_t response_data[5];
+	struct cmd_interface_msg response;
+	int status;
+
+	memcpy (data, &som->data[7], 10);
+	memcpy (&data[10], &eom->data[7], 10);
+
+	request.data = data;
+	request.length = sizeof (data);
+	request.source_eid = rx_header->source_eid;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memset (response_data, 0, sizeof (response_data));
+	response.data = response_data;
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[4] = rx_header->source_eid;
+	response.length = sizeof (response_data);
+	response.source_eid = rx_header->source_eid;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&mctp->cmd_cerberus.mock, mctp->cmd_cerberus.base.process_request,
+		&mctp->cmd_cerberus, 0,
+		MOCK_ARG_VALIDATOR_DEEP_COPY_TMP (cmd_interface_mock_validate_request, &request,
+			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request,
+			cmd_interface_mock_duplicate_request));
+	status |= mock_expect_output (&mctp->cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp->mctp, eom, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, sizeof (response_data) + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD,
+		tx->msg_size);
+	CuAssertIntEquals (test, rx_header->source_addr >> 1, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, rx_header->source_eid, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, rx_header->msg_tag, header->msg_tag);
+
+	status = testing_validate_array (response_data, &tx->data[MCTP_HEADER_LENGTH],
+		sizeof (response_data));
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper function to issue a request that does not wait for the response.
+ *
+ * @param test The test framework.
+ * @param mctp The testing instances to utilize.
+ * @param dest_eid EID to send the request to.
+ * @param dest_addr SMBus address to send the request to.
+ * @param msg_tag Message tag expected to be used for the request.
+ */
+static void mctp_interface_testing_issue_request_no_wait (CuTest *test,
+	struct mctp_interface_testing *mctp, uint8_t dest_eid, uint8_t dest_addr, uint8_t msg_tag)
+{
+	uint8_t buf[6] = {0};
+	uint8_t msg_buf[MCTP_BASE_PROTOCOL_MAX_MESSAGE_LEN] = {0};
+	struct cmd_packet tx_packet;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) tx_packet.data;
+	int status;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = dest_eid;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = msg_tag;
+	header->packet_seq = 0;
+
+	memcpy (&tx_packet.data[7], buf, sizeof (buf));
+
+	tx_packet.data[13] = checksum_crc8 (dest_addr << 1, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = dest_addr;
+	tx_packet.timeout_valid = false;
+
+	status = mock_expect (&mctp->channel.mock, mctp->channel.base.send_packet, &mctp->channel, 0,
+		MOCK_ARG_VALIDATOR_TMP (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_issue_request (&mctp->mctp, &mctp->channel.base, dest_addr, dest_eid,
+		buf, sizeof (buf), msg_buf, sizeof (msg_buf), 0);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper function to receive a response to a request.
+ *
+ * @param test The test framework.
+ * @param mctp The testing instances to utilize.
+ * @param src_eid EID of the device sending the response.
+ * @param msg_tag Message tag of the response.
+ * @param expected Flag indicating the response is expected to be processed.
+ */
+static void mctp_interface_testing_receive_response (CuTest *test,
+	struct mctp_interface_testing *mctp, uint8_t src_eid, uint8_t msg_tag, bool expected)
+{
+	struct cmd_packet rx_packet;
+	struct cmd_message *tx;
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+	int status;
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = src_eid;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
+	header->msg_tag = msg_tag;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = src_eid;
+	rx_packet.data[12] = msg_tag;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.dest_addr = 0x5D;
+
+	if (expected) {
+		response.data = &rx_packet.data[7];
+		response.length = 10;
+		response.source_eid = src_eid;
+		response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+		response.crypto_timeout = false;
+		response.channel_id = 0;
+		response.max_response = 0;
+
+		status = mock_expect (&mctp->cmd_cerberus.mock, mctp->cmd_cerberus.base.process_response,
+			&mctp->cmd_cerberus, 0,
+			MOCK_ARG_VALIDATOR_DEEP_COPY_TMP (cmd_interface_mock_validate_request, &response,
+				sizeof (response), cmd_interface_mock_save_request,
+				cmd_interface_mock_free_request, cmd_interface_mock_duplicate_request));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = mctp_interface_process_packet (&mctp->mctp, &rx_packet, &tx);
+	CuAssertIntEquals (test, (expected) ? 0 : MCTP_BASE_PROTOCOL_UNEXPECTED_PKT, status);
+	CuAssertPtrEquals (test, NULL, tx);
+}
+
 /*******************
  * Test cases
  *******************/
@@ -3230,10 +3524,234 @@ static void mctp_interface_test_process_packet_two_packet_response (CuTest *test
 	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[tx->pkt_size], second_pkt_total - 1),
 		tx->data[tx->msg_size - 1]);
 
-	status = testing_validate_array (&response.data[first_pkt],
-		&tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + MCTP_HEADER_LENGTH], second_pkt);
+	status = testing_validate_array (&response.data[first_pkt],
+		&tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + MCTP_HEADER_LENGTH], second_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_pldm_request (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	uint8_t response_data[5];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
+	rx.data[8] = 0x81;
+	rx.data[9] = 0x05;
+	rx.data[10] = 0x15;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.data = response_data;
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
+	response.data[1] = 0x01;
+	response.data[2] = 0x05;
+	response.data[3] = 0x15;
+	response.data[4] = 0x00;
+	response.length = sizeof (response_data);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+	response.packets = NULL;
+	response.packetized = false;
+
+	status = mock_expect (&mctp.cmd_pldm.mock, mctp.cmd_pldm.base.process_request,
+		&mctp.cmd_pldm, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&request, sizeof (request), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	status |= mock_expect_output (&mctp.cmd_pldm.mock, 0, &response, sizeof (response), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, sizeof (response_data) + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD,
+		tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
+
+	status = testing_validate_array (response_data, &tx->data[MCTP_HEADER_LENGTH],
+		sizeof (response_data));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, mctp.mctp.req_buffer.packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_pldm_request_packetized_response (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct mctp_interface_test_packetized_context context;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT + 48];
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	int status;
+	int first_pkt = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	int second_pkt = 48;
+	int second_pkt_total = second_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	size_t i;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
+	rx.data[8] = 0x81;
+	rx.data[9] = 0x05;
+	rx.data[10] = 0x15;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	response_data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
+	for (i = 1; i < sizeof (response_data); i++) {
+		response_data[i] = i;
+	}
+
+	context.test = test;
+	context.response = response_data;
+	context.length = sizeof (response_data);
+
+	status = mock_expect (&mctp.cmd_pldm.mock, mctp.cmd_pldm.base.process_request,
+		&mctp.cmd_pldm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_external_action (&mctp.cmd_pldm.mock,
+		mctp_interface_testing_packetized_response_callback, &context);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + second_pkt_total, tx->msg_size);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 0, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
+
+	status = testing_validate_array (response_data, &tx->data[MCTP_HEADER_LENGTH], first_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	header = (struct mctp_base_protocol_transport_header*) &tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 1, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[tx->pkt_size], second_pkt_total - 1),
+		tx->data[tx->msg_size - 1]);
+
+	status = testing_validate_array (&response_data[first_pkt],
+		&tx->data[tx->pkt_size + MCTP_HEADER_LENGTH], second_pkt);
 	CuAssertIntEquals (test, 0, status);
 
+	CuAssertPtrEquals (test, NULL, mctp.mctp.req_buffer.packets);
+	CuAssertIntEquals (test, false, mctp.mctp.req_buffer.packetized);
+
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
@@ -4345,6 +4863,108 @@ static void mctp_interface_test_process_packet_reset_message_processing (CuTest
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
+static void mctp_interface_test_process_packet_interleaved_requests_different_eid (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx[4];
+	struct cmd_message *tx;
+	int status;
+
+	TEST_START;
+
+	mctp_interface_testing_build_two_packet_request (&rx[0], MCTP_BASE_PROTOCOL_BMC_EID, 0x55, 1,
+		true);
+	mctp_interface_testing_build_two_packet_request (&rx[1], 0x20, 0x66, 1, true);
+	mctp_interface_testing_build_two_packet_request (&rx[2], MCTP_BASE_PROTOCOL_BMC_EID, 0x55, 1,
+		false);
+	mctp_interface_testing_build_two_packet_request (&rx[3], 0x20, 0x66, 1, false);
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[0], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[1], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_complete_two_packet_request (test, &mctp, &rx[0], &rx[2]);
+	mctp_interface_testing_complete_two_packet_request (test, &mctp, &rx[1], &rx[3]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_interleaved_requests_same_eid (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx[4];
+	struct cmd_message *tx;
+	int status;
+
+	TEST_START;
+
+	mctp_interface_testing_build_two_packet_request (&rx[0], MCTP_BASE_PROTOCOL_BMC_EID, 0x55, 2,
+		true);
+	mctp_interface_testing_build_two_packet_request (&rx[1], MCTP_BASE_PROTOCOL_BMC_EID, 0x55, 5,
+		true);
+	mctp_interface_testing_build_two_packet_request (&rx[2], MCTP_BASE_PROTOCOL_BMC_EID, 0x55, 2,
+		false);
+	mctp_interface_testing_build_two_packet_request (&rx[3], MCTP_BASE_PROTOCOL_BMC_EID, 0x55, 5,
+		false);
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[0], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[1], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_complete_two_packet_request (test, &mctp, &rx[1], &rx[3]);
+	mctp_interface_testing_complete_two_packet_request (test, &mctp, &rx[0], &rx[2]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_interleaved_requests_evict_least_recent (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx[MCTP_INTERFACE_MAX_MSG_CONTEXTS + 1][2];
+	struct cmd_message *tx;
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i <= MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		mctp_interface_testing_build_two_packet_request (&rx[i][0], 0x20 + i, 0x60 + i, 0, true);
+		mctp_interface_testing_build_two_packet_request (&rx[i][1], 0x20 + i, 0x60 + i, 0, false);
+	}
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	for (i = 0; i <= MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		status = mctp_interface_process_packet (&mctp.mctp, &rx[i][0], &tx);
+		CuAssertIntEquals (test, 0, status);
+		CuAssertPtrEquals (test, NULL, tx);
+	}
+
+	/* The first request was discarded to make room for the last one. */
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[0][1], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	for (i = 1; i <= MCTP_INTERFACE_MAX_MSG_CONTEXTS; i++) {
+		mctp_interface_testing_complete_two_packet_request (test, &mctp, &rx[i][0], &rx[i][1]);
+	}
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
 static void mctp_interface_test_process_packet_response_length_limited (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
@@ -6936,6 +7556,324 @@ static void mctp_interface_test_issue_request_no_wait (CuTest *test)
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
+static void mctp_interface_test_issue_request_no_wait_pipelined (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+ 	uint8_t buf[6] = {0};
+ 	uint8_t msg_buf[MCTP_BASE_PROTOCOL_MAX_MESSAGE_LEN] = {0};
+	struct cmd_packet tx_packet[2];
+	struct mctp_base_protocol_transport_header *header;
+	int status;
+	int i;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	for (i = 0; i < 2; i++) {
+		header = (struct mctp_base_protocol_transport_header*) tx_packet[i].data;
+
+		header->cmd_code = SMBUS_CMD_CODE_MCTP;
+		header->byte_count = 11;
+		header->source_addr = 0xBB;
+		header->rsvd = 0;
+		header->header_version = 1;
+		header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+		header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+		header->som = 1;
+		header->eom = 1;
+		header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+		header->msg_tag = i;
+		header->packet_seq = 0;
+
+		memcpy (&tx_packet[i].data[7], buf, sizeof (buf));
+
+		tx_packet[i].data[13] = checksum_crc8 (0xAA, tx_packet[i].data, 13);
+		tx_packet[i].pkt_size = 14;
+		tx_packet[i].state = CMD_VALID_PACKET;
+		tx_packet[i].dest_addr = 0x55;
+		tx_packet[i].timeout_valid = false;
+	}
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mock_expect (&mctp.channel.mock, mctp.channel.base.send_packet, &mctp.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (tx_packet[0])));
+	status |= mock_expect (&mctp.channel.mock, mctp.channel.base.send_packet, &mctp.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+			sizeof (tx_packet[1])));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_issue_request (&mctp.mctp, &mctp.channel.base, 0x55,
+		MCTP_BASE_PROTOCOL_BMC_EID, buf, sizeof (buf), msg_buf, sizeof (msg_buf), 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_issue_request (&mctp.mctp, &mctp.channel.base, 0x55,
+		MCTP_BASE_PROTOCOL_BMC_EID, buf, sizeof (buf), msg_buf, sizeof (msg_buf), 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, 0, mctp.mctp.response_msg_tag);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_issue_request_no_wait_pipelined_no_tag_available (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+ 	uint8_t buf[6] = {0};
+ 	uint8_t msg_buf[MCTP_BASE_PROTOCOL_MAX_MESSAGE_LEN] = {0};
+	int status;
+	int i;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	for (i = 0; i < 8; i++) {
+		status = mock_expect (&mctp.channel.mock, mctp.channel.base.send_packet, &mctp.channel, 0,
+			MOCK_ARG_NOT_NULL);
+		CuAssertIntEquals (test, 0, status);
+
+		status = mctp_interface_issue_request (&mctp.mctp, &mctp.channel.base, 0x55,
+			MCTP_BASE_PROTOCOL_BMC_EID, buf, sizeof (buf), msg_buf, sizeof (msg_buf), 0);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	CuAssertIntEquals (test, 8, mctp.mctp.outstanding_requests);
+
+	status = mctp_interface_issue_request (&mctp.mctp, &mctp.channel.base, 0x55,
+		MCTP_BASE_PROTOCOL_BMC_EID, buf, sizeof (buf), msg_buf, sizeof (msg_buf), 0);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_NO_TAG_AVAILABLE, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_issue_request_no_wait_different_eid (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	/* Message tags are only unique per destination, so both requests can use the same tag. */
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		0);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, 0x20, 0x60, 0);
+	CuAssertIntEquals (test, 2, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_WAITING, mctp.mctp.rsp_state);
+
+	mctp_interface_testing_receive_response (test, &mctp, 0x20, 0, true);
+	CuAssertIntEquals (test, 1, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_WAITING, mctp.mctp.rsp_state);
+
+	mctp_interface_testing_receive_response (test, &mctp, 0x20, 0, false);
+
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0, true);
+	CuAssertIntEquals (test, 0, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_SUCCESS, mctp.mctp.rsp_state);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_issue_request_no_wait_response_out_of_order (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		0);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		1);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		2);
+	CuAssertIntEquals (test, 3, mctp.mctp.outstanding_requests);
+
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 1, true);
+	CuAssertIntEquals (test, 2, mctp.mctp.outstanding_requests);
+
+	/* The tag of the completed request is available again. */
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		3);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		4);
+
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 2, true);
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0, true);
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 4, true);
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 3, true);
+	CuAssertIntEquals (test, 0, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_SUCCESS, mctp.mctp.rsp_state);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_issue_request_no_wait_discard_oldest (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int i;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	for (i = 0; i < MCTP_INTERFACE_MAX_PENDING_REQUESTS; i++) {
+		mctp_interface_testing_issue_request_no_wait (test, &mctp, 0x20 + i, 0x60, 0);
+	}
+
+	CuAssertIntEquals (test, MCTP_INTERFACE_MAX_PENDING_REQUESTS,
+		mctp.mctp.outstanding_requests);
+
+	/* With no free entries, the oldest request is no longer waited on. */
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, 0x10, 0x60, 0);
+	CuAssertIntEquals (test, MCTP_INTERFACE_MAX_PENDING_REQUESTS,
+		mctp.mctp.outstanding_requests);
+
+	mctp_interface_testing_receive_response (test, &mctp, 0x20, 0, false);
+	mctp_interface_testing_receive_response (test, &mctp, 0x10, 0, true);
+	mctp_interface_testing_receive_response (test, &mctp, 0x21, 0, true);
+
+	CuAssertIntEquals (test, MCTP_INTERFACE_MAX_PENDING_REQUESTS - 2,
+		mctp.mctp.outstanding_requests);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_cancel_requests (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		0);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		1);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, 0x20, 0x60, 0);
+	CuAssertIntEquals (test, 3, mctp.mctp.outstanding_requests);
+
+	/* Only the requests to the device are canceled. */
+	status = mctp_interface_cancel_requests (&mctp.mctp, MCTP_BASE_PROTOCOL_BMC_EID);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_WAITING, mctp.mctp.rsp_state);
+
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0, false);
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 1, false);
+
+	status = mctp_interface_cancel_requests (&mctp.mctp, 0x20);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_IDLE, mctp.mctp.rsp_state);
+
+	mctp_interface_testing_receive_response (test, &mctp, 0x20, 0, false);
+
+	/* The message tags of canceled requests are available again. */
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		0);
+	CuAssertIntEquals (test, 1, mctp.mctp.outstanding_requests);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_cancel_requests_no_requests (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_cancel_requests (&mctp.mctp, MCTP_BASE_PROTOCOL_BMC_EID);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, mctp.mctp.outstanding_requests);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_IDLE, mctp.mctp.rsp_state);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_cancel_requests_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = mctp_interface_cancel_requests (NULL, MCTP_BASE_PROTOCOL_BMC_EID);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+}
+
+static void mctp_interface_test_get_outstanding_requests (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	enum mctp_interface_response_state rsp_state;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_get_outstanding_requests (&mctp.mctp, MCTP_BASE_PROTOCOL_BMC_EID,
+		&rsp_state);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_IDLE, rsp_state);
+
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		0);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0x55,
+		1);
+	mctp_interface_testing_issue_request_no_wait (test, &mctp, 0x20, 0x60, 0);
+
+	/* Requests to other devices are not counted. */
+	status = mctp_interface_get_outstanding_requests (&mctp.mctp, MCTP_BASE_PROTOCOL_BMC_EID,
+		&rsp_state);
+	CuAssertIntEquals (test, 2, status);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_WAITING, rsp_state);
+
+	status = mctp_interface_get_outstanding_requests (&mctp.mctp, 0x20, NULL);
+	CuAssertIntEquals (test, 1, status);
+
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 1, true);
+	mctp_interface_testing_receive_response (test, &mctp, MCTP_BASE_PROTOCOL_BMC_EID, 0, true);
+
+	status = mctp_interface_get_outstanding_requests (&mctp.mctp, MCTP_BASE_PROTOCOL_BMC_EID,
+		&rsp_state);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_WAITING, rsp_state);
+
+	mctp_interface_testing_receive_response (test, &mctp, 0x20, 0, true);
+
+	status = mctp_interface_get_outstanding_requests (&mctp.mctp, 0x20, &rsp_state);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, MCTP_INTERFACE_RESPONSE_SUCCESS, rsp_state);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_get_outstanding_requests_null (CuTest *test)
+{
+	enum mctp_interface_response_state rsp_state;
+	int status;
+
+	TEST_START;
+
+	status = mctp_interface_get_outstanding_requests (NULL, MCTP_BASE_PROTOCOL_BMC_EID,
+		&rsp_state);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+}
+
 static void mctp_interface_test_send_discovery_notify (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
@@ -7580,6 +8518,8 @@ TEST (mctp_interface_test_process_packet_one_packet_request);
 TEST (mctp_interface_test_process_packet_one_packet_response);
 TEST (mctp_interface_test_process_packet_one_packet_response_non_zero_message_tag);
 TEST (mctp_interface_test_process_packet_two_packet_response);
+TEST (mctp_interface_test_process_packet_pldm_request);
+TEST (mctp_interface_test_process_packet_pldm_request_packetized_response);
 TEST (mctp_interface_test_process_packet_channel_id_reset_next_som);
 TEST (mctp_interface_test_process_packet_normal_timeout);
 TEST (mctp_interface_test_process_packet_crypto_timeout);
@@ -7588,6 +8528,9 @@ TEST (mctp_interface_test_process_packet_max_response);
 TEST (mctp_interface_test_process_packet_max_response_min_packets);
 TEST (mctp_interface_test_process_packet_no_eom);
 TEST (mctp_interface_test_process_packet_reset_message_processing);
+TEST (mctp_interface_test_process_packet_interleaved_requests_different_eid);
+TEST (mctp_interface_test_process_packet_interleaved_requests_same_eid);
+TEST (mctp_interface_test_process_packet_interleaved_requests_evict_least_recent);
 TEST (mctp_interface_test_process_packet_response_length_limited);
 TEST (mctp_interface_test_process_packet_response_too_large);
 TEST (mctp_interface_test_process_packet_response_too_large_length_limited);
@@ -7623,6 +8566,16 @@ TEST (mctp_interface_test_issue_request_invalid_arg);
 TEST (mctp_interface_test_issue_request_output_buf_too_small);
 TEST (mctp_interface_test_issue_request_request_payload_too_large);
 TEST (mctp_interface_test_issue_request_no_wait);
+TEST (mctp_interface_test_issue_request_no_wait_pipelined);
+TEST (mctp_interface_test_issue_request_no_wait_pipelined_no_tag_available);
+TEST (mctp_interface_test_issue_request_no_wait_different_eid);
+TEST (mctp_interface_test_issue_request_no_wait_response_out_of_order);
+TEST (mctp_interface_test_issue_request_no_wait_discard_oldest);
+TEST (mctp_interface_test_cancel_requests);
+TEST (mctp_interface_test_cancel_requests_no_requests);
+TEST (mctp_interface_test_cancel_requests_null);
+TEST (mctp_interface_test_get_outstanding_requests);
+TEST (mctp_interface_test_get_outstanding_requests_null);
 TEST (mctp_interface_test_send_discovery_notify);
 TEST (mctp_interface_test_send_discovery_notify_followed_by_another_rq);
 TEST (mctp_interface_test_send_discovery_notify_followed_discovery_notify_rsp_then_another_rq);
@@ -20,9 +20,12 @@ struct cmd_channel_mock {
 int cmd_channel_mock_init (struct cmd_channel_mock *mock, int id);
 void cmd_channel_mock_release (struct cmd_channel_mock *mock);
 
+void cmd_channel_mock_enable_send_packets (struct cmd_channel_mock *mock);
+
 int cmd_channel_mock_validate_and_release (struct cmd_channel_mock *mock);
 
 int cmd_channel_mock_validate_packet (const char *arg_info, void *expected, void *actual);
+int cmd_channel_mock_validate_message (const char *arg_info, void *expected, void *actual);
 
 
 #endif /* CMD_CHANNEL_MOCK_H_ */
@@ -1152,24 +1152,25 @@ int flash_master_mock_expect_copy_flash_verify_4byte_explicit (struct flash_mast
 }
 
 /**
- * Set up expectations for successfully reading chunks of flash for verification.
+ * Set up expectations for successfully reading flash in chunks of a fixed size.
  *
  * @param mock The mock for the flash being verified.
  * @param start The address to start verification.
  * @param data The data that should be returned from the flash.
  * @param length The length of data being verified.
+ * @param block The maximum number of bytes read at a time.
  * @param addr4 Type of of 4-byte addressing to use:  0 = None, 1 = 4-byte, 2 = explicit 4-byte
  *
  * @return 0 if the expectations were added successfully or non-zero if not.
  */
-static int flash_master_mock_expect_verify_flash_ext (struct flash_master_mock *mock,
-	uint32_t start, const uint8_t *data, size_t length, uint8_t addr4)
+static int flash_master_mock_expect_read_flash_blocks (struct flash_master_mock *mock,
+	uint32_t start, const uint8_t *data, size_t length, size_t block, uint8_t addr4)
 {
 	int status = 0;
 	size_t read_len;
 
 	while (length != 0) {
-		read_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		read_len = (length > block) ? block : length;
 
 		status |= flash_master_mock_expect_rx_xfer (mock, 0, &WIP_STATUS, 1,
 			FLASH_EXP_READ_STATUS_REG);
@@ -1190,6 +1191,24 @@ static int flash_master_mock_expect_verify_flash_ext (struct flash_master_mock *
 	return status;
 }
 
+/**
+ * Set up expectations for successfully reading chunks of flash for verification.
+ *
+ * @param mock The mock for the flash being verified.
+ * @param start The address to start verification.
+ * @param data The data that should be returned from the flash.
+ * @param length The length of data being verified.
+ * @param addr4 Type of of 4-byte addressing to use:  0 = None, 1 = 4-byte, 2 = explicit 4-byte
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int flash_master_mock_expect_verify_flash_ext (struct flash_master_mock *mock,
+	uint32_t start, const uint8_t *data, size_t length, uint8_t addr4)
+{
+	return flash_master_mock_expect_read_flash_blocks (mock, start, data, length,
+		FLASH_VERIFICATION_BLOCK, addr4);
+}
+
 /**
  * Set up expectations for successfully reading chunks of flash for verification.
  *
@@ -1240,6 +1259,206 @@ int flash_master_mock_expect_verify_flash_4byte_explicit (struct flash_master_mo
 	return flash_master_mock_expect_verify_flash_ext (mock, start, data, length, 2);
 }
 
+/**
+ * Set up expectations for copying flash data with verification when only sectors that differ from
+ * the source are updated.  Every destination sector is expected to be blank, causing each one to
+ * be erased and programmed.  The data being copied must not start with a blank block in any
+ * sector.  Sectors no larger than the buffer are programmed without reading the source again.
+ *
+ * @param mock_dest The mock for the destination flash.
+ * @param mock_src The mock for the source flash.
+ * @param dest_addr The destination address.
+ * @param src_addr The source address.
+ * @param data The data that will be copied.
+ * @param length The length of the data.
+ * @param buf_length The length of the buffer used to read the source data.
+ * @param addr4 Type of of 4-byte addressing to use:  0 = None, 2 = explicit 4-byte
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int flash_master_mock_expect_copy_flash_if_changed_verify_ext (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length, size_t buf_length, uint8_t addr4)
+{
+	int status = 0;
+	size_t sector_len;
+	size_t read_len;
+
+	while (length > 0) {
+		sector_len = FLASH_SECTOR_SIZE - (dest_addr & ~FLASH_SECTOR_MASK);
+		sector_len = (length > sector_len) ? sector_len : length;
+		read_len = (sector_len > buf_length) ? buf_length : sector_len;
+
+		status |= flash_master_mock_expect_read_flash_blocks (mock_src, src_addr, data, read_len,
+			buf_length, addr4);
+		status |= flash_master_mock_expect_verify_flash_ext (mock_dest, dest_addr,
+			mock_dest->blank, (read_len > FLASH_VERIFICATION_BLOCK) ?
+				FLASH_VERIFICATION_BLOCK : read_len, addr4);
+		if (!addr4) {
+			status |= flash_master_mock_expect_erase_flash_sector_verify (mock_dest, dest_addr,
+				sector_len);
+		}
+		else {
+			status |= flash_master_mock_expect_erase_flash_sector_verify_4byte_explicit (mock_dest,
+				dest_addr, sector_len);
+		}
+
+		if (sector_len <= buf_length) {
+			/* The sector data was read for the comparison and is programmed from that buffer. */
+			status |= flash_master_mock_expect_write_ext (mock_dest, dest_addr, data, sector_len,
+				false, addr4);
+			status |= flash_master_mock_expect_verify_flash_ext (mock_dest, dest_addr, data,
+				sector_len, addr4);
+		}
+		else if (!addr4) {
+			status |= flash_master_mock_expect_copy_flash_verify (mock_dest, mock_src, dest_addr,
+				src_addr, data, sector_len);
+		}
+		else {
+			status |= flash_master_mock_expect_copy_flash_verify_4byte_explicit (mock_dest,
+				mock_src, dest_addr, src_addr, data, sector_len);
+		}
+
+		length -= sector_len;
+		dest_addr += sector_len;
+		src_addr += sector_len;
+		data += sector_len;
+	}
+
+	return status;
+}
+
+/**
+ * Set up expectations for copying flash data with verification when only sectors that differ from
+ * the source are updated.  Every destination sector is expected to be blank, causing each one to
+ * be erased and programmed.  The data being copied must not start with a blank block in any
+ * sector.
+ *
+ * @param mock_dest The mock for the destination flash.
+ * @param mock_src The mock for the source flash.
+ * @param dest_addr The destination address.
+ * @param src_addr The source address.
+ * @param data The data that will be copied.
+ * @param length The length of the data.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_master_mock_expect_copy_flash_if_changed_verify (struct flash_master_mock *mock_dest,
+	struct flash_master_mock *mock_src, uint32_t dest_addr, uint32_t src_addr, const uint8_t *data,
+	size_t length)
+{
+	return flash_master_mock_expect_copy_flash_if_changed_verify_ext (mock_dest, mock_src,
+		dest_addr, src_addr, data, length, FLASH_VERIFICATION_BLOCK, 0);
+}
+
+/**
+ * Set up expectations for copying flash data with verification when only sectors that differ from
+ * the source are updated using explicit 4-byte address commands.  Every destination sector is
+ * expected to be blank, causing each one to be erased and programmed.  The data being copied must
+ * not start with a blank block in any sector.
+ *
+ * @param mock_dest The mock for the destination flash.
+ * @param mock_src The mock for the source flash.
+ * @param dest_addr The destination address.
+ * @param src_addr The source address.
+ * @param data The data that will be copied.
+ * @param length The length of the data.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length)
+{
+	return flash_master_mock_expect_copy_flash_if_changed_verify_ext (mock_dest, mock_src,
+		dest_addr, src_addr, data, length, FLASH_VERIFICATION_BLOCK, 2);
+}
+
+/**
+ * Set up expectations for copying flash data with verification when only sectors that differ from
+ * the source are updated and the source is read using a buffer of a specific size.  Every
+ * destination sector is expected to be blank, causing each one to be erased and programmed.  The
+ * data being copied must not start with a blank block in any sector.
+ *
+ * @param mock_dest The mock for the destination flash.
+ * @param mock_src The mock for the source flash.
+ * @param dest_addr The destination address.
+ * @param src_addr The source address.
+ * @param data The data that will be copied.
+ * @param length The length of the data.
+ * @param buf_length The length of the buffer used to read the source data.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length, size_t buf_length)
+{
+	return flash_master_mock_expect_copy_flash_if_changed_verify_ext (mock_dest, mock_src,
+		dest_addr, src_addr, data, length, buf_length, 0);
+}
+
+/**
+ * Set up expectations for copying flash data when only sectors that differ from the source are
+ * updated and the destination already contains the source data.  No sectors will be erased or
+ * programmed.
+ *
+ * @param mock_dest The mock for the destination flash.
+ * @param mock_src The mock for the source flash.
+ * @param dest_addr The destination address.
+ * @param src_addr The source address.
+ * @param data The data contained in both flash devices.
+ * @param length The length of the data.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_master_mock_expect_copy_flash_if_changed_unchanged (struct flash_master_mock *mock_dest,
+	struct flash_master_mock *mock_src, uint32_t dest_addr, uint32_t src_addr, const uint8_t *data,
+	size_t length)
+{
+	return flash_master_mock_expect_copy_flash_if_changed_unchanged_buffered (mock_dest, mock_src,
+		dest_addr, src_addr, data, length, FLASH_VERIFICATION_BLOCK);
+}
+
+/**
+ * Set up expectations for copying flash data when only sectors that differ from the source are
+ * updated, the source is read using a buffer of a specific size, and the destination already
+ * contains the source data.  No sectors will be erased or programmed.
+ *
+ * @param mock_dest The mock for the destination flash.
+ * @param mock_src The mock for the source flash.
+ * @param dest_addr The destination address.
+ * @param src_addr The source address.
+ * @param data The data contained in both flash devices.
+ * @param length The length of the data.
+ * @param buf_length The length of the buffer used to read the source data.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_master_mock_expect_copy_flash_if_changed_unchanged_buffered (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length, size_t buf_length)
+{
+	int status = 0;
+	size_t sector_len;
+
+	while (length > 0) {
+		sector_len = FLASH_SECTOR_SIZE - (dest_addr & ~FLASH_SECTOR_MASK);
+		sector_len = (length > sector_len) ? sector_len : length;
+
+		status |= flash_master_mock_expect_read_flash_blocks (mock_src, src_addr, data,
+			sector_len, buf_length, 0);
+		status |= flash_master_mock_expect_verify_flash (mock_dest, dest_addr, data, sector_len);
+
+		length -= sector_len;
+		dest_addr += sector_len;
+		src_addr += sector_len;
+		data += sector_len;
+	}
+
+	return status;
+}
+
 /**
  * Set up expectations for successfully programming data to a flash device.
  *
@@ -114,6 +114,21 @@ int flash_master_mock_expect_copy_flash_verify_4byte (struct flash_master_mock *
 int flash_master_mock_expect_copy_flash_verify_4byte_explicit (struct flash_master_mock *mock_dest,
 	struct flash_master_mock *mock_src, uint32_t dest_addr, uint32_t src_addr, const uint8_t *data,
 	size_t length);
+int flash_master_mock_expect_copy_flash_if_changed_verify (struct flash_master_mock *mock_dest,
+	struct flash_master_mock *mock_src, uint32_t dest_addr, uint32_t src_addr, const uint8_t *data,
+	size_t length);
+int flash_master_mock_expect_copy_flash_if_changed_verify_4byte_explicit (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length);
+int flash_master_mock_expect_copy_flash_if_changed_verify_buffered (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length, size_t buf_length);
+int flash_master_mock_expect_copy_flash_if_changed_unchanged (struct flash_master_mock *mock_dest,
+	struct flash_master_mock *mock_src, uint32_t dest_addr, uint32_t src_addr, const uint8_t *data,
+	size_t length);
+int flash_master_mock_expect_copy_flash_if_changed_unchanged_buffered (
+	struct flash_master_mock *mock_dest, struct flash_master_mock *mock_src, uint32_t dest_addr,
+	uint32_t src_addr, const uint8_t *data, size_t length, size_t buf_length);
 int flash_master_mock_expect_verify_flash (struct flash_master_mock *mock, uint32_t start,
 	const uint8_t *data, size_t length);
 int flash_master_mock_expect_verify_flash_4byte (struct flash_master_mock *mock, uint32_t start,
@@ -21,6 +21,7 @@ struct flash_mock {
 
 
 int flash_mock_init (struct flash_mock *mock);
+void flash_mock_enable_read_start (struct flash_mock *mock);
 void flash_mock_release (struct flash_mock *mock);
 
 int flash_mock_validate_and_release (struct flash_mock *mock);
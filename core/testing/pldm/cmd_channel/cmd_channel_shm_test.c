@@ -0,0 +1,616 @@
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "testing.h"
+#include "pldm/cmd_channel/cmd_channel_shm.h"
+
+
+TEST_SUITE_LABEL ("cmd_channel_shm");
+
+
+/**
+ * Dependencies for testing shared memory channels.  Both ends of the link are run in the same process unless a test
+ * forks a child for one end.
+ */
+struct cmd_channel_shm_testing {
+    struct cmd_channel_shm_link link;
+    struct cmd_channel_shm side_a;
+    struct cmd_channel_shm side_b;
+};
+
+
+/**
+ * Initialize a link and both channels that use it.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies to initialize.
+ */
+static void cmd_channel_shm_testing_init(CuTest *test, struct cmd_channel_shm_testing *testing)
+{
+    int status;
+
+    status = cmd_channel_shm_link_init(&testing->link);
+    CuAssertIntEquals(test, 0, status);
+
+    status = cmd_channel_shm_init(&testing->side_a, 1, &testing->link, CMD_CHANNEL_SHM_SIDE_A);
+    CuAssertIntEquals(test, 0, status);
+
+    status = cmd_channel_shm_init(&testing->side_b, 2, &testing->link, CMD_CHANNEL_SHM_SIDE_B);
+    CuAssertIntEquals(test, 0, status);
+}
+
+/**
+ * Release the channels and link used for testing.
+ *
+ * @param testing The testing dependencies to release.
+ */
+static void cmd_channel_shm_testing_release(struct cmd_channel_shm_testing *testing)
+{
+    cmd_channel_shm_release(&testing->side_a);
+    cmd_channel_shm_release(&testing->side_b);
+    cmd_channel_shm_link_release(&testing->link);
+}
+
+/**
+ * Send a packet filled with a known pattern.
+ *
+ * @param channel The channel to send the packet on.
+ * @param length The length of the packet.
+ * @param seed The first byte of the pattern.
+ *
+ * @return The status of the send.
+ */
+static int cmd_channel_shm_testing_send(struct cmd_channel_shm *channel, size_t length, uint8_t seed)
+{
+    struct cmd_packet packet;
+    size_t i;
+
+    memset(&packet, 0, sizeof (packet));
+    for (i = 0; i < length; i++) {
+        packet.data[i] = seed + i;
+    }
+    packet.pkt_size = length;
+
+    return channel->base.send_packet(&channel->base, &packet);
+}
+
+/**
+ * Receive a packet and check that it has the expected pattern.
+ *
+ * @param test The testing framework.
+ * @param channel The channel to receive the packet from.
+ * @param length The expected length of the packet.
+ * @param seed The expected first byte of the pattern.
+ */
+static void cmd_channel_shm_testing_receive(CuTest *test, struct cmd_channel_shm *channel, size_t length,
+    uint8_t seed)
+{
+    struct cmd_packet packet;
+    size_t i;
+    int status;
+
+    memset(&packet, 0, sizeof (packet));
+
+    status = channel->base.receive_packet(&channel->base, &packet, 0);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, length, packet.pkt_size);
+    CuAssertIntEquals(test, cmd_channel_get_id(&channel->base), packet.dest_addr);
+    CuAssertIntEquals(test, CMD_VALID_PACKET, packet.state);
+    CuAssertIntEquals(test, false, packet.timeout_valid);
+
+    for (i = 0; i < length; i++) {
+        CuAssertIntEquals(test, (uint8_t) (seed + i), packet.data[i]);
+    }
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_channel_shm_test_init(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    CuAssertPtrNotNull(test, testing.link.region);
+    CuAssertPtrNotNull(test, testing.side_a.base.receive_packet);
+    CuAssertPtrNotNull(test, testing.side_a.base.send_packet);
+    CuAssertPtrNotNull(test, testing.side_a.base.send_packets);
+    CuAssertIntEquals(test, 1, cmd_channel_get_id(&testing.side_a.base));
+    CuAssertIntEquals(test, 2, cmd_channel_get_id(&testing.side_b.base));
+
+    CuAssertPtrEquals(test, testing.side_a.tx, testing.side_b.rx);
+    CuAssertPtrEquals(test, testing.side_a.rx, testing.side_b.tx);
+    CuAssertIntEquals(test, testing.side_a.tx_event, testing.side_b.rx_event);
+    CuAssertIntEquals(test, testing.side_a.rx_event, testing.side_b.tx_event);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_init_null(CuTest *test)
+{
+    struct cmd_channel_shm_link link;
+    struct cmd_channel_shm channel;
+    struct cmd_channel_shm_link no_region;
+    int status;
+
+    TEST_START;
+
+    status = cmd_channel_shm_link_init(NULL);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    status = cmd_channel_shm_link_init(&link);
+    CuAssertIntEquals(test, 0, status);
+
+    status = cmd_channel_shm_init(NULL, 1, &link, CMD_CHANNEL_SHM_SIDE_A);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    status = cmd_channel_shm_init(&channel, 1, NULL, CMD_CHANNEL_SHM_SIDE_A);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    memset(&no_region, 0, sizeof (no_region));
+    status = cmd_channel_shm_init(&channel, 1, &no_region, CMD_CHANNEL_SHM_SIDE_A);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    status = cmd_channel_shm_init(&channel, 1, &link, (enum cmd_channel_shm_side) 2);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    cmd_channel_shm_link_release(&link);
+}
+
+static void cmd_channel_shm_test_release_null(CuTest *test)
+{
+    TEST_START;
+
+    cmd_channel_shm_release(NULL);
+    cmd_channel_shm_link_release(NULL);
+}
+
+static void cmd_channel_shm_test_send_receive(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 10, 0x10);
+    CuAssertIntEquals(test, 0, status);
+
+    status = cmd_channel_shm_testing_send(&testing.side_b, CMD_MAX_PACKET_SIZE, 0x80);
+    CuAssertIntEquals(test, 0, status);
+
+    cmd_channel_shm_testing_receive(test, &testing.side_b, 10, 0x10);
+    cmd_channel_shm_testing_receive(test, &testing.side_a, CMD_MAX_PACKET_SIZE, 0x80);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_receive_zero_timeout(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    struct cmd_packet packet;
+    platform_clock start;
+    platform_clock end;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    platform_init_current_tick(&start);
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 0);
+    platform_init_current_tick(&end);
+    CuAssertIntEquals(test, CMD_CHANNEL_RX_TIMEOUT, status);
+    CuAssertTrue(test, (platform_get_duration(&start, &end) < 50));
+
+    /* Nothing is left waiting on the ring by an immediate return. */
+    CuAssertIntEquals(test, 0, testing.side_b.rx->waiting);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_receive_timeout(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    struct cmd_packet packet;
+    platform_clock start;
+    platform_clock end;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    platform_init_current_tick(&start);
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 100);
+    platform_init_current_tick(&end);
+    CuAssertIntEquals(test, CMD_CHANNEL_RX_TIMEOUT, status);
+    CuAssertTrue(test, (platform_get_duration(&start, &end) >= 90));
+    CuAssertIntEquals(test, 0, testing.side_b.rx->waiting);
+
+    /* A packet that is already queued is returned without waiting. */
+    status = cmd_channel_shm_testing_send(&testing.side_a, 20, 0x20);
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 100);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 20, packet.pkt_size);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_receive_null(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    struct cmd_packet packet;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    status = testing.side_b.base.receive_packet(NULL, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, NULL, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_receive_oversized_slot(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    struct cmd_packet packet;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 10, 0x10);
+    CuAssertIntEquals(test, 0, status);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 11, 0x30);
+    CuAssertIntEquals(test, 0, status);
+
+    /* A corrupt length from the other end of the link must not overflow the packet. */
+    testing.side_a.tx->slots[0].pkt_size = CMD_MAX_PACKET_SIZE + 1;
+
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_PKT_SIZE, status);
+    CuAssertIntEquals(test, 1, testing.side_b.rx->head);
+
+    /* The bad slot is skipped, so the next packet is still received. */
+    cmd_channel_shm_testing_receive(test, &testing.side_b, 11, 0x30);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_send_packet_invalid_size(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 0, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_PKT_SIZE, status);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, CMD_MAX_PACKET_SIZE + 1, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_PKT_SIZE, status);
+
+    CuAssertIntEquals(test, 0, testing.side_a.tx->tail);
+
+    status = testing.side_a.base.send_packet(NULL, NULL);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    status = testing.side_a.base.send_packet(&testing.side_a.base, NULL);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_ring_full(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    int status;
+    int i;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    for (i = 0; i < CMD_CHANNEL_SHM_RING_LEN; i++) {
+        status = cmd_channel_shm_testing_send(&testing.side_a, 8, i);
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 8, 0xff);
+    CuAssertIntEquals(test, CMD_CHANNEL_TX_FAILED, status);
+    CuAssertIntEquals(test, CMD_CHANNEL_SHM_RING_LEN, testing.side_a.tx->tail);
+
+    /* The other direction of the link is not affected. */
+    status = cmd_channel_shm_testing_send(&testing.side_b, 8, 0x40);
+    CuAssertIntEquals(test, 0, status);
+
+    /* Receiving a packet makes room for one more. */
+    cmd_channel_shm_testing_receive(test, &testing.side_b, 8, 0);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 8, 0xff);
+    CuAssertIntEquals(test, 0, status);
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 8, 0xff);
+    CuAssertIntEquals(test, CMD_CHANNEL_TX_FAILED, status);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_ring_wrap(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    int status;
+    int i;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    /* Keep a few packets queued while the indexes pass the end of the ring several times. */
+    for (i = 0; i < 3; i++) {
+        status = cmd_channel_shm_testing_send(&testing.side_a, 1 + i, i);
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    for (i = 3; i < ((CMD_CHANNEL_SHM_RING_LEN * 2) + 5); i++) {
+        status = cmd_channel_shm_testing_send(&testing.side_a, 1 + (i % CMD_MAX_PACKET_SIZE), i);
+        CuAssertIntEquals(test, 0, status);
+
+        cmd_channel_shm_testing_receive(test, &testing.side_b, 1 + ((i - 3) % CMD_MAX_PACKET_SIZE), i - 3);
+    }
+
+    CuAssertIntEquals(test, (CMD_CHANNEL_SHM_RING_LEN * 2) + 5, testing.side_a.tx->tail);
+    CuAssertIntEquals(test, (CMD_CHANNEL_SHM_RING_LEN * 2) + 2, testing.side_b.rx->head);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_ring_wrap_index_overflow(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    int status;
+    int i;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    /* The free running indexes wrap at 32 bits. */
+    testing.side_a.tx->tail = UINT32_MAX - 1;
+    testing.side_a.tx->head = UINT32_MAX - 1;
+
+    for (i = 0; i < CMD_CHANNEL_SHM_RING_LEN; i++) {
+        status = cmd_channel_shm_testing_send(&testing.side_a, 4, i);
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    status = cmd_channel_shm_testing_send(&testing.side_a, 4, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_TX_FAILED, status);
+
+    for (i = 0; i < CMD_CHANNEL_SHM_RING_LEN; i++) {
+        cmd_channel_shm_testing_receive(test, &testing.side_b, 4, i);
+    }
+
+    CuAssertIntEquals(test, CMD_CHANNEL_SHM_RING_LEN - 2, testing.side_b.rx->head);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_send_packets(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    uint8_t data[(CMD_MAX_PACKET_SIZE * 3) + 7];
+    struct cmd_message message;
+    struct cmd_packet packet;
+    size_t i;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    for (i = 0; i < sizeof (data); i++) {
+        data[i] = i;
+    }
+
+    message.data = data;
+    message.msg_size = sizeof (data);
+    message.pkt_size = CMD_MAX_PACKET_SIZE;
+    message.dest_addr = 2;
+
+    status = testing.side_a.base.send_packets(&testing.side_a.base, &message);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 4, testing.side_a.tx->tail);
+
+    for (i = 0; i < 3; i++) {
+        cmd_channel_shm_testing_receive(test, &testing.side_b, CMD_MAX_PACKET_SIZE, i * CMD_MAX_PACKET_SIZE);
+    }
+
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 0);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 7, packet.pkt_size);
+
+    status = testing_validate_array(&data[CMD_MAX_PACKET_SIZE * 3], packet.data, 7);
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_RX_TIMEOUT, status);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_send_packets_no_room(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    uint8_t data[8 * 3];
+    struct cmd_message message;
+    int status;
+    int i;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    for (i = 0; i < (CMD_CHANNEL_SHM_RING_LEN - 2); i++) {
+        status = cmd_channel_shm_testing_send(&testing.side_a, 8, i);
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    memset(data, 0x55, sizeof (data));
+    message.data = data;
+    message.msg_size = sizeof (data);
+    message.pkt_size = 8;
+    message.dest_addr = 2;
+
+    /* None of the packets are queued if the whole message doesn't fit. */
+    status = testing.side_a.base.send_packets(&testing.side_a.base, &message);
+    CuAssertIntEquals(test, CMD_CHANNEL_TX_FAILED, status);
+    CuAssertIntEquals(test, CMD_CHANNEL_SHM_RING_LEN - 2, testing.side_a.tx->tail);
+
+    cmd_channel_shm_testing_receive(test, &testing.side_b, 8, 0);
+
+    status = testing.side_a.base.send_packets(&testing.side_a.base, &message);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, CMD_CHANNEL_SHM_RING_LEN + 1, testing.side_a.tx->tail);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_send_packets_invalid(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    uint8_t data[16];
+    struct cmd_message message;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    message.data = data;
+    message.msg_size = sizeof (data);
+    message.pkt_size = 0;
+    message.dest_addr = 2;
+
+    status = testing.side_a.base.send_packets(&testing.side_a.base, &message);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_PKT_SIZE, status);
+
+    message.pkt_size = CMD_MAX_PACKET_SIZE + 1;
+    status = testing.side_a.base.send_packets(&testing.side_a.base, &message);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_PKT_SIZE, status);
+
+    /* An empty message sends nothing. */
+    message.pkt_size = 8;
+    message.msg_size = 0;
+    status = testing.side_a.base.send_packets(&testing.side_a.base, &message);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 0, testing.side_a.tx->tail);
+
+    status = testing.side_a.base.send_packets(NULL, &message);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    status = testing.side_a.base.send_packets(&testing.side_a.base, NULL);
+    CuAssertIntEquals(test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+static void cmd_channel_shm_test_forked_peer(CuTest *test)
+{
+    struct cmd_channel_shm_testing testing;
+    struct cmd_packet packet;
+    pid_t child;
+    int child_status;
+    int status;
+    int i;
+
+    TEST_START;
+
+    cmd_channel_shm_testing_init(test, &testing);
+
+    child = fork();
+    CuAssertTrue(test, (child >= 0));
+
+    if (child == 0) {
+        /* The child is side B.  It waits for each packet and echoes it back with every byte incremented. */
+        for (i = 0; i < 4; i++) {
+            status = testing.side_b.base.receive_packet(&testing.side_b.base, &packet, 5000);
+            if (status != 0) {
+                _exit(1);
+            }
+
+            packet.data[0]++;
+            packet.data[packet.pkt_size - 1]++;
+
+            status = testing.side_b.base.send_packet(&testing.side_b.base, &packet);
+            if (status != 0) {
+                _exit(2);
+            }
+        }
+
+        _exit(0);
+    }
+
+    for (i = 0; i < 4; i++) {
+        /* Give the child time to sleep on the eventfd so the wakeup path is used. */
+        platform_msleep(20);
+
+        status = cmd_channel_shm_testing_send(&testing.side_a, 16 + i, i * 0x10);
+        CuAssertIntEquals(test, 0, status);
+
+        status = testing.side_a.base.receive_packet(&testing.side_a.base, &packet, 5000);
+        CuAssertIntEquals(test, 0, status);
+        CuAssertIntEquals(test, 16 + i, packet.pkt_size);
+        CuAssertIntEquals(test, 1, packet.dest_addr);
+        CuAssertIntEquals(test, (uint8_t) ((i * 0x10) + 1), packet.data[0]);
+        CuAssertIntEquals(test, (uint8_t) ((i * 0x10) + 1), packet.data[1]);
+        CuAssertIntEquals(test, (uint8_t) ((i * 0x10) + 16 + i), packet.data[15 + i]);
+    }
+
+    CuAssertIntEquals(test, child, waitpid(child, &child_status, 0));
+    CuAssertTrue(test, WIFEXITED(child_status));
+    CuAssertIntEquals(test, 0, WEXITSTATUS(child_status));
+
+    cmd_channel_shm_testing_release(&testing);
+}
+
+
+TEST_SUITE_START (cmd_channel_shm);
+
+TEST (cmd_channel_shm_test_init);
+TEST (cmd_channel_shm_test_init_null);
+TEST (cmd_channel_shm_test_release_null);
+TEST (cmd_channel_shm_test_send_receive);
+TEST (cmd_channel_shm_test_receive_zero_timeout);
+TEST (cmd_channel_shm_test_receive_timeout);
+TEST (cmd_channel_shm_test_receive_null);
+TEST (cmd_channel_shm_test_receive_oversized_slot);
+TEST (cmd_channel_shm_test_send_packet_invalid_size);
+TEST (cmd_channel_shm_test_ring_full);
+TEST (cmd_channel_shm_test_ring_wrap);
+TEST (cmd_channel_shm_test_ring_wrap_index_overflow);
+TEST (cmd_channel_shm_test_send_packets);
+TEST (cmd_channel_shm_test_send_packets_no_room);
+TEST (cmd_channel_shm_test_send_packets_invalid);
+TEST (cmd_channel_shm_test_forked_peer);
+
+TEST_SUITE_END;
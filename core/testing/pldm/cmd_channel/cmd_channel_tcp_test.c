@@ -0,0 +1,590 @@
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "testing.h"
+#include "pldm/cmd_channel/cmd_channel_tcp.h"
+
+
+TEST_SUITE_LABEL ("cmd_channel_tcp");
+
+
+/**
+ * Dependencies for testing the TCP channel.  The channel sends and receives on the local ends of socket pairs, and the
+ * test acts as the peer on the remote ends.
+ */
+struct cmd_channel_tcp_testing {
+    struct cmd_channel channel;
+    int rx_peer;
+    int tx_peer;
+};
+
+
+/**
+ * Initialize the channel and connect it to the testing peer.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies to initialize.
+ */
+static void cmd_channel_tcp_testing_init(CuTest *test, struct cmd_channel_tcp_testing *testing)
+{
+    int rx[2];
+    int tx[2];
+    int status;
+
+    status = cmd_channel_init(&testing->channel, 0x41);
+    CuAssertIntEquals(test, 0, status);
+
+    testing->channel.send_packet = send_packet;
+    testing->channel.send_packets = send_packets;
+    testing->channel.receive_packet = receive_packet;
+
+    status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    status = socketpair(AF_UNIX, SOCK_STREAM, 0, rx);
+    CuAssertIntEquals(test, 0, status);
+
+    status = socketpair(AF_UNIX, SOCK_STREAM, 0, tx);
+    CuAssertIntEquals(test, 0, status);
+
+    status = add_global_server_connection(rx[0]);
+    CuAssertIntEquals(test, 0, status);
+
+    status = set_global_client_connection(tx[0]);
+    CuAssertIntEquals(test, 0, status);
+
+    testing->rx_peer = rx[1];
+    testing->tx_peer = tx[1];
+}
+
+/**
+ * Release the channel and close the testing peer.
+ *
+ * @param testing The testing dependencies to release.
+ */
+static void cmd_channel_tcp_testing_release(struct cmd_channel_tcp_testing *testing)
+{
+    if (testing->rx_peer != -1) {
+        close(testing->rx_peer);
+    }
+    if (testing->tx_peer != -1) {
+        close(testing->tx_peer);
+    }
+
+    close_global_server_socket();
+    cmd_channel_release(&testing->channel);
+}
+
+/**
+ * Build a frame for a packet filled with a known pattern.
+ *
+ * @param frame Output for the frame.
+ * @param length The length of the packet.
+ * @param seed The first byte of the pattern.
+ *
+ * @return The length of the frame.
+ */
+static size_t cmd_channel_tcp_testing_frame(uint8_t *frame, size_t length, uint8_t seed)
+{
+    size_t i;
+
+    frame[0] = (length >> 8) & 0xff;
+    frame[1] = length & 0xff;
+    for (i = 0; i < length; i++) {
+        frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + i] = seed + i;
+    }
+
+    return CMD_CHANNEL_TCP_FRAME_HEADER_LEN + length;
+}
+
+/**
+ * Receive a packet and check that it has the expected pattern.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies.
+ * @param length The expected length of the packet.
+ * @param seed The expected first byte of the pattern.
+ */
+static void cmd_channel_tcp_testing_check_receive(CuTest *test, struct cmd_channel_tcp_testing *testing,
+    size_t length, uint8_t seed)
+{
+    struct cmd_packet packet;
+    size_t i;
+    int status;
+
+    memset(&packet, 0, sizeof (packet));
+
+    status = testing->channel.receive_packet(&testing->channel, &packet, 1000);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, length, packet.pkt_size);
+    CuAssertIntEquals(test, 0x41, packet.dest_addr);
+
+    for (i = 0; i < length; i++) {
+        CuAssertIntEquals(test, (uint8_t) (seed + i), packet.data[i]);
+    }
+}
+
+/**
+ * Read a frame sent by the channel and check that it has the expected packet.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies.
+ * @param data The expected packet data.
+ * @param length The expected length of the packet.
+ */
+static void cmd_channel_tcp_testing_check_frame(CuTest *test, struct cmd_channel_tcp_testing *testing,
+    const uint8_t *data, size_t length)
+{
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+    size_t expected = CMD_CHANNEL_TCP_FRAME_HEADER_LEN + length;
+    size_t received = 0;
+    ssize_t bytes;
+    int status;
+
+    while (received < expected) {
+        bytes = read(testing->tx_peer, &frame[received], expected - received);
+        CuAssertTrue(test, bytes > 0);
+        received += bytes;
+    }
+
+    CuAssertIntEquals(test, (length >> 8) & 0xff, frame[0]);
+    CuAssertIntEquals(test, length & 0xff, frame[1]);
+
+    status = testing_validate_array(data, &frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN], length);
+    CuAssertIntEquals(test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_channel_tcp_test_receive_packet(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+    size_t length;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    length = cmd_channel_tcp_testing_frame(frame, 64, 0x10);
+    CuAssertIntEquals(test, length, write(testing.rx_peer, frame, length));
+
+    cmd_channel_tcp_testing_check_receive(test, &testing, 64, 0x10);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_max_length(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+    size_t length;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    length = cmd_channel_tcp_testing_frame(frame, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN, 0x80);
+    CuAssertIntEquals(test, length, write(testing.rx_peer, frame, length));
+
+    cmd_channel_tcp_testing_check_receive(test, &testing, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN, 0x80);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_multiple_frames(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t stream[3 * (CMD_CHANNEL_TCP_FRAME_HEADER_LEN + 64)];
+    size_t length = 0;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    /* Several frames received in a single stream read are returned one packet at a time. */
+    length += cmd_channel_tcp_testing_frame(&stream[length], 10, 0x00);
+    length += cmd_channel_tcp_testing_frame(&stream[length], 64, 0x20);
+    length += cmd_channel_tcp_testing_frame(&stream[length], 1, 0x40);
+    CuAssertIntEquals(test, length, write(testing.rx_peer, stream, length));
+
+    cmd_channel_tcp_testing_check_receive(test, &testing, 10, 0x00);
+    cmd_channel_tcp_testing_check_receive(test, &testing, 64, 0x20);
+    cmd_channel_tcp_testing_check_receive(test, &testing, 1, 0x40);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_split_frame(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + 64];
+    struct cmd_packet packet;
+    size_t length;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    length = cmd_channel_tcp_testing_frame(frame, 64, 0x33);
+
+    /* A partial header or packet is buffered until the rest of the frame arrives. */
+    CuAssertIntEquals(test, 1, write(testing.rx_peer, frame, 1));
+
+    status = testing.channel.receive_packet(&testing.channel, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_SOC_TIMEOUT_ERROR, status);
+
+    CuAssertIntEquals(test, 20, write(testing.rx_peer, &frame[1], 20));
+
+    status = testing.channel.receive_packet(&testing.channel, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_SOC_TIMEOUT_ERROR, status);
+
+    CuAssertIntEquals(test, length - 21, write(testing.rx_peer, &frame[21], length - 21));
+
+    cmd_channel_tcp_testing_check_receive(test, &testing, 64, 0x33);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_timeout(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    struct cmd_packet packet;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    status = testing.channel.receive_packet(&testing.channel, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_SOC_TIMEOUT_ERROR, status);
+
+    status = testing.channel.receive_packet(&testing.channel, &packet, 10);
+    CuAssertIntEquals(test, CMD_CHANNEL_SOC_TIMEOUT_ERROR, status);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_invalid_frame(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + 16];
+    struct cmd_packet packet;
+    size_t length;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    /* The length in the header is larger than any packet, so the stream can't be resynchronized. */
+    frame[0] = ((MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + 1) >> 8) & 0xff;
+    frame[1] = (MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + 1) & 0xff;
+    CuAssertIntEquals(test, 2, write(testing.rx_peer, frame, 2));
+
+    length = cmd_channel_tcp_testing_frame(frame, 16, 0x01);
+    CuAssertIntEquals(test, length, write(testing.rx_peer, frame, length));
+
+    status = testing.channel.receive_packet(&testing.channel, &packet, 10);
+    CuAssertIntEquals(test, CMD_CHANNEL_SOC_TIMEOUT_ERROR, status);
+
+    /* The connection was closed by the channel. */
+    CuAssertIntEquals(test, 0, read(testing.rx_peer, frame, sizeof (frame)));
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_zero_length_frame(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN] = {0};
+    struct cmd_packet packet;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    CuAssertIntEquals(test, sizeof (frame), write(testing.rx_peer, frame, sizeof (frame)));
+
+    status = testing.channel.receive_packet(&testing.channel, &packet, 10);
+    CuAssertIntEquals(test, CMD_CHANNEL_SOC_TIMEOUT_ERROR, status);
+
+    CuAssertIntEquals(test, 0, read(testing.rx_peer, frame, sizeof (frame)));
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_after_peer_closed(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + 32];
+    size_t length;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    /* Complete packets received before the peer closed the connection are still returned. */
+    length = cmd_channel_tcp_testing_frame(frame, 32, 0x55);
+    CuAssertIntEquals(test, length, write(testing.rx_peer, frame, length));
+
+    close(testing.rx_peer);
+    testing.rx_peer = -1;
+
+    cmd_channel_tcp_testing_check_receive(test, &testing, 32, 0x55);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_receive_packet_not_initialized(CuTest *test)
+{
+    struct cmd_channel channel;
+    struct cmd_packet packet;
+    int status;
+
+    TEST_START;
+
+    status = cmd_channel_init(&channel, 0x41);
+    CuAssertIntEquals(test, 0, status);
+
+    status = receive_packet(&channel, &packet, 0);
+    CuAssertIntEquals(test, CMD_CHANNEL_CREATE_SOC_ERROR, status);
+
+    status = add_global_server_connection(0);
+    CuAssertIntEquals(test, CMD_CHANNEL_CREATE_SOC_ERROR, status);
+
+    cmd_channel_release(&channel);
+}
+
+static void cmd_channel_tcp_test_add_connection_max_connections(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    int pairs[CMD_CHANNEL_TCP_MAX_CONNECTIONS][2];
+    int i;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    /* One connection is already used by the testing peer. */
+    for (i = 0; i < CMD_CHANNEL_TCP_MAX_CONNECTIONS; i++) {
+        status = socketpair(AF_UNIX, SOCK_STREAM, 0, pairs[i]);
+        CuAssertIntEquals(test, 0, status);
+
+        status = add_global_server_connection(pairs[i][0]);
+        if (i < (CMD_CHANNEL_TCP_MAX_CONNECTIONS - 1)) {
+            CuAssertIntEquals(test, 0, status);
+        }
+        else {
+            CuAssertIntEquals(test, CMD_CHANNEL_SOC_MAX_CONNECTIONS_ERROR, status);
+            close(pairs[i][0]);
+        }
+    }
+
+    for (i = 0; i < CMD_CHANNEL_TCP_MAX_CONNECTIONS; i++) {
+        close(pairs[i][1]);
+    }
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_send_packet(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    struct cmd_packet packet;
+    size_t i;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    memset(&packet, 0, sizeof (packet));
+    for (i = 0; i < 100; i++) {
+        packet.data[i] = i * 3;
+    }
+    packet.pkt_size = 100;
+
+    status = testing.channel.send_packet(&testing.channel, &packet);
+    CuAssertIntEquals(test, 0, status);
+
+    cmd_channel_tcp_testing_check_frame(test, &testing, packet.data, 100);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_send_packet_invalid_size(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    struct cmd_packet packet;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    memset(&packet, 0, sizeof (packet));
+
+    status = testing.channel.send_packet(&testing.channel, &packet);
+    CuAssertIntEquals(test, CMD_CHANNEL_PKT_TOO_LARGE_ERROR, status);
+
+    packet.pkt_size = MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + 1;
+
+    status = testing.channel.send_packet(&testing.channel, &packet);
+    CuAssertIntEquals(test, CMD_CHANNEL_PKT_TOO_LARGE_ERROR, status);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_send_packets(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t data[(2 * MCTP_BASE_PROTOCOL_MAX_PACKET_LEN) + 10];
+    struct cmd_message message;
+    size_t i;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    for (i = 0; i < sizeof (data); i++) {
+        data[i] = i;
+    }
+
+    message.data = data;
+    message.msg_size = sizeof (data);
+    message.pkt_size = MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
+    message.dest_addr = 0x10;
+
+    /* Each packet is framed separately and the last packet only contains the rest of the message. */
+    status = testing.channel.send_packets(&testing.channel, &message);
+    CuAssertIntEquals(test, 0, status);
+
+    cmd_channel_tcp_testing_check_frame(test, &testing, data, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN);
+    cmd_channel_tcp_testing_check_frame(test, &testing, &data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN],
+        MCTP_BASE_PROTOCOL_MAX_PACKET_LEN);
+    cmd_channel_tcp_testing_check_frame(test, &testing, &data[2 * MCTP_BASE_PROTOCOL_MAX_PACKET_LEN], 10);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_send_packets_multiple_batches(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t data[(CMD_CHANNEL_TCP_MAX_BATCH_PACKETS + 2) * 16];
+    struct cmd_message message;
+    size_t i;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    for (i = 0; i < sizeof (data); i++) {
+        data[i] = i * 7;
+    }
+
+    message.data = data;
+    message.msg_size = sizeof (data);
+    message.pkt_size = 16;
+    message.dest_addr = 0x10;
+
+    /* More packets than fit in a single batch are sent in order. */
+    status = testing.channel.send_packets(&testing.channel, &message);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = 0; i < (CMD_CHANNEL_TCP_MAX_BATCH_PACKETS + 2); i++) {
+        cmd_channel_tcp_testing_check_frame(test, &testing, &data[i * 16], 16);
+    }
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_send_packets_invalid_size(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t data[16];
+    struct cmd_message message;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    message.data = data;
+    message.msg_size = sizeof (data);
+    message.pkt_size = 0;
+    message.dest_addr = 0x10;
+
+    status = testing.channel.send_packets(&testing.channel, &message);
+    CuAssertIntEquals(test, CMD_CHANNEL_PKT_TOO_LARGE_ERROR, status);
+
+    message.pkt_size = MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + 1;
+
+    status = testing.channel.send_packets(&testing.channel, &message);
+    CuAssertIntEquals(test, CMD_CHANNEL_PKT_TOO_LARGE_ERROR, status);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+static void cmd_channel_tcp_test_send_receive(CuTest *test)
+{
+    struct cmd_channel_tcp_testing testing;
+    uint8_t frame[CMD_CHANNEL_TCP_FRAME_HEADER_LEN + MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+    struct cmd_packet packet;
+    ssize_t bytes;
+    size_t i;
+    int status;
+
+    TEST_START;
+
+    cmd_channel_tcp_testing_init(test, &testing);
+
+    memset(&packet, 0, sizeof (packet));
+    for (i = 0; i < 48; i++) {
+        packet.data[i] = 0x60 + i;
+    }
+    packet.pkt_size = 48;
+
+    status = testing.channel.send_packet(&testing.channel, &packet);
+    CuAssertIntEquals(test, 0, status);
+
+    /* The frame sent by the channel is understood when it is received. */
+    bytes = read(testing.tx_peer, frame, CMD_CHANNEL_TCP_FRAME_HEADER_LEN + 48);
+    CuAssertIntEquals(test, CMD_CHANNEL_TCP_FRAME_HEADER_LEN + 48, bytes);
+    CuAssertIntEquals(test, bytes, write(testing.rx_peer, frame, bytes));
+
+    cmd_channel_tcp_testing_check_receive(test, &testing, 48, 0x60);
+
+    cmd_channel_tcp_testing_release(&testing);
+}
+
+
+TEST_SUITE_START (cmd_channel_tcp);
+
+TEST (cmd_channel_tcp_test_receive_packet);
+TEST (cmd_channel_tcp_test_receive_packet_max_length);
+TEST (cmd_channel_tcp_test_receive_packet_multiple_frames);
+TEST (cmd_channel_tcp_test_receive_packet_split_frame);
+TEST (cmd_channel_tcp_test_receive_packet_timeout);
+TEST (cmd_channel_tcp_test_receive_packet_invalid_frame);
+TEST (cmd_channel_tcp_test_receive_packet_zero_length_frame);
+TEST (cmd_channel_tcp_test_receive_packet_after_peer_closed);
+TEST (cmd_channel_tcp_test_receive_packet_not_initialized);
+TEST (cmd_channel_tcp_test_add_connection_max_connections);
+TEST (cmd_channel_tcp_test_send_packet);
+TEST (cmd_channel_tcp_test_send_packet_invalid_size);
+TEST (cmd_channel_tcp_test_send_packets);
+TEST (cmd_channel_tcp_test_send_packets_multiple_batches);
+TEST (cmd_channel_tcp_test_send_packets_invalid_size);
+TEST (cmd_channel_tcp_test_send_receive);
+
+TEST_SUITE_END;
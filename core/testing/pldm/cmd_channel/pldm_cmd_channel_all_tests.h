@@ -0,0 +1,35 @@
+#ifndef PLDM_CMD_CHANNEL_ALL_TESTS_H_
+#define PLDM_CMD_CHANNEL_ALL_TESTS_H_
+
+#include "testing.h"
+#include "platform_all_tests.h"
+#include "common/unused.h"
+
+/**
+ * Add all tests for the pldm command channels.
+ *
+ * Be sure to keep the test suites in alphabetical order for easier management.
+ *
+ * @param suite Suite to add the tests to.
+ */
+static void add_all_pldm_cmd_channel_tests (CuSuite *suite)
+{
+    /* This is unused when no tests will be executed. */
+    UNUSED (suite);
+
+#if (defined TESTING_RUN_CMD_CHANNEL_SHM_SUITE || \
+	    defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_CMD_CHANNEL_SHM_SUITE
+	TESTING_RUN_SUITE (cmd_channel_shm);
+#endif
+#if (defined TESTING_RUN_CMD_CHANNEL_TCP_SUITE || \
+	    defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_CMD_CHANNEL_TCP_SUITE
+	TESTING_RUN_SUITE (cmd_channel_tcp);
+#endif
+}
+
+
+#endif /* PLDM_CMD_CHANNEL_ALL_TESTS_H_ */
@@ -0,0 +1,795 @@
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "flash/flash_virtual_ram.h"
+#include "pldm/pldm_fwup_delta.h"
+#include "pldm/pldm_fwup_manager.h"
+#include "pldm/pldm_fwup_protocol_commands.h"
+#include "testing/engines/hash_testing_engine.h"
+
+
+TEST_SUITE_LABEL ("pldm_fwup_delta");
+
+
+#define PLDM_FWUP_DELTA_TESTING_FLASH_SIZE                  0x1000
+#define PLDM_FWUP_DELTA_TESTING_PKG_ADDR                    0x000
+#define PLDM_FWUP_DELTA_TESTING_NEW_ADDR                    0x400
+#define PLDM_FWUP_DELTA_TESTING_ACTIVE_ADDR                 0x800
+#define PLDM_FWUP_DELTA_TESTING_STAGING_ADDR                0xc00
+#define PLDM_FWUP_DELTA_TESTING_REGION_SIZE                 0x400
+
+#define PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE                  64
+#define PLDM_FWUP_DELTA_TESTING_IMG_SIZE                    300
+#define PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS                  5
+
+/**
+ * Dependencies for testing delta updates.
+ *
+ * A single flash holds the package data, the new component image provided by the UA, the active image of the FD, and
+ * the staging region the FD downloads to.  The new image differs from the active image in blocks 1 and 3.
+ */
+struct pldm_fwup_delta_testing {
+    uint8_t buffer[PLDM_FWUP_DELTA_TESTING_FLASH_SIZE];
+    struct flash_virtual_ram flash;
+    struct flash_virtual_ram_state flash_state;
+    HASH_TESTING_ENGINE hash;
+    struct flash_region new_region;
+    struct flash_region active_region;
+    struct flash_region staging_region;
+    struct pldm_fwup_flash_manager ua_flash_mgr;
+    struct pldm_fwup_flash_manager fd_flash_mgr;
+    struct pldm_fwup_fup_component_image_entry ua_comp;
+    struct pldm_fwup_protocol_component_entry fd_comp;
+    struct pldm_fwup_fd_state state;
+    struct pldm_fwup_fd_update_info update_info;
+    struct pldm_fwup_fd_comp_hash comp_hash;
+};
+
+
+/**
+ * Initialize the dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies to initialize.
+ */
+static void pldm_fwup_delta_testing_init(CuTest *test, struct pldm_fwup_delta_testing *testing)
+{
+    int status;
+    int i;
+
+    memset(testing, 0, sizeof (struct pldm_fwup_delta_testing));
+    memset(testing->buffer, 0xff, sizeof (testing->buffer));
+
+    for (i = 0; i < PLDM_FWUP_DELTA_TESTING_IMG_SIZE; i++) {
+        testing->buffer[PLDM_FWUP_DELTA_TESTING_ACTIVE_ADDR + i] = i * 7;
+        testing->buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + i] = i * 7;
+    }
+    testing->buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + (1 * PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE) + 5] ^= 0x55;
+    testing->buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + (3 * PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE)] ^= 0x55;
+
+    status = flash_virtual_ram_init(&testing->flash, &testing->flash_state, testing->buffer,
+        sizeof (testing->buffer));
+    CuAssertIntEquals(test, 0, status);
+
+    status = HASH_TESTING_ENGINE_INIT(&testing->hash);
+    CuAssertIntEquals(test, 0, status);
+
+    testing->new_region.start_addr = PLDM_FWUP_DELTA_TESTING_NEW_ADDR;
+    testing->new_region.length = PLDM_FWUP_DELTA_TESTING_REGION_SIZE;
+    testing->active_region.start_addr = PLDM_FWUP_DELTA_TESTING_ACTIVE_ADDR;
+    testing->active_region.length = PLDM_FWUP_DELTA_TESTING_REGION_SIZE;
+    testing->staging_region.start_addr = PLDM_FWUP_DELTA_TESTING_STAGING_ADDR;
+    testing->staging_region.length = PLDM_FWUP_DELTA_TESTING_REGION_SIZE;
+
+    testing->ua_flash_mgr.flash = &testing->flash.base;
+    testing->ua_flash_mgr.package_data_region.start_addr = PLDM_FWUP_DELTA_TESTING_PKG_ADDR;
+    testing->ua_flash_mgr.package_data_region.length = PLDM_FWUP_DELTA_TESTING_REGION_SIZE;
+    testing->ua_flash_mgr.comp_regions = &testing->new_region;
+
+    testing->fd_flash_mgr.flash = &testing->flash.base;
+    testing->fd_flash_mgr.package_data_region.start_addr = PLDM_FWUP_DELTA_TESTING_PKG_ADDR;
+    testing->fd_flash_mgr.package_data_region.length = PLDM_FWUP_DELTA_TESTING_REGION_SIZE;
+    testing->fd_flash_mgr.comp_regions = &testing->staging_region;
+    testing->fd_flash_mgr.active_comp_regions = &testing->active_region;
+
+    testing->ua_comp.comp_classification = PLDM_COMP_FIRMWARE;
+    testing->ua_comp.comp_identifier = 0x1234;
+    testing->ua_comp.comp_size = PLDM_FWUP_DELTA_TESTING_IMG_SIZE;
+
+    testing->fd_comp.comp_classification = PLDM_COMP_FIRMWARE;
+    testing->fd_comp.comp_identifier = 0x1234;
+
+    testing->update_info.comp_entries = &testing->fd_comp;
+    testing->update_info.current_comp_img_size = PLDM_FWUP_DELTA_TESTING_IMG_SIZE;
+    testing->update_info.max_transfer_size = 256;
+    testing->update_info.next_checkpoint = PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL;
+    reset_transfer_window(&testing->update_info.transfer_window, 1);
+
+    testing->comp_hash.hash = &testing->hash.base;
+    testing->comp_hash.type = HASH_TYPE_SHA256;
+}
+
+/**
+ * Release the testing dependencies.
+ *
+ * @param testing The testing dependencies to release.
+ */
+static void pldm_fwup_delta_testing_release(struct pldm_fwup_delta_testing *testing)
+{
+    cancel_comp_hash(&testing->comp_hash);
+    HASH_TESTING_ENGINE_RELEASE(&testing->hash);
+    flash_virtual_ram_release(&testing->flash);
+}
+
+/**
+ * Generate block digests for the new image and build the map of changed blocks on the FD.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies.
+ */
+static void pldm_fwup_delta_testing_build_map(CuTest *test, struct pldm_fwup_delta_testing *testing)
+{
+    int status;
+
+    status = pldm_fwup_delta_generate(&testing->ua_flash_mgr, &testing->ua_comp, 1,
+        PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE, &testing->hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+
+    testing->update_info.package_data_len = testing->ua_flash_mgr.package_data_size;
+
+    status = pldm_fwup_delta_build_map(&testing->update_info.delta, &testing->fd_flash_mgr,
+        testing->update_info.package_data_len, 0, &testing->fd_comp, PLDM_FWUP_DELTA_TESTING_IMG_SIZE,
+        &testing->hash.base);
+    CuAssertIntEquals(test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void pldm_fwup_delta_test_generate(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    struct pldm_fwup_delta_header *header;
+    struct pldm_fwup_delta_component *entry;
+    uint8_t digest[SHA256_HASH_LENGTH];
+    int status;
+    int i;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, sizeof (struct pldm_fwup_delta_header) + sizeof (struct pldm_fwup_delta_component) +
+        (PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS * SHA256_HASH_LENGTH), testing.ua_flash_mgr.package_data_size);
+
+    header = (struct pldm_fwup_delta_header*) &testing.buffer[PLDM_FWUP_DELTA_TESTING_PKG_ADDR];
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_MARKER, header->marker);
+    CuAssertIntEquals(test, HASH_TYPE_SHA256, header->hash_type);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE, header->block_size);
+    CuAssertIntEquals(test, 1, header->num_components);
+
+    entry = (struct pldm_fwup_delta_component*) &header[1];
+    CuAssertIntEquals(test, PLDM_COMP_FIRMWARE, entry->comp_classification);
+    CuAssertIntEquals(test, 0x1234, entry->comp_identifier);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, entry->comp_img_size);
+    CuAssertIntEquals(test, sizeof (*header) + sizeof (*entry), entry->digest_offset);
+
+    for (i = 0; i < PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS; i++) {
+        size_t length = (i == (PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS - 1)) ?
+            (PLDM_FWUP_DELTA_TESTING_IMG_SIZE % PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE) :
+            PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE;
+
+        status = testing.hash.base.calculate_sha256(&testing.hash.base,
+            &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + (i * PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE)], length,
+            digest, sizeof (digest));
+        CuAssertIntEquals(test, 0, status);
+
+        status = testing_validate_array(digest,
+            &testing.buffer[PLDM_FWUP_DELTA_TESTING_PKG_ADDR + entry->digest_offset + (i * SHA256_HASH_LENGTH)],
+            sizeof (digest));
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_generate_little_endian(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    uint8_t expected[] = {
+        0x50, 0x44, 0x4c, 0x54, HASH_TYPE_SHA256, 0x40, 0x00, 0x00, 0x00, 0x01, 0x00,
+        PLDM_COMP_FIRMWARE & 0xff, PLDM_COMP_FIRMWARE >> 8, 0x34, 0x12, 0x2c, 0x01, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00
+    };
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(expected, &testing.buffer[PLDM_FWUP_DELTA_TESTING_PKG_ADDR], sizeof (expected));
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_generate_null(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_generate(NULL, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, NULL, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 0, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, 0, &testing.hash.base,
+        HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        NULL, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_generate_too_many_blocks(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    testing.ua_comp.comp_size = PLDM_FWUP_PROTOCOL_MAX_DELTA_BLOCKS + 1;
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, 1, &testing.hash.base,
+        HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TOO_MANY_BLOCKS, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_generate_small_package_region(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    testing.ua_flash_mgr.package_data_region.length = 64;
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_SMALL_PACKAGE_REGION, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    struct pldm_fwup_fd_delta_map *map = &testing.update_info.delta;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    CuAssertIntEquals(test, true, map->active);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE, map->block_size);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS, map->num_blocks);
+    CuAssertIntEquals(test, 2, map->changed_blocks);
+
+    CuAssertIntEquals(test, false, pldm_fwup_delta_is_changed(map, 0));
+    CuAssertIntEquals(test, true, pldm_fwup_delta_is_changed(map, 64));
+    CuAssertIntEquals(test, true, pldm_fwup_delta_is_changed(map, 127));
+    CuAssertIntEquals(test, false, pldm_fwup_delta_is_changed(map, 128));
+    CuAssertIntEquals(test, true, pldm_fwup_delta_is_changed(map, 192));
+    CuAssertIntEquals(test, false, pldm_fwup_delta_is_changed(map, 256));
+    CuAssertIntEquals(test, true,
+        pldm_fwup_delta_is_changed(map, PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS * PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE));
+
+    CuAssertIntEquals(test, 64, pldm_fwup_delta_get_run_end(map, 10, PLDM_FWUP_DELTA_TESTING_IMG_SIZE));
+    CuAssertIntEquals(test, 128, pldm_fwup_delta_get_run_end(map, 64, PLDM_FWUP_DELTA_TESTING_IMG_SIZE));
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_IMG_SIZE,
+        pldm_fwup_delta_get_run_end(map, 256, PLDM_FWUP_DELTA_TESTING_IMG_SIZE));
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_adjacent_changes(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    struct pldm_fwup_fd_delta_map *map = &testing.update_info.delta;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + (2 * PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE)] ^= 0x55;
+
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    CuAssertIntEquals(test, true, map->active);
+    CuAssertIntEquals(test, 3, map->changed_blocks);
+    CuAssertIntEquals(test, 256, pldm_fwup_delta_get_run_end(map, 64, PLDM_FWUP_DELTA_TESTING_IMG_SIZE));
+    CuAssertIntEquals(test, 200, pldm_fwup_delta_get_run_end(map, 100, 200));
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_no_digests(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_build_map(&testing.update_info.delta, &testing.fd_flash_mgr,
+        PLDM_FWUP_DELTA_TESTING_REGION_SIZE, 0, &testing.fd_comp, PLDM_FWUP_DELTA_TESTING_IMG_SIZE,
+        &testing.hash.base);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+    CuAssertIntEquals(test, true, pldm_fwup_delta_is_changed(&testing.update_info.delta, 0));
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_IMG_SIZE,
+        pldm_fwup_delta_get_run_end(&testing.update_info.delta, 0, PLDM_FWUP_DELTA_TESTING_IMG_SIZE));
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_unknown_component(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    testing.fd_comp.comp_identifier = 0x4321;
+
+    pldm_fwup_delta_testing_build_map(test, &testing);
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_all_changed(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    memset(&testing.buffer[PLDM_FWUP_DELTA_TESTING_ACTIVE_ADDR], 0, PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+
+    pldm_fwup_delta_testing_build_map(test, &testing);
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_overlapping_regions(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    testing.fd_flash_mgr.comp_regions = &testing.active_region;
+
+    pldm_fwup_delta_testing_build_map(test, &testing);
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_no_active_regions(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    testing.fd_flash_mgr.active_comp_regions = NULL;
+
+    pldm_fwup_delta_testing_build_map(test, &testing);
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_build_map_null(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_build_map(NULL, &testing.fd_flash_mgr, PLDM_FWUP_DELTA_TESTING_REGION_SIZE, 0,
+        &testing.fd_comp, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, &testing.hash.base);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_build_map(&testing.update_info.delta, NULL, PLDM_FWUP_DELTA_TESTING_REGION_SIZE, 0,
+        &testing.fd_comp, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, &testing.hash.base);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_build_map(&testing.update_info.delta, &testing.fd_flash_mgr,
+        PLDM_FWUP_DELTA_TESTING_REGION_SIZE, 0, NULL, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, &testing.hash.base);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_delta_build_map(&testing.update_info.delta, &testing.fd_flash_mgr,
+        PLDM_FWUP_DELTA_TESTING_REGION_SIZE, 0, &testing.fd_comp, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, NULL);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_INVALID_ARGUMENT, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_get_transfer_size(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    testing.update_info.current_comp_img_offset = 64;
+    CuAssertIntEquals(test, 64, get_transfer_size(&testing.update_info));
+
+    testing.update_info.current_comp_img_offset = 200;
+    CuAssertIntEquals(test, 56, get_transfer_size(&testing.update_info));
+
+    testing.update_info.delta.active = false;
+    CuAssertIntEquals(test, 100, get_transfer_size(&testing.update_info));
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_copy_unchanged_firmware_data(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    uint8_t digest[SHA256_HASH_LENGTH];
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    start_comp_hash(&testing.comp_hash);
+    status = reset_write_buffer(&testing.update_info.write_buffer, &testing.flash.base,
+        PLDM_FWUP_DELTA_TESTING_STAGING_ADDR);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 64, testing.update_info.current_comp_img_offset);
+    CuAssertIntEquals(test, 64, testing.update_info.current_comp_img_confirmed);
+    CuAssertIntEquals(test, 64, testing.comp_hash.hashed_len);
+    CuAssertIntEquals(test, PLDM_FD_STATE_DOWNLOAD, testing.state.current_state);
+
+    status = testing_validate_array(&testing.buffer[PLDM_FWUP_DELTA_TESTING_ACTIVE_ADDR],
+        &testing.buffer[PLDM_FWUP_DELTA_TESTING_STAGING_ADDR], 64);
+    CuAssertIntEquals(test, 0, status);
+
+    /* The changed block has to be requested from the UA, so simulate receiving it. */
+    status = append_write_buffer(&testing.update_info.write_buffer, &testing.flash.base,
+        PLDM_FWUP_DELTA_TESTING_STAGING_ADDR + 64, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + 64], 64);
+    CuAssertIntEquals(test, 0, status);
+    update_comp_hash(&testing.comp_hash, 64, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + 64], 64,
+        PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+    testing.update_info.current_comp_img_offset = 128;
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 192, testing.update_info.current_comp_img_offset);
+    CuAssertIntEquals(test, 192, testing.comp_hash.hashed_len);
+
+    status = append_write_buffer(&testing.update_info.write_buffer, &testing.flash.base,
+        PLDM_FWUP_DELTA_TESTING_STAGING_ADDR + 192, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + 192], 64);
+    CuAssertIntEquals(test, 0, status);
+    update_comp_hash(&testing.comp_hash, 192, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + 192], 64,
+        PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+    testing.update_info.current_comp_img_offset = 256;
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, testing.update_info.current_comp_img_offset);
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_IMG_SIZE, testing.update_info.current_comp_img_confirmed);
+
+    /* The staged image and its running hash match the new image. */
+    status = testing_validate_array(&testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR],
+        &testing.buffer[PLDM_FWUP_DELTA_TESTING_STAGING_ADDR], PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = finish_comp_hash(&testing.comp_hash, &testing.fd_flash_mgr, 0, PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing.hash.base.calculate_sha256(&testing.hash.base, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR],
+        PLDM_FWUP_DELTA_TESTING_IMG_SIZE, digest, sizeof (digest));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(digest, testing.comp_hash.digest, sizeof (digest));
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_copy_unchanged_firmware_data_limited_length(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    start_comp_hash(&testing.comp_hash);
+    status = reset_write_buffer(&testing.update_info.write_buffer, &testing.flash.base,
+        PLDM_FWUP_DELTA_TESTING_STAGING_ADDR);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, 40);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 40, testing.update_info.current_comp_img_offset);
+    CuAssertIntEquals(test, 40, testing.comp_hash.hashed_len);
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, 40);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 64, testing.update_info.current_comp_img_offset);
+    CuAssertIntEquals(test, 64, testing.update_info.current_comp_img_confirmed);
+    CuAssertIntEquals(test, 64, testing.comp_hash.hashed_len);
+
+    status = testing_validate_array(&testing.buffer[PLDM_FWUP_DELTA_TESTING_ACTIVE_ADDR],
+        &testing.buffer[PLDM_FWUP_DELTA_TESTING_STAGING_ADDR], 64);
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_copy_unchanged_firmware_data_changed_block(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    testing.update_info.current_comp_img_offset = 64;
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+    CuAssertIntEquals(test, CMD_HANDLER_PLDM_OPERATION_NOT_EXPECTED, status);
+    CuAssertIntEquals(test, 64, testing.update_info.current_comp_img_offset);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_copy_unchanged_firmware_data_outstanding_request(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    testing.update_info.transfer_window.outstanding = 1;
+
+    status = pldm_fwup_copy_unchanged_firmware_data(&testing.state, &testing.update_info, &testing.fd_flash_mgr,
+        &testing.comp_hash, PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+    CuAssertIntEquals(test, CMD_HANDLER_PLDM_OPERATION_NOT_EXPECTED, status);
+    CuAssertIntEquals(test, 0, testing.update_info.current_comp_img_offset);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_start_fd_delta_restarts_hash(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+    testing.update_info.package_data_len = testing.ua_flash_mgr.package_data_size;
+
+    /* Resume after the first block was already written to the staging region. */
+    memcpy(&testing.buffer[PLDM_FWUP_DELTA_TESTING_STAGING_ADDR], &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR],
+        64);
+    testing.update_info.current_comp_img_confirmed = 64;
+    start_comp_hash(&testing.comp_hash);
+
+    status = start_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, true, is_fd_delta_pending(&testing.update_info, &testing.comp_hash));
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+    CuAssertIntEquals(test, false, testing.comp_hash.active);
+
+    while (is_fd_delta_pending(&testing.update_info, &testing.comp_hash)) {
+        status = continue_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash,
+            PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    CuAssertIntEquals(test, true, testing.update_info.delta.active);
+    CuAssertIntEquals(test, 2, testing.update_info.delta.changed_blocks);
+    CuAssertIntEquals(test, true, testing.comp_hash.active);
+    CuAssertIntEquals(test, 64, testing.comp_hash.hashed_len);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_continue_fd_delta_limited_length(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    uint8_t digest[SHA256_HASH_LENGTH];
+    int calls = 0;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+    testing.update_info.package_data_len = testing.ua_flash_mgr.package_data_size;
+
+    memcpy(&testing.buffer[PLDM_FWUP_DELTA_TESTING_STAGING_ADDR], &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR],
+        64);
+    testing.update_info.current_comp_img_confirmed = 64;
+    start_comp_hash(&testing.comp_hash);
+
+    status = start_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+
+    /* Each call compares one block of the active image and then hashes 16 bytes of the staged data. */
+    while (is_fd_delta_pending(&testing.update_info, &testing.comp_hash)) {
+        status = continue_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash, 16);
+        CuAssertIntEquals(test, 0, status);
+        calls++;
+
+        if (calls <= PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS) {
+            CuAssertIntEquals(test, calls, testing.update_info.delta.next_block);
+        }
+        else {
+            CuAssertIntEquals(test, (calls - PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS) * 16, testing.comp_hash.hashed_len);
+        }
+    }
+
+    CuAssertIntEquals(test, PLDM_FWUP_DELTA_TESTING_NUM_BLOCKS + 4, calls);
+    CuAssertIntEquals(test, true, testing.update_info.delta.active);
+    CuAssertIntEquals(test, 2, testing.update_info.delta.changed_blocks);
+    CuAssertIntEquals(test, true, testing.comp_hash.active);
+    CuAssertIntEquals(test, 64, testing.comp_hash.hashed_len);
+
+    /* The restarted hash matches the new image once the rest of the data is added. */
+    update_comp_hash(&testing.comp_hash, 64, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR + 64],
+        PLDM_FWUP_DELTA_TESTING_IMG_SIZE - 64, PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+
+    status = finish_comp_hash(&testing.comp_hash, &testing.fd_flash_mgr, 0, PLDM_FWUP_DELTA_TESTING_IMG_SIZE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing.hash.base.calculate_sha256(&testing.hash.base, &testing.buffer[PLDM_FWUP_DELTA_TESTING_NEW_ADDR],
+        PLDM_FWUP_DELTA_TESTING_IMG_SIZE, digest, sizeof (digest));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(digest, testing.comp_hash.digest, sizeof (digest));
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_continue_fd_delta_no_restart(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+
+    status = pldm_fwup_delta_generate(&testing.ua_flash_mgr, &testing.ua_comp, 1, PLDM_FWUP_DELTA_TESTING_BLOCK_SIZE,
+        &testing.hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+    testing.update_info.package_data_len = testing.ua_flash_mgr.package_data_size;
+
+    status = start_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+
+    status = continue_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash,
+        PLDM_FWUP_PROTOCOL_DELTA_STEP_LENGTH);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, false, is_fd_delta_pending(&testing.update_info, &testing.comp_hash));
+    CuAssertIntEquals(test, true, testing.update_info.delta.active);
+    CuAssertIntEquals(test, false, testing.comp_hash.active);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+static void pldm_fwup_delta_test_start_fd_delta_no_hash(CuTest *test)
+{
+    struct pldm_fwup_delta_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_delta_testing_init(test, &testing);
+    pldm_fwup_delta_testing_build_map(test, &testing);
+
+    testing.comp_hash.hash = NULL;
+
+    status = start_fd_delta(&testing.fd_flash_mgr, &testing.update_info, &testing.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, false, testing.update_info.delta.active);
+
+    pldm_fwup_delta_testing_release(&testing);
+}
+
+
+TEST_SUITE_START (pldm_fwup_delta);
+
+TEST (pldm_fwup_delta_test_generate);
+TEST (pldm_fwup_delta_test_generate_little_endian);
+TEST (pldm_fwup_delta_test_generate_null);
+TEST (pldm_fwup_delta_test_generate_too_many_blocks);
+TEST (pldm_fwup_delta_test_generate_small_package_region);
+TEST (pldm_fwup_delta_test_build_map);
+TEST (pldm_fwup_delta_test_build_map_adjacent_changes);
+TEST (pldm_fwup_delta_test_build_map_no_digests);
+TEST (pldm_fwup_delta_test_build_map_unknown_component);
+TEST (pldm_fwup_delta_test_build_map_all_changed);
+TEST (pldm_fwup_delta_test_build_map_overlapping_regions);
+TEST (pldm_fwup_delta_test_build_map_no_active_regions);
+TEST (pldm_fwup_delta_test_build_map_null);
+TEST (pldm_fwup_delta_test_get_transfer_size);
+TEST (pldm_fwup_delta_test_copy_unchanged_firmware_data);
+TEST (pldm_fwup_delta_test_copy_unchanged_firmware_data_limited_length);
+TEST (pldm_fwup_delta_test_copy_unchanged_firmware_data_changed_block);
+TEST (pldm_fwup_delta_test_copy_unchanged_firmware_data_outstanding_request);
+TEST (pldm_fwup_delta_test_start_fd_delta_restarts_hash);
+TEST (pldm_fwup_delta_test_start_fd_delta_no_hash);
+TEST (pldm_fwup_delta_test_continue_fd_delta_limited_length);
+TEST (pldm_fwup_delta_test_continue_fd_delta_no_restart);
+
+TEST_SUITE_END;
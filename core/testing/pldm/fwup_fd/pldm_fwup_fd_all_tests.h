@@ -18,6 +18,13 @@ static void add_all_pldm_fwup_fd_tests (CuSuite *suite)
     UNUSED (suite);
     
 
+#if (defined TESTING_RUN_PLDM_FWUP_DELTA_SUITE || \
+	    defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_PLDM_FWUP_DELTA_SUITE
+	TESTING_RUN_SUITE (pldm_fwup_delta);
+#endif
+
 #if (defined TESTING_RUN_PLDM_FWUP_PROTOCOL_FD_COMMANDS_SUITE || \
 	    defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -8,6 +8,8 @@
 #include "pldm/pldm_fwup_manager.h"
 #include "testing/pldm/fwup_testing.h"
 #include "pldm/pldm_fwup_handler.h"
+#include "pldm/pldm_fwup_fd_handler.h"
+#include "pldm/pldm_fwup_fd_handler_static.h"
 #include "platform_api.h"
 
 
@@ -85,9 +87,124 @@ static void pldm_fwup_handler_fd_test_start_update_fd_no_inventory_cmds(CuTest *
     close_global_server_socket();
 }
 
+static void pldm_fwup_handler_fd_test_fd_handler_periodic_task(CuTest *test)
+{
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_handler handler;
+    struct pldm_fwup_fd_handler fd_handler;
+    struct pldm_fwup_fd_handler_state fd_state;
+    const struct periodic_task_handler *handlers[1];
+
+    TEST_START;
+
+    int status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    status = pldm_fwup_handler_init(&handler, &testing.channel, &testing.mctp, testing.timeout_ms);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_handler_set_mode(&handler, PLDM_FWUP_HANDLER_FD_MODE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_fd_handler_init(&fd_handler, &fd_state, &handler);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_fd_handler_start(&fd_handler, testing.device_mgr.entries[2].eid, testing.device_mgr.entries[2].smbus_addr);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_fd_handler_start(&fd_handler, testing.device_mgr.entries[2].eid, testing.device_mgr.entries[2].smbus_addr);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS, status);
+
+    /* The update is run one step at a time by the periodic task. */
+    handlers[0] = &fd_handler.base;
+    periodic_task_prepare_handlers(handlers, 1);
+    while ((status = pldm_fwup_fd_handler_get_status(&fd_handler)) == PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS) {
+        CuAssertIntEquals(test, 0, periodic_task_execute_next_handler(handlers, 1));
+    }
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+    pldm_fwup_fd_handler_release(&fd_handler);
+    pldm_fwup_handler_release(&handler);
+    close_global_server_socket();
+}
+
+static void pldm_fwup_handler_fd_test_fd_handler_static_init(CuTest *test)
+{
+    struct pldm_fwup_handler handler;
+    struct pldm_fwup_fd_handler_state fd_state;
+    struct pldm_fwup_fd_handler fd_handler = pldm_fwup_fd_handler_static_init(&fd_state, &handler);
+    int status;
+
+    TEST_START;
+
+    CuAssertPtrNotNull(test, fd_handler.base.get_next_execution);
+    CuAssertPtrNotNull(test, fd_handler.base.execute);
+    CuAssertPtrEquals(test, NULL, fd_handler.base.prepare);
+
+    memset(&fd_state, 0xff, sizeof (fd_state));
+
+    status = pldm_fwup_fd_handler_init_state(&fd_handler);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_FD_HANDLER_STEP_IDLE, fd_state.step);
+    CuAssertPtrEquals(test, NULL, (void*) fd_handler.base.get_next_execution(&fd_handler.base));
+    CuAssertIntEquals(test, 0, pldm_fwup_fd_handler_get_status(&fd_handler));
+
+    pldm_fwup_fd_handler_release(&fd_handler);
+}
+
+static void pldm_fwup_handler_fd_test_start_update_fd_ua_handler(CuTest *test)
+{
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_handler handler;
+
+    TEST_START;
+
+    int status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    status = pldm_fwup_handler_init(&handler, &testing.channel, &testing.mctp, testing.timeout_ms);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_handler_set_mode(&handler, PLDM_FWUP_HANDLER_FD_MODE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = handler.start_update_fd(&handler, testing.device_mgr.entries[2].eid, testing.device_mgr.entries[2].smbus_addr);
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+    pldm_fwup_handler_release(&handler);
+    close_global_server_socket();
+}
+
+
 TEST_SUITE_START (pldm_fwup_handler_fd);
 
 TEST (pldm_fwup_handler_fd_test_start_update_fd);
 TEST (pldm_fwup_handler_fd_test_start_update_fd_no_inventory_cmds);
+TEST (pldm_fwup_handler_fd_test_fd_handler_periodic_task);
+TEST (pldm_fwup_handler_fd_test_fd_handler_static_init);
+TEST (pldm_fwup_handler_fd_test_start_update_fd_ua_handler);
 
 TEST_SUITE_END;
\ No newline at end of file
@@ -6,9 +6,11 @@
 #include "mctp/mctp_interface.h"
 #include "pldm/cmd_interface_pldm.h"
 #include "pldm/pldm_fwup_manager.h"
+#include "pldm/pldm_fwup_protocol_commands.h"
 #include "testing/pldm/fwup_testing.h"
 #include "pldm/pldm_fwup_handler.h"
 #include "platform_api.h"
+#include "testing/engines/hash_testing_engine.h"
 
 
 TEST_SUITE_LABEL ("pldm_fwup_protocol_fd_commands");
@@ -98,7 +100,7 @@ static void pldm_fwup_protocol_fd_commands_test_request_update_success(CuTest *t
     CuAssertIntEquals(test, 0, testing.fwup_mgr.fd_mgr.state.previous_completion_code);
     CuAssertIntEquals(test, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB, testing.fwup_mgr.fd_mgr.update_info.package_data_len);
     CuAssertIntEquals(test, 1024, testing.fwup_mgr.fd_mgr.update_info.max_transfer_size);
-    CuAssertIntEquals(test, 1, testing.fwup_mgr.fd_mgr.update_info.max_outstanding_transfer_req);
+    CuAssertIntEquals(test, PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ, testing.fwup_mgr.fd_mgr.update_info.max_outstanding_transfer_req);
     CuAssertIntEquals(test, PLDM_FWUP_NUM_COMPONENTS, testing.fwup_mgr.fd_mgr.update_info.num_components);
     CuAssertStrEquals(test, PLDM_FWUP_PENDING_COMP_IMG_SET_VER, (const char *)testing.fwup_mgr.fd_mgr.update_info.comp_img_set_ver.version_str);
 
@@ -262,6 +264,9 @@ static void pldm_fwup_protocol_fd_commands_test_update_component_success(CuTest
     CuAssertIntEquals(test, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB, testing.fwup_mgr.fd_mgr.update_info.current_comp_img_size);
     CuAssertIntEquals(test, 1, testing.fwup_mgr.fd_mgr.update_info.current_comp_update_option_flags.bits.bit0);
     CuAssertIntEquals(test, 0, testing.fwup_mgr.fd_mgr.update_info.current_comp_num);
+    CuAssertTrue(test,
+        testing.fwup_mgr.fd_mgr.update_info.time_before_req_fw_data <= PLDM_FWUP_PROTOCOL_TIME_BERFORE_REQ_FW_DATA);
+    CuAssertIntEquals(test, true, is_write_buffer_pre_erase_pending(&testing.fwup_mgr.fd_mgr.update_info.write_buffer));
 
     release_flash_ctx(&flash_ctx);
     release_testing_ctx(&testing_ctx);
@@ -480,6 +485,546 @@ static void pldm_fwup_protocol_fd_commands_test_request_firmware_data_1_mb_succe
     close_global_server_socket();
 }
 
+static void pldm_fwup_protocol_fd_commands_test_request_firmware_data_streaming_hash(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    HASH_TESTING_ENGINE hash;
+    uint8_t expected[SHA256_HASH_LENGTH];
+
+    TEST_START;
+
+    int status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    status = HASH_TESTING_ENGINE_INIT (&hash);
+    CuAssertIntEquals(test, 0, status);
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_50_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    status = pldm_fwup_manager_set_comp_hash(&testing.fwup_mgr, &hash.base, HASH_TYPE_SHA256);
+    CuAssertIntEquals(test, 0, status);
+
+    testing.fwup_mgr.fd_mgr.state.current_state = PLDM_FD_STATE_DOWNLOAD;
+    testing.fwup_mgr.fd_mgr.state.previous_cmd = PLDM_UPDATE_COMPONENT;
+    testing.fwup_mgr.fd_mgr.state.update_mode = 1;
+    testing.fwup_mgr.fd_mgr.update_info.current_comp_num = 0;
+    testing.fwup_mgr.fd_mgr.update_info.max_transfer_size = PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE;
+    testing.fwup_mgr.fd_mgr.update_info.current_comp_img_size = PLDM_FWUP_COMP_PKG_META_DATA_SIZE_50_KB;
+    testing.fwup_mgr.fd_mgr.update_info.current_comp_img_offset = 0;
+    start_comp_hash(&testing.fwup_mgr.fd_mgr.comp_hash);
+    CuAssertIntEquals(test, true, testing.fwup_mgr.fd_mgr.comp_hash.active);
+
+    uint32_t current_comp_img_size =  testing.fwup_mgr.fd_mgr.update_info.current_comp_img_size;
+    uint32_t max_transfer_size = testing.fwup_mgr.fd_mgr.update_info.max_transfer_size;
+    for (testing.fwup_mgr.fd_mgr.update_info.current_comp_img_offset = 0; 
+            testing.fwup_mgr.fd_mgr.update_info.current_comp_img_offset < current_comp_img_size;
+            testing.fwup_mgr.fd_mgr.update_info.current_comp_img_offset += max_transfer_size) {
+        status = send_and_receive_full_mctp_message(&testing, PLDM_REQUEST_FIRMWARE_DATA);
+        CuAssertIntEquals(test, 0, status);
+        CuAssertIntEquals(test, 0, testing.fwup_mgr.fd_mgr.state.previous_completion_code);
+    }
+
+    status = flush_write_buffer(&testing.fwup_mgr.fd_mgr.update_info.write_buffer, testing.fwup_mgr.fd_mgr.flash_mgr->flash);
+    CuAssertIntEquals(test, 0, status);
+
+    /* Every chunk arrived in order, so the digest is completed without reading back from flash. */
+    CuAssertIntEquals(test, true, testing.fwup_mgr.fd_mgr.comp_hash.active);
+    CuAssertIntEquals(test, current_comp_img_size, testing.fwup_mgr.fd_mgr.comp_hash.hashed_len);
+
+    status = finish_comp_hash(&testing.fwup_mgr.fd_mgr.comp_hash, testing.fwup_mgr.fd_mgr.flash_mgr, 0, current_comp_img_size);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, SHA256_HASH_LENGTH, testing.fwup_mgr.fd_mgr.comp_hash.digest_len);
+    CuAssertIntEquals(test, false, testing.fwup_mgr.fd_mgr.comp_hash.active);
+
+    status = flash_hash_contents(testing.fwup_mgr.fd_mgr.flash_mgr->flash, testing.fwup_mgr.fd_mgr.flash_mgr->comp_regions[0].start_addr,
+        current_comp_img_size, &hash.base, HASH_TYPE_SHA256, expected, sizeof (expected));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(expected, testing.fwup_mgr.fd_mgr.comp_hash.digest, sizeof (expected));
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+    HASH_TESTING_ENGINE_RELEASE (&hash);
+    close_global_server_socket();
+}
+
+
+static void pldm_fwup_protocol_fd_commands_test_resume_from_checkpoint(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_fd_update_info *update_info;
+
+    TEST_START;
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_50_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    testing_ctx.fd_flash_mgr.checkpoint_region.start_addr = PLDM_FWUP_FLASH_MANAGER_CHECKPOINT_ADDR;
+    testing_ctx.fd_flash_mgr.checkpoint_region.length = PLDM_FWUP_FLASH_MANAGER_REGION_SIZE;
+
+    update_info = &testing.fwup_mgr.fd_mgr.update_info;
+    update_info->current_comp_num = 1;
+    update_info->current_comp_img_size = PLDM_FWUP_COMP_PKG_META_DATA_SIZE_50_KB;
+    update_info->current_comp_comparison_stamp = 0x12345678;
+    update_info->comp_img_set_ver = PLDM_FWUP_UA_FUP_COMP_IMG_SET_VER;
+    update_info->current_comp_img_confirmed = 16 * 1024;
+
+    int status = save_fd_checkpoint(testing.fwup_mgr.fd_mgr.flash_mgr, update_info, &testing.fwup_mgr.fd_mgr.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+
+    /* The same component of the same image set resumes from the confirmed offset. */
+    update_info->current_comp_img_confirmed = 0;
+    status = resume_fd_checkpoint(testing.fwup_mgr.fd_mgr.flash_mgr, update_info, &testing.fwup_mgr.fd_mgr.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 16 * 1024, update_info->current_comp_img_offset);
+    CuAssertIntEquals(test, 16 * 1024, update_info->current_comp_img_confirmed);
+    CuAssertIntEquals(test, 16 * 1024 + PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL, update_info->next_checkpoint);
+
+    /* A different component image starts from the beginning. */
+    update_info->current_comp_comparison_stamp = 0x12345679;
+    status = resume_fd_checkpoint(testing.fwup_mgr.fd_mgr.flash_mgr, update_info, &testing.fwup_mgr.fd_mgr.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 0, update_info->current_comp_img_offset);
+    CuAssertIntEquals(test, 0, update_info->current_comp_img_confirmed);
+
+    /* A cleared checkpoint starts from the beginning. */
+    update_info->current_comp_comparison_stamp = 0x12345678;
+    status = clear_fd_checkpoint(testing.fwup_mgr.fd_mgr.flash_mgr);
+    CuAssertIntEquals(test, 0, status);
+
+    status = resume_fd_checkpoint(testing.fwup_mgr.fd_mgr.flash_mgr, update_info, &testing.fwup_mgr.fd_mgr.comp_hash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 0, update_info->current_comp_img_offset);
+    CuAssertIntEquals(test, 0, update_info->current_comp_img_confirmed);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+}
+
+static void pldm_fwup_protocol_fd_commands_test_write_buffer_coalesce(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_fd_write_buffer *buffer;
+    const struct flash *flash;
+    uint8_t data[5000];
+    uint8_t check[sizeof (data)];
+    uint32_t addr = PLDM_FWUP_FLASH_MANAGER_COMP_ONE_ADDR;
+    size_t i;
+
+    TEST_START;
+
+    for (i = 0; i < sizeof (data); i++) {
+        data[i] = i * 7;
+    }
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    buffer = &testing.fwup_mgr.fd_mgr.update_info.write_buffer;
+    flash = testing.fwup_mgr.fd_mgr.flash_mgr->flash;
+
+    int status = reset_write_buffer(buffer, flash, addr);
+    CuAssertIntEquals(test, 0, status);
+
+    /* Data is staged until the buffer is full. */
+    for (i = 0; i < 3; i++) {
+        status = append_write_buffer(buffer, flash, addr + (i * 1000), &data[i * 1000], 1000);
+        CuAssertIntEquals(test, 0, status);
+        CuAssertIntEquals(test, addr, buffer->flushed);
+    }
+
+    status = append_write_buffer(buffer, flash, addr + 3000, &data[3000], 2000);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, addr + PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE, buffer->flushed);
+    CuAssertIntEquals(test, sizeof (data) - PLDM_FWUP_PROTOCOL_WRITE_BUFFER_SIZE, buffer->length);
+
+    status = flush_write_buffer(buffer, flash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, addr + sizeof (data), buffer->flushed);
+    CuAssertIntEquals(test, 0, buffer->length);
+
+    status = flash->read(flash, addr, check, sizeof (check));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(data, check, sizeof (data));
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+}
+
+static void pldm_fwup_protocol_fd_commands_test_write_buffer_pre_erase(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_fd_write_buffer *buffer;
+    const struct flash *flash;
+    uint8_t data[256];
+    uint8_t check[sizeof (data)];
+    uint32_t addr = PLDM_FWUP_FLASH_MANAGER_COMP_ONE_ADDR;
+    uint32_t sector_size;
+
+    TEST_START;
+
+    memset(data, 0, sizeof (data));
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    buffer = &testing.fwup_mgr.fd_mgr.update_info.write_buffer;
+    flash = testing.fwup_mgr.fd_mgr.flash_mgr->flash;
+
+    int status = reset_write_buffer(buffer, flash, addr);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, false, is_write_buffer_pre_erase_pending(buffer));
+    sector_size = buffer->sector_size;
+
+    /* Leave data in the second sector to show which sectors have been erased. */
+    status = flash->write(flash, addr + sector_size, data, sizeof (data));
+    CuAssertIntEquals(test, sizeof (data), status);
+
+    start_write_buffer_pre_erase(buffer, addr + (3 * sector_size));
+    CuAssertIntEquals(test, true, is_write_buffer_pre_erase_pending(buffer));
+    CuAssertIntEquals(test, PLDM_FWUP_PROTOCOL_SECTOR_ERASE_TIME_MS, get_write_buffer_pre_erase_time(buffer, addr + 1));
+    CuAssertIntEquals(test, 3 * PLDM_FWUP_PROTOCOL_SECTOR_ERASE_TIME_MS,
+        get_write_buffer_pre_erase_time(buffer, addr + (8 * sector_size)));
+
+    status = continue_write_buffer_pre_erase(buffer, flash, 1);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, addr + sector_size, buffer->erased);
+    CuAssertTrue(test, buffer->erase_time_ms != 0);
+
+    status = flash->read(flash, addr + sector_size, check, sizeof (check));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(data, check, sizeof (data));
+    CuAssertIntEquals(test, 0, status);
+
+    /* Data written ahead of the background erase erases its sector, which is then skipped. */
+    status = append_write_buffer(buffer, flash, addr, data, sizeof (data));
+    CuAssertIntEquals(test, 0, status);
+
+    status = flush_write_buffer(buffer, flash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, addr + sector_size, buffer->erased);
+
+    status = append_write_buffer(buffer, flash, addr + sector_size, data, 16);
+    CuAssertIntEquals(test, 0, status);
+
+    status = flush_write_buffer(buffer, flash);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, addr + (2 * sector_size), buffer->erased);
+
+    status = continue_write_buffer_pre_erase(buffer, flash, 8);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, addr + (3 * sector_size), buffer->erased);
+    CuAssertIntEquals(test, false, is_write_buffer_pre_erase_pending(buffer));
+    CuAssertIntEquals(test, 0, get_write_buffer_pre_erase_time(buffer, addr + (3 * sector_size)));
+
+    /* The erased sector only contains the data written to it. */
+    status = flash->read(flash, addr + sector_size, check, sizeof (check));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(data, check, 16);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 0xff, check[16]);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+}
+
+static void pldm_fwup_protocol_fd_commands_test_transfer_size_tuning(CuTest *test) {
+    struct pldm_fwup_fd_update_info update_info;
+    struct pldm_fwup_fd_transfer_tuning *tuning = &update_info.transfer_tuning;
+    size_t overhead = PLDM_MCTP_BINDING_MSG_OVERHEAD + 1;
+    uint32_t best;
+    int i;
+
+    TEST_START;
+
+    memset(&update_info, 0, sizeof (update_info));
+    update_info.max_transfer_size = 1024;
+
+    /* Without tuning, every request uses the negotiated maximum. */
+    CuAssertIntEquals(test, 1024, get_transfer_size(&update_info));
+
+    reset_transfer_tuning(tuning, 1024, MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT);
+    CuAssertIntEquals(test, 1024, get_transfer_size(&update_info));
+
+    /* A retry halves the length, rounded down to fill whole MCTP packets. */
+    retry_transfer_tuning(tuning);
+    CuAssertIntEquals(test, 0, (get_transfer_size(&update_info) + overhead) % MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT);
+    CuAssertTrue(test, get_transfer_size(&update_info) <= 512);
+
+    for (i = 0; i < 8; i++) {
+        retry_transfer_tuning(tuning);
+    }
+    CuAssertIntEquals(test, PLDM_FWUP_BASELINE_TRANSFER_SIZE, get_transfer_size(&update_info));
+
+    /* Every window takes the same time, so longer requests measure a higher throughput and the length grows back
+     * to the maximum. */
+    for (i = 0; i < (PLDM_FWUP_PROTOCOL_TRANSFER_TUNING_WINDOW * 16); i++) {
+        update_transfer_tuning_window(tuning, get_transfer_size(&update_info), 100);
+    }
+    CuAssertIntEquals(test, 1024, get_transfer_size(&update_info));
+
+    /* A window with lower throughput restores the length that achieved the best throughput. */
+    retry_transfer_tuning(tuning);
+    best = get_transfer_size(&update_info);
+    CuAssertTrue(test, best < 1024);
+
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_TRANSFER_TUNING_WINDOW; i++) {
+        update_transfer_tuning_window(tuning, best, 100);
+    }
+    CuAssertTrue(test, get_transfer_size(&update_info) > best);
+
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_TRANSFER_TUNING_WINDOW; i++) {
+        update_transfer_tuning_window(tuning, get_transfer_size(&update_info), 10000);
+    }
+    CuAssertIntEquals(test, best, get_transfer_size(&update_info));
+}
+
+/**
+ * Generate a RequestFirmwareData request for the transfer window of the FD.
+ *
+ * @param test The test framework.
+ * @param fd_mgr The FD manager to generate the request for.
+ *
+ * @return The instance ID of the request.
+ */
+static uint8_t request_firmware_data_testing_request(CuTest *test, struct pldm_fwup_fd_manager *fd_mgr)
+{
+    uint8_t buffer[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+    struct pldm_msg *rq = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
+
+    int status = pldm_fwup_generate_request_firmware_data_request(&fd_mgr->state, &fd_mgr->update_info, buffer,
+        sizeof (buffer));
+    CuAssertTrue(test, status > 0);
+
+    fd_mgr->update_info.current_comp_img_offset += fd_mgr->update_info.last_request_length;
+    return rq->hdr.instance_id;
+}
+
+/**
+ * Process a RequestFirmwareData response from the UA.
+ *
+ * @param fd_mgr The FD manager to process the response.
+ * @param instance_id The instance ID of the request being responded to.
+ * @param completion_code The completion code of the response.
+ * @param data The firmware data in the response.
+ * @param length The length of the firmware data.
+ *
+ * @return The status of processing the response.
+ */
+static int request_firmware_data_testing_respond(struct pldm_fwup_fd_manager *fd_mgr, uint8_t instance_id,
+    uint8_t completion_code, const uint8_t *data, size_t length)
+{
+    uint8_t buffer[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+    struct pldm_msg *rsp = (struct pldm_msg *)(buffer + PLDM_MCTP_BINDING_MSG_OFFSET);
+    struct cmd_interface_msg response;
+
+    memset(&response, 0, sizeof (response));
+    buffer[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM;
+    encode_request_firmware_data_resp(instance_id, completion_code, rsp, 1 + length);
+    if (length > 0) {
+        memcpy(rsp->payload + 1, data, length);
+    }
+
+    response.data = buffer;
+    response.length = PLDM_MCTP_BINDING_MSG_OVERHEAD + 1 + length;
+    response.max_response = sizeof (buffer);
+
+    return pldm_fwup_process_request_firmware_data_response(&fd_mgr->state, &fd_mgr->update_info, fd_mgr->flash_mgr,
+        &fd_mgr->comp_hash, &response);
+}
+
+/**
+ * Prepare the FD to download a component image with two RequestFirmwareData requests outstanding.
+ *
+ * @param fd_mgr The FD manager to prepare.
+ * @param size The size of the component image.
+ *
+ * @return 0 on success or an error code.
+ */
+static int request_firmware_data_testing_start(struct pldm_fwup_fd_manager *fd_mgr, uint32_t size)
+{
+    struct pldm_fwup_fd_update_info *update_info = &fd_mgr->update_info;
+
+    fd_mgr->state.current_state = PLDM_FD_STATE_DOWNLOAD;
+    fd_mgr->state.update_mode = 1;
+    update_info->current_comp_num = 0;
+    update_info->max_transfer_size = PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE;
+    update_info->current_comp_img_size = size;
+    update_info->current_comp_img_offset = 0;
+    reset_transfer_window(&update_info->transfer_window, 2);
+
+    return reset_write_buffer(&update_info->write_buffer, fd_mgr->flash_mgr->flash,
+        fd_mgr->flash_mgr->comp_regions[0].start_addr);
+}
+
+static void pldm_fwup_protocol_fd_commands_test_request_firmware_data_short_and_failed_responses(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_fd_manager *fd_mgr;
+    struct pldm_fwup_fd_transfer_window *window;
+    uint8_t data[PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE * 2];
+    uint8_t check[sizeof (data)];
+    uint32_t chunk = PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE;
+    uint32_t partial = chunk / 4;
+    uint8_t first;
+    uint8_t second;
+    size_t i;
+
+    TEST_START;
+
+    for (i = 0; i < sizeof (data); i++) {
+        data[i] = i * 3;
+    }
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    fd_mgr = &testing.fwup_mgr.fd_mgr;
+    window = &fd_mgr->update_info.transfer_window;
+
+    int status = request_firmware_data_testing_start(fd_mgr, sizeof (data));
+    CuAssertIntEquals(test, 0, status);
+
+    first = request_firmware_data_testing_request(test, fd_mgr);
+    second = request_firmware_data_testing_request(test, fd_mgr);
+    CuAssertIntEquals(test, 2, window->outstanding);
+    CuAssertIntEquals(test, sizeof (data), fd_mgr->update_info.current_comp_img_offset);
+
+    /* A short response is written and the rest of the range is requested again. */
+    status = request_firmware_data_testing_respond(fd_mgr, first, PLDM_SUCCESS, data, partial);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, PLDM_SUCCESS, fd_mgr->state.previous_completion_code);
+    CuAssertIntEquals(test, 1, window->outstanding);
+    CuAssertIntEquals(test, 1, window->retries);
+
+    /* A failed response is requested again instead of leaving a hole in the image. */
+    status = request_firmware_data_testing_respond(fd_mgr, second, PLDM_FWUP_BUSY_IN_BACKGROUND, NULL, 0);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, PLDM_SUCCESS, fd_mgr->state.previous_completion_code);
+    CuAssertIntEquals(test, 0, window->outstanding);
+    CuAssertIntEquals(test, 2, window->retries);
+
+    first = request_firmware_data_testing_request(test, fd_mgr);
+    second = request_firmware_data_testing_request(test, fd_mgr);
+    CuAssertIntEquals(test, 2, window->outstanding);
+    CuAssertIntEquals(test, 0, window->retries);
+    CuAssertIntEquals(test, sizeof (data), fd_mgr->update_info.current_comp_img_offset);
+
+    /* Out of order responses are buffered until the rest of the first range arrives. */
+    status = request_firmware_data_testing_respond(fd_mgr, second, PLDM_SUCCESS, &data[chunk], chunk);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 2, window->outstanding);
+
+    status = request_firmware_data_testing_respond(fd_mgr, first, PLDM_SUCCESS, &data[partial], chunk - partial);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, 0, window->outstanding);
+    CuAssertIntEquals(test, 0, window->retries);
+    CuAssertIntEquals(test, true, pldm_fwup_handler_is_download_complete_fd(fd_mgr));
+
+    status = flush_write_buffer(&fd_mgr->update_info.write_buffer, fd_mgr->flash_mgr->flash);
+    CuAssertIntEquals(test, 0, status);
+
+    status = fd_mgr->flash_mgr->flash->read(fd_mgr->flash_mgr->flash, fd_mgr->flash_mgr->comp_regions[0].start_addr,
+        check, sizeof (check));
+    CuAssertIntEquals(test, 0, status);
+
+    status = testing_validate_array(data, check, sizeof (data));
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+}
+
+static void pldm_fwup_protocol_fd_commands_test_request_firmware_data_retries_exhausted(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_fd_manager *fd_mgr;
+    struct pldm_fwup_fd_transfer_window *window;
+    uint8_t instance_id;
+    int i;
+
+    TEST_START;
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_fd_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    fd_mgr = &testing.fwup_mgr.fd_mgr;
+    window = &fd_mgr->update_info.transfer_window;
+
+    int status = request_firmware_data_testing_start(fd_mgr, PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = 0; i < PLDM_FWUP_PROTOCOL_MAX_TRANSFER_RETRIES; i++) {
+        instance_id = request_firmware_data_testing_request(test, fd_mgr);
+
+        status = request_firmware_data_testing_respond(fd_mgr, instance_id, PLDM_FWUP_BUSY_IN_BACKGROUND, NULL, 0);
+        CuAssertIntEquals(test, 0, status);
+        CuAssertIntEquals(test, PLDM_SUCCESS, fd_mgr->state.previous_completion_code);
+        CuAssertIntEquals(test, 1, window->retries);
+    }
+
+    /* Once the retries are used up, the failure is reported to end the update. */
+    instance_id = request_firmware_data_testing_request(test, fd_mgr);
+
+    status = request_firmware_data_testing_respond(fd_mgr, instance_id, PLDM_FWUP_BUSY_IN_BACKGROUND, NULL, 0);
+    CuAssertIntEquals(test, 0, status);
+    CuAssertIntEquals(test, PLDM_FWUP_BUSY_IN_BACKGROUND, fd_mgr->state.previous_completion_code);
+    CuAssertIntEquals(test, 0, window->outstanding);
+    CuAssertIntEquals(test, 0, window->retries);
+
+    /* A short response after the retries are used up is reported as an error. */
+    status = request_firmware_data_testing_start(fd_mgr, PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = 0; i <= PLDM_FWUP_PROTOCOL_MAX_TRANSFER_RETRIES; i++) {
+        instance_id = request_firmware_data_testing_request(test, fd_mgr);
+
+        status = request_firmware_data_testing_respond(fd_mgr, instance_id, PLDM_SUCCESS, NULL, 0);
+        if (i < PLDM_FWUP_PROTOCOL_MAX_TRANSFER_RETRIES) {
+            CuAssertIntEquals(test, 0, status);
+        }
+    }
+    CuAssertIntEquals(test, CMD_HANDLER_PLDM_PROTOCOL_ERROR, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+}
 
 static void pldm_fwup_protocol_fd_commands_test_transfer_complete_success(CuTest *test) {
     struct pldm_fwup_protocol_testing_ctx testing_ctx;
@@ -801,6 +1346,7 @@ static void pldm_fwup_protocol_fd_commands_test_get_status_success(CuTest *test)
     testing.fwup_mgr.fd_mgr.state.previous_state = PLDM_FD_STATE_IDLE;
     testing.fwup_mgr.fd_mgr.state.update_mode = 1;
     testing.fwup_mgr.fd_mgr.state.previous_completion_code = PLDM_SUCCESS;
+    testing.fwup_mgr.fd_mgr.state.previous_cmd = PLDM_REQUEST_UPDATE;
     testing.fwup_mgr.fd_mgr.update_info.current_comp_update_option_flags.value = 0;
     testing.fwup_mgr.fd_mgr.update_info.current_comp_update_option_flags.bits.bit0 = 1;
 
@@ -808,7 +1354,8 @@ static void pldm_fwup_protocol_fd_commands_test_get_status_success(CuTest *test)
     status = receive_and_respond_full_mctp_message(&testing.channel, &testing.mctp, testing.timeout_ms);
     CuAssertIntEquals(test, 0, status);
     CuAssertIntEquals(test, PLDM_FD_STATE_LEARN_COMPONENTS, testing.fwup_mgr.fd_mgr.state.current_state);
-    CuAssertIntEquals(test, PLDM_GET_STATUS, testing.fwup_mgr.fd_mgr.state.previous_cmd);
+    CuAssertIntEquals(test, PLDM_FD_STATE_IDLE, testing.fwup_mgr.fd_mgr.state.previous_state);
+    CuAssertIntEquals(test, PLDM_REQUEST_UPDATE, testing.fwup_mgr.fd_mgr.state.previous_cmd);
     
 
     release_flash_ctx(&flash_ctx);
@@ -1344,6 +1891,13 @@ TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_50_kb_success);
 TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_100_kb_success);
 TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_500_kb_success);
 TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_1_mb_success);
+TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_streaming_hash);
+TEST (pldm_fwup_protocol_fd_commands_test_resume_from_checkpoint);
+TEST (pldm_fwup_protocol_fd_commands_test_write_buffer_coalesce);
+TEST (pldm_fwup_protocol_fd_commands_test_write_buffer_pre_erase);
+TEST (pldm_fwup_protocol_fd_commands_test_transfer_size_tuning);
+TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_short_and_failed_responses);
+TEST (pldm_fwup_protocol_fd_commands_test_request_firmware_data_retries_exhausted);
 TEST (pldm_fwup_protocol_fd_commands_test_get_package_data_50_kb_success);
 TEST (pldm_fwup_protocol_fd_commands_test_get_package_data_100_kb_success);
 TEST (pldm_fwup_protocol_fd_commands_test_get_package_data_500_kb_success);
@@ -195,42 +195,60 @@ void release_testing_ctx(struct pldm_fwup_protocol_testing_ctx *testing_ctx)
 
 void setup_ua_device_manager(struct device_manager *device_mgr, CuTest *test)
 {
+    struct device_manager_full_capabilities capabilities;
     int status = device_manager_init(device_mgr, 1, 2, DEVICE_MANAGER_AC_ROT_MODE, DEVICE_MANAGER_MASTER_BUS_ROLE,
         0, 0, 0, 0, 0, 0, 0);
     CuAssertIntEquals(test, 0, status);
 
-    device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].eid = PLDM_FWUP_UA_EID;
+    status = device_manager_update_device_eid(device_mgr, DEVICE_MANAGER_SELF_DEVICE_NUM, PLDM_FWUP_UA_EID);
+    CuAssertIntEquals(test, 0, status);
+
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].smbus_addr = PLDM_FWUP_UA_SMBUS_ADDR;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_device_id = 5678;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_vid = 1234;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_subsystem_id = 5432;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_subsystem_vid = 9876;
 
-    device_mgr->entries[2].eid = PLDM_FWUP_FD_EID;
+    status = device_manager_update_device_eid(device_mgr, 2, PLDM_FWUP_FD_EID);
+    CuAssertIntEquals(test, 0, status);
+
     device_mgr->entries[2].smbus_addr = PLDM_FWUP_FD_SMBUS_ADDR;
 
-    device_mgr->entries[2].capabilities.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-    device_mgr->entries[2].capabilities.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+    device_manager_get_device_capabilities(device_mgr, 2, &capabilities);
+    capabilities.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+    capabilities.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+
+    status = device_manager_update_device_capabilities(device_mgr, 2, &capabilities);
+    CuAssertIntEquals(test, 0, status);
 }
 
 void setup_fd_device_manager(struct device_manager *device_mgr, CuTest *test)
 {
+    struct device_manager_full_capabilities capabilities;
     int status = device_manager_init(device_mgr, 1, 2, DEVICE_MANAGER_AC_ROT_MODE, DEVICE_MANAGER_MASTER_BUS_ROLE,
         0, 0, 0, 0, 0, 0, 0);
     CuAssertIntEquals(test, 0, status);
 
-    device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].eid = PLDM_FWUP_FD_EID;
+    status = device_manager_update_device_eid(device_mgr, DEVICE_MANAGER_SELF_DEVICE_NUM, PLDM_FWUP_FD_EID);
+    CuAssertIntEquals(test, 0, status);
+
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].smbus_addr = PLDM_FWUP_FD_SMBUS_ADDR;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_device_id = 8765;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_vid = 4321;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_subsystem_id = 2109;
     device_mgr->entries[DEVICE_MANAGER_SELF_DEVICE_NUM].pci_subsystem_vid = 6789;
 
-    device_mgr->entries[2].eid = PLDM_FWUP_UA_EID;
+    status = device_manager_update_device_eid(device_mgr, 2, PLDM_FWUP_UA_EID);
+    CuAssertIntEquals(test, 0, status);
+
     device_mgr->entries[2].smbus_addr = PLDM_FWUP_UA_SMBUS_ADDR;
 
-    device_mgr->entries[2].capabilities.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-    device_mgr->entries[2].capabilities.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+    device_manager_get_device_capabilities(device_mgr, 2, &capabilities);
+    capabilities.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+    capabilities.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+
+    status = device_manager_update_device_capabilities(device_mgr, 2, &capabilities);
+    CuAssertIntEquals(test, 0, status);
 }
 
 void release_device_manager(struct device_manager *device_mgr)
@@ -252,6 +270,7 @@ void setup_testing(struct pldm_fwup_protocol_commands_testing *testing, struct p
     CuAssertIntEquals(test, 0, status);
 
     testing->channel.send_packet = send_packet;
+    testing->channel.send_packets = send_packets;
     testing->channel.receive_packet = receive_packet;
 
     testing_ctx->cmd_cerberus.generate_error_packet = generate_error_packet;
@@ -24,6 +24,7 @@
 #define PLDM_FWUP_FLASH_MANAGER_COMP_ONE_ADDR           2097152
 #define PLDM_FWUP_FLASH_MANAGER_COMP_TWO_ADDR           3145728
 #define PLDM_FWUP_FLASH_MANAGER_REGION_SIZE             1048576
+#define PLDM_FWUP_FLASH_MANAGER_CHECKPOINT_ADDR         4194304
 
 #define PLDM_FWUP_NUM_COMPONENTS                        2
 
@@ -8,6 +8,8 @@
 #include "pldm/pldm_fwup_manager.h"
 #include "testing/pldm/fwup_testing.h"
 #include "pldm/pldm_fwup_handler.h"
+#include "pldm/pldm_fwup_ua_handler.h"
+#include "pldm/pldm_fwup_ua_handler_static.h"
 #include "platform_api.h"
 
 
@@ -92,10 +94,177 @@ static void pldm_fwup_handler_ua_test_run_update_ua_no_inventory_cmds(CuTest *te
     close_global_server_socket();
 }
 
+static void pldm_fwup_handler_ua_test_run_update_ua_fd_handler(CuTest *test)
+{
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_handler handler;
+
+    TEST_START;
+
+    int status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_ua_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    status = pldm_fwup_handler_init(&handler, &testing.channel, &testing.mctp, testing.timeout_ms);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_handler_set_mode(&handler, PLDM_FWUP_HANDLER_UA_MODE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = handler.run_update_ua(&handler, true, testing.device_mgr.entries[2].eid, testing.device_mgr.entries[2].smbus_addr);
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+    pldm_fwup_handler_release(&handler);
+    close_global_server_socket();
+}
+
+static void pldm_fwup_handler_ua_test_ua_handler_periodic_task(CuTest *test)
+{
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+    struct pldm_fwup_handler handler;
+    struct pldm_fwup_ua_handler ua_handler;
+    struct pldm_fwup_ua_handler_state ua_state;
+    const struct periodic_task_handler *handlers[1];
+
+    TEST_START;
+
+    int status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_5_KB);
+    setup_ua_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    status = pldm_fwup_handler_init(&handler, &testing.channel, &testing.mctp, testing.timeout_ms);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_handler_set_mode(&handler, PLDM_FWUP_HANDLER_UA_MODE);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_handler_init(&ua_handler, &ua_state, &handler);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_handler_start(&ua_handler, true, testing.device_mgr.entries[2].eid,
+        testing.device_mgr.entries[2].smbus_addr);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_handler_start(&ua_handler, true, testing.device_mgr.entries[2].eid,
+        testing.device_mgr.entries[2].smbus_addr);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS, status);
+
+    /* The update is run one step at a time by the periodic task. */
+    handlers[0] = &ua_handler.base;
+    periodic_task_prepare_handlers(handlers, 1);
+    while ((status = pldm_fwup_ua_handler_get_status(&ua_handler)) == PLDM_FWUP_HANDLER_UPDATE_IN_PROGRESS) {
+        CuAssertIntEquals(test, 0, periodic_task_execute_next_handler(handlers, 1));
+    }
+    CuAssertIntEquals(test, 0, status);
+
+    status = mctp_interface_get_outstanding_requests(&testing.mctp, testing.device_mgr.entries[2].eid, NULL);
+    CuAssertIntEquals(test, 0, status);
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+    pldm_fwup_ua_handler_release(&ua_handler);
+    pldm_fwup_handler_release(&handler);
+    close_global_server_socket();
+}
+
+static void pldm_fwup_handler_ua_test_ua_handler_static_init(CuTest *test)
+{
+    struct pldm_fwup_handler handler;
+    struct pldm_fwup_ua_handler_state ua_state;
+    struct pldm_fwup_ua_handler ua_handler = pldm_fwup_ua_handler_static_init(&ua_state, &handler);
+    int status;
+
+    TEST_START;
+
+    CuAssertPtrNotNull(test, ua_handler.base.get_next_execution);
+    CuAssertPtrNotNull(test, ua_handler.base.execute);
+    CuAssertPtrEquals(test, NULL, ua_handler.base.prepare);
+
+    memset(&ua_state, 0xff, sizeof (ua_state));
+
+    status = pldm_fwup_ua_handler_init_state(&ua_handler);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_UA_HANDLER_STEP_IDLE, ua_state.step);
+    CuAssertPtrEquals(test, NULL, (void*) ua_handler.base.get_next_execution(&ua_handler.base));
+    CuAssertIntEquals(test, 0, pldm_fwup_ua_handler_get_status(&ua_handler));
+
+    pldm_fwup_ua_handler_release(&ua_handler);
+}
+
+static void pldm_fwup_handler_ua_test_ua_handler_init_null(CuTest *test)
+{
+    struct pldm_fwup_handler handler;
+    struct pldm_fwup_ua_handler ua_handler;
+    struct pldm_fwup_ua_handler_state ua_state;
+    int status;
+
+    TEST_START;
+
+    status = pldm_fwup_ua_handler_init(NULL, &ua_state, &handler);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_handler_init(&ua_handler, NULL, &handler);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_handler_init(&ua_handler, &ua_state, NULL);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_handler_start(NULL, true, 0, 0);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_handler_get_status(NULL);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_INVALID_ARGUMENT, status);
+}
+
+static void pldm_fwup_handler_ua_test_ua_handler_start_fd_mode(CuTest *test)
+{
+    struct pldm_fwup_handler handler;
+    struct pldm_fwup_ua_handler ua_handler;
+    struct pldm_fwup_ua_handler_state ua_state;
+    int status;
+
+    TEST_START;
+
+    memset(&handler, 0, sizeof (handler));
+    handler.mode = PLDM_FWUP_HANDLER_FD_MODE;
+
+    status = pldm_fwup_ua_handler_init(&ua_handler, &ua_state, &handler);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_handler_start(&ua_handler, true, 0, 0);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_INCORRECT_MODE, status);
+    CuAssertIntEquals(test, 0, pldm_fwup_ua_handler_get_status(&ua_handler));
+
+    pldm_fwup_ua_handler_release(&ua_handler);
+}
 
 TEST_SUITE_START (pldm_fwup_handler_ua);
 
 TEST (pldm_fwup_handler_ua_test_run_update_ua);
 TEST (pldm_fwup_handler_ua_test_run_update_ua_no_inventory_cmds);
+TEST (pldm_fwup_handler_ua_test_run_update_ua_fd_handler);
+TEST (pldm_fwup_handler_ua_test_ua_handler_periodic_task);
+TEST (pldm_fwup_handler_ua_test_ua_handler_static_init);
+TEST (pldm_fwup_handler_ua_test_ua_handler_init_null);
+TEST (pldm_fwup_handler_ua_test_ua_handler_start_fd_mode);
 
 TEST_SUITE_END;
\ No newline at end of file
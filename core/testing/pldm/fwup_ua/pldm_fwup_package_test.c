@@ -0,0 +1,480 @@
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "flash/flash_virtual_ram.h"
+#include "crypto/checksum.h"
+#include "pldm/pldm_fwup_package.h"
+
+
+TEST_SUITE_LABEL ("pldm_fwup_package");
+
+
+#define PLDM_FWUP_PACKAGE_TESTING_FLASH_SIZE                4096
+#define PLDM_FWUP_PACKAGE_TESTING_ADDR                      0x100
+#define PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS            3
+
+#define PLDM_FWUP_PACKAGE_TESTING_VER                       "package_v2.0"
+#define PLDM_FWUP_PACKAGE_TESTING_SET_VER                   "cerberus_v2.0"
+#define PLDM_FWUP_PACKAGE_TESTING_OTHER_SET_VER             "other_v2.0"
+#define PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA              "package data"
+
+static const uint8_t PLDM_FWUP_PACKAGE_TESTING_ID_1_0[] = {
+    0xf0, 0x18, 0x87, 0x8c, 0xcb, 0x7d, 0x49, 0x43, 0x98, 0x00, 0xa0, 0x2f, 0x05, 0x9a, 0xca, 0x02
+};
+
+static const uint8_t PLDM_FWUP_PACKAGE_TESTING_ID_1_1[] = {
+    0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d, 0x47, 0x18, 0xa0, 0x30, 0xfc, 0x8a, 0x56, 0x58, 0x7d, 0x5a
+};
+
+/**
+ * Dependencies for testing the package parser.
+ */
+struct pldm_fwup_package_testing {
+    uint8_t buffer[PLDM_FWUP_PACKAGE_TESTING_FLASH_SIZE];
+    struct flash_virtual_ram flash;
+    struct flash_virtual_ram_state flash_state;
+    struct flash_region comp_regions[PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS];
+    struct pldm_fwup_flash_manager flash_mgr;
+    struct pldm_fwup_fup_component_image_entry comp_entries[PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS];
+    struct pldm_fwup_package package;
+    size_t length;
+    size_t header_size;
+    size_t comp_offset[PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS];
+};
+
+
+static void pldm_fwup_package_testing_put16(uint8_t *data, size_t *pos, uint16_t value)
+{
+    data[(*pos)++] = value & 0xff;
+    data[(*pos)++] = value >> 8;
+}
+
+static void pldm_fwup_package_testing_put32(uint8_t *data, size_t *pos, uint32_t value)
+{
+    pldm_fwup_package_testing_put16(data, pos, value & 0xffff);
+    pldm_fwup_package_testing_put16(data, pos, value >> 16);
+}
+
+static void pldm_fwup_package_testing_put_str(uint8_t *data, size_t *pos, const char *str)
+{
+    memcpy(&data[*pos], str, strlen(str));
+    *pos += strlen(str);
+}
+
+/**
+ * Compute the header checksum of the package.
+ *
+ * @param testing The testing dependencies.
+ */
+static void pldm_fwup_package_testing_update_checksum(struct pldm_fwup_package_testing *testing)
+{
+    uint8_t *pkg = &testing->buffer[PLDM_FWUP_PACKAGE_TESTING_ADDR];
+    size_t pos = testing->header_size - 4;
+
+    pldm_fwup_package_testing_put32(pkg, &pos, checksum_crc32(pkg, testing->header_size - 4));
+}
+
+/**
+ * Write a firmware update package to the virtual flash.
+ *
+ * The package contains two device ID records.  The first record applies to components 0 and 2 and has package data.
+ * The second record applies to component 1 and has no package data.
+ *
+ * @param testing The testing dependencies.
+ * @param rev The header format revision of the package.
+ */
+static void pldm_fwup_package_testing_build(struct pldm_fwup_package_testing *testing, uint8_t rev)
+{
+    uint8_t *pkg = &testing->buffer[PLDM_FWUP_PACKAGE_TESTING_ADDR];
+    size_t location[PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS];
+    size_t record;
+    size_t pos = 0;
+    size_t i;
+    size_t j;
+
+    memcpy(pkg, (rev == PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0) ?
+        PLDM_FWUP_PACKAGE_TESTING_ID_1_0 : PLDM_FWUP_PACKAGE_TESTING_ID_1_1, 16);
+    pos += 16;
+    pkg[pos++] = rev;
+    pos += 2;
+    memset(&pkg[pos], 0x20, 13);
+    pos += 13;
+    pldm_fwup_package_testing_put16(pkg, &pos, 8);
+    pkg[pos++] = 1;
+    pkg[pos++] = strlen(PLDM_FWUP_PACKAGE_TESTING_VER);
+    pldm_fwup_package_testing_put_str(pkg, &pos, PLDM_FWUP_PACKAGE_TESTING_VER);
+
+    pkg[pos++] = 2;
+
+    record = pos;
+    pos += 2;
+    pkg[pos++] = 1;
+    pldm_fwup_package_testing_put32(pkg, &pos, 0x1);
+    pkg[pos++] = 1;
+    pkg[pos++] = strlen(PLDM_FWUP_PACKAGE_TESTING_SET_VER);
+    pldm_fwup_package_testing_put16(pkg, &pos, strlen(PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA));
+    pkg[pos++] = 0x05;
+    pldm_fwup_package_testing_put_str(pkg, &pos, PLDM_FWUP_PACKAGE_TESTING_SET_VER);
+    pldm_fwup_package_testing_put16(pkg, &pos, 0);
+    pldm_fwup_package_testing_put16(pkg, &pos, 2);
+    pldm_fwup_package_testing_put16(pkg, &pos, 0x1414);
+    pldm_fwup_package_testing_put_str(pkg, &pos, PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA);
+    pkg[record] = pos - record;
+
+    record = pos;
+    pos += 2;
+    pkg[pos++] = 1;
+    pldm_fwup_package_testing_put32(pkg, &pos, 0);
+    pkg[pos++] = 1;
+    pkg[pos++] = strlen(PLDM_FWUP_PACKAGE_TESTING_OTHER_SET_VER);
+    pldm_fwup_package_testing_put16(pkg, &pos, 0);
+    pkg[pos++] = 0x02;
+    pldm_fwup_package_testing_put_str(pkg, &pos, PLDM_FWUP_PACKAGE_TESTING_OTHER_SET_VER);
+    pldm_fwup_package_testing_put16(pkg, &pos, 0);
+    pldm_fwup_package_testing_put16(pkg, &pos, 2);
+    pldm_fwup_package_testing_put16(pkg, &pos, 0x1515);
+    pkg[record] = pos - record;
+
+    if (rev == PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1) {
+        pkg[pos++] = 1;
+        pldm_fwup_package_testing_put16(pkg, &pos, 8);
+        memset(&pkg[pos], 0x55, 6);
+        pos += 6;
+    }
+
+    pldm_fwup_package_testing_put16(pkg, &pos, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    for (i = 0; i < PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS; i++) {
+        pldm_fwup_package_testing_put16(pkg, &pos, 0x000a);
+        pldm_fwup_package_testing_put16(pkg, &pos, 0x10 + i);
+        pldm_fwup_package_testing_put32(pkg, &pos, 0x01020300 + i);
+        pldm_fwup_package_testing_put16(pkg, &pos, 0x0001);
+        pldm_fwup_package_testing_put16(pkg, &pos, 0x0004);
+        location[i] = pos;
+        pos += 4;
+        pldm_fwup_package_testing_put32(pkg, &pos, 64 * (i + 1));
+        pkg[pos++] = 1;
+        pkg[pos++] = 4;
+        pldm_fwup_package_testing_put_str(pkg, &pos, "v2.0");
+    }
+
+    testing->header_size = pos + 4;
+    i = 17;
+    pldm_fwup_package_testing_put16(pkg, &i, testing->header_size);
+    pos += 4;
+
+    for (i = 0; i < PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS; i++) {
+        testing->comp_offset[i] = pos;
+        j = location[i];
+        pldm_fwup_package_testing_put32(pkg, &j, pos);
+
+        memset(&pkg[pos], i + 1, 64 * (i + 1));
+        pos += 64 * (i + 1);
+    }
+
+    testing->length = pos;
+    pldm_fwup_package_testing_update_checksum(testing);
+}
+
+static void pldm_fwup_package_testing_init(CuTest *test, struct pldm_fwup_package_testing *testing, uint8_t rev)
+{
+    int status;
+
+    memset(testing, 0, sizeof (struct pldm_fwup_package_testing));
+
+    status = flash_virtual_ram_init(&testing->flash, &testing->flash_state, testing->buffer,
+        sizeof (testing->buffer));
+    CuAssertIntEquals(test, 0, status);
+
+    testing->flash_mgr.flash = &testing->flash.base;
+    testing->flash_mgr.comp_regions = testing->comp_regions;
+
+    pldm_fwup_package_testing_build(testing, rev);
+}
+
+static void pldm_fwup_package_testing_release(struct pldm_fwup_package_testing *testing)
+{
+    flash_virtual_ram_release(&testing->flash);
+}
+
+/**
+ * Testing Functions
+*/
+
+static void pldm_fwup_package_test_parse(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0, testing.package.header_format_rev);
+    CuAssertIntEquals(test, testing.header_size, testing.package.header_size);
+    CuAssertIntEquals(test, 8, testing.package.comp_bitmap_bit_length);
+    CuAssertIntEquals(test, strlen(PLDM_FWUP_PACKAGE_TESTING_VER), testing.package.package_ver.version_str_length);
+    CuAssertStrEquals(test, PLDM_FWUP_PACKAGE_TESTING_VER, (char*) testing.package.package_ver.version_str);
+    CuAssertIntEquals(test, 1, testing.package.comp_img_set_ver.version_str_type);
+    CuAssertIntEquals(test, strlen(PLDM_FWUP_PACKAGE_TESTING_SET_VER),
+        testing.package.comp_img_set_ver.version_str_length);
+    CuAssertStrEquals(test, PLDM_FWUP_PACKAGE_TESTING_SET_VER, (char*) testing.package.comp_img_set_ver.version_str);
+    CuAssertIntEquals(test, 0x1, testing.package.device_update_option_flags.value);
+    CuAssertIntEquals(test, 2, testing.package.num_components);
+
+    CuAssertIntEquals(test, strlen(PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA),
+        testing.flash_mgr.package_data_region.length);
+    CuAssertIntEquals(test, strlen(PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA), testing.flash_mgr.package_data_size);
+    status = memcmp(PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA,
+        &testing.buffer[testing.flash_mgr.package_data_region.start_addr],
+        strlen(PLDM_FWUP_PACKAGE_TESTING_PACKAGE_DATA));
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, 0x000a, testing.comp_entries[0].comp_classification);
+    CuAssertIntEquals(test, 0x10, testing.comp_entries[0].comp_identifier);
+    CuAssertIntEquals(test, 0x01020300, testing.comp_entries[0].comp_comparison_stamp);
+    CuAssertIntEquals(test, 0x0001, testing.comp_entries[0].comp_options.value);
+    CuAssertIntEquals(test, 0x0004, testing.comp_entries[0].requested_comp_activation_method.value);
+    CuAssertIntEquals(test, 64, testing.comp_entries[0].comp_size);
+    CuAssertIntEquals(test, 4, testing.comp_entries[0].comp_ver.version_str_length);
+    CuAssertStrEquals(test, "v2.0", (char*) testing.comp_entries[0].comp_ver.version_str);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TESTING_ADDR + testing.comp_offset[0],
+        testing.comp_regions[0].start_addr);
+    CuAssertIntEquals(test, 64, testing.comp_regions[0].length);
+
+    CuAssertIntEquals(test, 0x12, testing.comp_entries[1].comp_identifier);
+    CuAssertIntEquals(test, 0x01020302, testing.comp_entries[1].comp_comparison_stamp);
+    CuAssertIntEquals(test, 192, testing.comp_entries[1].comp_size);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TESTING_ADDR + testing.comp_offset[2],
+        testing.comp_regions[1].start_addr);
+    CuAssertIntEquals(test, 192, testing.comp_regions[1].length);
+    CuAssertIntEquals(test, 3, testing.buffer[testing.comp_regions[1].start_addr]);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_second_record(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 1, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertStrEquals(test, PLDM_FWUP_PACKAGE_TESTING_OTHER_SET_VER,
+        (char*) testing.package.comp_img_set_ver.version_str);
+    CuAssertIntEquals(test, 0, testing.package.device_update_option_flags.value);
+    CuAssertIntEquals(test, 0, testing.flash_mgr.package_data_size);
+    CuAssertIntEquals(test, 1, testing.package.num_components);
+
+    CuAssertIntEquals(test, 0x11, testing.comp_entries[0].comp_identifier);
+    CuAssertIntEquals(test, 128, testing.comp_entries[0].comp_size);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TESTING_ADDR + testing.comp_offset[1],
+        testing.comp_regions[0].start_addr);
+    CuAssertIntEquals(test, 128, testing.comp_regions[0].length);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_format_rev_1_1(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1, testing.package.header_format_rev);
+    CuAssertIntEquals(test, 2, testing.package.num_components);
+    CuAssertIntEquals(test, 0x10, testing.comp_entries[0].comp_identifier);
+    CuAssertIntEquals(test, 0x12, testing.comp_entries[1].comp_identifier);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TESTING_ADDR + testing.comp_offset[2],
+        testing.comp_regions[1].start_addr);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_null(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(NULL, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_package_parse(&testing.package, NULL, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, NULL, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        0, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_INVALID_ARGUMENT, status);
+
+    testing.flash_mgr.comp_regions = NULL;
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_INVALID_ARGUMENT, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_unsupported_format(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+    testing.buffer[PLDM_FWUP_PACKAGE_TESTING_ADDR + 16] = PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_1;
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_UNSUPPORTED_FORMAT, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_bad_checksum(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+    testing.buffer[PLDM_FWUP_PACKAGE_TESTING_ADDR + 20] ^= 0x01;
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_BAD_CHECKSUM, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_unknown_record(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 2, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_UNKNOWN_RECORD, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_too_many_components(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, 1);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TOO_MANY_COMPONENTS, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_header_truncated(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.header_size - 1, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TRUNCATED, status);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        10, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TRUNCATED, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_component_truncated(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length - 1, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_TRUNCATED, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+static void pldm_fwup_package_test_parse_bad_record_length(CuTest *test)
+{
+    struct pldm_fwup_package_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_package_testing_init(test, &testing, PLDM_FWUP_PACKAGE_HEADER_FORMAT_REV_1_0);
+
+    /* Set the length of the first device ID record to less than its fixed fields. */
+    testing.buffer[PLDM_FWUP_PACKAGE_TESTING_ADDR + 37 + strlen(PLDM_FWUP_PACKAGE_TESTING_VER)] = 10;
+    pldm_fwup_package_testing_update_checksum(&testing);
+
+    status = pldm_fwup_package_parse(&testing.package, &testing.flash_mgr, PLDM_FWUP_PACKAGE_TESTING_ADDR,
+        testing.length, 0, testing.comp_entries, PLDM_FWUP_PACKAGE_TESTING_NUM_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_PACKAGE_MALFORMED, status);
+
+    pldm_fwup_package_testing_release(&testing);
+}
+
+
+TEST_SUITE_START (pldm_fwup_package);
+
+TEST (pldm_fwup_package_test_parse);
+TEST (pldm_fwup_package_test_parse_second_record);
+TEST (pldm_fwup_package_test_parse_format_rev_1_1);
+TEST (pldm_fwup_package_test_parse_null);
+TEST (pldm_fwup_package_test_parse_unsupported_format);
+TEST (pldm_fwup_package_test_parse_bad_checksum);
+TEST (pldm_fwup_package_test_parse_unknown_record);
+TEST (pldm_fwup_package_test_parse_too_many_components);
+TEST (pldm_fwup_package_test_parse_header_truncated);
+TEST (pldm_fwup_package_test_parse_component_truncated);
+TEST (pldm_fwup_package_test_parse_bad_record_length);
+
+TEST_SUITE_END;
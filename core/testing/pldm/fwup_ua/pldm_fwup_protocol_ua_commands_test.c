@@ -428,6 +428,41 @@ static void pldm_fwup_protocol_ua_commands_test_request_firmware_data_1_mb_succe
 }
 
 
+static void pldm_fwup_protocol_ua_commands_test_request_firmware_data_streaming_hash(CuTest *test) {
+    struct pldm_fwup_protocol_testing_ctx testing_ctx;
+    struct pldm_fwup_protocol_flash_ctx flash_ctx;
+    struct pldm_fwup_protocol_commands_testing testing;
+
+    TEST_START;
+
+    int status = initialize_global_server_socket();
+    CuAssertIntEquals(test, 0, status);
+
+    setup_flash_ctx(&flash_ctx, test);
+    setup_testing_ctx(&testing_ctx, &flash_ctx, PLDM_FWUP_COMP_PKG_META_DATA_SIZE_50_KB);
+    setup_ua_device_manager(&testing.device_mgr, test);
+    setup_testing(&testing, &testing_ctx, test);
+
+    testing.fwup_mgr.ua_mgr.state.previous_cmd = PLDM_UPDATE_COMPONENT;
+    testing.fwup_mgr.ua_mgr.current_comp_num = 0;
+
+    int iterations = (PLDM_FWUP_COMP_PKG_META_DATA_SIZE_50_KB + PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE - 1) / PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE;
+    int i = 0;
+    while (i < iterations) {
+        status = receive_and_respond_full_mctp_message(&testing.channel, &testing.mctp, testing.timeout_ms);
+        CuAssertIntEquals(test, 0, status);
+        CuAssertIntEquals(test, PLDM_REQUEST_FIRMWARE_DATA, testing.fwup_mgr.ua_mgr.state.previous_cmd);
+        CuAssertIntEquals(test, 0, testing.fwup_mgr.ua_mgr.state.previous_completion_code);
+        i++;
+    }
+
+    release_flash_ctx(&flash_ctx);
+    release_testing_ctx(&testing_ctx);
+    release_device_manager(&testing.device_mgr);
+    release_testing(&testing);
+    close_global_server_socket();
+}
+
 static void pldm_fwup_protocol_ua_commands_test_transfer_complete_success(CuTest *test) {
     struct pldm_fwup_protocol_testing_ctx testing_ctx;
     struct pldm_fwup_protocol_flash_ctx flash_ctx;
@@ -1202,6 +1237,7 @@ TEST (pldm_fwup_protocol_ua_commands_test_request_firmware_data_50_kb_success);
 TEST (pldm_fwup_protocol_ua_commands_test_request_firmware_data_100_kb_success);
 TEST (pldm_fwup_protocol_ua_commands_test_request_firmware_data_500_kb_success);
 TEST (pldm_fwup_protocol_ua_commands_test_request_firmware_data_1_mb_success);
+TEST (pldm_fwup_protocol_ua_commands_test_request_firmware_data_streaming_hash);
 TEST (pldm_fwup_protocol_ua_commands_test_get_package_data_50_kb_success);
 TEST (pldm_fwup_protocol_ua_commands_test_get_package_data_100_kb_success);
 TEST (pldm_fwup_protocol_ua_commands_test_get_package_data_500_kb_success);
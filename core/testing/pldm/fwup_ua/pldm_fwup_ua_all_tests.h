@@ -32,6 +32,20 @@ static void add_all_pldm_fwup_ua_tests (CuSuite *suite)
 	TESTING_RUN_SUITE (pldm_fwup_handler_ua);
 #endif
 
+#if (defined TESTING_RUN_PLDM_FWUP_PACKAGE_SUITE || \
+	    defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_PLDM_FWUP_PACKAGE_SUITE
+	TESTING_RUN_SUITE (pldm_fwup_package);
+#endif
+
+#if (defined TESTING_RUN_PLDM_FWUP_UA_ORCHESTRATOR_SUITE || \
+	    defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_PLDM_FWUP_UA_ORCHESTRATOR_SUITE
+	TESTING_RUN_SUITE (pldm_fwup_ua_orchestrator);
+#endif
+
 }
 
 #endif /* PLDM_FWUP_UA_ALL_TESTS_H_ */
\ No newline at end of file
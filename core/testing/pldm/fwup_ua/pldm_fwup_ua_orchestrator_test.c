@@ -0,0 +1,722 @@
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "common/unused.h"
+#include "pldm/pldm_fwup_ua_orchestrator.h"
+#include "pldm/cmd_interface_pldm.h"
+#include "pldm/pldm_fwup_handler.h"
+#include "pldm/pldm_fwup_manager.h"
+
+
+TEST_SUITE_LABEL ("pldm_fwup_ua_orchestrator");
+
+
+#define PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS          3
+#define PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS        2
+
+/**
+ * A Firmware Device session used for testing.  The update of the FD is replaced with a function that records the
+ * call and returns a fixed result.
+ */
+struct pldm_fwup_ua_orchestrator_testing_session {
+    struct pldm_fwup_handler handler;                                               /**< Handler for the session.  Must be first. */
+    struct mctp_interface mctp;                                                     /**< MCTP layer referenced by the handler. */
+    struct cmd_interface_pldm pldm;                                                 /**< PLDM command interface for the session. */
+    struct pldm_fwup_manager fwup_mgr;                                              /**< FWUP manager for the session. */
+    int result;                                                                     /**< Result to report from the update. */
+    int calls;                                                                      /**< Number of times the update was run. */
+    bool inventory_cmds;                                                            /**< The inventory flag passed to the update. */
+    uint8_t fd_eid;                                                                 /**< The FD EID passed to the update. */
+    uint8_t fd_addr;                                                                /**< The FD address passed to the update. */
+};
+
+/**
+ * Dependencies for testing the UA orchestrator.
+ */
+struct pldm_fwup_ua_orchestrator_testing {
+    struct pldm_fwup_flash_manager ua_flash_mgr;
+    struct pldm_fwup_fup_component_image_entry comp_list[PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS];
+    struct pldm_fwup_protocol_version_string comp_img_set_ver;
+    struct flash_region meta_data_region[PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS];
+    struct pldm_fwup_ua_orchestrator_testing_session session[PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS];
+    struct pldm_fwup_ua_orchestrator test;
+};
+
+
+/**
+ * Update handler for a testing session.
+ *
+ * @param handler The handler for the session.
+ * @param inventory_cmds Flag indicating if inventory commands should be issued.
+ * @param fd_eid The EID of the FD.
+ * @param fd_addr The address of the FD.
+ *
+ * @return The configured result for the session.
+ */
+static int pldm_fwup_ua_orchestrator_testing_run_update_ua(struct pldm_fwup_handler *handler, bool inventory_cmds,
+    uint8_t fd_eid, uint8_t fd_addr)
+{
+    struct pldm_fwup_ua_orchestrator_testing_session *session =
+        (struct pldm_fwup_ua_orchestrator_testing_session*) handler;
+
+    session->calls++;
+    session->inventory_cmds = inventory_cmds;
+    session->fd_eid = fd_eid;
+    session->fd_addr = fd_addr;
+
+    return session->result;
+}
+
+/**
+ * Initialize the dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies to initialize.
+ */
+static void pldm_fwup_ua_orchestrator_testing_init_dependencies(CuTest *test,
+    struct pldm_fwup_ua_orchestrator_testing *testing)
+{
+    struct pldm_fwup_ua_orchestrator_testing_session *session;
+    int i;
+
+    memset(testing, 0, sizeof (struct pldm_fwup_ua_orchestrator_testing));
+
+    testing->ua_flash_mgr.package_data_region.start_addr = 0x10000;
+    testing->ua_flash_mgr.package_data_region.length = 0x1000;
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS; i++) {
+        testing->comp_list[i].comp_classification = PLDM_COMP_FIRMWARE;
+        testing->comp_list[i].comp_identifier = 0x100 + i;
+        testing->comp_list[i].comp_size = 0x400;
+    }
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS; i++) {
+        session = &testing->session[i];
+
+        session->handler.mctp = &session->mctp;
+        session->handler.mode = PLDM_FWUP_HANDLER_FD_MODE;
+        session->handler.run_update_ua = pldm_fwup_ua_orchestrator_testing_run_update_ua;
+        session->mctp.cmd_pldm = &session->pldm.base;
+        session->pldm.fwup_mgr = &session->fwup_mgr;
+
+        testing->meta_data_region[i].start_addr = 0x20000 + (i * 0x1000);
+        testing->meta_data_region[i].length = 0x1000;
+    }
+
+    UNUSED (test);
+}
+
+/**
+ * Initialize the orchestrator for testing and add every testing session.
+ *
+ * @param test The testing framework.
+ * @param testing The testing dependencies to initialize.
+ */
+static void pldm_fwup_ua_orchestrator_testing_init(CuTest *test, struct pldm_fwup_ua_orchestrator_testing *testing)
+{
+    int status;
+    int i;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing->test, &testing->ua_flash_mgr, testing->comp_list,
+        &testing->comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS; i++) {
+        status = pldm_fwup_ua_orchestrator_add_session(&testing->test, &testing->session[i].handler, 0x20 + i,
+            0x40 + i, &testing->meta_data_region[i]);
+        CuAssertIntEquals(test, i, status);
+    }
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void pldm_fwup_ua_orchestrator_test_init(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertPtrEquals(test, &testing.ua_flash_mgr, (void*) testing.test.ua_flash_mgr);
+    CuAssertPtrEquals(test, testing.comp_list, (void*) testing.test.fup_comp_img_list);
+    CuAssertPtrEquals(test, &testing.comp_img_set_ver, testing.test.fup_comp_img_set_ver);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS, testing.test.num_components);
+    CuAssertIntEquals(test, 0, testing.test.num_sessions);
+    CuAssertIntEquals(test, 0, testing.test.sessions_remaining);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_init_null(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(NULL, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, NULL, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, NULL,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, 0);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+}
+
+static void pldm_fwup_ua_orchestrator_test_release_null(CuTest *test)
+{
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_release(NULL);
+}
+
+static void pldm_fwup_ua_orchestrator_test_add_session(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    struct pldm_fwup_ua_session *session;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[0].handler, 0x20, 0x40,
+        &testing.meta_data_region[0]);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[1].handler, 0x21, 0x41,
+        &testing.meta_data_region[1]);
+    CuAssertIntEquals(test, 1, status);
+
+    CuAssertIntEquals(test, 2, testing.test.num_sessions);
+
+    session = &testing.test.sessions[1];
+    CuAssertPtrEquals(test, &testing.session[1].handler, session->handler);
+    CuAssertPtrEquals(test, &testing.session[1].fwup_mgr.ua_mgr, session->ua_mgr);
+    CuAssertIntEquals(test, 0x21, session->fd_eid);
+    CuAssertIntEquals(test, 0x41, session->fd_addr);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING, session->status);
+
+    CuAssertPtrNotNull(test, session->comp_img_entries);
+    CuAssertTrue(test, (session->comp_img_entries != testing.comp_list));
+    status = testing_validate_array((uint8_t*) testing.comp_list, (uint8_t*) session->comp_img_entries,
+        sizeof (testing.comp_list));
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, testing.ua_flash_mgr.package_data_region.start_addr,
+        session->flash_mgr.package_data_region.start_addr);
+    CuAssertIntEquals(test, testing.meta_data_region[1].start_addr,
+        session->flash_mgr.device_meta_data_region.start_addr);
+    CuAssertIntEquals(test, testing.meta_data_region[1].length, session->flash_mgr.device_meta_data_region.length);
+
+    status = pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 1);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_add_session_null(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(NULL, &testing.session[0].handler, 0x20, 0x40,
+        &testing.meta_data_region[0]);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, NULL, 0x20, 0x40, &testing.meta_data_region[0]);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[0].handler, 0x20, 0x40, NULL);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    testing.session[0].pldm.fwup_mgr = NULL;
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[0].handler, 0x20, 0x40,
+        &testing.meta_data_region[0]);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    CuAssertIntEquals(test, 0, testing.test.num_sessions);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_add_session_shared_manager(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[0].handler, 0x20, 0x40,
+        &testing.meta_data_region[0]);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[0].handler, 0x21, 0x41,
+        &testing.meta_data_region[1]);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SHARED_MANAGER, status);
+
+    testing.session[1].pldm.fwup_mgr = &testing.session[0].fwup_mgr;
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[1].handler, 0x21, 0x41,
+        &testing.meta_data_region[1]);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SHARED_MANAGER, status);
+
+    CuAssertIntEquals(test, 1, testing.test.num_sessions);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_add_session_update_active(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[0].handler, 0x20, 0x40,
+        &testing.meta_data_region[0]);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_add_session(&testing.test, &testing.session[1].handler, 0x21, 0x41,
+        &testing.meta_data_region[1]);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_UPDATE_ACTIVE, status);
+
+    CuAssertIntEquals(test, 1, testing.test.num_sessions);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_start(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    struct pldm_fwup_ua_manager *ua_mgr;
+    int status;
+    int i;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, true);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, true, testing.test.inventory_cmds);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS, testing.test.sessions_remaining);
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS; i++) {
+        ua_mgr = &testing.session[i].fwup_mgr.ua_mgr;
+
+        CuAssertIntEquals(test, PLDM_FWUP_HANDLER_UA_MODE, testing.session[i].handler.mode);
+        CuAssertPtrEquals(test, &testing.test.sessions[i].flash_mgr, ua_mgr->flash_mgr);
+        CuAssertPtrEquals(test, testing.test.sessions[i].comp_img_entries, ua_mgr->comp_img_entries);
+        CuAssertPtrEquals(test, &testing.comp_img_set_ver, ua_mgr->fup_comp_img_set_ver);
+        CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS, ua_mgr->num_components);
+        CuAssertIntEquals(test, 0, ua_mgr->current_comp_num);
+
+        status = pldm_fwup_ua_orchestrator_get_session_status(&testing.test, i);
+        CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING, status);
+    }
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_start_null(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_start(NULL, false);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    /* No sessions have been added. */
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_start_update_active(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 0);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_UPDATE_ACTIVE, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS - 1, testing.test.sessions_remaining);
+    CuAssertIntEquals(test, 0, pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 0));
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_run_session(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+    int i;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, true);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS; i++) {
+        status = pldm_fwup_ua_orchestrator_run_session(&testing.test, i);
+        CuAssertIntEquals(test, 0, status);
+
+        CuAssertIntEquals(test, 1, testing.session[i].calls);
+        CuAssertIntEquals(test, true, testing.session[i].inventory_cmds);
+        CuAssertIntEquals(test, 0x20 + i, testing.session[i].fd_eid);
+        CuAssertIntEquals(test, 0x40 + i, testing.session[i].fd_addr);
+
+        status = pldm_fwup_ua_orchestrator_get_session_status(&testing.test, i);
+        CuAssertIntEquals(test, 0, status);
+    }
+
+    CuAssertIntEquals(test, 0, testing.test.sessions_remaining);
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_run_session_out_of_order(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 2);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 0);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, 1, testing.test.sessions_remaining);
+    CuAssertIntEquals(test, 0, testing.session[1].calls);
+
+    status = pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 1);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 1);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_run_session_failed(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+    int i;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    testing.session[1].result = PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT;
+    testing.session[2].result = PLDM_FWUP_HANDLER_UPDATE_CANCELED;
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS - 1; i >= 0; i--) {
+        status = pldm_fwup_ua_orchestrator_run_session(&testing.test, i);
+        CuAssertIntEquals(test, testing.session[i].result, status);
+    }
+
+    CuAssertIntEquals(test, 0, pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 0));
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT,
+        pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 1));
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_UPDATE_CANCELED,
+        pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 2));
+
+    /* The status of the first failed session is reported. */
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_run_session_repeated(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 0);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 1);
+    CuAssertIntEquals(test, 0, status);
+
+    testing.session[0].result = PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT;
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 0);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_ALREADY_RUN, status);
+
+    CuAssertIntEquals(test, 1, testing.session[0].calls);
+    CuAssertIntEquals(test, 1, testing.test.sessions_remaining);
+    CuAssertIntEquals(test, 0, pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 0));
+
+    /* The last session is still running, so the update is not complete. */
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TIMEOUT, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 2);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_run_session_restart(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+    int i;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    testing.session[1].result = PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT;
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS; i++) {
+        status = pldm_fwup_ua_orchestrator_run_session(&testing.test, i);
+        CuAssertIntEquals(test, testing.session[i].result, status);
+    }
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_HANDLER_RESPONSE_TIMEOUT, status);
+
+    /* Every session can be run again once the orchestrator is restarted. */
+    testing.session[1].result = 0;
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_SESSION_PENDING,
+        pldm_fwup_ua_orchestrator_get_session_status(&testing.test, 1));
+
+    for (i = 0; i < PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS; i++) {
+        status = pldm_fwup_ua_orchestrator_run_session(&testing.test, i);
+        CuAssertIntEquals(test, 0, status);
+        CuAssertIntEquals(test, 2, testing.session[i].calls);
+    }
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_run_session_null(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(NULL, 0);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS, testing.test.sessions_remaining);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_wait_timeout(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_start(&testing.test, false);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TIMEOUT, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 0);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 1);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_TIMEOUT, status);
+
+    status = pldm_fwup_ua_orchestrator_run_session(&testing.test, 2);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, 0, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_wait_null(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init_dependencies(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_init(&testing.test, &testing.ua_flash_mgr, testing.comp_list,
+        &testing.comp_img_set_ver, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_COMPONENTS);
+    CuAssertIntEquals(test, 0, status);
+
+    status = pldm_fwup_ua_orchestrator_wait(NULL, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    /* No sessions have been added. */
+    status = pldm_fwup_ua_orchestrator_wait(&testing.test, 10);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+static void pldm_fwup_ua_orchestrator_test_get_session_status_null(CuTest *test)
+{
+    struct pldm_fwup_ua_orchestrator_testing testing;
+    int status;
+
+    TEST_START;
+
+    pldm_fwup_ua_orchestrator_testing_init(test, &testing);
+
+    status = pldm_fwup_ua_orchestrator_get_session_status(NULL, 0);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    status = pldm_fwup_ua_orchestrator_get_session_status(&testing.test, PLDM_FWUP_UA_ORCHESTRATOR_TESTING_SESSIONS);
+    CuAssertIntEquals(test, PLDM_FWUP_UA_ORCHESTRATOR_INVALID_ARGUMENT, status);
+
+    pldm_fwup_ua_orchestrator_release(&testing.test);
+}
+
+
+TEST_SUITE_START (pldm_fwup_ua_orchestrator);
+
+TEST (pldm_fwup_ua_orchestrator_test_init);
+TEST (pldm_fwup_ua_orchestrator_test_init_null);
+TEST (pldm_fwup_ua_orchestrator_test_release_null);
+TEST (pldm_fwup_ua_orchestrator_test_add_session);
+TEST (pldm_fwup_ua_orchestrator_test_add_session_null);
+TEST (pldm_fwup_ua_orchestrator_test_add_session_shared_manager);
+TEST (pldm_fwup_ua_orchestrator_test_add_session_update_active);
+TEST (pldm_fwup_ua_orchestrator_test_start);
+TEST (pldm_fwup_ua_orchestrator_test_start_null);
+TEST (pldm_fwup_ua_orchestrator_test_start_update_active);
+TEST (pldm_fwup_ua_orchestrator_test_run_session);
+TEST (pldm_fwup_ua_orchestrator_test_run_session_out_of_order);
+TEST (pldm_fwup_ua_orchestrator_test_run_session_failed);
+TEST (pldm_fwup_ua_orchestrator_test_run_session_repeated);
+TEST (pldm_fwup_ua_orchestrator_test_run_session_restart);
+TEST (pldm_fwup_ua_orchestrator_test_run_session_null);
+TEST (pldm_fwup_ua_orchestrator_test_wait_timeout);
+TEST (pldm_fwup_ua_orchestrator_test_wait_null);
+TEST (pldm_fwup_ua_orchestrator_test_get_session_status_null);
+
+TEST_SUITE_END;
@@ -4,6 +4,7 @@
 
 #include "testing.h"
 #include "platform_all_tests.h"
+#include "cmd_channel/pldm_cmd_channel_all_tests.h"
 #include "fwup_fd/pldm_fwup_fd_all_tests.h"
 #include "fwup_ua/pldm_fwup_ua_all_tests.h"
 
@@ -19,6 +20,8 @@ static void add_all_pldm_tests (CuSuite *suite)
     /* This is unused when no tests will be executed. */
     UNUSED (suite);
 
+    add_all_pldm_cmd_channel_tests(suite);
+
     add_all_pldm_fwup_fd_tests(suite);
 
     add_all_pldm_fwup_ua_tests(suite);
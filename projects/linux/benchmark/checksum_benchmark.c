@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "crypto/checksum.h"
+
+
+/**
+ * Microbenchmark of the SMBus CRC8 used for the MCTP packet PEC.
+ *
+ * The implementation selected by CHECKSUM_SMBUS_CRC8_SLICES is timed against a bit by bit
+ * reference calculation for a range of packet sizes.  The results are checked against the
+ * reference, so the benchmark also fails if the selected implementation is not equivalent.
+ */
+
+
+#define	BENCHMARK_DEFAULT_ITERATIONS			200000
+#define	BENCHMARK_BUFFER_LEN					255
+
+
+/**
+ * Packet lengths to time.  These cover control messages up to full size SMBus packets.
+ */
+static const int benchmark_lengths[] = {
+	8, 16, 32, 64, 128, 255
+};
+
+#define	BENCHMARK_NUM_LENGTHS					(sizeof (benchmark_lengths) / sizeof (benchmark_lengths[0]))
+
+
+/**
+ * Reference SMBus CRC8 calculation that processes the data one bit at a time.
+ */
+static uint8_t benchmark_reference_crc8 (uint8_t crc, const uint8_t *data, uint8_t len)
+{
+	int i;
+	int j;
+
+	for (i = 0; i < len; ++i) {
+		crc ^= data[i];
+
+		for (j = 0; j < 8; ++j) {
+			if ((crc & 0x80) != 0) {
+				crc = (uint8_t) ((crc << 1) ^ 0x07);
+			}
+			else {
+				crc <<= 1;
+			}
+		}
+	}
+
+	return crc;
+}
+
+static double benchmark_elapsed (const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) + ((end->tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/**
+ * Time a CRC8 calculation over a buffer.
+ *
+ * @param crc8 The CRC8 calculation to time.
+ * @param data The buffer to use for the calculation.
+ * @param len Length of the buffer.
+ * @param iterations The number of times to calculate the CRC.
+ * @param result Output for the combined result of all calculations.  This keeps the compiler from
+ * removing the work.
+ *
+ * @return The average time for a single calculation, in nanoseconds.
+ */
+static double benchmark_time_crc8 (uint8_t (*crc8) (uint8_t, const uint8_t*, uint8_t),
+	const uint8_t *data, uint8_t len, long iterations, uint8_t *result)
+{
+	struct timespec start;
+	struct timespec end;
+	uint8_t crc = 0;
+	long i;
+
+	clock_gettime (CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < iterations; i++) {
+		/* Chain the results so each calculation depends on the previous one, as with a real
+		 * sequence of packets. */
+		crc = crc8 (crc, data, len);
+	}
+
+	clock_gettime (CLOCK_MONOTONIC, &end);
+
+	*result = crc;
+	return (benchmark_elapsed (&start, &end) * 1e9) / iterations;
+}
+
+static void benchmark_usage (const char *name)
+{
+	printf ("Usage: %s [options]\n", name);
+	printf ("  --iterations <n>     Calculations to time for each packet length (default %d).\n",
+		BENCHMARK_DEFAULT_ITERATIONS);
+	printf ("  --min-speedup <x>    Fail if the speedup over the reference for full size packets\n");
+	printf ("                       is less than this value (default 0, disabled).\n");
+	printf ("  --help               Show this message.\n");
+}
+
+int main (int argc, char **argv)
+{
+	uint8_t buffer[BENCHMARK_BUFFER_LEN];
+	long iterations = BENCHMARK_DEFAULT_ITERATIONS;
+	double min_speedup = 0;
+	double full_speedup = 0;
+	double ref_ns;
+	double ns;
+	uint8_t ref_result;
+	uint8_t result;
+	size_t i;
+	int arg;
+
+	for (arg = 1; arg < argc; arg++) {
+		if ((strcmp (argv[arg], "--iterations") == 0) && ((arg + 1) < argc)) {
+			iterations = strtol (argv[++arg], NULL, 0);
+		}
+		else if ((strcmp (argv[arg], "--min-speedup") == 0) && ((arg + 1) < argc)) {
+			min_speedup = strtod (argv[++arg], NULL);
+		}
+		else if (strcmp (argv[arg], "--help") == 0) {
+			benchmark_usage (argv[0]);
+			return 0;
+		}
+		else {
+			benchmark_usage (argv[0]);
+			return 1;
+		}
+	}
+
+	if (iterations <= 0) {
+		printf ("Invalid iteration count: %ld\n", iterations);
+		return 1;
+	}
+
+	for (i = 0; i < sizeof (buffer); i++) {
+		buffer[i] = (uint8_t) ((i * 167) + 13);
+	}
+
+	printf ("SMBus CRC8 implementation: %d slice(s)%s\n", CHECKSUM_SMBUS_CRC8_SLICES,
+		(CHECKSUM_SMBUS_CRC8_SLICES == 0) ? " (bitwise)" : "");
+	printf ("%-8s %14s %14s %12s %10s\n", "length", "reference_ns", "selected_ns", "MB/s",
+		"speedup");
+
+	for (i = 0; i < BENCHMARK_NUM_LENGTHS; i++) {
+		uint8_t len = benchmark_lengths[i];
+
+		ref_ns = benchmark_time_crc8 (benchmark_reference_crc8, buffer, len, iterations,
+			&ref_result);
+		ns = benchmark_time_crc8 (checksum_update_smbus_crc8, buffer, len, iterations, &result);
+
+		if (result != ref_result) {
+			printf ("CRC mismatch for length %d: expected=0x%02x, actual=0x%02x\n", len, ref_result,
+				result);
+			return 1;
+		}
+
+		printf ("%-8d %14.1f %14.1f %12.1f %9.2fx\n", len, ref_ns, ns, (len * 1e3) / ns,
+			ref_ns / ns);
+
+		if (len == BENCHMARK_BUFFER_LEN) {
+			full_speedup = ref_ns / ns;
+		}
+	}
+
+	if ((min_speedup > 0) && (full_speedup < min_speedup)) {
+		printf ("Speedup %.2fx is below the minimum of %.2fx\n", full_speedup, min_speedup);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,702 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "platform_api.h"
+#include "cmd_interface/cmd_channel.h"
+#include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/device_manager.h"
+#include "common/common_math.h"
+#include "mctp/mctp_base_protocol.h"
+#include "mctp/mctp_interface.h"
+
+
+/**
+ * Microbenchmark of MCTP packetization and reassembly.
+ *
+ * Synthetic messages of each supported message type are packetized and processed for a range of
+ * transmission units and message sizes.  Requests are handled by a stub command interface, so only
+ * the MCTP layer is measured.  Four workloads are timed:
+ *  - construct:  Building packets with mctp_base_protocol_construct.
+ *  - interpret:  Parsing and validating packets with mctp_base_protocol_interpret.
+ *  - receive:  Reassembling a request with mctp_interface_process_packet.
+ *  - respond:  Packetizing a response from mctp_interface_process_packet for a single packet
+ *    request.
+ *
+ * SPDM messages are only received as responses to requests issued by the device, so SPDM is not
+ * used for the receive and respond workloads.
+ *
+ * The results of a run can be saved and used as the baseline for a later run, which fails if the
+ * packet rate of any case drops by more than the allowed tolerance.
+ */
+
+
+#define	BENCHMARK_SELF_EID						0x0B
+#define	BENCHMARK_SELF_SMBUS_ADDR				0x41
+#define	BENCHMARK_REMOTE_EID					0x0A
+#define	BENCHMARK_REMOTE_SMBUS_ADDR				0x10
+#define	BENCHMARK_REMOTE_DEVICE					2
+
+#define	BENCHMARK_DEFAULT_ITERATIONS			2000
+#define	BENCHMARK_DEFAULT_TOLERANCE				10.0
+
+#define	BENCHMARK_MAX_PACKETS					\
+	((MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY / MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT) + 1)
+
+
+/**
+ * The workloads that are timed.
+ */
+enum benchmark_workload {
+	BENCHMARK_CONSTRUCT,				/**< Build packets for a message. */
+	BENCHMARK_INTERPRET,				/**< Parse the packets of a message. */
+	BENCHMARK_RECEIVE,					/**< Reassemble a request. */
+	BENCHMARK_RESPOND,					/**< Packetize a response. */
+	NUM_BENCHMARK_WORKLOADS
+};
+
+static const char *benchmark_workload_names[NUM_BENCHMARK_WORKLOADS] = {
+	"construct",
+	"interpret",
+	"receive",
+	"respond"
+};
+
+/**
+ * A message type to benchmark.
+ */
+struct benchmark_msg_type {
+	const char *name;					/**< Name of the message type. */
+	uint8_t type;						/**< MCTP message type. */
+	size_t max_message;					/**< Largest message the type can use. */
+	bool requests;						/**< Flag indicating the MCTP interface handles requests of the type. */
+};
+
+static const struct benchmark_msg_type benchmark_msg_types[] = {
+	{"cerberus", MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY, true},
+	{"spdm", MCTP_BASE_PROTOCOL_MSG_TYPE_SPDM, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY, false},
+	{"pldm", MCTP_BASE_PROTOCOL_MSG_TYPE_PLDM, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY, true},
+	{"control", MCTP_BASE_PROTOCOL_MSG_TYPE_CONTROL_MSG, MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT,
+		true}
+};
+
+#define	BENCHMARK_NUM_MSG_TYPES		(sizeof (benchmark_msg_types) / sizeof (benchmark_msg_types[0]))
+
+/**
+ * Transmission units to benchmark.
+ */
+static const size_t benchmark_mtus[] = {
+	MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT, 128, MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT
+};
+
+#define	BENCHMARK_NUM_MTUS			(sizeof (benchmark_mtus) / sizeof (benchmark_mtus[0]))
+
+/**
+ * Message sizes to benchmark.  Sizes larger than a message type supports are skipped.
+ */
+static const size_t benchmark_msg_sizes[] = {
+	MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT, 1024, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY
+};
+
+#define	BENCHMARK_NUM_MSG_SIZES		(sizeof (benchmark_msg_sizes) / sizeof (benchmark_msg_sizes[0]))
+
+/**
+ * Command interface that responds to every request with a fixed amount of data.
+ */
+struct benchmark_cmd_interface {
+	struct cmd_interface base;			/**< Base command interface. */
+	size_t response_len;				/**< Length of the response to generate. */
+};
+
+/**
+ * Packets for a single message.
+ */
+struct benchmark_packets {
+	struct cmd_packet packet[BENCHMARK_MAX_PACKETS];	/**< The packets of the message. */
+	size_t count;										/**< The number of packets. */
+	size_t payload;										/**< Total payload of all packets. */
+};
+
+/**
+ * The MCTP stack being measured.
+ */
+struct benchmark_stack {
+	struct device_manager device_mgr;					/**< Device manager for the local and remote devices. */
+	struct benchmark_cmd_interface cmd;					/**< Handler for all message types. */
+	struct mctp_interface mctp;							/**< MCTP layer being measured. */
+};
+
+/**
+ * The measurement of a single benchmark case.
+ */
+struct benchmark_result {
+	double packets_per_sec;				/**< Packets processed per second. */
+	double bytes_per_sec;				/**< Packet payload processed per second. */
+	double cycles_per_packet;			/**< CPU timestamp cycles per packet, or negative if not available. */
+};
+
+/**
+ * Options for the benchmark run.
+ */
+struct benchmark_options {
+	int iterations;						/**< Number of messages to process for each case. */
+	const char *save;					/**< File to save the results to. */
+	const char *compare;				/**< File with baseline results to compare against. */
+	double tolerance;					/**< Allowed packet rate drop from the baseline, in percent. */
+};
+
+
+static int benchmark_process_request (struct cmd_interface *intf,
+	struct cmd_interface_msg *request)
+{
+	struct benchmark_cmd_interface *cmd = (struct benchmark_cmd_interface*) intf;
+
+	/* The request data is reused as the response, so the response starts with the same message
+	 * type and header as the request. */
+	request->length = min (cmd->response_len, request->max_response);
+
+	return 0;
+}
+
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+static int benchmark_process_response (struct cmd_interface *intf,
+	struct cmd_interface_msg *response)
+{
+	return 0;
+}
+#endif
+
+static int benchmark_generate_error_packet (struct cmd_interface *intf,
+	struct cmd_interface_msg *request, uint8_t error_code, uint32_t error_data, uint8_t cmd_set)
+{
+	return cmd_interface_generate_error_packet (intf, request, error_code, error_data, cmd_set);
+}
+
+static double benchmark_elapsed (const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) + ((end->tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/**
+ * Read the CPU timestamp counter.
+ *
+ * @return The current timestamp or 0 if there is no counter available.
+ */
+static uint64_t benchmark_cycles (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc ();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Start a measurement.
+ */
+static void benchmark_start (struct timespec *start, uint64_t *cycles)
+{
+	clock_gettime (CLOCK_MONOTONIC, start);
+	*cycles = benchmark_cycles ();
+}
+
+/**
+ * Finish a measurement and calculate the result.
+ *
+ * @param start Time the measurement was started.
+ * @param start_cycles Timestamp counter when the measurement was started.
+ * @param packets The number of packets processed.
+ * @param bytes The amount of packet payload processed.
+ * @param result Output for the measurement result.
+ */
+static void benchmark_finish (const struct timespec *start, uint64_t start_cycles, size_t packets,
+	size_t bytes, struct benchmark_result *result)
+{
+	struct timespec end;
+	uint64_t cycles;
+	double elapsed;
+
+	cycles = benchmark_cycles ();
+	clock_gettime (CLOCK_MONOTONIC, &end);
+
+	elapsed = benchmark_elapsed (start, &end);
+
+	result->packets_per_sec = packets / elapsed;
+	result->bytes_per_sec = bytes / elapsed;
+	result->cycles_per_packet = (start_cycles != 0) ?
+		((double) (cycles - start_cycles) / packets) : -1;
+}
+
+/**
+ * Initialize the MCTP stack with the transmission unit to use for the remote device.
+ */
+static int benchmark_init_stack (struct benchmark_stack *stack, size_t mtu)
+{
+	struct device_manager_full_capabilities capabilities;
+	int status;
+
+	memset (stack, 0, sizeof (struct benchmark_stack));
+
+	status = device_manager_init (&stack->device_mgr, 1, 2, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 0, 0, 0, 0, 0, 0, 0);
+	if (status != 0) {
+		return status;
+	}
+
+	status = device_manager_update_not_attestable_device_entry (&stack->device_mgr,
+		DEVICE_MANAGER_SELF_DEVICE_NUM, BENCHMARK_SELF_EID, BENCHMARK_SELF_SMBUS_ADDR, 0);
+	if (status != 0) {
+		return status;
+	}
+
+	status = device_manager_update_not_attestable_device_entry (&stack->device_mgr,
+		BENCHMARK_REMOTE_DEVICE, BENCHMARK_REMOTE_EID, BENCHMARK_REMOTE_SMBUS_ADDR, 0);
+	if (status != 0) {
+		return status;
+	}
+
+	device_manager_get_device_capabilities (&stack->device_mgr, BENCHMARK_REMOTE_DEVICE,
+		&capabilities);
+	capabilities.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	capabilities.request.max_packet_size = mtu;
+
+	status = device_manager_update_device_capabilities (&stack->device_mgr,
+		BENCHMARK_REMOTE_DEVICE, &capabilities);
+	if (status != 0) {
+		return status;
+	}
+
+	stack->cmd.base.process_request = benchmark_process_request;
+#ifdef CMD_ENABLE_ISSUE_REQUEST
+	stack->cmd.base.process_response = benchmark_process_response;
+#endif
+	stack->cmd.base.generate_error_packet = benchmark_generate_error_packet;
+
+	return mctp_interface_init (&stack->mctp, &stack->cmd.base, &stack->cmd.base,
+		&stack->cmd.base, &stack->cmd.base, &stack->device_mgr);
+}
+
+static void benchmark_release_stack (struct benchmark_stack *stack)
+{
+	mctp_interface_deinit (&stack->mctp);
+	device_manager_release (&stack->device_mgr);
+}
+
+/**
+ * Build the packets for a request sent from the remote device.
+ *
+ * @param packets Output for the packets of the request.
+ * @param msg_type The MCTP message type of the request.
+ * @param msg_size Total size of the request, including the message type.
+ * @param mtu Transmission unit to use for the packets.
+ * @param msg_tag Message tag for the request.
+ *
+ * @return 0 if the packets were built or an error code.
+ */
+static int benchmark_build_request (struct benchmark_packets *packets, uint8_t msg_type,
+	size_t msg_size, size_t mtu, uint8_t msg_tag)
+{
+	uint8_t message[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	size_t offset = 0;
+	size_t payload_len;
+	size_t i;
+	int status;
+
+	for (i = 0; i < msg_size; i++) {
+		message[i] = (uint8_t) i;
+	}
+	message[0] = msg_type;
+
+	packets->count = 0;
+	packets->payload = msg_size;
+
+	while (offset < msg_size) {
+		struct cmd_packet *packet = &packets->packet[packets->count];
+
+		payload_len = min (mtu, msg_size - offset);
+
+		status = mctp_base_protocol_construct (&message[offset], payload_len, packet->data,
+			sizeof (packet->data), BENCHMARK_REMOTE_SMBUS_ADDR, BENCHMARK_SELF_EID,
+			BENCHMARK_REMOTE_EID, (offset == 0), ((offset + payload_len) == msg_size),
+			packets->count % 4, msg_tag, MCTP_BASE_PROTOCOL_TO_REQUEST, BENCHMARK_SELF_SMBUS_ADDR);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		packet->pkt_size = status;
+		packet->dest_addr = BENCHMARK_SELF_SMBUS_ADDR;
+		packet->state = CMD_VALID_PACKET;
+		packet->timeout_valid = false;
+
+		offset += payload_len;
+		packets->count++;
+	}
+
+	return 0;
+}
+
+/**
+ * Time building the packets for a message.
+ */
+static int benchmark_construct (const struct benchmark_options *options, uint8_t msg_type,
+	size_t msg_size, size_t mtu, struct benchmark_result *result)
+{
+	static struct benchmark_packets packets;
+	struct timespec start;
+	uint64_t cycles;
+	size_t total = 0;
+	int i;
+	int status;
+
+	benchmark_start (&start, &cycles);
+
+	for (i = 0; i < options->iterations; i++) {
+		status = benchmark_build_request (&packets, msg_type, msg_size, mtu, i % 8);
+		if (status != 0) {
+			return status;
+		}
+
+		total += packets.count;
+	}
+
+	benchmark_finish (&start, cycles, total, (size_t) options->iterations * msg_size, result);
+
+	return 0;
+}
+
+/**
+ * Time parsing the packets for a message.
+ */
+static int benchmark_interpret (const struct benchmark_options *options, uint8_t msg_type,
+	size_t msg_size, size_t mtu, struct benchmark_result *result)
+{
+	static struct benchmark_packets packets;
+	struct timespec start;
+	uint64_t cycles;
+	uint8_t source_addr;
+	uint8_t src_eid;
+	uint8_t dest_eid;
+	uint8_t *payload;
+	size_t payload_len;
+	uint8_t tag;
+	uint8_t seq;
+	uint8_t crc;
+	uint8_t type = msg_type;
+	uint8_t tag_owner;
+	bool som;
+	bool eom;
+	size_t pkt;
+	int i;
+	int status;
+
+	status = benchmark_build_request (&packets, msg_type, msg_size, mtu, 0);
+	if (status != 0) {
+		return status;
+	}
+
+	benchmark_start (&start, &cycles);
+
+	for (i = 0; i < options->iterations; i++) {
+		for (pkt = 0; pkt < packets.count; pkt++) {
+			status = mctp_base_protocol_interpret (packets.packet[pkt].data,
+				packets.packet[pkt].pkt_size, BENCHMARK_SELF_SMBUS_ADDR, &source_addr, &som, &eom,
+				&src_eid, &dest_eid, &payload, &payload_len, &tag, &seq, &crc, &type, &tag_owner);
+			if (status != 0) {
+				return status;
+			}
+		}
+	}
+
+	benchmark_finish (&start, cycles, (size_t) options->iterations * packets.count,
+		(size_t) options->iterations * msg_size, result);
+
+	return 0;
+}
+
+/**
+ * Time reassembling requests and packetizing responses with the MCTP interface.
+ *
+ * @param request_size Size of each request.
+ * @param response_size Size of the response to each request.
+ * @param count_response Flag to measure the response packets instead of the request packets.
+ */
+static int benchmark_process (const struct benchmark_options *options, uint8_t msg_type,
+	size_t request_size, size_t response_size, size_t mtu, bool count_response,
+	struct benchmark_result *result)
+{
+	static struct benchmark_packets packets[8];
+	static struct benchmark_stack stack;
+	struct cmd_message *tx_message;
+	struct cmd_packet rx_packet;
+	struct timespec start;
+	uint64_t cycles;
+	size_t total = 0;
+	size_t bytes = 0;
+	size_t pkt;
+	int tag;
+	int i;
+	int status;
+
+	status = benchmark_init_stack (&stack, mtu);
+	if (status != 0) {
+		return status;
+	}
+
+	stack.cmd.response_len = response_size;
+
+	for (tag = 0; tag < 8; tag++) {
+		status = benchmark_build_request (&packets[tag], msg_type, request_size, mtu, tag);
+		if (status != 0) {
+			goto exit;
+		}
+	}
+
+	benchmark_start (&start, &cycles);
+
+	for (i = 0; i < options->iterations; i++) {
+		struct benchmark_packets *request = &packets[i % 8];
+
+		for (pkt = 0; pkt < request->count; pkt++) {
+			/* Packet processing can modify the packet, such as the timeout, so work on a copy the
+			 * same way a command channel does. */
+			memcpy (&rx_packet, &request->packet[pkt], sizeof (rx_packet));
+
+			status = mctp_interface_process_packet (&stack.mctp, &rx_packet, &tx_message);
+			if (status != 0) {
+				goto exit;
+			}
+		}
+
+		if (count_response) {
+			if (tx_message == NULL) {
+				status = -1;
+				goto exit;
+			}
+
+			total += (tx_message->msg_size + tx_message->pkt_size - 1) / tx_message->pkt_size;
+			bytes += stack.cmd.response_len;
+		}
+		else {
+			total += request->count;
+			bytes += request->payload;
+		}
+	}
+
+	benchmark_finish (&start, cycles, total, bytes, result);
+
+exit:
+	benchmark_release_stack (&stack);
+	return status;
+}
+
+/**
+ * Run a single benchmark case.
+ */
+static int benchmark_run_case (const struct benchmark_options *options,
+	enum benchmark_workload workload, const struct benchmark_msg_type *type, size_t msg_size,
+	size_t mtu, struct benchmark_result *result)
+{
+	size_t max_response = min (msg_size, type->max_message);
+
+	switch (workload) {
+		case BENCHMARK_CONSTRUCT:
+			return benchmark_construct (options, type->type, msg_size, mtu, result);
+
+		case BENCHMARK_INTERPRET:
+			return benchmark_interpret (options, type->type, msg_size, mtu, result);
+
+		case BENCHMARK_RECEIVE:
+			return benchmark_process (options, type->type, msg_size, 0, mtu, false, result);
+
+		case BENCHMARK_RESPOND:
+			return benchmark_process (options, type->type, min (mtu, max_response), max_response,
+				mtu, true, result);
+
+		default:
+			return -1;
+	}
+}
+
+/**
+ * Find the baseline packet rate for a benchmark case.
+ *
+ * @return 0 if the case was found in the baseline or -1 if not.
+ */
+static int benchmark_find_baseline (const char *file, const char *workload, const char *type,
+	size_t mtu, size_t msg_size, double *packets_per_sec)
+{
+	char line[256];
+	char line_workload[32];
+	char line_type[32];
+	size_t line_mtu;
+	size_t line_size;
+	double rate;
+	FILE *in;
+	int found = -1;
+
+	in = fopen (file, "r");
+	if (in == NULL) {
+		return -1;
+	}
+
+	while (fgets (line, sizeof (line), in) != NULL) {
+		if ((sscanf (line, "%31s %31s %zu %zu %lf", line_workload, line_type, &line_mtu,
+				&line_size, &rate) == 5) &&
+			(strcmp (line_workload, workload) == 0) && (strcmp (line_type, type) == 0) &&
+			(line_mtu == mtu) && (line_size == msg_size)) {
+			*packets_per_sec = rate;
+			found = 0;
+		}
+	}
+
+	fclose (in);
+
+	return found;
+}
+
+static void benchmark_usage (const char *name)
+{
+	printf ("Usage: %s [options]\n", name);
+	printf ("  --iterations N          Number of messages to process for each case (default %d).\n",
+		BENCHMARK_DEFAULT_ITERATIONS);
+	printf ("  --save FILE             Save the results to FILE.\n");
+	printf ("  --compare FILE          Fail if any packet rate is below the baseline in FILE.\n");
+	printf ("  --tolerance PERCENT     Allowed packet rate drop from the baseline (default %.0f).\n",
+		BENCHMARK_DEFAULT_TOLERANCE);
+}
+
+static int benchmark_parse_options (int argc, char **argv, struct benchmark_options *options)
+{
+	int i;
+
+	options->iterations = BENCHMARK_DEFAULT_ITERATIONS;
+	options->save = NULL;
+	options->compare = NULL;
+	options->tolerance = BENCHMARK_DEFAULT_TOLERANCE;
+
+	for (i = 1; i < argc; i++) {
+		bool has_value = (i + 1) < argc;
+
+		if ((strcmp (argv[i], "--iterations") == 0) && has_value) {
+			options->iterations = strtol (argv[++i], NULL, 0);
+		}
+		else if ((strcmp (argv[i], "--save") == 0) && has_value) {
+			options->save = argv[++i];
+		}
+		else if ((strcmp (argv[i], "--compare") == 0) && has_value) {
+			options->compare = argv[++i];
+		}
+		else if ((strcmp (argv[i], "--tolerance") == 0) && has_value) {
+			options->tolerance = strtod (argv[++i], NULL);
+		}
+		else {
+			benchmark_usage (argv[0]);
+			return -1;
+		}
+	}
+
+	if (options->iterations <= 0) {
+		printf ("Invalid iteration count: %d\n", options->iterations);
+		return -1;
+	}
+
+	return 0;
+}
+
+int main (int argc, char **argv)
+{
+	struct benchmark_options options;
+	struct benchmark_result result;
+	FILE *save = NULL;
+	double baseline;
+	double drop;
+	int failures = 0;
+	int workload;
+	size_t type;
+	size_t mtu;
+	size_t size;
+	int status;
+
+	if (benchmark_parse_options (argc, argv, &options) != 0) {
+		return 1;
+	}
+
+	if (options.save != NULL) {
+		save = fopen (options.save, "w");
+		if (save == NULL) {
+			printf ("Failed to open %s\n", options.save);
+			return 1;
+		}
+
+		fprintf (save, "# workload type mtu msg_size packets_per_sec\n");
+	}
+
+	printf ("%-10s %-9s %5s %8s %14s %10s %12s\n", "workload", "type", "mtu", "msg_size",
+		"packets/s", "MB/s", "cycles/pkt");
+
+	for (workload = 0; workload < NUM_BENCHMARK_WORKLOADS; workload++) {
+		for (type = 0; type < BENCHMARK_NUM_MSG_TYPES; type++) {
+			for (mtu = 0; mtu < BENCHMARK_NUM_MTUS; mtu++) {
+				for (size = 0; size < BENCHMARK_NUM_MSG_SIZES; size++) {
+					const struct benchmark_msg_type *msg_type = &benchmark_msg_types[type];
+					size_t msg_size = benchmark_msg_sizes[size];
+
+					if ((msg_size > msg_type->max_message) ||
+						((workload >= BENCHMARK_RECEIVE) && !msg_type->requests)) {
+						continue;
+					}
+
+					status = benchmark_run_case (&options, workload, msg_type, msg_size,
+						benchmark_mtus[mtu], &result);
+					if (status != 0) {
+						printf ("%s %s mtu=%zu msg_size=%zu failed: 0x%x\n",
+							benchmark_workload_names[workload], msg_type->name, benchmark_mtus[mtu],
+							msg_size, status);
+						failures++;
+						continue;
+					}
+
+					printf ("%-10s %-9s %5zu %8zu %14.0f %10.1f ",
+						benchmark_workload_names[workload], msg_type->name, benchmark_mtus[mtu],
+						msg_size, result.packets_per_sec, result.bytes_per_sec / (1024 * 1024));
+					if (result.cycles_per_packet >= 0) {
+						printf ("%12.0f\n", result.cycles_per_packet);
+					}
+					else {
+						printf ("%12s\n", "n/a");
+					}
+
+					if (save != NULL) {
+						fprintf (save, "%s %s %zu %zu %.0f\n", benchmark_workload_names[workload],
+							msg_type->name, benchmark_mtus[mtu], msg_size, result.packets_per_sec);
+					}
+
+					if ((options.compare != NULL) &&
+						(benchmark_find_baseline (options.compare,
+							benchmark_workload_names[workload], msg_type->name, benchmark_mtus[mtu],
+							msg_size, &baseline) == 0)) {
+						drop = ((baseline - result.packets_per_sec) / baseline) * 100;
+						if (drop > options.tolerance) {
+							printf ("  packet rate dropped %.1f%% from the baseline of %.0f\n", drop,
+								baseline);
+							failures++;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (save != NULL) {
+		fclose (save);
+	}
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,1051 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include "platform_api.h"
+#include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/device_manager.h"
+#include "common/common_math.h"
+#include "crypto/hash.h"
+#include "crypto/hash_openssl.h"
+#include "flash/flash_virtual_ram.h"
+#include "mctp/mctp_base_protocol.h"
+#include "mctp/mctp_interface.h"
+#include "pldm/cmd_channel/cmd_channel_loopback.h"
+#include "pldm/cmd_channel/cmd_channel_shm.h"
+#include "pldm/cmd_interface_pldm.h"
+#include "pldm/pldm_fwup_handler.h"
+#include "pldm/pldm_fwup_manager.h"
+#include "pldm/pldm_fwup_protocol.h"
+#include "libpldm/firmware_update.h"
+
+
+/**
+ * End-to-end benchmark of a PLDM firmware update.
+ *
+ * An Update Agent and a Firmware Device run in the same process, connected by a loopback or shared
+ * memory command channel, and the UA transfers components from virtual flash to the FD.  Each run reports the
+ * transfer throughput, the latency of every PLDM command, and the time spent in each DSP0267
+ * phase of the update.
+ *
+ * The results of a run can be saved and used as the baseline for a later run, which fails if the
+ * throughput drops by more than the allowed tolerance.
+ */
+
+
+#define	BENCHMARK_UA_EID						0x60
+#define	BENCHMARK_UA_SMBUS_ADDR					0x6E
+#define	BENCHMARK_FD_EID						0x40
+#define	BENCHMARK_FD_SMBUS_ADDR					0x4E
+
+#define	BENCHMARK_MAX_COMPONENTS				8
+#define	BENCHMARK_REGION_ALIGN					(64 * 1024)
+#define	BENCHMARK_PACKAGE_DATA_SIZE				4096
+#define	BENCHMARK_META_DATA_SIZE				4096
+
+#define	BENCHMARK_PKG_DATA_ADDR					0
+#define	BENCHMARK_META_DATA_ADDR				(1 * BENCHMARK_REGION_ALIGN)
+#define	BENCHMARK_CHECKPOINT_ADDR				(2 * BENCHMARK_REGION_ALIGN)
+#define	BENCHMARK_COMP_ADDR						(3 * BENCHMARK_REGION_ALIGN)
+
+#define	BENCHMARK_NUM_COMMANDS					0x20
+#define	BENCHMARK_NUM_INSTANCES					0x20
+#define	BENCHMARK_TIMEOUT_MS					10000
+
+#define	BENCHMARK_DEFAULT_COMPONENT_SIZE		(1024 * 1024)
+#define	BENCHMARK_DEFAULT_COMPONENTS			2
+#define	BENCHMARK_DEFAULT_ITERATIONS			3
+#define	BENCHMARK_DEFAULT_TOLERANCE				10.0
+
+#define	BENCHMARK_VERSION_STR(ver, str)			\
+	do { \
+		(ver).version_str_type = PLDM_STR_TYPE_ASCII; \
+		(ver).version_str_length = strlen (str); \
+		memcpy ((ver).version_str, str, strlen (str)); \
+	} while (0)
+
+
+/**
+ * The phases of a DSP0267 update that are timed separately.
+ */
+enum benchmark_phase {
+	BENCHMARK_PHASE_INVENTORY,			/**< QueryDeviceIdentifiers and GetFirmwareParameters. */
+	BENCHMARK_PHASE_REQUEST_UPDATE,		/**< RequestUpdate, GetPackageData, and GetDeviceMetaData. */
+	BENCHMARK_PHASE_COMPONENT_TABLE,	/**< PassComponentTable. */
+	BENCHMARK_PHASE_DOWNLOAD,			/**< UpdateComponent and RequestFirmwareData. */
+	BENCHMARK_PHASE_VERIFY,				/**< TransferComplete and VerifyComplete. */
+	BENCHMARK_PHASE_APPLY,				/**< ApplyComplete. */
+	BENCHMARK_PHASE_ACTIVATE,			/**< ActivateFirmware. */
+	BENCHMARK_PHASE_OTHER,				/**< Any other command, such as GetStatus. */
+	NUM_BENCHMARK_PHASES
+};
+
+static const char *benchmark_phase_names[NUM_BENCHMARK_PHASES] = {
+	"inventory",
+	"request_update",
+	"component_table",
+	"download",
+	"verify",
+	"apply",
+	"activate",
+	"other"
+};
+
+/**
+ * Latency samples collected for a single command, in microseconds.
+ */
+struct benchmark_samples {
+	uint32_t *us;						/**< The collected samples. */
+	size_t count;						/**< The number of samples collected. */
+	size_t max;							/**< The number of samples that can be stored. */
+};
+
+/**
+ * Timing data collected from the packets sent by both endpoints.
+ */
+struct benchmark_trace {
+	platform_mutex lock;													/**< Synchronization between the endpoints. */
+	struct timespec sent[BENCHMARK_NUM_COMMANDS][BENCHMARK_NUM_INSTANCES];	/**< Time each outstanding request was sent. */
+	bool pending[BENCHMARK_NUM_COMMANDS][BENCHMARK_NUM_INSTANCES];			/**< Flag indicating a request has no response yet. */
+	struct benchmark_samples latency[BENCHMARK_NUM_COMMANDS];				/**< Request to response latency of each command. */
+	enum benchmark_phase phase;												/**< The current update phase. */
+	bool phase_valid;														/**< Flag indicating an update phase has started. */
+	struct timespec phase_start;											/**< Time the current phase started. */
+	double phase_time[NUM_BENCHMARK_PHASES];								/**< Total time spent in each phase, in seconds. */
+};
+
+/**
+ * The command channels that can connect the endpoints.
+ */
+enum benchmark_channel_type {
+	BENCHMARK_CHANNEL_LOOPBACK,			/**< Mutex and semaphore protected queues. */
+	BENCHMARK_CHANNEL_SHM,				/**< Lock-free rings in shared memory. */
+};
+
+/**
+ * Channel to the other endpoint.
+ */
+union benchmark_channel {
+	struct cmd_channel base;				/**< The common command channel. */
+	struct cmd_channel_loopback loopback;	/**< Loopback channel. */
+	struct cmd_channel_shm shm;				/**< Shared memory channel. */
+};
+
+/**
+ * The connection between the endpoints for a single update.
+ */
+struct benchmark_link {
+	enum benchmark_channel_type type;			/**< The type of channel used by both endpoints. */
+	struct cmd_channel_loopback_queue to_fd;	/**< Loopback queue of packets sent to the FD. */
+	struct cmd_channel_loopback_queue to_ua;	/**< Loopback queue of packets sent to the UA. */
+	struct cmd_channel_shm_link shm;			/**< Shared memory rings between the endpoints. */
+};
+
+/**
+ * One side of the update and the PLDM stack it uses.
+ */
+struct benchmark_endpoint {
+	union benchmark_channel channel;										/**< Channel to the other endpoint.  Must be first. */
+	int (*send_packet) (struct cmd_channel *channel, struct cmd_packet *packet);	/**< Send function of the channel. */
+	int (*send_packets) (struct cmd_channel *channel, struct cmd_message *message);	/**< Batched send function of the channel. */
+	enum benchmark_channel_type channel_type;								/**< The type of channel to the other endpoint. */
+	struct benchmark_trace *trace;											/**< Timing data shared by both endpoints. */
+	bool msg_valid;															/**< Flag indicating a PLDM message is being sent. */
+	uint8_t msg_command;													/**< The command of the message being sent. */
+	uint8_t msg_instance;													/**< The instance ID of the message being sent. */
+	bool msg_request;														/**< Flag indicating the message being sent is a request. */
+	uint8_t *flash_buffer;													/**< Storage for the virtual flash. */
+	struct flash_virtual_ram flash;											/**< Virtual flash for the endpoint. */
+	struct flash_virtual_ram_state flash_state;								/**< Variable context for the virtual flash. */
+	struct flash_region comp_regions[BENCHMARK_MAX_COMPONENTS];				/**< Component image regions. */
+	struct pldm_fwup_flash_manager flash_mgr;								/**< FWUP flash manager. */
+	struct device_manager device_mgr;										/**< Device manager with the remote endpoint. */
+	struct pldm_fwup_manager fwup_mgr;										/**< FWUP manager. */
+	struct cmd_interface_pldm pldm;											/**< PLDM command interface. */
+	struct cmd_interface cmd_cerberus;										/**< Unused Cerberus command interface. */
+	struct cmd_interface cmd_mctp;											/**< Unused MCTP control command interface. */
+	struct cmd_interface cmd_spdm;											/**< Unused SPDM command interface. */
+	struct mctp_interface mctp;												/**< MCTP layer. */
+	struct pldm_fwup_handler handler;										/**< Firmware update handler. */
+	int status;																/**< The result of the update. */
+};
+
+/**
+ * Options for a benchmark run.
+ */
+struct benchmark_options {
+	size_t component_size;				/**< Size of each component image. */
+	int components;						/**< The number of components to update. */
+	int iterations;						/**< The number of updates to run. */
+	bool hash;							/**< Flag to hash components on the FD while they are downloaded. */
+	bool checkpoints;					/**< Flag to save transfer checkpoints on the FD. */
+	enum benchmark_channel_type channel;	/**< The channel connecting the endpoints. */
+	const char *save;					/**< File to save the results to. */
+	const char *compare;				/**< Baseline file to compare the results against. */
+	double tolerance;					/**< Allowed throughput drop from the baseline, in percent. */
+	double min_mbps;					/**< Minimum allowed throughput. */
+};
+
+/**
+ * Shared configuration of the UA component list and the FD firmware parameters.
+ */
+struct benchmark_config {
+	struct pldm_fwup_protocol_component_parameter_entry params[BENCHMARK_MAX_COMPONENTS];
+	struct pldm_fwup_protocol_firmware_parameters fw_parameters;
+	struct pldm_fwup_fup_component_image_entry comp_list[BENCHMARK_MAX_COMPONENTS];
+	struct pldm_fwup_protocol_version_string comp_img_set_ver;
+	size_t flash_size;
+	size_t region_size;
+};
+
+
+static int benchmark_generate_error_packet (struct cmd_interface *intf,
+	struct cmd_interface_msg *request, uint8_t error_code, uint32_t error_data, uint8_t cmd_set)
+{
+	(void) intf;
+	(void) request;
+	(void) error_code;
+	(void) error_data;
+	(void) cmd_set;
+
+	return CMD_HANDLER_PLDM_TRANSPORT_ERROR;
+}
+
+static double benchmark_elapsed (const struct timespec *start, const struct timespec *end)
+{
+	return (double) (end->tv_sec - start->tv_sec) + ((end->tv_nsec - start->tv_nsec) / 1e9);
+}
+
+static enum benchmark_phase benchmark_get_phase (uint8_t command)
+{
+	switch (command) {
+		case PLDM_QUERY_DEVICE_IDENTIFIERS:
+		case PLDM_GET_FIRMWARE_PARAMETERS:
+			return BENCHMARK_PHASE_INVENTORY;
+
+		case PLDM_REQUEST_UPDATE:
+		case PLDM_GET_PACKAGE_DATA:
+		case PLDM_GET_DEVICE_METADATA:
+			return BENCHMARK_PHASE_REQUEST_UPDATE;
+
+		case PLDM_PASS_COMPONENT_TABLE:
+			return BENCHMARK_PHASE_COMPONENT_TABLE;
+
+		case PLDM_UPDATE_COMPONENT:
+		case PLDM_REQUEST_FIRMWARE_DATA:
+			return BENCHMARK_PHASE_DOWNLOAD;
+
+		case PLDM_TRANSFER_COMPLETE:
+		case PLDM_VERIFY_COMPLETE:
+			return BENCHMARK_PHASE_VERIFY;
+
+		case PLDM_APPLY_COMPLETE:
+			return BENCHMARK_PHASE_APPLY;
+
+		case PLDM_ACTIVATE_FIRMWARE:
+			return BENCHMARK_PHASE_ACTIVATE;
+
+		default:
+			return BENCHMARK_PHASE_OTHER;
+	}
+}
+
+static const char* benchmark_get_command_name (uint8_t command)
+{
+	switch (command) {
+		case PLDM_QUERY_DEVICE_IDENTIFIERS:
+			return "QueryDeviceIdentifiers";
+		case PLDM_GET_FIRMWARE_PARAMETERS:
+			return "GetFirmwareParameters";
+		case PLDM_REQUEST_UPDATE:
+			return "RequestUpdate";
+		case PLDM_GET_PACKAGE_DATA:
+			return "GetPackageData";
+		case PLDM_GET_DEVICE_METADATA:
+			return "GetDeviceMetaData";
+		case PLDM_PASS_COMPONENT_TABLE:
+			return "PassComponentTable";
+		case PLDM_UPDATE_COMPONENT:
+			return "UpdateComponent";
+		case PLDM_REQUEST_FIRMWARE_DATA:
+			return "RequestFirmwareData";
+		case PLDM_TRANSFER_COMPLETE:
+			return "TransferComplete";
+		case PLDM_VERIFY_COMPLETE:
+			return "VerifyComplete";
+		case PLDM_APPLY_COMPLETE:
+			return "ApplyComplete";
+		case PLDM_ACTIVATE_FIRMWARE:
+			return "ActivateFirmware";
+		case PLDM_GET_STATUS:
+			return "GetStatus";
+		case PLDM_CANCEL_UPDATE_COMPONENT:
+			return "CancelUpdateComponent";
+		case PLDM_CANCEL_UPDATE:
+			return "CancelUpdate";
+		default:
+			return "Unknown";
+	}
+}
+
+static void benchmark_add_sample (struct benchmark_samples *samples, uint32_t us)
+{
+	uint32_t *grow;
+
+	if (samples->count == samples->max) {
+		grow = realloc (samples->us, ((samples->max == 0) ? 256 : samples->max * 2) * sizeof (uint32_t));
+		if (grow == NULL) {
+			return;
+		}
+
+		samples->us = grow;
+		samples->max = (samples->max == 0) ? 256 : samples->max * 2;
+	}
+
+	samples->us[samples->count++] = us;
+}
+
+/**
+ * Record the time a request was sent and track the phase of the update.
+ */
+static void benchmark_trace_request (struct benchmark_trace *trace, uint8_t command, uint8_t instance,
+	const struct timespec *now)
+{
+	enum benchmark_phase phase = benchmark_get_phase (command);
+
+	platform_mutex_lock (&trace->lock);
+
+	trace->sent[command][instance] = *now;
+	trace->pending[command][instance] = true;
+
+	if (!trace->phase_valid || (trace->phase != phase)) {
+		if (trace->phase_valid) {
+			trace->phase_time[trace->phase] += benchmark_elapsed (&trace->phase_start, now);
+		}
+
+		trace->phase = phase;
+		trace->phase_start = *now;
+		trace->phase_valid = true;
+	}
+
+	platform_mutex_unlock (&trace->lock);
+}
+
+/**
+ * Record the latency of a request once the last packet of its response is sent.
+ */
+static void benchmark_trace_response (struct benchmark_trace *trace, uint8_t command, uint8_t instance,
+	const struct timespec *now)
+{
+	platform_mutex_lock (&trace->lock);
+
+	if (trace->pending[command][instance]) {
+		benchmark_add_sample (&trace->latency[command],
+			benchmark_elapsed (&trace->sent[command][instance], now) * 1e6);
+		trace->pending[command][instance] = false;
+	}
+
+	platform_mutex_unlock (&trace->lock);
+}
+
+/**
+ * Finish timing the last phase of an update.
+ */
+static void benchmark_trace_finish (struct benchmark_trace *trace, const struct timespec *end)
+{
+	platform_mutex_lock (&trace->lock);
+
+	if (trace->phase_valid) {
+		trace->phase_time[trace->phase] += benchmark_elapsed (&trace->phase_start, end);
+		trace->phase_valid = false;
+	}
+
+	memset (trace->pending, 0, sizeof (trace->pending));
+
+	platform_mutex_unlock (&trace->lock);
+}
+
+/**
+ * Record the timing of PLDM messages for a packet about to be sent to the other endpoint.
+ *
+ * @param endpoint The endpoint sending the packet.
+ * @param data The packet data.
+ * @param length Length of the packet data.
+ */
+static void benchmark_trace_packet (struct benchmark_endpoint *endpoint, const uint8_t *data,
+	size_t length)
+{
+	const struct mctp_base_protocol_transport_header *header =
+		(const struct mctp_base_protocol_transport_header*) data;
+	const size_t msg_offset = sizeof (struct mctp_base_protocol_transport_header);
+	const struct pldm_msg_hdr *pldm;
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	if (header->som) {
+		endpoint->msg_valid = false;
+
+		if ((length > (msg_offset + 1 + sizeof (struct pldm_msg_hdr))) &&
+			MCTP_BASE_PROTOCOL_IS_PLDM_MSG (data[msg_offset])) {
+			pldm = (const struct pldm_msg_hdr*) &data[msg_offset + 1];
+
+			if (pldm->command < BENCHMARK_NUM_COMMANDS) {
+				endpoint->msg_valid = true;
+				endpoint->msg_command = pldm->command;
+				endpoint->msg_instance = pldm->instance_id;
+				endpoint->msg_request = pldm->request;
+
+				if (endpoint->msg_request) {
+					benchmark_trace_request (endpoint->trace, endpoint->msg_command,
+						endpoint->msg_instance, &now);
+				}
+			}
+		}
+	}
+
+	if (header->eom && endpoint->msg_valid) {
+		if (!endpoint->msg_request) {
+			benchmark_trace_response (endpoint->trace, endpoint->msg_command, endpoint->msg_instance,
+				&now);
+		}
+
+		endpoint->msg_valid = false;
+	}
+}
+
+/**
+ * Send a packet to the other endpoint and record the timing of PLDM messages.
+ */
+static int benchmark_send_packet (struct cmd_channel *channel, struct cmd_packet *packet)
+{
+	struct benchmark_endpoint *endpoint = (struct benchmark_endpoint*) channel;
+
+	benchmark_trace_packet (endpoint, packet->data, packet->pkt_size);
+
+	return endpoint->send_packet (channel, packet);
+}
+
+/**
+ * Send all packets of a message to the other endpoint and record the timing of PLDM messages.
+ */
+static int benchmark_send_packets (struct cmd_channel *channel, struct cmd_message *message)
+{
+	struct benchmark_endpoint *endpoint = (struct benchmark_endpoint*) channel;
+	size_t offset;
+
+	for (offset = 0; offset < message->msg_size; offset += message->pkt_size) {
+		benchmark_trace_packet (endpoint, &message->data[offset],
+			min (message->pkt_size, message->msg_size - offset));
+	}
+
+	return endpoint->send_packets (channel, message);
+}
+
+static int benchmark_init_endpoint (struct benchmark_endpoint *endpoint,
+	struct benchmark_config *config, struct benchmark_trace *trace,
+	const struct benchmark_options *options, struct benchmark_link *link, bool is_ua,
+	struct hash_engine *hash)
+{
+	struct device_manager_full_capabilities capabilities;
+	struct device_manager_entry *self;
+	struct device_manager_entry *remote;
+	uint8_t *flash_buffer = endpoint->flash_buffer;
+	int i;
+	int status;
+
+	memset (endpoint, 0, sizeof (struct benchmark_endpoint));
+	endpoint->flash_buffer = flash_buffer;
+	endpoint->trace = trace;
+
+	status = flash_virtual_ram_init (&endpoint->flash, &endpoint->flash_state, endpoint->flash_buffer,
+		config->flash_size);
+	if (status != 0) {
+		return status;
+	}
+
+	endpoint->flash_mgr.flash = &endpoint->flash.base;
+	endpoint->flash_mgr.package_data_region.start_addr = BENCHMARK_PKG_DATA_ADDR;
+	endpoint->flash_mgr.package_data_region.length = BENCHMARK_REGION_ALIGN;
+	endpoint->flash_mgr.device_meta_data_region.start_addr = BENCHMARK_META_DATA_ADDR;
+	endpoint->flash_mgr.device_meta_data_region.length = BENCHMARK_REGION_ALIGN;
+	if (!is_ua && options->checkpoints) {
+		endpoint->flash_mgr.checkpoint_region.start_addr = BENCHMARK_CHECKPOINT_ADDR;
+		endpoint->flash_mgr.checkpoint_region.length = BENCHMARK_REGION_ALIGN;
+	}
+
+	for (i = 0; i < options->components; i++) {
+		endpoint->comp_regions[i].start_addr = BENCHMARK_COMP_ADDR + (i * config->region_size);
+		endpoint->comp_regions[i].length = config->region_size;
+	}
+	endpoint->flash_mgr.comp_regions = endpoint->comp_regions;
+
+	if (is_ua) {
+		endpoint->flash_mgr.package_data_size = BENCHMARK_PACKAGE_DATA_SIZE;
+	}
+	else {
+		endpoint->flash_mgr.device_meta_data_size = BENCHMARK_META_DATA_SIZE;
+	}
+
+	status = device_manager_init (&endpoint->device_mgr, 1, 2, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_MASTER_BUS_ROLE, 0, 0, 0, 0, 0, 0, 0);
+	if (status != 0) {
+		return status;
+	}
+
+	self = &endpoint->device_mgr.entries[DEVICE_MANAGER_SELF_DEVICE_NUM];
+	remote = &endpoint->device_mgr.entries[2];
+
+	status = device_manager_update_device_eid (&endpoint->device_mgr,
+		DEVICE_MANAGER_SELF_DEVICE_NUM, (is_ua) ? BENCHMARK_UA_EID : BENCHMARK_FD_EID);
+	if (status != 0) {
+		return status;
+	}
+
+	self->smbus_addr = (is_ua) ? BENCHMARK_UA_SMBUS_ADDR : BENCHMARK_FD_SMBUS_ADDR;
+	self->pci_device_id = (is_ua) ? 5678 : 8765;
+	self->pci_vid = (is_ua) ? 1234 : 4321;
+	self->pci_subsystem_id = (is_ua) ? 5432 : 2109;
+	self->pci_subsystem_vid = (is_ua) ? 9876 : 6789;
+
+	status = device_manager_update_device_eid (&endpoint->device_mgr, 2,
+		(is_ua) ? BENCHMARK_FD_EID : BENCHMARK_UA_EID);
+	if (status != 0) {
+		return status;
+	}
+
+	remote->smbus_addr = (is_ua) ? BENCHMARK_FD_SMBUS_ADDR : BENCHMARK_UA_SMBUS_ADDR;
+
+	device_manager_get_device_capabilities (&endpoint->device_mgr, 2, &capabilities);
+	capabilities.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	capabilities.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+
+	status = device_manager_update_device_capabilities (&endpoint->device_mgr, 2, &capabilities);
+	if (status != 0) {
+		return status;
+	}
+
+	status = pldm_fwup_manager_init (&endpoint->fwup_mgr, &config->fw_parameters, config->comp_list,
+		&endpoint->flash_mgr, &endpoint->flash_mgr, &config->comp_img_set_ver, options->components);
+	if (status != 0) {
+		return status;
+	}
+
+	if (!is_ua && (hash != NULL)) {
+		status = pldm_fwup_manager_set_comp_hash (&endpoint->fwup_mgr, hash, HASH_TYPE_SHA256);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	status = cmd_interface_pldm_init (&endpoint->pldm, &endpoint->fwup_mgr, &endpoint->device_mgr);
+	if (status != 0) {
+		return status;
+	}
+
+	endpoint->channel_type = link->type;
+	if (link->type == BENCHMARK_CHANNEL_SHM) {
+		status = cmd_channel_shm_init (&endpoint->channel.shm, self->smbus_addr, &link->shm,
+			(is_ua) ? CMD_CHANNEL_SHM_SIDE_A : CMD_CHANNEL_SHM_SIDE_B);
+	}
+	else {
+		status = cmd_channel_loopback_init (&endpoint->channel.loopback, self->smbus_addr,
+			(is_ua) ? &link->to_ua : &link->to_fd, (is_ua) ? &link->to_fd : &link->to_ua);
+	}
+	if (status != 0) {
+		return status;
+	}
+
+	endpoint->send_packet = endpoint->channel.base.send_packet;
+	endpoint->channel.base.send_packet = benchmark_send_packet;
+	endpoint->send_packets = endpoint->channel.base.send_packets;
+	endpoint->channel.base.send_packets = benchmark_send_packets;
+
+	endpoint->cmd_cerberus.generate_error_packet = benchmark_generate_error_packet;
+
+	status = mctp_interface_init (&endpoint->mctp, &endpoint->cmd_cerberus, &endpoint->cmd_mctp,
+		&endpoint->cmd_spdm, &endpoint->pldm.base, &endpoint->device_mgr);
+	if (status != 0) {
+		return status;
+	}
+
+	status = pldm_fwup_handler_init (&endpoint->handler, &endpoint->channel.base, &endpoint->mctp,
+		BENCHMARK_TIMEOUT_MS);
+	if (status != 0) {
+		return status;
+	}
+
+	return pldm_fwup_handler_set_mode (&endpoint->handler,
+		(is_ua) ? PLDM_FWUP_HANDLER_UA_MODE : PLDM_FWUP_HANDLER_FD_MODE);
+}
+
+static void benchmark_release_endpoint (struct benchmark_endpoint *endpoint)
+{
+	pldm_fwup_handler_release (&endpoint->handler);
+	mctp_interface_deinit (&endpoint->mctp);
+	if (endpoint->channel_type == BENCHMARK_CHANNEL_SHM) {
+		cmd_channel_shm_release (&endpoint->channel.shm);
+	}
+	else {
+		cmd_channel_loopback_release (&endpoint->channel.loopback);
+	}
+	cmd_interface_pldm_deinit (&endpoint->pldm);
+	pldm_fwup_manager_deinit (&endpoint->fwup_mgr);
+	device_manager_release (&endpoint->device_mgr);
+	flash_virtual_ram_release (&endpoint->flash);
+}
+
+static int benchmark_init_link (struct benchmark_link *link, enum benchmark_channel_type type)
+{
+	int status;
+
+	link->type = type;
+
+	if (type == BENCHMARK_CHANNEL_SHM) {
+		return cmd_channel_shm_link_init (&link->shm);
+	}
+
+	status = cmd_channel_loopback_queue_init (&link->to_fd);
+	if (status != 0) {
+		return status;
+	}
+
+	status = cmd_channel_loopback_queue_init (&link->to_ua);
+	if (status != 0) {
+		cmd_channel_loopback_queue_release (&link->to_fd);
+	}
+
+	return status;
+}
+
+static void benchmark_release_link (struct benchmark_link *link)
+{
+	if (link->type == BENCHMARK_CHANNEL_SHM) {
+		cmd_channel_shm_link_release (&link->shm);
+	}
+	else {
+		cmd_channel_loopback_queue_release (&link->to_ua);
+		cmd_channel_loopback_queue_release (&link->to_fd);
+	}
+}
+
+static void benchmark_init_config (struct benchmark_config *config,
+	const struct benchmark_options *options)
+{
+	int i;
+
+	memset (config, 0, sizeof (struct benchmark_config));
+
+	config->region_size = ((options->component_size + BENCHMARK_REGION_ALIGN - 1) /
+		BENCHMARK_REGION_ALIGN) * BENCHMARK_REGION_ALIGN;
+	config->flash_size = BENCHMARK_COMP_ADDR + (options->components * config->region_size);
+
+	for (i = 0; i < options->components; i++) {
+		config->params[i].comp_classification = PLDM_COMP_FIRMWARE;
+		config->params[i].comp_identifier = 0x1000 + i;
+		config->params[i].comp_classification_index = i;
+		config->params[i].active_comp_comparison_stamp = 1;
+		config->params[i].pending_comp_comparison_stamp = 2;
+		config->params[i].comp_activation_methods.bits.bit1 = 1;
+		BENCHMARK_VERSION_STR (config->params[i].active_comp_ver, "benchmark_v1.0");
+		BENCHMARK_VERSION_STR (config->params[i].pending_comp_ver, "benchmark_v2.0");
+
+		config->comp_list[i].comp_classification = PLDM_COMP_FIRMWARE;
+		config->comp_list[i].comp_identifier = 0x1000 + i;
+		config->comp_list[i].comp_comparison_stamp = 2;
+		config->comp_list[i].comp_size = options->component_size;
+		config->comp_list[i].comp_options.bits.bit0 = 1;
+		config->comp_list[i].requested_comp_activation_method.bits.bit1 = 1;
+		BENCHMARK_VERSION_STR (config->comp_list[i].comp_ver, "benchmark_v2.0");
+	}
+
+	config->fw_parameters.count = options->components;
+	config->fw_parameters.entries = config->params;
+	BENCHMARK_VERSION_STR (config->fw_parameters.active_comp_img_set_ver, "set_v1.0");
+	BENCHMARK_VERSION_STR (config->fw_parameters.pending_comp_img_set_ver, "set_v2.0");
+	BENCHMARK_VERSION_STR (config->comp_img_set_ver, "set_v2.0");
+}
+
+static void* benchmark_run_fd (void *arg)
+{
+	struct benchmark_endpoint *fd = arg;
+
+	fd->status = fd->handler.start_update_fd (&fd->handler, BENCHMARK_UA_EID,
+		BENCHMARK_UA_SMBUS_ADDR);
+
+	return NULL;
+}
+
+/**
+ * Run a single update and check that the FD received every component intact.
+ *
+ * @return 0 if the update was successful or an error code.
+ */
+static int benchmark_run_update (struct benchmark_endpoint *ua, struct benchmark_endpoint *fd,
+	const struct benchmark_options *options, double *seconds)
+{
+	struct timespec start;
+	struct timespec end;
+	pthread_t fd_task;
+	int i;
+
+	if (pthread_create (&fd_task, NULL, benchmark_run_fd, fd) != 0) {
+		return -1;
+	}
+
+	clock_gettime (CLOCK_MONOTONIC, &start);
+	ua->status = ua->handler.run_update_ua (&ua->handler, true, BENCHMARK_FD_EID,
+		BENCHMARK_FD_SMBUS_ADDR);
+	pthread_join (fd_task, NULL);
+	clock_gettime (CLOCK_MONOTONIC, &end);
+
+	benchmark_trace_finish (ua->trace, &end);
+	*seconds = benchmark_elapsed (&start, &end);
+
+	if (ua->status != 0) {
+		printf ("UA update failed: 0x%x\n", ua->status);
+		return ua->status;
+	}
+
+	if (fd->status != 0) {
+		printf ("FD update failed: 0x%x\n", fd->status);
+		return fd->status;
+	}
+
+	for (i = 0; i < options->components; i++) {
+		if (memcmp (&ua->flash_buffer[ua->comp_regions[i].start_addr],
+			&fd->flash_buffer[fd->comp_regions[i].start_addr], options->component_size) != 0) {
+			printf ("Component %d was not transferred correctly.\n", i);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int benchmark_compare_us (const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t*) a;
+	uint32_t y = *(const uint32_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t benchmark_percentile (const struct benchmark_samples *samples, int percent)
+{
+	size_t index;
+
+	if (samples->count == 0) {
+		return 0;
+	}
+
+	index = ((samples->count - 1) * percent) / 100;
+	return samples->us[index];
+}
+
+static int benchmark_read_baseline (const char *file, double *mbps)
+{
+	char line[256];
+	FILE *in;
+	int found = -1;
+
+	in = fopen (file, "r");
+	if (in == NULL) {
+		printf ("Failed to open baseline %s\n", file);
+		return -1;
+	}
+
+	while (fgets (line, sizeof (line), in) != NULL) {
+		if (sscanf (line, "throughput_mbps=%lf", mbps) == 1) {
+			found = 0;
+		}
+	}
+
+	fclose (in);
+
+	if (found != 0) {
+		printf ("No throughput found in baseline %s\n", file);
+	}
+
+	return found;
+}
+
+static void benchmark_usage (const char *name)
+{
+	printf ("Usage: %s [options]\n", name);
+	printf ("  --component-size BYTES  Size of each component image (default %d).\n",
+		BENCHMARK_DEFAULT_COMPONENT_SIZE);
+	printf ("  --components N          Number of components, 1 to %d (default %d).\n",
+		BENCHMARK_MAX_COMPONENTS, BENCHMARK_DEFAULT_COMPONENTS);
+	printf ("  --iterations N          Number of updates to run (default %d).\n",
+		BENCHMARK_DEFAULT_ITERATIONS);
+	printf ("  --no-hash               Don't hash components on the FD during download.\n");
+	printf ("  --checkpoints           Save transfer checkpoints on the FD.\n");
+	printf ("  --channel TYPE          Channel between the endpoints, loopback or shm (default loopback).\n");
+	printf ("  --save FILE             Save the results to FILE.\n");
+	printf ("  --compare FILE          Fail if throughput is below the baseline in FILE.\n");
+	printf ("  --tolerance PERCENT     Allowed throughput drop from the baseline (default %.0f).\n",
+		BENCHMARK_DEFAULT_TOLERANCE);
+	printf ("  --min-mbps MBPS         Fail if throughput is below MBPS.\n");
+	printf ("The maximum transfer size is set at build time: %d bytes.\n",
+		PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE);
+}
+
+static int benchmark_parse_options (int argc, char **argv, struct benchmark_options *options)
+{
+	int i;
+
+	options->component_size = BENCHMARK_DEFAULT_COMPONENT_SIZE;
+	options->components = BENCHMARK_DEFAULT_COMPONENTS;
+	options->iterations = BENCHMARK_DEFAULT_ITERATIONS;
+	options->hash = true;
+	options->checkpoints = false;
+	options->channel = BENCHMARK_CHANNEL_LOOPBACK;
+	options->save = NULL;
+	options->compare = NULL;
+	options->tolerance = BENCHMARK_DEFAULT_TOLERANCE;
+	options->min_mbps = 0;
+
+	for (i = 1; i < argc; i++) {
+		bool has_value = (i + 1) < argc;
+
+		if ((strcmp (argv[i], "--component-size") == 0) && has_value) {
+			options->component_size = strtoul (argv[++i], NULL, 0);
+		}
+		else if ((strcmp (argv[i], "--components") == 0) && has_value) {
+			options->components = atoi (argv[++i]);
+		}
+		else if ((strcmp (argv[i], "--iterations") == 0) && has_value) {
+			options->iterations = atoi (argv[++i]);
+		}
+		else if (strcmp (argv[i], "--no-hash") == 0) {
+			options->hash = false;
+		}
+		else if (strcmp (argv[i], "--checkpoints") == 0) {
+			options->checkpoints = true;
+		}
+		else if ((strcmp (argv[i], "--channel") == 0) && has_value &&
+			(strcmp (argv[i + 1], "loopback") == 0)) {
+			options->channel = BENCHMARK_CHANNEL_LOOPBACK;
+			i++;
+		}
+		else if ((strcmp (argv[i], "--channel") == 0) && has_value &&
+			(strcmp (argv[i + 1], "shm") == 0)) {
+			options->channel = BENCHMARK_CHANNEL_SHM;
+			i++;
+		}
+		else if ((strcmp (argv[i], "--save") == 0) && has_value) {
+			options->save = argv[++i];
+		}
+		else if ((strcmp (argv[i], "--compare") == 0) && has_value) {
+			options->compare = argv[++i];
+		}
+		else if ((strcmp (argv[i], "--tolerance") == 0) && has_value) {
+			options->tolerance = atof (argv[++i]);
+		}
+		else if ((strcmp (argv[i], "--min-mbps") == 0) && has_value) {
+			options->min_mbps = atof (argv[++i]);
+		}
+		else {
+			benchmark_usage (argv[0]);
+			return -1;
+		}
+	}
+
+	if ((options->component_size == 0) || (options->components < 1) ||
+		(options->components > BENCHMARK_MAX_COMPONENTS) || (options->iterations < 1)) {
+		benchmark_usage (argv[0]);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void benchmark_report (FILE *out, const struct benchmark_trace *trace,
+	const struct benchmark_options *options, const double *mbps, double total_seconds)
+{
+	double min = mbps[0];
+	double max = mbps[0];
+	double sum = 0;
+	int i;
+
+	for (i = 0; i < options->iterations; i++) {
+		sum += mbps[i];
+		min = (mbps[i] < min) ? mbps[i] : min;
+		max = (mbps[i] > max) ? mbps[i] : max;
+	}
+
+	fprintf (out, "component_size=%zu\n", options->component_size);
+	fprintf (out, "components=%d\n", options->components);
+	fprintf (out, "max_transfer_size=%d\n", PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE);
+	fprintf (out, "max_outstanding_transfer_req=%d\n",
+		PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ);
+	fprintf (out, "hash=%d\n", options->hash);
+	fprintf (out, "checkpoints=%d\n", options->checkpoints);
+	fprintf (out, "channel=%s\n", (options->channel == BENCHMARK_CHANNEL_SHM) ? "shm" : "loopback");
+	fprintf (out, "iterations=%d\n", options->iterations);
+	fprintf (out, "throughput_mbps=%.3f\n", sum / options->iterations);
+	fprintf (out, "throughput_min_mbps=%.3f\n", min);
+	fprintf (out, "throughput_max_mbps=%.3f\n", max);
+
+	for (i = 0; i < NUM_BENCHMARK_PHASES; i++) {
+		if (trace->phase_time[i] != 0) {
+			fprintf (out, "phase.%s_ms=%.3f (%.1f%%)\n", benchmark_phase_names[i],
+				(trace->phase_time[i] * 1000) / options->iterations,
+				(trace->phase_time[i] * 100) / total_seconds);
+		}
+	}
+
+	for (i = 0; i < BENCHMARK_NUM_COMMANDS; i++) {
+		const struct benchmark_samples *samples = &trace->latency[i];
+
+		if (samples->count != 0) {
+			fprintf (out, "latency.%s_us=count:%zu p50:%u p90:%u p99:%u max:%u\n",
+				benchmark_get_command_name (i), samples->count, benchmark_percentile (samples, 50),
+				benchmark_percentile (samples, 90), benchmark_percentile (samples, 99),
+				samples->us[samples->count - 1]);
+		}
+	}
+}
+
+int main (int argc, char **argv)
+{
+	static struct benchmark_endpoint ua;
+	static struct benchmark_endpoint fd;
+	static struct benchmark_trace trace;
+	struct benchmark_options options;
+	struct benchmark_config config;
+	struct benchmark_link *link;
+	struct hash_engine_openssl hash;
+	double *mbps;
+	double seconds;
+	double total_seconds = 0;
+	double baseline;
+	double average = 0;
+	size_t i;
+	int iteration;
+	int status;
+
+	if (benchmark_parse_options (argc, argv, &options) != 0) {
+		return 2;
+	}
+
+	benchmark_init_config (&config, &options);
+
+	ua.flash_buffer = malloc (config.flash_size);
+	fd.flash_buffer = malloc (config.flash_size);
+	mbps = calloc (options.iterations, sizeof (double));
+	link = malloc (sizeof (struct benchmark_link));
+	if ((ua.flash_buffer == NULL) || (fd.flash_buffer == NULL) || (mbps == NULL) ||
+		(link == NULL)) {
+		printf ("Out of memory.\n");
+		return 1;
+	}
+
+	/* Use the same images for every run so results are repeatable. */
+	srand (1);
+	for (i = 0; i < config.flash_size; i++) {
+		ua.flash_buffer[i] = rand ();
+	}
+
+	status = hash_openssl_init (&hash);
+	if (status != 0) {
+		printf ("Failed to initialize hashing: 0x%x\n", status);
+		return 1;
+	}
+
+	status = platform_mutex_init (&trace.lock);
+	if (status != 0) {
+		return 1;
+	}
+
+	for (iteration = 0; iteration < options.iterations; iteration++) {
+		memset (fd.flash_buffer, 0xff, config.flash_size);
+
+		status = benchmark_init_link (link, options.channel);
+		if (status == 0) {
+			status = benchmark_init_endpoint (&ua, &config, &trace, &options, link, true, NULL);
+		}
+		if (status == 0) {
+			status = benchmark_init_endpoint (&fd, &config, &trace, &options, link, false,
+				(options.hash) ? &hash.base : NULL);
+		}
+		if (status != 0) {
+			printf ("Failed to initialize the update: 0x%x\n", status);
+			return 1;
+		}
+
+		status = benchmark_run_update (&ua, &fd, &options, &seconds);
+
+		benchmark_release_endpoint (&fd);
+		benchmark_release_endpoint (&ua);
+		benchmark_release_link (link);
+
+		if (status != 0) {
+			return 1;
+		}
+
+		mbps[iteration] = (options.component_size * options.components) / seconds / 1e6;
+		total_seconds += seconds;
+		average += mbps[iteration] / options.iterations;
+
+		printf ("Run %d: %.3f MB/s in %.3f s\n", iteration + 1, mbps[iteration], seconds);
+	}
+
+	for (i = 0; i < BENCHMARK_NUM_COMMANDS; i++) {
+		qsort (trace.latency[i].us, trace.latency[i].count, sizeof (uint32_t), benchmark_compare_us);
+	}
+
+	printf ("\n");
+	benchmark_report (stdout, &trace, &options, mbps, total_seconds);
+
+	if (options.save != NULL) {
+		FILE *out = fopen (options.save, "w");
+
+		if (out == NULL) {
+			printf ("Failed to save results to %s\n", options.save);
+			return 1;
+		}
+
+		benchmark_report (out, &trace, &options, mbps, total_seconds);
+		fclose (out);
+	}
+
+	status = 0;
+	if ((options.min_mbps != 0) && (average < options.min_mbps)) {
+		printf ("FAIL: %.3f MB/s is below the minimum of %.3f MB/s\n", average, options.min_mbps);
+		status = 1;
+	}
+
+	if (options.compare != NULL) {
+		if (benchmark_read_baseline (options.compare, &baseline) != 0) {
+			status = 1;
+		}
+		else if (average < (baseline * (1 - (options.tolerance / 100)))) {
+			printf ("FAIL: %.3f MB/s is more than %.1f%% below the baseline of %.3f MB/s\n",
+				average, options.tolerance, baseline);
+			status = 1;
+		}
+		else {
+			printf ("PASS: %.3f MB/s against a baseline of %.3f MB/s\n", average, baseline);
+		}
+	}
+
+	for (i = 0; i < BENCHMARK_NUM_COMMANDS; i++) {
+		free (trace.latency[i].us);
+	}
+
+	hash_openssl_release (&hash);
+	platform_mutex_free (&trace.lock);
+	free (link);
+	free (mbps);
+	free (fd.flash_buffer);
+	free (ua.flash_buffer);
+
+	return status;
+}
@@ -117,14 +117,18 @@
  * PLDM protocol
  ********************/
 
+#ifndef PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE
 #define PLDM_FWUP_PROTOCOL_MAX_TRANSFER_SIZE                    1024
+#endif
 
-#define PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ         1
+#define PLDM_FWUP_PROTOCOL_MAX_OUTSTANDING_TRANSFER_REQ         4
 
 #define PLDM_FWUP_PROTOCOL_TIME_BERFORE_REQ_FW_DATA             1
 
 #define PLDM_FWUP_PROTOCOL_EST_TIME_SELF_CONTAINED_ACTIVATION   1
 
+#define PLDM_FWUP_PROTOCOL_CHECKPOINT_INTERVAL                  (16 * 1024)
+
 #define PLDM_TESTING_FIRMWARE_DEVICE_PORT           49156
 #define PLDM_TESTING_UPDATE_AGENT_PORT              49155
 